@@ -0,0 +1,548 @@
+/*
+* Copyright (c) <2021> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniApiRecorder.h"
+
+#include "HoudiniApi.h"
+#include "HoudiniEnginePrivatePCH.h"
+#include "HAPI/HAPI_Version.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/Crc.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/Archive.h"
+
+#include <type_traits>
+
+// "HAPR"
+#define HOUDINI_API_RECORDING_MAGIC			0x52504148
+#define HOUDINI_API_RECORDING_VERSION		1
+
+// Index of every FHoudiniApi function in the recordings
+namespace EHoudiniApiFunction
+{
+	enum Type : int32
+	{
+#define HOUDINI_API_FUNCTION(Name) Name,
+#include "HoudiniApiRecorderFunctions.inl"
+#undef HOUDINI_API_FUNCTION
+		Count
+	};
+}
+
+static const TCHAR* HoudiniApiFunctionNames[] =
+{
+#define HOUDINI_API_FUNCTION(Name) TEXT(#Name),
+#include "HoudiniApiRecorderFunctions.inl"
+#undef HOUDINI_API_FUNCTION
+};
+
+// Size of an array output argument, see HoudiniApiRecorderFunctions.inl
+struct FHoudiniApiOutputSize
+{
+	int32 OutputArgIndex = -1;
+	int32 CountArgIndex = -1;
+	int32 AttributeInfoArgIndex = -1;
+	int32 FixedCount = 1;
+};
+
+static const TArray<TArray<FHoudiniApiOutputSize>>&
+GetHoudiniApiOutputSizes()
+{
+	static TArray<TArray<FHoudiniApiOutputSize>> OutputSizes = []()
+	{
+		TArray<TArray<FHoudiniApiOutputSize>> Sizes;
+		Sizes.SetNum(EHoudiniApiFunction::Count);
+#define HOUDINI_API_OUTPUT_ARRAY(Name, OutputArg, CountArg, AttributeInfoArg) Sizes[EHoudiniApiFunction::Name].Add({ OutputArg, CountArg, AttributeInfoArg, 1 });
+#define HOUDINI_API_OUTPUT_FIXED(Name, OutputArg, Count) Sizes[EHoudiniApiFunction::Name].Add({ OutputArg, -1, -1, Count });
+#include "HoudiniApiRecorderFunctions.inl"
+#undef HOUDINI_API_OUTPUT_ARRAY
+#undef HOUDINI_API_OUTPUT_FIXED
+		return Sizes;
+	}();
+
+	return OutputSizes;
+}
+
+// Arguments of a single HAPI call
+struct FHoudiniApiCallCapture
+{
+	FHoudiniApiCallCapture(const int32& InFunctionIndex)
+		: FunctionIndex(InFunctionIndex)
+		, InputHash(0)
+	{}
+
+	template<typename T>
+	void CaptureArgument(const int32& InArgIndex, T InArg)
+	{
+		ArgValues.SetNumZeroed(FMath::Max(ArgValues.Num(), InArgIndex + 1));
+		ArgPointers.SetNumZeroed(FMath::Max(ArgPointers.Num(), InArgIndex + 1));
+
+		if constexpr (std::is_pointer_v<T>)
+		{
+			using ElementType = std::remove_pointer_t<T>;
+			ArgPointers[InArgIndex] = (const void*)InArg;
+
+			if constexpr (std::is_same_v<std::remove_cv_t<ElementType>, char> && std::is_const_v<ElementType>)
+			{
+				// Strings (names, paths) identify the call
+				if (InArg)
+					InputHash = FCrc::MemCrc32(InArg, FCStringAnsi::Strlen(InArg), InputHash);
+			}
+			else if constexpr (!std::is_const_v<ElementType> && !std::is_void_v<ElementType> && !std::is_pointer_v<ElementType>)
+			{
+				// Non-const pointers are the outputs, one element unless listed in HoudiniApiRecorderFunctions.inl
+				Outputs.Add({ InArgIndex, (void*)InArg, (int64)sizeof(ElementType) });
+			}
+			// Other pointers (session, input buffers and structs) are not part of the call's key
+		}
+		else
+		{
+			if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+				ArgValues[InArgIndex] = (int64)InArg;
+
+			InputHash = FCrc::MemCrc32(&InArg, sizeof(T), InputHash);
+		}
+	}
+
+	// Turns the output element sizes into buffer sizes, using the array arguments' counts
+	void ResolveOutputSizes()
+	{
+		const TArray<FHoudiniApiOutputSize>& Sizes = GetHoudiniApiOutputSizes()[FunctionIndex];
+		for (FHoudiniApiOutput& Output : Outputs)
+		{
+			const FHoudiniApiOutputSize* Size = Sizes.FindByPredicate(
+				[&Output](const FHoudiniApiOutputSize& InSize) { return InSize.OutputArgIndex == Output.ArgIndex; });
+			if (!Size)
+				continue;
+
+			int64 Count = Size->FixedCount;
+			if (ArgValues.IsValidIndex(Size->CountArgIndex))
+				Count = ArgValues[Size->CountArgIndex];
+
+			const HAPI_AttributeInfo* AttributeInfo = ArgPointers.IsValidIndex(Size->AttributeInfoArgIndex)
+				? (const HAPI_AttributeInfo*)ArgPointers[Size->AttributeInfoArgIndex] : nullptr;
+			if (AttributeInfo)
+				Count *= FMath::Max(1, AttributeInfo->tupleSize);
+
+			Output.Size *= FMath::Max<int64>(0, Count);
+		}
+	}
+
+	struct FHoudiniApiOutput
+	{
+		int32 ArgIndex;
+		void* Data;
+		int64 Size;
+	};
+
+	int32 FunctionIndex;
+	uint32 InputHash;
+	TArray<FHoudiniApiOutput, TInlineAllocator<4>> Outputs;
+	TArray<int64, TInlineAllocator<16>> ArgValues;
+	TArray<const void*, TInlineAllocator<16>> ArgPointers;
+};
+
+struct FHoudiniApiRecordedCall
+{
+	int32 FunctionIndex = -1;
+	uint32 InputHash = 0;
+	TArray<uint8> Result;
+	TArray<TArray<uint8>> Outputs;
+
+	friend FArchive& operator<<(FArchive& Ar, FHoudiniApiRecordedCall& Call)
+	{
+		Ar << Call.FunctionIndex;
+		Ar << Call.InputHash;
+		Ar << Call.Result;
+		Ar << Call.Outputs;
+		return Ar;
+	}
+};
+
+// Recorded results of all the calls sharing the same function and key
+struct FHoudiniApiReplayQueue
+{
+	TArray<int32> CallIndices;
+	int32 NextCall = 0;
+};
+
+struct FHoudiniApiRecorderState
+{
+	FCriticalSection Lock;
+	EHoudiniApiRecorderMode Mode = EHoudiniApiRecorderMode::None;
+
+	FArchive* Writer = nullptr;
+
+	TArray<FHoudiniApiRecordedCall> RecordedCalls;
+	TMap<uint64, FHoudiniApiReplayQueue> ReplayQueues;
+	TSet<int32> MissingFunctions;
+
+	FThreadSafeCounter CallCount;
+	FThreadSafeCounter MissingCallCount;
+};
+
+static FHoudiniApiRecorderState&
+GetRecorderState()
+{
+	static FHoudiniApiRecorderState RecorderState;
+	return RecorderState;
+}
+
+static uint64
+GetReplayKey(const int32& InFunctionIndex, const uint32& InInputHash)
+{
+	return ((uint64)(uint32)InFunctionIndex << 32) | (uint64)InInputHash;
+}
+
+static void
+RecordCall(const FHoudiniApiCallCapture& InCapture, const void* InResult, const int32& InResultSize)
+{
+	FHoudiniApiRecordedCall Call;
+	Call.FunctionIndex = InCapture.FunctionIndex;
+	Call.InputHash = InCapture.InputHash;
+	Call.Result.Append((const uint8*)InResult, InResultSize);
+
+	Call.Outputs.SetNum(InCapture.Outputs.Num());
+	for (int32 Idx = 0; Idx < InCapture.Outputs.Num(); Idx++)
+	{
+		const FHoudiniApiCallCapture::FHoudiniApiOutput& Output = InCapture.Outputs[Idx];
+		if (Output.Data && Output.Size > 0)
+			Call.Outputs[Idx].Append((const uint8*)Output.Data, Output.Size);
+	}
+
+	FHoudiniApiRecorderState& State = GetRecorderState();
+	FScopeLock ScopeLock(&State.Lock);
+	if (!State.Writer)
+		return;
+
+	*State.Writer << Call;
+	State.CallCount.Increment();
+}
+
+static bool
+ReplayCall(const FHoudiniApiCallCapture& InCapture, void* OutResult, const int32& InResultSize)
+{
+	FHoudiniApiRecorderState& State = GetRecorderState();
+	FScopeLock ScopeLock(&State.Lock);
+	State.CallCount.Increment();
+
+	FHoudiniApiReplayQueue* Queue = State.ReplayQueues.Find(GetReplayKey(InCapture.FunctionIndex, InCapture.InputHash));
+	if (!Queue || Queue->CallIndices.Num() <= 0)
+	{
+		State.MissingCallCount.Increment();
+		if (!State.MissingFunctions.Contains(InCapture.FunctionIndex))
+		{
+			State.MissingFunctions.Add(InCapture.FunctionIndex);
+			HOUDINI_LOG_WARNING(TEXT("HAPI replay: a call to %s was not found in the recording."), HoudiniApiFunctionNames[InCapture.FunctionIndex]);
+		}
+		return false;
+	}
+
+	// Serve the calls in recorded order, then keep serving the last one (status polling...)
+	const FHoudiniApiRecordedCall& Call = State.RecordedCalls[Queue->CallIndices[FMath::Min(Queue->NextCall, Queue->CallIndices.Num() - 1)]];
+	Queue->NextCall++;
+
+	if (OutResult && Call.Result.Num() == InResultSize)
+		FMemory::Memcpy(OutResult, Call.Result.GetData(), InResultSize);
+
+	for (int32 Idx = 0; Idx < InCapture.Outputs.Num() && Idx < Call.Outputs.Num(); Idx++)
+	{
+		const FHoudiniApiCallCapture::FHoudiniApiOutput& Output = InCapture.Outputs[Idx];
+		if (Output.Data && Output.Size > 0)
+			FMemory::Memcpy(Output.Data, Call.Outputs[Idx].GetData(), FMath::Min<int64>(Output.Size, Call.Outputs[Idx].Num()));
+	}
+
+	return true;
+}
+
+template<typename ReturnType>
+static ReturnType
+GetFailedCallResult()
+{
+	if constexpr (std::is_same_v<ReturnType, HAPI_Result>)
+		return HAPI_RESULT_FAILURE;
+	else
+		return ReturnType{};
+}
+
+// Replaces a FHoudiniApi function, captures its arguments and records or replays it
+template<int32 FunctionIndex, typename FuncPtrType>
+struct THoudiniApiShim;
+
+template<int32 FunctionIndex, typename ReturnType, typename... ArgTypes>
+struct THoudiniApiShim<FunctionIndex, ReturnType(*)(ArgTypes...)>
+{
+	static inline ReturnType(*Original)(ArgTypes...) = nullptr;
+
+	static ReturnType Call(ArgTypes... Args)
+	{
+		FHoudiniApiCallCapture Capture(FunctionIndex);
+		int32 ArgIndex = 0;
+		(Capture.CaptureArgument(ArgIndex++, Args), ...);
+		Capture.ResolveOutputSizes();
+
+		const bool bReplaying = GetRecorderState().Mode == EHoudiniApiRecorderMode::Replaying;
+		if constexpr (std::is_void_v<ReturnType>)
+		{
+			if (bReplaying)
+			{
+				ReplayCall(Capture, nullptr, 0);
+				return;
+			}
+
+			Original(Args...);
+			RecordCall(Capture, nullptr, 0);
+		}
+		else
+		{
+			ReturnType Result = GetFailedCallResult<ReturnType>();
+			if (bReplaying)
+			{
+				ReplayCall(Capture, &Result, sizeof(ReturnType));
+				return Result;
+			}
+
+			Result = Original(Args...);
+			RecordCall(Capture, &Result, sizeof(ReturnType));
+			return Result;
+		}
+	}
+};
+
+#define HOUDINI_API_SHIM(Name) THoudiniApiShim<EHoudiniApiFunction::Name, FHoudiniApi::Name##FuncPtr>
+
+static void
+InstallShims()
+{
+#define HOUDINI_API_FUNCTION(Name) \
+	HOUDINI_API_SHIM(Name)::Original = FHoudiniApi::Name; \
+	FHoudiniApi::Name = &HOUDINI_API_SHIM(Name)::Call;
+#include "HoudiniApiRecorderFunctions.inl"
+#undef HOUDINI_API_FUNCTION
+}
+
+static void
+RemoveShims()
+{
+#define HOUDINI_API_FUNCTION(Name) \
+	if (FHoudiniApi::Name == &HOUDINI_API_SHIM(Name)::Call) \
+		FHoudiniApi::Name = HOUDINI_API_SHIM(Name)::Original;
+#include "HoudiniApiRecorderFunctions.inl"
+#undef HOUDINI_API_FUNCTION
+}
+
+#undef HOUDINI_API_SHIM
+
+bool
+FHoudiniApiRecorder::StartRecording(const FString& InFilePath)
+{
+	FHoudiniApiRecorderState& State = GetRecorderState();
+	if (State.Mode != EHoudiniApiRecorderMode::None)
+	{
+		HOUDINI_LOG_WARNING(TEXT("HAPI recorder: already recording or replaying."));
+		return false;
+	}
+
+	FArchive* Writer = IFileManager::Get().CreateFileWriter(*InFilePath);
+	if (!Writer)
+	{
+		HOUDINI_LOG_ERROR(TEXT("HAPI recorder: unable to create %s."), *InFilePath);
+		return false;
+	}
+
+	// Header: format, HAPI version and the function names, so indices can be remapped if the API changes
+	uint32 Magic = HOUDINI_API_RECORDING_MAGIC;
+	int32 Version = HOUDINI_API_RECORDING_VERSION;
+	int32 HoudiniMajor = HAPI_VERSION_HOUDINI_MAJOR;
+	int32 HoudiniMinor = HAPI_VERSION_HOUDINI_MINOR;
+	int32 HoudiniBuild = HAPI_VERSION_HOUDINI_BUILD;
+	TArray<FString> FunctionNames;
+	for (int32 Idx = 0; Idx < EHoudiniApiFunction::Count; Idx++)
+		FunctionNames.Add(HoudiniApiFunctionNames[Idx]);
+
+	*Writer << Magic << Version << HoudiniMajor << HoudiniMinor << HoudiniBuild << FunctionNames;
+
+	{
+		FScopeLock ScopeLock(&State.Lock);
+		State.Writer = Writer;
+		State.CallCount.Reset();
+		State.MissingCallCount.Reset();
+		State.Mode = EHoudiniApiRecorderMode::Recording;
+	}
+
+	InstallShims();
+
+	HOUDINI_LOG_MESSAGE(TEXT("HAPI recorder: recording HAPI calls to %s."), *InFilePath);
+	return true;
+}
+
+bool
+FHoudiniApiRecorder::StartReplay(const FString& InFilePath)
+{
+	FHoudiniApiRecorderState& State = GetRecorderState();
+	if (State.Mode != EHoudiniApiRecorderMode::None)
+	{
+		HOUDINI_LOG_WARNING(TEXT("HAPI recorder: already recording or replaying."));
+		return false;
+	}
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*InFilePath));
+	if (!Reader)
+	{
+		HOUDINI_LOG_ERROR(TEXT("HAPI recorder: unable to open %s."), *InFilePath);
+		return false;
+	}
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 HoudiniMajor = 0;
+	int32 HoudiniMinor = 0;
+	int32 HoudiniBuild = 0;
+	TArray<FString> FunctionNames;
+	*Reader << Magic << Version;
+	if (Magic != HOUDINI_API_RECORDING_MAGIC || Version != HOUDINI_API_RECORDING_VERSION)
+	{
+		HOUDINI_LOG_ERROR(TEXT("HAPI recorder: %s is not a valid HAPI recording."), *InFilePath);
+		return false;
+	}
+
+	*Reader << HoudiniMajor << HoudiniMinor << HoudiniBuild << FunctionNames;
+	if (HoudiniMajor != HAPI_VERSION_HOUDINI_MAJOR || HoudiniMinor != HAPI_VERSION_HOUDINI_MINOR)
+	{
+		HOUDINI_LOG_WARNING(TEXT("HAPI recorder: %s was recorded with Houdini %d.%d.%d, the plugin uses %d.%d.%d."),
+			*InFilePath, HoudiniMajor, HoudiniMinor, HoudiniBuild,
+			HAPI_VERSION_HOUDINI_MAJOR, HAPI_VERSION_HOUDINI_MINOR, HAPI_VERSION_HOUDINI_BUILD);
+	}
+
+	// Map the recorded function indices to ours
+	TMap<FString, int32> FunctionIndices;
+	for (int32 Idx = 0; Idx < EHoudiniApiFunction::Count; Idx++)
+		FunctionIndices.Add(HoudiniApiFunctionNames[Idx], Idx);
+
+	TArray<int32> RecordedToCurrentIndex;
+	for (const FString& FunctionName : FunctionNames)
+	{
+		const int32* CurrentIndex = FunctionIndices.Find(FunctionName);
+		RecordedToCurrentIndex.Add(CurrentIndex ? *CurrentIndex : INDEX_NONE);
+	}
+
+	TArray<FHoudiniApiRecordedCall> RecordedCalls;
+	TMap<uint64, FHoudiniApiReplayQueue> ReplayQueues;
+	while (!Reader->AtEnd() && !Reader->IsError())
+	{
+		FHoudiniApiRecordedCall Call;
+		*Reader << Call;
+		if (Reader->IsError() || !RecordedToCurrentIndex.IsValidIndex(Call.FunctionIndex))
+			break;
+
+		Call.FunctionIndex = RecordedToCurrentIndex[Call.FunctionIndex];
+		if (Call.FunctionIndex == INDEX_NONE)
+			continue;
+
+		ReplayQueues.FindOrAdd(GetReplayKey(Call.FunctionIndex, Call.InputHash)).CallIndices.Add(RecordedCalls.Num());
+		RecordedCalls.Add(MoveTemp(Call));
+	}
+
+	{
+		FScopeLock ScopeLock(&State.Lock);
+		State.RecordedCalls = MoveTemp(RecordedCalls);
+		State.ReplayQueues = MoveTemp(ReplayQueues);
+		State.MissingFunctions.Empty();
+		State.CallCount.Reset();
+		State.MissingCallCount.Reset();
+		State.Mode = EHoudiniApiRecorderMode::Replaying;
+	}
+
+	InstallShims();
+
+	HOUDINI_LOG_MESSAGE(TEXT("HAPI recorder: replaying %d HAPI calls from %s."), State.RecordedCalls.Num(), *InFilePath);
+	return true;
+}
+
+void
+FHoudiniApiRecorder::Stop()
+{
+	FHoudiniApiRecorderState& State = GetRecorderState();
+	if (State.Mode == EHoudiniApiRecorderMode::None)
+		return;
+
+	RemoveShims();
+
+	FScopeLock ScopeLock(&State.Lock);
+	if (State.Writer)
+	{
+		State.Writer->Close();
+		delete State.Writer;
+		State.Writer = nullptr;
+	}
+
+	HOUDINI_LOG_MESSAGE(TEXT("HAPI recorder: stopped after %d calls (%d missing)."),
+		State.CallCount.GetValue(), State.MissingCallCount.GetValue());
+
+	State.RecordedCalls.Empty();
+	State.ReplayQueues.Empty();
+	State.Mode = EHoudiniApiRecorderMode::None;
+}
+
+EHoudiniApiRecorderMode
+FHoudiniApiRecorder::GetMode()
+{
+	return GetRecorderState().Mode;
+}
+
+int32
+FHoudiniApiRecorder::GetCallCount()
+{
+	return GetRecorderState().CallCount.GetValue();
+}
+
+int32
+FHoudiniApiRecorder::GetMissingCallCount()
+{
+	return GetRecorderState().MissingCallCount.GetValue();
+}
+
+static FAutoConsoleCommand CCmdHoudiniEngineRecordHAPI(
+	TEXT("HoudiniEngine.RecordHAPI"),
+	TEXT("Records all the HAPI calls to the given file, until HoudiniEngine.StopHAPIRecorder is called."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() < 1)
+		{
+			HOUDINI_LOG_WARNING(TEXT("Usage: HoudiniEngine.RecordHAPI <file path>"));
+			return;
+		}
+
+		FHoudiniApiRecorder::StartRecording(Args[0]);
+	}));
+
+static FAutoConsoleCommand CCmdHoudiniEngineStopHAPIRecorder(
+	TEXT("HoudiniEngine.StopHAPIRecorder"),
+	TEXT("Stops recording or replaying HAPI calls."),
+	FConsoleCommandDelegate::CreateStatic(&FHoudiniApiRecorder::Stop));
@@ -0,0 +1,66 @@
+/*
+* Copyright (c) <2021> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EHoudiniApiRecorderMode : uint8
+{
+	None,
+	Recording,	// HAPI calls go to libHAPI and are captured to a file
+	Replaying	// HAPI calls are served from a recording, libHAPI is not used
+};
+
+// Records every call made through the FHoudiniApi function table, with its return value and
+// output buffers, and replays them deterministically without a Houdini Engine install.
+//
+// Replayed calls are matched on the function and the value/string arguments, in recorded order.
+// Once all the recorded results of a call are consumed, the last one is served again.
+//
+// Can be started with -HoudiniEngineRecord=<file> / -HoudiniEngineReplay=<file>
+// or the HoudiniEngine.RecordHAPI / HoudiniEngine.StopHAPIRecorder console commands.
+class HOUDINIENGINE_API FHoudiniApiRecorder
+{
+	public:
+
+		// Shims the FHoudiniApi functions and starts writing their calls to the given file.
+		static bool StartRecording(const FString& InFilePath);
+
+		// Loads a recording and replaces the FHoudiniApi functions with its replay.
+		static bool StartReplay(const FString& InFilePath);
+
+		// Restores the FHoudiniApi functions and closes the recording.
+		static void Stop();
+
+		static EHoudiniApiRecorderMode GetMode();
+
+		// Number of calls recorded or replayed since the recorder started.
+		static int32 GetCallCount();
+
+		// Number of replayed calls that were not found in the recording.
+		static int32 GetMissingCallCount();
+};
@@ -0,0 +1,504 @@
+/*
+* Copyright (c) <2021> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// List of the FHoudiniApi functions, and of the output buffers of their array arguments.
+// Must be kept in sync with HoudiniApi.h, the recorder shims every function in this list.
+//
+// HOUDINI_API_FUNCTION(Name)
+// HOUDINI_API_OUTPUT_ARRAY(Name, OutputArgIndex, CountArgIndex, AttributeInfoArgIndex)
+//		The output argument holds as many elements as the value of the count argument,
+//		multiplied by the tuple size of the HAPI_AttributeInfo argument if its index isn't -1.
+// HOUDINI_API_OUTPUT_FIXED(Name, OutputArgIndex, Count)
+//		The output argument always holds Count elements.
+//
+// Pointer arguments that are not listed here are treated as a single element.
+
+#ifdef HOUDINI_API_FUNCTION
+HOUDINI_API_FUNCTION(AddAttribute)
+HOUDINI_API_FUNCTION(AddGroup)
+HOUDINI_API_FUNCTION(AssetInfo_Create)
+HOUDINI_API_FUNCTION(AssetInfo_Init)
+HOUDINI_API_FUNCTION(AttributeInfo_Create)
+HOUDINI_API_FUNCTION(AttributeInfo_Init)
+HOUDINI_API_FUNCTION(BindCustomImplementation)
+HOUDINI_API_FUNCTION(CancelPDGCook)
+HOUDINI_API_FUNCTION(CheckForSpecificErrors)
+HOUDINI_API_FUNCTION(Cleanup)
+HOUDINI_API_FUNCTION(ClearConnectionError)
+HOUDINI_API_FUNCTION(CloseSession)
+HOUDINI_API_FUNCTION(CommitGeo)
+HOUDINI_API_FUNCTION(CommitWorkItems)
+HOUDINI_API_FUNCTION(CommitWorkitems)
+HOUDINI_API_FUNCTION(ComposeChildNodeList)
+HOUDINI_API_FUNCTION(ComposeNodeCookResult)
+HOUDINI_API_FUNCTION(ComposeObjectList)
+HOUDINI_API_FUNCTION(CompositorOptions_Create)
+HOUDINI_API_FUNCTION(CompositorOptions_Init)
+HOUDINI_API_FUNCTION(ConnectNodeInput)
+HOUDINI_API_FUNCTION(ConvertMatrixToEuler)
+HOUDINI_API_FUNCTION(ConvertMatrixToQuat)
+HOUDINI_API_FUNCTION(ConvertTransform)
+HOUDINI_API_FUNCTION(ConvertTransformEulerToMatrix)
+HOUDINI_API_FUNCTION(ConvertTransformQuatToMatrix)
+HOUDINI_API_FUNCTION(CookNode)
+HOUDINI_API_FUNCTION(CookOptions_AreEqual)
+HOUDINI_API_FUNCTION(CookOptions_Create)
+HOUDINI_API_FUNCTION(CookOptions_Init)
+HOUDINI_API_FUNCTION(CookPDG)
+HOUDINI_API_FUNCTION(CookPDGAllOutputs)
+HOUDINI_API_FUNCTION(CreateCustomSession)
+HOUDINI_API_FUNCTION(CreateHeightFieldInput)
+HOUDINI_API_FUNCTION(CreateHeightfieldInputVolumeNode)
+HOUDINI_API_FUNCTION(CreateInProcessSession)
+HOUDINI_API_FUNCTION(CreateInputCurveNode)
+HOUDINI_API_FUNCTION(CreateInputNode)
+HOUDINI_API_FUNCTION(CreateNode)
+HOUDINI_API_FUNCTION(CreateThriftNamedPipeSession)
+HOUDINI_API_FUNCTION(CreateThriftSocketSession)
+HOUDINI_API_FUNCTION(CreateWorkItem)
+HOUDINI_API_FUNCTION(CreateWorkitem)
+HOUDINI_API_FUNCTION(CurveInfo_Create)
+HOUDINI_API_FUNCTION(CurveInfo_Init)
+HOUDINI_API_FUNCTION(DeleteAttribute)
+HOUDINI_API_FUNCTION(DeleteGroup)
+HOUDINI_API_FUNCTION(DeleteNode)
+HOUDINI_API_FUNCTION(DirtyPDGNode)
+HOUDINI_API_FUNCTION(DisconnectNodeInput)
+HOUDINI_API_FUNCTION(DisconnectNodeOutputsAt)
+HOUDINI_API_FUNCTION(ExtractImageToFile)
+HOUDINI_API_FUNCTION(ExtractImageToMemory)
+HOUDINI_API_FUNCTION(GeoInfo_Create)
+HOUDINI_API_FUNCTION(GeoInfo_GetGroupCountByType)
+HOUDINI_API_FUNCTION(GeoInfo_Init)
+HOUDINI_API_FUNCTION(GetActiveCacheCount)
+HOUDINI_API_FUNCTION(GetActiveCacheNames)
+HOUDINI_API_FUNCTION(GetAssetDefinitionParmCounts)
+HOUDINI_API_FUNCTION(GetAssetDefinitionParmInfos)
+HOUDINI_API_FUNCTION(GetAssetDefinitionParmValues)
+HOUDINI_API_FUNCTION(GetAssetInfo)
+HOUDINI_API_FUNCTION(GetAssetLibraryFilePath)
+HOUDINI_API_FUNCTION(GetAssetLibraryIds)
+HOUDINI_API_FUNCTION(GetAttributeFloat64ArrayData)
+HOUDINI_API_FUNCTION(GetAttributeFloat64Data)
+HOUDINI_API_FUNCTION(GetAttributeFloatArrayData)
+HOUDINI_API_FUNCTION(GetAttributeFloatData)
+HOUDINI_API_FUNCTION(GetAttributeInfo)
+HOUDINI_API_FUNCTION(GetAttributeInt16ArrayData)
+HOUDINI_API_FUNCTION(GetAttributeInt16Data)
+HOUDINI_API_FUNCTION(GetAttributeInt64ArrayData)
+HOUDINI_API_FUNCTION(GetAttributeInt64Data)
+HOUDINI_API_FUNCTION(GetAttributeInt8ArrayData)
+HOUDINI_API_FUNCTION(GetAttributeInt8Data)
+HOUDINI_API_FUNCTION(GetAttributeIntArrayData)
+HOUDINI_API_FUNCTION(GetAttributeIntData)
+HOUDINI_API_FUNCTION(GetAttributeNames)
+HOUDINI_API_FUNCTION(GetAttributeStringArrayData)
+HOUDINI_API_FUNCTION(GetAttributeStringData)
+HOUDINI_API_FUNCTION(GetAttributeUInt8ArrayData)
+HOUDINI_API_FUNCTION(GetAttributeUInt8Data)
+HOUDINI_API_FUNCTION(GetAvailableAssetCount)
+HOUDINI_API_FUNCTION(GetAvailableAssets)
+HOUDINI_API_FUNCTION(GetBoxInfo)
+HOUDINI_API_FUNCTION(GetCacheProperty)
+HOUDINI_API_FUNCTION(GetComposedChildNodeList)
+HOUDINI_API_FUNCTION(GetComposedNodeCookResult)
+HOUDINI_API_FUNCTION(GetComposedObjectList)
+HOUDINI_API_FUNCTION(GetComposedObjectTransforms)
+HOUDINI_API_FUNCTION(GetCompositorOptions)
+HOUDINI_API_FUNCTION(GetConnectionError)
+HOUDINI_API_FUNCTION(GetConnectionErrorLength)
+HOUDINI_API_FUNCTION(GetCookingCurrentCount)
+HOUDINI_API_FUNCTION(GetCookingTotalCount)
+HOUDINI_API_FUNCTION(GetCurveCounts)
+HOUDINI_API_FUNCTION(GetCurveInfo)
+HOUDINI_API_FUNCTION(GetCurveKnots)
+HOUDINI_API_FUNCTION(GetCurveOrders)
+HOUDINI_API_FUNCTION(GetDisplayGeoInfo)
+HOUDINI_API_FUNCTION(GetEdgeCountOfEdgeGroup)
+HOUDINI_API_FUNCTION(GetEnvInt)
+HOUDINI_API_FUNCTION(GetFaceCounts)
+HOUDINI_API_FUNCTION(GetFirstVolumeTile)
+HOUDINI_API_FUNCTION(GetGeoInfo)
+HOUDINI_API_FUNCTION(GetGeoSize)
+HOUDINI_API_FUNCTION(GetGroupCountOnPackedInstancePart)
+HOUDINI_API_FUNCTION(GetGroupMembership)
+HOUDINI_API_FUNCTION(GetGroupMembershipOnPackedInstancePart)
+HOUDINI_API_FUNCTION(GetGroupNames)
+HOUDINI_API_FUNCTION(GetGroupNamesOnPackedInstancePart)
+HOUDINI_API_FUNCTION(GetHIPFileNodeCount)
+HOUDINI_API_FUNCTION(GetHIPFileNodeIds)
+HOUDINI_API_FUNCTION(GetHandleBindingInfo)
+HOUDINI_API_FUNCTION(GetHandleInfo)
+HOUDINI_API_FUNCTION(GetHeightFieldData)
+HOUDINI_API_FUNCTION(GetImageFilePath)
+HOUDINI_API_FUNCTION(GetImageInfo)
+HOUDINI_API_FUNCTION(GetImageMemoryBuffer)
+HOUDINI_API_FUNCTION(GetImagePlaneCount)
+HOUDINI_API_FUNCTION(GetImagePlanes)
+HOUDINI_API_FUNCTION(GetInputCurveInfo)
+HOUDINI_API_FUNCTION(GetInstanceTransformsOnPart)
+HOUDINI_API_FUNCTION(GetInstancedObjectIds)
+HOUDINI_API_FUNCTION(GetInstancedPartIds)
+HOUDINI_API_FUNCTION(GetInstancerPartTransforms)
+HOUDINI_API_FUNCTION(GetLoadedAssetLibraryCount)
+HOUDINI_API_FUNCTION(GetManagerNodeId)
+HOUDINI_API_FUNCTION(GetMaterialInfo)
+HOUDINI_API_FUNCTION(GetMaterialNodeIdsOnFaces)
+HOUDINI_API_FUNCTION(GetNextVolumeTile)
+HOUDINI_API_FUNCTION(GetNodeFromPath)
+HOUDINI_API_FUNCTION(GetNodeInfo)
+HOUDINI_API_FUNCTION(GetNodeInputName)
+HOUDINI_API_FUNCTION(GetNodeOutputName)
+HOUDINI_API_FUNCTION(GetNodePath)
+HOUDINI_API_FUNCTION(GetNumWorkItems)
+HOUDINI_API_FUNCTION(GetNumWorkitems)
+HOUDINI_API_FUNCTION(GetObjectInfo)
+HOUDINI_API_FUNCTION(GetObjectTransform)
+HOUDINI_API_FUNCTION(GetOutputGeoCount)
+HOUDINI_API_FUNCTION(GetOutputGeoInfos)
+HOUDINI_API_FUNCTION(GetOutputNodeId)
+HOUDINI_API_FUNCTION(GetPDGEvents)
+HOUDINI_API_FUNCTION(GetPDGGraphContextId)
+HOUDINI_API_FUNCTION(GetPDGGraphContexts)
+HOUDINI_API_FUNCTION(GetPDGGraphContextsCount)
+HOUDINI_API_FUNCTION(GetPDGState)
+HOUDINI_API_FUNCTION(GetParameters)
+HOUDINI_API_FUNCTION(GetParmChoiceLists)
+HOUDINI_API_FUNCTION(GetParmExpression)
+HOUDINI_API_FUNCTION(GetParmFile)
+HOUDINI_API_FUNCTION(GetParmFloatValue)
+HOUDINI_API_FUNCTION(GetParmFloatValues)
+HOUDINI_API_FUNCTION(GetParmIdFromName)
+HOUDINI_API_FUNCTION(GetParmInfo)
+HOUDINI_API_FUNCTION(GetParmInfoFromName)
+HOUDINI_API_FUNCTION(GetParmIntValue)
+HOUDINI_API_FUNCTION(GetParmIntValues)
+HOUDINI_API_FUNCTION(GetParmNodeValue)
+HOUDINI_API_FUNCTION(GetParmStringValue)
+HOUDINI_API_FUNCTION(GetParmStringValues)
+HOUDINI_API_FUNCTION(GetParmTagName)
+HOUDINI_API_FUNCTION(GetParmTagValue)
+HOUDINI_API_FUNCTION(GetParmWithTag)
+HOUDINI_API_FUNCTION(GetPartInfo)
+HOUDINI_API_FUNCTION(GetPreset)
+HOUDINI_API_FUNCTION(GetPresetBufLength)
+HOUDINI_API_FUNCTION(GetServerEnvInt)
+HOUDINI_API_FUNCTION(GetServerEnvString)
+HOUDINI_API_FUNCTION(GetServerEnvVarCount)
+HOUDINI_API_FUNCTION(GetServerEnvVarList)
+HOUDINI_API_FUNCTION(GetSessionEnvInt)
+HOUDINI_API_FUNCTION(GetSessionSyncInfo)
+HOUDINI_API_FUNCTION(GetSphereInfo)
+HOUDINI_API_FUNCTION(GetStatus)
+HOUDINI_API_FUNCTION(GetStatusString)
+HOUDINI_API_FUNCTION(GetStatusStringBufLength)
+HOUDINI_API_FUNCTION(GetString)
+HOUDINI_API_FUNCTION(GetStringBatch)
+HOUDINI_API_FUNCTION(GetStringBatchSize)
+HOUDINI_API_FUNCTION(GetStringBufLength)
+HOUDINI_API_FUNCTION(GetSupportedImageFileFormatCount)
+HOUDINI_API_FUNCTION(GetSupportedImageFileFormats)
+HOUDINI_API_FUNCTION(GetTime)
+HOUDINI_API_FUNCTION(GetTimelineOptions)
+HOUDINI_API_FUNCTION(GetTotalCookCount)
+HOUDINI_API_FUNCTION(GetUseHoudiniTime)
+HOUDINI_API_FUNCTION(GetVertexList)
+HOUDINI_API_FUNCTION(GetViewport)
+HOUDINI_API_FUNCTION(GetVolumeBounds)
+HOUDINI_API_FUNCTION(GetVolumeInfo)
+HOUDINI_API_FUNCTION(GetVolumeTileFloatData)
+HOUDINI_API_FUNCTION(GetVolumeTileIntData)
+HOUDINI_API_FUNCTION(GetVolumeVisualInfo)
+HOUDINI_API_FUNCTION(GetVolumeVoxelFloatData)
+HOUDINI_API_FUNCTION(GetVolumeVoxelIntData)
+HOUDINI_API_FUNCTION(GetWorkItemAttributeSize)
+HOUDINI_API_FUNCTION(GetWorkItemFloatAttribute)
+HOUDINI_API_FUNCTION(GetWorkItemInfo)
+HOUDINI_API_FUNCTION(GetWorkItemIntAttribute)
+HOUDINI_API_FUNCTION(GetWorkItemOutputFiles)
+HOUDINI_API_FUNCTION(GetWorkItemStringAttribute)
+HOUDINI_API_FUNCTION(GetWorkItems)
+HOUDINI_API_FUNCTION(GetWorkitemDataLength)
+HOUDINI_API_FUNCTION(GetWorkitemFloatData)
+HOUDINI_API_FUNCTION(GetWorkitemInfo)
+HOUDINI_API_FUNCTION(GetWorkitemIntData)
+HOUDINI_API_FUNCTION(GetWorkitemResultInfo)
+HOUDINI_API_FUNCTION(GetWorkitemStringData)
+HOUDINI_API_FUNCTION(GetWorkitems)
+HOUDINI_API_FUNCTION(HandleBindingInfo_Create)
+HOUDINI_API_FUNCTION(HandleBindingInfo_Init)
+HOUDINI_API_FUNCTION(HandleInfo_Create)
+HOUDINI_API_FUNCTION(HandleInfo_Init)
+HOUDINI_API_FUNCTION(ImageFileFormat_Create)
+HOUDINI_API_FUNCTION(ImageFileFormat_Init)
+HOUDINI_API_FUNCTION(ImageInfo_Create)
+HOUDINI_API_FUNCTION(ImageInfo_Init)
+HOUDINI_API_FUNCTION(Initialize)
+HOUDINI_API_FUNCTION(InputCurveInfo_Create)
+HOUDINI_API_FUNCTION(InputCurveInfo_Init)
+HOUDINI_API_FUNCTION(InsertMultiparmInstance)
+HOUDINI_API_FUNCTION(Interrupt)
+HOUDINI_API_FUNCTION(IsInitialized)
+HOUDINI_API_FUNCTION(IsNodeValid)
+HOUDINI_API_FUNCTION(IsSessionValid)
+HOUDINI_API_FUNCTION(Keyframe_Create)
+HOUDINI_API_FUNCTION(Keyframe_Init)
+HOUDINI_API_FUNCTION(LoadAssetLibraryFromFile)
+HOUDINI_API_FUNCTION(LoadAssetLibraryFromMemory)
+HOUDINI_API_FUNCTION(LoadGeoFromFile)
+HOUDINI_API_FUNCTION(LoadGeoFromMemory)
+HOUDINI_API_FUNCTION(LoadHIPFile)
+HOUDINI_API_FUNCTION(LoadNodeFromFile)
+HOUDINI_API_FUNCTION(MaterialInfo_Create)
+HOUDINI_API_FUNCTION(MaterialInfo_Init)
+HOUDINI_API_FUNCTION(MergeHIPFile)
+HOUDINI_API_FUNCTION(NodeInfo_Create)
+HOUDINI_API_FUNCTION(NodeInfo_Init)
+HOUDINI_API_FUNCTION(ObjectInfo_Create)
+HOUDINI_API_FUNCTION(ObjectInfo_Init)
+HOUDINI_API_FUNCTION(ParmChoiceInfo_Create)
+HOUDINI_API_FUNCTION(ParmChoiceInfo_Init)
+HOUDINI_API_FUNCTION(ParmHasExpression)
+HOUDINI_API_FUNCTION(ParmHasTag)
+HOUDINI_API_FUNCTION(ParmInfo_Create)
+HOUDINI_API_FUNCTION(ParmInfo_GetFloatValueCount)
+HOUDINI_API_FUNCTION(ParmInfo_GetIntValueCount)
+HOUDINI_API_FUNCTION(ParmInfo_GetStringValueCount)
+HOUDINI_API_FUNCTION(ParmInfo_Init)
+HOUDINI_API_FUNCTION(ParmInfo_IsFloat)
+HOUDINI_API_FUNCTION(ParmInfo_IsInt)
+HOUDINI_API_FUNCTION(ParmInfo_IsNode)
+HOUDINI_API_FUNCTION(ParmInfo_IsNonValue)
+HOUDINI_API_FUNCTION(ParmInfo_IsPath)
+HOUDINI_API_FUNCTION(ParmInfo_IsString)
+HOUDINI_API_FUNCTION(PartInfo_Create)
+HOUDINI_API_FUNCTION(PartInfo_GetAttributeCountByOwner)
+HOUDINI_API_FUNCTION(PartInfo_GetElementCountByAttributeOwner)
+HOUDINI_API_FUNCTION(PartInfo_GetElementCountByGroupType)
+HOUDINI_API_FUNCTION(PartInfo_Init)
+HOUDINI_API_FUNCTION(PausePDGCook)
+HOUDINI_API_FUNCTION(PythonThreadInterpreterLock)
+HOUDINI_API_FUNCTION(QueryNodeInput)
+HOUDINI_API_FUNCTION(QueryNodeOutputConnectedCount)
+HOUDINI_API_FUNCTION(QueryNodeOutputConnectedNodes)
+HOUDINI_API_FUNCTION(RemoveCustomString)
+HOUDINI_API_FUNCTION(RemoveMultiparmInstance)
+HOUDINI_API_FUNCTION(RemoveParmExpression)
+HOUDINI_API_FUNCTION(RenameNode)
+HOUDINI_API_FUNCTION(RenderCOPToImage)
+HOUDINI_API_FUNCTION(RenderTextureToImage)
+HOUDINI_API_FUNCTION(ResetSimulation)
+HOUDINI_API_FUNCTION(RevertGeo)
+HOUDINI_API_FUNCTION(RevertParmToDefault)
+HOUDINI_API_FUNCTION(RevertParmToDefaults)
+HOUDINI_API_FUNCTION(SaveGeoToFile)
+HOUDINI_API_FUNCTION(SaveGeoToMemory)
+HOUDINI_API_FUNCTION(SaveHIPFile)
+HOUDINI_API_FUNCTION(SaveNodeToFile)
+HOUDINI_API_FUNCTION(SessionSyncInfo_Create)
+HOUDINI_API_FUNCTION(SetAnimCurve)
+HOUDINI_API_FUNCTION(SetAttributeFloat64ArrayData)
+HOUDINI_API_FUNCTION(SetAttributeFloat64Data)
+HOUDINI_API_FUNCTION(SetAttributeFloat64UniqueData)
+HOUDINI_API_FUNCTION(SetAttributeFloatArrayData)
+HOUDINI_API_FUNCTION(SetAttributeFloatData)
+HOUDINI_API_FUNCTION(SetAttributeFloatUniqueData)
+HOUDINI_API_FUNCTION(SetAttributeIndexedStringData)
+HOUDINI_API_FUNCTION(SetAttributeInt16ArrayData)
+HOUDINI_API_FUNCTION(SetAttributeInt16Data)
+HOUDINI_API_FUNCTION(SetAttributeInt16UniqueData)
+HOUDINI_API_FUNCTION(SetAttributeInt64ArrayData)
+HOUDINI_API_FUNCTION(SetAttributeInt64Data)
+HOUDINI_API_FUNCTION(SetAttributeInt64UniqueData)
+HOUDINI_API_FUNCTION(SetAttributeInt8ArrayData)
+HOUDINI_API_FUNCTION(SetAttributeInt8Data)
+HOUDINI_API_FUNCTION(SetAttributeInt8UniqueData)
+HOUDINI_API_FUNCTION(SetAttributeIntArrayData)
+HOUDINI_API_FUNCTION(SetAttributeIntData)
+HOUDINI_API_FUNCTION(SetAttributeIntUniqueData)
+HOUDINI_API_FUNCTION(SetAttributeStringArrayData)
+HOUDINI_API_FUNCTION(SetAttributeStringData)
+HOUDINI_API_FUNCTION(SetAttributeStringUniqueData)
+HOUDINI_API_FUNCTION(SetAttributeUInt8ArrayData)
+HOUDINI_API_FUNCTION(SetAttributeUInt8Data)
+HOUDINI_API_FUNCTION(SetAttributeUInt8UniqueData)
+HOUDINI_API_FUNCTION(SetCacheProperty)
+HOUDINI_API_FUNCTION(SetCompositorOptions)
+HOUDINI_API_FUNCTION(SetCurveCounts)
+HOUDINI_API_FUNCTION(SetCurveInfo)
+HOUDINI_API_FUNCTION(SetCurveKnots)
+HOUDINI_API_FUNCTION(SetCurveOrders)
+HOUDINI_API_FUNCTION(SetCustomString)
+HOUDINI_API_FUNCTION(SetFaceCounts)
+HOUDINI_API_FUNCTION(SetGroupMembership)
+HOUDINI_API_FUNCTION(SetHeightFieldData)
+HOUDINI_API_FUNCTION(SetImageInfo)
+HOUDINI_API_FUNCTION(SetInputCurveInfo)
+HOUDINI_API_FUNCTION(SetInputCurvePositions)
+HOUDINI_API_FUNCTION(SetInputCurvePositionsRotationsScales)
+HOUDINI_API_FUNCTION(SetNodeDisplay)
+HOUDINI_API_FUNCTION(SetObjectTransform)
+HOUDINI_API_FUNCTION(SetParmExpression)
+HOUDINI_API_FUNCTION(SetParmFloatValue)
+HOUDINI_API_FUNCTION(SetParmFloatValues)
+HOUDINI_API_FUNCTION(SetParmIntValue)
+HOUDINI_API_FUNCTION(SetParmIntValues)
+HOUDINI_API_FUNCTION(SetParmNodeValue)
+HOUDINI_API_FUNCTION(SetParmStringValue)
+HOUDINI_API_FUNCTION(SetPartInfo)
+HOUDINI_API_FUNCTION(SetPreset)
+HOUDINI_API_FUNCTION(SetServerEnvInt)
+HOUDINI_API_FUNCTION(SetServerEnvString)
+HOUDINI_API_FUNCTION(SetSessionSync)
+HOUDINI_API_FUNCTION(SetSessionSyncInfo)
+HOUDINI_API_FUNCTION(SetTime)
+HOUDINI_API_FUNCTION(SetTimelineOptions)
+HOUDINI_API_FUNCTION(SetTransformAnimCurve)
+HOUDINI_API_FUNCTION(SetUseHoudiniTime)
+HOUDINI_API_FUNCTION(SetVertexList)
+HOUDINI_API_FUNCTION(SetViewport)
+HOUDINI_API_FUNCTION(SetVolumeInfo)
+HOUDINI_API_FUNCTION(SetVolumeTileFloatData)
+HOUDINI_API_FUNCTION(SetVolumeTileIntData)
+HOUDINI_API_FUNCTION(SetVolumeVoxelFloatData)
+HOUDINI_API_FUNCTION(SetVolumeVoxelIntData)
+HOUDINI_API_FUNCTION(SetWorkItemFloatAttribute)
+HOUDINI_API_FUNCTION(SetWorkItemIntAttribute)
+HOUDINI_API_FUNCTION(SetWorkItemStringAttribute)
+HOUDINI_API_FUNCTION(SetWorkitemFloatData)
+HOUDINI_API_FUNCTION(SetWorkitemIntData)
+HOUDINI_API_FUNCTION(SetWorkitemStringData)
+HOUDINI_API_FUNCTION(Shutdown)
+HOUDINI_API_FUNCTION(StartThriftNamedPipeServer)
+HOUDINI_API_FUNCTION(StartThriftSocketServer)
+HOUDINI_API_FUNCTION(ThriftServerOptions_Create)
+HOUDINI_API_FUNCTION(ThriftServerOptions_Init)
+HOUDINI_API_FUNCTION(TimelineOptions_Create)
+HOUDINI_API_FUNCTION(TimelineOptions_Init)
+HOUDINI_API_FUNCTION(TransformEuler_Create)
+HOUDINI_API_FUNCTION(TransformEuler_Init)
+HOUDINI_API_FUNCTION(Transform_Create)
+HOUDINI_API_FUNCTION(Transform_Init)
+HOUDINI_API_FUNCTION(Viewport_Create)
+HOUDINI_API_FUNCTION(VolumeInfo_Create)
+HOUDINI_API_FUNCTION(VolumeInfo_Init)
+HOUDINI_API_FUNCTION(VolumeTileInfo_Create)
+HOUDINI_API_FUNCTION(VolumeTileInfo_Init)
+#endif
+
+#if defined(HOUDINI_API_OUTPUT_ARRAY) && defined(HOUDINI_API_OUTPUT_FIXED)
+HOUDINI_API_OUTPUT_FIXED(ConvertTransformEulerToMatrix, 2, 16)
+HOUDINI_API_OUTPUT_FIXED(ConvertTransformQuatToMatrix, 2, 16)
+HOUDINI_API_OUTPUT_ARRAY(GetActiveCacheNames, 1, 2, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAssetDefinitionParmInfos, 3, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAssetDefinitionParmValues, 3, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAssetDefinitionParmValues, 6, 8, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAssetDefinitionParmValues, 10, 12, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAssetDefinitionParmValues, 13, 15, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAssetLibraryIds, 1, 3, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeFloat64ArrayData, 5, 6, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeFloat64ArrayData, 7, 9, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeFloat64Data, 6, 8, 4)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeFloatArrayData, 5, 6, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeFloatArrayData, 7, 9, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeFloatData, 6, 8, 4)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeInt16ArrayData, 5, 6, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeInt16ArrayData, 7, 9, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeInt16Data, 6, 8, 4)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeInt64ArrayData, 5, 6, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeInt64ArrayData, 7, 9, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeInt64Data, 6, 8, 4)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeInt8ArrayData, 5, 6, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeInt8ArrayData, 7, 9, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeInt8Data, 6, 8, 4)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeIntArrayData, 5, 6, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeIntArrayData, 7, 9, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeIntData, 6, 8, 4)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeNames, 4, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeStringArrayData, 5, 6, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeStringArrayData, 7, 9, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeStringData, 5, 7, 4)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeUInt8ArrayData, 5, 6, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeUInt8ArrayData, 7, 9, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetAttributeUInt8Data, 6, 8, 4)
+HOUDINI_API_OUTPUT_ARRAY(GetAvailableAssets, 2, 3, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetComposedChildNodeList, 2, 3, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetComposedNodeCookResult, 1, 2, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetComposedObjectList, 2, 4, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetComposedObjectTransforms, 3, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetConnectionError, 0, 1, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetCurveCounts, 3, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetCurveKnots, 3, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetCurveOrders, 3, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetFaceCounts, 3, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetGroupMembership, 6, 8, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetGroupMembershipOnPackedInstancePart, 6, 8, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetGroupNames, 3, 4, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetGroupNamesOnPackedInstancePart, 4, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetHIPFileNodeIds, 2, 3, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetHandleBindingInfo, 3, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetHandleInfo, 2, 4, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetHeightFieldData, 3, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetImageMemoryBuffer, 2, 3, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetImagePlanes, 2, 3, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetInstanceTransformsOnPart, 4, 6, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetInstancedObjectIds, 2, 4, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetInstancedPartIds, 3, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetInstancerPartTransforms, 4, 6, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetMaterialNodeIdsOnFaces, 4, 6, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetOutputGeoInfos, 2, 3, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetPDGEvents, 2, 3, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetPDGGraphContexts, 1, 4, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetPDGGraphContexts, 2, 4, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetParameters, 2, 4, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetParmChoiceLists, 2, 4, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetParmFloatValues, 2, 4, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetParmIntValues, 2, 4, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetParmStringValues, 3, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetPreset, 2, 3, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetServerEnvVarList, 1, 3, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetStatusString, 2, 3, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetString, 2, 3, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetStringBatch, 1, 2, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetSupportedImageFileFormats, 1, 2, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetVertexList, 3, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetVolumeTileFloatData, 5, 6, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetVolumeTileIntData, 5, 6, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetVolumeVoxelFloatData, 6, 7, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetVolumeVoxelIntData, 6, 7, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetWorkItemFloatAttribute, 4, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetWorkItemIntAttribute, 4, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetWorkItemOutputFiles, 3, 4, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetWorkItemStringAttribute, 4, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetWorkItems, 2, 3, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetWorkitemFloatData, 4, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetWorkitemIntData, 4, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetWorkitemResultInfo, 3, 4, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetWorkitemStringData, 4, 5, -1)
+HOUDINI_API_OUTPUT_ARRAY(GetWorkitems, 2, 3, -1)
+HOUDINI_API_OUTPUT_ARRAY(QueryNodeOutputConnectedNodes, 5, 7, -1)
+HOUDINI_API_OUTPUT_ARRAY(SaveGeoToMemory, 2, 3, -1)
+#endif
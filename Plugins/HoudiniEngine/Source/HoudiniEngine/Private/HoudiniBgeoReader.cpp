@@ -0,0 +1,2035 @@
+/*
+* Copyright (c) <2021> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "HoudiniBgeoReader.h"
+
+#include "HoudiniEnginePrivatePCH.h"
+#include "HoudiniEngineUtils.h"
+#include "HoudiniGeoPartObject.h"
+
+#include "Algo/Reverse.h"
+#include "Math/Float16.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+
+// Token ids of the binary JSON format
+enum EHoudiniBJsonId : uint8
+{
+	HJID_NULL = 0x00,
+	HJID_MAP_BEGIN = 0x7b,
+	HJID_MAP_END = 0x7d,
+	HJID_ARRAY_BEGIN = 0x5b,
+	HJID_ARRAY_END = 0x5d,
+	HJID_BOOL = 0x10,
+	HJID_INT8 = 0x11,
+	HJID_INT16 = 0x12,
+	HJID_INT32 = 0x13,
+	HJID_INT64 = 0x14,
+	HJID_REAL16 = 0x18,
+	HJID_REAL32 = 0x19,
+	HJID_REAL64 = 0x1a,
+	HJID_UINT8 = 0x21,
+	HJID_UINT16 = 0x22,
+	HJID_STRING = 0x27,
+	HJID_FALSE = 0x30,
+	HJID_TRUE = 0x31,
+	HJID_TOKENDEF = 0x2b,
+	HJID_TOKENREF = 0x26,
+	HJID_TOKENUNDEF = 0x2d,
+	HJID_UNIFORM_ARRAY = 0x40,
+	HJID_KEY_SEPARATOR = 0x3a,
+	HJID_VALUE_SEPARATOR = 0x2c,
+	HJID_MAGIC = 0x7f
+};
+
+// Magic number following HJID_MAGIC at the start of binary files ('bJSN')
+#define HOUDINI_BJSON_MAGIC 0x624a534e
+
+// Maximum nesting of JSON values
+#define HOUDINI_BGEO_MAX_DEPTH 256
+
+// Voxels are stored in tiles of 16x16x16
+#define HOUDINI_BGEO_VOLUME_TILE_SIZE 16
+
+// Blosc chunk header flags
+#define HOUDINI_BLOSC_HEADER_SIZE 16
+#define HOUDINI_BLOSC_DOSHUFFLE 0x01
+#define HOUDINI_BLOSC_MEMCPYED 0x02
+#define HOUDINI_BLOSC_DOBITSHUFFLE 0x04
+#define HOUDINI_BLOSC_DONT_SPLIT 0x10
+#define HOUDINI_BLOSC_MAX_SPLITS 16
+#define HOUDINI_BLOSC_MIN_BUFFERSIZE 128
+
+int64
+FHoudiniBgeoValue::AsInt() const
+{
+	if (Type == EType::Real)
+		return (int64)Real;
+
+	return Int;
+}
+
+double
+FHoudiniBgeoValue::AsReal() const
+{
+	if (Type == EType::Real)
+		return Real;
+
+	return (double)Int;
+}
+
+int32
+FHoudiniBgeoValue::Num() const
+{
+	switch (Type)
+	{
+	case EType::Array:
+	case EType::Map:
+		return Values.Num();
+	case EType::IntArray:
+		return Ints.Num();
+	case EType::RealArray:
+		return Reals.Num();
+	default:
+		return 0;
+	}
+}
+
+double
+FHoudiniBgeoValue::RealAt(const int32& InIndex) const
+{
+	switch (Type)
+	{
+	case EType::IntArray:
+		return (double)Ints[InIndex];
+	case EType::RealArray:
+		return Reals[InIndex];
+	case EType::Array:
+		return Values[InIndex].AsReal();
+	default:
+		return 0.0;
+	}
+}
+
+const FHoudiniBgeoValue*
+FHoudiniBgeoValue::Find(const TCHAR* InKey) const
+{
+	if (Type == EType::Map)
+	{
+		const int32 Index = Keys.IndexOfByKey(InKey);
+		return Index != INDEX_NONE ? &Values[Index] : nullptr;
+	}
+
+	if (Type == EType::Array)
+	{
+		for (int32 Index = 0; Index + 1 < Values.Num(); Index += 2)
+		{
+			if (Values[Index].IsString() && Values[Index].String == InKey)
+				return &Values[Index + 1];
+		}
+	}
+
+	return nullptr;
+}
+
+const FHoudiniBgeoAttribute*
+FHoudiniBgeoGeometry::FindAttribute(const FString& InName, const HAPI_AttributeOwner& InOwner) const
+{
+	return Attributes.FindByPredicate([&InName, &InOwner](const FHoudiniBgeoAttribute& Attribute)
+	{
+		return Attribute.Owner == InOwner && Attribute.Name == InName;
+	});
+}
+
+int32
+FHoudiniBgeoGeometry::GetAttributeCount(const HAPI_AttributeOwner& InOwner) const
+{
+	int32 Count = 0;
+	for (const FHoudiniBgeoAttribute& Attribute : Attributes)
+	{
+		if (Attribute.Owner == InOwner)
+			Count++;
+	}
+
+	return Count;
+}
+
+// Packs arrays that only contain numbers, so large arrays of the ASCII format take as little memory as uniform
+// arrays of the binary format
+static void
+PackBgeoNumbers(FHoudiniBgeoValue& InOutValue)
+{
+	if (InOutValue.Type != FHoudiniBgeoValue::EType::Array || InOutValue.Values.Num() == 0)
+		return;
+
+	bool bHasReals = false;
+	for (const FHoudiniBgeoValue& Element : InOutValue.Values)
+	{
+		if (!Element.IsNumber())
+			return;
+
+		bHasReals |= (Element.Type == FHoudiniBgeoValue::EType::Real);
+	}
+
+	if (bHasReals)
+	{
+		InOutValue.Reals.SetNumUninitialized(InOutValue.Values.Num());
+		for (int32 Index = 0; Index < InOutValue.Values.Num(); Index++)
+			InOutValue.Reals[Index] = InOutValue.Values[Index].AsReal();
+		InOutValue.Type = FHoudiniBgeoValue::EType::RealArray;
+	}
+	else
+	{
+		InOutValue.Ints.SetNumUninitialized(InOutValue.Values.Num());
+		for (int32 Index = 0; Index < InOutValue.Values.Num(); Index++)
+			InOutValue.Ints[Index] = InOutValue.Values[Index].AsInt();
+		InOutValue.Type = FHoudiniBgeoValue::EType::IntArray;
+	}
+
+	InOutValue.Values.Empty();
+}
+
+//
+// Binary JSON
+//
+
+struct FHoudiniBJsonParser
+{
+	FHoudiniBJsonParser(const uint8* InData, const int64& InSize)
+		: Data(InData)
+		, Size(InSize)
+	{}
+
+	bool
+	ReadBytes(void* OutData, const int64& InCount)
+	{
+		if (InCount < 0 || InCount > Size - Position)
+			return false;
+
+		FMemory::Memcpy(OutData, Data + Position, InCount);
+		Position += InCount;
+		return true;
+	}
+
+	template<typename T>
+	bool
+	Read(T& OutValue)
+	{
+		if (!ReadBytes(&OutValue, sizeof(T)))
+			return false;
+
+		if (bSwapBytes && sizeof(T) > 1)
+			Algo::Reverse((uint8*)&OutValue, sizeof(T));
+
+		return true;
+	}
+
+	bool
+	ReadLength(int64& OutLength)
+	{
+		uint8 Byte = 0;
+		if (!Read(Byte))
+			return false;
+
+		if (Byte < 0xf1)
+		{
+			OutLength = Byte;
+			return true;
+		}
+		else if (Byte == 0xf2)
+		{
+			uint16 Length = 0;
+			if (!Read(Length))
+				return false;
+			OutLength = Length;
+			return true;
+		}
+		else if (Byte == 0xf4)
+		{
+			uint32 Length = 0;
+			if (!Read(Length))
+				return false;
+			OutLength = Length;
+			return true;
+		}
+		else if (Byte == 0xf8)
+		{
+			uint64 Length = 0;
+			if (!Read(Length))
+				return false;
+			OutLength = (int64)Length;
+			return OutLength >= 0;
+		}
+
+		return false;
+	}
+
+	bool
+	ReadString(FString& OutString)
+	{
+		int64 Length = 0;
+		if (!ReadLength(Length) || Length > Size - Position)
+			return false;
+
+		FUTF8ToTCHAR Converted((const ANSICHAR*)(Data + Position), (int32)Length);
+		OutString = FString(Converted.Length(), Converted.Get());
+		Position += Length;
+		return true;
+	}
+
+	// Reads the id of the next value, handling the token definitions in between
+	bool
+	ReadId(uint8& OutId)
+	{
+		while (Read(OutId))
+		{
+			if (OutId == HJID_TOKENDEF)
+			{
+				int64 TokenId = 0;
+				FString Token;
+				if (!ReadLength(TokenId) || !ReadString(Token))
+					return false;
+				Tokens.Add(TokenId, MoveTemp(Token));
+			}
+			else if (OutId == HJID_TOKENUNDEF)
+			{
+				int64 TokenId = 0;
+				if (!ReadLength(TokenId))
+					return false;
+				Tokens.Remove(TokenId);
+			}
+			else if (OutId != HJID_KEY_SEPARATOR && OutId != HJID_VALUE_SEPARATOR)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool
+	ReadTokenRef(FString& OutString)
+	{
+		int64 TokenId = 0;
+		if (!ReadLength(TokenId))
+			return false;
+
+		const FString* Token = Tokens.Find(TokenId);
+		if (!Token)
+			return false;
+
+		OutString = *Token;
+		return true;
+	}
+
+	// Counts come from the file: they have to fit in a TArray and in the data left to read.
+	// InElementsPerWord elements are packed in each word of InBytesPerWord bytes.
+	bool
+	CheckCount(const int64& InCount, const int64& InBytesPerWord, const int64& InElementsPerWord = 1) const
+	{
+		if (InCount < 0 || InCount > MAX_int32
+			|| (InCount + InElementsPerWord - 1) / InElementsPerWord * InBytesPerWord > Size - Position)
+		{
+			HOUDINI_LOG_ERROR(TEXT("Invalid array of %lld elements at offset %lld."), InCount, Position);
+			return false;
+		}
+
+		return true;
+	}
+
+	template<typename TSource, typename TDest>
+	bool
+	ReadUniformValues(const int64& InCount, TArray<TDest>& OutValues)
+	{
+		if (!CheckCount(InCount, sizeof(TSource)))
+			return false;
+
+		OutValues.SetNumUninitialized(InCount);
+		for (int64 Index = 0; Index < InCount; Index++)
+		{
+			TSource Value;
+			Read(Value);
+			OutValues[Index] = (TDest)Value;
+		}
+
+		return true;
+	}
+
+	bool
+	ReadUniformArray(FHoudiniBgeoValue& OutValue)
+	{
+		uint8 ElementId = 0;
+		int64 Count = 0;
+		if (!Read(ElementId) || !ReadLength(Count))
+			return false;
+
+		OutValue.Type = FHoudiniBgeoValue::EType::IntArray;
+		switch (ElementId)
+		{
+		case HJID_BOOL:
+		case HJID_FALSE:
+		case HJID_TRUE:
+		{
+			// Bits packed in 32 bit words
+			if (!CheckCount(Count, sizeof(uint32), 32))
+				return false;
+
+			OutValue.Ints.SetNumZeroed(Count);
+			for (int64 Word = 0; Word * 32 < Count; Word++)
+			{
+				uint32 Bits = 0;
+				if (!Read(Bits))
+					return false;
+				for (int64 Bit = 0; Bit < 32 && Word * 32 + Bit < Count; Bit++)
+					OutValue.Ints[Word * 32 + Bit] = (Bits >> Bit) & 1;
+			}
+			return true;
+		}
+		case HJID_INT8:
+			return ReadUniformValues<int8>(Count, OutValue.Ints);
+		case HJID_INT16:
+			return ReadUniformValues<int16>(Count, OutValue.Ints);
+		case HJID_INT32:
+			return ReadUniformValues<int32>(Count, OutValue.Ints);
+		case HJID_INT64:
+			return ReadUniformValues<int64>(Count, OutValue.Ints);
+		case HJID_UINT8:
+			return ReadUniformValues<uint8>(Count, OutValue.Ints);
+		case HJID_UINT16:
+			return ReadUniformValues<uint16>(Count, OutValue.Ints);
+		case HJID_REAL16:
+		{
+			OutValue.Type = FHoudiniBgeoValue::EType::RealArray;
+			TArray<uint16> Halves;
+			if (!ReadUniformValues<uint16>(Count, Halves))
+				return false;
+			OutValue.Reals.SetNumUninitialized(Count);
+			for (int64 Index = 0; Index < Count; Index++)
+			{
+				FFloat16 Half;
+				Half.Encoded = Halves[Index];
+				OutValue.Reals[Index] = Half.GetFloat();
+			}
+			return true;
+		}
+		case HJID_REAL32:
+			OutValue.Type = FHoudiniBgeoValue::EType::RealArray;
+			return ReadUniformValues<float>(Count, OutValue.Reals);
+		case HJID_REAL64:
+			OutValue.Type = FHoudiniBgeoValue::EType::RealArray;
+			return ReadUniformValues<double>(Count, OutValue.Reals);
+		default:
+			return false;
+		}
+	}
+
+	bool
+	ParseValue(const uint8& InId, FHoudiniBgeoValue& OutValue, const int32& InDepth)
+	{
+		if (InDepth > HOUDINI_BGEO_MAX_DEPTH)
+			return false;
+
+		switch (InId)
+		{
+		case HJID_NULL:
+			OutValue.Type = FHoudiniBgeoValue::EType::Null;
+			return true;
+		case HJID_FALSE:
+		case HJID_TRUE:
+			OutValue.Type = FHoudiniBgeoValue::EType::Bool;
+			OutValue.Int = (InId == HJID_TRUE) ? 1 : 0;
+			return true;
+		case HJID_BOOL:
+		{
+			uint8 Value = 0;
+			OutValue.Type = FHoudiniBgeoValue::EType::Bool;
+			if (!Read(Value))
+				return false;
+			OutValue.Int = Value ? 1 : 0;
+			return true;
+		}
+		case HJID_INT8:
+		{
+			int8 Value = 0;
+			OutValue.Type = FHoudiniBgeoValue::EType::Int;
+			if (!Read(Value))
+				return false;
+			OutValue.Int = Value;
+			return true;
+		}
+		case HJID_INT16:
+		{
+			int16 Value = 0;
+			OutValue.Type = FHoudiniBgeoValue::EType::Int;
+			if (!Read(Value))
+				return false;
+			OutValue.Int = Value;
+			return true;
+		}
+		case HJID_INT32:
+		{
+			int32 Value = 0;
+			OutValue.Type = FHoudiniBgeoValue::EType::Int;
+			if (!Read(Value))
+				return false;
+			OutValue.Int = Value;
+			return true;
+		}
+		case HJID_INT64:
+			OutValue.Type = FHoudiniBgeoValue::EType::Int;
+			return Read(OutValue.Int);
+		case HJID_UINT8:
+		{
+			uint8 Value = 0;
+			OutValue.Type = FHoudiniBgeoValue::EType::Int;
+			if (!Read(Value))
+				return false;
+			OutValue.Int = Value;
+			return true;
+		}
+		case HJID_UINT16:
+		{
+			uint16 Value = 0;
+			OutValue.Type = FHoudiniBgeoValue::EType::Int;
+			if (!Read(Value))
+				return false;
+			OutValue.Int = Value;
+			return true;
+		}
+		case HJID_REAL16:
+		{
+			FFloat16 Value;
+			OutValue.Type = FHoudiniBgeoValue::EType::Real;
+			if (!Read(Value.Encoded))
+				return false;
+			OutValue.Real = Value.GetFloat();
+			return true;
+		}
+		case HJID_REAL32:
+		{
+			float Value = 0.0f;
+			OutValue.Type = FHoudiniBgeoValue::EType::Real;
+			if (!Read(Value))
+				return false;
+			OutValue.Real = Value;
+			return true;
+		}
+		case HJID_REAL64:
+			OutValue.Type = FHoudiniBgeoValue::EType::Real;
+			return Read(OutValue.Real);
+		case HJID_STRING:
+			OutValue.Type = FHoudiniBgeoValue::EType::String;
+			return ReadString(OutValue.String);
+		case HJID_TOKENREF:
+			OutValue.Type = FHoudiniBgeoValue::EType::String;
+			return ReadTokenRef(OutValue.String);
+		case HJID_UNIFORM_ARRAY:
+			return ReadUniformArray(OutValue);
+		case HJID_ARRAY_BEGIN:
+		{
+			OutValue.Type = FHoudiniBgeoValue::EType::Array;
+			uint8 Id = 0;
+			while (ReadId(Id))
+			{
+				if (Id == HJID_ARRAY_END)
+				{
+					PackBgeoNumbers(OutValue);
+					return true;
+				}
+				if (!ParseValue(Id, OutValue.Values.AddDefaulted_GetRef(), InDepth + 1))
+					return false;
+			}
+			return false;
+		}
+		case HJID_MAP_BEGIN:
+		{
+			OutValue.Type = FHoudiniBgeoValue::EType::Map;
+			uint8 Id = 0;
+			while (ReadId(Id))
+			{
+				if (Id == HJID_MAP_END)
+					return true;
+
+				FString& Key = OutValue.Keys.AddDefaulted_GetRef();
+				if (Id == HJID_STRING)
+				{
+					if (!ReadString(Key))
+						return false;
+				}
+				else if (Id != HJID_TOKENREF || !ReadTokenRef(Key))
+				{
+					return false;
+				}
+
+				if (!ReadId(Id) || !ParseValue(Id, OutValue.Values.AddDefaulted_GetRef(), InDepth + 1))
+					return false;
+			}
+			return false;
+		}
+		default:
+			return false;
+		}
+	}
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+	int64 Position = 0;
+	bool bSwapBytes = false;
+	TMap<int64, FString> Tokens;
+};
+
+//
+// ASCII JSON
+//
+
+struct FHoudiniAsciiJsonParser
+{
+	FHoudiniAsciiJsonParser(const uint8* InData, const int64& InSize)
+		: Data(InData)
+		, Size(InSize)
+	{}
+
+	void
+	SkipWhitespace()
+	{
+		while (Position < Size && FChar::IsWhitespace((TCHAR)Data[Position]))
+			Position++;
+	}
+
+	bool
+	Expect(const ANSICHAR* InLiteral)
+	{
+		const int64 Length = FCStringAnsi::Strlen(InLiteral);
+		if (Position + Length > Size || FCStringAnsi::Strncmp((const ANSICHAR*)(Data + Position), InLiteral, Length) != 0)
+			return false;
+
+		Position += Length;
+		return true;
+	}
+
+	bool
+	ParseString(FString& OutString)
+	{
+		// Skip the opening quote
+		Position++;
+
+		TArray<ANSICHAR> Utf8;
+		while (Position < Size)
+		{
+			const ANSICHAR Char = (ANSICHAR)Data[Position++];
+			if (Char == '"')
+			{
+				Utf8.Add('\0');
+				OutString = UTF8_TO_TCHAR(Utf8.GetData());
+				return true;
+			}
+
+			if (Char != '\\')
+			{
+				Utf8.Add(Char);
+				continue;
+			}
+
+			if (Position >= Size)
+				return false;
+
+			const ANSICHAR Escaped = (ANSICHAR)Data[Position++];
+			switch (Escaped)
+			{
+			case 'b': Utf8.Add('\b'); break;
+			case 'f': Utf8.Add('\f'); break;
+			case 'n': Utf8.Add('\n'); break;
+			case 'r': Utf8.Add('\r'); break;
+			case 't': Utf8.Add('\t'); break;
+			case 'u':
+			{
+				if (Position + 4 > Size)
+					return false;
+				const FString Hex(4, (const ANSICHAR*)(Data + Position));
+				Position += 4;
+				const FString Character = FString::Chr((TCHAR)FParse::HexNumber(*Hex));
+				FTCHARToUTF8 Converted(*Character);
+				Utf8.Append((const ANSICHAR*)Converted.Get(), Converted.Length());
+				break;
+			}
+			default: Utf8.Add(Escaped); break;
+			}
+		}
+
+		return false;
+	}
+
+	bool
+	ParseNumber(FHoudiniBgeoValue& OutValue)
+	{
+		const int64 Start = Position;
+		bool bIsReal = false;
+		while (Position < Size)
+		{
+			const ANSICHAR Char = (ANSICHAR)Data[Position];
+			if (Char == '.' || Char == 'e' || Char == 'E')
+				bIsReal = true;
+			else if (!FChar::IsDigit(Char) && Char != '-' && Char != '+')
+				break;
+			Position++;
+		}
+
+		if (Position == Start)
+			return false;
+
+		const FString Number((int32)(Position - Start), (const ANSICHAR*)(Data + Start));
+		if (bIsReal)
+		{
+			OutValue.Type = FHoudiniBgeoValue::EType::Real;
+			OutValue.Real = FCString::Atod(*Number);
+		}
+		else
+		{
+			OutValue.Type = FHoudiniBgeoValue::EType::Int;
+			OutValue.Int = FCString::Atoi64(*Number);
+		}
+
+		return true;
+	}
+
+	bool
+	ParseValue(FHoudiniBgeoValue& OutValue, const int32& InDepth)
+	{
+		if (InDepth > HOUDINI_BGEO_MAX_DEPTH)
+			return false;
+
+		SkipWhitespace();
+		if (Position >= Size)
+			return false;
+
+		const ANSICHAR Char = (ANSICHAR)Data[Position];
+		if (Char == '[')
+		{
+			Position++;
+			OutValue.Type = FHoudiniBgeoValue::EType::Array;
+			SkipWhitespace();
+			if (Position < Size && Data[Position] == ']')
+			{
+				Position++;
+				return true;
+			}
+
+			while (true)
+			{
+				if (!ParseValue(OutValue.Values.AddDefaulted_GetRef(), InDepth + 1))
+					return false;
+
+				SkipWhitespace();
+				if (Position >= Size)
+					return false;
+
+				const ANSICHAR Separator = (ANSICHAR)Data[Position++];
+				if (Separator == ']')
+				{
+					PackBgeoNumbers(OutValue);
+					return true;
+				}
+				if (Separator != ',')
+					return false;
+			}
+		}
+		else if (Char == '{')
+		{
+			Position++;
+			OutValue.Type = FHoudiniBgeoValue::EType::Map;
+			SkipWhitespace();
+			if (Position < Size && Data[Position] == '}')
+			{
+				Position++;
+				return true;
+			}
+
+			while (true)
+			{
+				SkipWhitespace();
+				if (Position >= Size || Data[Position] != '"' || !ParseString(OutValue.Keys.AddDefaulted_GetRef()))
+					return false;
+
+				SkipWhitespace();
+				if (Position >= Size || Data[Position++] != ':')
+					return false;
+
+				if (!ParseValue(OutValue.Values.AddDefaulted_GetRef(), InDepth + 1))
+					return false;
+
+				SkipWhitespace();
+				if (Position >= Size)
+					return false;
+
+				const ANSICHAR Separator = (ANSICHAR)Data[Position++];
+				if (Separator == '}')
+					return true;
+				if (Separator != ',')
+					return false;
+			}
+		}
+		else if (Char == '"')
+		{
+			OutValue.Type = FHoudiniBgeoValue::EType::String;
+			return ParseString(OutValue.String);
+		}
+		else if (Expect("true"))
+		{
+			OutValue.Type = FHoudiniBgeoValue::EType::Bool;
+			OutValue.Int = 1;
+			return true;
+		}
+		else if (Expect("false"))
+		{
+			OutValue.Type = FHoudiniBgeoValue::EType::Bool;
+			OutValue.Int = 0;
+			return true;
+		}
+		else if (Expect("null"))
+		{
+			OutValue.Type = FHoudiniBgeoValue::EType::Null;
+			return true;
+		}
+
+		return ParseNumber(OutValue);
+	}
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+	int64 Position = 0;
+};
+
+bool
+FHoudiniBgeoReader::ParseJSON(const uint8* InData, const int64& InSize, FHoudiniBgeoValue& OutValue)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniBgeoReader::ParseJSON);
+
+	OutValue = FHoudiniBgeoValue();
+	if (!InData || InSize <= 0)
+		return false;
+
+	if (InData[0] == HJID_MAGIC)
+	{
+		FHoudiniBJsonParser Parser(InData, InSize);
+		Parser.Position = 1;
+
+		uint32 Magic = 0;
+		if (!Parser.Read(Magic))
+			return false;
+
+		if (Magic != HOUDINI_BJSON_MAGIC)
+		{
+			// The file was written with the other byte order
+			Parser.bSwapBytes = true;
+			if (BYTESWAP_ORDER32(Magic) != HOUDINI_BJSON_MAGIC)
+			{
+				HOUDINI_LOG_ERROR(TEXT("Invalid binary geometry file header."));
+				return false;
+			}
+		}
+
+		uint8 Id = 0;
+		if (!Parser.ReadId(Id) || !Parser.ParseValue(Id, OutValue, 0))
+		{
+			HOUDINI_LOG_ERROR(TEXT("Failed to parse binary geometry at offset %lld."), Parser.Position);
+			return false;
+		}
+
+		return true;
+	}
+
+	FHoudiniAsciiJsonParser Parser(InData, InSize);
+	if (!Parser.ParseValue(OutValue, 0))
+	{
+		HOUDINI_LOG_ERROR(TEXT("Failed to parse ASCII geometry at offset %lld."), Parser.Position);
+		return false;
+	}
+
+	return true;
+}
+
+//
+// Blosc
+//
+
+static uint32
+ReadBloscUInt32(const uint8* InData)
+{
+	// Blosc headers are always little endian
+	return (uint32)InData[0] | ((uint32)InData[1] << 8) | ((uint32)InData[2] << 16) | ((uint32)InData[3] << 24);
+}
+
+static bool
+DecodeBloscStream(const int32& InCodec, const uint8* InSource, const int32& InSourceSize, uint8* OutDest, const int32& InDestSize)
+{
+	switch (InCodec)
+	{
+	case 1:
+		return FCompression::UncompressMemory(NAME_LZ4, OutDest, InDestSize, InSource, InSourceSize);
+	case 3:
+		return FCompression::UncompressMemory(NAME_Zlib, OutDest, InDestSize, InSource, InSourceSize);
+	default:
+		return false;
+	}
+}
+
+// Decompresses a single Blosc chunk, whose header was validated, in OutDest
+static bool
+DecompressBloscChunk(const uint8* InChunk, const int64& InChunkSize, uint8* OutDest)
+{
+	const uint8 Flags = InChunk[2];
+	const int32 TypeSize = FMath::Max<int32>(InChunk[3], 1);
+	const int64 NumBytes = ReadBloscUInt32(InChunk + 4);
+	const int64 BlockSize = ReadBloscUInt32(InChunk + 8);
+
+	if (NumBytes == 0)
+		return true;
+
+	if (Flags & HOUDINI_BLOSC_MEMCPYED)
+	{
+		if (InChunkSize < HOUDINI_BLOSC_HEADER_SIZE + NumBytes)
+			return false;
+		FMemory::Memcpy(OutDest, InChunk + HOUDINI_BLOSC_HEADER_SIZE, NumBytes);
+		return true;
+	}
+
+	const int32 Codec = (Flags >> 5) & 0x7;
+	if (Codec != 1 && Codec != 3)
+	{
+		HOUDINI_LOG_ERROR(TEXT("Unsupported Blosc codec %d, only LZ4 and zlib are supported."), Codec);
+		return false;
+	}
+
+	if (Flags & HOUDINI_BLOSC_DOBITSHUFFLE)
+	{
+		HOUDINI_LOG_ERROR(TEXT("Unsupported Blosc bit shuffle."));
+		return false;
+	}
+
+	if (BlockSize <= 0)
+		return false;
+
+	const bool bShuffle = (Flags & HOUDINI_BLOSC_DOSHUFFLE) && TypeSize > 1;
+	const int64 NumBlocks = (NumBytes + BlockSize - 1) / BlockSize;
+	const int64 Leftover = NumBytes % BlockSize;
+	if (HOUDINI_BLOSC_HEADER_SIZE + NumBlocks * 4 > InChunkSize)
+		return false;
+
+	TArray<uint8> Shuffled;
+	Shuffled.SetNumUninitialized(BlockSize);
+	for (int64 Block = 0; Block < NumBlocks; Block++)
+	{
+		const bool bLeftoverBlock = (Block == NumBlocks - 1) && Leftover > 0;
+		const int64 BlockBytes = bLeftoverBlock ? Leftover : BlockSize;
+		int64 Position = ReadBloscUInt32(InChunk + HOUDINI_BLOSC_HEADER_SIZE + Block * 4);
+
+		// Blocks of shuffled data are compressed as one stream per byte of the type
+		const bool bSplit = !(Flags & HOUDINI_BLOSC_DONT_SPLIT) && !bLeftoverBlock
+			&& TypeSize <= HOUDINI_BLOSC_MAX_SPLITS && (BlockSize / TypeSize) >= HOUDINI_BLOSC_MIN_BUFFERSIZE;
+		const int32 NumSplits = bSplit ? TypeSize : 1;
+		const int64 SplitBytes = BlockBytes / NumSplits;
+
+		uint8* BlockDest = bShuffle ? Shuffled.GetData() : OutDest + Block * BlockSize;
+		for (int32 Split = 0; Split < NumSplits; Split++)
+		{
+			if (Position + 4 > InChunkSize)
+				return false;
+
+			const int64 StreamSize = (int32)ReadBloscUInt32(InChunk + Position);
+			Position += 4;
+			if (StreamSize < 0 || Position + StreamSize > InChunkSize)
+				return false;
+
+			uint8* SplitDest = BlockDest + Split * SplitBytes;
+			if (StreamSize == SplitBytes)
+			{
+				// Incompressible streams are stored as is
+				FMemory::Memcpy(SplitDest, InChunk + Position, SplitBytes);
+			}
+			else if (!DecodeBloscStream(Codec, InChunk + Position, StreamSize, SplitDest, SplitBytes))
+			{
+				return false;
+			}
+
+			Position += StreamSize;
+		}
+
+		if (bShuffle)
+		{
+			// Byte i of element j was stored at j + i * NumElements
+			uint8* Dest = OutDest + Block * BlockSize;
+			const int64 NumElements = BlockBytes / TypeSize;
+			for (int64 Element = 0; Element < NumElements; Element++)
+			{
+				for (int32 Byte = 0; Byte < TypeSize; Byte++)
+					Dest[Element * TypeSize + Byte] = Shuffled[Byte * NumElements + Element];
+			}
+
+			// Trailing bytes that do not make a whole element are not shuffled
+			const int64 ShuffledBytes = NumElements * TypeSize;
+			if (ShuffledBytes < BlockBytes)
+				FMemory::Memcpy(Dest + ShuffledBytes, Shuffled.GetData() + ShuffledBytes, BlockBytes - ShuffledBytes);
+		}
+	}
+
+	return true;
+}
+
+static bool
+IsValidBloscHeader(const uint8* InData, const int64& InAvailable)
+{
+	if (InAvailable < HOUDINI_BLOSC_HEADER_SIZE)
+		return false;
+
+	const uint8 Version = InData[0];
+	const int64 NumBytes = ReadBloscUInt32(InData + 4);
+	const int64 BlockSize = ReadBloscUInt32(InData + 8);
+	const int64 ChunkSize = ReadBloscUInt32(InData + 12);
+	return Version >= 1 && Version <= 4
+		&& ChunkSize >= HOUDINI_BLOSC_HEADER_SIZE && ChunkSize <= InAvailable
+		&& (NumBytes == 0 || BlockSize > 0);
+}
+
+bool
+FHoudiniBgeoReader::IsBloscCompressed(const TArray<uint8>& InData)
+{
+	return InData.Num() > 0 && InData[0] != HJID_MAGIC && IsValidBloscHeader(InData.GetData(), InData.Num());
+}
+
+bool
+FHoudiniBgeoReader::DecompressBlosc(const TArray<uint8>& InData, TArray<uint8>& OutData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniBgeoReader::DecompressBlosc);
+
+	// The stream is a sequence of independently compressed chunks
+	OutData.Reset();
+	int64 Position = 0;
+	while (Position < InData.Num())
+	{
+		const uint8* Chunk = InData.GetData() + Position;
+		if (!IsValidBloscHeader(Chunk, InData.Num() - Position))
+		{
+			HOUDINI_LOG_ERROR(TEXT("Invalid Blosc chunk at offset %lld."), Position);
+			return false;
+		}
+
+		const int64 NumBytes = ReadBloscUInt32(Chunk + 4);
+		const int64 ChunkSize = ReadBloscUInt32(Chunk + 12);
+		const int64 Offset = OutData.Num();
+		OutData.AddUninitialized(NumBytes);
+		if (!DecompressBloscChunk(Chunk, ChunkSize, OutData.GetData() + Offset))
+		{
+			HOUDINI_LOG_ERROR(TEXT("Failed to decompress the Blosc chunk at offset %lld."), Position);
+			return false;
+		}
+
+		Position += ChunkSize;
+	}
+
+	return true;
+}
+
+//
+// Geometry
+//
+
+// Reads the values of an attribute (or of the indices of a string attribute), stored as tuples, as arrays of
+// components or as raw pages
+template<typename T>
+static T
+GetBgeoNumber(const FHoudiniBgeoValue& InValue, const int32& InIndex)
+{
+	if constexpr (TIsFloatingPoint<T>::Value)
+		return (T)InValue.RealAt(InIndex);
+	else
+		return (T)InValue.IntAt(InIndex);
+}
+
+template<typename T>
+static bool
+ReadBgeoAttributeValues(const FHoudiniBgeoValue& InBlock, const int32& InCount, const int32& InTupleSize, TArray<T>& OutValues)
+{
+	const int32 TupleSize = InTupleSize;
+	OutValues.SetNumZeroed(InCount * TupleSize);
+
+	if (const FHoudiniBgeoValue* Tuples = InBlock.Find(TEXT("tuples")))
+	{
+		if (Tuples->Num() != InCount)
+			return false;
+
+		// Tuples of one component can be stored as plain numbers
+		if (Tuples->Type != FHoudiniBgeoValue::EType::Array)
+		{
+			if (TupleSize != 1)
+				return false;
+			for (int32 Index = 0; Index < InCount; Index++)
+				OutValues[Index] = GetBgeoNumber<T>(*Tuples, Index);
+			return true;
+		}
+
+		for (int32 Index = 0; Index < InCount; Index++)
+		{
+			const FHoudiniBgeoValue& Tuple = Tuples->Values[Index];
+			if (Tuple.IsNumber() && TupleSize == 1)
+			{
+				OutValues[Index] = TIsFloatingPoint<T>::Value ? (T)Tuple.AsReal() : (T)Tuple.AsInt();
+				continue;
+			}
+
+			if (Tuple.Num() < TupleSize)
+				return false;
+			for (int32 Component = 0; Component < TupleSize; Component++)
+				OutValues[Index * TupleSize + Component] = GetBgeoNumber<T>(Tuple, Component);
+		}
+		return true;
+	}
+
+	if (const FHoudiniBgeoValue* Arrays = InBlock.Find(TEXT("arrays")))
+	{
+		if (Arrays->Type != FHoudiniBgeoValue::EType::Array || Arrays->Num() != TupleSize)
+			return false;
+
+		for (int32 Component = 0; Component < TupleSize; Component++)
+		{
+			const FHoudiniBgeoValue& Values = Arrays->Values[Component];
+			if (Values.Num() != InCount)
+				return false;
+			for (int32 Index = 0; Index < InCount; Index++)
+				OutValues[Index * TupleSize + Component] = GetBgeoNumber<T>(Values, Index);
+		}
+		return true;
+	}
+
+	if (const FHoudiniBgeoValue* RawPageData = InBlock.Find(TEXT("rawpagedata")))
+	{
+		// Values are stored per page of PageSize elements. Within a page, each subvector of the tuple (given by
+		// the packing) is stored contiguously, or as a single tuple if the page is constant for that subvector.
+		const FHoudiniBgeoValue* PageSizeValue = InBlock.Find(TEXT("pagesize"));
+		const int32 PageSize = PageSizeValue ? (int32)PageSizeValue->AsInt() : 1024;
+		if (PageSize <= 0)
+			return false;
+
+		TArray<int32> Packing;
+		if (const FHoudiniBgeoValue* PackingValue = InBlock.Find(TEXT("packing")))
+		{
+			for (int32 Index = 0; Index < PackingValue->Num(); Index++)
+				Packing.Add((int32)PackingValue->IntAt(Index));
+		}
+		if (Packing.Num() == 0)
+			Packing.Add(TupleSize);
+
+		int32 PackedSize = 0;
+		for (const int32& SubvectorSize : Packing)
+			PackedSize += SubvectorSize;
+		if (PackedSize != TupleSize)
+			return false;
+
+		const FHoudiniBgeoValue* ConstantPageFlags = InBlock.Find(TEXT("constantpageflags"));
+		auto IsConstantPage = [&](const int32& InSubvector, const int32& InPage)
+		{
+			if (!ConstantPageFlags || ConstantPageFlags->Type != FHoudiniBgeoValue::EType::Array || !ConstantPageFlags->Values.IsValidIndex(InSubvector))
+				return false;
+			const FHoudiniBgeoValue& Flags = ConstantPageFlags->Values[InSubvector];
+			return InPage < Flags.Num() && Flags.IntAt(InPage) != 0;
+		};
+
+		const int32 NumRaw = RawPageData->Num();
+		int32 RawIndex = 0;
+		const int32 NumPages = (InCount + PageSize - 1) / PageSize;
+		for (int32 Page = 0; Page < NumPages; Page++)
+		{
+			const int32 PageStart = Page * PageSize;
+			const int32 PageCount = FMath::Min(PageSize, InCount - PageStart);
+			int32 ComponentOffset = 0;
+			for (int32 Subvector = 0; Subvector < Packing.Num(); Subvector++)
+			{
+				const int32 SubvectorSize = Packing[Subvector];
+				const bool bConstant = IsConstantPage(Subvector, Page);
+				if (RawIndex + (bConstant ? 1 : PageCount) * SubvectorSize > NumRaw)
+					return false;
+
+				for (int32 Element = 0; Element < PageCount; Element++)
+				{
+					const int32 Source = RawIndex + (bConstant ? 0 : Element * SubvectorSize);
+					for (int32 Component = 0; Component < SubvectorSize; Component++)
+					{
+						OutValues[(PageStart + Element) * TupleSize + ComponentOffset + Component] =
+							GetBgeoNumber<T>(*RawPageData, Source + Component);
+					}
+				}
+
+				RawIndex += (bConstant ? 1 : PageCount) * SubvectorSize;
+				ComponentOffset += SubvectorSize;
+			}
+		}
+		return RawIndex == NumRaw;
+	}
+
+	return false;
+}
+
+static HAPI_StorageType
+GetBgeoStorageType(const FString& InStorage)
+{
+	if (InStorage == TEXT("fpreal16") || InStorage == TEXT("fpreal32"))
+		return HAPI_STORAGETYPE_FLOAT;
+	if (InStorage == TEXT("fpreal64"))
+		return HAPI_STORAGETYPE_FLOAT64;
+	if (InStorage == TEXT("int8"))
+		return HAPI_STORAGETYPE_INT8;
+	if (InStorage == TEXT("uint8"))
+		return HAPI_STORAGETYPE_UINT8;
+	if (InStorage == TEXT("int16"))
+		return HAPI_STORAGETYPE_INT16;
+	if (InStorage == TEXT("int32"))
+		return HAPI_STORAGETYPE_INT;
+	if (InStorage == TEXT("int64"))
+		return HAPI_STORAGETYPE_INT64;
+
+	return HAPI_STORAGETYPE_INVALID;
+}
+
+static bool
+ReadBgeoAttribute(const FHoudiniBgeoValue& InAttribute, const HAPI_AttributeOwner& InOwner, const int32& InCount, FHoudiniBgeoAttribute& OutAttribute)
+{
+	if (InAttribute.Type != FHoudiniBgeoValue::EType::Array || InAttribute.Values.Num() < 2)
+		return false;
+
+	const FHoudiniBgeoValue& Header = InAttribute.Values[0];
+	const FHoudiniBgeoValue& Data = InAttribute.Values[1];
+	const FHoudiniBgeoValue* Name = Header.Find(TEXT("name"));
+	const FHoudiniBgeoValue* Type = Header.Find(TEXT("type"));
+	if (!Name || !Type)
+		return false;
+
+	OutAttribute.Name = Name->String;
+	OutAttribute.Owner = InOwner;
+
+	const FHoudiniBgeoValue* Size = Data.Find(TEXT("size"));
+	const int64 TupleSize = Size ? FMath::Max(Size->AsInt(), (int64)1) : 1;
+	if (TupleSize * InCount > MAX_int32)
+	{
+		HOUDINI_LOG_ERROR(TEXT("Attribute %s has too many values: %d tuples of %lld."), *OutAttribute.Name, InCount, TupleSize);
+		return false;
+	}
+	OutAttribute.TupleSize = (int32)TupleSize;
+
+	if (Type->String == TEXT("numeric"))
+	{
+		const FHoudiniBgeoValue* Storage = Data.Find(TEXT("storage"));
+		OutAttribute.Storage = Storage ? GetBgeoStorageType(Storage->String) : HAPI_STORAGETYPE_INVALID;
+		if (OutAttribute.Storage == HAPI_STORAGETYPE_INVALID)
+			return false;
+
+		const bool bIsFloat = OutAttribute.Storage == HAPI_STORAGETYPE_FLOAT || OutAttribute.Storage == HAPI_STORAGETYPE_FLOAT64;
+		const FHoudiniBgeoValue* Values = Data.Find(TEXT("values"));
+		if (!Values)
+		{
+			// Attributes without values only have their defaults
+			const FHoudiniBgeoValue* Defaults = Data.Find(TEXT("defaults"));
+			const FHoudiniBgeoValue* DefaultValues = Defaults ? Defaults->Find(TEXT("values")) : nullptr;
+			if (bIsFloat)
+				OutAttribute.FloatValues.SetNumZeroed(InCount * OutAttribute.TupleSize);
+			else
+				OutAttribute.IntValues.SetNumZeroed(InCount * OutAttribute.TupleSize);
+
+			for (int32 Index = 0; DefaultValues && Index < InCount * OutAttribute.TupleSize; Index++)
+			{
+				const int32 Component = FMath::Min(Index % OutAttribute.TupleSize, DefaultValues->Num() - 1);
+				if (Component < 0)
+					break;
+				if (bIsFloat)
+					OutAttribute.FloatValues[Index] = (float)DefaultValues->RealAt(Component);
+				else
+					OutAttribute.IntValues[Index] = (int32)DefaultValues->IntAt(Component);
+			}
+			return true;
+		}
+
+		return bIsFloat
+			? ReadBgeoAttributeValues(*Values, InCount, OutAttribute.TupleSize, OutAttribute.FloatValues)
+			: ReadBgeoAttributeValues(*Values, InCount, OutAttribute.TupleSize, OutAttribute.IntValues);
+	}
+	else if (Type->String == TEXT("string"))
+	{
+		OutAttribute.Storage = HAPI_STORAGETYPE_STRING;
+		const FHoudiniBgeoValue* Strings = Data.Find(TEXT("strings"));
+		const FHoudiniBgeoValue* Indices = Data.Find(TEXT("indices"));
+		if (!Strings || !Indices || Strings->Type != FHoudiniBgeoValue::EType::Array)
+			return false;
+
+		TArray<int32> StringIndices;
+		if (!ReadBgeoAttributeValues(*Indices, InCount, OutAttribute.TupleSize, StringIndices))
+			return false;
+
+		OutAttribute.StringValues.SetNum(StringIndices.Num());
+		for (int32 Index = 0; Index < StringIndices.Num(); Index++)
+		{
+			// Negative indices are empty strings
+			if (Strings->Values.IsValidIndex(StringIndices[Index]))
+				OutAttribute.StringValues[Index] = Strings->Values[StringIndices[Index]].String;
+		}
+		return true;
+	}
+
+	HOUDINI_LOG_WARNING(TEXT("Skipping attribute %s of unsupported type %s."), *OutAttribute.Name, *Type->String);
+	return false;
+}
+
+static bool
+ReadBgeoGroup(const FHoudiniBgeoValue& InGroup, const HAPI_GroupType& InType, const int32& InCount, FHoudiniBgeoGroup& OutGroup)
+{
+	if (InGroup.Type != FHoudiniBgeoValue::EType::Array || InGroup.Values.Num() < 2)
+		return false;
+
+	const FHoudiniBgeoValue* Name = InGroup.Values[0].Find(TEXT("name"));
+	const FHoudiniBgeoValue* Selection = InGroup.Values[1].Find(TEXT("selection"));
+	if (!Name || !Selection)
+		return false;
+
+	OutGroup.Name = Name->String;
+	OutGroup.Type = InType;
+
+	bool bDefault = false;
+	if (const FHoudiniBgeoValue* Defaults = Selection->Find(TEXT("defaults")))
+	{
+		const FHoudiniBgeoValue* DefaultValue = Defaults->Find(TEXT("value"));
+		if (DefaultValue && DefaultValue->IsArray())
+			bDefault = DefaultValue->Num() > 0 && DefaultValue->IntAt(0) != 0;
+		else if (DefaultValue)
+			bDefault = DefaultValue->AsBool();
+	}
+	OutGroup.Membership.Init(bDefault, InCount);
+
+	if (const FHoudiniBgeoValue* Unordered = Selection->Find(TEXT("unordered")))
+	{
+		if (const FHoudiniBgeoValue* Flags = Unordered->Find(TEXT("i8")))
+		{
+			// One flag per element
+			if (Flags->Num() != InCount)
+				return false;
+			for (int32 Index = 0; Index < InCount; Index++)
+				OutGroup.Membership[Index] = Flags->IntAt(Index) != 0;
+			return true;
+		}
+
+		if (const FHoudiniBgeoValue* Runs = Unordered->Find(TEXT("boolRLE")))
+		{
+			// Pairs of run length and membership
+			if (!Runs->IsArray() || Runs->Num() % 2 != 0)
+				return false;
+			int32 Element = 0;
+			for (int32 Index = 0; Index + 1 < Runs->Num(); Index += 2)
+			{
+				const int32 RunLength = (int32)Runs->IntAt(Index);
+				const bool bMember = Runs->IntAt(Index + 1) != 0;
+				if (RunLength < 0 || Element + RunLength > InCount)
+					return false;
+				for (int32 Run = 0; Run < RunLength; Run++)
+					OutGroup.Membership[Element++] = bMember;
+			}
+			return true;
+		}
+
+		return false;
+	}
+
+	if (const FHoudiniBgeoValue* Ordered = Selection->Find(TEXT("ordered")))
+	{
+		// Member indices, in the group's order
+		const FHoudiniBgeoValue* Indices = Ordered->Find(TEXT("i32"));
+		if (!Indices)
+			Indices = Ordered->Find(TEXT("i64"));
+		if (!Indices || !Indices->IsArray())
+			return false;
+
+		for (int32 Index = 0; Index < Indices->Num(); Index++)
+		{
+			const int64 Element = Indices->IntAt(Index);
+			if (Element < 0 || Element >= InCount)
+				return false;
+			OutGroup.Membership[Element] = true;
+		}
+		return true;
+	}
+
+	return true;
+}
+
+// Builds a transform from a 3x3 (or 4x4) matrix stored as rows, in Houdini's row vector convention
+static FMatrix
+GetBgeoTransform(const FHoudiniBgeoValue* InValue)
+{
+	FMatrix Transform = FMatrix::Identity;
+	if (!InValue)
+		return Transform;
+
+	const int32 Size = (InValue->Num() == 16) ? 4 : ((InValue->Num() == 9) ? 3 : 0);
+	for (int32 Row = 0; Row < Size; Row++)
+	{
+		for (int32 Column = 0; Column < Size; Column++)
+			Transform.M[Row][Column] = InValue->RealAt(Row * Size + Column);
+	}
+
+	return Transform;
+}
+
+static int32
+GetBgeoPrimitiveVertex(const FHoudiniBgeoValue& InData)
+{
+	const FHoudiniBgeoValue* Vertex = InData.Find(TEXT("vertex"));
+	if (!Vertex)
+		return INDEX_NONE;
+
+	if (Vertex->IsArray())
+		return Vertex->Num() > 0 ? (int32)Vertex->IntAt(0) : INDEX_NONE;
+
+	return (int32)Vertex->AsInt();
+}
+
+// The voxel count of a volume has to fit in a TArray
+static bool
+IsBgeoVolumeTooLarge(const FHoudiniBgeoValue& InData)
+{
+	const FHoudiniBgeoValue* Resolution = InData.Find(TEXT("res"));
+	if (!Resolution || Resolution->Num() != 3)
+		return false;
+
+	int64 NumVoxels = 1;
+	for (int32 Index = 0; Index < 3; Index++)
+	{
+		const int64 Res = FMath::Max(Resolution->IntAt(Index), (int64)0);
+		if (Res > MAX_int32 || NumVoxels * Res > MAX_int32)
+		{
+			HOUDINI_LOG_ERROR(TEXT("Volume resolution %lld x %lld x %lld is too large."),
+				Resolution->IntAt(0), Resolution->IntAt(1), Resolution->IntAt(2));
+			return true;
+		}
+		NumVoxels *= Res;
+	}
+
+	return false;
+}
+
+static bool
+ReadBgeoVolume(const FHoudiniBgeoValue& InData, FHoudiniBgeoVolume& OutVolume)
+{
+	const FHoudiniBgeoValue* Resolution = InData.Find(TEXT("res"));
+	if (!Resolution || Resolution->Num() != 3)
+		return false;
+
+	// IsBgeoVolumeTooLarge() has made sure the voxel count fits in an int32
+	OutVolume.Resolution = FIntVector((int32)Resolution->IntAt(0), (int32)Resolution->IntAt(1), (int32)Resolution->IntAt(2));
+	if (OutVolume.Resolution.X <= 0 || OutVolume.Resolution.Y <= 0 || OutVolume.Resolution.Z <= 0)
+		return false;
+
+	OutVolume.Transform = GetBgeoTransform(InData.Find(TEXT("transform")));
+
+	// Voxels are stored in tiles, X varying fastest, each tile being raw values or a constant
+	const FHoudiniBgeoValue* Voxels = InData.Find(TEXT("voxels"));
+	const FHoudiniBgeoValue* TiledArray = Voxels ? Voxels->Find(TEXT("tiledarray")) : nullptr;
+	const FHoudiniBgeoValue* Tiles = TiledArray ? TiledArray->Find(TEXT("tiles")) : nullptr;
+	if (!Tiles || Tiles->Type != FHoudiniBgeoValue::EType::Array)
+		return false;
+
+	const int32 TileSize = HOUDINI_BGEO_VOLUME_TILE_SIZE;
+	const FIntVector NumTiles(
+		FMath::DivideAndRoundUp(OutVolume.Resolution.X, TileSize),
+		FMath::DivideAndRoundUp(OutVolume.Resolution.Y, TileSize),
+		FMath::DivideAndRoundUp(OutVolume.Resolution.Z, TileSize));
+	if (Tiles->Num() != NumTiles.X * NumTiles.Y * NumTiles.Z)
+		return false;
+
+	const FIntVector& Res = OutVolume.Resolution;
+	OutVolume.Values.SetNumZeroed(Res.X * Res.Y * Res.Z);
+
+	int32 TileIndex = 0;
+	for (int32 TileZ = 0; TileZ < NumTiles.Z; TileZ++)
+	{
+		for (int32 TileY = 0; TileY < NumTiles.Y; TileY++)
+		{
+			for (int32 TileX = 0; TileX < NumTiles.X; TileX++)
+			{
+				const FHoudiniBgeoValue& Tile = Tiles->Values[TileIndex++];
+				const FHoudiniBgeoValue* Compression = Tile.Find(TEXT("compression"));
+				const FHoudiniBgeoValue* Data = Tile.Find(TEXT("data"));
+				if (!Compression || !Data)
+					return false;
+
+				const FIntVector Origin(TileX * TileSize, TileY * TileSize, TileZ * TileSize);
+				const FIntVector Dimensions(
+					FMath::Min(TileSize, Res.X - Origin.X),
+					FMath::Min(TileSize, Res.Y - Origin.Y),
+					FMath::Min(TileSize, Res.Z - Origin.Z));
+				const int32 NumVoxels = Dimensions.X * Dimensions.Y * Dimensions.Z;
+
+				// 0: raw values of the tile, 1: raw values of a full tile, even on the borders,
+				// 2: constant tile, 3: raw half float values
+				const int64 CompressionType = Compression->AsInt();
+				const bool bConstant = (CompressionType == 2);
+				FIntVector Stride = Dimensions;
+				if (CompressionType == 1)
+				{
+					Stride = FIntVector(TileSize, TileSize, TileSize);
+				}
+				else if (CompressionType != 0 && CompressionType != 2 && CompressionType != 3)
+				{
+					HOUDINI_LOG_ERROR(TEXT("Unsupported volume tile compression %lld."), CompressionType);
+					return false;
+				}
+
+				if (bConstant)
+				{
+					const float Value = (float)(Data->IsArray() ? (Data->Num() > 0 ? Data->RealAt(0) : 0.0) : Data->AsReal());
+					for (int32 Z = 0; Z < Dimensions.Z; Z++)
+					{
+						for (int32 Y = 0; Y < Dimensions.Y; Y++)
+						{
+							float* Row = OutVolume.Values.GetData() + ((Origin.Z + Z) * Res.Y + (Origin.Y + Y)) * Res.X + Origin.X;
+							for (int32 X = 0; X < Dimensions.X; X++)
+								Row[X] = Value;
+						}
+					}
+					continue;
+				}
+
+				if (Data->Num() < Stride.X * Stride.Y * Stride.Z || Data->Num() < NumVoxels)
+					return false;
+
+				for (int32 Z = 0; Z < Dimensions.Z; Z++)
+				{
+					for (int32 Y = 0; Y < Dimensions.Y; Y++)
+					{
+						float* Row = OutVolume.Values.GetData() + ((Origin.Z + Z) * Res.Y + (Origin.Y + Y)) * Res.X + Origin.X;
+						const int32 Source = (Z * Stride.Y + Y) * Stride.X;
+						for (int32 X = 0; X < Dimensions.X; X++)
+							Row[X] = (float)Data->RealAt(Source + X);
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+static FVector
+GetBgeoPointPosition(const FHoudiniBgeoGeometry& InGeometry, const FHoudiniBgeoAttribute* InPositions, const int32& InVertex)
+{
+	if (!InPositions || InPositions->TupleSize < 3 || !InGeometry.VertexPoints.IsValidIndex(InVertex))
+		return FVector::ZeroVector;
+
+	const int32 Offset = InGeometry.VertexPoints[InVertex] * InPositions->TupleSize;
+	if (!InPositions->FloatValues.IsValidIndex(Offset + 2))
+		return FVector::ZeroVector;
+
+	return FVector(InPositions->FloatValues[Offset], InPositions->FloatValues[Offset + 1], InPositions->FloatValues[Offset + 2]);
+}
+
+static bool
+ReadBgeoPrimitives(const FHoudiniBgeoValue& InPrimitives, const FHoudiniBgeoAttribute* InPositions, FHoudiniBgeoGeometry& OutGeometry)
+{
+	if (InPrimitives.Type != FHoudiniBgeoValue::EType::Array)
+		return false;
+
+	auto AddPolygon = [&OutGeometry](const int32& InPrimitiveIndex, const TArray<int32>& InVertices)
+	{
+		OutGeometry.FaceCounts.Add(InVertices.Num());
+		OutGeometry.FaceVertices.Append(InVertices);
+		OutGeometry.FacePrimitives.Add(InPrimitiveIndex);
+	};
+
+	TSet<FString> UnsupportedTypes;
+	int32 PrimitiveIndex = 0;
+	TArray<int32> Vertices;
+	for (const FHoudiniBgeoValue& Primitive : InPrimitives.Values)
+	{
+		if (Primitive.Type != FHoudiniBgeoValue::EType::Array || Primitive.Values.Num() < 2)
+			return false;
+
+		const FHoudiniBgeoValue& Header = Primitive.Values[0];
+		const FHoudiniBgeoValue& Data = Primitive.Values[1];
+		const FHoudiniBgeoValue* TypeValue = Header.Find(TEXT("type"));
+		if (!TypeValue)
+			return false;
+
+		const FString& Type = TypeValue->String;
+		if (Type == TEXT("Polygon_run"))
+		{
+			// Closed polygons using consecutive vertices
+			const FHoudiniBgeoValue* StartVertex = Data.Find(TEXT("startvertex"));
+			const FHoudiniBgeoValue* NumPrimitives = Data.Find(TEXT("nprimitives"));
+			if (!StartVertex || !NumPrimitives)
+				return false;
+
+			TArray<int32> Counts;
+			if (const FHoudiniBgeoValue* CountRuns = Data.Find(TEXT("nvertices_rle")))
+			{
+				// Pairs of vertex count and number of polygons
+				for (int32 Index = 0; Index + 1 < CountRuns->Num(); Index += 2)
+				{
+					for (int64 Run = 0; Run < CountRuns->IntAt(Index + 1); Run++)
+						Counts.Add((int32)CountRuns->IntAt(Index));
+				}
+			}
+			else if (const FHoudiniBgeoValue* VertexCounts = Data.Find(TEXT("nvertices")))
+			{
+				for (int32 Index = 0; Index < VertexCounts->Num(); Index++)
+					Counts.Add((int32)VertexCounts->IntAt(Index));
+			}
+
+			if (Counts.Num() != NumPrimitives->AsInt())
+				return false;
+
+			int32 Vertex = (int32)StartVertex->AsInt();
+			for (const int32& Count : Counts)
+			{
+				Vertices.Reset();
+				for (int32 Index = 0; Index < Count; Index++)
+					Vertices.Add(Vertex++);
+				AddPolygon(PrimitiveIndex++, Vertices);
+			}
+		}
+		else if (Type == TEXT("Poly"))
+		{
+			const FHoudiniBgeoValue* VertexList = Data.Find(TEXT("vertex"));
+			const FHoudiniBgeoValue* Closed = Data.Find(TEXT("closed"));
+			if (!VertexList)
+				return false;
+
+			if (!Closed || Closed->AsBool())
+			{
+				Vertices.Reset();
+				for (int32 Index = 0; Index < VertexList->Num(); Index++)
+					Vertices.Add((int32)VertexList->IntAt(Index));
+				AddPolygon(PrimitiveIndex, Vertices);
+			}
+			else
+			{
+				UnsupportedTypes.Add(TEXT("open Poly"));
+				OutGeometry.UnsupportedPrimitiveCount++;
+			}
+			PrimitiveIndex++;
+		}
+		else if (Type == TEXT("run"))
+		{
+			// Runs of primitives of the same type, with the fields that vary per primitive listed in the header
+			const FHoudiniBgeoValue* RunType = Header.Find(TEXT("runtype"));
+			const FHoudiniBgeoValue* VaryingFields = Header.Find(TEXT("varyingfields"));
+			const FHoudiniBgeoValue* UniformFields = Header.Find(TEXT("uniformfields"));
+			if (!RunType || Data.Type != FHoudiniBgeoValue::EType::Array)
+				return false;
+
+			int32 VertexField = INDEX_NONE;
+			int32 ClosedField = INDEX_NONE;
+			for (int32 Index = 0; VaryingFields && Index < VaryingFields->Values.Num(); Index++)
+			{
+				if (VaryingFields->Values[Index].String == TEXT("vertex"))
+					VertexField = Index;
+				else if (VaryingFields->Values[Index].String == TEXT("closed"))
+					ClosedField = Index;
+			}
+
+			const FHoudiniBgeoValue* UniformClosed = UniformFields ? UniformFields->Find(TEXT("closed")) : nullptr;
+			for (const FHoudiniBgeoValue& Fields : Data.Values)
+			{
+				const bool bClosed = Fields.Values.IsValidIndex(ClosedField)
+					? Fields.Values[ClosedField].AsBool()
+					: (!UniformClosed || UniformClosed->AsBool());
+
+				if (RunType->String == TEXT("Poly") && bClosed && Fields.Values.IsValidIndex(VertexField))
+				{
+					const FHoudiniBgeoValue& VertexList = Fields.Values[VertexField];
+					Vertices.Reset();
+					for (int32 Index = 0; Index < VertexList.Num(); Index++)
+						Vertices.Add((int32)VertexList.IntAt(Index));
+					AddPolygon(PrimitiveIndex, Vertices);
+				}
+				else
+				{
+					UnsupportedTypes.Add(RunType->String);
+					OutGeometry.UnsupportedPrimitiveCount++;
+				}
+				PrimitiveIndex++;
+			}
+		}
+		else if (Type == TEXT("Volume"))
+		{
+			FHoudiniBgeoVolume Volume;
+			Volume.PrimitiveIndex = PrimitiveIndex++;
+			if (IsBgeoVolumeTooLarge(Data))
+				return false;
+
+			const int32 Vertex = GetBgeoPrimitiveVertex(Data);
+			if (!ReadBgeoVolume(Data, Volume) || !OutGeometry.VertexPoints.IsValidIndex(Vertex))
+			{
+				HOUDINI_LOG_WARNING(TEXT("Failed to read volume primitive %d."), Volume.PrimitiveIndex);
+				OutGeometry.UnsupportedPrimitiveCount++;
+				continue;
+			}
+
+			// The volume is centered on its point
+			Volume.Transform.SetOrigin(GetBgeoPointPosition(OutGeometry, InPositions, Vertex));
+			OutGeometry.Volumes.Add(MoveTemp(Volume));
+		}
+		else if (Type.StartsWith(TEXT("Packed")) || Type == TEXT("AlembicRef"))
+		{
+			FHoudiniBgeoPackedPrimitive& Packed = OutGeometry.PackedPrimitives.AddDefaulted_GetRef();
+			Packed.Type = Type;
+			Packed.PrimitiveIndex = PrimitiveIndex++;
+
+			const FHoudiniBgeoValue* Parameters = Data.Find(TEXT("parameters"));
+			if (!Parameters)
+				Parameters = &Data;
+
+			int32 Vertex = GetBgeoPrimitiveVertex(*Parameters);
+			if (Vertex == INDEX_NONE)
+				Vertex = GetBgeoPrimitiveVertex(Data);
+			Packed.PointIndex = OutGeometry.VertexPoints.IsValidIndex(Vertex) ? OutGeometry.VertexPoints[Vertex] : INDEX_NONE;
+
+			// The instance is placed on its point, offset by its transformed pivot
+			Packed.Transform = GetBgeoTransform(Parameters->Find(TEXT("transform")));
+			FVector Origin = GetBgeoPointPosition(OutGeometry, InPositions, Vertex);
+			if (const FHoudiniBgeoValue* Pivot = Parameters->Find(TEXT("pivot")))
+			{
+				if (Pivot->Num() == 3)
+					Origin -= Packed.Transform.TransformVector(FVector(Pivot->RealAt(0), Pivot->RealAt(1), Pivot->RealAt(2)));
+			}
+			Packed.Transform.SetOrigin(Origin);
+
+			if (const FHoudiniBgeoValue* FilePath = Parameters->Find(TEXT("filename")))
+				Packed.FilePath = FilePath->String;
+		}
+		else
+		{
+			UnsupportedTypes.Add(Type);
+			OutGeometry.UnsupportedPrimitiveCount++;
+			PrimitiveIndex++;
+		}
+	}
+
+	for (const FString& Type : UnsupportedTypes)
+		HOUDINI_LOG_WARNING(TEXT("Skipping unsupported %s primitives."), *Type);
+
+	return true;
+}
+
+bool
+FHoudiniBgeoReader::ReadGeometry(const FHoudiniBgeoValue& InRoot, FHoudiniBgeoGeometry& OutGeometry)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniBgeoReader::ReadGeometry);
+
+	OutGeometry = FHoudiniBgeoGeometry();
+
+	// Invalid counts are returned as -1
+	auto GetCount = [&InRoot](const TCHAR* InKey)
+	{
+		const FHoudiniBgeoValue* Value = InRoot.Find(InKey);
+		const int64 Count = Value ? Value->AsInt() : 0;
+		if (Count < 0 || Count > MAX_int32)
+		{
+			HOUDINI_LOG_ERROR(TEXT("Invalid geometry %s %lld."), InKey, Count);
+			return -1;
+		}
+		return (int32)Count;
+	};
+
+	OutGeometry.PointCount = GetCount(TEXT("pointcount"));
+	OutGeometry.VertexCount = GetCount(TEXT("vertexcount"));
+	OutGeometry.PrimitiveCount = GetCount(TEXT("primitivecount"));
+	if (OutGeometry.PointCount < 0 || OutGeometry.VertexCount < 0 || OutGeometry.PrimitiveCount < 0)
+		return false;
+
+	// Point of each vertex
+	const FHoudiniBgeoValue* Topology = InRoot.Find(TEXT("topology"));
+	const FHoudiniBgeoValue* PointRef = Topology ? Topology->Find(TEXT("pointref")) : nullptr;
+	const FHoudiniBgeoValue* Indices = PointRef ? PointRef->Find(TEXT("indices")) : nullptr;
+	if (OutGeometry.VertexCount > 0)
+	{
+		if (!Indices || Indices->Num() != OutGeometry.VertexCount)
+		{
+			HOUDINI_LOG_ERROR(TEXT("Invalid geometry topology."));
+			return false;
+		}
+
+		OutGeometry.VertexPoints.SetNumUninitialized(OutGeometry.VertexCount);
+		for (int32 Index = 0; Index < OutGeometry.VertexCount; Index++)
+		{
+			const int64 Point = Indices->IntAt(Index);
+			if (Point < 0 || Point >= OutGeometry.PointCount)
+			{
+				HOUDINI_LOG_ERROR(TEXT("Invalid point index %lld for vertex %d."), Point, Index);
+				return false;
+			}
+			OutGeometry.VertexPoints[Index] = (int32)Point;
+		}
+	}
+
+	if (const FHoudiniBgeoValue* Attributes = InRoot.Find(TEXT("attributes")))
+	{
+		const TPair<const TCHAR*, HAPI_AttributeOwner> OwnerKeys[] = {
+			{ TEXT("vertexattributes"), HAPI_ATTROWNER_VERTEX },
+			{ TEXT("pointattributes"), HAPI_ATTROWNER_POINT },
+			{ TEXT("primitiveattributes"), HAPI_ATTROWNER_PRIM },
+			{ TEXT("globalattributes"), HAPI_ATTROWNER_DETAIL } };
+
+		for (const TPair<const TCHAR*, HAPI_AttributeOwner>& OwnerKey : OwnerKeys)
+		{
+			const FHoudiniBgeoValue* OwnerAttributes = Attributes->Find(OwnerKey.Key);
+			if (!OwnerAttributes)
+				continue;
+
+			int32 Count = 1;
+			if (OwnerKey.Value == HAPI_ATTROWNER_VERTEX)
+				Count = OutGeometry.VertexCount;
+			else if (OwnerKey.Value == HAPI_ATTROWNER_POINT)
+				Count = OutGeometry.PointCount;
+			else if (OwnerKey.Value == HAPI_ATTROWNER_PRIM)
+				Count = OutGeometry.PrimitiveCount;
+
+			for (const FHoudiniBgeoValue& Attribute : OwnerAttributes->Values)
+			{
+				FHoudiniBgeoAttribute NewAttribute;
+				if (ReadBgeoAttribute(Attribute, OwnerKey.Value, Count, NewAttribute))
+					OutGeometry.Attributes.Add(MoveTemp(NewAttribute));
+				else
+					HOUDINI_LOG_WARNING(TEXT("Failed to read attribute %s."), *NewAttribute.Name);
+			}
+		}
+	}
+
+	// Primitives need the point positions for the volume and packed primitive transforms
+	if (const FHoudiniBgeoValue* Primitives = InRoot.Find(TEXT("primitives")))
+	{
+		const FHoudiniBgeoAttribute* Positions = OutGeometry.FindAttribute(TEXT("P"), HAPI_ATTROWNER_POINT);
+		if (!ReadBgeoPrimitives(*Primitives, Positions, OutGeometry))
+		{
+			HOUDINI_LOG_ERROR(TEXT("Failed to read the geometry primitives."));
+			return false;
+		}
+	}
+
+	for (const int32& Vertex : OutGeometry.FaceVertices)
+	{
+		if (Vertex < 0 || Vertex >= OutGeometry.VertexCount)
+		{
+			HOUDINI_LOG_ERROR(TEXT("Invalid polygon vertex %d."), Vertex);
+			return false;
+		}
+	}
+
+	const TPair<const TCHAR*, HAPI_GroupType> GroupKeys[] = {
+		{ TEXT("pointgroups"), HAPI_GROUPTYPE_POINT },
+		{ TEXT("primitivegroups"), HAPI_GROUPTYPE_PRIM } };
+	for (const TPair<const TCHAR*, HAPI_GroupType>& GroupKey : GroupKeys)
+	{
+		const FHoudiniBgeoValue* Groups = InRoot.Find(GroupKey.Key);
+		if (!Groups)
+			continue;
+
+		const int32 Count = (GroupKey.Value == HAPI_GROUPTYPE_POINT) ? OutGeometry.PointCount : OutGeometry.PrimitiveCount;
+		for (const FHoudiniBgeoValue& Group : Groups->Values)
+		{
+			FHoudiniBgeoGroup NewGroup;
+			if (ReadBgeoGroup(Group, GroupKey.Value, Count, NewGroup))
+				OutGeometry.Groups.Add(MoveTemp(NewGroup));
+			else
+				HOUDINI_LOG_WARNING(TEXT("Failed to read group %s."), *NewGroup.Name);
+		}
+	}
+
+	// Volumes are named after their primitive's name attribute
+	if (const FHoudiniBgeoAttribute* Names = OutGeometry.FindAttribute(TEXT("name"), HAPI_ATTROWNER_PRIM))
+	{
+		for (FHoudiniBgeoVolume& Volume : OutGeometry.Volumes)
+		{
+			if (Names->StringValues.IsValidIndex(Volume.PrimitiveIndex * Names->TupleSize))
+				Volume.Name = Names->StringValues[Volume.PrimitiveIndex * Names->TupleSize];
+		}
+	}
+
+	return true;
+}
+
+bool
+FHoudiniBgeoReader::ReadFromMemory(const TArray<uint8>& InData, FHoudiniBgeoGeometry& OutGeometry)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniBgeoReader::ReadFromMemory);
+
+	// Binary and ASCII documents are parsed directly, anything else has to be Blosc compressed
+	bool bIsJSON = InData.Num() > 0 && InData[0] == HJID_MAGIC;
+	for (int32 Index = 0; !bIsJSON && Index < InData.Num(); Index++)
+	{
+		if (FChar::IsWhitespace((TCHAR)InData[Index]))
+			continue;
+
+		bIsJSON = (InData[Index] == '[' || InData[Index] == '{');
+		break;
+	}
+
+	FHoudiniBgeoValue Root;
+	if (bIsJSON)
+	{
+		if (!ParseJSON(InData.GetData(), InData.Num(), Root))
+			return false;
+	}
+	else
+	{
+		TArray<uint8> Decompressed;
+		if (!IsBloscCompressed(InData) || !DecompressBlosc(InData, Decompressed))
+		{
+			HOUDINI_LOG_ERROR(TEXT("Unrecognized geometry file format."));
+			return false;
+		}
+
+		if (!ParseJSON(Decompressed.GetData(), Decompressed.Num(), Root))
+			return false;
+	}
+
+	return ReadGeometry(Root, OutGeometry);
+}
+
+bool
+FHoudiniBgeoReader::ReadFile(const FString& InFilePath, FHoudiniBgeoGeometry& OutGeometry)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniBgeoReader::ReadFile);
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *InFilePath))
+	{
+		HOUDINI_LOG_ERROR(TEXT("Failed to load geometry file %s."), *InFilePath);
+		return false;
+	}
+
+	if (!ReadFromMemory(Data, OutGeometry))
+	{
+		HOUDINI_LOG_ERROR(TEXT("Failed to read geometry file %s."), *InFilePath);
+		return false;
+	}
+
+	return true;
+}
+
+// Converts a transform in Houdini space to Unreal, the same way the transforms returned by HAPI are
+static FTransform
+ConvertBgeoTransform(const FMatrix& InTransform)
+{
+	const FTransform HoudiniTransform(InTransform);
+
+	HAPI_Transform HapiTransform;
+	FMemory::Memzero(HapiTransform);
+	const FVector Position = HoudiniTransform.GetLocation();
+	const FQuat Rotation = HoudiniTransform.GetRotation();
+	const FVector Scale = HoudiniTransform.GetScale3D();
+	for (int32 Index = 0; Index < 3; Index++)
+	{
+		HapiTransform.position[Index] = (float)Position[Index];
+		HapiTransform.scale[Index] = (float)Scale[Index];
+	}
+	HapiTransform.rotationQuaternion[0] = (float)Rotation.X;
+	HapiTransform.rotationQuaternion[1] = (float)Rotation.Y;
+	HapiTransform.rotationQuaternion[2] = (float)Rotation.Z;
+	HapiTransform.rotationQuaternion[3] = (float)Rotation.W;
+
+	FTransform UnrealTransform;
+	FHoudiniEngineUtils::TranslateHapiTransform(HapiTransform, UnrealTransform);
+	return UnrealTransform;
+}
+
+void
+FHoudiniBgeoReader::BuildGeoPartObjects(
+	const FHoudiniBgeoGeometry& InGeometry,
+	const FString& InObjectName,
+	TArray<FHoudiniGeoPartObject>& OutHGPOs)
+{
+	auto AddPart = [&](const EHoudiniPartType& InType, const FString& InPartName) -> FHoudiniGeoPartObject&
+	{
+		FHoudiniGeoPartObject& HGPO = OutHGPOs.AddDefaulted_GetRef();
+		HGPO.AssetId = -1;
+		HGPO.ObjectId = 0;
+		HGPO.ObjectName = InObjectName;
+		HGPO.GeoId = 0;
+		HGPO.PartId = OutHGPOs.Num() - 1;
+		HGPO.PartName = InPartName;
+		HGPO.Type = InType;
+		HGPO.bIsVisible = true;
+		HGPO.bHasGeoChanged = true;
+		HGPO.bHasPartChanged = true;
+
+		HGPO.PartInfo.PartId = HGPO.PartId;
+		HGPO.PartInfo.Name = InPartName;
+		HGPO.PartInfo.Type = InType;
+		HGPO.PartInfo.PointCount = InGeometry.PointCount;
+		HGPO.PartInfo.VertexCount = 0;
+		HGPO.PartInfo.FaceCount = 0;
+		HGPO.PartInfo.PointAttributeCounts = InGeometry.GetAttributeCount(HAPI_ATTROWNER_POINT);
+		HGPO.PartInfo.VertexAttributeCounts = InGeometry.GetAttributeCount(HAPI_ATTROWNER_VERTEX);
+		HGPO.PartInfo.PrimitiveAttributeCounts = InGeometry.GetAttributeCount(HAPI_ATTROWNER_PRIM);
+		HGPO.PartInfo.DetailAttributeCounts = InGeometry.GetAttributeCount(HAPI_ATTROWNER_DETAIL);
+		HGPO.PartInfo.bHasChanged = true;
+		return HGPO;
+	};
+
+	if (InGeometry.FaceCounts.Num() > 0)
+	{
+		FHoudiniGeoPartObject& HGPO = AddPart(EHoudiniPartType::Mesh, InObjectName);
+		HGPO.PartInfo.FaceCount = InGeometry.FaceCounts.Num();
+		HGPO.PartInfo.VertexCount = InGeometry.FaceVertices.Num();
+	}
+
+	for (const FHoudiniBgeoVolume& Volume : InGeometry.Volumes)
+	{
+		FHoudiniGeoPartObject& HGPO = AddPart(EHoudiniPartType::Volume, Volume.Name);
+		HGPO.PartInfo.FaceCount = 1;
+		HGPO.PartInfo.VertexCount = 1;
+		HGPO.VolumeName = Volume.Name;
+
+		HGPO.VolumeInfo.Name = Volume.Name;
+		HGPO.VolumeInfo.bIsVDB = false;
+		HGPO.VolumeInfo.TupleSize = 1;
+		HGPO.VolumeInfo.bIsFloat = true;
+		HGPO.VolumeInfo.TileSize = HOUDINI_BGEO_VOLUME_TILE_SIZE;
+		HGPO.VolumeInfo.Transform = ConvertBgeoTransform(Volume.Transform);
+		HGPO.VolumeInfo.XLength = Volume.Resolution.X;
+		HGPO.VolumeInfo.YLength = Volume.Resolution.Y;
+		HGPO.VolumeInfo.ZLength = Volume.Resolution.Z;
+		HGPO.VolumeInfo.MinX = -Volume.Resolution.X / 2;
+		HGPO.VolumeInfo.MinY = -Volume.Resolution.Y / 2;
+		HGPO.VolumeInfo.MinZ = -Volume.Resolution.Z / 2;
+	}
+
+	if (InGeometry.PackedPrimitives.Num() > 0)
+	{
+		FHoudiniGeoPartObject& HGPO = AddPart(EHoudiniPartType::Instancer, InObjectName + TEXT("_instancer"));
+		HGPO.InstancerType = EHoudiniInstancerType::PackedPrimitive;
+		HGPO.PartInfo.FaceCount = InGeometry.PackedPrimitives.Num();
+		HGPO.PartInfo.VertexCount = InGeometry.PackedPrimitives.Num();
+		HGPO.PartInfo.bIsInstanced = false;
+		HGPO.PartInfo.InstanceCount = InGeometry.PackedPrimitives.Num();
+		HGPO.PartInfo.InstancedPartCount = 1;
+	}
+}
@@ -0,0 +1,194 @@
+/*
+* Copyright (c) <2021> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "HAPI/HAPI_Common.h"
+
+struct FHoudiniGeoPartObject;
+
+// A value of a Houdini JSON geometry file, read from its ASCII or binary form.
+// Arrays of numbers are kept packed in Ints or Reals.
+struct HOUDINIENGINE_API FHoudiniBgeoValue
+{
+	enum class EType : uint8
+	{
+		Null,
+		Bool,
+		Int,
+		Real,
+		String,
+		Array,
+		Map,
+		IntArray,
+		RealArray
+	};
+
+	EType Type = EType::Null;
+
+	int64 Int = 0;
+	double Real = 0.0;
+	FString String;
+
+	// Elements of arrays, values of maps
+	TArray<FHoudiniBgeoValue> Values;
+	// Keys of maps
+	TArray<FString> Keys;
+
+	// Packed arrays of numbers
+	TArray<int64> Ints;
+	TArray<double> Reals;
+
+	bool IsNumber() const { return Type == EType::Int || Type == EType::Real || Type == EType::Bool; }
+	bool IsString() const { return Type == EType::String; }
+	bool IsArray() const { return Type == EType::Array || Type == EType::IntArray || Type == EType::RealArray; }
+
+	int64 AsInt() const;
+	double AsReal() const;
+	bool AsBool() const { return AsInt() != 0; }
+
+	// Number of elements of an array
+	int32 Num() const;
+
+	// Number at the given index of an array, packed or not
+	double RealAt(const int32& InIndex) const;
+	int64 IntAt(const int32& InIndex) const { return (Type == EType::IntArray) ? Ints[InIndex] : (int64)RealAt(InIndex); }
+
+	// Finds a value by key, in a map or in an array of alternating keys and values
+	const FHoudiniBgeoValue* Find(const TCHAR* InKey) const;
+};
+
+// An attribute read from a geometry file, with one tuple per element of its owner
+struct HOUDINIENGINE_API FHoudiniBgeoAttribute
+{
+	FString Name;
+	HAPI_AttributeOwner Owner = HAPI_ATTROWNER_INVALID;
+	HAPI_StorageType Storage = HAPI_STORAGETYPE_INVALID;
+	int32 TupleSize = 1;
+
+	// Values of float, int and string attributes, depending on Storage
+	TArray<float> FloatValues;
+	TArray<int32> IntValues;
+	TArray<FString> StringValues;
+};
+
+// A point or primitive group, with one membership flag per element
+struct HOUDINIENGINE_API FHoudiniBgeoGroup
+{
+	FString Name;
+	HAPI_GroupType Type = HAPI_GROUPTYPE_INVALID;
+	TArray<bool> Membership;
+};
+
+// A dense volume primitive
+struct HOUDINIENGINE_API FHoudiniBgeoVolume
+{
+	FString Name;
+	int32 PrimitiveIndex = INDEX_NONE;
+	FIntVector Resolution = FIntVector::ZeroValue;
+	// Volume to world transform, in Houdini space
+	FMatrix Transform = FMatrix::Identity;
+	// Voxel values, X varying fastest
+	TArray<float> Values;
+};
+
+// A packed primitive, to be instanced
+struct HOUDINIENGINE_API FHoudiniBgeoPackedPrimitive
+{
+	// Packed primitive type, ie PackedDisk, PackedGeometry, AlembicRef...
+	FString Type;
+	int32 PrimitiveIndex = INDEX_NONE;
+	int32 PointIndex = INDEX_NONE;
+	// Instance transform, in Houdini space
+	FMatrix Transform = FMatrix::Identity;
+	// File referenced by packed disk and alembic primitives
+	FString FilePath;
+};
+
+// Geometry read from a .geo, .bgeo or .bgeo.sc file
+struct HOUDINIENGINE_API FHoudiniBgeoGeometry
+{
+	int32 PointCount = 0;
+	int32 VertexCount = 0;
+	int32 PrimitiveCount = 0;
+
+	// Point index of each vertex
+	TArray<int32> VertexPoints;
+
+	// Polygons: their vertex count, their vertices, and the primitive index of each polygon
+	TArray<int32> FaceCounts;
+	TArray<int32> FaceVertices;
+	TArray<int32> FacePrimitives;
+
+	TArray<FHoudiniBgeoAttribute> Attributes;
+	TArray<FHoudiniBgeoGroup> Groups;
+	TArray<FHoudiniBgeoVolume> Volumes;
+	TArray<FHoudiniBgeoPackedPrimitive> PackedPrimitives;
+
+	// Number of primitives that were skipped because their type is not supported
+	int32 UnsupportedPrimitiveCount = 0;
+
+	const FHoudiniBgeoAttribute* FindAttribute(const FString& InName, const HAPI_AttributeOwner& InOwner) const;
+
+	int32 GetAttributeCount(const HAPI_AttributeOwner& InOwner) const;
+};
+
+// Reads Houdini geometry files without a Houdini Engine session.
+// Supports the ASCII (.geo) and binary (.bgeo) JSON formats, and Blosc compressed files (.bgeo.sc) using the
+// LZ4 or zlib codecs. Reads polygons, numeric and string attributes, point and primitive groups, dense volumes
+// and packed primitives.
+struct HOUDINIENGINE_API FHoudiniBgeoReader
+{
+public:
+
+	// Reads a geometry file
+	static bool ReadFile(const FString& InFilePath, FHoudiniBgeoGeometry& OutGeometry);
+
+	// Reads the content of a geometry file, the format is detected from the data
+	static bool ReadFromMemory(const TArray<uint8>& InData, FHoudiniBgeoGeometry& OutGeometry);
+
+	// Indicates if the data is Blosc compressed
+	static bool IsBloscCompressed(const TArray<uint8>& InData);
+
+	// Decompresses a sequence of Blosc chunks
+	static bool DecompressBlosc(const TArray<uint8>& InData, TArray<uint8>& OutData);
+
+	// Parses a JSON document, in its binary or ASCII form
+	static bool ParseJSON(const uint8* InData, const int64& InSize, FHoudiniBgeoValue& OutValue);
+
+	// Reads the geometry from a parsed geometry document
+	static bool ReadGeometry(const FHoudiniBgeoValue& InRoot, FHoudiniBgeoGeometry& OutGeometry);
+
+	// Creates the HGPOs for the parts of the geometry, as the translators would get them from HAPI:
+	// a mesh part for the polygons, a volume part per volume, and an instancer part for the packed primitives.
+	static void BuildGeoPartObjects(
+		const FHoudiniBgeoGeometry& InGeometry,
+		const FString& InObjectName,
+		TArray<FHoudiniGeoPartObject>& OutHGPOs);
+};
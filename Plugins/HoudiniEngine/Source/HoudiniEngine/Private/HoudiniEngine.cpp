@@ -29,10 +29,15 @@
 #include "HoudiniEnginePrivatePCH.h"
 
 #include "HoudiniApi.h"
+#include "HoudiniApiRecorder.h"
 #include "HoudiniEngineUtils.h"
+#include "HoudiniInputGeometryCache.h"
+#include "UnrealLandscapeTranslator.h"
+#include "HoudiniMeshMarshalling.h"
 #include "HoudiniEngineRuntimeUtils.h"
 #include "HoudiniRuntimeSettings.h"
 #include "HoudiniEngineScheduler.h"
+#include "HoudiniEngineString.h"
 #include "HoudiniEngineManager.h"
 #include "HoudiniEngineRuntime.h"
 #include "HoudiniEngineRuntimeUtils.h"
@@ -144,6 +149,16 @@ FHoudiniEngine::StartupModule()
 		}
 	}
 
+	// Record or replay the HAPI calls if requested on the command line.
+	// Replays don't need libHAPI, the recording serves all the calls.
+	{
+		FString RecordingFilePath;
+		if (FParse::Value(FCommandLine::Get(), TEXT("HoudiniEngineReplay="), RecordingFilePath))
+			FHoudiniApiRecorder::StartReplay(RecordingFilePath);
+		else if (FParse::Value(FCommandLine::Get(), TEXT("HoudiniEngineRecord="), RecordingFilePath))
+			FHoudiniApiRecorder::StartRecording(RecordingFilePath);
+	}
+
 	// Create static mesh Houdini logo.
 	HoudiniLogoStaticMesh = LoadObject<UStaticMesh>(
 		nullptr, HAPI_UNREAL_RESOURCE_HOUDINI_LOGO, nullptr, LOAD_None, nullptr);
@@ -253,6 +268,9 @@ FHoudiniEngine::ShutdownModule()
 {
 	HOUDINI_LOG_MESSAGE(TEXT("Shutting down the Houdini Engine module."));
 
+	// Free the pooled mesh staging buffers
+	FHoudiniMeshMarshalling::EmptyBufferPool();
+
 	// We no longer need the Houdini logo static mesh.
 	if (HoudiniLogoStaticMesh.IsValid())
 	{
@@ -343,6 +361,9 @@ FHoudiniEngine::ShutdownModule()
 		SessionStatus = EHoudiniSessionStatus::Invalid;
 	}
 
+	// Restore the HAPI functions before they are cleared.
+	FHoudiniApiRecorder::Stop();
+
 	FHoudiniApi::FinalizeHAPI();
 
 	FHoudiniEngine::HoudiniEngineInstance = nullptr;
@@ -351,15 +372,26 @@ FHoudiniEngine::ShutdownModule()
 void
 FHoudiniEngine::AddTask(const FHoudiniEngineTask & InTask)
 {
+	// Register the task info before queuing the task, the scheduler thread
+	// can pick it up and respond immediately.
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		FHoudiniEngineTaskInfo TaskInfo;
+		TaskInfo.TaskType = InTask.TaskType;
+		TaskInfo.TaskState = EHoudiniEngineTaskState::Working;
+
+		TaskInfos.Add(InTask.HapiGUID, TaskInfo);
+	}
+
 	if ( HoudiniEngineScheduler )
 		HoudiniEngineScheduler->AddTask(InTask);
+}
 
-	FScopeLock ScopeLock(&CriticalSection);
-	FHoudiniEngineTaskInfo TaskInfo;
-	TaskInfo.TaskType = InTask.TaskType;
-	TaskInfo.TaskState = EHoudiniEngineTaskState::Working;
-
-	TaskInfos.Add(InTask.HapiGUID, TaskInfo);
+void
+FHoudiniEngine::CancelTask(const FGuid& InHapiGUID)
+{
+	if ( HoudiniEngineScheduler )
+		HoudiniEngineScheduler->CancelTask(InHapiGUID);
 }
 
 void
@@ -532,6 +564,9 @@ FHoudiniEngine::GetSessionStatusAndColor(
 void
 FHoudiniEngine::SetSessionStatus(const EHoudiniSessionStatus& InSessionStatus)
 {
+	// String handles are only valid for the session that created them
+	FHoudiniEngineString::InvalidateStringCache();
+
 	const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
 	if (HoudiniRuntimeSettings->SessionType == EHoudiniRuntimeSettingsSessionType::HRSST_None)
 	{
@@ -982,6 +1017,10 @@ FHoudiniEngine::StopSession(HAPI_Session*& SessionPtr)
 	Session.id = -1;
 	Session.type = HAPI_SESSION_MAX;
 	SetSessionStatus(EHoudiniSessionStatus::Stopped);
+
+	// The cached input nodes are gone with the session
+	FHoudiniInputGeometryCache::Reset();
+	FUnrealLandscapeTranslator::ClearLandscapeRegionExports();
 	bEnableSessionSync = false;
 
 	HoudiniEngineManager->StopHoudiniTicking();
@@ -155,6 +155,8 @@ class HOUDINIENGINE_API FHoudiniEngine : public IModuleInterface
 
 		// Register task for execution.
 		virtual void AddTask(const FHoudiniEngineTask & InTask);
+		// Cancel a queued or running task, its task info is set to Aborted.
+		virtual void CancelTask(const FGuid& InHapiGUID);
 		// Register task info.
 		virtual void AddTaskInfo(const FGuid& InHapiGUID, const FHoudiniEngineTaskInfo & InTaskInfo);
 		// Remove task info.
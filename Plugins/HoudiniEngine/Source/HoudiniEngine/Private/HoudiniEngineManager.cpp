@@ -29,6 +29,8 @@
 #include "HoudiniEnginePrivatePCH.h"
 #include "HoudiniEngine.h"
 #include "HoudiniEngineRuntime.h"
+#include "HoudiniInputGeometryCache.h"
+#include "UnrealLandscapeTranslator.h"
 #include "HoudiniAsset.h"
 #include "HoudiniAssetComponent.h"
 #include "HoudiniEngineString.h"
@@ -37,6 +39,7 @@
 #include "HoudiniPDGManager.h"
 #include "HoudiniInputTranslator.h"
 #include "HoudiniOutputTranslator.h"
+#include "HoudiniMeshTranslator.h"
 #include "HoudiniHandleTranslator.h"
 #include "HoudiniLandscapeRuntimeUtils.h"
 
@@ -47,6 +50,7 @@
 
 #if WITH_EDITOR
 	#include "Editor.h"
+	#include "Engine/Selection.h"
 	#include "EditorViewportClient.h"
 	#include "Kismet/KismetMathLibrary.h"
 
@@ -64,6 +68,14 @@ static TAutoConsoleVariable<float> CVarHoudiniEngineTickTimeLimit(
 	TEXT("1.0: Default\n")
 );
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineIdleComponentsPerTick(
+	TEXT("HoudiniEngine.IdleComponentsPerTick"),
+	1,
+	TEXT("Number of idle HDAs visited per tick of the Houdini Engine Manager, in a round robin fashion.\n")
+	TEXT("Idle HDAs only need to be visited to poll for changes that are not notified (world inputs, session sync).\n")
+	TEXT("1: Default\n")
+);
+
 FHoudiniEngineManager::FHoudiniEngineManager()
 	: CurrentIndex(0)
 	, ComponentCount(0)
@@ -145,97 +157,9 @@ FHoudiniEngineManager::Tick(float DeltaTime)
 		return true;
 	}
 
-	// Build a set of components that need to be processed
-	// 1 - selected HACs
-	// 2 - "Active" HACs
-	// 3 - The "next" inactive HAC
+	// Build the list of components that need to be processed
 	TArray<UHoudiniAssetComponent*> ComponentsToProcess;
-	if (FHoudiniEngineRuntime::IsInitialized())
-	{
-		FHoudiniEngineRuntime::Get().CleanUpRegisteredHoudiniComponents();
-
-		//FScopeLock ScopeLock(&CriticalSection);
-		ComponentCount = FHoudiniEngineRuntime::Get().GetRegisteredHoudiniComponentCount();
-
-		// Wrap around if needed
-		if (CurrentIndex >= ComponentCount)
-			CurrentIndex = 0;
-
-		for (uint32 nIdx = 0; nIdx < ComponentCount; nIdx++)
-		{
-			UHoudiniAssetComponent * CurrentComponent = FHoudiniEngineRuntime::Get().GetRegisteredHoudiniComponentAt(nIdx);
-			if (!CurrentComponent || !CurrentComponent->IsValidLowLevelFast())
-			{
-				// Invalid component, do not process
-				continue;
-			}
-			else if (!IsValid(CurrentComponent) || CurrentComponent->GetAssetState() == EHoudiniAssetState::Deleting)
-			{
-				// Component being deleted, do not process
-				continue;
-			}
-			
-			{
-				UWorld* World = CurrentComponent->GetHACWorld();
-				if (World && (World->IsPlayingReplay() || World->IsPlayInEditor()))
-				{
-					if (!CurrentComponent->IsPlayInEditorRefinementAllowed())
-					{
-						// This component's world is current in PIE and this HDA is NOT allowed to cook / refine in PIE.
-						continue;
-					}
-				}
-			}
-
-			if (!CurrentComponent->IsFullyLoaded())
-			{
-				// Let the component figure out whether it's fully loaded or not.
-				CurrentComponent->HoudiniEngineTick();
-				if (!CurrentComponent->IsFullyLoaded())
-					continue; // We need to wait some more.
-			}
-
-			if (!CurrentComponent->IsValidComponent())
-			{
-				// This component is no longer valid. Prevent it from being processed, and remove it.
-				FHoudiniEngineRuntime::Get().UnRegisterHoudiniComponent(CurrentComponent);
-				continue;
-			}
-
-			AActor* Owner = CurrentComponent->GetOwner();
-			if (Owner && Owner->IsSelectedInEditor())
-			{
-				// 1. Add selected HACs
-				// If the component's owner is selected, add it to the set
-				ComponentsToProcess.Add(CurrentComponent);
-			}
-			else if (CurrentComponent->GetAssetState() != EHoudiniAssetState::NeedInstantiation
-				&& CurrentComponent->GetAssetState() != EHoudiniAssetState::None)
-			{
-				// 2. Add "Active" HACs, the only two non-active states are:
-				// NeedInstantiation (loaded, not instantiated in H yet, not modified)
-				// None (no processing currently)
-				ComponentsToProcess.Add(CurrentComponent);
-			}
-			else if(nIdx == CurrentIndex)
-			{
-				// 3. Add the "Current" HAC
-				ComponentsToProcess.Add(CurrentComponent);
-			}
-
-			// Set the LastTickTime on the "current" HAC to 0 to ensure it's treated first
-			if (nIdx == CurrentIndex)
-			{
-				CurrentComponent->LastTickTime = 0.0;
-			}
-		}
-
-		// Increment the current index for the next tick
-		CurrentIndex++;
-	}
-
-	// Sort the components by last tick time
-	ComponentsToProcess.Sort([](const UHoudiniAssetComponent& A, const UHoudiniAssetComponent& B) { return A.LastTickTime < B.LastTickTime; });
+	GatherComponentsToProcess(ComponentsToProcess);
 
 	// Time limit for processing
 	double dProcessTimeLimit = CVarHoudiniEngineTickTimeLimit.GetValueOnAnyThread();
@@ -351,6 +275,10 @@ FHoudiniEngineManager::Tick(float DeltaTime)
 			// Update the tick time for this component
 			CurrentComponent->LastTickTime = dNow;
 		}
+
+		// Idle components don't need to be visited until they are modified again
+		if (IsComponentIdle(CurrentComponent))
+			FHoudiniEngineRuntime::Get().MarkHoudiniComponentIdle(CurrentComponent);
 	}
 
 	// Handle Asset delete
@@ -367,6 +295,11 @@ FHoudiniEngineManager::Tick(float DeltaTime)
 				FHoudiniEngineRuntime::Get().RemoveNodeIdPendingDeleteAt(DeleteIdx);
 				if (bShouldDeleteParent)
 					FHoudiniEngineRuntime::Get().RemoveParentNodePendingDelete(NodeIdToDelete);
+
+				FUnrealLandscapeTranslator::RemoveLandscapeRegionExport(NodeIdToDelete);
+
+				// Release the shared input geometry if that node was referencing it
+				FHoudiniInputGeometryCache::ReleaseReferenceAndDeleteSharedNode(NodeIdToDelete);
 			}
 		}
 	}
@@ -409,6 +342,130 @@ FHoudiniEngineManager::Tick(float DeltaTime)
 	return true;
 }
 
+void
+FHoudiniEngineManager::GatherComponentsToProcess(TArray<UHoudiniAssetComponent*>& OutComponents)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniEngineManager::GatherComponentsToProcess);
+
+	OutComponents.Reset();
+	if (!FHoudiniEngineRuntime::IsInitialized())
+		return;
+
+	FHoudiniEngineRuntime& Runtime = FHoudiniEngineRuntime::Get();
+
+	// The set of components that need to be processed is made of
+	// 1 - selected HACs
+	// 2 - the next idle HACs, round robin
+	// 3 - "Active" HACs: HACs that have been modified or are in an active state.
+#if WITH_EDITOR
+	if (GEditor)
+	{
+		for (FSelectionIterator It(GEditor->GetSelectedActorIterator()); It; ++It)
+		{
+			AActor* Actor = Cast<AActor>(*It);
+			if (!IsValid(Actor))
+				continue;
+
+			TInlineComponentArray<UHoudiniAssetComponent*> SelectedComponents(Actor);
+			for (UHoudiniAssetComponent* SelectedComponent : SelectedComponents)
+				Runtime.MarkHoudiniComponentActive(SelectedComponent);
+		}
+	}
+#endif
+
+	ComponentCount = Runtime.GetRegisteredHoudiniComponentCount();
+	const uint32 IdleCount = FMath::Min<uint32>(FMath::Max(CVarHoudiniEngineIdleComponentsPerTick.GetValueOnAnyThread(), 0), ComponentCount);
+	for (uint32 nIdx = 0; nIdx < IdleCount; nIdx++)
+	{
+		// Wrap around if needed, clean up the registered components once per sweep
+		if (CurrentIndex >= ComponentCount)
+		{
+			CurrentIndex = 0;
+			Runtime.CleanUpRegisteredHoudiniComponents();
+			ComponentCount = Runtime.GetRegisteredHoudiniComponentCount();
+			if (ComponentCount == 0)
+				break;
+		}
+
+		UHoudiniAssetComponent* CurrentComponent = Runtime.GetRegisteredHoudiniComponentAt(CurrentIndex);
+		if (CurrentComponent)
+		{
+			// Set the LastTickTime on the "current" HAC to 0 to ensure it's treated first
+			CurrentComponent->LastTickTime = 0.0;
+			Runtime.MarkHoudiniComponentActive(CurrentComponent);
+		}
+
+		// Increment the current index for the next tick
+		CurrentIndex++;
+	}
+
+	TArray<UHoudiniAssetComponent*> ActiveComponents;
+	Runtime.GetActiveHoudiniComponents(ActiveComponents);
+	for (UHoudiniAssetComponent* CurrentComponent : ActiveComponents)
+	{
+		if (!CurrentComponent->IsValidLowLevelFast())
+		{
+			// Invalid component, do not process
+			Runtime.MarkHoudiniComponentIdle(CurrentComponent);
+			continue;
+		}
+		else if (CurrentComponent->GetAssetState() == EHoudiniAssetState::Deleting)
+		{
+			// Component being deleted, do not process
+			Runtime.MarkHoudiniComponentIdle(CurrentComponent);
+			continue;
+		}
+
+		{
+			UWorld* World = CurrentComponent->GetHACWorld();
+			if (World && (World->IsPlayingReplay() || World->IsPlayInEditor()))
+			{
+				if (!CurrentComponent->IsPlayInEditorRefinementAllowed())
+				{
+					// This component's world is current in PIE and this HDA is NOT allowed to cook / refine in PIE.
+					// The idle sweep will pick it up again after PIE.
+					Runtime.MarkHoudiniComponentIdle(CurrentComponent);
+					continue;
+				}
+			}
+		}
+
+		if (!CurrentComponent->IsFullyLoaded())
+		{
+			// Let the component figure out whether it's fully loaded or not.
+			// It stays active until it is.
+			CurrentComponent->HoudiniEngineTick();
+			if (!CurrentComponent->IsFullyLoaded())
+				continue; // We need to wait some more.
+		}
+
+		if (!CurrentComponent->IsValidComponent())
+		{
+			// This component is no longer valid. Prevent it from being processed, and remove it.
+			Runtime.UnRegisterHoudiniComponent(CurrentComponent);
+			continue;
+		}
+
+		OutComponents.Add(CurrentComponent);
+	}
+
+	// Sort the components by last tick time, so the time budget is shared fairly
+	OutComponents.Sort([](const UHoudiniAssetComponent& A, const UHoudiniAssetComponent& B) { return A.LastTickTime < B.LastTickTime; });
+}
+
+bool
+FHoudiniEngineManager::IsComponentIdle(UHoudiniAssetComponent* HAC)
+{
+	if (!IsValid(HAC))
+		return true;
+
+	// The only two non-active states are:
+	// NeedInstantiation (loaded, not instantiated in H yet, not modified)
+	// None (no processing currently)
+	const EHoudiniAssetState State = HAC->GetAssetState();
+	return State == EHoudiniAssetState::NeedInstantiation || State == EHoudiniAssetState::None;
+}
+
 void
 FHoudiniEngineManager::AutoStartFirstSessionIfNeeded(UHoudiniAssetComponent* InCurrentHAC)
 {
@@ -1496,7 +1553,11 @@ FHoudiniEngineManager::BuildStaticMeshesForAllHoudiniStaticMeshes(UHoudiniAssetC
 	Progress.EnterProgressFrame(1.0f);
 #endif
 
+	// Build the meshes of all the outputs in one batch. When refining with cooks, the commands keep an outer
+	// deferred build open until every cook is done, the meshes are then built with those of the other components.
+	FHoudiniMeshTranslator::BeginDeferredStaticMeshBuilds();
 	FHoudiniOutputTranslator::BuildStaticMeshesOnHoudiniProxyMeshOutputs(HAC);
+	FHoudiniMeshTranslator::EndDeferredStaticMeshBuilds();
 
 #if WITH_EDITOR
 	Progress.EnterProgressFrame(1.0f);
@@ -170,6 +170,15 @@ protected:
 	// Automatically try to start the First HE session if needed
 	void AutoStartFirstSessionIfNeeded(UHoudiniAssetComponent* InCurrentHAC);
 
+public:
+
+	// Collects the components to process this tick: selected, active and the next idle components.
+	// Sorted by last tick time.
+	void GatherComponentsToProcess(TArray<UHoudiniAssetComponent*>& OutComponents);
+
+	// Returns true if the component has nothing left to process until it is modified again
+	static bool IsComponentIdle(UHoudiniAssetComponent* HAC);
+
 private:
 
 	// Ticker handle, used for processing HAC.
@@ -202,6 +202,7 @@
 #define HAPI_UNREAL_ATTRIB_INSTANCE_NUM_CUSTOM_FLOATS		"unreal_num_custom_floats"
 #define HAPI_UNREAL_ATTRIB_INSTANCE_CUSTOM_DATA_PREFIX		"unreal_per_instance_custom_data"
 #define HAPI_UNREAL_ATTRIB_FORCE_INSTANCER					"unreal_force_instancer"
+#define HAPI_UNREAL_ATTRIB_INSTANCE_ID						"id"
 
 #define HAPI_UNREAL_ATTRIB_LANDSCAPE_TILE_NAME				 HAPI_ATTRIB_NAME
 #define HAPI_UNREAL_ATTRIB_LANDSCAPE_VERTEX_INDEX		    "unreal_vertex_index"
@@ -333,6 +334,7 @@
 #define HAPI_UNREAL_PACKAGE_META_GENERATED_NAME                 TEXT( "HoudiniGeneratedName" )
 #define HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_TYPE         TEXT( "HoudiniGeneratedTextureType" )
 #define HAPI_UNREAL_PACKAGE_META_NODE_PATH                      TEXT( "HoudiniNodePath" )
+#define HAPI_UNREAL_PACKAGE_META_IMAGE_HASH                     TEXT( "HoudiniImageHash" )
 #define HAPI_UNREAL_PACKAGE_META_BAKE_COUNTER                   TEXT( "HoudiniPackageBakeCounter" )
 #define HAPI_UNREAL_PACKAGE_META_BAKED_OBJECT					TEXT( "HoudiniBakedObject" )
 
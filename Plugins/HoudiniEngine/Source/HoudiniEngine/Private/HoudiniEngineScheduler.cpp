@@ -31,40 +31,25 @@
 #include "HoudiniEngineUtils.h"
 #include "HoudiniEngine.h"
 
-const uint32
-FHoudiniEngineScheduler::InitialTaskSize = 256u;
-
 const float
-FHoudiniEngineScheduler::UpdateFrequency = 0.1f;
+FHoudiniEngineScheduler::StatusPollInterval = 0.02f;
 
 FHoudiniEngineScheduler::FHoudiniEngineScheduler()
-	: Tasks(nullptr)
-	, PositionWrite(0u)
-	, PositionRead(0u)
+	: WakeEvent(nullptr)
+	, RunningTask(nullptr)
 	, bStopping(false)
 {
-	//  Make sure size is power of two.
-	TaskCount = FPlatformMath::RoundUpToPowerOfTwo(FHoudiniEngineScheduler::InitialTaskSize);
-
-	if (TaskCount)
-	{
-		// Allocate buffer to store all tasks.
-		Tasks = static_cast<FHoudiniEngineTask *>(FMemory::Malloc(TaskCount * sizeof(FHoudiniEngineTask)));
-
-		if (Tasks)
-		{
-			// Zero memory.
-			FMemory::Memset(Tasks, 0x0, TaskCount * sizeof(FHoudiniEngineTask));
-		}
-	}
+	// Auto reset event: a trigger without a waiting thread is kept until the next wait,
+	// so a task added while the scheduler is busy is never missed.
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
 }
 
 FHoudiniEngineScheduler::~FHoudiniEngineScheduler()
 {
-	if (TaskCount)
+	if (WakeEvent)
 	{
-		FMemory::Free(Tasks);
-		Tasks = nullptr;
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
 	}
 }
 
@@ -242,8 +227,18 @@ FHoudiniEngineScheduler::TaskInstantiateAsset(const FHoudiniEngineTask & Task)
 				AssetId, Task, CookStateMessage);
 		}
 
-		// We want to yield.
-		FPlatformProcess::SleepNoStats(UpdateFrequency);
+		// Wait for the next status poll, or for a cancel request.
+		if (WaitForStatusPoll())
+		{
+			FHoudiniApi::Interrupt(FHoudiniEngine::Get().GetSession());
+			AddResponseMessageTaskInfo(
+				HAPI_RESULT_SUCCESS,
+				EHoudiniEngineTaskType::AssetInstantiation,
+				EHoudiniEngineTaskState::Aborted,
+				AssetId, Task, TEXT("Instantiation cancelled."));
+
+			break;
+		}
 	}
 }
 
@@ -306,6 +301,7 @@ FHoudiniEngineScheduler::TaskCookAsset(const FHoudiniEngineTask & Task)
 	for (auto& CurrentNodeId : NodesToCook)
 	{
 		Result = FHoudiniApi::CookNode(FHoudiniEngine::Get().GetSession(), CurrentNodeId, &CookOptions);
+		FHoudiniEngineString::MarkStringTableDirty();
 		if (Result != HAPI_RESULT_SUCCESS)
 		{
 			AddResponseMessageTaskInfo(
@@ -368,8 +364,18 @@ FHoudiniEngineScheduler::TaskCookAsset(const FHoudiniEngineTask & Task)
 					AssetId, Task, CookStateMessage);
 			}
 
-			// We want to yield.
-			FPlatformProcess::SleepNoStats(UpdateFrequency);
+			// Wait for the next status poll, or for a cancel request.
+			if (WaitForStatusPoll())
+			{
+				FHoudiniApi::Interrupt(FHoudiniEngine::Get().GetSession());
+				AddResponseMessageTaskInfo(
+					HAPI_RESULT_SUCCESS,
+					EHoudiniEngineTaskType::AssetCooking,
+					EHoudiniEngineTaskState::Aborted,
+					AssetId, Task, TEXT("Cooking cancelled."));
+
+				return;
+			}
 		}
 	}	
 
@@ -445,7 +451,7 @@ FHoudiniEngineScheduler::AddResponseTaskInfo(
 	//TaskInfo.bLoadedComponent = Task.bLoadedComponent;
 
 	TaskDescription(TaskInfo, Task.ActorName, StatusString);
-	FHoudiniEngine::Get().AddTaskInfo(Task.HapiGUID, TaskInfo);
+	PostTaskInfo(Task, TaskInfo);
 }
 
 void
@@ -458,34 +464,43 @@ FHoudiniEngineScheduler::AddResponseMessageTaskInfo(
 	//TaskInfo.bLoadedComponent = Task.bLoadedComponent;
 
 	TaskDescription(TaskInfo, Task.ActorName, ErrorMessage);
-	FHoudiniEngine::Get().AddTaskInfo(Task.HapiGUID, TaskInfo);
+	PostTaskInfo(Task, TaskInfo);
 }
 
 void
-FHoudiniEngineScheduler::ProcessQueuedTasks()
+FHoudiniEngineScheduler::PostTaskInfo(const FHoudiniEngineTask & Task, const FHoudiniEngineTaskInfo & TaskInfo)
 {
-	while (!bStopping)
-	{
-		while (true)
-		{
-			FHoudiniEngineTask Task;
+	// GUIDs cancelled while the task is running already received their final (aborted) info
+	if (!RunningCancelledGUIDs.Contains(Task.HapiGUID))
+		FHoudiniEngine::Get().AddTaskInfo(Task.HapiGUID, TaskInfo);
 
-			{
-				FScopeLock ScopeLock(&CriticalSection);
-
-				// We have no tasks left.
-				if (PositionWrite == PositionRead)
-					break;
+	for (const FGuid& CoalescedGUID : Task.CoalescedGUIDs)
+	{
+		if (!RunningCancelledGUIDs.Contains(CoalescedGUID))
+			FHoudiniEngine::Get().AddTaskInfo(CoalescedGUID, TaskInfo);
+	}
+}
 
-				// Retrieve task.
-				Task = Tasks[PositionRead];
-				PositionRead++;
+void
+FHoudiniEngineScheduler::PostTaskCancelled(const FHoudiniEngineTask & Task, const FGuid & TaskGUID)
+{
+	FHoudiniEngineTaskInfo TaskInfo(HAPI_RESULT_SUCCESS, Task.AssetId, Task.TaskType, EHoudiniEngineTaskState::Aborted);
+	TaskDescription(TaskInfo, Task.ActorName, TEXT("Cancelled"));
+	FHoudiniEngine::Get().AddTaskInfo(TaskGUID, TaskInfo);
+}
 
-				// Wrap around if required.
-				PositionRead &= (TaskCount - 1);
-			}
+void
+FHoudiniEngineScheduler::ProcessQueuedTasks(bool bReturnWhenIdle)
+{
+	while (!bStopping)
+	{
+		DrainIncomingQueues();
 
-			bool bTaskProcessed = true;
+		FHoudiniEngineTask Task;
+		if (PopNextTask(Task))
+		{
+			RunningTask = &Task;
+			RunningCancelledGUIDs.Empty();
 
 			switch (Task.TaskType)
 			{
@@ -515,26 +530,188 @@ FHoudiniEngineScheduler::ProcessQueuedTasks()
 
 				default:
 				{
-					bTaskProcessed = false;
 					break;
 				}
 			}
 
-			if (!bTaskProcessed)
-				break;
+			RunningTask = nullptr;
+			RunningCancelledGUIDs.Empty();
+			QueuedTaskCount.Decrement();
+			continue;
 		}
 
-		if (FPlatformProcess::SupportsMultithreading())
-		{
-			// We want to yield for a bit.
-			FPlatformProcess::SleepNoStats(UpdateFrequency);
-		}
-		else
+		if (bReturnWhenIdle || !FPlatformProcess::SupportsMultithreading())
 		{
 			// If we are running in single threaded mode, return so we don't block everything else.
 			return;
 		}
+
+		// Nothing left to do, sleep until a task or a cancel request is added.
+		WakeEvent->Wait();
+	}
+}
+
+bool
+FHoudiniEngineScheduler::DrainIncomingQueues()
+{
+	// Tasks first, so cancel requests find the tasks they were issued for.
+	for (int32 Priority = 0; Priority < (int32)EHoudiniEngineTaskPriority::Count; Priority++)
+	{
+		FHoudiniEngineTask Task;
+		while (IncomingTasks[Priority].Dequeue(Task))
+		{
+			if (Task.TaskType == EHoudiniEngineTaskType::AssetCooking && CoalesceCookTask(Task))
+				continue;
+
+			PendingTasks[Priority].Add(MoveTemp(Task));
+		}
+	}
+
+	bool bRunningTaskCancelled = false;
+	FGuid CancelGUID;
+	while (CancelRequests.Dequeue(CancelGUID))
+	{
+		if (CancelPendingTask(CancelGUID))
+			continue;
+
+		if (RunningTask && (CancelGUID == RunningTask->HapiGUID || RunningTask->CoalescedGUIDs.Contains(CancelGUID)))
+		{
+			if (!RunningCancelledGUIDs.Contains(CancelGUID))
+			{
+				PostTaskCancelled(*RunningTask, CancelGUID);
+				RunningCancelledGUIDs.Add(CancelGUID);
+			}
+
+			// Only interrupt HAPI if nobody else waits for the result of this task.
+			if (RunningCancelledGUIDs.Num() == RunningTask->CoalescedGUIDs.Num() + 1)
+				bRunningTaskCancelled = true;
+
+			continue;
+		}
+
+		// The task might have been added after we drained the task queues.
+		for (int32 Priority = 0; Priority < (int32)EHoudiniEngineTaskPriority::Count; Priority++)
+		{
+			FHoudiniEngineTask Task;
+			while (IncomingTasks[Priority].Dequeue(Task))
+			{
+				if (Task.TaskType == EHoudiniEngineTaskType::AssetCooking && CoalesceCookTask(Task))
+					continue;
+
+				PendingTasks[Priority].Add(MoveTemp(Task));
+			}
+		}
+
+		// Unknown GUIDs belong to tasks that are already finished.
+		CancelPendingTask(CancelGUID);
+	}
+
+	return bRunningTaskCancelled;
+}
+
+bool
+FHoudiniEngineScheduler::PopNextTask(FHoudiniEngineTask & OutTask)
+{
+	for (int32 Priority = 0; Priority < (int32)EHoudiniEngineTaskPriority::Count; Priority++)
+	{
+		if (PendingTasks[Priority].Num() <= 0)
+			continue;
+
+		OutTask = MoveTemp(PendingTasks[Priority][0]);
+		PendingTasks[Priority].RemoveAt(0);
+		return true;
+	}
+
+	return false;
+}
+
+bool
+FHoudiniEngineScheduler::CoalesceCookTask(const FHoudiniEngineTask & Task)
+{
+	for (int32 Priority = 0; Priority < (int32)EHoudiniEngineTaskPriority::Count; Priority++)
+	{
+		for (int32 Idx = 0; Idx < PendingTasks[Priority].Num(); Idx++)
+		{
+			FHoudiniEngineTask& Pending = PendingTasks[Priority][Idx];
+			if (Pending.TaskType != EHoudiniEngineTaskType::AssetCooking || Pending.AssetId != Task.AssetId)
+				continue;
+
+			// One cook of the asset answers both requests.
+			for (const HAPI_NodeId& NodeId : Task.OtherNodeIds)
+				Pending.OtherNodeIds.AddUnique(NodeId);
+
+			Pending.CoalescedGUIDs.Add(Task.HapiGUID);
+			Pending.CoalescedGUIDs.Append(Task.CoalescedGUIDs);
+			Pending.ActorName = Task.ActorName;
+			Pending.bUseOutputNodes = Task.bUseOutputNodes;
+			Pending.bOutputTemplateGeos = Task.bOutputTemplateGeos;
+
+			// The merged cook runs with the most urgent priority of its requests.
+			if ((int32)Task.Priority < Priority)
+			{
+				FHoudiniEngineTask Merged = MoveTemp(Pending);
+				PendingTasks[Priority].RemoveAt(Idx);
+				Merged.Priority = Task.Priority;
+				PendingTasks[(int32)Task.Priority].Add(MoveTemp(Merged));
+			}
+
+			QueuedTaskCount.Decrement();
+			CoalescedTaskCount.Increment();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool
+FHoudiniEngineScheduler::CancelPendingTask(const FGuid & TaskGUID)
+{
+	for (int32 Priority = 0; Priority < (int32)EHoudiniEngineTaskPriority::Count; Priority++)
+	{
+		for (int32 Idx = 0; Idx < PendingTasks[Priority].Num(); Idx++)
+		{
+			FHoudiniEngineTask& Pending = PendingTasks[Priority][Idx];
+			if (Pending.HapiGUID != TaskGUID && !Pending.CoalescedGUIDs.Contains(TaskGUID))
+				continue;
+
+			PostTaskCancelled(Pending, TaskGUID);
+			if (Pending.HapiGUID != TaskGUID)
+			{
+				Pending.CoalescedGUIDs.Remove(TaskGUID);
+			}
+			else if (Pending.CoalescedGUIDs.Num() > 0)
+			{
+				// Other requests still wait for this task.
+				Pending.HapiGUID = Pending.CoalescedGUIDs.Pop(false);
+			}
+			else
+			{
+				PendingTasks[Priority].RemoveAt(Idx);
+				QueuedTaskCount.Decrement();
+			}
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool
+FHoudiniEngineScheduler::WaitForStatusPoll()
+{
+	if (FPlatformProcess::SupportsMultithreading())
+	{
+		// Woken up early by new tasks or cancel requests.
+		WakeEvent->Wait((uint32)(StatusPollInterval * 1000.0f));
+	}
+	else
+	{
+		FPlatformProcess::SleepNoStats(StatusPollInterval);
 	}
+
+	return DrainIncomingQueues();
 }
 
 void
@@ -591,70 +768,35 @@ FHoudiniEngineScheduler::TaskProccessAsset(const FHoudiniEngineTask & Task)
 
 bool FHoudiniEngineScheduler::HasPendingTasks()
 {
-	FScopeLock ScopeLock(&CriticalSection);
-	return (PositionWrite != PositionRead);
+	return QueuedTaskCount.GetValue() > 0;
 }
 
 void
 FHoudiniEngineScheduler::AddTask(const FHoudiniEngineTask & Task)
 {
-	FScopeLock ScopeLock(&CriticalSection);
-
-	// Check if we need to grow our circular buffer.
-	if (PositionWrite + 1 == PositionRead)
-	{
-		// Calculate next size (next power of two).
-		uint32 NextTaskCount = FPlatformMath::RoundUpToPowerOfTwo(TaskCount + 1);
-
-		// Allocate new buffer.
-		FHoudiniEngineTask * Buffer = static_cast<FHoudiniEngineTask *>(
-			FMemory::Malloc(NextTaskCount * sizeof(FHoudiniEngineTask)));
+	FHoudiniEngineTask QueuedTask = Task;
+	QueuedTask.QueuedTime = FPlatformTime::Seconds();
+	const int32 Priority = FMath::Clamp((int32)Task.Priority, 0, (int32)EHoudiniEngineTaskPriority::Count - 1);
 
-		if (!Buffer)
-			return;
-
-		// Zero memory.
-		FMemory::Memset(Buffer, 0x0, NextTaskCount * sizeof(FHoudiniEngineTask));
-
-		// Copy elements from old buffer to new one.
-		if (PositionRead < PositionWrite)
-		{
-			FMemory::Memcpy(Buffer, Tasks + PositionRead, sizeof(FHoudiniEngineTask) * (PositionWrite - PositionRead));
-
-			// Update index positions.
-			PositionRead = 0;
-			PositionWrite = PositionWrite - PositionRead;
-		}
-		else
-		{
-			FMemory::Memcpy(Buffer, Tasks + PositionRead, sizeof(FHoudiniEngineTask) * (TaskCount - PositionRead));
-			FMemory::Memcpy(Buffer + TaskCount - PositionRead, Tasks, sizeof(FHoudiniEngineTask) * PositionWrite);
-
-			// Update index positions.
-			PositionRead = 0;
-			PositionWrite = TaskCount - PositionRead + PositionWrite;
-		}
-
-		// Deallocate old buffer.
-		FMemory::Free(Tasks);
-
-		// Bookkeeping.
-		Tasks = Buffer;
-		TaskCount = NextTaskCount;
-	}
+	QueuedTaskCount.Increment();
+	IncomingTasks[Priority].Enqueue(MoveTemp(QueuedTask));
+	WakeEvent->Trigger();
+}
 
-	// Store task.
-	Tasks[PositionWrite] = Task;
-	PositionWrite++;
+void
+FHoudiniEngineScheduler::CancelTask(const FGuid & TaskGUID)
+{
+	if (!TaskGUID.IsValid())
+		return;
 
-	// Wrap around if required.
-	PositionWrite &= (TaskCount - 1);
+	CancelRequests.Enqueue(TaskGUID);
+	WakeEvent->Trigger();
 }
 
 uint32
 FHoudiniEngineScheduler::Run()
 {
-	ProcessQueuedTasks();
+	ProcessQueuedTasks(false);
 	return 0;
 }
 
@@ -662,12 +804,16 @@ void
 FHoudiniEngineScheduler::Stop()
 {
 	bStopping = true;
+
+	// Wake up the scheduler thread so it can exit.
+	if (WakeEvent)
+		WakeEvent->Trigger();
 }
 
 void
 FHoudiniEngineScheduler::Tick()
 {
-	ProcessQueuedTasks();
+	ProcessQueuedTasks(true);
 }
 
 FSingleThreadRunnable *
@@ -28,10 +28,18 @@
 
 #include "HoudiniEngineTask.h"
 #include "HoudiniEngineTaskInfo.h"
+#include "Containers/Queue.h"
+#include "HAL/Event.h"
 #include "HAL/Runnable.h"
 #include "HAL/RunnableThread.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "Misc/SingleThreadRunnable.h"
 
+// Runs HAPI tasks on the scheduler thread.
+// Producers push tasks into lock-free MPSC queues (one per priority) and signal an event,
+// the scheduler thread sleeps on that event while there is nothing to do.
+// Queued cook requests for the same asset are coalesced into one cook, and queued or
+// running tasks can be cancelled by GUID.
 class FHoudiniEngineScheduler : public FRunnable, FSingleThreadRunnable
 {
 public:
@@ -49,9 +57,16 @@ public:
 
 	bool HasPendingTasks();
 
-	// Adds a task.
+	// Adds a task. Can be called from any thread.
 	void AddTask(const FHoudiniEngineTask & Task);
 
+	// Cancels a queued or running task. Can be called from any thread.
+	// The task's info is set to Aborted once the scheduler thread handled the request.
+	void CancelTask(const FGuid & TaskGUID);
+
+	// Number of cook requests merged into an already queued cook.
+	int32 GetCoalescedTaskCount() const { return CoalescedTaskCount.GetValue(); }
+
 	// Adds instantiation response task info.
 	void AddResponseTaskInfo(
 		HAPI_Result Result, 
@@ -71,7 +86,30 @@ public:
 protected:
 
 	// Process queued tasks. 
-	void ProcessQueuedTasks();
+	// When bReturnWhenIdle is false, waits for new tasks until the scheduler is stopped.
+	void ProcessQueuedTasks(bool bReturnWhenIdle);
+
+	// Moves new tasks from the incoming queues to the pending lists, coalescing redundant cooks,
+	// and handles cancel requests. Returns true if the running task has been cancelled.
+	bool DrainIncomingQueues();
+
+	// Pops the next pending task by priority.
+	bool PopNextTask(FHoudiniEngineTask & OutTask);
+
+	// Merges a cook request into an already pending cook of the same asset.
+	bool CoalesceCookTask(const FHoudiniEngineTask & Task);
+
+	// Removes a cancelled GUID from the pending tasks. Returns true if found.
+	bool CancelPendingTask(const FGuid & TaskGUID);
+
+	// Waits for the next HAPI status poll, returns true if the running task got cancelled meanwhile.
+	bool WaitForStatusPoll();
+
+	// Sends a task info to the task's GUID and to the GUIDs coalesced into it.
+	void PostTaskInfo(const FHoudiniEngineTask & Task, const FHoudiniEngineTaskInfo & TaskInfo);
+
+	// Sets the task info of a cancelled GUID to Aborted.
+	void PostTaskCancelled(const FHoudiniEngineTask & Task, const FGuid & TaskGUID);
 
 	// Task : instantiate an asset. 
 	void TaskInstantiateAsset(const FHoudiniEngineTask & Task);
@@ -93,27 +131,31 @@ protected:
 
 private:
 
-	// Initial number of tasks in our circular queue. 
-	static const uint32 InitialTaskSize;
+	// Interval between two HAPI cook status polls of a running task.
+	static const float StatusPollInterval;
+
+	// New tasks, one queue per priority. Written by any thread, read by the scheduler thread.
+	TQueue<FHoudiniEngineTask, EQueueMode::Mpsc> IncomingTasks[(int32)EHoudiniEngineTaskPriority::Count];
 
-	// Frequency update (sleep time between each update)
-	static const float UpdateFrequency;
+	// GUIDs of tasks to cancel. Written by any thread, read by the scheduler thread.
+	TQueue<FGuid, EQueueMode::Mpsc> CancelRequests;
 
-	// Synchronization primitive. 
-	FCriticalSection CriticalSection;
+	// Tasks taken from the incoming queues but not started yet. Scheduler thread only.
+	TArray<FHoudiniEngineTask> PendingTasks[(int32)EHoudiniEngineTaskPriority::Count];
 
-	// List of scheduled tasks. 
-	FHoudiniEngineTask* Tasks;
+	// Signaled when a task or a cancel request is added, or when stopping.
+	FEvent * WakeEvent;
 
-	// Head of the circular queue. 
-	uint32 PositionWrite;
+	// Number of queued tasks that have not finished yet.
+	FThreadSafeCounter QueuedTaskCount;
 
-	// Tail of the circular queue. 
-	uint32 PositionRead;
+	// Number of cook requests merged into other cooks.
+	FThreadSafeCounter CoalescedTaskCount;
 
-	// Size of the circular queue. 
-	uint32 TaskCount;
+	// Task currently running and its GUIDs cancelled while it runs. Scheduler thread only.
+	const FHoudiniEngineTask * RunningTask;
+	TArray<FGuid> RunningCancelledGUIDs;
 
 	// Stopping flag. 
-	bool bStopping;
+	TAtomic<bool> bStopping;
 };
@@ -30,8 +30,206 @@
 #include "HoudiniEngine.h"
 #include "HoudiniEnginePrivatePCH.h"
 
+#include "HAL/IConsoleManager.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Misc/ScopeLock.h"
+
 #include <vector>
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineStringCache(
+	TEXT("HoudiniEngine.StringCache"),
+	1,
+	TEXT("When enabled, the strings resolved from HAPI string handles are kept until the next cook or session change instead of being fetched again for every query.\n")
+	TEXT("0: Resolve the string handles with HAPI on every query\n")
+	TEXT("1: Cache the resolved strings (default)\n")
+);
+
+// The cache is emptied when it grows past this number of strings
+#define HOUDINI_STRING_CACHE_MAX_ENTRIES 1048576
+
+// Strings resolved from HAPI string handles, since the last cook or session change
+struct FHoudiniEngineStringCache
+{
+	FCriticalSection Lock;
+	TMap<int32, FString> Strings;
+
+	// Incremented when a cook may have modified the string table
+	FThreadSafeCounter StringTableVersion;
+	// Version of the string table the cached strings were resolved from
+	int32 CachedVersion = 0;
+
+	FThreadSafeCounter64 HitCount;
+	FThreadSafeCounter64 MissCount;
+};
+
+static FHoudiniEngineStringCache&
+GetStringCache()
+{
+	static FHoudiniEngineStringCache StringCache;
+	return StringCache;
+}
+
+static bool
+IsStringCacheEnabled()
+{
+	return CVarHoudiniEngineStringCache.GetValueOnAnyThread() > 0;
+}
+
+// Resolves the given handles with GetStringBatchSize/GetStringBatch
+static bool
+HapiGetStringBatch(const TArray<int32>& InStringIdArray, TArray<FString>& OutStringArray)
+{
+	OutStringArray.Empty(InStringIdArray.Num());
+
+	int32 BufferSize = 0;
+	if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetStringBatchSize(
+		FHoudiniEngine::Get().GetSession(), InStringIdArray.GetData(), InStringIdArray.Num(), &BufferSize))
+		return false;
+
+	if (BufferSize <= 0)
+		return false;
+
+	TArray<char> Buffer;
+	Buffer.SetNumZeroed(BufferSize);
+	if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetStringBatch(FHoudiniEngine::Get().GetSession(), &Buffer[0], BufferSize))
+		return false;
+
+	// Parse the buffer to a string array
+	int32 StringOffset = 0;
+	while (StringOffset < BufferSize)
+	{
+		OutStringArray.Add(UTF8_TO_TCHAR(&Buffer[StringOffset]));
+
+		// Move on to next indexed string
+		while (StringOffset < BufferSize && Buffer[StringOffset] != 0)
+			StringOffset++;
+
+		StringOffset++;
+	}
+
+	return OutStringArray.Num() == InStringIdArray.Num();
+}
+
+// Empties the cache if a cook may have changed the string table since the strings were cached.
+// Needs the cache lock, returns the current version of the string table.
+static int32
+SyncStringCacheVersion(FHoudiniEngineStringCache& StringCache)
+{
+	const int32 CurrentVersion = StringCache.StringTableVersion.GetValue();
+	if (StringCache.CachedVersion != CurrentVersion)
+	{
+		StringCache.Strings.Empty();
+		StringCache.CachedVersion = CurrentVersion;
+	}
+
+	return CurrentVersion;
+}
+
+// Splits the handles between the ones found in the cache and the ones that need to be resolved.
+// OutVersion is the string table version to pass to AddCachedStrings once the missing strings are resolved.
+static void
+FindCachedStrings(const TSet<int32>& InStringIds, TMap<int32, FString>& OutFoundStrings, TArray<int32>& OutMissingIds, int32& OutVersion)
+{
+	FHoudiniEngineStringCache& StringCache = GetStringCache();
+	OutVersion = StringCache.StringTableVersion.GetValue();
+	if (!IsStringCacheEnabled())
+	{
+		OutMissingIds = InStringIds.Array();
+		return;
+	}
+
+	int32 HitCount = 0;
+	{
+		FScopeLock ScopeLock(&StringCache.Lock);
+		OutVersion = SyncStringCacheVersion(StringCache);
+		for (const int32& CurrentId : InStringIds)
+		{
+			const FString* CachedString = CurrentId > 0 ? StringCache.Strings.Find(CurrentId) : nullptr;
+			if (CachedString)
+			{
+				OutFoundStrings.Add(CurrentId, *CachedString);
+				HitCount++;
+			}
+			else
+			{
+				OutMissingIds.Add(CurrentId);
+			}
+		}
+	}
+
+	StringCache.HitCount.Add(HitCount);
+	StringCache.MissCount.Add(OutMissingIds.Num());
+}
+
+static bool
+FindCachedString(const int32& InStringId, FString& OutString, int32& OutVersion)
+{
+	FHoudiniEngineStringCache& StringCache = GetStringCache();
+	OutVersion = StringCache.StringTableVersion.GetValue();
+	if (InStringId <= 0 || !IsStringCacheEnabled())
+		return false;
+
+	const FString* CachedString = nullptr;
+	{
+		FScopeLock ScopeLock(&StringCache.Lock);
+		OutVersion = SyncStringCacheVersion(StringCache);
+		CachedString = StringCache.Strings.Find(InStringId);
+		if (CachedString)
+			OutString = *CachedString;
+	}
+
+	if (CachedString)
+		StringCache.HitCount.Increment();
+	else
+		StringCache.MissCount.Increment();
+
+	return CachedString != nullptr;
+}
+
+// InVersion is the string table version returned by the lookup that preceded the resolve
+static void
+AddCachedStrings(const TArray<int32>& InStringIds, const TArray<FString>& InStrings, const int32& InVersion)
+{
+	if (!IsStringCacheEnabled())
+		return;
+
+	FHoudiniEngineStringCache& StringCache = GetStringCache();
+	FScopeLock ScopeLock(&StringCache.Lock);
+
+	// A cook happened while the strings were resolved, they might come from the previous string table
+	if (SyncStringCacheVersion(StringCache) != InVersion)
+		return;
+
+	if (StringCache.Strings.Num() + InStringIds.Num() > HOUDINI_STRING_CACHE_MAX_ENTRIES)
+		StringCache.Strings.Empty();
+
+	for (int32 Idx = 0; Idx < InStringIds.Num(); Idx++)
+	{
+		// Null/invalid handles are never cached
+		if (InStringIds[Idx] <= 0)
+			continue;
+
+		StringCache.Strings.Add(InStringIds[Idx], InStrings[Idx]);
+	}
+}
+
+static FAutoConsoleCommand CCmdHoudiniEngineStringCacheStats(
+	TEXT("HoudiniEngine.StringCacheStats"),
+	TEXT("Logs the hit and miss counts of the HAPI string cache since the last call, then resets them."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		int64 HitCount = 0;
+		int64 MissCount = 0;
+		int32 EntryCount = 0;
+		FHoudiniEngineString::GetStringCacheStats(HitCount, MissCount, EntryCount);
+		const int64 QueryCount = HitCount + MissCount;
+		HOUDINI_LOG_MESSAGE(
+			TEXT("String cache: %lld queries, %lld hits (%.1f%%), %lld misses, %d cached strings."),
+			QueryCount, HitCount, QueryCount > 0 ? 100.0 * HitCount / QueryCount : 0.0, MissCount, EntryCount);
+		FHoudiniEngineString::ResetStringCacheStats();
+	}));
+
 FHoudiniEngineString::FHoudiniEngineString()
 	: StringId(-1)
 {}
@@ -130,11 +328,15 @@ bool
 FHoudiniEngineString::ToFString(FString& String) const
 {
 	String = TEXT("");
-	std::string NamePlain = "";
+	int32 StringTableVersion = 0;
+	if (FindCachedString(StringId, String, StringTableVersion))
+		return true;
 
+	std::string NamePlain = "";
 	if (ToStdString(NamePlain))
 	{
 		String = UTF8_TO_TCHAR(NamePlain.c_str());
+		AddCachedStrings({ StringId }, { String }, StringTableVersion);
 		return true;
 	}
 
@@ -196,59 +398,42 @@ FHoudiniEngineString::SHArrayToFStringArray(const TArray<int32>& InStringIdArray
 bool
 FHoudiniEngineString::SHArrayToFStringArray_Batch(const TArray<int32>& InStringIdArray, TArray<FString>& OutStringArray)
 {
-    bool bReturn = true;
-    OutStringArray.SetNumZeroed(InStringIdArray.Num());
-
-    TSet<int32> UniqueSH;
-    for (const auto& CurrentSH : InStringIdArray)
-    {
-        UniqueSH.Add(CurrentSH);
-    }
-
-    TArray<int32> UniqueSHArray = UniqueSH.Array();
-
-    int32 BufferSize = 0;
-    if (HAPI_RESULT_SUCCESS
-        != FHoudiniApi::GetStringBatchSize(FHoudiniEngine::Get().GetSession(), UniqueSHArray.GetData(),
-                                           UniqueSHArray.Num(), &BufferSize))
-        return false;
+	OutStringArray.SetNumZeroed(InStringIdArray.Num());
 
-    if (BufferSize <= 0)
-        return false;
+	TSet<int32> UniqueSH;
+	for (const auto& CurrentSH : InStringIdArray)
+	{
+		UniqueSH.Add(CurrentSH);
+	}
 
-    TArray<char> Buffer;
-    Buffer.SetNumZeroed(BufferSize);
-    if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetStringBatch(FHoudiniEngine::Get().GetSession(), &Buffer[0], BufferSize))
-        return false;
+	// Only the strings that are not in the cache are fetched from HAPI
+	TMap<int32, FString> StringMap;
+	StringMap.Reserve(UniqueSH.Num());
+	TArray<int32> MissingSHArray;
+	int32 StringTableVersion = 0;
+	FindCachedStrings(UniqueSH, StringMap, MissingSHArray, StringTableVersion);
 
-    // Parse the buffer to a string array
-    TMap<int, FString> StringMap;
-    int Index = 0;
-    int StringOffset = 0;
-    while (StringOffset < BufferSize)
-    {
-        // Add the current string to our dictionary.
-        FString StringValue = UTF8_TO_TCHAR(& Buffer[StringOffset]);
-        StringMap.Add(UniqueSHArray[Index], StringValue);
-
-        // Move on to next indexed string
-        Index++;
-        while (Buffer[StringOffset] != 0 && StringOffset < BufferSize)
-            StringOffset++;
+	if (MissingSHArray.Num() > 0)
+	{
+		TArray<FString> MissingStrings;
+		if (!HapiGetStringBatch(MissingSHArray, MissingStrings))
+			return false;
 
-        StringOffset++;
-    }
+		for (int32 Idx = 0; Idx < MissingSHArray.Num(); Idx++)
+		{
+			StringMap.Add(MissingSHArray[Idx], MissingStrings[Idx]);
+		}
 
-    if (StringMap.Num() != UniqueSH.Num())
-        return false;
+		AddCachedStrings(MissingSHArray, MissingStrings, StringTableVersion);
+	}
 
-    // Fill the output array using the map
-    for (int32 IdxSH = 0; IdxSH < InStringIdArray.Num(); IdxSH++)
-    {
-        OutStringArray[IdxSH] = StringMap[InStringIdArray[IdxSH]];
-    }
+	// Fill the output array using the map
+	for (int32 IdxSH = 0; IdxSH < InStringIdArray.Num(); IdxSH++)
+	{
+		OutStringArray[IdxSH] = StringMap[InStringIdArray[IdxSH]];
+	}
 
-    return true;
+	return true;
 }
 
 bool
@@ -281,6 +466,69 @@ FHoudiniEngineString::SHArrayToFStringArray_Singles(const TArray<int32>& InStrin
 	return bReturn;
 }
 
+bool
+FHoudiniEngineString::PrefetchStrings(const TArray<int32>& InStringIdArray)
+{
+	if (!IsStringCacheEnabled())
+		return false;
+
+	TSet<int32> UniqueSH;
+	for (const auto& CurrentSH : InStringIdArray)
+	{
+		if (CurrentSH > 0)
+			UniqueSH.Add(CurrentSH);
+	}
+
+	TMap<int32, FString> FoundStrings;
+	TArray<int32> MissingSHArray;
+	int32 StringTableVersion = 0;
+	FindCachedStrings(UniqueSH, FoundStrings, MissingSHArray, StringTableVersion);
+	if (MissingSHArray.Num() <= 0)
+		return true;
+
+	TArray<FString> MissingStrings;
+	if (!HapiGetStringBatch(MissingSHArray, MissingStrings))
+		return false;
+
+	AddCachedStrings(MissingSHArray, MissingStrings, StringTableVersion);
+	return true;
+}
+
+void
+FHoudiniEngineString::InvalidateStringCache()
+{
+	FHoudiniEngineStringCache& StringCache = GetStringCache();
+	FScopeLock ScopeLock(&StringCache.Lock);
+	StringCache.Strings.Empty();
+	// Strings resolved before the session changed are not added to the cache
+	StringCache.CachedVersion = StringCache.StringTableVersion.Increment();
+}
+
+void
+FHoudiniEngineString::MarkStringTableDirty()
+{
+	GetStringCache().StringTableVersion.Increment();
+}
+
+void
+FHoudiniEngineString::GetStringCacheStats(int64& OutHitCount, int64& OutMissCount, int32& OutEntryCount)
+{
+	FHoudiniEngineStringCache& StringCache = GetStringCache();
+	OutHitCount = StringCache.HitCount.GetValue();
+	OutMissCount = StringCache.MissCount.GetValue();
+
+	FScopeLock ScopeLock(&StringCache.Lock);
+	OutEntryCount = StringCache.Strings.Num();
+}
+
+void
+FHoudiniEngineString::ResetStringCacheStats()
+{
+	FHoudiniEngineStringCache& StringCache = GetStringCache();
+	StringCache.HitCount.Reset();
+	StringCache.MissCount.Reset();
+}
+
 const FString& FHoudiniEngineIndexedStringMap::GetStringForIndex(int Index) const
 {
     StringId Id = Ids[Index];
@@ -67,6 +67,19 @@ class HOUDINIENGINE_API FHoudiniEngineString
 		// Array converter, uses a map to reduce HAPI calls
 		static bool SHArrayToFStringArray_Singles(const TArray<int32>& InStringIdArray, TArray<FString>& OutStringArray);
 
+		// Resolves all the handles that are not in the string cache with a single string batch
+		static bool PrefetchStrings(const TArray<int32>& InStringIdArray);
+
+		// String cache, shared by all the converters until the next cook or session change.
+		// Empties the cache, needs to be called when the session changes.
+		static void InvalidateStringCache();
+		// Indicates that a cook might have changed the session's string table,
+		// the cache is emptied before its next use.
+		static void MarkStringTableDirty();
+		// Cache statistics, for profiling
+		static void GetStringCacheStats(int64& OutHitCount, int64& OutMissCount, int32& OutEntryCount);
+		static void ResetStringCacheStats();
+
 		// Return id of this string.
 		int32 GetId() const;
 
@@ -30,6 +30,8 @@
 
 FHoudiniEngineTask::FHoudiniEngineTask()
 	: TaskType(EHoudiniEngineTaskType::None)
+	, Priority(EHoudiniEngineTaskPriority::Normal)
+	, QueuedTime(0.0)
 	, ActorName(TEXT(""))
 	, AssetId(-1)
 	, bUseOutputNodes(false)
@@ -44,6 +46,8 @@ FHoudiniEngineTask::FHoudiniEngineTask()
 FHoudiniEngineTask::FHoudiniEngineTask(EHoudiniEngineTaskType InTaskType, FGuid InHapiGUID)
 	: HapiGUID(InHapiGUID)
 	, TaskType(InTaskType)
+	, Priority(EHoudiniEngineTaskPriority::Normal)
+	, QueuedTime(0.0)
 	, ActorName(TEXT(""))
 	, AssetId(-1)
 	, bUseOutputNodes(false)
@@ -52,4 +56,21 @@ FHoudiniEngineTask::FHoudiniEngineTask(EHoudiniEngineTaskType InTaskType, FGuid
 	, AssetHapiName(-1)
 {
 	OtherNodeIds.Empty();
+
+	// Cooks are what the user waits for after a change, deletions and processing can wait.
+	switch (TaskType)
+	{
+		case EHoudiniEngineTaskType::AssetCooking:
+			Priority = EHoudiniEngineTaskPriority::High;
+			break;
+
+		case EHoudiniEngineTaskType::AssetDeletion:
+		case EHoudiniEngineTaskType::AssetProcess:
+			Priority = EHoudiniEngineTaskPriority::Low;
+			break;
+
+		default:
+			Priority = EHoudiniEngineTaskPriority::Normal;
+			break;
+	}
 }
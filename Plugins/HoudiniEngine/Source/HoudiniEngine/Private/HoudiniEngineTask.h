@@ -68,6 +68,21 @@ enum class EHoudiniEngineTaskType : uint8
 	AssetProcess,
 };
 
+// Order in which the scheduler picks up queued tasks.
+enum class EHoudiniEngineTaskPriority : uint8
+{
+	// Interactive requests (parameter or input changes leading to a cook).
+	High,
+
+	// Instantiations.
+	Normal,
+
+	// Background work (deletions, result processing).
+	Low,
+
+	Count
+};
+
 struct HOUDINIENGINE_API FHoudiniEngineTask
 {
 	// Constructors.
@@ -80,6 +95,16 @@ struct HOUDINIENGINE_API FHoudiniEngineTask
 	// Type of this task.
 	EHoudiniEngineTaskType TaskType;
 
+	// Priority of this task, defaults depend on the task type.
+	EHoudiniEngineTaskPriority Priority;
+
+	// GUIDs of redundant requests merged into this task by the scheduler.
+	// They receive the same task infos as HapiGUID.
+	TArray<FGuid> CoalescedGUIDs;
+
+	// Time the task was handed to the scheduler (FPlatformTime::Seconds()).
+	double QueuedTime;
+
 	// Houdini asset for instantiation.
 	TWeakObjectPtr< class UHoudiniAsset > Asset;
 
@@ -100,6 +100,7 @@
 #include "FileHelpers.h"
 #include "Factories/WorldFactory.h"
 #include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
 
 #if WITH_EDITOR
 	#include "EditorModeManager.h"
@@ -189,12 +190,51 @@ TArray<int> RunLengthEncode(const DataType* Data, int TupleSize, int Count, cons
     return EncodedData;
 }
 
-// Maximum size of the data that can be sent via thrift
+// Maximum size of the string data that can be sent via thrift
 //#define THRIFT_MAX_CHUNKSIZE			100 * 1024 * 1024 // This is supposedly the current limit in thrift, but still seems to be too large
 #define THRIFT_MAX_CHUNKSIZE			10 * 1024 * 1024
 //#define THRIFT_MAX_CHUNKSIZE			2048 * 2048
 //#define THRIFT_MAX_CHUNKSIZE_STRING		256 * 256
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineBulkTransferChunkSize(
+	TEXT("HoudiniEngine.BulkTransferChunkSize"),
+	40,
+	TEXT("Size in MB of the chunks used to transfer large arrays (attributes, vertex lists, heightfields) over a Thrift session.\n")
+	TEXT("In-process sessions are never chunked, HAPI copies the data directly from/to our buffers.\n")
+);
+
+// Returns how many elements of InElementSize bytes can be transferred with a single HAPI call on the current session
+static int32
+GetBulkTransferChunkCount(const int32& InElementSize)
+{
+	const HAPI_Session* Session = FHoudiniEngine::Get().GetSession();
+	if (Session && Session->type == HAPI_SESSION_INPROCESS)
+		return MAX_int32;
+
+	const int64 ChunkBytes = (int64)FMath::Max(1, CVarHoudiniEngineBulkTransferChunkSize.GetValueOnAnyThread()) * 1024 * 1024;
+	return (int32)FMath::Clamp<int64>(ChunkBytes / FMath::Max(1, InElementSize), 1, MAX_int32);
+}
+
+// Transfers InCount elements with InTransferFunc(ChunkStart, ChunkCount), split in as few calls as the session allows
+template<typename TransferFuncType>
+static HAPI_Result
+HapiTransferInChunks(const int32& InCount, const int32& InElementSize, TransferFuncType InTransferFunc)
+{
+	const int32 ChunkSize = GetBulkTransferChunkCount(InElementSize);
+	if (InCount <= ChunkSize)
+		return InTransferFunc(0, InCount);
+
+	HAPI_Result Result = HAPI_RESULT_FAILURE;
+	for (int32 ChunkStart = 0; ChunkStart < InCount; ChunkStart += ChunkSize)
+	{
+		Result = InTransferFunc(ChunkStart, FMath::Min(ChunkSize, InCount - ChunkStart));
+		if (Result != HAPI_RESULT_SUCCESS)
+			break;
+	}
+
+	return Result;
+}
+
 const FString
 FHoudiniEngineUtils::GetErrorDescription(HAPI_Result Result)
 {
@@ -3454,35 +3494,16 @@ FHoudiniEngineUtils::HapiSetAttributeFloatData(
 	}
 
 
-	int32 ChunkSize = THRIFT_MAX_CHUNKSIZE / InAttributeInfo.tupleSize;
-	if (InAttributeInfo.count > ChunkSize)
-	{
-		// Send the attribte in chunks
-		for (int32 ChunkStart = 0; ChunkStart < InAttributeInfo.count; ChunkStart += ChunkSize)
+	// Send the attribute values, in chunks if the session requires it
+	return HapiTransferInChunks(InAttributeInfo.count, InAttributeInfo.tupleSize * sizeof(*InFloatData),
+		[&](const int32& ChunkStart, const int32& ChunkCount)
 		{
-			int32 CurCount = InAttributeInfo.count - ChunkStart > ChunkSize ? ChunkSize : InAttributeInfo.count - ChunkStart;
-
-			Result = FHoudiniApi::SetAttributeFloatData(
+			return FHoudiniApi::SetAttributeFloatData(
 				FHoudiniEngine::Get().GetSession(),
 				InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
 				&InAttributeInfo, InFloatData + ChunkStart * InAttributeInfo.tupleSize,
-				ChunkStart, CurCount);
-
-			if (Result != HAPI_RESULT_SUCCESS)
-				break;
-		}
-	}
-	else
-	{
-		// Send all the attribute values once
-		Result = FHoudiniApi::SetAttributeFloatData(
-			FHoudiniEngine::Get().GetSession(),
-			InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
-			&InAttributeInfo, InFloatData,
-			0, InAttributeInfo.count);
-	}
-
-	return Result;
+				ChunkStart, ChunkCount);
+		});
 }
 
 HAPI_Result
@@ -3582,36 +3603,16 @@ FHoudiniEngineUtils::HapiSetAttributeIntData(
         }
 	}
 
-	HAPI_Result Result = HAPI_RESULT_FAILURE;
-	int32 ChunkSize = THRIFT_MAX_CHUNKSIZE / InAttributeInfo.tupleSize;
-	if (InAttributeInfo.count > ChunkSize)
-	{
-		// Send the attribte in chunks
-		for (int32 ChunkStart = 0; ChunkStart < InAttributeInfo.count; ChunkStart += ChunkSize)
+	// Send the attribute values, in chunks if the session requires it
+	return HapiTransferInChunks(InAttributeInfo.count, InAttributeInfo.tupleSize * sizeof(*InIntData),
+		[&](const int32& ChunkStart, const int32& ChunkCount)
 		{
-			int32 CurCount = InAttributeInfo.count - ChunkStart > ChunkSize ? ChunkSize : InAttributeInfo.count - ChunkStart;
-
-			Result = FHoudiniApi::SetAttributeIntData(
+			return FHoudiniApi::SetAttributeIntData(
 				FHoudiniEngine::Get().GetSession(),
 				InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
 				&InAttributeInfo, InIntData + ChunkStart * InAttributeInfo.tupleSize,
-				ChunkStart, CurCount);
-
-			if (Result != HAPI_RESULT_SUCCESS)
-				break;
-		}
-	}
-	else
-	{
-		// Send all the attribute values once
-		Result = FHoudiniApi::SetAttributeIntData(
-			FHoudiniEngine::Get().GetSession(),
-			InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
-			&InAttributeInfo, InIntData,
-			0, InAttributeInfo.count);
-	}
-
-	return Result;
+				ChunkStart, ChunkCount);
+		});
 }
 
 HAPI_Result
@@ -3666,36 +3667,16 @@ FHoudiniEngineUtils::HapiSetAttributeInt8Data(
 	if (InAttributeInfo.count <= 0 || InAttributeInfo.tupleSize < 1)
 		return HAPI_RESULT_INVALID_ARGUMENT;
 
-	HAPI_Result Result = HAPI_RESULT_FAILURE;
-	int32 ChunkSize = THRIFT_MAX_CHUNKSIZE / InAttributeInfo.tupleSize;
-	if (InAttributeInfo.count > ChunkSize)
-	{
-		// Send the attribte in chunks
-		for (int32 ChunkStart = 0; ChunkStart < InAttributeInfo.count; ChunkStart += ChunkSize)
+	// Send the attribute values, in chunks if the session requires it
+	return HapiTransferInChunks(InAttributeInfo.count, InAttributeInfo.tupleSize * sizeof(*InByteData),
+		[&](const int32& ChunkStart, const int32& ChunkCount)
 		{
-			int32 CurCount = InAttributeInfo.count - ChunkStart > ChunkSize ? ChunkSize : InAttributeInfo.count - ChunkStart;
-
-			Result = FHoudiniApi::SetAttributeInt8Data(
+			return FHoudiniApi::SetAttributeInt8Data(
 				FHoudiniEngine::Get().GetSession(),
 				InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
 				&InAttributeInfo, InByteData + ChunkStart * InAttributeInfo.tupleSize,
-				ChunkStart, CurCount);
-
-			if (Result != HAPI_RESULT_SUCCESS)
-				break;
-		}
-	}
-	else
-	{
-		// Send all the attribute values once
-		Result = FHoudiniApi::SetAttributeInt8Data(
-			FHoudiniEngine::Get().GetSession(),
-			InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
-			&InAttributeInfo, InByteData,
-			0, InAttributeInfo.count);
-	}
-
-	return Result;
+				ChunkStart, ChunkCount);
+		});
 }
 
 HAPI_Result
@@ -3726,36 +3707,16 @@ FHoudiniEngineUtils::HapiSetAttributeUInt8Data(
 	if (InAttributeInfo.count <= 0 || InAttributeInfo.tupleSize < 1)
 		return HAPI_RESULT_INVALID_ARGUMENT;
 
-	HAPI_Result Result = HAPI_RESULT_FAILURE;
-	int32 ChunkSize = THRIFT_MAX_CHUNKSIZE / InAttributeInfo.tupleSize;
-	if (InAttributeInfo.count > ChunkSize)
-	{
-		// Send the attribte in chunks
-		for (int32 ChunkStart = 0; ChunkStart < InAttributeInfo.count; ChunkStart += ChunkSize)
+	// Send the attribute values, in chunks if the session requires it
+	return HapiTransferInChunks(InAttributeInfo.count, InAttributeInfo.tupleSize * sizeof(*InByteData),
+		[&](const int32& ChunkStart, const int32& ChunkCount)
 		{
-			int32 CurCount = InAttributeInfo.count - ChunkStart > ChunkSize ? ChunkSize : InAttributeInfo.count - ChunkStart;
-
-			Result = FHoudiniApi::SetAttributeUInt8Data(
+			return FHoudiniApi::SetAttributeUInt8Data(
 				FHoudiniEngine::Get().GetSession(),
 				InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
 				&InAttributeInfo, InByteData + ChunkStart * InAttributeInfo.tupleSize,
-				ChunkStart, CurCount);
-
-			if (Result != HAPI_RESULT_SUCCESS)
-				break;
-		}
-	}
-	else
-	{
-		// Send all the attribute values once
-		Result = FHoudiniApi::SetAttributeUInt8Data(
-			FHoudiniEngine::Get().GetSession(),
-			InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
-			&InAttributeInfo, InByteData,
-			0, InAttributeInfo.count);
-	}
-
-	return Result;
+				ChunkStart, ChunkCount);
+		});
 }
 
 HAPI_Result
@@ -3788,36 +3749,16 @@ FHoudiniEngineUtils::HapiSetAttributeInt16Data(
 	if (InAttributeInfo.count <= 0 || InAttributeInfo.tupleSize < 1)
 		return HAPI_RESULT_INVALID_ARGUMENT;
 
-	HAPI_Result Result = HAPI_RESULT_FAILURE;
-	int32 ChunkSize = THRIFT_MAX_CHUNKSIZE / InAttributeInfo.tupleSize;
-	if (InAttributeInfo.count > ChunkSize)
-	{
-		// Send the attribte in chunks
-		for (int32 ChunkStart = 0; ChunkStart < InAttributeInfo.count; ChunkStart += ChunkSize)
+	// Send the attribute values, in chunks if the session requires it
+	return HapiTransferInChunks(InAttributeInfo.count, InAttributeInfo.tupleSize * sizeof(*InShortData),
+		[&](const int32& ChunkStart, const int32& ChunkCount)
 		{
-			int32 CurCount = InAttributeInfo.count - ChunkStart > ChunkSize ? ChunkSize : InAttributeInfo.count - ChunkStart;
-
-			Result = FHoudiniApi::SetAttributeInt16Data(
+			return FHoudiniApi::SetAttributeInt16Data(
 				FHoudiniEngine::Get().GetSession(),
 				InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
 				&InAttributeInfo, InShortData + ChunkStart * InAttributeInfo.tupleSize,
-				ChunkStart, CurCount);
-
-			if (Result != HAPI_RESULT_SUCCESS)
-				break;
-		}
-	}
-	else
-	{
-		// Send all the attribute values once
-		Result = FHoudiniApi::SetAttributeInt16Data(
-			FHoudiniEngine::Get().GetSession(),
-			InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
-			&InAttributeInfo, InShortData,
-			0, InAttributeInfo.count);
-	}
-
-	return Result;
+				ChunkStart, ChunkCount);
+		});
 }
 
 HAPI_Result
@@ -3884,72 +3825,23 @@ FHoudiniEngineUtils::HapiSetAttributeInt64Data(
 	}
 #endif
 
-	HAPI_Result Result = HAPI_RESULT_FAILURE;
-	int32 ChunkSize = THRIFT_MAX_CHUNKSIZE / InAttributeInfo.tupleSize;
-	if (InAttributeInfo.count > ChunkSize)
-	{
-		// Send the attribute in chunks
-		for (int32 ChunkStart = 0; ChunkStart < InAttributeInfo.count; ChunkStart += ChunkSize)
+	// Send the attribute values, in chunks if the session requires it
+	return HapiTransferInChunks(InAttributeInfo.count, InAttributeInfo.tupleSize * sizeof(HAPI_Int64),
+		[&](const int32& ChunkStart, const int32& ChunkCount)
 		{
-			int32 CurCount = InAttributeInfo.count - ChunkStart > ChunkSize ? ChunkSize : InAttributeInfo.count - ChunkStart;
 #if PLATFORM_LINUX
-			if (sizeof(int64) != sizeof(HAPI_Int64))
-			{
-				Result = FHoudiniApi::SetAttributeInt64Data(
-					FHoudiniEngine::Get().GetSession(),
-					InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
-					&InAttributeInfo, HData.GetData() + ChunkStart * InAttributeInfo.tupleSize,
-					ChunkStart, CurCount);
-			}
-			else
-			{
-				Result = FHoudiniApi::SetAttributeInt64Data(
-					FHoudiniEngine::Get().GetSession(),
-					InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
-					&InAttributeInfo, reinterpret_cast<const HAPI_Int64*>(InInt64Data + ChunkStart * InAttributeInfo.tupleSize),
-					ChunkStart, CurCount);
-			}
+			const HAPI_Int64* ChunkData = (sizeof(int64) != sizeof(HAPI_Int64))
+				? HData.GetData() + ChunkStart * InAttributeInfo.tupleSize
+				: reinterpret_cast<const HAPI_Int64*>(InInt64Data + ChunkStart * InAttributeInfo.tupleSize);
 #else
-			Result = FHoudiniApi::SetAttributeInt64Data(
-				FHoudiniEngine::Get().GetSession(),
-				InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
-				&InAttributeInfo, InInt64Data + ChunkStart * InAttributeInfo.tupleSize,
-				ChunkStart, CurCount);
+			const HAPI_Int64* ChunkData = InInt64Data + ChunkStart * InAttributeInfo.tupleSize;
 #endif
-			if (Result != HAPI_RESULT_SUCCESS)
-				break;
-		}
-	}
-	else
-	{
-		// Send all the attribute values once
-#if PLATFORM_LINUX
-		if (sizeof(int64) != sizeof(HAPI_Int64))
-		{
-			Result = FHoudiniApi::SetAttributeInt64Data(
+			return FHoudiniApi::SetAttributeInt64Data(
 				FHoudiniEngine::Get().GetSession(),
 				InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
-				&InAttributeInfo, HData.GetData(),
-				0, InAttributeInfo.count);
-		}
-		else
-		{
-			Result = FHoudiniApi::SetAttributeInt64Data(
-				FHoudiniEngine::Get().GetSession(),
-				InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
-				&InAttributeInfo, reinterpret_cast<const HAPI_Int64*>(InInt64Data),
-				0, InAttributeInfo.count);
-		}
-#else
-		Result = FHoudiniApi::SetAttributeInt64Data(
-			FHoudiniEngine::Get().GetSession(),
-			InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
-			&InAttributeInfo, InInt64Data,
-			0, InAttributeInfo.count);
-#endif
-	}
-
-	return Result;
+				&InAttributeInfo, ChunkData,
+				ChunkStart, ChunkCount);
+		});
 }
 
 HAPI_Result
@@ -4004,36 +3896,16 @@ FHoudiniEngineUtils::HapiSetAttributeDoubleData(
 	if (InAttributeInfo.count <= 0 || InAttributeInfo.tupleSize < 1)
 		return HAPI_RESULT_INVALID_ARGUMENT;
 
-	HAPI_Result Result = HAPI_RESULT_FAILURE;
-	int32 ChunkSize = THRIFT_MAX_CHUNKSIZE / InAttributeInfo.tupleSize;
-	if (InAttributeInfo.count > ChunkSize)
-	{
-		// Send the attribte in chunks
-		for (int32 ChunkStart = 0; ChunkStart < InAttributeInfo.count; ChunkStart += ChunkSize)
+	// Send the attribute values, in chunks if the session requires it
+	return HapiTransferInChunks(InAttributeInfo.count, InAttributeInfo.tupleSize * sizeof(*InDoubleData),
+		[&](const int32& ChunkStart, const int32& ChunkCount)
 		{
-			int32 CurCount = InAttributeInfo.count - ChunkStart > ChunkSize ? ChunkSize : InAttributeInfo.count - ChunkStart;
-
-			Result = FHoudiniApi::SetAttributeFloat64Data(
+			return FHoudiniApi::SetAttributeFloat64Data(
 				FHoudiniEngine::Get().GetSession(),
 				InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
 				&InAttributeInfo, InDoubleData + ChunkStart * InAttributeInfo.tupleSize,
-				ChunkStart, CurCount);
-
-			if (Result != HAPI_RESULT_SUCCESS)
-				break;
-		}
-	}
-	else
-	{
-		// Send all the attribute values once
-		Result = FHoudiniApi::SetAttributeFloat64Data(
-			FHoudiniEngine::Get().GetSession(),
-			InNodeId, InPartId, TCHAR_TO_ANSI(*InAttributeName),
-			&InAttributeInfo, InDoubleData,
-			0, InAttributeInfo.count);
-	}
-
-	return Result;
+				ChunkStart, ChunkCount);
+		});
 }
 
 HAPI_Result
@@ -4048,30 +3920,14 @@ FHoudiniEngineUtils::HapiSetVertexList(
 	if (ListNum < 1)
 		return HAPI_RESULT_INVALID_ARGUMENT;
 		
-	int32 ChunkSize = THRIFT_MAX_CHUNKSIZE;
-	HAPI_Result Result = HAPI_RESULT_FAILURE;
-	if (ListNum > ChunkSize)
-	{
-		// Send the vertex list in chunks
-		for (int32 ChunkStart = 0; ChunkStart < ListNum; ChunkStart += ChunkSize)
+	// Send the vertex list, in chunks if the session requires it
+	return HapiTransferInChunks(ListNum, sizeof(int32),
+		[&](const int32& ChunkStart, const int32& ChunkCount)
 		{
-			int32 CurCount = ListNum - ChunkStart > ChunkSize ? ChunkSize : ListNum - ChunkStart;
-			Result = FHoudiniApi::SetVertexList(
+			return FHoudiniApi::SetVertexList(
 				FHoudiniEngine::Get().GetSession(),
-				InNodeId, InPartId, InVertexListData.GetData() + ChunkStart, ChunkStart, CurCount);
-
-			if (Result != HAPI_RESULT_SUCCESS)
-				break;
-		}
-	}
-	else
-	{
-		Result = FHoudiniApi::SetVertexList(
-			FHoudiniEngine::Get().GetSession(),
-			InNodeId, InPartId, InVertexListData.GetData(), 0, InVertexListData.Num());
-	}
-
-	return Result;
+				InNodeId, InPartId, InVertexListData.GetData() + ChunkStart, ChunkStart, ChunkCount);
+		});
 }
 
 
@@ -4087,30 +3943,14 @@ FHoudiniEngineUtils::HapiSetFaceCounts(
 	if (FaceCountsNum < 1)
 		return HAPI_RESULT_INVALID_ARGUMENT;
 
-	int32 ChunkSize = THRIFT_MAX_CHUNKSIZE;
-	HAPI_Result Result = HAPI_RESULT_FAILURE;
-	if (FaceCountsNum > ChunkSize)
-	{
-		// Send the vertex list in chunks
-		for (int32 ChunkStart = 0; ChunkStart < FaceCountsNum; ChunkStart += ChunkSize)
+	// Send the face counts, in chunks if the session requires it
+	return HapiTransferInChunks(FaceCountsNum, sizeof(int32),
+		[&](const int32& ChunkStart, const int32& ChunkCount)
 		{
-			int32 CurCount = FaceCountsNum - ChunkStart > ChunkSize ? ChunkSize : FaceCountsNum - ChunkStart;
-			Result = FHoudiniApi::SetFaceCounts(
+			return FHoudiniApi::SetFaceCounts(
 				FHoudiniEngine::Get().GetSession(),
-				InNodeId, InPartId, InFaceCounts.GetData() + ChunkStart, ChunkStart, CurCount);
-
-			if (Result != HAPI_RESULT_SUCCESS)
-				break;
-		}
-	}
-	else
-	{
-		Result = FHoudiniApi::SetFaceCounts(
-			FHoudiniEngine::Get().GetSession(),
-			InNodeId, InPartId, InFaceCounts.GetData(), 0, InFaceCounts.Num());
-	}
-
-	return Result;
+				InNodeId, InPartId, InFaceCounts.GetData() + ChunkStart, ChunkStart, ChunkCount);
+		});
 }
 
 HAPI_Result
@@ -4279,11 +4119,22 @@ FHoudiniEngineUtils::HapiSetHeightFieldData(
 	const HAPI_PartId& InPartId,
 	const TArray<float>& InFloatValues,
 	const FString& InHeightfieldName)
+{
+	return HapiSetHeightFieldData(InNodeId, InPartId, InFloatValues, InHeightfieldName, 0, InFloatValues.Num());
+}
+
+HAPI_Result
+FHoudiniEngineUtils::HapiSetHeightFieldData(
+	const HAPI_NodeId& InNodeId,
+	const HAPI_PartId& InPartId,
+	const TArray<float>& InFloatValues,
+	const FString& InHeightfieldName,
+	const int32& InStart,
+	const int32& InCount)
 {
     SCOPED_FUNCTION_TIMER();
 
-	int32 NumValues = InFloatValues.Num();
-	if (NumValues < 1)
+	if (InCount < 1 || InStart < 0 || InStart + InCount > InFloatValues.Num())
 		return HAPI_RESULT_INVALID_ARGUMENT;
 
 	// Get the volume name as std::string
@@ -4291,33 +4142,16 @@ FHoudiniEngineUtils::HapiSetHeightFieldData(
 	FHoudiniEngineUtils::ConvertUnrealString(InHeightfieldName, NameStr);
 
 	// Get the Heighfield float data
-	const float* HeightData = InFloatValues.GetData();
+	const float* HeightData = InFloatValues.GetData() + InStart;
 
-	int32 ChunkSize = THRIFT_MAX_CHUNKSIZE;
-	HAPI_Result Result = HAPI_RESULT_FAILURE;
-	if (NumValues > ChunkSize)
-	{
-		// Send the heightfield data in chunks
-		for (int32 ChunkStart = 0; ChunkStart < NumValues; ChunkStart += ChunkSize)
+	// Send the heightfield data, in chunks if the session requires it
+	return HapiTransferInChunks(InCount, sizeof(float),
+		[&](const int32& ChunkStart, const int32& ChunkCount)
 		{
-			int32 CurCount = NumValues - ChunkStart > ChunkSize ? ChunkSize : NumValues - ChunkStart;
-			
-			Result = FHoudiniApi::SetHeightFieldData(
+			return FHoudiniApi::SetHeightFieldData(
 				FHoudiniEngine::Get().GetSession(),
-				InNodeId, InPartId, NameStr.c_str(), &HeightData[ChunkStart], ChunkStart, CurCount);
-
-			if (Result != HAPI_RESULT_SUCCESS)
-				break;
-		}
-	}
-	else
-	{
-		Result = FHoudiniApi::SetHeightFieldData(
-			FHoudiniEngine::Get().GetSession(),
-			InNodeId, InPartId, NameStr.c_str(), HeightData, 0, InFloatValues.Num());
-	}
-
-	return Result;
+				InNodeId, InPartId, NameStr.c_str(), HeightData + ChunkStart, InStart + ChunkStart, ChunkCount);
+		});
 }
 
 
@@ -4336,31 +4170,14 @@ FHoudiniEngineUtils::HapiGetHeightFieldData(
 	// float data
 	float* HeightData = OutFloatValues.GetData();
 
-	int32 ChunkSize = THRIFT_MAX_CHUNKSIZE;
-	HAPI_Result Result = HAPI_RESULT_FAILURE;
-	if (NumValues > ChunkSize)
-	{
-		// Get the heightfield data in chunks
-		for (int32 ChunkStart = 0; ChunkStart < NumValues; ChunkStart += ChunkSize)
+	// Get the heightfield data, in chunks if the session requires it
+	return HapiTransferInChunks(NumValues, sizeof(float),
+		[&](const int32& ChunkStart, const int32& ChunkCount)
 		{
-			int32 CurCount = NumValues - ChunkStart > ChunkSize ? ChunkSize : NumValues - ChunkStart;
-
-			Result = FHoudiniApi::GetHeightFieldData(
+			return FHoudiniApi::GetHeightFieldData(
 				FHoudiniEngine::Get().GetSession(),
-				InNodeId, InPartId, &HeightData[ChunkStart], ChunkStart, CurCount);
-
-			if (Result != HAPI_RESULT_SUCCESS)
-				break;
-		}
-	}
-	else
-	{
-		Result = FHoudiniApi::GetHeightFieldData(
-			FHoudiniEngine::Get().GetSession(),
-			InNodeId, InPartId, HeightData, 0, NumValues);
-	}
-
-	return Result;
+				InNodeId, InPartId, HeightData + ChunkStart, ChunkStart, ChunkCount);
+		});
 }
 
 char *
@@ -5622,6 +5439,80 @@ FHoudiniEngineUtils::HapiGetAttributeOfType(
 	return NumberOfAttributeFound;
 }
 
+bool
+FHoudiniEngineUtils::HapiPrefetchPartStringAttributes(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartId& InPartId,
+	const HAPI_PartInfo& InPartInfo)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniEngineUtils::HapiPrefetchPartStringAttributes);
+
+	// Only the attributes the output translators read: unreal_* attributes (including the generic uproperty ones),
+	// mesh sockets and instance references. Other string attributes (name, path...) can hold many unique values
+	// that would never be queried.
+	auto IsTranslatorStringAttribute = [](const FString& InAttribName)
+	{
+		return InAttribName.StartsWith(TEXT("unreal_"), ESearchCase::CaseSensitive)
+			|| InAttribName.StartsWith(TEXT(HAPI_UNREAL_ATTRIB_MESH_SOCKET_PREFIX), ESearchCase::CaseSensitive)
+			|| InAttribName.Equals(TEXT(HAPI_UNREAL_ATTRIB_INSTANCE), ESearchCase::CaseSensitive);
+	};
+
+	// Gather the string handles of these string attributes on the part
+	TArray<HAPI_StringHandle> StringHandles;
+	for (int32 OwnerIdx = 0; OwnerIdx < HAPI_ATTROWNER_MAX; OwnerIdx++)
+	{
+		const HAPI_AttributeOwner Owner = (HAPI_AttributeOwner)OwnerIdx;
+		const int32 AttribCount = InPartInfo.attributeCounts[Owner];
+		if (AttribCount <= 0)
+			continue;
+
+		TArray<HAPI_StringHandle> AttribNameSHArray;
+		AttribNameSHArray.SetNum(AttribCount);
+		if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetAttributeNames(
+			FHoudiniEngine::Get().GetSession(),
+			InGeoId, InPartId, Owner,
+			AttribNameSHArray.GetData(), AttribCount))
+			continue;
+
+		TArray<FString> AttribNameArray;
+		FHoudiniEngineString::SHArrayToFStringArray(AttribNameSHArray, AttribNameArray);
+
+		for (const FString& AttribName : AttribNameArray)
+		{
+			if (!IsTranslatorStringAttribute(AttribName))
+				continue;
+
+			HAPI_AttributeInfo AttrInfo;
+			FHoudiniApi::AttributeInfo_Init(&AttrInfo);
+			if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetAttributeInfo(
+				FHoudiniEngine::Get().GetSession(),
+				InGeoId, InPartId, TCHAR_TO_UTF8(*AttribName),
+				Owner, &AttrInfo))
+				continue;
+
+			if (!AttrInfo.exists || AttrInfo.storage != HAPI_STORAGETYPE_STRING || AttrInfo.count <= 0)
+				continue;
+
+			const int32 StartIndex = StringHandles.Num();
+			StringHandles.AddUninitialized(AttrInfo.count * AttrInfo.tupleSize);
+			if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetAttributeStringData(
+				FHoudiniEngine::Get().GetSession(),
+				InGeoId, InPartId, TCHAR_TO_UTF8(*AttribName),
+				&AttrInfo, &StringHandles[StartIndex],
+				0, AttrInfo.count))
+			{
+				StringHandles.SetNum(StartIndex);
+			}
+		}
+	}
+
+	if (StringHandles.Num() <= 0)
+		return true;
+
+	// Resolve all of them in a single string batch, the attribute queries will then find them in the string cache
+	return FHoudiniEngineString::PrefetchStrings(StringHandles);
+}
+
 HAPI_PartInfo
 FHoudiniEngineUtils::ToHAPIPartInfo(const FHoudiniPartInfo& InHPartInfo)
 {
@@ -8161,6 +8052,8 @@ FHoudiniEngineUtils::HapiCookNode(const HAPI_NodeId& InNodeId, HAPI_CookOptions*
 			FHoudiniEngine::Get().GetSession(), InNodeId, InCookOptions), false);
 	}
 
+	FHoudiniEngineString::MarkStringTableDirty();
+
 	// If we don't need to wait for completion, return now
 	if (!bWaitForCompletion)
 		return true;
@@ -282,6 +282,13 @@ struct HOUDINIENGINE_API FHoudiniEngineUtils
 			const int32& InStartIndex = 0,
 			const int32& InCount = -1);
 
+		// HAPI : Resolves the values of the string attributes of a part read by the translators (unreal_*, mesh sockets, instance)
+		// in a single batch, so that the following string attribute queries are served by the string cache.
+		static bool HapiPrefetchPartStringAttributes(
+			const HAPI_NodeId& InGeoId,
+			const HAPI_PartId& InPartId,
+			const HAPI_PartInfo& InPartInfo);
+
 		// HAPI : Check if given attribute exists.
 		static bool HapiCheckAttributeExists(
 			const HAPI_NodeId& GeoId,
@@ -649,6 +656,16 @@ struct HOUDINIENGINE_API FHoudiniEngineUtils
 			const TArray<float>& InFloatValues,
 			const FString& InHeightfieldName);
 
+		// Helper function to set a range of Heightfield data, InFloatValues contains the whole volume
+		// The data will be sent in chunks if too large for thrift
+		static HAPI_Result HapiSetHeightFieldData(
+			const HAPI_NodeId& InNodeId,
+			const HAPI_PartId& InPartId,
+			const TArray<float>& InFloatValues,
+			const FString& InHeightfieldName,
+			const int32& InStart,
+			const int32& InCount);
+
 		// Helper function to get Heightfield data
 		// The data will be read in chunks if too large for thrift
 		static HAPI_Result HapiGetHeightFieldData(
@@ -27,6 +27,7 @@
 #include "HoudiniGeoImporter.h"
 
 #include "HoudiniApi.h"
+#include "HoudiniBgeoReader.h"
 #include "HoudiniEngine.h"
 #include "HoudiniEngineUtils.h"
 #include "HoudiniEngineRuntime.h"
@@ -51,6 +52,9 @@
 
 #include "Materials/MaterialInterface.h"
 #include "Materials/Material.h"
+#include "Engine/StaticMesh.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
 
 
 UHoudiniGeoImporter::UHoudiniGeoImporter(const FObjectInitializer & ObjectInitializer)
@@ -685,34 +689,12 @@ UHoudiniGeoImporter::ImportBGEOFile(
 	
 	// 1. Houdini Engine Session
 	// See if we should/can start the default "first" HE session
-	if (!AutoStartHoudiniEngineSessionIfNeeded())
-		return false;
+	const bool bHasSession = AutoStartHoudiniEngineSessionIfNeeded();
 
 	// 2. Update the file paths
 	if (!SetFilePath(InBGEOFile))
 		return false;
 
-	// 3. Load the BGEO file in HAPI
-	HAPI_NodeId NodeId;
-	if (!LoadBGEOFileInHAPI(NodeId))
-		return false;
-	
-	// 4. Get the output from the file node
-	TArray<UHoudiniOutput*> NewOutputs;
-	TArray<UHoudiniOutput*> OldOutputs;
-	if (!BuildOutputsForNode(NodeId, OldOutputs, NewOutputs))
-		return false;
-
-	// Failure lambda
-	auto CleanUpAndReturn = [&NewOutputs](const bool& bReturnValue)
-	{
-		// Remove the output objects from the root set before returning false
-		for (auto Out : NewOutputs)
-			Out->RemoveFromRoot();
-
-		return bReturnValue;
-	};
-
 	// Prepare the package used for creating the mesh, landscape and instancer pacakges
 	FHoudiniPackageParams PackageParams;
 	if (InPackageParams)
@@ -743,14 +725,39 @@ UHoudiniGeoImporter::ImportBGEOFile(
 		PackageParams.ComponentGUID = FGuid::NewGuid();
 	}
 
+	const FMeshBuildSettings& MeshBuildSettings =
+		InMeshBuildSettings ? *InMeshBuildSettings : FHoudiniEngineRuntimeUtils::GetDefaultMeshBuildSettings();
+
+	// Without a session, the file's polygons can still be read and imported
+	if (!bHasSession)
+		return ImportBGEOFileWithoutSession(InParent, PackageParams, MeshBuildSettings);
+
+	// 3. Load the BGEO file in HAPI
+	HAPI_NodeId NodeId;
+	if (!LoadBGEOFileInHAPI(NodeId))
+		return false;
+	
+	// 4. Get the output from the file node
+	TArray<UHoudiniOutput*> NewOutputs;
+	TArray<UHoudiniOutput*> OldOutputs;
+	if (!BuildOutputsForNode(NodeId, OldOutputs, NewOutputs))
+		return false;
+
+	// Failure lambda
+	auto CleanUpAndReturn = [&NewOutputs](const bool& bReturnValue)
+	{
+		// Remove the output objects from the root set before returning false
+		for (auto Out : NewOutputs)
+			Out->RemoveFromRoot();
+
+		return bReturnValue;
+	};
+
 	// 5. Create the static meshes in the outputs
 	const FHoudiniStaticMeshGenerationProperties& StaticMeshGenerationProperties =
 		InStaticMeshGenerationProperties?
 		*InStaticMeshGenerationProperties :
 		FHoudiniEngineRuntimeUtils::GetDefaultStaticMeshGenerationProperties();
-	
-	const FMeshBuildSettings& MeshBuildSettings =
-		InMeshBuildSettings ? *InMeshBuildSettings : FHoudiniEngineRuntimeUtils::GetDefaultMeshBuildSettings();
 		
 	if (!CreateStaticMeshes(NewOutputs, InParent, PackageParams, StaticMeshGenerationProperties, MeshBuildSettings))
 		return CleanUpAndReturn(false);
@@ -870,6 +877,287 @@ UHoudiniGeoImporter::CloseBGEOFile(const HAPI_NodeId& InNodeId)
 	return true;
 }
 
+bool
+UHoudiniGeoImporter::ReadBGEOFile(const FString& InBGEOFile, FHoudiniBgeoGeometry& OutGeometry, TArray<FHoudiniGeoPartObject>& OutHGPOs)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UHoudiniGeoImporter::ReadBGEOFile);
+
+	OutHGPOs.Empty();
+	const FString AbsoluteFile = FPaths::ConvertRelativePathToFull(InBGEOFile);
+	if (!FPaths::FileExists(AbsoluteFile))
+	{
+		HOUDINI_LOG_ERROR(TEXT("Houdini GEO Importer: could not find file %s!"), *InBGEOFile);
+		return false;
+	}
+
+	if (!FHoudiniBgeoReader::ReadFile(AbsoluteFile, OutGeometry))
+		return false;
+
+	FHoudiniBgeoReader::BuildGeoPartObjects(OutGeometry, FPaths::GetBaseFilename(AbsoluteFile), OutHGPOs);
+	return true;
+}
+
+bool
+UHoudiniGeoImporter::ImportBGEOFileWithoutSession(
+	UObject* InParent, const FHoudiniPackageParams& InPackageParams, const FMeshBuildSettings& InMeshBuildSettings)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UHoudiniGeoImporter::ImportBGEOFileWithoutSession);
+
+	HOUDINI_LOG_MESSAGE(TEXT("Houdini GEO Importer: no Houdini Engine session, reading %s without HAPI."), *AbsoluteFilePath);
+
+	FHoudiniBgeoGeometry Geometry;
+	TArray<FHoudiniGeoPartObject> HGPOs;
+	if (!ReadBGEOFile(AbsoluteFilePath, Geometry, HGPOs))
+		return false;
+
+	// All the polygons of the file are in a single mesh part, that gives a single static mesh
+	bool bMeshCreated = false;
+	for (const FHoudiniGeoPartObject& CurHGPO : HGPOs)
+	{
+		// Volumes and packed primitives need the translators, and they read their data from HAPI
+		if (CurHGPO.Type != EHoudiniPartType::Mesh)
+		{
+			HOUDINI_LOG_WARNING(
+				TEXT("Houdini GEO Importer: part %s of %s can only be imported with a Houdini Engine session, skipping it."),
+				*CurHGPO.PartName, *FileName);
+			continue;
+		}
+
+		if (!bMeshCreated)
+			bMeshCreated = CreateStaticMeshFromBGEO(Geometry, CurHGPO, InPackageParams, InMeshBuildSettings);
+	}
+
+	return bMeshCreated;
+}
+
+// Finds a float attribute that has a value for every vertex of the polygons: a vertex, point or primitive attribute
+static const FHoudiniBgeoAttribute*
+FindBgeoPolygonAttribute(const FHoudiniBgeoGeometry& InGeometry, const FString& InName, const int32& InMinTupleSize)
+{
+	const HAPI_AttributeOwner Owners[3] = { HAPI_ATTROWNER_VERTEX, HAPI_ATTROWNER_POINT, HAPI_ATTROWNER_PRIM };
+	const int32 ElementCounts[3] = { InGeometry.VertexCount, InGeometry.PointCount, InGeometry.PrimitiveCount };
+	for (int32 OwnerIdx = 0; OwnerIdx < 3; OwnerIdx++)
+	{
+		const FHoudiniBgeoAttribute* Attribute = InGeometry.FindAttribute(InName, Owners[OwnerIdx]);
+		if (Attribute && Attribute->TupleSize >= InMinTupleSize
+			&& Attribute->FloatValues.Num() >= ElementCounts[OwnerIdx] * Attribute->TupleSize)
+			return Attribute;
+	}
+
+	return nullptr;
+}
+
+// Index of the attribute's tuple for a vertex of a polygon
+static int32
+GetBgeoPolygonAttributeIndex(const FHoudiniBgeoGeometry& InGeometry, const FHoudiniBgeoAttribute& InAttribute, const int32& InVertex, const int32& InFace)
+{
+	if (InAttribute.Owner == HAPI_ATTROWNER_POINT)
+		return InGeometry.VertexPoints[InVertex];
+	else if (InAttribute.Owner == HAPI_ATTROWNER_PRIM)
+		return InGeometry.FacePrimitives[InFace];
+
+	return InVertex;
+}
+
+bool
+UHoudiniGeoImporter::BuildMeshDescriptionFromBGEO(
+	const FHoudiniBgeoGeometry& InGeometry, FMeshDescription& OutMeshDescription, TArray<FString>& OutMaterialNames)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UHoudiniGeoImporter::BuildMeshDescriptionFromBGEO);
+
+	OutMaterialNames.Empty();
+
+	const FHoudiniBgeoAttribute* Positions = InGeometry.FindAttribute(FString(HAPI_UNREAL_ATTRIB_POSITION), HAPI_ATTROWNER_POINT);
+	if (!Positions || Positions->TupleSize < 3 || Positions->FloatValues.Num() < InGeometry.PointCount * Positions->TupleSize)
+		return false;
+
+	const FHoudiniBgeoAttribute* Normals = FindBgeoPolygonAttribute(InGeometry, FString(HAPI_UNREAL_ATTRIB_NORMAL), 3);
+	const FHoudiniBgeoAttribute* UVs = FindBgeoPolygonAttribute(InGeometry, FString(HAPI_UNREAL_ATTRIB_UV), 2);
+	const FHoudiniBgeoAttribute* Colors = FindBgeoPolygonAttribute(InGeometry, FString(HAPI_UNREAL_ATTRIB_COLOR), 3);
+	const FHoudiniBgeoAttribute* Alphas = FindBgeoPolygonAttribute(InGeometry, FString(HAPI_UNREAL_ATTRIB_ALPHA), 1);
+
+	// Material assignments, per primitive or for the whole geometry
+	const FHoudiniBgeoAttribute* Materials = InGeometry.FindAttribute(FString(HAPI_UNREAL_ATTRIB_MATERIAL), HAPI_ATTROWNER_PRIM);
+	if (!Materials || Materials->StringValues.Num() < InGeometry.PrimitiveCount * Materials->TupleSize)
+		Materials = InGeometry.FindAttribute(FString(HAPI_UNREAL_ATTRIB_MATERIAL), HAPI_ATTROWNER_DETAIL);
+	if (Materials && Materials->StringValues.Num() <= 0)
+		Materials = nullptr;
+
+	// Polygons in the invisible collision groups are not rendered, the mesh translator needs a session to build collisions
+	TArray<const FHoudiniBgeoGroup*> CollisionGroups;
+	for (const FHoudiniBgeoGroup& Group : InGeometry.Groups)
+	{
+		if (Group.Type == HAPI_GROUPTYPE_PRIM && Group.Name.StartsWith(HAPI_UNREAL_GROUP_INVISIBLE_COLLISION_PREFIX, ESearchCase::IgnoreCase))
+			CollisionGroups.Add(&Group);
+	}
+
+	FStaticMeshAttributes MeshAttributes(OutMeshDescription);
+	MeshAttributes.Register();
+
+	auto VertexPositions = MeshAttributes.GetVertexPositions();
+	auto VertexInstanceNormals = MeshAttributes.GetVertexInstanceNormals();
+	auto VertexInstanceUVs = MeshAttributes.GetVertexInstanceUVs();
+	auto VertexInstanceColors = MeshAttributes.GetVertexInstanceColors();
+	auto PolygonGroupMaterialSlotNames = MeshAttributes.GetPolygonGroupMaterialSlotNames();
+
+	// Swap Y and Z, and convert to centimeters
+	OutMeshDescription.ReserveNewVertices(InGeometry.PointCount);
+	for (int32 Point = 0; Point < InGeometry.PointCount; Point++)
+	{
+		const float* Position = &Positions->FloatValues[Point * Positions->TupleSize];
+		const FVertexID VertexID = OutMeshDescription.CreateVertex();
+		VertexPositions[VertexID] = FVector3f(Position[0], Position[2], Position[1]) * HAPI_UNREAL_SCALE_FACTOR_POSITION;
+	}
+
+	// One polygon group per material, polygons without a material use the default one
+	TMap<FString, FPolygonGroupID> PolygonGroupIDs;
+	auto GetPolygonGroupID = [&](const FString& InMaterialName)
+	{
+		if (const FPolygonGroupID* Found = PolygonGroupIDs.Find(InMaterialName))
+			return *Found;
+
+		const FPolygonGroupID PolygonGroupID = OutMeshDescription.CreatePolygonGroup();
+		PolygonGroupMaterialSlotNames[PolygonGroupID] = InMaterialName.IsEmpty() ? FName(HAPI_UNREAL_DEFAULT_MATERIAL_NAME) : FName(*InMaterialName);
+		PolygonGroupIDs.Add(InMaterialName, PolygonGroupID);
+		OutMaterialNames.Add(InMaterialName);
+		return PolygonGroupID;
+	};
+
+	int32 NumCollisionFaces = 0;
+	TArray<FVertexInstanceID> PolygonVertexInstanceIDs;
+	int32 FaceStart = 0;
+	for (int32 Face = 0; Face < InGeometry.FaceCounts.Num(); Face++)
+	{
+		const int32 FaceCount = InGeometry.FaceCounts[Face];
+		const int32 CurrentFaceStart = FaceStart;
+		FaceStart += FaceCount;
+		if (FaceCount < 3 || !InGeometry.FaceVertices.IsValidIndex(FaceStart - 1))
+			continue;
+
+		const int32 Primitive = InGeometry.FacePrimitives[Face];
+		const bool bIsCollision = CollisionGroups.ContainsByPredicate([Primitive](const FHoudiniBgeoGroup* InGroup)
+		{
+			return InGroup->Membership.IsValidIndex(Primitive) && InGroup->Membership[Primitive];
+		});
+		if (bIsCollision)
+		{
+			NumCollisionFaces++;
+			continue;
+		}
+
+		FString MaterialName;
+		if (Materials)
+			MaterialName = Materials->StringValues[Materials->Owner == HAPI_ATTROWNER_PRIM ? Primitive * Materials->TupleSize : 0];
+
+		// Reverse the vertices to fix the winding order
+		PolygonVertexInstanceIDs.Reset();
+		for (int32 Corner = 0; Corner < FaceCount; Corner++)
+		{
+			const int32 Vertex = InGeometry.FaceVertices[CurrentFaceStart + (FaceCount - Corner) % FaceCount];
+			const FVertexInstanceID VertexInstanceID = OutMeshDescription.CreateVertexInstance(FVertexID(InGeometry.VertexPoints[Vertex]));
+			PolygonVertexInstanceIDs.Add(VertexInstanceID);
+
+			if (Normals)
+			{
+				const float* Normal = &Normals->FloatValues[GetBgeoPolygonAttributeIndex(InGeometry, *Normals, Vertex, Face) * Normals->TupleSize];
+				VertexInstanceNormals[VertexInstanceID] = FVector3f(Normal[0], Normal[2], Normal[1]);
+			}
+
+			if (UVs)
+			{
+				const float* UV = &UVs->FloatValues[GetBgeoPolygonAttributeIndex(InGeometry, *UVs, Vertex, Face) * UVs->TupleSize];
+				VertexInstanceUVs.Set(VertexInstanceID, 0, FVector2f(UV[0], 1.0f - UV[1]));
+			}
+
+			FVector4f Color(1.0f, 1.0f, 1.0f, 1.0f);
+			if (Colors)
+			{
+				const float* Cd = &Colors->FloatValues[GetBgeoPolygonAttributeIndex(InGeometry, *Colors, Vertex, Face) * Colors->TupleSize];
+				Color = FVector4f(Cd[0], Cd[1], Cd[2], Colors->TupleSize >= 4 ? Cd[3] : 1.0f);
+			}
+
+			if (Alphas)
+				Color.W = Alphas->FloatValues[GetBgeoPolygonAttributeIndex(InGeometry, *Alphas, Vertex, Face) * Alphas->TupleSize];
+
+			VertexInstanceColors[VertexInstanceID] = Color;
+		}
+
+		OutMeshDescription.CreatePolygon(GetPolygonGroupID(MaterialName), PolygonVertexInstanceIDs);
+	}
+
+	if (NumCollisionFaces > 0)
+	{
+		HOUDINI_LOG_WARNING(
+			TEXT("Houdini GEO Importer: skipping %d polygons in collision groups, collisions can only be imported with a Houdini Engine session."),
+			NumCollisionFaces);
+	}
+
+	return true;
+}
+
+bool
+UHoudiniGeoImporter::CreateStaticMeshFromBGEO(
+	const FHoudiniBgeoGeometry& InGeometry, const FHoudiniGeoPartObject& InHGPO,
+	FHoudiniPackageParams InPackageParams, const FMeshBuildSettings& InMeshBuildSettings)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UHoudiniGeoImporter::CreateStaticMeshFromBGEO);
+
+	FMeshDescription MeshDescription;
+	TArray<FString> MaterialNames;
+	if (!BuildMeshDescriptionFromBGEO(InGeometry, MeshDescription, MaterialNames))
+	{
+		HOUDINI_LOG_ERROR(TEXT("Houdini GEO Importer: %s has no point positions."), *FileName);
+		return false;
+	}
+
+	if (MeshDescription.Triangles().Num() <= 0)
+	{
+		HOUDINI_LOG_WARNING(TEXT("Houdini GEO Importer: 0 valid triangles in %s."), *FileName);
+		return false;
+	}
+
+	InPackageParams.ObjectId = InHGPO.ObjectId;
+	InPackageParams.GeoId = InHGPO.GeoId;
+	InPackageParams.PartId = InHGPO.PartId;
+	InPackageParams.SplitStr = HAPI_UNREAL_GROUP_GEOMETRY_NOT_COLLISION;
+
+	UStaticMesh* StaticMesh = InPackageParams.CreateObjectAndPackage<UStaticMesh>();
+	if (!IsValid(StaticMesh))
+		return false;
+
+	StaticMesh->SetNumSourceModels(1);
+	FStaticMeshSourceModel& SourceModel = StaticMesh->GetSourceModel(0);
+	SourceModel.BuildSettings = InMeshBuildSettings;
+	SourceModel.BuildSettings.bRecomputeNormals = (FindBgeoPolygonAttribute(InGeometry, FString(HAPI_UNREAL_ATTRIB_NORMAL), 3) == nullptr);
+
+	// The material slots follow the order of the polygon groups
+	UMaterialInterface* DefaultMaterial = Cast<UMaterialInterface>(FHoudiniEngine::Get().GetHoudiniDefaultMaterial(false).Get());
+	StaticMesh->GetStaticMaterials().Empty();
+	for (const FString& MaterialName : MaterialNames)
+	{
+		UMaterialInterface* MaterialInterface = nullptr;
+		if (!MaterialName.IsEmpty())
+		{
+			MaterialInterface = Cast<UMaterialInterface>(
+				StaticLoadObject(UMaterialInterface::StaticClass(), nullptr, *MaterialName, nullptr, LOAD_NoWarn, nullptr));
+			if (!MaterialInterface)
+				HOUDINI_LOG_WARNING(TEXT("Houdini GEO Importer: could not load material %s, using the default material."), *MaterialName);
+		}
+
+		const FName SlotName = MaterialName.IsEmpty() ? FName(HAPI_UNREAL_DEFAULT_MATERIAL_NAME) : FName(*MaterialName);
+		StaticMesh->GetStaticMaterials().Add(FStaticMaterial(MaterialInterface ? MaterialInterface : DefaultMaterial, SlotName, SlotName));
+	}
+
+	StaticMesh->CreateMeshDescription(0, MoveTemp(MeshDescription));
+	StaticMesh->CommitMeshDescription(0);
+	StaticMesh->ImportVersion = EImportStaticMeshVersion::LastVersion;
+	StaticMesh->Build(true);
+	StaticMesh->MarkPackageDirty();
+
+	OutputObjects.Add(StaticMesh);
+	return true;
+}
+
 bool
 UHoudiniGeoImporter::LoadBGEOFileInHAPI(HAPI_NodeId& NodeId)
 {
@@ -32,9 +32,12 @@
 
 class UHoudiniOutput;
 
+struct FHoudiniBgeoGeometry;
+struct FHoudiniGeoPartObject;
 struct FHoudiniPackageParams;
 struct FHoudiniStaticMeshGenerationProperties;
 struct FMeshBuildSettings;
+struct FMeshDescription;
 
 UCLASS()
 class HOUDINIENGINE_API UHoudiniGeoImporter : public UObject
@@ -61,6 +64,8 @@ public:
 		static bool BuildAllOutputsForNode(const HAPI_NodeId& InNodeId, UObject* InOuter, TArray<UHoudiniOutput*>& InOldOutputs, TArray<UHoudiniOutput*>& OutNewOutputs, bool bInAddOutputsToRootSet=false);
 		// Delete the HAPI node and remove InOutputs from the root set.
 		static bool CloseBGEOFile(const HAPI_NodeId& InNodeId);
+		// Read a BGEO file without a Houdini Engine session, and create the HGPOs for its parts
+		static bool ReadBGEOFile(const FString& InBGEOFile, FHoudiniBgeoGeometry& OutGeometry, TArray<FHoudiniGeoPartObject>& OutHGPOs);
 		// END: Static API
 
 		// Import the BGEO file
@@ -90,6 +95,17 @@ public:
 		// 9. Clean up the created node
 		static bool DeleteCreatedNode(const HAPI_NodeId& InNodeId);
 
+		// Import the polygons of the BGEO file without a Houdini Engine session, used when no session can be started
+		bool ImportBGEOFileWithoutSession(UObject* InParent, const FHoudiniPackageParams& InPackageParams, const FMeshBuildSettings& InMeshBuildSettings);
+		// Fills a mesh description with the polygons of a geometry read by FHoudiniBgeoReader, with a polygon group
+		// per unreal_material value (OutMaterialNames, empty for the default material). Collision polygons are left out.
+		static bool BuildMeshDescriptionFromBGEO(
+			const FHoudiniBgeoGeometry& InGeometry, FMeshDescription& OutMeshDescription, TArray<FString>& OutMaterialNames);
+		// Creates a static mesh for the mesh part of a geometry read by FHoudiniBgeoReader
+		bool CreateStaticMeshFromBGEO(
+			const FHoudiniBgeoGeometry& InGeometry, const FHoudiniGeoPartObject& InHGPO,
+			FHoudiniPackageParams InPackageParams, const FMeshBuildSettings& InMeshBuildSettings);
+
 		static bool CreateInstancerOutputPartData(
 			TArray<UHoudiniOutput*>& InOutputs,
 			TMap<struct FHoudiniOutputObjectIdentifier, struct FHoudiniInstancedOutputPartData>& OutInstancedOutputPartData);
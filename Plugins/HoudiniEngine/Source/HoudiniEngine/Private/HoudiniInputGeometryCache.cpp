@@ -0,0 +1,326 @@
+/*
+* Copyright (c) <2021> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniInputGeometryCache.h"
+
+#include "HoudiniApi.h"
+#include "HoudiniEngine.h"
+#include "HoudiniEngineRuntime.h"
+#include "HoudiniEnginePrivatePCH.h"
+#include "HoudiniDataLayerUtils.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshSocket.h"
+#include "GameFramework/Actor.h"
+#include "Hash/CityHash.h"
+#include "Materials/MaterialInterface.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "StaticMeshResources.h"
+
+#if ENGINE_MINOR_VERSION >= 2
+	#include "StaticMeshComponentLODInfo.h"
+#endif
+
+static TMap<uint64, FHoudiniInputGeometryCacheEntry> HoudiniInputGeometryCacheEntries;
+static TMap<HAPI_NodeId, FHoudiniInputGeometryReference> HoudiniInputGeometryReferences;
+
+static void
+HashInputGeometryData(uint64& InOutHash, const void* InData, const int32& InSize)
+{
+	InOutHash = CityHash64WithSeed((const char*)InData, (uint32)InSize, InOutHash);
+}
+
+template<typename T>
+static void
+HashInputGeometryValue(uint64& InOutHash, const T& InValue)
+{
+	HashInputGeometryData(InOutHash, &InValue, sizeof(T));
+}
+
+static void
+HashInputGeometryString(uint64& InOutHash, const FString& InString)
+{
+	HashInputGeometryValue(InOutHash, InString.Len());
+	HashInputGeometryData(InOutHash, *InString, InString.Len() * sizeof(TCHAR));
+}
+
+static void
+HashInputGeometryObjectPath(uint64& InOutHash, const UObject* InObject)
+{
+	HashInputGeometryString(InOutHash, IsValid(InObject) ? InObject->GetPathName() : FString());
+}
+
+bool
+FHoudiniInputGeometryCache::GetStaticMeshContentKey(
+	UStaticMesh* InStaticMesh,
+	UStaticMeshComponent* InStaticMeshComponent,
+	const bool& bExportLODs,
+	const bool& bExportSockets,
+	const bool& bExportColliders,
+	const bool& bPreferNaniteFallbackMesh,
+	const bool& bExportMaterialParameters,
+	uint64& OutContentKey)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniInputGeometryCache::GetStaticMeshContentKey);
+
+	if (!IsValid(InStaticMesh) || !IsValid(InStaticMeshComponent))
+		return false;
+
+	// Tags, data layers and vertex color overrides are exported on the mesh's geometry,
+	// and would be different for each component.
+	if (InStaticMeshComponent->ComponentTags.Num() > 0)
+		return false;
+
+	AActor* ParentActor = InStaticMeshComponent->GetOwner();
+	if (IsValid(ParentActor))
+	{
+		if (ParentActor->Tags.Num() > 0)
+			return false;
+#if HOUDINI_ENABLE_DATA_LAYERS
+		if (ParentActor->HasDataLayers())
+			return false;
+#endif
+	}
+
+	for (const FStaticMeshComponentLODInfo& LODInfo : InStaticMeshComponent->LODData)
+	{
+		if (LODInfo.OverrideVertexColors)
+			return false;
+	}
+
+	// The derived data key changes with the source mesh data and its build settings
+	FString DerivedDataKey;
+#if WITH_EDITORONLY_DATA
+	if (InStaticMesh->GetRenderData())
+		DerivedDataKey = InStaticMesh->GetRenderData()->DerivedDataKey;
+#endif
+	if (DerivedDataKey.IsEmpty())
+		return false;
+
+	uint64 ContentKey = 0;
+
+	// The mesh's path is exported as an attribute
+	HashInputGeometryObjectPath(ContentKey, InStaticMesh);
+	HashInputGeometryString(ContentKey, DerivedDataKey);
+
+	const uint8 Options[] = { bExportLODs, bExportSockets, bExportColliders, bPreferNaniteFallbackMesh, bExportMaterialParameters };
+	HashInputGeometryData(ContentKey, Options, sizeof(Options));
+	HashInputGeometryValue(ContentKey, InStaticMesh->GetLightMapResolution());
+
+	// LODs
+	HashInputGeometryValue(ContentKey, InStaticMesh->GetNumLODs());
+#if WITH_EDITORONLY_DATA
+	if (bExportLODs && !InStaticMesh->bAutoComputeLODScreenSize)
+	{
+		for (const FStaticMeshSourceModel& SourceModel : InStaticMesh->GetSourceModels())
+			HashInputGeometryValue(ContentKey, SourceModel.ScreenSize.Default);
+	}
+#endif
+
+	// Materials, including the component's overrides
+	const int32 NumMaterials = InStaticMeshComponent->GetNumMaterials();
+	HashInputGeometryValue(ContentKey, NumMaterials);
+	for (int32 MaterialIdx = 0; MaterialIdx < NumMaterials; MaterialIdx++)
+		HashInputGeometryObjectPath(ContentKey, InStaticMeshComponent->GetMaterial(MaterialIdx));
+
+	// Physical materials
+	FBodyInstance* BodyInstance = InStaticMeshComponent->GetBodyInstance();
+	HashInputGeometryObjectPath(ContentKey, BodyInstance ? BodyInstance->GetSimplePhysicalMaterial() : nullptr);
+
+	UBodySetup* BodySetup = InStaticMesh->GetBodySetup();
+	if (BodySetup)
+		HashInputGeometryString(ContentKey, BodySetup->PhysMaterial.GetPath());
+
+	// Sockets
+	if (bExportSockets)
+	{
+		HashInputGeometryValue(ContentKey, InStaticMesh->Sockets.Num());
+		for (const UStaticMeshSocket* Socket : InStaticMesh->Sockets)
+		{
+			if (!IsValid(Socket))
+				continue;
+
+			HashInputGeometryString(ContentKey, Socket->SocketName.ToString());
+			HashInputGeometryString(ContentKey, Socket->Tag);
+			HashInputGeometryValue(ContentKey, Socket->RelativeLocation);
+			HashInputGeometryValue(ContentKey, Socket->RelativeRotation);
+			HashInputGeometryValue(ContentKey, Socket->RelativeScale);
+		}
+	}
+
+	// Simple colliders
+	if (bExportColliders && BodySetup)
+	{
+		const FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+		HashInputGeometryValue(ContentKey, AggGeom.GetElementCount());
+		for (const FKBoxElem& Box : AggGeom.BoxElems)
+		{
+			HashInputGeometryValue(ContentKey, Box.Center);
+			HashInputGeometryValue(ContentKey, Box.Rotation);
+			HashInputGeometryValue(ContentKey, FVector(Box.X, Box.Y, Box.Z));
+		}
+		for (const FKSphereElem& Sphere : AggGeom.SphereElems)
+		{
+			HashInputGeometryValue(ContentKey, Sphere.Center);
+			HashInputGeometryValue(ContentKey, Sphere.Radius);
+		}
+		for (const FKSphylElem& Sphyl : AggGeom.SphylElems)
+		{
+			HashInputGeometryValue(ContentKey, Sphyl.Center);
+			HashInputGeometryValue(ContentKey, Sphyl.Rotation);
+			HashInputGeometryValue(ContentKey, Sphyl.Radius);
+			HashInputGeometryValue(ContentKey, Sphyl.Length);
+		}
+		for (const FKConvexElem& Convex : AggGeom.ConvexElems)
+		{
+			HashInputGeometryData(ContentKey, Convex.VertexData.GetData(), Convex.VertexData.Num() * Convex.VertexData.GetTypeSize());
+			HashInputGeometryValue(ContentKey, Convex.GetTransform().GetTranslation());
+			HashInputGeometryValue(ContentKey, Convex.GetTransform().GetRotation());
+		}
+	}
+
+	OutContentKey = ContentKey;
+	return true;
+}
+
+HAPI_NodeId
+FHoudiniInputGeometryCache::FindSharedNode(const uint64& InContentKey)
+{
+	FHoudiniInputGeometryCacheEntry* Entry = HoudiniInputGeometryCacheEntries.Find(InContentKey);
+	if (!Entry)
+		return -1;
+
+	// Make sure the node hasn't been deleted or replaced since it was cached
+	bool bIsValid = false;
+	if (HAPI_RESULT_SUCCESS != FHoudiniApi::IsNodeValid(
+		FHoudiniEngine::Get().GetSession(), Entry->NodeId, Entry->UniqueHoudiniNodeId, &bIsValid) || !bIsValid)
+	{
+		// Its references will be recreated when they are updated
+		HoudiniInputGeometryCacheEntries.Remove(InContentKey);
+		return -1;
+	}
+
+	return Entry->NodeId;
+}
+
+bool
+FHoudiniInputGeometryCache::AddSharedNode(const uint64& InContentKey, const HAPI_NodeId& InNodeId)
+{
+	HAPI_NodeInfo NodeInfo;
+	FHoudiniApi::NodeInfo_Init(&NodeInfo);
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetNodeInfo(
+		FHoudiniEngine::Get().GetSession(), InNodeId, &NodeInfo), false);
+
+	FHoudiniInputGeometryCacheEntry& Entry = HoudiniInputGeometryCacheEntries.FindOrAdd(InContentKey);
+	Entry.NodeId = InNodeId;
+	Entry.UniqueHoudiniNodeId = NodeInfo.uniqueHoudiniNodeId;
+
+	return true;
+}
+
+bool
+FHoudiniInputGeometryCache::FindReference(const HAPI_NodeId& InNodeId, FHoudiniInputGeometryReference& OutReference)
+{
+	if (InNodeId < 0)
+		return false;
+
+	const FHoudiniInputGeometryReference* Reference = HoudiniInputGeometryReferences.Find(InNodeId);
+	if (!Reference)
+		return false;
+
+	OutReference = *Reference;
+	return true;
+}
+
+void
+FHoudiniInputGeometryCache::SetReference(const FHoudiniInputGeometryReference& InReference)
+{
+	if (InReference.AttributesNodeId < 0)
+		return;
+
+	HoudiniInputGeometryReferences.Add(InReference.AttributesNodeId, InReference);
+
+	if (FHoudiniInputGeometryCacheEntry* Entry = HoudiniInputGeometryCacheEntries.Find(InReference.ContentKey))
+		Entry->References.Add(InReference.AttributesNodeId);
+}
+
+bool
+FHoudiniInputGeometryCache::ReleaseReference(const HAPI_NodeId& InNodeId, HAPI_NodeId& OutSharedNodeToDelete)
+{
+	OutSharedNodeToDelete = -1;
+
+	FHoudiniInputGeometryReference Reference;
+	if (InNodeId < 0 || !HoudiniInputGeometryReferences.RemoveAndCopyValue(InNodeId, Reference))
+		return false;
+
+	FHoudiniInputGeometryCacheEntry* Entry = HoudiniInputGeometryCacheEntries.Find(Reference.ContentKey);
+	if (!Entry)
+		return true;
+
+	Entry->References.Remove(InNodeId);
+	if (Entry->References.Num() <= 0)
+	{
+		// That was the last reference to the shared node
+		OutSharedNodeToDelete = Entry->NodeId;
+		HoudiniInputGeometryCacheEntries.Remove(Reference.ContentKey);
+	}
+
+	return true;
+}
+
+bool
+FHoudiniInputGeometryCache::ReleaseReferenceAndDeleteSharedNode(const HAPI_NodeId& InNodeId)
+{
+	HAPI_NodeId SharedNodeToDelete = -1;
+	if (!ReleaseReference(InNodeId, SharedNodeToDelete))
+		return false;
+
+	if (SharedNodeToDelete >= 0 && FHoudiniEngineRuntime::IsInitialized())
+		FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(SharedNodeToDelete, true);
+
+	return true;
+}
+
+int32
+FHoudiniInputGeometryCache::GetNumSharedNodes()
+{
+	return HoudiniInputGeometryCacheEntries.Num();
+}
+
+int32
+FHoudiniInputGeometryCache::GetNumReferences()
+{
+	return HoudiniInputGeometryReferences.Num();
+}
+
+void
+FHoudiniInputGeometryCache::Reset()
+{
+	HoudiniInputGeometryCacheEntries.Empty();
+	HoudiniInputGeometryReferences.Empty();
+}
@@ -0,0 +1,100 @@
+/*
+* Copyright (c) <2021> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "HAPI/HAPI_Common.h"
+
+#include "CoreMinimal.h"
+
+class UStaticMesh;
+class UStaticMeshComponent;
+
+// Node created by a world input object to reference a shared geometry node:
+// a geo OBJ with an object merge of the shared node and the per-object attributes.
+struct FHoudiniInputGeometryReference
+{
+	uint64 ContentKey = 0;
+	HAPI_NodeId GeoObjectNodeId = -1;
+	HAPI_NodeId ObjectMergeNodeId = -1;
+	HAPI_NodeId AttributesNodeId = -1;
+};
+
+struct FHoudiniInputGeometryCacheEntry
+{
+	// Shared node containing the geometry
+	HAPI_NodeId NodeId = -1;
+	int32 UniqueHoudiniNodeId = -1;
+
+	// Output node ids of the references to this entry
+	TSet<HAPI_NodeId> References;
+};
+
+// Session-wide cache of the input geometry uploaded to Houdini, keyed by a hash of its content.
+// Input objects exporting the same geometry reference a single shared node instead of uploading
+// their own copy. Shared nodes are released when their last reference node is deleted.
+struct HOUDINIENGINE_API FHoudiniInputGeometryCache
+{
+	// Computes the content key of a static mesh component's mesh, as it would be exported
+	// by FUnrealMeshTranslator::HapiCreateInputNodeForStaticMesh with those options.
+	// Returns false if the export contains component or actor specific data (tags, data layers,
+	// vertex color overrides...) and can't be shared.
+	static bool GetStaticMeshContentKey(
+		UStaticMesh* InStaticMesh,
+		UStaticMeshComponent* InStaticMeshComponent,
+		const bool& bExportLODs,
+		const bool& bExportSockets,
+		const bool& bExportColliders,
+		const bool& bPreferNaniteFallbackMesh,
+		const bool& bExportMaterialParameters,
+		uint64& OutContentKey);
+
+	// Returns the valid shared node for this key, or -1 if it needs to be created.
+	static HAPI_NodeId FindSharedNode(const uint64& InContentKey);
+
+	static bool AddSharedNode(const uint64& InContentKey, const HAPI_NodeId& InNodeId);
+
+	// Finds the reference whose output node is InNodeId.
+	static bool FindReference(const HAPI_NodeId& InNodeId, FHoudiniInputGeometryReference& OutReference);
+
+	// Adds or updates the reference whose output node is InReference.AttributesNodeId.
+	static void SetReference(const FHoudiniInputGeometryReference& InReference);
+
+	// Releases the reference whose output node is InNodeId, if any.
+	// OutSharedNodeToDelete is set to the shared node if this was its last reference, -1 otherwise.
+	static bool ReleaseReference(const HAPI_NodeId& InNodeId, HAPI_NodeId& OutSharedNodeToDelete);
+
+	// Releases the reference whose output node is InNodeId, if any, and marks its shared node as pending delete
+	// if this was its last reference. To be called whenever a node that may be a reference is deleted.
+	static bool ReleaseReferenceAndDeleteSharedNode(const HAPI_NodeId& InNodeId);
+
+	static int32 GetNumSharedNodes();
+
+	static int32 GetNumReferences();
+
+	// Forgets all the nodes, to be called when the session is stopped.
+	static void Reset();
+};
@@ -29,6 +29,7 @@
 #include "HoudiniInput.h"
 #include "HoudiniApi.h"
 #include "HoudiniEngine.h"
+#include "HoudiniEngineRuntime.h"
 #include "HoudiniEngineUtils.h"
 #include "HoudiniEngineString.h"
 #include "HoudiniParameter.h"
@@ -38,6 +39,7 @@
 #include "HoudiniInputObject.h"
 #include "HoudiniEnginePrivatePCH.h"
 #include "HoudiniDataLayerUtils.h"
+#include "HoudiniInputGeometryCache.h"
 #include "HoudiniSplineTranslator.h"
 #include "HoudiniAssetActor.h"
 #include "HoudiniOutputTranslator.h"
@@ -531,6 +533,7 @@ FHoudiniInputTranslator::DestroyInputNodes(UHoudiniInput* InputToDestroy, const
 						
 						// No need to delete the nodes created for an asset component manually here,
 						// As they will be deleted when we clean up the CreateNodeIds array
+						FHoudiniInputGeometryCache::ReleaseReferenceAndDeleteSharedNode(CurComponent->InputNodeId);
 						CurComponent->InputNodeId = -1;
 					}
 				}
@@ -541,6 +544,7 @@ FHoudiniInputTranslator::DestroyInputNodes(UHoudiniInput* InputToDestroy, const
 			if (CurInputObject->InputNodeId >= 0)
 			{
 				FHoudiniApi::DeleteNode(FHoudiniEngine::Get().GetSession(), CurInputObject->InputNodeId);
+				FHoudiniInputGeometryCache::ReleaseReferenceAndDeleteSharedNode(CurInputObject->InputNodeId);
 				CurInputObject->InputNodeId = -1;
 			}
 
@@ -578,6 +582,7 @@ FHoudiniInputTranslator::DestroyInputNodes(UHoudiniInput* InputToDestroy, const
 			continue;
 
 		FHoudiniApi::DeleteNode(FHoudiniEngine::Get().GetSession(), AssetNodeId);
+		FHoudiniInputGeometryCache::ReleaseReferenceAndDeleteSharedNode(AssetNodeId);
 	}
 	CreatedInputDataAssetIds.Empty();
 
@@ -848,6 +853,8 @@ FHoudiniInputTranslator::UploadChangedInputs(UHoudiniAssetComponent * HAC)
 			}
 
 			HOUDINI_CHECK_ERROR(FHoudiniApi::DeleteNode(FHoudiniEngine::Get().GetSession(), NodeToDelete));
+			FUnrealLandscapeTranslator::RemoveLandscapeRegionExport(InputNodeIdPendingDelete);
+			FHoudiniInputGeometryCache::ReleaseReferenceAndDeleteSharedNode(InputNodeIdPendingDelete);
 		}
 		CurrentInput->ClearInputNodesPendingDelete();
 
@@ -2864,6 +2871,7 @@ FHoudiniInputTranslator::HapiCreateInputNodeForStaticMeshComponent(
 	FString SMCName = InObjNodeName + TEXT("_") + SMC->GetName();
 
 	FUnrealObjectInputHandle InputNodeHandle;
+	uint64 ContentKey = 0;
 	bool bSuccess = true;
 	if (bImportAsReference) 
 	{
@@ -2882,6 +2890,9 @@ FHoudiniInputTranslator::HapiCreateInputNodeForStaticMeshComponent(
 			InObject->GetMaterialReferences() :
 			TArray<FString>();
 
+		// Our previous nodes are replaced by the reference node, release the shared mesh they referenced
+		FHoudiniInputGeometryCache::ReleaseReferenceAndDeleteSharedNode(CreatedNodeId);
+
 		bSuccess = FHoudiniInputTranslator::CreateInputNodeForReference(
 			CreatedNodeId,
 			SM,
@@ -2896,8 +2907,28 @@ FHoudiniInputTranslator::HapiCreateInputNodeForStaticMeshComponent(
 			bImportAsReferenceMaterialEnabled,
 			MaterialReferences);
 	}
+	else if (!bUseRefCountedInputSystem && FHoudiniInputGeometryCache::GetStaticMeshContentKey(
+		SM, SMC, bExportLODs, bExportSockets, bExportColliders, bPreferNaniteFallbackMesh, bExportMaterialParameters, ContentKey))
+	{
+		// Components sharing the same mesh data reference a single uploaded mesh
+		bSuccess = HapiCreateInputNodeForSharedStaticMesh(
+			SMCName,
+			SM,
+			SMC,
+			ContentKey,
+			CreatedNodeId,
+			bExportLODs,
+			bExportSockets,
+			bExportColliders,
+			bInputNodesCanBeDeleted,
+			bPreferNaniteFallbackMesh,
+			bExportMaterialParameters);
+	}
 	else 
 	{
+		// If we were referencing a shared mesh, release it before creating our own nodes
+		FHoudiniInputGeometryCache::ReleaseReferenceAndDeleteSharedNode(CreatedNodeId);
+
 		bSuccess = FUnrealMeshTranslator::HapiCreateInputNodeForStaticMesh(
 			SM, 
 			CreatedNodeId, 
@@ -2957,6 +2988,138 @@ FHoudiniInputTranslator::HapiCreateInputNodeForStaticMeshComponent(
 	return bSuccess;
 }
 
+bool
+FHoudiniInputTranslator::HapiCreateInputNodeForSharedStaticMesh(
+	const FString& InObjNodeName,
+	UStaticMesh* InStaticMesh,
+	UStaticMeshComponent* InStaticMeshComponent,
+	const uint64& InContentKey,
+	HAPI_NodeId& InOutNodeId,
+	const bool& bExportLODs,
+	const bool& bExportSockets,
+	const bool& bExportColliders,
+	const bool& bInputNodesCanBeDeleted,
+	const bool& bPreferNaniteFallbackMesh,
+	bool bExportMaterialParameters)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniInputTranslator::HapiCreateInputNodeForSharedStaticMesh);
+
+	if (!IsValid(InStaticMesh) || !IsValid(InStaticMeshComponent))
+		return false;
+
+	// Find the shared node for this mesh data, or upload the mesh if it isn't cached yet
+	HAPI_NodeId SharedNodeId = FHoudiniInputGeometryCache::FindSharedNode(InContentKey);
+	if (SharedNodeId < 0)
+	{
+		FUnrealObjectInputHandle SharedNodeHandle;
+		const FString SharedNodeName = FString::Printf(TEXT("%s_%016llx"), *InStaticMesh->GetName(), InContentKey);
+		if (!FUnrealMeshTranslator::HapiCreateInputNodeForStaticMesh(
+			InStaticMesh,
+			SharedNodeId,
+			SharedNodeName,
+			SharedNodeHandle,
+			InStaticMeshComponent,
+			bExportLODs,
+			bExportSockets,
+			bExportColliders,
+			true,
+			bInputNodesCanBeDeleted,
+			bPreferNaniteFallbackMesh,
+			bExportMaterialParameters))
+		{
+			return false;
+		}
+
+		FHoudiniInputGeometryCache::AddSharedNode(InContentKey, SharedNodeId);
+	}
+
+	// Reuse our previous reference nodes if we have some
+	FHoudiniInputGeometryReference Reference;
+	if (FHoudiniInputGeometryCache::FindReference(InOutNodeId, Reference))
+	{
+		if (Reference.ContentKey != InContentKey)
+		{
+			// We were referencing another mesh, release it
+			FHoudiniInputGeometryCache::ReleaseReferenceAndDeleteSharedNode(InOutNodeId);
+		}
+	}
+	else if (InOutNodeId >= 0)
+	{
+		// Our previous nodes contain their own mesh, delete them and their parent OBJ
+		HAPI_NodeId PreviousInputOBJNode = FHoudiniEngineUtils::HapiGetParentNodeId(InOutNodeId);
+		if (HAPI_RESULT_SUCCESS != FHoudiniApi::DeleteNode(FHoudiniEngine::Get().GetSession(), InOutNodeId))
+			HOUDINI_LOG_WARNING(TEXT("Failed to cleanup the previous input node for %s."), *InObjNodeName);
+
+		if (HAPI_RESULT_SUCCESS != FHoudiniApi::DeleteNode(FHoudiniEngine::Get().GetSession(), PreviousInputOBJNode))
+			HOUDINI_LOG_WARNING(TEXT("Failed to cleanup the previous input OBJ node for %s."), *InObjNodeName);
+	}
+	Reference.ContentKey = InContentKey;
+
+	// Object merge the shared node in our own geo OBJ, the component's transform is set on it by the caller
+	if (!HapiCreateOrUpdateGeoObjectMergeAndSetTransform(
+		-1,
+		SharedNodeId,
+		InObjNodeName,
+		Reference.ObjectMergeNodeId,
+		Reference.GeoObjectNodeId))
+	{
+		return false;
+	}
+
+	// The shared mesh was exported with the first component's actor, set our own actor and level paths
+	if (!FHoudiniEngineUtils::IsHoudiniNodeValid(Reference.AttributesNodeId))
+	{
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::CreateNode(
+			Reference.GeoObjectNodeId, TEXT("attribwrangle"), TEXT("actor_attributes"), true, &Reference.AttributesNodeId), false);
+
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::ConnectNodeInput(
+			FHoudiniEngine::Get().GetSession(), Reference.AttributesNodeId, 0, Reference.ObjectMergeNodeId, 0), false);
+
+		// Run over primitives
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::SetParmIntValue(
+			FHoudiniEngine::Get().GetSession(), Reference.AttributesNodeId, "class", 0, 1), false);
+	}
+
+	FString ActorPath;
+	FString LevelPath;
+	AActor* ParentActor = InStaticMeshComponent->GetOwner();
+	if (IsValid(ParentActor))
+	{
+		ActorPath = ParentActor->GetPathName();
+		if (IsValid(ParentActor->GetLevel()))
+		{
+			// We just want the level path up to the first point
+			LevelPath = ParentActor->GetLevel()->GetPathName();
+			int32 DotIndex;
+			if (LevelPath.FindChar('.', DotIndex))
+				LevelPath.LeftInline(DotIndex, false);
+		}
+	}
+
+	auto EscapeVEXString = [](const FString& InString)
+	{
+		return InString.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("'"), TEXT("\\'"));
+	};
+
+	// eg. s@unreal_actor_path = '/Game/Map.Map:PersistentLevel.Actor'; s@unreal_level_path = '/Game/Map';
+	const FString VEXpression = FString::Printf(TEXT("s@%s = '%s'; s@%s = '%s';"),
+		TEXT(HAPI_UNREAL_ATTRIB_ACTOR_PATH), *EscapeVEXString(ActorPath),
+		TEXT(HAPI_UNREAL_ATTRIB_LEVEL_PATH), *EscapeVEXString(LevelPath));
+
+	HAPI_ParmInfo ParmInfo;
+	HAPI_ParmId ParmId = FHoudiniEngineUtils::HapiFindParameterByName(Reference.AttributesNodeId, "snippet", ParmInfo);
+	if (ParmId < 0)
+		return false;
+
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::SetParmStringValue(
+		FHoudiniEngine::Get().GetSession(), Reference.AttributesNodeId, TCHAR_TO_UTF8(*VEXpression), ParmId, 0), false);
+
+	FHoudiniInputGeometryCache::SetReference(Reference);
+	InOutNodeId = Reference.AttributesNodeId;
+
+	return true;
+}
+
 bool
 FHoudiniInputTranslator::HapiCreateInputNodeForInstancedStaticMeshComponent(
 	const FString& InObjNodeName,
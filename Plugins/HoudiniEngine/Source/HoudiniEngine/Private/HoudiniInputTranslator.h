@@ -249,6 +249,21 @@ struct HOUDINIENGINE_API FHoudiniInputTranslator
 		const bool& bPreferNaniteFallbackMesh = false,
 		bool bExportMaterialParameters = false);
 
+	// Creates or updates a reference to the shared node of a static mesh component's geometry
+	// in the input geometry cache, uploading the mesh only if it isn't cached yet.
+	static bool HapiCreateInputNodeForSharedStaticMesh(
+		const FString& InObjNodeName,
+		UStaticMesh* InStaticMesh,
+		UStaticMeshComponent* InStaticMeshComponent,
+		const uint64& InContentKey,
+		HAPI_NodeId& InOutNodeId,
+		const bool& bExportLODs,
+		const bool& bExportSockets,
+		const bool& bExportColliders,
+		const bool& bInputNodesCanBeDeleted,
+		const bool& bPreferNaniteFallbackMesh,
+		bool bExportMaterialParameters);
+
 	static bool	HapiCreateInputNodeForInstancedStaticMeshComponent(
 		const FString& InObjNodeName,
 		UHoudiniInputInstancedMeshComponent* InObject,
@@ -48,6 +48,7 @@
 #include "InstancedFoliageActor.h"
 #include "GeometryCollectionEngine/Public/GeometryCollection/GeometryCollectionComponent.h"
 #include "FoliageEditUtility.h"
+#include "HAL/IConsoleManager.h"
 //#include "GeometryCollectionEngine/Public/GeometryCollection/GeometryCollectionDebugDrawComponent.h"
 
 #if ENGINE_MINOR_VERSION >= 2
@@ -70,6 +71,24 @@ inline int fastrand(int& nSeed)
 	return (nSeed >> 16) & 0x7FFF;
 }
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineInstanceIdDiff(
+	TEXT("HoudiniEngine.InstanceIdDiff"),
+	1,
+	TEXT("Use the instancer's id point attribute to diff instanced static mesh updates.\n")
+	TEXT("0: Instances are matched by index.\n")
+	TEXT("1: Instances are matched by id, so inserting/removing instances does not update the following ones.\n"));
+
+// Instance ids and slot assignment of the last update of each ISMC, used to diff the next update.
+struct FHoudiniISMCInstanceSlots
+{
+	// Houdini instance id of each of the component's instances
+	TArray<int32> SlotIds;
+	// Index of each of the component's instances in the instancer's transforms
+	TArray<int32> SlotToInstance;
+};
+
+static TMap<TWeakObjectPtr<UInstancedStaticMeshComponent>, FHoudiniISMCInstanceSlots> HoudiniISMCInstanceSlots;
+
 //
 bool
 FHoudiniInstanceTranslator::PopulateInstancedOutputPartData(
@@ -356,6 +375,11 @@ FHoudiniInstanceTranslator::CreateAllInstancersFromHoudiniOutput(
 			VariationInstancedObjects[InstanceObjectIdx].LoadSynchronous();
 		}
 
+		// Stable per-instance ids, used to only update the instances that changed
+		TArray<int32> PartInstanceIds;
+		if (CVarHoudiniEngineInstanceIdDiff.GetValueOnGameThread() > 0)
+			GetInstanceIds(CurHGPO.GeoId, CurHGPO.PartId, PartInstanceIds);
+
 		// Create the instancer components now
 		for (int32 InstanceObjectIdx = 0; InstanceObjectIdx < VariationInstancedObjects.Num(); InstanceObjectIdx++)
 		{
@@ -415,6 +439,27 @@ FHoudiniInstanceTranslator::CreateAllInstancersFromHoudiniOutput(
 			if (!GetAllInstancerMaterials(OutputIdentifier.GeoId, OutputIdentifier.PartId, VariationOriginalIndex, CurHGPO, InPackageParms, VariationMaterials))
 				VariationMaterials.Empty();
 
+			// Get the ids of this variation's instances
+			TArray<int32> VariationInstanceIds;
+			if (PartInstanceIds.Num() > 0 && InstancedOutputPartData.OriginalInstancedIndices.IsValidIndex(VariationOriginalIndex))
+			{
+				const TArray<int32>& OriginalIndices = InstancedOutputPartData.OriginalInstancedIndices[VariationOriginalIndex];
+				const bool bHasVariations = FoundInstancedOutput && FoundInstancedOutput->VariationObjects.Num() > 1;
+				for (int32 Idx = 0; Idx < OriginalIndices.Num(); Idx++)
+				{
+					if (bHasVariations && FoundInstancedOutput->TransformVariationIndices.IsValidIndex(Idx)
+						&& FoundInstancedOutput->TransformVariationIndices[Idx] != VariationIndices[InstanceObjectIdx])
+						continue;
+
+					if (PartInstanceIds.IsValidIndex(OriginalIndices[Idx]))
+						VariationInstanceIds.Add(PartInstanceIds[OriginalIndices[Idx]]);
+				}
+
+				// Ignore the ids if they don't match the variation's transforms
+				if (VariationInstanceIds.Num() != InstancedObjectTransforms.Num())
+					VariationInstanceIds.Empty();
+			}
+
 			TArray<USceneComponent*> NewInstancerComponents;
 			UFoliageType* FoliageTypeUsed = nullptr;
 			UWorld * WorldUsed = nullptr;
@@ -436,7 +481,8 @@ FHoudiniInstanceTranslator::CreateAllInstancersFromHoudiniOutput(
 				FoliageTypeUsed,
 				WorldUsed, 
 				InstancedOutputPartData.bForceHISM,
-				InstancedOutputPartData.bForceInstancer))
+				InstancedOutputPartData.bForceInstancer,
+				VariationInstanceIds))
 			{
 				// TODO??
 				continue;
@@ -2047,7 +2093,8 @@ FHoudiniInstanceTranslator::CreateOrUpdateInstanceComponent(
 	UFoliageType*& FoliageTypeUsed,
 	UWorld*& WorldUsed,
 	const bool& bForceHISM,
-	const bool& bForceInstancer)
+	const bool& bForceInstancer,
+	const TArray<int32>& InstanceIds)
 {
 	// See if we can reuse the old component
 	InstancerComponentType OldType = GetComponentsType(OldComponents);
@@ -2137,7 +2184,7 @@ FHoudiniInstanceTranslator::CreateOrUpdateInstanceComponent(
 		{
 			// Create an Instanced Static Mesh Component
 			bSuccess = CreateOrUpdateInstancedStaticMeshComponent(
-				StaticMesh, InstancedObjectTransforms, AllPropertyAttributes, InstancerGeoPartObject, ParentComponent, NewComponents[0], InstancerMaterials, bForceHISM, FirstOriginalIndex);
+				StaticMesh, InstancedObjectTransforms, AllPropertyAttributes, InstancerGeoPartObject, ParentComponent, NewComponents[0], InstancerMaterials, bForceHISM, FirstOriginalIndex, InstanceIds);
 			bCheckRenderState = true;
 		}
 		break;
@@ -2238,6 +2285,160 @@ FHoudiniInstanceTranslator::CreateOrUpdateInstanceComponent(
 	return bSuccess;
 }
 
+void
+FHoudiniInstanceTranslator::ComputeInstanceSlots(
+	const TArray<int32>& InOldSlotIds,
+	const TArray<int32>& InNewIds,
+	TArray<int32>& OutSlotToInstance)
+{
+	TMap<int32, int32> OldSlotOfId;
+	OldSlotOfId.Reserve(InOldSlotIds.Num());
+	for (int32 Slot = 0; Slot < InOldSlotIds.Num(); Slot++)
+		OldSlotOfId.FindOrAdd(InOldSlotIds[Slot], Slot);
+
+	// Instances that were already present keep their slot
+	OutSlotToInstance.Init(INDEX_NONE, InOldSlotIds.Num());
+	TArray<int32> AddedInstances;
+	for (int32 InstanceIdx = 0; InstanceIdx < InNewIds.Num(); InstanceIdx++)
+	{
+		const int32* OldSlot = OldSlotOfId.Find(InNewIds[InstanceIdx]);
+		if (OldSlot && OutSlotToInstance[*OldSlot] == INDEX_NONE)
+			OutSlotToInstance[*OldSlot] = InstanceIdx;
+		else
+			AddedInstances.Add(InstanceIdx);
+	}
+
+	// New instances reuse the slots of the removed ones first, the rest are appended
+	int32 AddedIdx = 0;
+	for (int32 Slot = 0; Slot < OutSlotToInstance.Num() && AddedIdx < AddedInstances.Num(); Slot++)
+	{
+		if (OutSlotToInstance[Slot] == INDEX_NONE)
+			OutSlotToInstance[Slot] = AddedInstances[AddedIdx++];
+	}
+
+	for (; AddedIdx < AddedInstances.Num(); AddedIdx++)
+		OutSlotToInstance.Add(AddedInstances[AddedIdx]);
+
+	// Fill the remaining free slots with the last instances, so only the tail of the component needs to be removed
+	for (int32 Slot = 0; Slot < OutSlotToInstance.Num(); Slot++)
+	{
+		if (OutSlotToInstance[Slot] != INDEX_NONE)
+			continue;
+
+		while (OutSlotToInstance.Num() > Slot && OutSlotToInstance.Last() == INDEX_NONE)
+			OutSlotToInstance.Pop(false);
+
+		if (Slot >= OutSlotToInstance.Num())
+			break;
+
+		OutSlotToInstance[Slot] = OutSlotToInstance.Pop(false);
+	}
+}
+
+// Updates the instances of an ISMC with minimal changes: only the instances whose transform changed are updated,
+// and instances are only added or removed at the end of the component.
+static void
+UpdateInstancedStaticMeshComponentInstances(
+	UInstancedStaticMeshComponent* InISMC,
+	const TArray<FTransform>& InTransforms,
+	const TArray<int32>& InInstanceIds)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UpdateInstancedStaticMeshComponentInstances);
+
+	const int32 NumOldInstances = InISMC->GetInstanceCount();
+	const int32 NumNewInstances = InTransforms.Num();
+
+	// Match the instances by id if we have one per instance, and know the ids of the component's instances
+	const bool bUseInstanceIds = CVarHoudiniEngineInstanceIdDiff.GetValueOnGameThread() > 0 && InInstanceIds.Num() == NumNewInstances;
+	const FHoudiniISMCInstanceSlots* OldSlots = HoudiniISMCInstanceSlots.Find(InISMC);
+	TArray<int32> SlotToInstance;
+	if (bUseInstanceIds && OldSlots && OldSlots->SlotIds.Num() == NumOldInstances)
+	{
+		FHoudiniInstanceTranslator::ComputeInstanceSlots(OldSlots->SlotIds, InInstanceIds, SlotToInstance);
+	}
+	else
+	{
+		SlotToInstance.SetNumUninitialized(NumNewInstances);
+		for (int32 Slot = 0; Slot < NumNewInstances; Slot++)
+			SlotToInstance[Slot] = Slot;
+	}
+
+	// Update the changed instances, nearby changes are grouped in a single batch
+	const int32 MaxUnchangedInstancesInBatch = 64;
+	int32 BatchStart = INDEX_NONE;
+	int32 BatchEnd = INDEX_NONE;
+	auto FlushBatch = [&]()
+	{
+		if (BatchStart == INDEX_NONE)
+			return;
+
+		TArray<FTransform> BatchTransforms;
+		BatchTransforms.SetNumUninitialized(BatchEnd - BatchStart + 1);
+		for (int32 Slot = BatchStart; Slot <= BatchEnd; Slot++)
+			BatchTransforms[Slot - BatchStart] = InTransforms[SlotToInstance[Slot]];
+
+		InISMC->BatchUpdateInstancesTransforms(BatchStart, BatchTransforms, false, false);
+		BatchStart = INDEX_NONE;
+	};
+
+	const int32 NumKeptInstances = FMath::Min(NumOldInstances, NumNewInstances);
+	for (int32 Slot = 0; Slot < NumKeptInstances; Slot++)
+	{
+		FTransform OldTransform;
+		if (InISMC->GetInstanceTransform(Slot, OldTransform, false) && OldTransform.Equals(InTransforms[SlotToInstance[Slot]]))
+			continue;
+
+		if (BatchStart != INDEX_NONE && Slot - BatchEnd > MaxUnchangedInstancesInBatch)
+			FlushBatch();
+
+		if (BatchStart == INDEX_NONE)
+			BatchStart = Slot;
+		BatchEnd = Slot;
+	}
+	FlushBatch();
+
+	if (NumNewInstances > NumOldInstances)
+	{
+		// Append the new instances
+		TArray<FTransform> AddedTransforms;
+		AddedTransforms.SetNumUninitialized(NumNewInstances - NumOldInstances);
+		for (int32 Slot = NumOldInstances; Slot < NumNewInstances; Slot++)
+			AddedTransforms[Slot - NumOldInstances] = InTransforms[SlotToInstance[Slot]];
+
+		InISMC->AddInstances(AddedTransforms, false);
+	}
+	else if (NumOldInstances > NumNewInstances)
+	{
+		// Remove the last instances, in reverse order so no other instance is moved
+		TArray<int32> RemovedInstances;
+		RemovedInstances.SetNumUninitialized(NumOldInstances - NumNewInstances);
+		for (int32 Slot = NumOldInstances - 1; Slot >= NumNewInstances; Slot--)
+			RemovedInstances[NumOldInstances - 1 - Slot] = Slot;
+
+		InISMC->RemoveInstances(RemovedInstances);
+	}
+
+	// Remember the ids for the next update, and drop the entries of destroyed components
+	for (auto It = HoudiniISMCInstanceSlots.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+			It.RemoveCurrent();
+	}
+
+	if (bUseInstanceIds)
+	{
+		FHoudiniISMCInstanceSlots& NewSlots = HoudiniISMCInstanceSlots.FindOrAdd(InISMC);
+		NewSlots.SlotIds.SetNumUninitialized(NumNewInstances);
+		for (int32 Slot = 0; Slot < NumNewInstances; Slot++)
+			NewSlots.SlotIds[Slot] = InInstanceIds[SlotToInstance[Slot]];
+		NewSlots.SlotToInstance = MoveTemp(SlotToInstance);
+	}
+	else
+	{
+		HoudiniISMCInstanceSlots.Remove(InISMC);
+	}
+}
+
 bool
 FHoudiniInstanceTranslator::CreateOrUpdateInstancedStaticMeshComponent(
 	UStaticMesh* InstancedStaticMesh,
@@ -2248,7 +2449,8 @@ FHoudiniInstanceTranslator::CreateOrUpdateInstancedStaticMeshComponent(
 	USceneComponent*& CreatedInstancedComponent,
 	TArray<UMaterialInterface*> InstancerMaterials,
 	const bool & bForceHISM,
-	const int32& InstancerObjectIdx)
+	const int32& InstancerObjectIdx,
+	const TArray<int32>& InstanceIds)
 {
 	if (!InstancedStaticMesh)
 		return false;
@@ -2311,42 +2513,7 @@ FHoudiniInstanceTranslator::CreateOrUpdateInstancedStaticMeshComponent(
 	}
 
 	// Now add the instances themselves
-	//InstancedStaticMeshComponent->ClearInstances();
-	//InstancedStaticMeshComponent->AddInstances(InstancedObjectTransforms, false);
-
-	int32 NumOldInstances = InstancedStaticMeshComponent->GetInstanceCount();
-	int32 NumNewInstances = InstancedObjectTransforms.Num();
-	if (NumOldInstances >= NumNewInstances)
-	{
-		if (NumOldInstances > NumNewInstances)
-		{
-			// We need to remove instances
-			// Remove instance will occasionally cause crashes in UE5-EA2, so clear and re-create the instances
-			InstancedStaticMeshComponent->ClearInstances();
-			InstancedStaticMeshComponent->AddInstances(InstancedObjectTransforms, false);
-		}
-		else  // Reuse existing instances, and update instances transform
-			InstancedStaticMeshComponent->BatchUpdateInstancesTransforms(0, InstancedObjectTransforms, false, true);
-
-		// Remove instance occasionally cause crashes in UE5-EA2
-		//for (int32 n = NumOldInstances - 1; n >= NumNewInstances; n--)
-		//	InstancedStaticMeshComponent->RemoveInstance(n);
-		//InstancedStaticMeshComponent->BatchUpdateInstancesTransforms(0, InstancedObjectTransforms, false, true);
-	}
-	else
-	{
-		// We need to append new instances
-		TArray<FTransform> CreatedTransforms = InstancedObjectTransforms;
-		TArray<FTransform> NewTransforms;
-		for (int32 n = NumNewInstances - 1; n >= NumOldInstances; n--)
-			NewTransforms.Add(CreatedTransforms.Pop());
-
-		// Update the existing instances
-		InstancedStaticMeshComponent->BatchUpdateInstancesTransforms(0, CreatedTransforms, false, true);
-
-		// Append the new ones
-		InstancedStaticMeshComponent->AddInstances(NewTransforms, false);
-	}
+	UpdateInstancedStaticMeshComponentInstances(InstancedStaticMeshComponent, InstancedObjectTransforms, InstanceIds);
 
 	// Apply generic attributes if we have any
 	UpdateGenericPropertiesAttributes(InstancedStaticMeshComponent, AllPropertyAttributes, InstancerObjectIdx);
@@ -3618,6 +3785,29 @@ FHoudiniInstanceTranslator::HasForceInstancerAttribute(const HAPI_NodeId& GeoId,
 	return IntData[0] != 0;
 }
 
+bool
+FHoudiniInstanceTranslator::GetInstanceIds(const HAPI_NodeId& GeoId, const HAPI_NodeId& PartId, TArray<int32>& OutInstanceIds)
+{
+	HAPI_AttributeInfo AttriInfo;
+	FHoudiniApi::AttributeInfo_Init(&AttriInfo);
+
+	OutInstanceIds.Empty();
+	if (!FHoudiniEngineUtils::HapiGetAttributeDataAsInteger(
+		GeoId, PartId, HAPI_UNREAL_ATTRIB_INSTANCE_ID,
+		AttriInfo, OutInstanceIds, 1, HAPI_ATTROWNER_POINT))
+	{
+		return false;
+	}
+
+	if (!AttriInfo.exists || OutInstanceIds.Num() <= 0)
+	{
+		OutInstanceIds.Empty();
+		return false;
+	}
+
+	return true;
+}
+
 void
 FHoudiniInstancedOutputPartData::BuildFlatInstancedTransformsAndObjectPaths()
 {
@@ -3877,19 +4067,21 @@ FHoudiniInstanceTranslator::GetPerInstanceCustomData(
 		// Now that we have read all the custom data values, we need to "interlace" them
 		// in the final per-instance custom data array, fill missing values with zeroes
 		TArray<float>& PerInstanceCustomData = OutInstancedOutputPartData.PerInstanceCustomData[ObjIdx];
-		PerInstanceCustomData.Reserve(InstanceIndices.Num() * NumCustomFloatsForInstance);
 
 		if(NumCustomFloatsForInstance == 0)
 		{
 			continue;
 		}
-		
-		for (int32 InstIdx : InstanceIndices)
+
+		// Interlace one custom data column at a time
+		PerInstanceCustomData.SetNumZeroed(InstanceIndices.Num() * NumCustomFloatsForInstance);
+		for (int32 nCustomIdx = 0; nCustomIdx < NumCustomFloatsForInstance; ++nCustomIdx)
 		{
-			for (int32 nCustomIdx = 0; nCustomIdx < NumCustomFloatsForInstance; ++nCustomIdx)
+			const TArray<float>& CustomDataColumn = AllCustomDataAttributeValues[nCustomIdx];
+			for (int32 n = 0; n < InstanceIndices.Num(); ++n)
 			{
-				float CustomData = (InstIdx < AllCustomDataAttributeValues[nCustomIdx].Num() ? AllCustomDataAttributeValues[nCustomIdx][InstIdx] : 0.0f);
-				PerInstanceCustomData.Add(CustomData);
+				if (CustomDataColumn.IsValidIndex(InstanceIndices[n]))
+					PerInstanceCustomData[n * NumCustomFloatsForInstance + nCustomIdx] = CustomDataColumn[InstanceIndices[n]];
 			}
 		}
 	}
@@ -3933,11 +4125,26 @@ FHoudiniInstanceTranslator::UpdateChangedPerInstanceCustomData(
 	// except we modify all the instance/custom values at once
 	ISMC->Modify();
 
-	// MemCopy
-	const int32 NumToCopy = FMath::Min(ISMC->PerInstanceSMCustomData.Num(), InPerInstanceCustomData.Num());
-	if (NumToCopy > 0)
+	const FHoudiniISMCInstanceSlots* InstanceSlots = HoudiniISMCInstanceSlots.Find(ISMC);
+	if (InstanceSlots && InstanceSlots->SlotToInstance.Num() == InstanceCount)
 	{
-		FMemory::Memcpy(&ISMC->PerInstanceSMCustomData[0], InPerInstanceCustomData.GetData(), NumToCopy * InPerInstanceCustomData.GetTypeSize());
+		// The instances were matched by id, copy each instance's data to its slot
+		for (int32 Slot = 0; Slot < InstanceCount; Slot++)
+		{
+			FMemory::Memcpy(
+				&ISMC->PerInstanceSMCustomData[Slot * NumCustomFloats],
+				&InPerInstanceCustomData[InstanceSlots->SlotToInstance[Slot] * NumCustomFloats],
+				NumCustomFloats * InPerInstanceCustomData.GetTypeSize());
+		}
+	}
+	else
+	{
+		// MemCopy
+		const int32 NumToCopy = FMath::Min(ISMC->PerInstanceSMCustomData.Num(), InPerInstanceCustomData.Num());
+		if (NumToCopy > 0)
+		{
+			FMemory::Memcpy(&ISMC->PerInstanceSMCustomData[0], InPerInstanceCustomData.GetData(), NumToCopy * InPerInstanceCustomData.GetTypeSize());
+		}
 	}
 
 	// Force recreation of the render data when proxy is created
@@ -339,7 +339,8 @@ struct HOUDINIENGINE_API FHoudiniInstanceTranslator
 			UFoliageType*& FoliageTypeUsed,
 			UWorld* & WorldUsed,
 			const bool& bForceHISM = false,
-			const bool& bForceInstancer = false);
+			const bool& bForceInstancer = false,
+			const TArray<int32>& InstanceIds = TArray<int32>());
 
 		// Create or update an ISMC / HISMC
 		static bool CreateOrUpdateInstancedStaticMeshComponent(
@@ -351,7 +352,16 @@ struct HOUDINIENGINE_API FHoudiniInstanceTranslator
 			USceneComponent*& CreatedInstancedComponent,
 			TArray<UMaterialInterface*> InstancerMaterials,
 			const bool& bForceHISM = false,
-			const int32& InstancerObjectIdx = 0);
+			const int32& InstancerObjectIdx = 0,
+			const TArray<int32>& InstanceIds = TArray<int32>());
+
+		// Assigns the new instances to the component's instance slots, keeping the slots of the instances
+		// whose id was already present so only the added/removed/changed instances need to be updated.
+		// OutSlotToInstance[Slot] is the index in InNewIds of the instance to place in that slot.
+		static void ComputeInstanceSlots(
+			const TArray<int32>& InOldSlotIds,
+			const TArray<int32>& InNewIds,
+			TArray<int32>& OutSlotToInstance);
 
 		// Create or update an IAC
 		static bool CreateOrUpdateInstancedActorComponent(
@@ -504,6 +514,9 @@ struct HOUDINIENGINE_API FHoudiniInstanceTranslator
 		// Return true if HAPI_UNREAL_ATTRIB_FORCE_INSTANCER is set to non-zero (this controls
 		// if an instancer is created even for single instances (static mesh vs instanced static mesh for example)
 		static bool HasForceInstancerAttribute(const HAPI_NodeId& GeoId, const HAPI_NodeId& PartId);
+
+		// Gets the stable per-instance ids (HAPI_UNREAL_ATTRIB_INSTANCE_ID point attribute) if the instancer has them
+		static bool GetInstanceIds(const HAPI_NodeId& GeoId, const HAPI_NodeId& PartId, TArray<int32>& OutInstanceIds);
 	
 		// Checks for PerInstanceCustomData on the instancer part
 		static bool GetPerInstanceCustomData(
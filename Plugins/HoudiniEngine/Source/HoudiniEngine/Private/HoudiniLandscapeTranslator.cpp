@@ -745,18 +745,14 @@ FHoudiniLandscapeTranslator::TranslateHeightFieldPart(
 		float Scale = 100.0f; // Scale from Meters to CM.
 		Scale /= Range; // Remap to -1.0f to 1.0 Range
 
-		FHoudiniLandscapeUtils::RealignHeightFieldData(HeightFieldData.Values, 0.5f, Scale * 0.5f);
-		
-		// Explicitly clamp the values, and report if clamped.
-		bool bClamped = FHoudiniLandscapeUtils::ClampHeightFieldData(HeightFieldData.Values, 0.0, 1.0f);
+		// Realign, explicitly clamp the values and quantize them to 16-bit, report if clamped.
+		TArray<uint16> QuantizedData;
+		bool bClamped = FHoudiniLandscapeUtils::ConvertHeightFieldDataTo16Bit(HeightFieldData.Values, 0.5f, Scale * 0.5f, QuantizedData);
 		if (bClamped)
 		{
 			HOUDINI_BAKING_WARNING(TEXT("Landscape layer exceeded max heights so was clamped."));
 		}
 
-		// Quantized to 16-bit and set the data.
-		auto QuantizedData = FHoudiniLandscapeUtils::QuantizeNormalizedDataTo16Bit(HeightFieldData.Values);
-
 		FScopedSetLandscapeEditingLayer Scope(OutputLandscape, UnrealEditLayer->Guid, [&] { OutputLandscape->RequestLayersContentUpdate(ELandscapeLayerUpdateMode::Update_All); });
 
 		FLandscapeEditDataInterface LandscapeEdit(TargetLandscapeInfo);
@@ -41,6 +41,28 @@
 #include "Materials/MaterialInstanceConstant.h"
 #include "HoudiniMaterialTranslator.h"
 #include "PackageTools.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineParallelLandscapeConversion(
+	TEXT("HoudiniEngine.ParallelLandscapeConversion"),
+	1,
+	TEXT("When enabled, heightfield data is transposed, resampled and quantized on multiple threads.\n")
+	TEXT("0: Convert the whole heightfield on the calling thread\n")
+	TEXT("1: Split the heightfield in bands of rows converted on the task graph (default)\n")
+);
+
+// Number of values processed by one task when converting heightfield data
+#define HOUDINI_HEIGHTFIELD_PARALLEL_CHUNK_SIZE 16384
+
+// Size of the square tiles used when transposing heightfield data
+#define HOUDINI_HEIGHTFIELD_TRANSPOSE_TILE_SIZE 64
+
+static bool
+IsParallelLandscapeConversionEnabled()
+{
+	return CVarHoudiniEngineParallelLandscapeConversion.GetValueOnAnyThread() != 0;
+}
 
 TSet<UHoudiniLandscapeTargetLayerOutput *>
 FHoudiniLandscapeUtils::GetEditLayers(UHoudiniOutput& Output)
@@ -113,19 +135,24 @@ FHoudiniLandscapeUtils::SetCookedLayersVisibility(UHoudiniAssetComponent& HAC, A
 
 void FHoudiniLandscapeUtils::RealignHeightFieldData(TArray<float>& Data, float ZeroPoint, float Scale)
 {
-	for(int Index = 0; Index < Data.Num(); Index++)
+	float* Values = Data.GetData();
+	const int32 NumChunks = FMath::DivideAndRoundUp(Data.Num(), HOUDINI_HEIGHTFIELD_PARALLEL_CHUNK_SIZE);
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
 	{
-		Data[Index] = Data[Index] * Scale + ZeroPoint;
-	}
+		const int32 Start = ChunkIndex * HOUDINI_HEIGHTFIELD_PARALLEL_CHUNK_SIZE;
+		const int32 End = FMath::Min(Start + HOUDINI_HEIGHTFIELD_PARALLEL_CHUNK_SIZE, Data.Num());
+		for (int32 Index = Start; Index < End; Index++)
+		{
+			Values[Index] = Values[Index] * Scale + ZeroPoint;
+		}
+	}, !IsParallelLandscapeConversionEnabled() || NumChunks < 2);
 }
 
 
 bool FHoudiniLandscapeUtils::ClampHeightFieldData(TArray<float>& Data, float MinValue, float MaxValue)
 {
-	TArray<float> Result;
 	bool bClamped = false;
-	Result.SetNumUninitialized(Data.Num());
-	for (int Index = 0; Index < Result.Num(); Index++)
+	for (int Index = 0; Index < Data.Num(); Index++)
 	{
 		float Value = Data[Index];
 		Data[Index] = FMath::Clamp(Value, MinValue, MaxValue);
@@ -147,6 +174,95 @@ FHoudiniLandscapeUtils::QuantizeNormalizedDataTo16Bit(const TArray<float>& Data)
 	return Result;
 }
 
+bool
+FHoudiniLandscapeUtils::ConvertHeightFieldDataTo16Bit(const TArray<float>& Data, float ZeroPoint, float Scale, TArray<uint16>& OutQuantized)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniLandscapeUtils::ConvertHeightFieldDataTo16Bit);
+
+	OutQuantized.SetNumUninitialized(Data.Num());
+
+	const float* Values = Data.GetData();
+	uint16* Quantized = OutQuantized.GetData();
+	const int32 NumChunks = FMath::DivideAndRoundUp(Data.Num(), HOUDINI_HEIGHTFIELD_PARALLEL_CHUNK_SIZE);
+
+	TArray<bool> ChunkClamped;
+	ChunkClamped.SetNumZeroed(NumChunks);
+
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		const int32 Start = ChunkIndex * HOUDINI_HEIGHTFIELD_PARALLEL_CHUNK_SIZE;
+		const int32 End = FMath::Min(Start + HOUDINI_HEIGHTFIELD_PARALLEL_CHUNK_SIZE, Data.Num());
+
+		const VectorRegister4Float VectorScale = VectorSetFloat1(Scale);
+		const VectorRegister4Float VectorZeroPoint = VectorSetFloat1(ZeroPoint);
+		const VectorRegister4Float VectorMaxValue = VectorSetFloat1(65535.0f);
+
+		// Same operations as RealignHeightFieldData, ClampHeightFieldData(0, 1) and QuantizeNormalizedDataTo16Bit,
+		// four values at a time.
+		bool bClamped = false;
+		int32 Index = Start;
+		for (; Index + 4 <= End; Index += 4)
+		{
+			const VectorRegister4Float Realigned = VectorAdd(VectorMultiply(VectorLoad(Values + Index), VectorScale), VectorZeroPoint);
+			const VectorRegister4Float Clamped = VectorMin(VectorMax(Realigned, GlobalVectorConstants::FloatZero), GlobalVectorConstants::FloatOne);
+			bClamped |= VectorMaskBits(VectorCompareNE(Realigned, Clamped)) != 0;
+
+			alignas(16) int32 Ints[4];
+			VectorIntStoreAligned(VectorFloatToInt(VectorMultiply(Clamped, VectorMaxValue)), Ints);
+			Quantized[Index + 0] = static_cast<uint16>(Ints[0]);
+			Quantized[Index + 1] = static_cast<uint16>(Ints[1]);
+			Quantized[Index + 2] = static_cast<uint16>(Ints[2]);
+			Quantized[Index + 3] = static_cast<uint16>(Ints[3]);
+		}
+
+		for (; Index < End; Index++)
+		{
+			const float Realigned = Values[Index] * Scale + ZeroPoint;
+			const float Clamped = FMath::Clamp(Realigned, 0.0f, 1.0f);
+			bClamped |= (Clamped != Realigned);
+			Quantized[Index] = static_cast<uint16>(FMath::Clamp<int>(static_cast<int>(Clamped * 65535), 0, 65535));
+		}
+
+		ChunkClamped[ChunkIndex] = bClamped;
+	}, !IsParallelLandscapeConversionEnabled() || NumChunks < 2);
+
+	return ChunkClamped.Contains(true);
+}
+
+void
+FHoudiniLandscapeUtils::TransposeHeightFieldData(const TArray<float>& HoudiniValues, const FIntPoint& Dimensions, TArray<float>& OutValues)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniLandscapeUtils::TransposeHeightFieldData);
+
+	OutValues.SetNumUninitialized(Dimensions.X * Dimensions.Y);
+	if (!ensure(HoudiniValues.Num() == OutValues.Num()))
+		return;
+
+	const float* Source = HoudiniValues.GetData();
+	float* Dest = OutValues.GetData();
+
+	// Houdini values are stored X major, copy them tile by tile so both the reads and the writes stay in cache.
+	// Each task owns a band of destination rows.
+	const int32 TileSize = HOUDINI_HEIGHTFIELD_TRANSPOSE_TILE_SIZE;
+	const int32 NumBands = FMath::DivideAndRoundUp(Dimensions.Y, TileSize);
+	ParallelFor(NumBands, [&](int32 BandIndex)
+	{
+		const int32 StartY = BandIndex * TileSize;
+		const int32 EndY = FMath::Min(StartY + TileSize, Dimensions.Y);
+		for (int32 StartX = 0; StartX < Dimensions.X; StartX += TileSize)
+		{
+			const int32 EndX = FMath::Min(StartX + TileSize, Dimensions.X);
+			for (int32 Y = StartY; Y < EndY; Y++)
+			{
+				for (int32 X = StartX; X < EndX; X++)
+				{
+					Dest[Y * Dimensions.X + X] = Source[Y + Dimensions.Y * X];
+				}
+			}
+		}
+	}, !IsParallelLandscapeConversionEnabled() || NumBands < 2);
+}
+
 static float Convert(int NewValue, int NewMax, int OldMax)
 {
 	float Scale = float(NewValue) / float(NewMax - 1);
@@ -890,30 +1006,18 @@ FHoudiniHeightFieldData FHoudiniLandscapeUtils::FetchVolumeInUnrealSpace(const F
 
 	TArray<float> HoudiniValues;
 	HoudiniValues.SetNumZeroed(Result.GetNumPoints());
-	Result.Values.SetNumZeroed(HoudiniValues.Num());
 
 	auto Status = FHoudiniEngineUtils::HapiGetHeightFieldData(
 							HeightField.GeoId, HeightField.PartId, HoudiniValues);
 	HOUDINI_CHECK_RETURN(Status == HAPI_RESULT_SUCCESS, Result);
 
-
-	Result.Values.SetNum(HoudiniValues.Num());
-
 	if (bTansposeData)
 	{
-		int Offset = 0;
-		for(int Y = 0; Y < Result.Dimensions.Y; Y++)
-		{
-			for (int X = 0; X < Result.Dimensions.X; X++)
-			{
-				int HIndex = Y + Result.Dimensions.Y * X;
-				Result.Values[Offset++] = HoudiniValues[HIndex];
-			}
-		}
+		TransposeHeightFieldData(HoudiniValues, Result.Dimensions, Result.Values);
 	}
 	else
 	{
-		Result.Values = HoudiniValues;
+		Result.Values = MoveTemp(HoudiniValues);
 	}
 
 	return Result;
@@ -925,29 +1029,69 @@ FHoudiniLandscapeUtils::ReDimensionLandscape(const FHoudiniHeightFieldData & Hei
 	FHoudiniHeightFieldData Result;
 	Result.Transform = HeightField.Transform;
 	Result.Dimensions = NewDimensions;
-	Result.Values.SetNumZeroed(Result.GetNumPoints());
+	Result.Values.SetNumUninitialized(Result.GetNumPoints());
+
+	const FIntPoint OldDimensions = HeightField.Dimensions;
+	const float XScale = (float)(OldDimensions.X - 1) / (NewDimensions.X - 1);
+	const float YScale = (float)(OldDimensions.Y - 1) / (NewDimensions.Y - 1);
+	const bool bParallel = IsParallelLandscapeConversionEnabled();
+
+	// Bilinear filtering is separable: BiLerp(P00, P10, P01, P11, FX, FY) == Lerp(Lerp(P00, P10, FX), Lerp(P01, P11, FX), FY).
+	// Resample the source rows along X once, then blend pairs of resampled rows along Y.
+	TArray<int32> X0s;
+	TArray<int32> X1s;
+	TArray<float> XFractions;
+	X0s.SetNumUninitialized(NewDimensions.X);
+	X1s.SetNumUninitialized(NewDimensions.X);
+	XFractions.SetNumUninitialized(NewDimensions.X);
+	for (int32 X = 0; X < NewDimensions.X; ++X)
+	{
+		float OldX = X * XScale;
+		X0s[X] = FMath::FloorToInt(OldX);
+		X1s[X] = FMath::Min(FMath::FloorToInt(OldX) + 1, OldDimensions.X - 1);
+		XFractions[X] = FMath::Fractional(OldX);
+	}
+
+	// Only the source rows sampled by the output are resampled.
+	TArray<bool> UsedRows;
+	UsedRows.SetNumZeroed(OldDimensions.Y);
+	for (int32 Y = 0; Y < NewDimensions.Y; ++Y)
+	{
+		float OldY = Y * YScale;
+		UsedRows[FMath::FloorToInt(OldY)] = true;
+		UsedRows[FMath::Min(FMath::FloorToInt(OldY) + 1, OldDimensions.Y - 1)] = true;
+	}
 
-	const float XScale = (float)(HeightField.Dimensions.X - 1) / (Result.Dimensions.X - 1);
-	const float YScale = (float)(HeightField.Dimensions.Y - 1) / (Result.Dimensions.Y - 1);
-	for (int32 Y = 0; Y < Result.Dimensions.Y; ++Y)
+	TArray<float> ResampledRows;
+	ResampledRows.SetNumUninitialized(OldDimensions.Y * NewDimensions.X);
+	ParallelFor(OldDimensions.Y, [&](int32 Y)
 	{
-		for (int32 X = 0; X < Result.Dimensions.X; ++X)
+		if (!UsedRows[Y])
+			return;
+
+		const float* SourceRow = HeightField.Values.GetData() + Y * OldDimensions.X;
+		float* ResampledRow = ResampledRows.GetData() + Y * NewDimensions.X;
+		for (int32 X = 0; X < NewDimensions.X; ++X)
 		{
-			float OldY = Y * YScale;
-			float OldX = X * XScale;
-			int32 X0 = FMath::FloorToInt(OldX);
-			int32 X1 = FMath::Min(FMath::FloorToInt(OldX) + 1, HeightField.Dimensions.X - 1);
-			int32 Y0 = FMath::FloorToInt(OldY);
-			int32 Y1 = FMath::Min(FMath::FloorToInt(OldY) + 1, HeightField.Dimensions.Y - 1);
-			float Original00 = HeightField.Values[Y0 * HeightField.Dimensions.X + X0];
-			float Original10 = HeightField.Values[Y0 * HeightField.Dimensions.X + X1];
-			float Original01 = HeightField.Values[Y1 * HeightField.Dimensions.X + X0];
-			float Original11 = HeightField.Values[Y1 * HeightField.Dimensions.X + X1];
-			float NewValue = FMath::BiLerp(Original00, Original10, Original01, Original11, FMath::Fractional(OldX), FMath::Fractional(OldY));
-			Result.Values[Y * Result.Dimensions.X + X] = NewValue;
+			ResampledRow[X] = FMath::Lerp(SourceRow[X0s[X]], SourceRow[X1s[X]], XFractions[X]);
+		}
+	}, !bParallel);
 
+	ParallelFor(NewDimensions.Y, [&](int32 Y)
+	{
+		float OldY = Y * YScale;
+		int32 Y0 = FMath::FloorToInt(OldY);
+		int32 Y1 = FMath::Min(FMath::FloorToInt(OldY) + 1, OldDimensions.Y - 1);
+		const float YFraction = FMath::Fractional(OldY);
+
+		const float* Row0 = ResampledRows.GetData() + Y0 * NewDimensions.X;
+		const float* Row1 = ResampledRows.GetData() + Y1 * NewDimensions.X;
+		float* ResultRow = Result.Values.GetData() + Y * NewDimensions.X;
+		for (int32 X = 0; X < NewDimensions.X; ++X)
+		{
+			ResultRow[X] = FMath::Lerp(Row0[X], Row1[X], YFraction);
 		}
-	}
+	}, !bParallel);
 
 	return Result;
 }
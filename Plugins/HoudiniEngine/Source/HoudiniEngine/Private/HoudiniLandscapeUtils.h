@@ -201,6 +201,13 @@ struct HOUDINIENGINE_API FHoudiniLandscapeUtils
 
 	static TArray<uint16> QuantizeNormalizedDataTo16Bit(const TArray<float>& Data);
 
+	// Realigns, clamps to [0, 1] and quantizes the data in a single parallel pass, with the same
+	// result as the three functions above. Returns true if any value was clamped.
+	static bool ConvertHeightFieldDataTo16Bit(const TArray<float>& Data, float ZeroPoint, float Scale, TArray<uint16>& OutQuantized);
+
+	// Converts X major Houdini volume values to Unreal's row major layout.
+	static void TransposeHeightFieldData(const TArray<float>& HoudiniValues, const FIntPoint& Dimensions, TArray<float>& OutValues);
+
     static float GetLandscapeHeightRangeInCM(ALandscape& Landscape);
 
     static TArray<uint16> GetHeightData(ALandscape* Landscape, const FHoudiniExtents& Extents, FLandscapeLayer* EditLayer);
@@ -53,6 +53,8 @@
 #include "PackageTools.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "UObject/MetaData.h"
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
 #if ENGINE_MINOR_VERSION > 1
 	#include "MaterialShared.h"
 #endif
@@ -636,49 +638,15 @@ FHoudiniMaterialTranslator::CreateUnrealTexture(
 	const FCreateTexture2DParameters& TextureParameters,
 	const TextureGroup& LODGroup, 
 	const FString& TextureType,
-	const FString& NodePath)
+	const FString& NodePath,
+	bool& bOutTextureUpdated)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMaterialTranslator::CreateUnrealTexture);
+
+	bOutTextureUpdated = false;
 	if (!IsValid(Package))
 		return nullptr;
 
-	UTexture2D * Texture = nullptr;
-	if (ExistingTexture)
-	{
-		Texture = ExistingTexture;
-	}
-	else
-	{
-		// Create new texture object.
-		Texture = NewObject< UTexture2D >(
-			Package, UTexture2D::StaticClass(), *TextureName,
-			RF_Transactional);
-
-		// Assign texture group.
-		Texture->LODGroup = LODGroup;
-	}
-
-	// Add/Update meta information to package.
-	FHoudiniEngineUtils::AddHoudiniMetaInformationToPackage(
-		Package, Texture, HAPI_UNREAL_PACKAGE_META_GENERATED_OBJECT, TEXT("true"));
-	FHoudiniEngineUtils::AddHoudiniMetaInformationToPackage(
-		Package, Texture, HAPI_UNREAL_PACKAGE_META_GENERATED_NAME, *TextureName);
-	FHoudiniEngineUtils::AddHoudiniMetaInformationToPackage(
-		Package, Texture, HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_TYPE, *TextureType);
-	FHoudiniEngineUtils::AddHoudiniMetaInformationToPackage(
-		Package, Texture, HAPI_UNREAL_PACKAGE_META_NODE_PATH, *NodePath);
-
-	// Initialize texture source.
-	Texture->Source.Init(ImageInfo.xRes, ImageInfo.yRes, 1, 1, TSF_BGRA8);
-
-	// Lock the texture.
-	uint8 * MipData = Texture->Source.LockMip(0);
-
-	// Create base map.
-	uint8* DestPtr = nullptr;
-	uint32 SrcWidth = ImageInfo.xRes;
-	uint32 SrcHeight = ImageInfo.yRes;
-	const char * SrcData = &ImageBuffer[0];
-
 	// Handle the different packing for the source Houdini texture
 	uint32 PackOffset = 4;
 	uint32 OffsetR = 0;
@@ -742,45 +710,100 @@ FHoudiniMaterialTranslator::CreateUnrealTexture(
 			break;
 	}
 
-	for (uint32 y = 0; y < SrcHeight; y++)
-	{
-		DestPtr = &MipData[(SrcHeight - 1 - y) * SrcWidth * sizeof(FColor)];
+	const uint32 SrcWidth = ImageInfo.xRes;
+	const uint32 SrcHeight = ImageInfo.yRes;
+	// Hash the image and the parameters that affect the texture's source
+	uint64 ImageHash = CityHash64(ImageBuffer.GetData(), SrcWidth * SrcHeight * PackOffset);
+	const uint32 ImageParameters[] = { SrcWidth, SrcHeight, (uint32)ImageInfo.packing,
+		(uint32)TextureParameters.bUseAlpha, (uint32)TextureParameters.bSRGB, (uint32)TextureParameters.CompressionSettings };
+	ImageHash = CityHash64WithSeed((const char*)ImageParameters, sizeof(ImageParameters), ImageHash);
+	const FString ImageHashString = FString::Printf(TEXT("%016llx"), ImageHash);
 
-		for (uint32 x = 0; x < SrcWidth; x++)
-		{
-			uint32 DataOffset = y * SrcWidth * PackOffset + x * PackOffset;
+	// The existing texture already has this image, no need to update it
+	if (IsValid(ExistingTexture) && ExistingTexture->GetOuter() == Package && IsValid(Package->GetMetaData())
+		&& Package->GetMetaData()->GetValue(ExistingTexture, HAPI_UNREAL_PACKAGE_META_IMAGE_HASH) == ImageHashString
+		&& ExistingTexture->Source.GetSizeX() == SrcWidth && ExistingTexture->Source.GetSizeY() == SrcHeight)
+	{
+		return ExistingTexture;
+	}
 
-			*DestPtr++ = *(uint8*)(SrcData + DataOffset + OffsetB); // B
-			*DestPtr++ = *(uint8*)(SrcData + DataOffset + OffsetG); // G
-			*DestPtr++ = *(uint8*)(SrcData + DataOffset + OffsetR); // R
+	UTexture2D * Texture = nullptr;
+	if (ExistingTexture)
+	{
+		Texture = ExistingTexture;
+	}
+	else
+	{
+		// Create new texture object.
+		Texture = NewObject< UTexture2D >(
+			Package, UTexture2D::StaticClass(), *TextureName,
+			RF_Transactional);
 
-			if (TextureParameters.bUseAlpha && PackOffset == 4)
-				*DestPtr++ = *(uint8*)(SrcData + DataOffset + OffsetA); // A
-			else
-				*DestPtr++ = 0xFF;
-		}
+		// Assign texture group.
+		Texture->LODGroup = LODGroup;
 	}
 
-	bool bHasAlphaValue = false;
-	if (TextureParameters.bUseAlpha)
-	{
-		// See if there is an actual alpha value in the texture or if we can ignore the texture alpha
-		for (uint32 y = 0; y < SrcHeight; y++)
+	// Add/Update meta information to package.
+	FHoudiniEngineUtils::AddHoudiniMetaInformationToPackage(
+		Package, Texture, HAPI_UNREAL_PACKAGE_META_GENERATED_OBJECT, TEXT("true"));
+	FHoudiniEngineUtils::AddHoudiniMetaInformationToPackage(
+		Package, Texture, HAPI_UNREAL_PACKAGE_META_GENERATED_NAME, *TextureName);
+	FHoudiniEngineUtils::AddHoudiniMetaInformationToPackage(
+		Package, Texture, HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_TYPE, *TextureType);
+	FHoudiniEngineUtils::AddHoudiniMetaInformationToPackage(
+		Package, Texture, HAPI_UNREAL_PACKAGE_META_NODE_PATH, *NodePath);
+	FHoudiniEngineUtils::AddHoudiniMetaInformationToPackage(
+		Package, Texture, HAPI_UNREAL_PACKAGE_META_IMAGE_HASH, ImageHashString);
+
+	// Initialize texture source.
+	Texture->Source.Init(SrcWidth, SrcHeight, 1, 1, TSF_BGRA8);
+
+	// Lock the texture.
+	uint8 * MipData = Texture->Source.LockMip(0);
+	const char * SrcData = ImageBuffer.GetData();
+	const bool bCopyAlpha = TextureParameters.bUseAlpha && PackOffset == 4;
+
+	// Convert the pixels to BGRA on worker threads, a few rows per task
+	const int32 RowsPerTask = FMath::Max<int32>(1, 65536 / FMath::Max<uint32>(1, SrcWidth));
+	const int32 NumTasks = FMath::DivideAndRoundUp<int32>(SrcHeight, RowsPerTask);
+	TArray<bool> TaskHasAlpha;
+	TaskHasAlpha.SetNumZeroed(NumTasks);
+	ParallelFor(NumTasks, [&](int32 TaskIndex)
+	{
+		const uint32 StartRow = TaskIndex * RowsPerTask;
+		const uint32 EndRow = FMath::Min<uint32>(StartRow + RowsPerTask, SrcHeight);
+		bool bHasAlpha = false;
+		for (uint32 y = StartRow; y < EndRow; y++)
 		{
+			uint8* DestPtr = &MipData[(SrcHeight - 1 - y) * SrcWidth * sizeof(FColor)];
+			const char* SrcRow = SrcData + y * SrcWidth * PackOffset;
+
 			for (uint32 x = 0; x < SrcWidth; x++)
 			{
-				uint32 DataOffset = y * SrcWidth * 4 + x * 4;
-				if (*(uint8*)(SrcData + DataOffset + 3) != 0xFF)
+				const char* SrcPixel = SrcRow + x * PackOffset;
+
+				*DestPtr++ = *(uint8*)(SrcPixel + OffsetB); // B
+				*DestPtr++ = *(uint8*)(SrcPixel + OffsetG); // G
+				*DestPtr++ = *(uint8*)(SrcPixel + OffsetR); // R
+
+				if (bCopyAlpha)
+				{
+					const uint8 Alpha = *(uint8*)(SrcPixel + OffsetA);
+					bHasAlpha |= (Alpha != 0xFF);
+					*DestPtr++ = Alpha; // A
+				}
+				else
 				{
-					bHasAlphaValue = true;
-					break;
+					*DestPtr++ = 0xFF;
 				}
 			}
-
-			if (bHasAlphaValue)
-				break;
 		}
-	}
+
+		TaskHasAlpha[TaskIndex] = bHasAlpha;
+	});
+
+	// See if there is an actual alpha value in the texture or if we can ignore the texture alpha
+	const bool bHasAlphaValue = TaskHasAlpha.Contains(true);
 
 	// Unlock the texture.
 	Texture->Source.UnlockMip(0);
@@ -799,7 +822,8 @@ FHoudiniMaterialTranslator::CreateUnrealTexture(
 	}
 	*/
 
-	Texture->PostEditChange();
+	// The texture is built (mips, compression) by the caller's PostEditChange, on the texture compiling manager's workers
+	bOutTextureUpdated = true;
 
 	return Texture;
 }
@@ -1161,6 +1185,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentDiffuse(
 				FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 				// Reuse existing diffuse texture, or create new one.
+				bool bTextureDiffuseUpdated = false;
 				TextureDiffuse = FHoudiniMaterialTranslator::CreateUnrealTexture(
 					TextureDiffuse,
 					ImageInfo,
@@ -1170,7 +1195,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentDiffuse(
 					CreateTexture2DParameters,
 					TEXTUREGROUP_World,
 					HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_DIFFUSE,
-					NodePath);
+					NodePath,
+					bTextureDiffuseUpdated);
 
 				//if (BakeMode == EBakeMode::CookToTemp)
 				TextureDiffuse->SetFlags(RF_Public | RF_Standalone);
@@ -1195,9 +1221,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentDiffuse(
 				if (bCreatedNewTextureDiffuse)
 					FAssetRegistryModule::AssetCreated(TextureDiffuse);
 
-				TextureDiffuse->PreEditChange(nullptr);
-				TextureDiffuse->PostEditChange();
-				TextureDiffuse->MarkPackageDirty();
+				if (bTextureDiffuseUpdated)
+				{
+					TextureDiffuse->PreEditChange(nullptr);
+					TextureDiffuse->PostEditChange();
+					TextureDiffuse->MarkPackageDirty();
+				}
 			}
 
 			// Cache the texture package
@@ -1475,6 +1504,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentOpacityMask(
 				FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 				// Reuse existing opacity texture, or create new one.
+				bool bTextureOpacityUpdated = false;
 				TextureOpacity = FHoudiniMaterialTranslator::CreateUnrealTexture(
 					TextureOpacity,
 					ImageInfo,
@@ -1484,7 +1514,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentOpacityMask(
 					CreateTexture2DParameters,
 					TEXTUREGROUP_World,
 					HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_OPACITY_MASK,
-					NodePath);
+					NodePath,
+					bTextureOpacityUpdated);
 
  				// if (BakeMode == EBakeMode::CookToTemp)
 				TextureOpacity->SetFlags(RF_Public | RF_Standalone);
@@ -1528,9 +1559,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentOpacityMask(
 				if (bCreatedNewTextureOpacity)
 					FAssetRegistryModule::AssetCreated(TextureOpacity);
 
-				TextureOpacity->PreEditChange(nullptr);
-				TextureOpacity->PostEditChange();
-				TextureOpacity->MarkPackageDirty();
+				if (bTextureOpacityUpdated)
+				{
+					TextureOpacity->PreEditChange(nullptr);
+					TextureOpacity->PostEditChange();
+					TextureOpacity->MarkPackageDirty();
+				}
 
 				bExpressionCreated = true;
 			}
@@ -1907,6 +1941,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentNormal(
 				FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 				// Reuse existing normal texture, or create new one.
+				bool bTextureNormalUpdated = false;
 				TextureNormal = FHoudiniMaterialTranslator::CreateUnrealTexture(
 					TextureNormal,
 					ImageInfo,
@@ -1916,7 +1951,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentNormal(
 					CreateTexture2DParameters,
 					TEXTUREGROUP_WorldNormalMap,
 					HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_NORMAL,
-					NodePath);
+					NodePath,
+					bTextureNormalUpdated);
 
 				//if (BakeMode == EBakeMode::CookToTemp)
 				TextureNormal->SetFlags(RF_Public | RF_Standalone);
@@ -1951,9 +1987,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentNormal(
 				if (bCreatedNewTextureNormal)
 					FAssetRegistryModule::AssetCreated(TextureNormal);
 
-				TextureNormal->PreEditChange(nullptr);
-				TextureNormal->PostEditChange();
-				TextureNormal->MarkPackageDirty();
+				if (bTextureNormalUpdated)
+				{
+					TextureNormal->PreEditChange(nullptr);
+					TextureNormal->PostEditChange();
+					TextureNormal->MarkPackageDirty();
+				}
 			}
 
 			// Cache the texture package
@@ -2065,6 +2104,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentNormal(
 					FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 					// Reuse existing normal texture, or create new one.
+					bool bTextureNormalUpdated = false;
 					TextureNormal = FHoudiniMaterialTranslator::CreateUnrealTexture(
 						TextureNormal, 
 						ImageInfo,
@@ -2074,7 +2114,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentNormal(
 						CreateTexture2DParameters,
 						TEXTUREGROUP_WorldNormalMap,
 						HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_NORMAL,
-						NodePath);
+						NodePath,
+						bTextureNormalUpdated);
 
 					//if (BakeMode == EBakeMode::CookToTemp)
 					TextureNormal->SetFlags(RF_Public | RF_Standalone);
@@ -2107,9 +2148,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentNormal(
 					if (bCreatedNewTextureNormal)
 						FAssetRegistryModule::AssetCreated(TextureNormal);
 
-					TextureNormal->PreEditChange(nullptr);
-					TextureNormal->PostEditChange();
-					TextureNormal->MarkPackageDirty();
+					if (bTextureNormalUpdated)
+					{
+						TextureNormal->PreEditChange(nullptr);
+						TextureNormal->PostEditChange();
+						TextureNormal->MarkPackageDirty();
+					}
 
 					bExpressionCreated = true;
 				}
@@ -2260,6 +2304,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentSpecular(
 				FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 				// Reuse existing specular texture, or create new one.
+				bool bTextureSpecularUpdated = false;
 				TextureSpecular = FHoudiniMaterialTranslator::CreateUnrealTexture(
 					TextureSpecular,
 					ImageInfo,
@@ -2269,7 +2314,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentSpecular(
 					CreateTexture2DParameters,
 					TEXTUREGROUP_World,
 					HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_SPECULAR,
-					NodePath);
+					NodePath,
+					bTextureSpecularUpdated);
 
 				//if (BakeMode == EBakeMode::CookToTemp)
 				TextureSpecular->SetFlags(RF_Public | RF_Standalone);
@@ -2303,9 +2349,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentSpecular(
 				if (bCreatedNewTextureSpecular)
 					FAssetRegistryModule::AssetCreated(TextureSpecular);
 
-				TextureSpecular->PreEditChange(nullptr);
-				TextureSpecular->PostEditChange();
-				TextureSpecular->MarkPackageDirty();
+				if (bTextureSpecularUpdated)
+				{
+					TextureSpecular->PreEditChange(nullptr);
+					TextureSpecular->PostEditChange();
+					TextureSpecular->MarkPackageDirty();
+				}
 			}
 
 			// Cache the texture package
@@ -2517,6 +2566,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentRoughness(
 				FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 				// Reuse existing roughness texture, or create new one.
+				bool bTextureRoughnessUpdated = false;
 				TextureRoughness = FHoudiniMaterialTranslator::CreateUnrealTexture(
 					TextureRoughness,
 					ImageInfo,
@@ -2526,7 +2576,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentRoughness(
 					CreateTexture2DParameters,
 					TEXTUREGROUP_World,
 					HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_ROUGHNESS,
-					NodePath);
+					NodePath,
+					bTextureRoughnessUpdated);
 
 				//if (BakeMode == EBakeMode::CookToTemp)
 				TextureRoughness->SetFlags(RF_Public | RF_Standalone);
@@ -2558,9 +2609,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentRoughness(
 				if (bCreatedNewTextureRoughness)
 					FAssetRegistryModule::AssetCreated(TextureRoughness);
 
-				TextureRoughness->PreEditChange(nullptr);
-				TextureRoughness->PostEditChange();
-				TextureRoughness->MarkPackageDirty();
+				if (bTextureRoughnessUpdated)
+				{
+					TextureRoughness->PreEditChange(nullptr);
+					TextureRoughness->PostEditChange();
+					TextureRoughness->MarkPackageDirty();
+				}
 			}
 
 			// Cache the texture package
@@ -2777,6 +2831,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentMetallic(
 				FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 				// Reuse existing metallic texture, or create new one.
+				bool bTextureMetallicUpdated = false;
 				TextureMetallic = FHoudiniMaterialTranslator::CreateUnrealTexture(
 					TextureMetallic, 
 					ImageInfo,
@@ -2786,7 +2841,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentMetallic(
 					CreateTexture2DParameters,
 					TEXTUREGROUP_World,
 					HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_METALLIC,
-					NodePath);
+					NodePath,
+					bTextureMetallicUpdated);
 
 				//if (BakeMode == EBakeMode::CookToTemp)
 				TextureMetallic->SetFlags(RF_Public | RF_Standalone);
@@ -2818,9 +2874,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentMetallic(
 				if (bCreatedNewTextureMetallic)
 					FAssetRegistryModule::AssetCreated(TextureMetallic);
 
-				TextureMetallic->PreEditChange(nullptr);
-				TextureMetallic->PostEditChange();
-				TextureMetallic->MarkPackageDirty();
+				if (bTextureMetallicUpdated)
+				{
+					TextureMetallic->PreEditChange(nullptr);
+					TextureMetallic->PostEditChange();
+					TextureMetallic->MarkPackageDirty();
+				}
 			}
 
 			// Cache the texture package
@@ -3142,6 +3201,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentEmissive(
 				FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 				// Reuse existing emissive texture, or create new one.
+				bool bTextureEmissiveUpdated = false;
 				TextureEmissive = FHoudiniMaterialTranslator::CreateUnrealTexture(
 					TextureEmissive,
 					ImageInfo,
@@ -3151,7 +3211,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentEmissive(
 					CreateTexture2DParameters,
 					TEXTUREGROUP_World,
 					HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_EMISSIVE,
-					NodePath);
+					NodePath,
+					bTextureEmissiveUpdated);
 
 				//if (BakeMode == EBakeMode::CookToTemp)
 				TextureEmissive->SetFlags(RF_Public | RF_Standalone);
@@ -3176,9 +3237,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentEmissive(
 				if (bCreatedNewTextureEmissive)
 					FAssetRegistryModule::AssetCreated(TextureEmissive);
 
-				TextureEmissive->PreEditChange(nullptr);
-				TextureEmissive->PostEditChange();
-				TextureEmissive->MarkPackageDirty();
+				if (bTextureEmissiveUpdated)
+				{
+					TextureEmissive->PreEditChange(nullptr);
+					TextureEmissive->PostEditChange();
+					TextureEmissive->MarkPackageDirty();
+				}
 			}
 
 			// Cache the texture package
@@ -117,6 +117,8 @@ public:
 
 
 	// Create a texture from given information.
+	// The pixels are converted on worker threads, and an existing texture whose image hash matches the image
+	// is left untouched: bOutTextureUpdated is then false and the texture doesn't need to be rebuilt.
 	static UTexture2D* CreateUnrealTexture(
 		UTexture2D* ExistingTexture,
 		const HAPI_ImageInfo& ImageInfo,
@@ -126,7 +128,8 @@ public:
 		const FCreateTexture2DParameters& TextureParameters,
 		const TextureGroup& LODGroup,
 		const FString& TextureType,
-		const FString& NodePath);
+		const FString& NodePath,
+		bool& bOutTextureUpdated);
 
 	// HAPI : Retrieve a list of image planes.
 	static bool HapiExtractImage(
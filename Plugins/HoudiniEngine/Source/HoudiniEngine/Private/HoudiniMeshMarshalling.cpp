@@ -0,0 +1,627 @@
+/*
+* Copyright (c) <2021> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniMeshMarshalling.h"
+
+#include "HoudiniEnginePrivatePCH.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "MeshDescription.h"
+#include "Rendering/ColorVertexBuffer.h"
+#include "StaticMeshAttributes.h"
+#include "StaticMeshOperations.h"
+#include "StaticMeshResources.h"
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineParallelMeshMarshalling(
+	TEXT("HoudiniEngine.ParallelMeshMarshalling"),
+	1,
+	TEXT("When enabled, the buffers of the meshes sent to Houdini are filled on multiple threads,\n")
+	TEXT("while the previous attribute is being uploaded.\n")
+	TEXT("0: Fill each attribute buffer on the game thread, then upload it\n")
+	TEXT("1: Fill the next attribute buffer on the task graph while the current one is uploaded (default)\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineMeshMarshallingPoolSize(
+	TEXT("HoudiniEngine.MeshMarshallingPoolSize"),
+	512,
+	TEXT("Maximum size, in MB, of the staging buffers kept for the next mesh sent to Houdini.\n")
+	TEXT("Buffers used for larger meshes are freed after the upload.\n")
+);
+
+// Number of elements processed by one task when filling mesh buffers in parallel
+#define HOUDINI_MESH_MARSHALLING_CHUNK_SIZE 16384
+
+// Maximum number of pooled staging buffers
+#define HOUDINI_MESH_MARSHALLING_POOL_COUNT 4
+
+static FCriticalSection HoudiniMeshMarshallingPoolLock;
+static TArray<TUniquePtr<FHoudiniMeshMarshallingBuffers>> HoudiniMeshMarshallingPool;
+
+// Calls InBody(Index) for every index in [0, InNum), split in chunks over the task graph when bInParallel is set.
+// InBody must only write the data owned by its index, so the result does not depend on the chunking.
+template<typename TBody>
+static void
+HoudiniMeshMarshallingParallelFor(const int32 InNum, const bool bInParallel, const TBody& InBody)
+{
+	const int32 NumChunks = FMath::DivideAndRoundUp(InNum, HOUDINI_MESH_MARSHALLING_CHUNK_SIZE);
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		const int32 Start = ChunkIndex * HOUDINI_MESH_MARSHALLING_CHUNK_SIZE;
+		const int32 End = FMath::Min(Start + HOUDINI_MESH_MARSHALLING_CHUNK_SIZE, InNum);
+		for (int32 Index = Start; Index < End; Index++)
+			InBody(Index);
+	}, !bInParallel || NumChunks < 2);
+}
+
+// Sets the number of elements of a staging buffer, without releasing its allocation
+template<typename T>
+static void
+SetStagingBufferNum(TArray<T>& OutBuffer, const int32 InNum)
+{
+	OutBuffer.Reset(InNum);
+	OutBuffer.SetNumUninitialized(InNum);
+}
+
+// Fills 3 floats per Houdini vertex from a per source vertex instance vector, swapping Y and Z for Houdini.
+template<typename TGetter>
+static void
+FillVertexVectors(const TArray<int32>& InVertexSources, const bool bInParallel, TArray<float>& OutValues, const TGetter& InGetter)
+{
+	SetStagingBufferNum(OutValues, InVertexSources.Num() * 3);
+	float* Values = OutValues.GetData();
+	HoudiniMeshMarshallingParallelFor(InVertexSources.Num(), bInParallel, [&](int32 VertexIdx)
+	{
+		const FVector3f Vector = InGetter(InVertexSources[VertexIdx]);
+		Values[VertexIdx * 3 + 0] = Vector.X;
+		Values[VertexIdx * 3 + 1] = Vector.Z;
+		Values[VertexIdx * 3 + 2] = Vector.Y;
+	});
+}
+
+// Fills 3 floats per Houdini vertex from a per source vertex instance UV, flipping V for Houdini.
+template<typename TGetter>
+static void
+FillVertexUVs(const TArray<int32>& InVertexSources, const bool bInParallel, TArray<float>& OutValues, const TGetter& InGetter)
+{
+	SetStagingBufferNum(OutValues, InVertexSources.Num() * 3);
+	float* Values = OutValues.GetData();
+	HoudiniMeshMarshallingParallelFor(InVertexSources.Num(), bInParallel, [&](int32 VertexIdx)
+	{
+		const FVector2f UV = InGetter(InVertexSources[VertexIdx]);
+		Values[VertexIdx * 3 + 0] = UV.X;
+		Values[VertexIdx * 3 + 1] = 1.0f - UV.Y;
+		Values[VertexIdx * 3 + 2] = 0.0f;
+	});
+}
+
+// Fills the RGB colors and alphas of each Houdini vertex from a per source vertex instance color.
+template<typename TGetter>
+static void
+FillVertexColors(const TArray<int32>& InVertexSources, const bool bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers, const TGetter& InGetter)
+{
+	SetStagingBufferNum(OutBuffers.RGBColors, InVertexSources.Num() * 3);
+	SetStagingBufferNum(OutBuffers.Alphas, InVertexSources.Num());
+	float* RGBColors = OutBuffers.RGBColors.GetData();
+	float* Alphas = OutBuffers.Alphas.GetData();
+	HoudiniMeshMarshallingParallelFor(InVertexSources.Num(), bInParallel, [&](int32 VertexIdx)
+	{
+		const FLinearColor Color = InGetter(InVertexSources[VertexIdx]);
+		RGBColors[VertexIdx * 3 + 0] = Color.R;
+		RGBColors[VertexIdx * 3 + 1] = Color.G;
+		RGBColors[VertexIdx * 3 + 2] = Color.B;
+		Alphas[VertexIdx] = Color.A;
+	});
+}
+
+// Converts the positions of the Houdini points to Houdini's space.
+template<typename TGetter>
+static void
+FillPointPositions(const FVector3f& InBuildScale, const bool bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers, const TGetter& InGetter)
+{
+	SetStagingBufferNum(OutBuffers.Positions, OutBuffers.PointSources.Num() * 3);
+	float* Positions = OutBuffers.Positions.GetData();
+	const int32* PointSources = OutBuffers.PointSources.GetData();
+	HoudiniMeshMarshallingParallelFor(OutBuffers.PointSources.Num(), bInParallel, [&](int32 PointIdx)
+	{
+		const FVector3f Position = InGetter(PointSources[PointIdx]);
+		Positions[PointIdx * 3 + 0] = Position.X / HAPI_UNREAL_SCALE_FACTOR_POSITION * InBuildScale.X;
+		Positions[PointIdx * 3 + 1] = Position.Z / HAPI_UNREAL_SCALE_FACTOR_POSITION * InBuildScale.Z;
+		Positions[PointIdx * 3 + 2] = Position.Y / HAPI_UNREAL_SCALE_FACTOR_POSITION * InBuildScale.Y;
+	});
+}
+
+void
+FHoudiniMeshMarshallingBuffers::Reset()
+{
+	PointSources.Reset();
+	PointIndices.Reset();
+	VertexSources.Reset();
+	VertexList.Reset();
+	FaceCounts.Reset();
+	FaceMaterialIndices.Reset();
+	FaceSmoothingMasks.Reset();
+	Positions.Reset();
+	Normals.Reset();
+	Tangents.Reset();
+	Binormals.Reset();
+	RGBColors.Reset();
+	Alphas.Reset();
+	for (TArray<float>& UVLayer : UVs)
+		UVLayer.Reset();
+}
+
+SIZE_T
+FHoudiniMeshMarshallingBuffers::GetAllocatedSize() const
+{
+	SIZE_T Size = PointSources.GetAllocatedSize() + PointIndices.GetAllocatedSize() + VertexSources.GetAllocatedSize()
+		+ VertexList.GetAllocatedSize() + FaceCounts.GetAllocatedSize() + FaceMaterialIndices.GetAllocatedSize()
+		+ FaceSmoothingMasks.GetAllocatedSize() + Positions.GetAllocatedSize() + Normals.GetAllocatedSize()
+		+ Tangents.GetAllocatedSize() + Binormals.GetAllocatedSize() + RGBColors.GetAllocatedSize()
+		+ Alphas.GetAllocatedSize() + UVs.GetAllocatedSize();
+
+	for (const TArray<float>& UVLayer : UVs)
+		Size += UVLayer.GetAllocatedSize();
+
+	return Size;
+}
+
+bool
+FHoudiniMeshMarshalling::IsParallel()
+{
+	return CVarHoudiniEngineParallelMeshMarshalling.GetValueOnAnyThread() != 0;
+}
+
+TUniquePtr<FHoudiniMeshMarshallingBuffers>
+FHoudiniMeshMarshalling::AcquireBuffers()
+{
+	{
+		FScopeLock ScopeLock(&HoudiniMeshMarshallingPoolLock);
+		if (HoudiniMeshMarshallingPool.Num() > 0)
+			return HoudiniMeshMarshallingPool.Pop(false);
+	}
+
+	return MakeUnique<FHoudiniMeshMarshallingBuffers>();
+}
+
+void
+FHoudiniMeshMarshalling::ReleaseBuffers(TUniquePtr<FHoudiniMeshMarshallingBuffers> InBuffers)
+{
+	if (!InBuffers.IsValid())
+		return;
+
+	// Don't hold on to the memory used by a very large mesh
+	const SIZE_T MaxPoolSize = (SIZE_T)FMath::Max(CVarHoudiniEngineMeshMarshallingPoolSize.GetValueOnAnyThread(), 0) * 1024 * 1024;
+	if (InBuffers->GetAllocatedSize() > MaxPoolSize)
+		return;
+
+	InBuffers->Reset();
+
+	FScopeLock ScopeLock(&HoudiniMeshMarshallingPoolLock);
+	if (HoudiniMeshMarshallingPool.Num() < HOUDINI_MESH_MARSHALLING_POOL_COUNT)
+		HoudiniMeshMarshallingPool.Add(MoveTemp(InBuffers));
+}
+
+void
+FHoudiniMeshMarshalling::EmptyBufferPool()
+{
+	FScopeLock ScopeLock(&HoudiniMeshMarshallingPoolLock);
+	HoudiniMeshMarshallingPool.Empty();
+}
+
+int32
+FHoudiniMeshMarshalling::GetNumPooledBuffers()
+{
+	FScopeLock ScopeLock(&HoudiniMeshMarshallingPoolLock);
+	return HoudiniMeshMarshallingPool.Num();
+}
+
+bool
+FHoudiniMeshMarshalling::RunUploads(TArray<FHoudiniMeshAttributeUpload>& InUploads, const bool& bInParallel)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::RunUploads);
+
+	// Fills are only started once the previous one is done, so they can depend on each other
+	auto StartFill = [&InUploads, bInParallel](const int32 InIndex)
+	{
+		if (!bInParallel || !InUploads.IsValidIndex(InIndex) || !InUploads[InIndex].Fill)
+			return TFuture<void>();
+
+		return Async(EAsyncExecution::TaskGraph, [&InUploads, InIndex]() { InUploads[InIndex].Fill(); });
+	};
+
+	TFuture<void> PendingFill = StartFill(0);
+	for (int32 Index = 0; Index < InUploads.Num(); Index++)
+	{
+		FHoudiniMeshAttributeUpload& CurrentUpload = InUploads[Index];
+		if (PendingFill.IsValid())
+			PendingFill.Wait();
+		else if (!bInParallel && CurrentUpload.Fill)
+			CurrentUpload.Fill();
+
+		// Build the next buffer while this one is sent to Houdini
+		PendingFill = StartFill(Index + 1);
+
+		if (CurrentUpload.Upload && !CurrentUpload.Upload())
+		{
+			// The pending fill may still be writing to the caller's buffers
+			if (PendingFill.IsValid())
+				PendingFill.Wait();
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void
+FHoudiniMeshMarshalling::FillMeshDescriptionPoints(
+	const FMeshDescription& InMeshDescription, const FVector3f& InBuildScale, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillMeshDescriptionPoints);
+
+	FStaticMeshConstAttributes MeshDescriptionAttributes(InMeshDescription);
+	TVertexAttributesConstRef<FVector3f> VertexPositions = MeshDescriptionAttributes.GetVertexPositions();
+
+	// The mesh element arrays are sparse: the max index/ID value can be larger than the number of elements - 1
+	// so we have to maintain a lookup of VertexID (UE) to PointIndex (Houdini)
+	const FVertexArray& Vertices = InMeshDescription.Vertices();
+	SetStagingBufferNum(OutBuffers.PointIndices, Vertices.GetArraySize());
+	for (int32& PointIndex : OutBuffers.PointIndices)
+		PointIndex = INDEX_NONE;
+
+	OutBuffers.PointSources.Reset(Vertices.Num());
+	for (const FVertexID VertexID : Vertices.GetElementIDs())
+		OutBuffers.PointIndices[VertexID.GetValue()] = OutBuffers.PointSources.Add(VertexID.GetValue());
+
+	FillPointPositions(InBuildScale, bInParallel, OutBuffers, [&](int32 VertexID)
+	{
+		return VertexPositions.Get(FVertexID(VertexID));
+	});
+}
+
+void
+FHoudiniMeshMarshalling::FillMeshDescriptionTopology(
+	const FMeshDescription& InMeshDescription, const TMap<FPolygonGroupID, int32>& InPolygonGroupToMaterialIndex,
+	const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillMeshDescriptionTopology);
+
+	// Find where each polygon's triangles start, so the polygons can be processed independently
+	const FPolygonArray& Polygons = InMeshDescription.Polygons();
+	TArray<FPolygonID> PolygonIDs;
+	TArray<int32> PolygonFirstTriangles;
+	PolygonIDs.Reserve(Polygons.Num());
+	PolygonFirstTriangles.Reserve(Polygons.Num());
+
+	int32 NumTriangles = 0;
+	for (const FPolygonID PolygonID : Polygons.GetElementIDs())
+	{
+		PolygonIDs.Add(PolygonID);
+		PolygonFirstTriangles.Add(NumTriangles);
+		NumTriangles += InMeshDescription.GetPolygonTriangles(PolygonID).Num();
+	}
+
+	SetStagingBufferNum(OutBuffers.VertexSources, NumTriangles * 3);
+	SetStagingBufferNum(OutBuffers.VertexList, NumTriangles * 3);
+	SetStagingBufferNum(OutBuffers.FaceCounts, NumTriangles);
+	SetStagingBufferNum(OutBuffers.FaceMaterialIndices, NumTriangles);
+
+	HoudiniMeshMarshallingParallelFor(PolygonIDs.Num(), bInParallel, [&](int32 PolygonIdx)
+	{
+		const FPolygonID PolygonID = PolygonIDs[PolygonIdx];
+		const int32 MaterialIndex = InPolygonGroupToMaterialIndex.FindChecked(InMeshDescription.GetPolygonPolygonGroup(PolygonID));
+
+		int32 TriangleIdx = PolygonFirstTriangles[PolygonIdx];
+		for (const FTriangleID TriangleID : InMeshDescription.GetPolygonTriangles(PolygonID))
+		{
+			OutBuffers.FaceCounts[TriangleIdx] = 3;
+			OutBuffers.FaceMaterialIndices[TriangleIdx] = MaterialIndex;
+
+			for (int32 TriangleVertexIndex = 0; TriangleVertexIndex < 3; ++TriangleVertexIndex)
+			{
+				// Reverse the winding order for Houdini (but still start at 0)
+				const int32 WindingIdx = (3 - TriangleVertexIndex) % 3;
+				const FVertexInstanceID VertexInstanceID = InMeshDescription.GetTriangleVertexInstance(TriangleID, WindingIdx);
+				const int32 VertexIdx = TriangleIdx * 3 + TriangleVertexIndex;
+
+				const int32 UEVertexIdx = InMeshDescription.GetVertexInstanceVertex(VertexInstanceID).GetValue();
+				OutBuffers.VertexSources[VertexIdx] = VertexInstanceID.GetValue();
+				OutBuffers.VertexList[VertexIdx] = OutBuffers.PointIndices.IsValidIndex(UEVertexIdx) ? OutBuffers.PointIndices[UEVertexIdx] : 0;
+			}
+
+			TriangleIdx++;
+		}
+	});
+}
+
+void
+FHoudiniMeshMarshalling::FillMeshDescriptionNormals(const FMeshDescription& InMeshDescription, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillMeshDescriptionNormals);
+
+	FStaticMeshConstAttributes MeshDescriptionAttributes(InMeshDescription);
+	TVertexInstanceAttributesConstRef<FVector3f> VertexInstanceNormals = MeshDescriptionAttributes.GetVertexInstanceNormals();
+	FillVertexVectors(OutBuffers.VertexSources, bInParallel, OutBuffers.Normals, [&](int32 VertexInstanceID)
+	{
+		return VertexInstanceNormals.Get(FVertexInstanceID(VertexInstanceID));
+	});
+}
+
+void
+FHoudiniMeshMarshalling::FillMeshDescriptionTangents(const FMeshDescription& InMeshDescription, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillMeshDescriptionTangents);
+
+	FStaticMeshConstAttributes MeshDescriptionAttributes(InMeshDescription);
+	TVertexInstanceAttributesConstRef<FVector3f> VertexInstanceTangents = MeshDescriptionAttributes.GetVertexInstanceTangents();
+	FillVertexVectors(OutBuffers.VertexSources, bInParallel, OutBuffers.Tangents, [&](int32 VertexInstanceID)
+	{
+		return VertexInstanceTangents.Get(FVertexInstanceID(VertexInstanceID));
+	});
+}
+
+void
+FHoudiniMeshMarshalling::FillMeshDescriptionBinormals(const FMeshDescription& InMeshDescription, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillMeshDescriptionBinormals);
+
+	FStaticMeshConstAttributes MeshDescriptionAttributes(InMeshDescription);
+	TVertexInstanceAttributesConstRef<FVector3f> VertexInstanceNormals = MeshDescriptionAttributes.GetVertexInstanceNormals();
+	TVertexInstanceAttributesConstRef<FVector3f> VertexInstanceTangents = MeshDescriptionAttributes.GetVertexInstanceTangents();
+	TVertexInstanceAttributesConstRef<float> VertexInstanceBinormalSigns = MeshDescriptionAttributes.GetVertexInstanceBinormalSigns();
+	const bool bCanComputeBinormals = VertexInstanceNormals.IsValid() && VertexInstanceTangents.IsValid() && VertexInstanceBinormalSigns.IsValid();
+
+	const TArray<int32>& VertexSources = OutBuffers.VertexSources;
+	SetStagingBufferNum(OutBuffers.Binormals, VertexSources.Num() * 3);
+	float* Binormals = OutBuffers.Binormals.GetData();
+	HoudiniMeshMarshallingParallelFor(VertexSources.Num(), bInParallel, [&](int32 VertexIdx)
+	{
+		if (!bCanComputeBinormals)
+		{
+			Binormals[VertexIdx * 3 + 0] = 0.0f;
+			Binormals[VertexIdx * 3 + 1] = 0.0f;
+			Binormals[VertexIdx * 3 + 2] = 0.0f;
+			return;
+		}
+
+		// The binormal is computed from the tangent and normal, once they are converted to Houdini's space
+		const FVertexInstanceID VertexInstanceID(VertexSources[VertexIdx]);
+		const FVector3f& Tangent = VertexInstanceTangents.Get(VertexInstanceID);
+		const FVector3f& Normal = VertexInstanceNormals.Get(VertexInstanceID);
+		const FVector Binormal = FVector::CrossProduct(
+			FVector(Tangent.X, Tangent.Z, Tangent.Y),
+			FVector(Normal.X, Normal.Z, Normal.Y)) * VertexInstanceBinormalSigns.Get(VertexInstanceID);
+
+		Binormals[VertexIdx * 3 + 0] = (float)Binormal.X;
+		Binormals[VertexIdx * 3 + 1] = (float)Binormal.Y;
+		Binormals[VertexIdx * 3 + 2] = (float)Binormal.Z;
+	});
+}
+
+void
+FHoudiniMeshMarshalling::FillMeshDescriptionUVs(const FMeshDescription& InMeshDescription, const int32& InUVLayer, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillMeshDescriptionUVs);
+
+	if (!ensure(OutBuffers.UVs.IsValidIndex(InUVLayer)))
+		return;
+
+	FStaticMeshConstAttributes MeshDescriptionAttributes(InMeshDescription);
+	TVertexInstanceAttributesConstRef<FVector2f> VertexInstanceUVs = MeshDescriptionAttributes.GetVertexInstanceUVs();
+	FillVertexUVs(OutBuffers.VertexSources, bInParallel, OutBuffers.UVs[InUVLayer], [&](int32 VertexInstanceID)
+	{
+		return VertexInstanceUVs.Get(FVertexInstanceID(VertexInstanceID), InUVLayer);
+	});
+}
+
+void
+FHoudiniMeshMarshalling::FillMeshDescriptionColors(
+	const FMeshDescription& InMeshDescription, const FColorVertexBuffer* InOverrideColors, const TArray<int32>* InWedgeMap,
+	const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillMeshDescriptionColors);
+
+	if (InOverrideColors && InWedgeMap)
+	{
+		FillVertexColors(OutBuffers.VertexSources, bInParallel, OutBuffers, [&](int32 VertexInstanceID)
+		{
+			const int32 Index = InWedgeMap->IsValidIndex(VertexInstanceID) ? (*InWedgeMap)[VertexInstanceID] : INDEX_NONE;
+			return Index != INDEX_NONE ? InOverrideColors->VertexColor(Index).ReinterpretAsLinear() : FLinearColor::White;
+		});
+	}
+	else
+	{
+		FStaticMeshConstAttributes MeshDescriptionAttributes(InMeshDescription);
+		TVertexInstanceAttributesConstRef<FVector4f> VertexInstanceColors = MeshDescriptionAttributes.GetVertexInstanceColors();
+		FillVertexColors(OutBuffers.VertexSources, bInParallel, OutBuffers, [&](int32 VertexInstanceID)
+		{
+			const FVector4f Color = VertexInstanceColors.Get(FVertexInstanceID(VertexInstanceID));
+			return FLinearColor(Color.X, Color.Y, Color.Z, Color.W);
+		});
+	}
+}
+
+void
+FHoudiniMeshMarshalling::FillMeshDescriptionSmoothingMasks(const FMeshDescription& InMeshDescription, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillMeshDescriptionSmoothingMasks);
+
+	TArray<uint32> UnsignedSmoothingMasks;
+	UnsignedSmoothingMasks.SetNumZeroed(InMeshDescription.Triangles().Num());
+	FStaticMeshOperations::ConvertHardEdgesToSmoothGroup(InMeshDescription, UnsignedSmoothingMasks);
+
+	// Convert uint32 smoothing mask to int
+	SetStagingBufferNum(OutBuffers.FaceSmoothingMasks, UnsignedSmoothingMasks.Num());
+	for (int32 Index = 0; Index < UnsignedSmoothingMasks.Num(); Index++)
+		OutBuffers.FaceSmoothingMasks[Index] = (int32)UnsignedSmoothingMasks[Index];
+}
+
+void
+FHoudiniMeshMarshalling::FillLODResourcesPoints(
+	const FStaticMeshLODResources& InLODResources, const FVector3f& InBuildScale, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillLODResourcesPoints);
+
+	// Vertices sharing a position share a point. The point order depends on the order of insertion,
+	// so this part can't be done in parallel.
+	const FPositionVertexBuffer& PositionVertexBuffer = InLODResources.VertexBuffers.PositionVertexBuffer;
+	const int32 NumVertexInstances = InLODResources.VertexBuffers.StaticMeshVertexBuffer.GetNumVertices();
+
+	TMap<FVector3f, int32> PositionToPointIndexMap;
+	PositionToPointIndexMap.Reserve(NumVertexInstances);
+
+	SetStagingBufferNum(OutBuffers.PointIndices, NumVertexInstances);
+	OutBuffers.PointSources.Reset();
+	for (int32 VertexInstanceIndex = 0; VertexInstanceIndex < NumVertexInstances; ++VertexInstanceIndex)
+	{
+		const FVector3f& PositionVector = PositionVertexBuffer.VertexPosition(VertexInstanceIndex);
+		const int32* FoundPointIndexPtr = PositionToPointIndexMap.Find(PositionVector);
+		if (!FoundPointIndexPtr)
+		{
+			const int32 NewPointIndex = OutBuffers.PointSources.Add(VertexInstanceIndex);
+			PositionToPointIndexMap.Add(PositionVector, NewPointIndex);
+			OutBuffers.PointIndices[VertexInstanceIndex] = NewPointIndex;
+		}
+		else
+		{
+			OutBuffers.PointIndices[VertexInstanceIndex] = *FoundPointIndexPtr;
+		}
+	}
+
+	FillPointPositions(InBuildScale, false, OutBuffers, [&](int32 VertexInstanceIndex)
+	{
+		return PositionVertexBuffer.VertexPosition(VertexInstanceIndex);
+	});
+}
+
+void
+FHoudiniMeshMarshalling::FillLODResourcesTopology(
+	const FStaticMeshLODResources& InLODResources, const TArray<int32>& InSectionMaterialIndices,
+	const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillLODResourcesTopology);
+
+	int32 NumTriangles = 0;
+	for (const FStaticMeshSection& Section : InLODResources.Sections)
+		NumTriangles += Section.NumTriangles;
+
+	SetStagingBufferNum(OutBuffers.VertexSources, NumTriangles * 3);
+	SetStagingBufferNum(OutBuffers.VertexList, NumTriangles * 3);
+	SetStagingBufferNum(OutBuffers.FaceCounts, NumTriangles);
+	SetStagingBufferNum(OutBuffers.FaceMaterialIndices, NumTriangles);
+
+	const FIndexArrayView TriangleVertexIndices = InLODResources.IndexBuffer.GetArrayView();
+	int32 SectionFirstTriangle = 0;
+	for (int32 SectionIndex = 0; SectionIndex < InLODResources.Sections.Num(); ++SectionIndex)
+	{
+		const FStaticMeshSection& Section = InLODResources.Sections[SectionIndex];
+		const int32 MaterialIndex = InSectionMaterialIndices.IsValidIndex(SectionIndex) ? InSectionMaterialIndices[SectionIndex] : Section.MaterialIndex;
+
+		HoudiniMeshMarshallingParallelFor(Section.NumTriangles, bInParallel, [&](int32 SectionTriangleIndex)
+		{
+			const int32 TriangleIdx = SectionFirstTriangle + SectionTriangleIndex;
+			OutBuffers.FaceCounts[TriangleIdx] = 3;
+			OutBuffers.FaceMaterialIndices[TriangleIdx] = MaterialIndex;
+
+			for (int32 TriangleVertexIndex = 0; TriangleVertexIndex < 3; ++TriangleVertexIndex)
+			{
+				// Reverse the winding order for Houdini (but still start at 0)
+				const int32 WindingIdx = (3 - TriangleVertexIndex) % 3;
+				const int32 UEVertexIndex = (int32)TriangleVertexIndices[Section.FirstIndex + SectionTriangleIndex * 3 + WindingIdx];
+				const int32 VertexIdx = TriangleIdx * 3 + TriangleVertexIndex;
+
+				OutBuffers.VertexSources[VertexIdx] = UEVertexIndex;
+				OutBuffers.VertexList[VertexIdx] = OutBuffers.PointIndices.IsValidIndex(UEVertexIndex) ? OutBuffers.PointIndices[UEVertexIndex] : 0;
+			}
+		});
+
+		SectionFirstTriangle += Section.NumTriangles;
+	}
+}
+
+void
+FHoudiniMeshMarshalling::FillLODResourcesNormals(const FStaticMeshLODResources& InLODResources, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillLODResourcesNormals);
+
+	const FStaticMeshVertexBuffer& StaticMeshVertexBuffer = InLODResources.VertexBuffers.StaticMeshVertexBuffer;
+	FillVertexVectors(OutBuffers.VertexSources, bInParallel, OutBuffers.Normals, [&](int32 VertexIndex)
+	{
+		return FVector3f(StaticMeshVertexBuffer.VertexTangentZ(VertexIndex));
+	});
+}
+
+void
+FHoudiniMeshMarshalling::FillLODResourcesTangents(const FStaticMeshLODResources& InLODResources, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillLODResourcesTangents);
+
+	const FStaticMeshVertexBuffer& StaticMeshVertexBuffer = InLODResources.VertexBuffers.StaticMeshVertexBuffer;
+	FillVertexVectors(OutBuffers.VertexSources, bInParallel, OutBuffers.Tangents, [&](int32 VertexIndex)
+	{
+		return FVector3f(StaticMeshVertexBuffer.VertexTangentX(VertexIndex));
+	});
+}
+
+void
+FHoudiniMeshMarshalling::FillLODResourcesBinormals(const FStaticMeshLODResources& InLODResources, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillLODResourcesBinormals);
+
+	const FStaticMeshVertexBuffer& StaticMeshVertexBuffer = InLODResources.VertexBuffers.StaticMeshVertexBuffer;
+	FillVertexVectors(OutBuffers.VertexSources, bInParallel, OutBuffers.Binormals, [&](int32 VertexIndex)
+	{
+		return FVector3f(StaticMeshVertexBuffer.VertexTangentY(VertexIndex));
+	});
+}
+
+void
+FHoudiniMeshMarshalling::FillLODResourcesUVs(const FStaticMeshLODResources& InLODResources, const int32& InUVLayer, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillLODResourcesUVs);
+
+	if (!ensure(OutBuffers.UVs.IsValidIndex(InUVLayer)))
+		return;
+
+	const FStaticMeshVertexBuffer& StaticMeshVertexBuffer = InLODResources.VertexBuffers.StaticMeshVertexBuffer;
+	FillVertexUVs(OutBuffers.VertexSources, bInParallel, OutBuffers.UVs[InUVLayer], [&](int32 VertexIndex)
+	{
+		return StaticMeshVertexBuffer.GetVertexUV(VertexIndex, InUVLayer);
+	});
+}
+
+void
+FHoudiniMeshMarshalling::FillLODResourcesColors(const FColorVertexBuffer& InColors, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshMarshalling::FillLODResourcesColors);
+
+	FillVertexColors(OutBuffers.VertexSources, bInParallel, OutBuffers, [&](int32 VertexIndex)
+	{
+		return InColors.VertexColor(VertexIndex).ReinterpretAsLinear();
+	});
+}
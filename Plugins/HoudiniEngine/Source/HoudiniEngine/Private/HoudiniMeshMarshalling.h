@@ -0,0 +1,166 @@
+/*
+* Copyright (c) <2021> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MeshTypes.h"
+
+struct FMeshDescription;
+struct FStaticMeshLODResources;
+class FColorVertexBuffer;
+
+// Staging buffers for the geometry of a mesh sent to Houdini.
+// Buffers are pooled and reused between meshes, so sending large meshes does not reallocate them every time.
+struct HOUDINIENGINE_API FHoudiniMeshMarshallingBuffers
+{
+	// Source vertex index of each Houdini point
+	TArray<int32> PointSources;
+	// Houdini point index of each source vertex, INDEX_NONE for unused indices
+	TArray<int32> PointIndices;
+	// Source vertex instance index of each Houdini vertex, in Houdini winding order
+	TArray<int32> VertexSources;
+
+	// Houdini point index of each Houdini vertex
+	TArray<int32> VertexList;
+	TArray<int32> FaceCounts;
+	TArray<int32> FaceMaterialIndices;
+	TArray<int32> FaceSmoothingMasks;
+
+	// Point positions, 3 floats per point
+	TArray<float> Positions;
+	// Vertex attributes, 3 floats per vertex (1 for alphas)
+	TArray<float> Normals;
+	TArray<float> Tangents;
+	TArray<float> Binormals;
+	TArray<float> RGBColors;
+	TArray<float> Alphas;
+	TArray<TArray<float>> UVs;
+
+	// Empties the buffers but keeps their allocations.
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const;
+};
+
+// One attribute sent to Houdini: Fill builds its buffer, Upload sends it to the session.
+struct FHoudiniMeshAttributeUpload
+{
+	// Optional. Fills only run one at a time and in order, so a fill can read the buffers of the
+	// previous ones. It must not resize containers read by the uploads (ie, the UVs array itself).
+	TFunction<void()> Fill;
+
+	// Always called on the thread running the uploads.
+	TFunction<bool()> Upload;
+};
+
+struct HOUDINIENGINE_API FHoudiniMeshMarshalling
+{
+	// Returns true if the mesh buffers should be built on multiple threads (HoudiniEngine.ParallelMeshMarshalling).
+	static bool IsParallel();
+
+	// Gets staging buffers from the pool, they must be given back with ReleaseBuffers.
+	static TUniquePtr<FHoudiniMeshMarshallingBuffers> AcquireBuffers();
+
+	// Returns buffers to the pool. Buffers larger than HoudiniEngine.MeshMarshallingPoolSize are freed.
+	static void ReleaseBuffers(TUniquePtr<FHoudiniMeshMarshallingBuffers> InBuffers);
+
+	// Frees all the pooled buffers.
+	static void EmptyBufferPool();
+
+	static int32 GetNumPooledBuffers();
+
+	// Runs the fills and uploads in order, the uploads on the calling thread.
+	// When bInParallel is set, the buffer for the next upload is filled on the task graph while the current one is sent.
+	static bool RunUploads(TArray<FHoudiniMeshAttributeUpload>& InUploads, const bool& bInParallel);
+
+	//
+	// Mesh description: one point per vertex, vertices in polygon and triangle order with a reversed winding.
+	//
+
+	// Fills PointSources, PointIndices and Positions (converted to Houdini's space and scaled by InBuildScale).
+	static void FillMeshDescriptionPoints(
+		const FMeshDescription& InMeshDescription, const FVector3f& InBuildScale, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers);
+
+	// Fills VertexSources, VertexList, FaceCounts and FaceMaterialIndices. Requires PointIndices.
+	static void FillMeshDescriptionTopology(
+		const FMeshDescription& InMeshDescription, const TMap<FPolygonGroupID, int32>& InPolygonGroupToMaterialIndex,
+		const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers);
+
+	// Vertex attribute fills, require VertexSources.
+	static void FillMeshDescriptionNormals(const FMeshDescription& InMeshDescription, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers);
+	static void FillMeshDescriptionTangents(const FMeshDescription& InMeshDescription, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers);
+	static void FillMeshDescriptionBinormals(const FMeshDescription& InMeshDescription, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers);
+	static void FillMeshDescriptionUVs(const FMeshDescription& InMeshDescription, const int32& InUVLayer, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers);
+
+	// Uses the override colors when InOverrideColors and InWedgeMap (vertex instance to override color index) are set.
+	static void FillMeshDescriptionColors(
+		const FMeshDescription& InMeshDescription, const FColorVertexBuffer* InOverrideColors, const TArray<int32>* InWedgeMap,
+		const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers);
+
+	// Fills FaceSmoothingMasks from the hard edges.
+	static void FillMeshDescriptionSmoothingMasks(const FMeshDescription& InMeshDescription, FHoudiniMeshMarshallingBuffers& OutBuffers);
+
+	//
+	// LOD resources: every entry of the vertex buffers is a vertex instance, points are shared by position.
+	//
+
+	// Fills PointSources, PointIndices and Positions.
+	static void FillLODResourcesPoints(
+		const FStaticMeshLODResources& InLODResources, const FVector3f& InBuildScale, FHoudiniMeshMarshallingBuffers& OutBuffers);
+
+	// Fills VertexSources, VertexList, FaceCounts and FaceMaterialIndices, with the material index of each section.
+	// Requires PointIndices.
+	static void FillLODResourcesTopology(
+		const FStaticMeshLODResources& InLODResources, const TArray<int32>& InSectionMaterialIndices,
+		const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers);
+
+	// Vertex attribute fills, require VertexSources.
+	static void FillLODResourcesNormals(const FStaticMeshLODResources& InLODResources, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers);
+	static void FillLODResourcesTangents(const FStaticMeshLODResources& InLODResources, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers);
+	static void FillLODResourcesBinormals(const FStaticMeshLODResources& InLODResources, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers);
+	static void FillLODResourcesUVs(const FStaticMeshLODResources& InLODResources, const int32& InUVLayer, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers);
+	static void FillLODResourcesColors(const FColorVertexBuffer& InColors, const bool& bInParallel, FHoudiniMeshMarshallingBuffers& OutBuffers);
+};
+
+// Staging buffers taken from the pool for the lifetime of the scope.
+struct FHoudiniScopedMeshMarshallingBuffers
+{
+	FHoudiniScopedMeshMarshallingBuffers()
+		: Buffers(FHoudiniMeshMarshalling::AcquireBuffers())
+	{}
+
+	~FHoudiniScopedMeshMarshallingBuffers()
+	{
+		FHoudiniMeshMarshalling::ReleaseBuffers(MoveTemp(Buffers));
+	}
+
+	FHoudiniMeshMarshallingBuffers& Get() { return *Buffers; }
+
+	private:
+
+		TUniquePtr<FHoudiniMeshMarshallingBuffers> Buffers;
+};
@@ -51,8 +51,6 @@
 #include "StaticMeshAttributes.h"
 #include "MeshDescriptionOperations.h"
 
-#include "BSPOps.h"
-#include "Model.h"
 #include "Engine/Polys.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Interfaces/ITargetPlatform.h"
@@ -65,10 +63,12 @@
 #include "ReferenceSkeleton.h"
 #include "Engine/SkeletalMesh.h"
 #include "Animation/Skeleton.h"
-// #include "Async/ParallelFor.h"
+#include "Async/ParallelFor.h"
+#include "HAL/ThreadSafeBool.h"
 #include "HoudiniEngineString.h" 
 #include "Components/SkeletalMeshComponent.h"
 #include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "StaticMeshCompiler.h"
 
 #include "EditorSupportDelegates.h"
 #include "HoudiniGeometryCollectionTranslator.h"
@@ -94,6 +94,75 @@ static TAutoConsoleVariable<float> CVarHoudiniEngineMeshBuildTimer(
 	TEXT("When enabled, the plugin will output timings during the Mesh creation.\n")
 );
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineParallelMeshBuild(
+	TEXT("HoudiniEngine.ParallelMeshBuild"),
+	1,
+	TEXT("When enabled, the mesh buffers are filled on multiple threads during the Mesh creation.\n")
+	TEXT("0: Convert the positions, normals, tangents, colors and UVs of each split one element at a time on the game thread\n")
+	TEXT("1: Convert them in chunks on the task graph, large attributes only (default)\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineParallelCollisionBuild(
+	TEXT("HoudiniEngine.ParallelCollisionBuild"),
+	1,
+	TEXT("When enabled, the simple and convex colliders of all the collision groups of a part are created on multiple threads.\n")
+	TEXT("0: Create the colliders of each collision group in turn on the game thread\n")
+	TEXT("1: Create the colliders of all the groups concurrently, multi hull decompositions still run on the game thread (default)\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineConvexCollisionPerConnectedPiece(
+	TEXT("HoudiniEngine.ConvexCollisionPerConnectedPiece"),
+	0,
+	TEXT("Controls how the convex (UCX) collision groups that are not ucx_multi groups are turned into convex hulls.\n")
+	TEXT("Concave pieces are not decomposed, use a ucx_multi group for that.\n")
+	TEXT("0: A single convex hull around the whole group (default)\n")
+	TEXT("1: One convex hull per connected piece of the group\n")
+);
+
+int32 FHoudiniMeshTranslator::DeferredStaticMeshBuildDepth = 0;
+TArray<TWeakObjectPtr<UStaticMesh>> FHoudiniMeshTranslator::DeferredStaticMeshBuilds;
+
+// Number of elements processed by one task when filling mesh buffers in parallel
+#define HOUDINI_MESH_PARALLEL_CHUNK_SIZE 16384
+
+// Calls InBody(Index) for every index in [0, InNum), split in chunks over the task graph when bInParallel is set.
+// InBody must only write the data owned by its index, so the result does not depend on the chunking.
+template<typename TBody>
+static void
+HoudiniMeshParallelFor(const int32 InNum, const bool bInParallel, const TBody& InBody)
+{
+	const int32 NumChunks = FMath::DivideAndRoundUp(InNum, HOUDINI_MESH_PARALLEL_CHUNK_SIZE);
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		const int32 Start = ChunkIndex * HOUDINI_MESH_PARALLEL_CHUNK_SIZE;
+		const int32 End = FMath::Min(Start + HOUDINI_MESH_PARALLEL_CHUNK_SIZE, InNum);
+		for (int32 Index = Start; Index < End; Index++)
+			InBody(Index);
+	}, !bInParallel || NumChunks < 2);
+}
+
+// Returns the position of a point of a part, converted to Unreal space
+static FVector
+GetHoudiniMeshPointPosition(const TArray<float>& InPartPositions, const int32 InPointIndex)
+{
+	// We need to swap Z and Y coordinate here
+	return FVector(
+		InPartPositions[InPointIndex * 3 + 0] * HAPI_UNREAL_SCALE_FACTOR_POSITION,
+		InPartPositions[InPointIndex * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION,
+		InPartPositions[InPointIndex * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION);
+}
+
+// Indicates a UCX split should be decomposed in multiple convex hulls with DecomposeMeshToHulls()
+static bool
+IsMultiHullCollisionSplit(const FString& InSplitGroupName)
+{
+#if WITH_EDITOR
+	return InSplitGroupName.Contains(TEXT("ucx_multi"), ESearchCase::IgnoreCase);
+#else
+	return false;
+#endif
+}
+
 /**
 * Process and fill in the mesh ref skeleton bone hierarchy using the raw binary import data
 * (difference from epic - Remove any FBX Importer depenedencies)
@@ -1192,7 +1261,8 @@ FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput(
 	const TMap<FString, UMaterialInterface*>& InAllOutputMaterials,
 	UObject* InOuterComponent,
 	bool bInTreatExistingMaterialsAsUpToDate,
-	bool bInDestroyProxies)
+	bool bInDestroyProxies,
+	FHoudiniMeshPrefetchedParts* InPrefetchedParts)
 {
 	if (!IsValid(InOutput))
 		return false;
@@ -1234,6 +1304,11 @@ FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput(
 				InOuterComponent, PropertyAttributes);
 		}
 
+		// Use the part data fetched ahead if we have it, release it once the part has been built
+		TSharedPtr<FHoudiniMeshTranslator> PrefetchedTranslator;
+		if (InPrefetchedParts)
+			InPrefetchedParts->RemoveAndCopyValue(MakeTuple(CurHGPO.ObjectId, CurHGPO.GeoId, CurHGPO.PartId), PrefetchedTranslator);
+
 		CreateStaticMeshFromHoudiniGeoPartObject(
 			CurHGPO,
 			InPackageParams,
@@ -1247,7 +1322,8 @@ FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput(
 			InStaticMeshMethod,
 			InSMGenerationProperties,
 			InMeshBuildSettings,
-			bInTreatExistingMaterialsAsUpToDate);
+			bInTreatExistingMaterialsAsUpToDate,
+			PrefetchedTranslator.Get());
 	}
 
 	return FHoudiniMeshTranslator::CreateOrUpdateAllComponents(
@@ -1717,7 +1793,8 @@ FHoudiniMeshTranslator::CreateStaticMeshFromHoudiniGeoPartObject(
 	const EHoudiniStaticMeshMethod& InStaticMeshMethod,
 	const FHoudiniStaticMeshGenerationProperties& InSMGenerationProperties,
 	const FMeshBuildSettings& InSMBuildSettings,
-	bool bInTreatExistingMaterialsAsUpToDate)
+	bool bInTreatExistingMaterialsAsUpToDate,
+	FHoudiniMeshTranslator* InPrefetchedTranslator)
 {
 	// If we're not forcing the rebuild
 	// No need to recreate something that hasn't changed
@@ -1728,7 +1805,9 @@ FHoudiniMeshTranslator::CreateStaticMeshFromHoudiniGeoPartObject(
 		return true;
 	}
 	
-	FHoudiniMeshTranslator CurrentTranslator;
+	// Reuse the translator holding the prefetched part data if we have one
+	FHoudiniMeshTranslator LocalTranslator;
+	FHoudiniMeshTranslator& CurrentTranslator = InPrefetchedTranslator ? *InPrefetchedTranslator : LocalTranslator;
 	CurrentTranslator.ForceRebuild = InForceRebuild;
 	CurrentTranslator.SetHoudiniGeoPartObject(InHGPO);
 	CurrentTranslator.SetInputObjects(InOutputObjects);
@@ -1779,6 +1858,254 @@ FHoudiniMeshTranslator::CreateStaticMeshFromHoudiniGeoPartObject(
 	return true;
 }
 
+void
+FHoudiniMeshTranslator::PrefetchMeshPartData(
+	const TArray<TPair<UHoudiniOutput*, EHoudiniStaticMeshMethod>>& InMeshOutputs,
+	const bool& bInParallel,
+	FHoudiniMeshPrefetchedParts& OutPrefetchedParts)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::PrefetchMeshPartData"));
+
+	// Gather the mesh parts that will be rebuilt, using the same test as CreateStaticMeshFromHoudiniGeoPartObject
+	TArray<TSharedPtr<FHoudiniMeshTranslator>> Translators;
+	TArray<EHoudiniStaticMeshMethod> TranslatorMethods;
+	for (const TPair<UHoudiniOutput*, EHoudiniStaticMeshMethod>& MeshOutput : InMeshOutputs)
+	{
+		UHoudiniOutput* CurOutput = MeshOutput.Key;
+		if (!IsValid(CurOutput))
+			continue;
+
+		const bool bForceRebuild = CurOutput->HasAnyCurrentProxy() && MeshOutput.Value != EHoudiniStaticMeshMethod::UHoudiniStaticMesh;
+		const bool bHasOutputObjects = CurOutput->GetOutputObjects().Num() > 0;
+		for (const FHoudiniGeoPartObject& CurHGPO : CurOutput->GetHoudiniGeoPartObjects())
+		{
+			if (CurHGPO.Type != EHoudiniPartType::Mesh)
+				continue;
+
+			if (!bForceRebuild && !CurHGPO.bHasGeoChanged && !CurHGPO.bHasPartChanged && bHasOutputObjects)
+				continue;
+
+			TSharedPtr<FHoudiniMeshTranslator> Translator = MakeShared<FHoudiniMeshTranslator>();
+			Translator->SetHoudiniGeoPartObject(CurHGPO);
+			Translators.Add(Translator);
+			TranslatorMethods.Add(MeshOutput.Value);
+		}
+	}
+
+	// HAPI calls are serialized by the session, but fetching the parts concurrently
+	// overlaps the calls with the conversion of the previous parts' data.
+	ParallelFor(Translators.Num(), [&](int32 TranslatorIdx)
+	{
+		Translators[TranslatorIdx]->PrefetchPartData(TranslatorMethods[TranslatorIdx]);
+	}, !bInParallel);
+
+	for (const TSharedPtr<FHoudiniMeshTranslator>& Translator : Translators)
+	{
+		if (!Translator->bHasPrefetchedPartData)
+			continue;
+
+		const FHoudiniGeoPartObject& CurHGPO = Translator->HGPO;
+		OutPrefetchedParts.Add(MakeTuple(CurHGPO.ObjectId, CurHGPO.GeoId, CurHGPO.PartId), Translator);
+	}
+}
+
+void
+FHoudiniMeshTranslator::BeginDeferredStaticMeshBuilds()
+{
+	check(IsInGameThread());
+	DeferredStaticMeshBuildDepth++;
+}
+
+bool
+FHoudiniMeshTranslator::IsDeferringStaticMeshBuilds()
+{
+	return DeferredStaticMeshBuildDepth > 0;
+}
+
+bool
+FHoudiniMeshTranslator::DeferStaticMeshBuild(UStaticMesh* InStaticMesh)
+{
+	if (!IsDeferringStaticMeshBuilds() || !IsValid(InStaticMesh))
+		return false;
+
+	DeferredStaticMeshBuilds.Add(InStaticMesh);
+	return true;
+}
+
+int32
+FHoudiniMeshTranslator::EndDeferredStaticMeshBuilds()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::EndDeferredStaticMeshBuilds"));
+
+	check(IsInGameThread());
+	if (DeferredStaticMeshBuildDepth <= 0)
+		return 0;
+
+	// Only the outermost scope builds the queued meshes
+	DeferredStaticMeshBuildDepth--;
+	if (DeferredStaticMeshBuildDepth > 0)
+		return 0;
+
+	TArray<UStaticMesh*> StaticMeshes;
+	for (const TWeakObjectPtr<UStaticMesh>& DeferredMesh : DeferredStaticMeshBuilds)
+	{
+		UStaticMesh* SM = DeferredMesh.Get();
+		if (IsValid(SM))
+			StaticMeshes.AddUnique(SM);
+	}
+	DeferredStaticMeshBuilds.Empty();
+
+	if (StaticMeshes.Num() <= 0)
+		return 0;
+
+	// Build all the meshes in one batch: the engine builds their render data, distance fields and collision
+	// concurrently, asynchronously when static mesh compilation is allowed to, and in parallel otherwise.
+	const double BuildStart = FPlatformTime::Seconds();
+	TArray<FText> SMBuildErrors;
+	{
+		FHoudiniScopedGlobalSilence ScopedGlobalSilence;
+#if ENGINE_MINOR_VERSION < 1
+		UStaticMesh::BatchBuild(StaticMeshes, true, nullptr, &SMBuildErrors);
+#else
+		UStaticMesh::FBuildParameters BuildParameters;
+		BuildParameters.bInSilent = true;
+		BuildParameters.OutErrors = &SMBuildErrors;
+		UStaticMesh::BatchBuild(StaticMeshes, BuildParameters);
+#endif
+	}
+
+	// Wait for the meshes in the order they were queued. They are built concurrently, so the time reported
+	// for each of them is when its render data became available, relative to the start of the batch.
+	for (UStaticMesh* SM : StaticMeshes)
+	{
+		FStaticMeshCompilingManager::Get().FinishCompilation({ SM });
+		HOUDINI_LOG_MESSAGE(TEXT("Static mesh %s ready %f seconds after the batch build started."), *(SM->GetName()), FPlatformTime::Seconds() - BuildStart);
+	}
+
+	for (const FText& Error : SMBuildErrors)
+		HOUDINI_LOG_WARNING(TEXT("%s"), *(Error.ToString()));
+
+	FinalizeStaticMeshBuilds(StaticMeshes);
+
+	HOUDINI_LOG_MESSAGE(TEXT("Built %d static meshes in %f seconds."), StaticMeshes.Num(), FPlatformTime::Seconds() - BuildStart);
+
+	return StaticMeshes.Num();
+}
+
+void
+FHoudiniMeshTranslator::FinalizeStaticMeshBuilds(const TArray<UStaticMesh*>& InStaticMeshes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::FinalizeStaticMeshBuilds"));
+
+	TSet<UStaticMesh*> BuiltMeshes;
+	for (UStaticMesh* SM : InStaticMeshes)
+	{
+		if (IsValid(SM))
+			BuiltMeshes.Add(SM);
+	}
+
+	if (BuiltMeshes.Num() <= 0)
+		return;
+
+	// This replaces the call to RefreshCollision below, but without CreateNavCollision
+	// as it is already called by UStaticMesh::PostBuildInternal as part of the ::Build call,
+	// and can be expensive depending on the vert/poly count of the mesh
+	// RefreshCollisionChange(*SM);
+	// The components are only iterated once for all the meshes that were built.
+	for (FThreadSafeObjectIterator Iter(UStaticMeshComponent::StaticClass()); Iter; ++Iter)
+	{
+		UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(*Iter);
+		if (BuiltMeshes.Contains(StaticMeshComponent->GetStaticMesh()))
+		{
+			// it needs to recreate IF it already has been created
+			if (StaticMeshComponent->IsPhysicsStateCreated())
+			{
+				StaticMeshComponent->RecreatePhysicsState();
+			}
+		}
+	}
+
+	FEditorSupportDelegates::RedrawAllViewports.Broadcast();
+
+	for (UStaticMesh* SM : BuiltMeshes)
+	{
+		SM->GetOnMeshChanged().Broadcast();
+
+		UPackage* MeshPackage = SM->GetOutermost();
+		if (IsValid(MeshPackage))
+		{
+			MeshPackage->MarkPackageDirty();
+		}
+	}
+}
+
+bool
+FHoudiniMeshTranslator::PrefetchPartData(const EHoudiniStaticMeshMethod& InStaticMeshMethod)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::PrefetchPartData"));
+
+	bHasPrefetchedPartData = false;
+
+	// Skeletal meshes are read separately
+	if (HasSkeletalMeshData(HGPO.GeoId, HGPO.PartId))
+		return false;
+
+	if (!UpdatePartVertexList())
+		return false;
+
+	SortSplitGroups();
+
+	if (!UpdateSplitsFacesAndIndices())
+		return false;
+
+	ResetPartCache();
+
+	// Fetch all the attributes the Create functions will need.
+	// Each fetched attribute is flagged so that its getter doesn't query HAPI again when the attribute is absent,
+	// attributes that are not prefetched here are still fetched on demand by their getter.
+	UpdatePartPositionIfNeeded();
+	PrefetchedPartAttributes |= EHoudiniPartCacheAttribute::Positions;
+
+	UpdatePartNormalsIfNeeded();
+	PrefetchedPartAttributes |= EHoudiniPartCacheAttribute::Normals;
+
+	const UHoudiniRuntimeSettings* HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
+	bool bReadTangents = HoudiniRuntimeSettings ? HoudiniRuntimeSettings->RecomputeTangentsFlag != EHoudiniRuntimeSettingsRecomputeFlag::HRSRF_Always : true;
+	if (bReadTangents)
+	{
+		UpdatePartTangentsIfNeeded();
+		PrefetchedPartAttributes |= EHoudiniPartCacheAttribute::Tangents;
+	}
+
+	UpdatePartColorsIfNeeded();
+	PrefetchedPartAttributes |= EHoudiniPartCacheAttribute::Colors;
+
+	UpdatePartAlphasIfNeeded();
+	PrefetchedPartAttributes |= EHoudiniPartCacheAttribute::Alphas;
+
+	UpdatePartFaceSmoothingIfNeeded();
+	PrefetchedPartAttributes |= EHoudiniPartCacheAttribute::FaceSmoothingMasks;
+
+	UpdatePartUVSetsIfNeeded(InStaticMeshMethod == EHoudiniStaticMeshMethod::FMeshDescription);
+	PrefetchedPartAttributes |= EHoudiniPartCacheAttribute::UVSets;
+
+	UpdatePartLightmapResolutionsIfNeeded();
+	PrefetchedPartAttributes |= EHoudiniPartCacheAttribute::LightmapResolutions;
+
+	UpdatePartLODScreensizeIfNeeded();
+	PrefetchedPartAttributes |= EHoudiniPartCacheAttribute::LODScreensize;
+
+	UpdatePartFaceMaterialIDsIfNeeded();
+	PrefetchedPartAttributes |= EHoudiniPartCacheAttribute::FaceMaterialIds;
+
+	UpdatePartFaceMaterialOverridesIfNeeded();
+	PrefetchedPartAttributes |= EHoudiniPartCacheAttribute::FaceMaterialOverrides;
+
+	bHasPrefetchedPartData = true;
+
+	return true;
+}
+
 bool
 FHoudiniMeshTranslator::UpdatePartVertexList()
 {
@@ -2019,6 +2346,8 @@ FHoudiniMeshTranslator::ResetPartCache()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::ResetPartCache"));
 
+	PrefetchedPartAttributes = EHoudiniPartCacheAttribute::None;
+
 	// Vertex Positions
 	PartPositions.Empty();
 	FHoudiniApi::AttributeInfo_Init(&AttribInfoPositions);
@@ -2081,7 +2410,7 @@ FHoudiniMeshTranslator::UpdatePartPositionIfNeeded()
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::UpdatePartPositionIfNeeded"));
 
 	// Only Retrieve the vertices positions if necessary
-	if (PartPositions.Num() > 0)
+	if (PartPositions.Num() > 0 || IsPartAttributePrefetched(EHoudiniPartCacheAttribute::Positions))
 		return true;
 
 	if (!FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
@@ -2113,7 +2442,7 @@ FHoudiniMeshTranslator::UpdatePartNormalsIfNeeded()
 		return true;
 
 	// Only Retrieve the normals if we haven't already
-	if (PartNormals.Num() > 0)
+	if (PartNormals.Num() > 0 || IsPartAttributePrefetched(EHoudiniPartCacheAttribute::Normals))
 		return true;
 
 	// Retrieve normal data for this part
@@ -2146,7 +2475,7 @@ FHoudiniMeshTranslator::UpdatePartTangentsIfNeeded()
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::UpdatePartTangentsIfNeeded"))
 
 	bool bReturn = true;
-	if (PartTangentU.Num() <= 0)
+	if (PartTangentU.Num() <= 0 && !IsPartAttributePrefetched(EHoudiniPartCacheAttribute::Tangents))
 	{
 		// Retrieve TangentU data for this part
 		bool Success = FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
@@ -2166,7 +2495,7 @@ FHoudiniMeshTranslator::UpdatePartTangentsIfNeeded()
 		}
 	}
 
-	if (PartTangentV.Num() <= 0)
+	if (PartTangentV.Num() <= 0 && !IsPartAttributePrefetched(EHoudiniPartCacheAttribute::Tangents))
 	{
 		// Retrieve TangentV data for this part
 		bool Success = FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
@@ -2195,7 +2524,7 @@ FHoudiniMeshTranslator::UpdatePartColorsIfNeeded()
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::UpdatePartColorsIfNeeded"));
 
 	// Only Retrieve the vertices colors if necessary
-	if (PartColors.Num() > 0)
+	if (PartColors.Num() > 0 || IsPartAttributePrefetched(EHoudiniPartCacheAttribute::Colors))
 		return true;
 
 	bool Success = FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
@@ -2220,7 +2549,7 @@ FHoudiniMeshTranslator::UpdatePartAlphasIfNeeded()
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::UpdatePartAlphasIfNeeded"));
 
 	// Only Retrieve the vertices alphas if necessary
-	if (PartAlphas.Num() > 0)
+	if (PartAlphas.Num() > 0 || IsPartAttributePrefetched(EHoudiniPartCacheAttribute::Alphas))
 		return true;
 
 	bool Success = FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
@@ -2243,7 +2572,7 @@ bool
 FHoudiniMeshTranslator::UpdatePartFaceSmoothingIfNeeded()
 {
 	// Only Retrieve the vertices FaceSmoothing if necessary
-	if (PartFaceSmoothingMasks.Num() > 0)
+	if (PartFaceSmoothingMasks.Num() > 0 || IsPartAttributePrefetched(EHoudiniPartCacheAttribute::FaceSmoothingMasks))
 		return true;
 
 	bool Success = FHoudiniEngineUtils::HapiGetAttributeDataAsInteger(
@@ -2269,7 +2598,7 @@ FHoudiniMeshTranslator::UpdatePartUVSetsIfNeeded(const bool& bRemoveUnused)
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::UpdatePartUVSetsIfNeeded"));
 
 	// Only Retrieve uvs if necessary
-	if (PartUVSets.Num() > 0)
+	if (PartUVSets.Num() > 0 || IsPartAttributePrefetched(EHoudiniPartCacheAttribute::UVSets))
 		return true;
 
 	PartUVSets.SetNum(MAX_STATIC_TEXCOORDS);
@@ -2382,7 +2711,7 @@ bool
 FHoudiniMeshTranslator::UpdatePartLightmapResolutionsIfNeeded()
 {
 	// Only Retrieve the vertices lightmap resolution if necessary
-	if (PartLightMapResolutions.Num() > 0)
+	if (PartLightMapResolutions.Num() > 0 || IsPartAttributePrefetched(EHoudiniPartCacheAttribute::LightmapResolutions))
 		return true;
 
 	// Get lightmap resolution (if present).
@@ -2409,7 +2738,7 @@ FHoudiniMeshTranslator::UpdatePartFaceMaterialIDsIfNeeded()
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::UpdatePartFaceMaterialIDsIfNeeded"));
 
 	// Only Retrieve the material IDs if necessary
-	if (PartFaceMaterialIds.Num() > 0)
+	if (PartFaceMaterialIds.Num() > 0 || IsPartAttributePrefetched(EHoudiniPartCacheAttribute::FaceMaterialIds))
 		return true;
 
 	int32 NumFaces = HGPO.PartInfo.FaceCount;
@@ -2443,7 +2772,7 @@ FHoudiniMeshTranslator::UpdatePartFaceMaterialOverridesIfNeeded()
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::UpdatePartFaceMaterialOverridesIfNeeded"));
 
 	// Only Retrieve the material overrides if necessary
-	if (PartFaceMaterialOverrides.Num() > 0)
+	if (PartFaceMaterialOverrides.Num() > 0 || IsPartAttributePrefetched(EHoudiniPartCacheAttribute::FaceMaterialOverrides))
 		return true;
 
 	bMaterialOverrideNeedsCreateInstance = false;
@@ -2557,7 +2886,7 @@ bool
 FHoudiniMeshTranslator::UpdatePartLODScreensizeIfNeeded()
 {
 	// Only retrieve LOD screensizes if necessary
-	if (PartLODScreensize.Num() > 0)
+	if (PartLODScreensize.Num() > 0 || IsPartAttributePrefetched(EHoudiniPartCacheAttribute::LODScreensize))
 		return true;
 
 	bool Success = FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
@@ -2969,25 +3298,32 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 	// Time limit for processing
 	bool bDoTiming = CVarHoudiniEngineMeshBuildTimer.GetValueOnAnyThread() != 0.0;
 
+	// Fill the mesh buffers on multiple threads
+	const bool bParallelMeshBuild = CVarHoudiniEngineParallelMeshBuild.GetValueOnAnyThread() != 0;
+
 	double time_start = FPlatformTime::Seconds();
 
 	// Keep a copy of the initial package params, since PackageParams is modified in place when resolving attributes
 	FHoudiniPackageParams InitialPackageParams = PackageParams;
 
-	// Start by updating the vertex list
-	if (!UpdatePartVertexList())
-		return false;
+	// The part data may already have been fetched by PrefetchPartData()
+	if (!bHasPrefetchedPartData)
+	{
+		// Start by updating the vertex list
+		if (!UpdatePartVertexList())
+			return false;
 
-	// Sort the split groups
-	SortSplitGroups();
+		// Sort the split groups
+		SortSplitGroups();
 
-	// Handles the split groups found in the part
-	// and builds the corresponding faces and indices arrays
-	if (!UpdateSplitsFacesAndIndices())
-		return true;
+		// Handles the split groups found in the part
+		// and builds the corresponding faces and indices arrays
+		if (!UpdateSplitsFacesAndIndices())
+			return true;
 
-	// Resets the containers used for the raw data extraction.
-	ResetPartCache();
+		// Resets the containers used for the raw data extraction.
+		ResetPartCache();
+	}
 
 	// Prepare the object that will store UCX and simple colliders
 	AllAggregateCollisions.Empty();
@@ -3060,6 +3396,9 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 	// Map of object identifiers to package params
 	TMap<FHoudiniOutputObjectIdentifier, FHoudiniPackageParams> ObjectIdentifiersToPackageParams;
 
+	// Create the colliders of all the collision splits up front, so they can be created concurrently
+	BuildAllSplitCollisions(CVarHoudiniEngineParallelCollisionBuild.GetValueOnGameThread() != 0);
+
 	// Iterate through all detected split groups we care about and split geometry.
 	// The split are ordered in the following way:
 	// Invisible Simple/Convex Colliders > LODs > MainGeo > Visible Colliders > Invisible Colliders
@@ -3110,11 +3449,8 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 		if (SplitType == EHoudiniSplitType::InvisibleUCXCollider || SplitType == EHoudiniSplitType::RenderedUCXCollider)
 		{
 			MainStaticMeshCTF = ECollisionTraceFlag::CTF_UseDefault;
-			// Get the part position if needed
-			UpdatePartPositionIfNeeded();
-
-			// Create the convex hull colliders and add them to the Aggregate
-			if (!AddConvexCollisionToAggregate(SplitGroupName, AggregateCollisions))
+			// Add the convex hull colliders created by BuildAllSplitCollisions() to the Aggregate
+			if (!AddSplitCollisionToAggregate(SplitGroupName, AggregateCollisions))
 			{
 				// Failed to generate a convex collider
 				HOUDINI_LOG_WARNING(
@@ -3129,11 +3465,8 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 		else if (SplitType == EHoudiniSplitType::InvisibleSimpleCollider || SplitType == EHoudiniSplitType::RenderedSimpleCollider)
 		{
 			MainStaticMeshCTF = ECollisionTraceFlag::CTF_UseDefault;
-			// Get the part position if needed
-			UpdatePartPositionIfNeeded();
-
-			// Create the simple colliders and add them to the aggregate
-			if (!AddSimpleCollisionToAggregate(SplitGroupName, AggregateCollisions))
+			// Add the simple colliders created by BuildAllSplitCollisions() to the aggregate
+			if (!AddSplitCollisionToAggregate(SplitGroupName, AggregateCollisions))
 			{
 				// Failed to generate a convex collider
 				HOUDINI_LOG_WARNING(
@@ -3357,13 +3690,13 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 
 			// Transfer the normals to the raw mesh 
 			RawMesh.WedgeTangentZ.SetNumZeroed(WedgeNormalCount);
-			for (int32 WedgeTangentZIdx = 0; WedgeTangentZIdx < WedgeNormalCount; ++WedgeTangentZIdx)
+			HoudiniMeshParallelFor(WedgeNormalCount, bParallelMeshBuild, [&](int32 WedgeTangentZIdx)
 			{
 				// Swap Y/Z for Coordinates conversion
 				RawMesh.WedgeTangentZ[WedgeTangentZIdx].X = SplitNormals[WedgeTangentZIdx * 3 + 0];
 				RawMesh.WedgeTangentZ[WedgeTangentZIdx].Y = SplitNormals[WedgeTangentZIdx * 3 + 2];
 				RawMesh.WedgeTangentZ[WedgeTangentZIdx].Z = SplitNormals[WedgeTangentZIdx * 3 + 1];
-			}
+			});
 
 			if (bDoTiming)
 			{
@@ -3415,35 +3748,35 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 				{
 					RawMesh.WedgeTangentX.SetNumZeroed(WedgeNormalCount);
 					RawMesh.WedgeTangentY.SetNumZeroed(WedgeNormalCount);
-					for (int32 WedgeTangentZIdx = 0; WedgeTangentZIdx < WedgeNormalCount; ++WedgeTangentZIdx)
+					HoudiniMeshParallelFor(WedgeNormalCount, bParallelMeshBuild, [&](int32 WedgeTangentZIdx)
 					{
 						FVector3f TangentX, TangentY;
 						RawMesh.WedgeTangentZ[WedgeTangentZIdx].FindBestAxisVectors(TangentX, TangentY);
 
 						RawMesh.WedgeTangentX[WedgeTangentZIdx] = TangentX;
 						RawMesh.WedgeTangentY[WedgeTangentZIdx] = TangentY;
-					}
+					});
 				}
 				else
 				{
 					// Transfer the tangents we have read them and they're valid
 					RawMesh.WedgeTangentX.SetNumZeroed(WedgeTangentUCount);
-					for (int32 WedgeTangentUIdx = 0; WedgeTangentUIdx < WedgeTangentUCount; ++WedgeTangentUIdx)
+					HoudiniMeshParallelFor(WedgeTangentUCount, bParallelMeshBuild, [&](int32 WedgeTangentUIdx)
 					{
 						// We need to flip Z and Y
 						RawMesh.WedgeTangentX[WedgeTangentUIdx].X = SplitTangentU[WedgeTangentUIdx * 3 + 0];
 						RawMesh.WedgeTangentX[WedgeTangentUIdx].Y = SplitTangentU[WedgeTangentUIdx * 3 + 2];
 						RawMesh.WedgeTangentX[WedgeTangentUIdx].Z = SplitTangentU[WedgeTangentUIdx * 3 + 1];
-					}
+					});
 
 					RawMesh.WedgeTangentY.SetNumZeroed(WedgeTangentVCount);
-					for (int32 WedgeTangentVIdx = 0; WedgeTangentVIdx < WedgeTangentVCount; ++WedgeTangentVIdx)
+					HoudiniMeshParallelFor(WedgeTangentVCount, bParallelMeshBuild, [&](int32 WedgeTangentVIdx)
 					{
 						// We need to flip Z and Y
 						RawMesh.WedgeTangentY[WedgeTangentVIdx].X = SplitTangentV[WedgeTangentVIdx * 3 + 0];
 						RawMesh.WedgeTangentY[WedgeTangentVIdx].Y = SplitTangentV[WedgeTangentVIdx * 3 + 2];
 						RawMesh.WedgeTangentY[WedgeTangentVIdx].Z = SplitTangentV[WedgeTangentVIdx * 3 + 1];
-					}
+					});
 				}
 			}
 
@@ -3480,7 +3813,7 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 			if (bSplitColorValid)
 			{
 				RawMesh.WedgeColors.SetNumZeroed(WedgeColorsCount);
-				for (int32 WedgeColorIdx = 0; WedgeColorIdx < WedgeColorsCount; WedgeColorIdx++)
+				HoudiniMeshParallelFor(WedgeColorsCount, bParallelMeshBuild, [&](int32 WedgeColorIdx)
 				{
 					FLinearColor WedgeColor;
 					WedgeColor.R = FMath::Clamp(
@@ -3508,7 +3841,7 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 
 					// Convert linear color to fixed color.
 					RawMesh.WedgeColors[WedgeColorIdx] = WedgeColor.ToFColor(false);
-				}
+				});
 			}
 			else
 			{
@@ -3595,12 +3928,13 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 				if (SplitUVs.Num() > 0 && SplitUVs.IsValidIndex((WedgeUVCount - 1) * 2 + 1))
 				{
 					RawMesh.WedgeTexCoords[TexCoordIdx].SetNumZeroed(WedgeUVCount);
-					for (int32 WedgeUVIdx = 0; WedgeUVIdx < WedgeUVCount; ++WedgeUVIdx)
+					TArray<FVector2f>& WedgeTexCoords = RawMesh.WedgeTexCoords[TexCoordIdx];
+					HoudiniMeshParallelFor(WedgeUVCount, bParallelMeshBuild, [&](int32 WedgeUVIdx)
 					{
 						// We need to flip V coordinate when it's coming from HAPI.
-						RawMesh.WedgeTexCoords[TexCoordIdx][WedgeUVIdx].X = SplitUVs[WedgeUVIdx * 2 + 0];
-						RawMesh.WedgeTexCoords[TexCoordIdx][WedgeUVIdx].Y = 1.0f - SplitUVs[WedgeUVIdx * 2 + 1];
-					}
+						WedgeTexCoords[WedgeUVIdx].X = SplitUVs[WedgeUVIdx * 2 + 0];
+						WedgeTexCoords[WedgeUVIdx].Y = 1.0f - SplitUVs[WedgeUVIdx * 2 + 1];
+					});
 
 					UVChannelCount++;
 					if (UVChannelCount <= 2)
@@ -3774,8 +4108,8 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 			//
 			int32 VertexPositionsCount = NeededVertices.Num();
 			RawMesh.VertexPositions.SetNumZeroed(VertexPositionsCount);
-			bool bHasInvalidPositionIndexData = false;
-			for (int32 VertexPositionIdx = 0; VertexPositionIdx < VertexPositionsCount; ++VertexPositionIdx)
+			FThreadSafeBool bHasInvalidPositionIndexData = false;
+			HoudiniMeshParallelFor(VertexPositionsCount, bParallelMeshBuild, [&](int32 VertexPositionIdx)
 			{
 				int32 NeededVertexIndex = NeededVertices[VertexPositionIdx];
 				if (!PartPositions.IsValidIndex(NeededVertexIndex * 3 + 2))
@@ -3783,14 +4117,14 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 					// Error retrieving positions.
 					bHasInvalidPositionIndexData = true;
 
-					continue;
+					return;
 				}
 
 				// We need to swap Z and Y coordinate here, and convert from m to cm. 
 				RawMesh.VertexPositions[VertexPositionIdx].X = PartPositions[NeededVertexIndex * 3 + 0] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
 				RawMesh.VertexPositions[VertexPositionIdx].Y = PartPositions[NeededVertexIndex * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
 				RawMesh.VertexPositions[VertexPositionIdx].Z = PartPositions[NeededVertexIndex * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-			}
+			});
 
 			if (bHasInvalidPositionIndexData)
 			{
@@ -4443,6 +4777,10 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 		}
 
 		// BUILD the Static Mesh
+		// During a deferred build, the mesh is queued and built with the others in EndDeferredStaticMeshBuilds()
+		if (DeferStaticMeshBuild(SM))
+			continue;
+
 		// bSilent doesnt add the Build Errors...
 		double build_start = FPlatformTime::Seconds();
 		TArray<FText> SMBuildErrors;
@@ -4453,34 +4791,7 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 			HOUDINI_LOG_MESSAGE(TEXT("CreateStaticMesh_RawMesh() - StaticMesh->Build() executed in %f seconds."), tick - build_start);
 		}
 
-		// This replaces the call to RefreshCollision below, but without CreateNavCollision
-		// as it is already called by UStaticMesh::PostBuildInternal as part of the ::Build call,
-		// and can be expensive depending on the vert/poly count of the mesh
-		// RefreshCollisionChange(*SM);
-		{
-			for (FThreadSafeObjectIterator Iter(UStaticMeshComponent::StaticClass()); Iter; ++Iter)
-			{
-				UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(*Iter);
-				if (StaticMeshComponent->GetStaticMesh() == SM)
-				{
-					// it needs to recreate IF it already has been created
-					if (StaticMeshComponent->IsPhysicsStateCreated())
-					{
-						StaticMeshComponent->RecreatePhysicsState();
-					}
-				}
-			}
-
-			FEditorSupportDelegates::RedrawAllViewports.Broadcast();
-		}
-
-		SM->GetOnMeshChanged().Broadcast();
-
-		UPackage* MeshPackage = SM->GetOutermost();
-		if (IsValid(MeshPackage))
-		{
-			MeshPackage->MarkPackageDirty();
-		}
+		FinalizeStaticMeshBuilds({ SM });
 
 		if (bDoTiming)
 		{
@@ -4503,26 +4814,33 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 	// Time limit for processing
 	bool bDoTiming = CVarHoudiniEngineMeshBuildTimer.GetValueOnAnyThread() != 0.0;
 
+	// Fill the mesh buffers on multiple threads
+	const bool bParallelMeshBuild = CVarHoudiniEngineParallelMeshBuild.GetValueOnAnyThread() != 0;
+
 	double time_start = FPlatformTime::Seconds();
 
 	// Keep a copy of the initial package params, since PackageParams is modified in place when resolving attributes
 	FHoudiniPackageParams InitialPackageParams = PackageParams;
 
-	// Start by updating the vertex list
-	if (!UpdatePartVertexList())
-		return false;
+	// The part data may already have been fetched by PrefetchPartData()
+	if (!bHasPrefetchedPartData)
+	{
+		// Start by updating the vertex list
+		if (!UpdatePartVertexList())
+			return false;
 
-	// Sort the split groups
-	// Simple colliders first, lods and finally, invisible colliders (that are separate Static Mesh)
-	SortSplitGroups();
+		// Sort the split groups
+		// Simple colliders first, lods and finally, invisible colliders (that are separate Static Mesh)
+		SortSplitGroups();
 
-	// Handles the split groups found in the part
-	// and builds the corresponding faces and indices arrays
-	if (!UpdateSplitsFacesAndIndices())
-		return true;
+		// Handles the split groups found in the part
+		// and builds the corresponding faces and indices arrays
+		if (!UpdateSplitsFacesAndIndices())
+			return true;
 
-	// Resets the containers used for the raw data extraction.
-	ResetPartCache();
+		// Resets the containers used for the raw data extraction.
+		ResetPartCache();
+	}
 
 	// Prepare the object that will store UCX and simple colliders
 	AllAggregateCollisions.Empty();
@@ -4593,6 +4911,9 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 	// Map of object identifiers to package params
 	TMap<FHoudiniOutputObjectIdentifier, FHoudiniPackageParams> ObjectIdentifiersToPackageParams;
 
+	// Create the colliders of all the collision splits up front, so they can be created concurrently
+	BuildAllSplitCollisions(CVarHoudiniEngineParallelCollisionBuild.GetValueOnGameThread() != 0);
+
 	// Iterate through all detected split groups we care about and split geometry.
 	// The split are ordered in the following way:
 	// Invisible Simple/Convex Colliders > LODs > MainGeo > Visible Colliders > Invisible Colliders
@@ -4642,11 +4963,8 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 		// Handle UCX / Convex Hull colliders
 		if (SplitType == EHoudiniSplitType::InvisibleUCXCollider || SplitType == EHoudiniSplitType::RenderedUCXCollider)
 		{
-			// Get the part position if needed
-			UpdatePartPositionIfNeeded();
-
-			// Create the convex hull colliders and add them to the Aggregate
-			if (!AddConvexCollisionToAggregate(SplitGroupName, AggregateCollisions))
+			// Add the convex hull colliders created by BuildAllSplitCollisions() to the Aggregate
+			if (!AddSplitCollisionToAggregate(SplitGroupName, AggregateCollisions))
 			{
 				MainStaticMeshCTF = ECollisionTraceFlag::CTF_UseDefault;
 				// Failed to generate a convex collider
@@ -4662,11 +4980,8 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 		else if (SplitType == EHoudiniSplitType::InvisibleSimpleCollider || SplitType == EHoudiniSplitType::RenderedSimpleCollider)
 		{
 			MainStaticMeshCTF = ECollisionTraceFlag::CTF_UseDefault;
-			// Get the part position if needed
-			UpdatePartPositionIfNeeded();
-
-			// Create the simple colliders and add them to the aggregate
-			if (!AddSimpleCollisionToAggregate(SplitGroupName, AggregateCollisions))
+			// Add the simple colliders created by BuildAllSplitCollisions() to the aggregate
+			if (!AddSplitCollisionToAggregate(SplitGroupName, AggregateCollisions))
 			{
 				// Failed to generate a convex collider
 				HOUDINI_LOG_WARNING(
@@ -4981,12 +5296,18 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 			TVertexAttributesRef<FVector3f> VertexPositions = 
 				MeshDescription->VertexAttributes().GetAttributesRef<FVector3f>(MeshAttribute::Vertex::Position);
 
-			bool bHasInvalidPositionIndexData = false;
+			// Create the vertices first, then fill their positions in parallel
+			TArray<FVertexID> SplitVertexIDs;
+			SplitVertexIDs.SetNumUninitialized(SplitNeededVertices.Num());
 			MeshDescription->ReserveNewVertices(SplitNeededVertices.Num());
-			for (const int32& NeededVertexIndex : SplitNeededVertices)
+			for (int32 SplitVertexIdx = 0; SplitVertexIdx < SplitNeededVertices.Num(); SplitVertexIdx++)
+				SplitVertexIDs[SplitVertexIdx] = MeshDescription->CreateVertex();
+
+			FThreadSafeBool bHasInvalidPositionIndexData = false;
+			HoudiniMeshParallelFor(SplitNeededVertices.Num(), bParallelMeshBuild, [&](int32 SplitVertexIdx)
 			{
-				// Create a new Vertex
-				FVertexID VertexID = MeshDescription->CreateVertex();
+				const int32 NeededVertexIndex = SplitNeededVertices[SplitVertexIdx];
+				const FVertexID VertexID = SplitVertexIDs[SplitVertexIdx];
 				if (PartPositions.IsValidIndex(NeededVertexIndex * 3 + 2))
 				{
 					// We need to swap Z and Y coordinate here, and convert from m to cm. 
@@ -4998,10 +5319,8 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 				{
 					// Error when retrieving positions.
 					bHasInvalidPositionIndexData = true;
-
-					continue;
 				}
-			}
+			});
 
 			if (bHasInvalidPositionIndexData)
 			{
@@ -5312,8 +5631,6 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 			FHoudiniMeshTranslator::TransferRegularPointAttributesToVertices(
 				SplitVertexList, AttribInfoNormals, PartNormals, SplitNormals);
 
-			TVertexInstanceAttributesRef<FVector3f> VertexInstanceNormals = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector3f>(MeshAttribute::VertexInstance::Normal);
-
 			// No need to read the tangents if we want unreal to recompute them after
 			const UHoudiniRuntimeSettings* HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
 			bool bReadTangents = HoudiniRuntimeSettings ? HoudiniRuntimeSettings->RecomputeTangentsFlag != EHoudiniRuntimeSettingsRecomputeFlag::HRSRF_Always : true;
@@ -5354,8 +5671,9 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 				{
 					SplitTangentU.SetNumZeroed(NormalCount);
 					SplitTangentV.SetNumZeroed(NormalCount);
-					for (int32 Idx = 0; Idx + 2 < NormalCount; Idx += 3)
+					HoudiniMeshParallelFor(NormalCount / 3, bParallelMeshBuild, [&](int32 NormalIdx)
 					{
+						const int32 Idx = NormalIdx * 3;
 						FVector3f TangentZ;
 						TangentZ.X = SplitNormals[Idx + 0];
 						TangentZ.Y = SplitNormals[Idx + 2];
@@ -5371,13 +5689,9 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 						SplitTangentV[Idx + 0] = TangentY.X;
 						SplitTangentV[Idx + 2] = TangentY.Y;
 						SplitTangentV[Idx + 1] = TangentY.Z;
-					}
+					});
 				}
 			}
-			TVertexInstanceAttributesRef<FVector3f> VertexInstanceTangents = 
-				MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector3f>(MeshAttribute::VertexInstance::Tangent);
-			TVertexInstanceAttributesRef<float> VertexInstanceBinormalSigns = 
-				MeshDescription->VertexInstanceAttributes().GetAttributesRef<float>(MeshAttribute::VertexInstance::BinormalSign);
 
 			// Extract the color values
 			UpdatePartColorsIfNeeded();
@@ -5392,8 +5706,6 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 			TArray<float> SplitAlphas;
 			FHoudiniMeshTranslator::TransferRegularPointAttributesToVertices(
 				SplitVertexList, AttribInfoAlpha, PartAlphas, SplitAlphas);
-			TVertexInstanceAttributesRef<FVector4f> VertexInstanceColors = 
-				MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector4f>(MeshAttribute::VertexInstance::Color);
 
 			// Extract UVs
 			UpdatePartUVSetsIfNeeded(true);
@@ -5424,21 +5736,20 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 
 			bHasNormal = SplitNormals.Num() > 0;
 			bHasTangents = SplitTangentU.Num() > 0 && SplitTangentV.Num() > 0;
-			bool bHasRGB = SplitColors.Num() > 0;
-			bool bHasRGBA = bHasRGB && AttribInfoColors.tupleSize == 4;
-			bool bHasAlpha = SplitAlphas.Num() > 0;
 
-			TArray<bool> HasUVSets;
-			HasUVSets.SetNumZeroed(PartUVSets.Num());
-			for (int32 Idx = 0; Idx < PartUVSets.Num(); Idx++)
-				HasUVSets[Idx] = PartUVSets[Idx].Num() > 0;
+			// Create the vertex instances and triangles, and keep track of the split index of each instance
+			// so their attributes can be filled in parallel afterwards
+			TArray<FVertexInstanceID> SplitVertexInstanceIDs;
+			TArray<int32> SplitVertexInstanceIndices;
+			SplitVertexInstanceIDs.Reserve(SplitIndices.Num());
+			SplitVertexInstanceIndices.Reserve(SplitIndices.Num());
+
+			TArray<FVertexInstanceID> FaceVertexInstanceIDs;
+			FaceVertexInstanceIDs.SetNum(3);
 
 			uint32 FaceCount = SplitIndices.Num() / 3;
 			for (uint32 FaceIndex = 0; FaceIndex < FaceCount; FaceIndex++)
 			{
-				TArray<FVertexInstanceID> FaceVertexInstanceIDs;
-				FaceVertexInstanceIDs.SetNum(3);
-
 				// Ignore degenerate triangles
 				FVertexID VertexIDs[3];
 				for (int32 Corner = 0; Corner < 3; ++Corner)
@@ -5448,85 +5759,19 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 				if (VertexIDs[0] == VertexIDs[1] || VertexIDs[0] == VertexIDs[2] || VertexIDs[1] == VertexIDs[2])
 					continue;
 
-				//FVertexID FaceVertexIDs[3];
 				for (int32 Corner = 0; Corner < 3; Corner++)
 				{
 					uint32 SplitIndex = (FaceIndex * 3) + Corner;
 					uint32 SplitVertexIndex = SplitIndices[SplitIndex];
-					const FVertexInstanceID& VertexInstanceID = MeshDescription->CreateVertexInstance(FVertexID(SplitVertexIndex));
+					const FVertexInstanceID VertexInstanceID = MeshDescription->CreateVertexInstance(FVertexID(SplitVertexIndex));
 
 					// Fix the winding order by updating the SplitIndex (invert corner 1 and 2)
 					// instead of going 0 1 2 go 0 2 1
 					// TODO; this slows down StaticMesh->Build() considerably!
 					Corner == 1 ? SplitIndex++ : Corner == 2 ? SplitIndex-- : SplitIndex;
 
-					const uint32 SplitVertexIndex_X = SplitIndex * 3 + 0;
-					const uint32 SplitVertexIndex_Y = SplitIndex * 3 + 2;
-					const uint32 SplitVertexIndex_Z = SplitIndex * 3 + 1;
-					// Normals
-					if (bHasNormal)
-					{
-						// We need to swap Z and Y coordinate here, and convert from m to cm. 
-						VertexInstanceNormals[VertexInstanceID].X = SplitNormals[SplitVertexIndex_X];
-						VertexInstanceNormals[VertexInstanceID].Y = SplitNormals[SplitVertexIndex_Y];
-						VertexInstanceNormals[VertexInstanceID].Z = SplitNormals[SplitVertexIndex_Z];
-					}
-
-					// Tangents and binormals
-					if (bHasTangents)
-					{
-						// We need to swap Z and Y coordinate here, and convert from m to cm.
-						VertexInstanceTangents[VertexInstanceID].X = SplitTangentU[SplitVertexIndex_X];
-						VertexInstanceTangents[VertexInstanceID].Y = SplitTangentU[SplitVertexIndex_Y];
-						VertexInstanceTangents[VertexInstanceID].Z = SplitTangentU[SplitVertexIndex_Z];
-
-						FVector3f TangentY;
-						TangentY.X = SplitTangentV[SplitVertexIndex_X];
-						TangentY.Y = SplitTangentV[SplitVertexIndex_Y];
-						TangentY.Z = SplitTangentV[SplitVertexIndex_Z];
-
-						VertexInstanceBinormalSigns[VertexInstanceID] = GetBasisDeterminantSign(
-							(FVector)VertexInstanceTangents[VertexInstanceID].GetSafeNormal(),
-							(FVector)TangentY.GetSafeNormal(),
-							(FVector)VertexInstanceNormals[VertexInstanceID].GetSafeNormal());
-					}
-
-					// Color
-					FLinearColor Color = FLinearColor::White;
-					if (bHasRGB)
-					{
-						Color.R = FMath::Clamp(
-							SplitColors[SplitIndex * AttribInfoColors.tupleSize + 0], 0.0f, 1.0f);
-						Color.G = FMath::Clamp(
-							SplitColors[SplitIndex * AttribInfoColors.tupleSize + 1], 0.0f, 1.0f);
-						Color.B = FMath::Clamp(
-							SplitColors[SplitIndex * AttribInfoColors.tupleSize + 2], 0.0f, 1.0f);
-					}
-					// Alpha
-					if (bHasAlpha)
-					{
-						Color.A = FMath::Clamp(SplitAlphas[SplitIndex], 0.0f, 1.0f);
-					}
-					else if (bHasRGBA)
-					{
-						Color.A = FMath::Clamp(SplitColors[SplitIndex * AttribInfoColors.tupleSize + 3], 0.0f, 1.0f);
-					}
-					VertexInstanceColors[VertexInstanceID] = FVector4f(Color);
-
-					// UVs
-					for (int32 UVIndex = 0; UVIndex < SplitUVSets.Num(); UVIndex++)
-					{
-						if (HasUVSets[UVIndex])
-						{
-							// We need to flip V coordinate when it's coming from HAPI.
-							FVector2f CurrentUV;
-							CurrentUV.X = SplitUVSets[UVIndex][SplitIndex * 2 + 0];
-							CurrentUV.Y = 1.0f - SplitUVSets[UVIndex][SplitIndex * 2 + 1];
-
-							VertexInstanceUVs.Set(VertexInstanceID, UVIndex, CurrentUV);
-						}
-					}
-
+					SplitVertexInstanceIDs.Add(VertexInstanceID);
+					SplitVertexInstanceIndices.Add(SplitIndex);
 					FaceVertexInstanceIDs[Corner] = VertexInstanceID;
 				}
 
@@ -5536,6 +5781,13 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 				MeshDescription->CreateTriangle(PolygonGroupID, FaceVertexInstanceIDs);
 			}
 
+			// Normals, tangents, colors and UVs
+			FHoudiniMeshTranslator::FillVertexInstanceAttributes(
+				*MeshDescription, SplitVertexInstanceIDs, SplitVertexInstanceIndices,
+				SplitNormals, SplitTangentU, SplitTangentV,
+				SplitColors, AttribInfoColors.tupleSize, SplitAlphas,
+				SplitUVSets, bParallelMeshBuild);
+
 			if (bDoTiming)
 			{
 				HOUDINI_LOG_MESSAGE(TEXT("CreateStaticMesh_MeshDescription() - VertexAttr filled in %f seconds."), FPlatformTime::Seconds() - tick);
@@ -5861,45 +6113,21 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 		}
 
 		// BUILD the Static Mesh
+		// During a deferred build, the mesh is queued and built with the others in EndDeferredStaticMeshBuilds()
+		if (DeferStaticMeshBuild(SM))
+			continue;
+
 		// bSilent doesnt add the Build Errors...
 		double build_start = FPlatformTime::Seconds();
 		TArray<FText> SMBuildErrors;
-		SM->Build(true, &SMBuildErrors);		
-
+		SM->Build(true, &SMBuildErrors);
 		if (bDoTiming)
-		{			
+		{
 			tick = FPlatformTime::Seconds();
 			HOUDINI_LOG_MESSAGE(TEXT("CreateStaticMesh_MeshDescription() - StaticMesh->Build() executed in %f seconds."), tick - build_start);
 		}
 
-		// This replaces the call to RefreshCollision below, but without CreateNavCollision
-		// as it is already called by UStaticMesh::PostBuildInternal as part of the ::Build call,
-		// and can be expensive depending on the vert/poly count of the mesh
-		// RefreshCollisionChange(*SM);
-		{
-			for (FThreadSafeObjectIterator Iter(UStaticMeshComponent::StaticClass()); Iter; ++Iter)
-			{
-				UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(*Iter);
-				if (StaticMeshComponent->GetStaticMesh() == SM)
-				{
-					// it needs to recreate IF it already has been created
-					if (StaticMeshComponent->IsPhysicsStateCreated())
-					{
-						StaticMeshComponent->RecreatePhysicsState();
-					}
-				}
-			}
-
-			FEditorSupportDelegates::RedrawAllViewports.Broadcast();
-		}
-
-		SM->GetOnMeshChanged().Broadcast();
-
-		UPackage* MeshPackage = SM->GetOutermost();
-		if (IsValid(MeshPackage))
-		{
-			MeshPackage->MarkPackageDirty();
-		}
+		FinalizeStaticMeshBuilds({ SM });
 
 		if (bDoTiming)
 		{
@@ -5922,6 +6150,9 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 	// Time limit for processing
 	bool bDoTiming = CVarHoudiniEngineMeshBuildTimer.GetValueOnAnyThread() != 0.0;
 
+	// Fill the mesh buffers on multiple threads
+	const bool bParallelMeshBuild = CVarHoudiniEngineParallelMeshBuild.GetValueOnAnyThread() != 0;
+
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::CreateHoudiniStaticMesh"));
 
 	const double time_start = FPlatformTime::Seconds();
@@ -5929,20 +6160,24 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 	// Keep a copy of the initial package params, since PackageParams is modified in place when resolving attributes
 	FHoudiniPackageParams InitialPackageParams = PackageParams;
 
-	// Start by updating the vertex list
-	if (!UpdatePartVertexList())
-		return false;
+	// The part data may already have been fetched by PrefetchPartData()
+	if (!bHasPrefetchedPartData)
+	{
+		// Start by updating the vertex list
+		if (!UpdatePartVertexList())
+			return false;
 
-	// Sort the split groups
-	SortSplitGroups();
+		// Sort the split groups
+		SortSplitGroups();
 
-	// Handles the split groups found in the part
-	// and builds the corresponding faces and indices arrays
-	if (!UpdateSplitsFacesAndIndices())
-		return true;
+		// Handles the split groups found in the part
+		// and builds the corresponding faces and indices arrays
+		if (!UpdateSplitsFacesAndIndices())
+			return true;
 
-	// Resets the containers used for the raw data extraction.
-	ResetPartCache();
+		// Resets the containers used for the raw data extraction.
+		ResetPartCache();
+	}
 
 	// Determine if there is "main" geo, if not we'll use the first LOD
 	// as main geo
@@ -6404,16 +6639,15 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 			{
 				TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::CreateHoudiniStaticMesh -- Set Vertex Positions"));
 
-				bool bHasInvalidPositionIndexData = false;
-				for (int32 VertexPositionIdx = 0; VertexPositionIdx < NumVertexPositions; ++VertexPositionIdx)
-				//ParallelFor(NumVertexPositions, [&](uint32 VertexPositionIdx)
+				FThreadSafeBool bHasInvalidPositionIndexData = false;
+				HoudiniMeshParallelFor(NumVertexPositions, bParallelMeshBuild, [&](int32 VertexPositionIdx)
 				{
 					int32 NeededVertexIndex = NeededVertices[VertexPositionIdx];
 					if (!PartPositions.IsValidIndex(NeededVertexIndex * 3 + 2))
 					{
 						// Error retrieving positions.
 						bHasInvalidPositionIndexData = true;
-						continue;
+						return;
 					}
 
 					// We need to swap Z and Y coordinate here, and convert from m to cm. 
@@ -6422,7 +6656,7 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 						PartPositions[NeededVertexIndex * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION,
 						PartPositions[NeededVertexIndex * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION
 					));
-				}//);
+				});
 
 				if (bHasInvalidPositionIndexData)
 				{
@@ -6441,9 +6675,8 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 			{
 				TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::CreateHoudiniStaticMesh -- Set Triangle Indices & Per Vertex Instance Attribute Values"));
 
-				// Now add the triangles to the mesh
-				for (int32 TriangleIdx = 0; TriangleIdx < NumTriangles; ++TriangleIdx)
-				// ParallelFor(NumTriangles, [&](uint32 TriangleIdx)
+				// Now add the triangles to the mesh, each triangle only writes its own vertex instances
+				HoudiniMeshParallelFor(NumTriangles, bParallelMeshBuild, [&](int32 TriangleIdx)
 				{
 					// TODO: add some additional intermediate consts for index calculations to make the indexing
 					// TODO: code a bit more readable
@@ -6496,9 +6729,9 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 									TangentU.Y = SplitTangentU[TriVertIdx0 * 3 + 3 * ElementIdx + 2];
 									TangentU.Z = SplitTangentU[TriVertIdx0 * 3 + 3 * ElementIdx + 1];
 
-									TangentU.X = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 0];
-									TangentU.Y = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 2];
-									TangentU.Z = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 1];
+									TangentV.X = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 0];
+									TangentV.Y = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 2];
+									TangentV.Z = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 1];
 
 									FoundStaticMesh->SetTriangleVertexUTangent(TriangleIdx, TriWindingIndex[ElementIdx], TangentU);
 									FoundStaticMesh->SetTriangleVertexVTangent(TriangleIdx, TriWindingIndex[ElementIdx], TangentV);
@@ -6559,7 +6792,7 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 							}
 						}
 					}
-				}
+				});
 			}
 
 			FMeshBuildSettings BuildSettings;
@@ -7229,42 +7462,118 @@ FHoudiniMeshTranslator::GetSplitTypeFromSplitName(const FString& InSplitName)
 	//return EHoudiniSplitType::Normal;
 }
 
-bool
-FHoudiniMeshTranslator::AddConvexCollisionToAggregate(const FString& SplitGroupName, FKAggregateGeom& AggCollisions)
+void
+FHoudiniMeshTranslator::BuildAllSplitCollisions(const bool& bInParallel)
 {
-	// Get the vertex indices for the split group
-	TArray<int32>& SplitGroupVertexList = AllSplitVertexLists[SplitGroupName];
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::BuildAllSplitCollisions"));
 
-	// We're only interested in unique vertices
-	TArray<int32> UniqueVertexIndexes;
-	for (int32 VertexIdx = 0; VertexIdx < SplitGroupVertexList.Num(); VertexIdx++)
+	AllSplitCollisions.Empty();
+
+	// Gather the UCX and simple collider splits
+	TArray<FString> CollisionSplits;
+	TArray<bool> CollisionSplitIsConvex;
+	for (const FString& SplitGroupName : AllSplitGroups)
 	{
-		int32 Index = SplitGroupVertexList[VertexIdx];
-		if (!PartPositions.IsValidIndex(Index))
+		const EHoudiniSplitType SplitType = GetSplitTypeFromSplitName(SplitGroupName);
+		const bool bIsConvex = SplitType == EHoudiniSplitType::InvisibleUCXCollider || SplitType == EHoudiniSplitType::RenderedUCXCollider;
+		const bool bIsSimple = SplitType == EHoudiniSplitType::InvisibleSimpleCollider || SplitType == EHoudiniSplitType::RenderedSimpleCollider;
+		if (!bIsConvex && !bIsSimple)
+			continue;
+
+		if (!AllSplitVertexLists.Contains(SplitGroupName))
 			continue;
 
-		UniqueVertexIndexes.AddUnique(Index);
+		CollisionSplits.Add(SplitGroupName);
+		CollisionSplitIsConvex.Add(bIsConvex);
 	}
 
-	// Extract the collision geo's vertices
-	TArray< FVector > VertexArray;
-	VertexArray.SetNum(UniqueVertexIndexes.Num());
-	for (int32 Idx = 0; Idx < UniqueVertexIndexes.Num(); Idx++)
+	if (CollisionSplits.Num() <= 0)
+		return;
+
+	// Get the part position if needed
+	UpdatePartPositionIfNeeded();
+
+	const bool bConvexPieces = CVarHoudiniEngineConvexCollisionPerConnectedPiece.GetValueOnGameThread() != 0;
+
+	// Every split only reads the part caches and fills its own aggregate.
+	// The multi hull decompositions need a body setup, so they are left for the game thread.
+	TArray<FKAggregateGeom> SplitCollisions;
+	SplitCollisions.SetNum(CollisionSplits.Num());
+	TArray<bool> SplitSucceeded;
+	SplitSucceeded.SetNumZeroed(CollisionSplits.Num());
+	TArray<bool> SplitNeedsGameThread;
+	SplitNeedsGameThread.SetNumZeroed(CollisionSplits.Num());
+	ParallelFor(CollisionSplits.Num(), [&](int32 SplitIdx)
+	{
+		const FString& SplitGroupName = CollisionSplits[SplitIdx];
+		if (!CollisionSplitIsConvex[SplitIdx])
+			SplitSucceeded[SplitIdx] = AddSimpleCollisionToAggregate(SplitGroupName, SplitCollisions[SplitIdx]);
+		else if (IsMultiHullCollisionSplit(SplitGroupName))
+			SplitNeedsGameThread[SplitIdx] = true;
+		else if (bConvexPieces)
+			SplitSucceeded[SplitIdx] = AddConvexPiecesCollisionToAggregate(SplitGroupName, SplitCollisions[SplitIdx]);
+		else
+			SplitSucceeded[SplitIdx] = AddConvexCollisionToAggregate(SplitGroupName, SplitCollisions[SplitIdx]);
+	}, !bInParallel);
+
+	for (int32 SplitIdx = 0; SplitIdx < CollisionSplits.Num(); SplitIdx++)
+	{
+		if (SplitNeedsGameThread[SplitIdx])
+			SplitSucceeded[SplitIdx] = AddConvexCollisionToAggregate(CollisionSplits[SplitIdx], SplitCollisions[SplitIdx]);
+
+		if (SplitSucceeded[SplitIdx])
+			AllSplitCollisions.Add(CollisionSplits[SplitIdx], MoveTemp(SplitCollisions[SplitIdx]));
+	}
+}
+
+bool
+FHoudiniMeshTranslator::AddSplitCollisionToAggregate(const FString& SplitGroupName, FKAggregateGeom& AggCollisions) const
+{
+	const FKAggregateGeom* SplitCollisions = AllSplitCollisions.Find(SplitGroupName);
+	if (!SplitCollisions)
+		return false;
+
+	AggCollisions.SphereElems.Append(SplitCollisions->SphereElems);
+	AggCollisions.BoxElems.Append(SplitCollisions->BoxElems);
+	AggCollisions.SphylElems.Append(SplitCollisions->SphylElems);
+	AggCollisions.ConvexElems.Append(SplitCollisions->ConvexElems);
+
+	return true;
+}
+
+void
+FHoudiniMeshTranslator::GetSplitUniquePositions(const FString& SplitGroupName, TArray<FVector>& OutPositions) const
+{
+	OutPositions.Reset();
+
+	// Get the vertex indices for the split group
+	const TArray<int32>* SplitGroupVertexList = AllSplitVertexLists.Find(SplitGroupName);
+	if (!SplitGroupVertexList)
+		return;
+
+	// We're only interested in unique points, in the order they are first used
+	const int32 NumPoints = PartPositions.Num() / 3;
+	TBitArray<> UsedPoints(false, NumPoints);
+	for (const int32& Point : *SplitGroupVertexList)
 	{
-		int32 VertexIndex = UniqueVertexIndexes[Idx];
-		if (!PartPositions.IsValidIndex(VertexIndex * 3 + 2))
+		if (Point < 0 || Point >= NumPoints || UsedPoints[Point])
 			continue;
 
-		VertexArray[Idx].X = PartPositions[VertexIndex * 3 + 0] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-		VertexArray[Idx].Y = PartPositions[VertexIndex * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-		VertexArray[Idx].Z = PartPositions[VertexIndex * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
+		UsedPoints[Point] = true;
+		OutPositions.Add(GetHoudiniMeshPointPosition(PartPositions, Point));
 	}
+}
+
+bool
+FHoudiniMeshTranslator::AddConvexCollisionToAggregate(const FString& SplitGroupName, FKAggregateGeom& AggCollisions) const
+{
+	// Extract the collision geo's vertices
+	TArray<FVector> VertexArray;
+	GetSplitUniquePositions(SplitGroupName, VertexArray);
 
 #if WITH_EDITOR
 	// Do we want to create multiple convex hulls?
-	bool bDoMultiHullDecomp = false;
-	if (SplitGroupName.Contains(TEXT("ucx_multi"), ESearchCase::IgnoreCase))
-		bDoMultiHullDecomp = true;
+	bool bDoMultiHullDecomp = IsMultiHullCollisionSplit(SplitGroupName);
 
 	uint32 HullCount = 8;
 	int32 MaxHullVerts = 16;
@@ -7274,12 +7583,14 @@ FHoudiniMeshTranslator::AddConvexCollisionToAggregate(const FString& SplitGroupN
 		// Look for extra attributes for the decomposition parameters? (HullCount/MaxHullVerts)
 	}
 
-	if (bDoMultiHullDecomp && (VertexArray.Num() >= 3 || UniqueVertexIndexes.Num() >= 3))
+	if (bDoMultiHullDecomp && VertexArray.Num() >= 3)
 	{
 		// creating multiple convex hull collision
 		// ... this might take a while
+		check(IsInGameThread());
 
 		// We're only interested in the valid indices!
+		const TArray<int32>& SplitGroupVertexList = AllSplitVertexLists.FindChecked(SplitGroupName);
 		TArray<uint32> Indices;
 		for (int32 VertexIdx = 0; VertexIdx < SplitGroupVertexList.Num(); VertexIdx++)
 		{
@@ -7296,9 +7607,7 @@ FHoudiniMeshTranslator::AddConvexCollisionToAggregate(const FString& SplitGroupN
 
 		for (int32 Idx = 0; Idx < Vertices.Num(); Idx++)
 		{
-			Vertices[Idx].X = PartPositions[Idx * 3 + 0] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-			Vertices[Idx].Y = PartPositions[Idx * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-			Vertices[Idx].Z = PartPositions[Idx * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
+			Vertices[Idx] = (FVector3f)GetHoudiniMeshPointPosition(PartPositions, Idx);
 		}
 
 		// We are using Unreal's DecomposeMeshToHulls() 
@@ -7332,36 +7641,95 @@ FHoudiniMeshTranslator::AddConvexCollisionToAggregate(const FString& SplitGroupN
 }
 
 bool
-FHoudiniMeshTranslator::AddSimpleCollisionToAggregate(const FString& SplitGroupName, FKAggregateGeom& AggCollisions)
+FHoudiniMeshTranslator::AddConvexPiecesCollisionToAggregate(const FString& SplitGroupName, FKAggregateGeom& AggCollisions) const
 {
-	// Get the vertex indices for the split group
-	TArray<int32>& SplitGroupVertexList = AllSplitVertexLists[SplitGroupName];
+	// Split the group into its connected pieces: collision geometry made of separate pieces (rubble, debris...)
+	// gets one hull per piece instead of a single hull around all of them. Each piece is still a single hull.
+	const TArray<int32>* SplitGroupVertexList = AllSplitVertexLists.Find(SplitGroupName);
+	if (!SplitGroupVertexList)
+		return false;
+
+	// Only the points used by the split take part in the union-find
+	const int32 NumPoints = PartPositions.Num() / 3;
+	TMap<int32, int32> PointToSplitPoint;
+	TArray<int32> SplitPoints;
+	TArray<int32> Parents;
+	auto GetSplitPoint = [&](int32 Point)
+	{
+		if (const int32* FoundSplitPoint = PointToSplitPoint.Find(Point))
+			return *FoundSplitPoint;
 
-	// We're only interested in unique vertices
-	TArray<int32> UniqueVertexIndexes;
-	for (int32 VertexIdx = 0; VertexIdx < SplitGroupVertexList.Num(); VertexIdx++)
+		const int32 SplitPoint = SplitPoints.Add(Point);
+		Parents.Add(SplitPoint);
+		PointToSplitPoint.Add(Point, SplitPoint);
+		return SplitPoint;
+	};
+
+	auto FindRoot = [&Parents](int32 SplitPoint)
 	{
-		int32 Index = SplitGroupVertexList[VertexIdx];
-		if (!PartPositions.IsValidIndex(Index))
+		while (Parents[SplitPoint] != SplitPoint)
+		{
+			Parents[SplitPoint] = Parents[Parents[SplitPoint]];
+			SplitPoint = Parents[SplitPoint];
+		}
+		return SplitPoint;
+	};
+
+	// Join the points of every triangle of the split
+	for (int32 VertexIdx = 0; VertexIdx + 2 < SplitGroupVertexList->Num(); VertexIdx += 3)
+	{
+		const int32 Triangle[3] = { (*SplitGroupVertexList)[VertexIdx], (*SplitGroupVertexList)[VertexIdx + 1], (*SplitGroupVertexList)[VertexIdx + 2] };
+		if (Triangle[0] < 0 || Triangle[0] >= NumPoints || Triangle[1] < 0 || Triangle[1] >= NumPoints || Triangle[2] < 0 || Triangle[2] >= NumPoints)
 			continue;
 
-		UniqueVertexIndexes.AddUnique(Index);
+		const int32 Root = FindRoot(GetSplitPoint(Triangle[0]));
+		for (int32 Corner = 1; Corner < 3; Corner++)
+		{
+			const int32 CornerRoot = FindRoot(GetSplitPoint(Triangle[Corner]));
+			if (Root != CornerRoot)
+				Parents[CornerRoot] = Root;
+		}
 	}
 
-	// Extract the collision geo's vertices
-	TArray< FVector > VertexArray;
-	VertexArray.SetNum(UniqueVertexIndexes.Num());
-	for (int32 Idx = 0; Idx < UniqueVertexIndexes.Num(); Idx++)
+	// Gather the points of each piece
+	TMap<int32, int32> RootToPiece;
+	TArray<TArray<FVector>> Pieces;
+	for (int32 SplitPoint = 0; SplitPoint < SplitPoints.Num(); SplitPoint++)
 	{
-		int32 VertexIndex = UniqueVertexIndexes[Idx];
-		if (!PartPositions.IsValidIndex(VertexIndex * 3 + 2))
+		const int32 Root = FindRoot(SplitPoint);
+		const int32* FoundPiece = RootToPiece.Find(Root);
+		const int32 PieceIdx = FoundPiece ? *FoundPiece : RootToPiece.Add(Root, Pieces.AddDefaulted());
+		Pieces[PieceIdx].Add(GetHoudiniMeshPointPosition(PartPositions, SplitPoints[SplitPoint]));
+	}
+
+	int32 NumHulls = 0;
+	for (TArray<FVector>& Piece : Pieces)
+	{
+		// Flat pieces can't make a hull
+		if (Piece.Num() < 4)
 			continue;
 
-		VertexArray[Idx].X = PartPositions[VertexIndex * 3 + 0] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-		VertexArray[Idx].Y = PartPositions[VertexIndex * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-		VertexArray[Idx].Z = PartPositions[VertexIndex * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
+		FKConvexElem ConvexCollision;
+		ConvexCollision.VertexData = MoveTemp(Piece);
+		ConvexCollision.UpdateElemBox();
+		AggCollisions.ConvexElems.Add(ConvexCollision);
+		NumHulls++;
 	}
 
+	// Fall back to a single hull
+	if (NumHulls <= 0)
+		return AddConvexCollisionToAggregate(SplitGroupName, AggCollisions);
+
+	return true;
+}
+
+bool
+FHoudiniMeshTranslator::AddSimpleCollisionToAggregate(const FString& SplitGroupName, FKAggregateGeom& AggCollisions) const
+{
+	// Extract the collision geo's vertices
+	TArray<FVector> VertexArray;
+	GetSplitUniquePositions(SplitGroupName, VertexArray);
+
 	int32 NewColliders = 0;
 	if (SplitGroupName.Contains("Box"))
 	{
@@ -7416,6 +7784,117 @@ FHoudiniMeshTranslator::AddSimpleCollisionToAggregate(const FString& SplitGroupN
 	return (NewColliders > 0);
 }
 
+void
+FHoudiniMeshTranslator::FillVertexInstanceAttributes(
+	FMeshDescription& OutMeshDescription,
+	const TArray<FVertexInstanceID>& InVertexInstanceIDs,
+	const TArray<int32>& InSplitIndices,
+	const TArray<float>& InSplitNormals,
+	const TArray<float>& InSplitTangentU,
+	const TArray<float>& InSplitTangentV,
+	const TArray<float>& InSplitColors,
+	const int32& InColorTupleSize,
+	const TArray<float>& InSplitAlphas,
+	const TArray<TArray<float>>& InSplitUVSets,
+	const bool& bInParallel)
+{
+	if (!ensure(InVertexInstanceIDs.Num() == InSplitIndices.Num()))
+		return;
+
+	TVertexInstanceAttributesRef<FVector3f> VertexInstanceNormals = 
+		OutMeshDescription.VertexInstanceAttributes().GetAttributesRef<FVector3f>(MeshAttribute::VertexInstance::Normal);
+	TVertexInstanceAttributesRef<FVector3f> VertexInstanceTangents = 
+		OutMeshDescription.VertexInstanceAttributes().GetAttributesRef<FVector3f>(MeshAttribute::VertexInstance::Tangent);
+	TVertexInstanceAttributesRef<float> VertexInstanceBinormalSigns = 
+		OutMeshDescription.VertexInstanceAttributes().GetAttributesRef<float>(MeshAttribute::VertexInstance::BinormalSign);
+	TVertexInstanceAttributesRef<FVector4f> VertexInstanceColors = 
+		OutMeshDescription.VertexInstanceAttributes().GetAttributesRef<FVector4f>(MeshAttribute::VertexInstance::Color);
+	TVertexInstanceAttributesRef<FVector2f> VertexInstanceUVs = 
+		OutMeshDescription.VertexInstanceAttributes().GetAttributesRef<FVector2f>(MeshAttribute::VertexInstance::TextureCoordinate);
+
+	const bool bHasNormal = InSplitNormals.Num() > 0;
+	const bool bHasTangents = InSplitTangentU.Num() > 0 && InSplitTangentV.Num() > 0;
+	const bool bHasRGB = InSplitColors.Num() > 0;
+	const bool bHasRGBA = bHasRGB && InColorTupleSize == 4;
+	const bool bHasAlpha = InSplitAlphas.Num() > 0;
+	const int32 UVSetCount = FMath::Min(InSplitUVSets.Num(), VertexInstanceUVs.GetNumChannels());
+
+	// Every vertex instance only writes its own attribute values
+	HoudiniMeshParallelFor(InVertexInstanceIDs.Num(), bInParallel, [&](int32 Idx)
+	{
+		const FVertexInstanceID VertexInstanceID = InVertexInstanceIDs[Idx];
+		const int32 SplitIndex = InSplitIndices[Idx];
+
+		// We need to swap Z and Y coordinate here
+		const int32 SplitVertexIndex_X = SplitIndex * 3 + 0;
+		const int32 SplitVertexIndex_Y = SplitIndex * 3 + 2;
+		const int32 SplitVertexIndex_Z = SplitIndex * 3 + 1;
+
+		// Normals
+		FVector3f Normal = FVector3f::ZeroVector;
+		if (bHasNormal)
+		{
+			Normal.X = InSplitNormals[SplitVertexIndex_X];
+			Normal.Y = InSplitNormals[SplitVertexIndex_Y];
+			Normal.Z = InSplitNormals[SplitVertexIndex_Z];
+			VertexInstanceNormals[VertexInstanceID] = Normal;
+		}
+
+		// Tangents and binormals
+		if (bHasTangents)
+		{
+			FVector3f TangentX;
+			TangentX.X = InSplitTangentU[SplitVertexIndex_X];
+			TangentX.Y = InSplitTangentU[SplitVertexIndex_Y];
+			TangentX.Z = InSplitTangentU[SplitVertexIndex_Z];
+			VertexInstanceTangents[VertexInstanceID] = TangentX;
+
+			FVector3f TangentY;
+			TangentY.X = InSplitTangentV[SplitVertexIndex_X];
+			TangentY.Y = InSplitTangentV[SplitVertexIndex_Y];
+			TangentY.Z = InSplitTangentV[SplitVertexIndex_Z];
+
+			VertexInstanceBinormalSigns[VertexInstanceID] = GetBasisDeterminantSign(
+				(FVector)TangentX.GetSafeNormal(),
+				(FVector)TangentY.GetSafeNormal(),
+				(FVector)Normal.GetSafeNormal());
+		}
+
+		// Color
+		FLinearColor Color = FLinearColor::White;
+		if (bHasRGB)
+		{
+			Color.R = FMath::Clamp(InSplitColors[SplitIndex * InColorTupleSize + 0], 0.0f, 1.0f);
+			Color.G = FMath::Clamp(InSplitColors[SplitIndex * InColorTupleSize + 1], 0.0f, 1.0f);
+			Color.B = FMath::Clamp(InSplitColors[SplitIndex * InColorTupleSize + 2], 0.0f, 1.0f);
+		}
+		// Alpha
+		if (bHasAlpha)
+		{
+			Color.A = FMath::Clamp(InSplitAlphas[SplitIndex], 0.0f, 1.0f);
+		}
+		else if (bHasRGBA)
+		{
+			Color.A = FMath::Clamp(InSplitColors[SplitIndex * InColorTupleSize + 3], 0.0f, 1.0f);
+		}
+		VertexInstanceColors[VertexInstanceID] = FVector4f(Color);
+
+		// UVs
+		for (int32 UVIndex = 0; UVIndex < UVSetCount; UVIndex++)
+		{
+			if (InSplitUVSets[UVIndex].Num() <= 0)
+				continue;
+
+			// We need to flip V coordinate when it's coming from HAPI.
+			FVector2f CurrentUV;
+			CurrentUV.X = InSplitUVSets[UVIndex][SplitIndex * 2 + 0];
+			CurrentUV.Y = 1.0f - InSplitUVSets[UVIndex][SplitIndex * 2 + 1];
+
+			VertexInstanceUVs.Set(VertexInstanceID, UVIndex, CurrentUV);
+		}
+	});
+}
+
 int32
 FHoudiniMeshTranslator::TransferRegularPointAttributesToVertices(
 	const TArray<int32>& InVertexList,
@@ -8261,10 +8740,6 @@ FHoudiniMeshTranslator::GenerateKDopAsSimpleCollision(const TArray<FVector>& InP
 	for (int32 n = 0; n < maxDist.Num(); n++)
 		maxDist[n] = -my_flt_max;
 
-	// Construct temporary UModel for kdop creation. We keep no refs to it, so it can be GC'd.
-	auto TempModel = NewObject<UModel>();
-	TempModel->Initialize(nullptr, 1);
-
 	// For each vertex, project along each kdop direction, to find the max in that direction.
 	for (int32 i = 0; i < InPositionArray.Num(); i++)
 	{
@@ -8287,9 +8762,12 @@ FHoudiniMeshTranslator::GenerateKDopAsSimpleCollision(const TArray<FVector>& InP
 	for (int32 i = 0; i < kCount; i++)
 		planes.Add(FPlane4f((FVector3f)Dirs[i], maxDist[i]));
 
+	// The kdop is convex, so its polygons are built directly instead of going through a temporary UModel, BSP and
+	// UBodySetup: this keeps the function free of UObjects, so it can be used to create colliders on worker threads.
+	TArray<FPoly> Polys;
 	for (int32 i = 0; i < planes.Num(); i++)
 	{
-		FPoly*	Polygon = new(TempModel->Polys->Element) FPoly();
+		FPoly*	Polygon = new(Polys) FPoly();
 		FVector3f Base, AxisX, AxisY;
 
 		Polygon->Init();
@@ -8318,7 +8796,7 @@ FHoudiniMeshTranslator::GenerateKDopAsSimpleCollision(const TArray<FVector>& InP
 		if (Polygon->Vertices.Num() < 3)
 		{
 			// If poly resulted in no verts, remove from array
-			TempModel->Polys->Element.RemoveAt(TempModel->Polys->Element.Num() - 1);
+			Polys.RemoveAt(Polys.Num() - 1);
 		}
 		else
 		{
@@ -8328,37 +8806,24 @@ FHoudiniMeshTranslator::GenerateKDopAsSimpleCollision(const TArray<FVector>& InP
 		}
 	}
 
-	if (TempModel->Polys->Element.Num() < 4)
+	if (Polys.Num() < 4)
 	{
-		TempModel = NULL;
 		HOUDINI_LOG_WARNING(TEXT("Failed to generate a simple KDOP collider."));
 		return 0;
 	}
 
-	// Build bounding box.
-	TempModel->BuildBound();
-
-	// Build BSP for the brush.
-	FBSPOps::bspBuild(TempModel, FBSPOps::BSP_Good, 15, 70, 1, 0);
-	FBSPOps::bspRefresh(TempModel, 1);
-	FBSPOps::bspBuildBounds(TempModel);
-
-	// Now, create a temporary BodySetup to build the colliders
-	UBodySetup* TempBS = NewObject<UBodySetup>();
-	TempBS->CreateFromModel(TempModel, false);
-
-	// Copy the convex elements back to our aggregate
-	int32 NewConvexElems = 0;
-	if (TempBS && TempBS->AggGeom.ConvexElems.Num() > 0)
+	// The kdop's convex element is made of the unique vertices of its polygons
+	FKConvexElem ConvexElem;
+	for (const FPoly& Polygon : Polys)
 	{
-		for (const auto& CurConvexElem : TempBS->AggGeom.ConvexElems)
-		{
-			OutAggregateCollisions.ConvexElems.Add(CurConvexElem);
-			NewConvexElems++;
-		}
+		for (const FVector3f& Vertex : Polygon.Vertices)
+			ConvexElem.VertexData.AddUnique((FVector)Vertex);
 	}
 
-	return NewConvexElems;
+	ConvexElem.UpdateElemBox();
+	OutAggregateCollisions.ConvexElems.Add(ConvexElem);
+
+	return 1;
 }
 
 
@@ -37,6 +37,7 @@
 #include "ImportUtils/SkeletalMeshImportUtils.h"
 #include "Rendering/SkeletalMeshLODImporterData.h"
 #include "PhysicsEngine/AggregateGeom.h"
+#include "MeshTypes.h"
 
 //#include "HoudiniMeshTranslator.generated.h"
 
@@ -51,6 +52,7 @@ class UHoudiniStaticMesh;
 class UHoudiniStaticMeshComponent;
 
 struct FKAggregateGeom;
+struct FMeshDescription;
 struct FHoudiniGenericAttribute;
 
 
@@ -89,8 +91,36 @@ enum class EHoudiniSplitType : uint8
 	InvisibleSimpleCollider
 };
 
+// Part attributes cached by FHoudiniMeshTranslator::PrefetchPartData()
+enum class EHoudiniPartCacheAttribute : uint32
+{
+	None = 0,
+	Positions = 1 << 0,
+	Normals = 1 << 1,
+	Tangents = 1 << 2,
+	Colors = 1 << 3,
+	Alphas = 1 << 4,
+	FaceSmoothingMasks = 1 << 5,
+	UVSets = 1 << 6,
+	LightmapResolutions = 1 << 7,
+	LODScreensize = 1 << 8,
+	FaceMaterialIds = 1 << 9,
+	FaceMaterialOverrides = 1 << 10
+};
+ENUM_CLASS_FLAGS(EHoudiniPartCacheAttribute);
+
+struct FHoudiniMeshTranslator;
+
+// Mesh translators whose part data has already been fetched from HAPI, by (ObjectId, GeoId, PartId)
+typedef TMap<TTuple<int32, int32, int32>, TSharedPtr<FHoudiniMeshTranslator>> FHoudiniMeshPrefetchedParts;
+
 struct HOUDINIENGINE_API FHoudiniMeshTranslator
 {
+	// The collision tests fill the part and split caches directly
+	friend class HoudiniMeshTranslatorCollisionTest;
+	// The output fetch test compares the part caches filled by the serial and parallel prefetch
+	friend class HoudiniMeshTranslatorParallelOutputFetchTest;
+
 	public:
 
 		//-----------------------------------------------------------------------------------------------------------------------------
@@ -107,7 +137,8 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 			const TMap<FString, UMaterialInterface*>& InAllOutputMaterials,
 			UObject* InOuterComponent,
 			bool bInTreatExistingMaterialsAsUpToDate=false,
-			bool bInDestroyProxies=false);
+			bool bInDestroyProxies=false,
+			FHoudiniMeshPrefetchedParts* InPrefetchedParts=nullptr);
 	
 		static bool CreateStaticMeshFromHoudiniGeoPartObject(
 			const FHoudiniGeoPartObject& InHGPO,
@@ -122,7 +153,25 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 			const EHoudiniStaticMeshMethod& InStaticMeshMethod,
 			const FHoudiniStaticMeshGenerationProperties& InSMGenerationProperties,
 			const FMeshBuildSettings& InMeshBuildSettings,
-			bool bInTreatExistingMaterialsAsUpToDate = false);
+			bool bInTreatExistingMaterialsAsUpToDate = false,
+			FHoudiniMeshTranslator* InPrefetchedTranslator = nullptr);
+
+		// Fetches the HAPI data of the mesh parts that need to be rebuilt in the given outputs (with the static mesh
+		// method used for each output). This only fills the translators' part caches, no UObject is created,
+		// so the parts are fetched concurrently when bInParallel is true.
+		static void PrefetchMeshPartData(
+			const TArray<TPair<UHoudiniOutput*, EHoudiniStaticMeshMethod>>& InMeshOutputs,
+			const bool& bInParallel,
+			FHoudiniMeshPrefetchedParts& OutPrefetchedParts);
+
+		// While a deferred build is active, the static meshes created by the translators are not built one by one:
+		// they are queued and built together by EndDeferredStaticMeshBuilds(), which returns the number of meshes built.
+		// Deferred builds can be nested, the queued meshes are built when the outermost one ends. Game thread only.
+		static void BeginDeferredStaticMeshBuilds();
+		static int32 EndDeferredStaticMeshBuilds();
+		static bool IsDeferringStaticMeshBuilds();
+		// Queues the mesh if a deferred build is active, returns false if the mesh has to be built now
+		static bool DeferStaticMeshBuild(UStaticMesh* InStaticMesh);
 
 		static bool CreateOrUpdateAllComponents(
 			UHoudiniOutput* InOutput,
@@ -146,6 +195,22 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 
 		static FString GetMeshIdentifierFromSplit(const FString& InSplitName, const EHoudiniSplitType& InSplitType);
 
+		// Fills the normals, tangents, colors and UVs of already created vertex instances.
+		// InSplitIndices contains the index in the split attribute arrays of each vertex instance.
+		// When bInParallel is true, the values are written in parallel chunks, the result is identical to the serial fill.
+		static void FillVertexInstanceAttributes(
+			FMeshDescription& OutMeshDescription,
+			const TArray<FVertexInstanceID>& InVertexInstanceIDs,
+			const TArray<int32>& InSplitIndices,
+			const TArray<float>& InSplitNormals,
+			const TArray<float>& InSplitTangentU,
+			const TArray<float>& InSplitTangentV,
+			const TArray<float>& InSplitColors,
+			const int32& InColorTupleSize,
+			const TArray<float>& InSplitAlphas,
+			const TArray<TArray<float>>& InSplitUVSets,
+			const bool& bInParallel);
+
 		// TODO: Rename me! and template me! float/int/string ?
 		// TransferPartAttributesToSplitVertices
 		static int32 TransferRegularPointAttributesToVertices(
@@ -243,6 +308,9 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 
 		bool CreateSkeletalMesh_SkeletalMeshImportData();
 
+		// Fetches the vertex list, splits and all the attributes needed to build this part's meshes
+		bool PrefetchPartData(const EHoudiniStaticMeshMethod& InStaticMeshMethod);
+
 		// Indicates the update is forced
 		bool ForceRebuild;
 		int32 DefaultMeshSmoothing;
@@ -265,6 +333,9 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 
 		void ResetPartCache();
 
+		// Indicates if PrefetchPartData() has already fetched the given attribute, even if it was absent on the part
+		bool IsPartAttributePrefetched(const EHoudiniPartCacheAttribute& InAttribute) const { return EnumHasAnyFlags(PrefetchedPartAttributes, InAttribute); }
+
 		bool UpdatePartVertexList();
 
 		void SortSplitGroups();
@@ -328,10 +399,23 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 
 		float GetLODSCreensizeForSplit(const FString& SplitGroupName);
 
+		// Create the colliders of all the collision splits, concurrently, before the splits are processed.
+		// Concave groups are not decomposed on the worker threads: ucx_multi splits still use DecomposeMeshToHulls(),
+		// which needs a UBodySetup, and run on the game thread once the other splits are done.
+		void BuildAllSplitCollisions(const bool& bInParallel);
+		// Add the colliders created by BuildAllSplitCollisions() for a split to the aggregate
+		bool AddSplitCollisionToAggregate(const FString& SplitGroupName, FKAggregateGeom& AggCollisions) const;
+
+		// Gets the unique positions used by a split, in Unreal space
+		void GetSplitUniquePositions(const FString& SplitGroupName, TArray<FVector>& OutPositions) const;
+
 		// Create convex/UCX collider for a split and add to the aggregate
-		bool AddConvexCollisionToAggregate(const FString& SplitGroupName, FKAggregateGeom& AggCollisions);
+		// Multi hull decomposition (ucx_multi) needs UObjects, so it can only run on the game thread
+		bool AddConvexCollisionToAggregate(const FString& SplitGroupName, FKAggregateGeom& AggCollisions) const;
+		// Create one convex collider per connected piece of a split and add them to the aggregate, pieces are not decomposed further
+		bool AddConvexPiecesCollisionToAggregate(const FString& SplitGroupName, FKAggregateGeom& AggCollisions) const;
 		// Create simple colliders for a split and add to the aggregate
-		bool AddSimpleCollisionToAggregate(const FString& SplitGroupName, FKAggregateGeom& AggCollisions);
+		bool AddSimpleCollisionToAggregate(const FString& SplitGroupName, FKAggregateGeom& AggCollisions) const;
 		
 		// Helper functions to generate the simple colliders and add them to the aggregate
 		static int32 GenerateBoxAsSimpleCollision(const TArray<FVector>& InPositionArray, FKAggregateGeom& OutAggregateCollisions);
@@ -381,11 +465,24 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 		static bool HasFracturePieceAttribute(const HAPI_NodeId& GeoId, const HAPI_NodeId& PartId);
 	protected:
 
+		// Updates the components, notifications and packages of static meshes that have just been built
+		static void FinalizeStaticMeshBuilds(const TArray<UStaticMesh*>& InStaticMeshes);
+
+		// Nesting depth of the active deferred builds, and the static meshes waiting to be built
+		static int32 DeferredStaticMeshBuildDepth;
+		static TArray<TWeakObjectPtr<UStaticMesh>> DeferredStaticMeshBuilds;
+
 		// Data cache for this translator
 
 		// The HoudiniGeoPartObject we're working on
 		FHoudiniGeoPartObject HGPO;
 
+		// Indicates the part caches have been filled by PrefetchPartData()
+		bool bHasPrefetchedPartData = false;
+
+		// Attributes fetched by PrefetchPartData(), the others are still fetched on demand
+		EHoudiniPartCacheAttribute PrefetchedPartAttributes = EHoudiniPartCacheAttribute::None;
+
 		// Outer object for attaching components to
 		UObject* OuterComponent = nullptr;
 
@@ -418,6 +515,9 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 		// The generated simple/UCX colliders
 		TMap <FHoudiniOutputObjectIdentifier, FKAggregateGeom> AllAggregateCollisions;
 
+		// Per-split colliders created by BuildAllSplitCollisions(), the splits that failed are not in the map
+		TMap<FString, FKAggregateGeom> AllSplitCollisions;
+
 		// Names of the groups used for splitting the geometry
 		TArray<FString> AllSplitGroups;
 
@@ -70,6 +70,22 @@
 
 #define LOCTEXT_NAMESPACE HOUDINI_LOCTEXT_NAMESPACE
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineParallelOutputFetch(
+	TEXT("HoudiniEngine.ParallelOutputFetch"),
+	1,
+	TEXT("When enabled, the HAPI data of all the mesh parts that changed is fetched concurrently before any output object is created.\n")
+	TEXT("0: Fetch each part's data while creating its outputs\n")
+	TEXT("1: Fetch all the parts first, then create the outputs (default)\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEnginePrefetchPartStrings(
+	TEXT("HoudiniEngine.PrefetchPartStrings"),
+	1,
+	TEXT("When enabled, the values of all the string attributes of a part that changed are resolved in a single batch before the part is processed.\n")
+	TEXT("0: Resolve the strings of each attribute when it is read\n")
+	TEXT("1: Prefetch the strings of all the string attributes (default)\n")
+);
+
 //
 bool
 FHoudiniOutputTranslator::UpdateOutputs(
@@ -254,6 +270,62 @@ FHoudiniOutputTranslator::UpdateOutputs(
 	TArray<ALandscapeProxy *> AllInputLandscapes;
 	FHoudiniEngineUtils::GatherLandscapeInputs(HAC, AllInputLandscapes);
 
+	// Proxy meshes are disabled when instancing more than one instance of a mesh part
+	auto IsProxyStaticMeshEnabledForOutput = [&](const UHoudiniOutput* InOutput)
+	{
+		bool bIsProxyStaticMeshEnabled = (
+			HAC->IsProxyStaticMeshEnabled() &&
+			!HAC->HasNoProxyMeshNextCookBeenRequested() &&
+			!HAC->IsBakeAfterNextCookEnabled());
+		if (bIsProxyStaticMeshEnabled && NumInstances > 1)
+		{
+			if (bHasObjectInstancer)
+			{
+				// Completely disable proxies if we have object instancers/old school attribute instancers
+				// as they rely on having a static mesh created (and the instanced mesh HGPO is not marked as instanced...)
+				bIsProxyStaticMeshEnabled = false;
+			}
+			else
+			{
+				// If we dont have proxy instancer, enable proxy only for non-instanced mesh
+				for (const FHoudiniGeoPartObject &HGPO : InOutput->GetHoudiniGeoPartObjects())
+				{
+					if (HGPO.bIsInstanced && HGPO.Type == EHoudiniPartType::Mesh)
+					{
+						bIsProxyStaticMeshEnabled = false;
+						break;
+					}
+				}
+			}
+		}
+		return bIsProxyStaticMeshEnabled;
+	};
+
+	// ----------------------------------------------------
+	// Fetch the mesh parts' data
+	// ----------------------------------------------------
+	// The outputs are built in two phases: the HAPI data of all the mesh parts that changed is first
+	// fetched concurrently into the mesh translators' part caches, the UObjects are then created
+	// from those buffers on the game thread by the loop below.
+	FHoudiniMeshPrefetchedParts PrefetchedMeshParts;
+	if (CVarHoudiniEngineParallelOutputFetch.GetValueOnGameThread() != 0)
+	{
+		TArray<TPair<UHoudiniOutput*, EHoudiniStaticMeshMethod>> MeshOutputs;
+		for (UHoudiniOutput* CurOutput : HAC->Outputs)
+		{
+			if (!IsValid(CurOutput) || CurOutput->GetType() != EHoudiniOutputType::Mesh)
+				continue;
+
+			if (!HAC->IsOutputTypeSupported(CurOutput->GetType()))
+				continue;
+
+			MeshOutputs.Add(TPair<UHoudiniOutput*, EHoudiniStaticMeshMethod>(
+				CurOutput, IsProxyStaticMeshEnabledForOutput(CurOutput) ? EHoudiniStaticMeshMethod::UHoudiniStaticMesh : HAC->StaticMeshMethod));
+		}
+
+		FHoudiniMeshTranslator::PrefetchMeshPartData(MeshOutputs, FPlatformProcess::SupportsMultithreading(), PrefetchedMeshParts);
+	}
+
 	// ----------------------------------------------------
 	// Process outputs
 	// ----------------------------------------------------
@@ -287,32 +359,7 @@ FHoudiniOutputTranslator::UpdateOutputs(
 		{
 			case EHoudiniOutputType::Mesh:
 			{
-				bool bIsProxyStaticMeshEnabled = (
-					HAC->IsProxyStaticMeshEnabled() &&
-					!HAC->HasNoProxyMeshNextCookBeenRequested() &&
-					!HAC->IsBakeAfterNextCookEnabled());
-				if (bIsProxyStaticMeshEnabled && NumInstances > 1)
-				{
-					if (bHasObjectInstancer)
-					{
-						// Completely disable proxies if we have object instancers/old school attribute instancers
-						// as they rely on having a static mesh created (and the instanced mesh HGPO is not marked as instanced...)
-						bIsProxyStaticMeshEnabled = false;
-					}
-					else
-					{
-						// If we dont have proxy instancer, enable proxy only for non-instanced mesh
-						for (const FHoudiniGeoPartObject &HGPO : CurOutput->GetHoudiniGeoPartObjects())
-						{
-							if (HGPO.bIsInstanced && HGPO.Type == EHoudiniPartType::Mesh)
-							{
-								bIsProxyStaticMeshEnabled = false;
-								break;
-							}
-						}
-					}
-				}
-
+				const bool bIsProxyStaticMeshEnabled = IsProxyStaticMeshEnabledForOutput(CurOutput);
 				FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput(
 					CurOutput, 
 					PackageParams, 
@@ -320,7 +367,10 @@ FHoudiniOutputTranslator::UpdateOutputs(
 					HAC->StaticMeshGenerationProperties,
 					HAC->StaticMeshBuildSettings,
 					AllOutputMaterials,
-					OuterComponent);
+					OuterComponent,
+					false,
+					false,
+					&PrefetchedMeshParts);
 
 				NumVisibleOutputs++;
 
@@ -672,6 +722,22 @@ FHoudiniOutputTranslator::BuildStaticMeshesOnHoudiniProxyMeshOutputs(UHoudiniAss
 	// Keep track of all generated houdini materials to avoid recreating them over and over
 	TMap<FString, UMaterialInterface*> AllOutputMaterials;
 
+	const EHoudiniStaticMeshMethod StaticMeshMethod = HAC->StaticMeshMethod != EHoudiniStaticMeshMethod::UHoudiniStaticMesh ? HAC->StaticMeshMethod : EHoudiniStaticMeshMethod::RawMesh;
+
+	// Fetch the data of all the proxied parts concurrently before building their static meshes
+	FHoudiniMeshPrefetchedParts PrefetchedMeshParts;
+	if (CVarHoudiniEngineParallelOutputFetch.GetValueOnGameThread() != 0)
+	{
+		TArray<TPair<UHoudiniOutput*, EHoudiniStaticMeshMethod>> MeshOutputs;
+		for (UHoudiniOutput* CurOutput : HAC->Outputs)
+		{
+			if (IsValid(CurOutput) && CurOutput->GetType() == EHoudiniOutputType::Mesh && CurOutput->HasAnyCurrentProxy())
+				MeshOutputs.Add(TPair<UHoudiniOutput*, EHoudiniStaticMeshMethod>(CurOutput, StaticMeshMethod));
+		}
+
+		FHoudiniMeshTranslator::PrefetchMeshPartData(MeshOutputs, FPlatformProcess::SupportsMultithreading(), PrefetchedMeshParts);
+	}
+
 	bool bFoundProxies = false;
 	TArray<UHoudiniOutput*> InstancerOutputs;
 	for (auto& CurOutput : HAC->Outputs)
@@ -685,13 +751,14 @@ FHoudiniOutputTranslator::BuildStaticMeshesOnHoudiniProxyMeshOutputs(UHoudiniAss
 				FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput(
 					CurOutput,
 					PackageParams,
-					HAC->StaticMeshMethod != EHoudiniStaticMeshMethod::UHoudiniStaticMesh ? HAC->StaticMeshMethod : EHoudiniStaticMeshMethod::RawMesh,
+					StaticMeshMethod,
 					HAC->StaticMeshGenerationProperties,
 					HAC->StaticMeshBuildSettings,
 					AllOutputMaterials,
 					OuterComponent,
 					true,  // bInTreatExistingMaterialsAsUpToDate
-					bInDestroyProxies
+					bInDestroyProxies,
+					&PrefetchedMeshParts
 				);  
 			}
 		}
@@ -1527,6 +1594,10 @@ FHoudiniOutputTranslator::BuildAllOutputs(
 					continue;
 				}
 				
+				// Resolve all the string attributes' values at once (material paths, level paths, instance references...)
+				if (CurrentHapiGeoInfo.hasGeoChanged && CVarHoudiniEnginePrefetchPartStrings.GetValueOnGameThread() > 0)
+					FHoudiniEngineUtils::HapiPrefetchPartStringAttributes(CurrentHapiGeoInfo.nodeId, CurrentHapiPartInfo.id, CurrentHapiPartInfo);
+
 				// Extract Mesh sockets
 				// Do this before ignoring invalid parts, as socket groups/attributes could be set on parts
 				// that don't have any mesh, just points! Those would be be considered "invalid" parts but
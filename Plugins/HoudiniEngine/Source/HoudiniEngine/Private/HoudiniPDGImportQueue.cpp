@@ -0,0 +1,225 @@
+/*
+* Copyright (c) <2021> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "HoudiniPDGImportQueue.h"
+
+bool
+FHoudiniPDGImportQueue::IsSameRequest(const FHoudiniPDGImportBGEOMessage& InA, const FHoudiniPDGImportBGEOMessage& InB)
+{
+	return InA.TOPNodeId == InB.TOPNodeId && InA.WorkItemId == InB.WorkItemId && InA.Name == InB.Name;
+}
+
+void
+FHoudiniPDGImportQueue::Enqueue(const FHoudiniPDGImportBGEOMessage& InRequest)
+{
+	// Start counting progress again for this new batch of imports
+	if (IsIdle())
+	{
+		NumQueued = 0;
+		NumCompleted = 0;
+		NumFailed = 0;
+	}
+
+	FRequest* Existing = Pending.FindByPredicate([&InRequest](const FRequest& Request)
+	{
+		return IsSameRequest(Request.Message, InRequest);
+	});
+
+	if (Existing)
+	{
+		Existing->Message = InRequest;
+		Existing->NumAttempts = 0;
+		return;
+	}
+
+	// A worker is already importing this result object: its result would be applied, then this request's result
+	// would find the result object already loaded. Supersede it, the new request takes its place in the progress.
+	bool bSupersededInFlight = false;
+	for (auto& WorkerRequests : InFlight)
+	{
+		for (FRequest& Request : WorkerRequests.Value)
+		{
+			if (!Request.bSuperseded && IsSameRequest(Request.Message, InRequest))
+			{
+				Request.bSuperseded = true;
+				bSupersededInFlight = true;
+			}
+		}
+	}
+
+	FRequest& NewRequest = Pending.AddDefaulted_GetRef();
+	NewRequest.Message = InRequest;
+	if (!bSupersededInFlight)
+		NumQueued++;
+}
+
+void
+FHoudiniPDGImportQueue::AddWorker(const FGuid& InWorkerGuid)
+{
+	InFlight.FindOrAdd(InWorkerGuid);
+}
+
+void
+FHoudiniPDGImportQueue::RemoveWorker(const FGuid& InWorkerGuid, TArray<FHoudiniPDGImportBGEOMessage>& OutFailedRequests)
+{
+	TArray<FRequest> WorkerRequests;
+	if (!InFlight.RemoveAndCopyValue(InWorkerGuid, WorkerRequests))
+		return;
+
+	// Requeue in front, in their original order, so they are not delayed behind the rest of the queue
+	TArray<FRequest> Requeued;
+	Requeued.Reserve(WorkerRequests.Num());
+	for (FRequest& Request : WorkerRequests)
+	{
+		// Its replacement is already queued
+		if (Request.bSuperseded)
+			continue;
+
+		if (Request.NumAttempts >= MaxAttempts)
+		{
+			OutFailedRequests.Add(MoveTemp(Request.Message));
+			NumFailed++;
+		}
+		else
+		{
+			Requeued.Add(MoveTemp(Request));
+		}
+	}
+
+	if (Requeued.Num() > 0)
+		Pending.Insert(MoveTemp(Requeued), 0);
+}
+
+int32
+FHoudiniPDGImportQueue::Dispatch(
+	const TArray<FGuid>& InReadyWorkers,
+	const int32 InMaxInFlightPerWorker,
+	TArray<TPair<FGuid, FHoudiniPDGImportBGEOMessage>>& OutDispatched)
+{
+	int32 NumDispatched = 0;
+	while (NumDispatched < Pending.Num())
+	{
+		// Find the least loaded worker that can take another request
+		TArray<FRequest>* BestWorkerRequests = nullptr;
+		const FGuid* BestWorkerGuid = nullptr;
+		for (const FGuid& WorkerGuid : InReadyWorkers)
+		{
+			TArray<FRequest>* WorkerRequests = InFlight.Find(WorkerGuid);
+			if (!WorkerRequests)
+				continue;
+
+			if (InMaxInFlightPerWorker > 0 && WorkerRequests->Num() >= InMaxInFlightPerWorker)
+				continue;
+
+			if (!BestWorkerRequests || WorkerRequests->Num() < BestWorkerRequests->Num())
+			{
+				BestWorkerRequests = WorkerRequests;
+				BestWorkerGuid = &WorkerGuid;
+			}
+		}
+
+		if (!BestWorkerRequests)
+			break;
+
+		FRequest& Request = Pending[NumDispatched++];
+		Request.NumAttempts++;
+		OutDispatched.Emplace(*BestWorkerGuid, Request.Message);
+		BestWorkerRequests->Add(MoveTemp(Request));
+	}
+
+	// Remove the dispatched requests in one go, to keep dispatching linear in the size of the queue
+	if (NumDispatched > 0)
+		Pending.RemoveAt(0, NumDispatched);
+
+	return NumDispatched;
+}
+
+bool
+FHoudiniPDGImportQueue::Complete(const FGuid& InWorkerGuid, const FHoudiniPDGImportBGEOMessage& InRequest, const bool& bInSuccess)
+{
+	TArray<FRequest>* WorkerRequests = InFlight.Find(InWorkerGuid);
+	if (!WorkerRequests)
+		return false;
+
+	const int32 Index = WorkerRequests->IndexOfByPredicate([&InRequest](const FRequest& Request)
+	{
+		return IsSameRequest(Request.Message, InRequest);
+	});
+
+	if (Index == INDEX_NONE)
+		return false;
+
+	const bool bSuperseded = (*WorkerRequests)[Index].bSuperseded;
+	WorkerRequests->RemoveAt(Index);
+	if (bSuperseded)
+		return false;
+
+	if (bInSuccess)
+		NumCompleted++;
+	else
+		NumFailed++;
+
+	return true;
+}
+
+void
+FHoudiniPDGImportQueue::TakePending(TArray<FHoudiniPDGImportBGEOMessage>& OutRequests)
+{
+	OutRequests.Reserve(OutRequests.Num() + Pending.Num());
+	for (FRequest& Request : Pending)
+		OutRequests.Add(MoveTemp(Request.Message));
+
+	NumQueued -= Pending.Num();
+	Pending.Empty();
+}
+
+void
+FHoudiniPDGImportQueue::Reset()
+{
+	Pending.Empty();
+	InFlight.Empty();
+	NumQueued = 0;
+	NumCompleted = 0;
+	NumFailed = 0;
+}
+
+int32
+FHoudiniPDGImportQueue::GetNumInFlight() const
+{
+	int32 NumInFlight = 0;
+	for (const auto& Entry : InFlight)
+		NumInFlight += Entry.Value.Num();
+
+	return NumInFlight;
+}
+
+int32
+FHoudiniPDGImportQueue::GetNumInFlight(const FGuid& InWorkerGuid) const
+{
+	const TArray<FRequest>* WorkerRequests = InFlight.Find(InWorkerGuid);
+	return WorkerRequests ? WorkerRequests->Num() : 0;
+}
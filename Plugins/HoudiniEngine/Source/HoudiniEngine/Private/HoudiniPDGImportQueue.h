@@ -0,0 +1,106 @@
+/*
+* Copyright (c) <2021> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Guid.h"
+
+#include "HoudiniPDGImporterMessages.h"
+
+// Work item result objects waiting to be imported by the BGEO commandlets, and the ones each commandlet is
+// currently importing.
+// Requests are dispatched to the least loaded workers, with a bounded number of requests in flight per worker so
+// that the rest of the queue can still go to other workers, or be reassigned if a worker stops.
+struct HOUDINIENGINE_API FHoudiniPDGImportQueue
+{
+public:
+
+	// Number of times a request is reassigned after the worker importing it stopped, before it is failed.
+	static constexpr int32 MaxAttempts = 2;
+
+	// Queue the import of a work item result object. A request for the same result object that is still waiting
+	// for a worker is replaced. If one is being imported, it is superseded: the new request is queued, and the
+	// result of the superseded one will be discarded.
+	void Enqueue(const FHoudiniPDGImportBGEOMessage& InRequest);
+
+	// Register a worker that requests can be dispatched to
+	void AddWorker(const FGuid& InWorkerGuid);
+
+	// Unregister a worker: its requests go back to the front of the queue. Requests that already failed
+	// MaxAttempts times are removed and returned in OutFailedRequests, superseded requests are dropped.
+	void RemoveWorker(const FGuid& InWorkerGuid, TArray<FHoudiniPDGImportBGEOMessage>& OutFailedRequests);
+
+	bool HasWorker(const FGuid& InWorkerGuid) const { return InFlight.Contains(InWorkerGuid); }
+
+	// Assign queued requests to the given workers, least loaded first, with at most InMaxInFlightPerWorker
+	// requests in flight per worker (no limit if <= 0). Returns the number of dispatched requests.
+	int32 Dispatch(
+		const TArray<FGuid>& InReadyWorkers,
+		const int32 InMaxInFlightPerWorker,
+		TArray<TPair<FGuid, FHoudiniPDGImportBGEOMessage>>& OutDispatched);
+
+	// Mark a request as done by a worker. Returns false if the worker was not importing this request, or if the
+	// request was superseded: its result must then be discarded.
+	bool Complete(const FGuid& InWorkerGuid, const FHoudiniPDGImportBGEOMessage& InRequest, const bool& bInSuccess);
+
+	// Remove all the requests that are waiting for a worker
+	void TakePending(TArray<FHoudiniPDGImportBGEOMessage>& OutRequests);
+
+	// Remove everything, workers included
+	void Reset();
+
+	int32 GetNumPending() const { return Pending.Num(); }
+	int32 GetNumInFlight() const;
+	int32 GetNumInFlight(const FGuid& InWorkerGuid) const;
+
+	// Progress since the queue was last idle
+	int32 GetNumCompleted() const { return NumCompleted; }
+	int32 GetNumFailed() const { return NumFailed; }
+	int32 GetNumQueued() const { return NumQueued; }
+
+	bool IsIdle() const { return GetNumPending() == 0 && GetNumInFlight() == 0; }
+
+	static bool IsSameRequest(const FHoudiniPDGImportBGEOMessage& InA, const FHoudiniPDGImportBGEOMessage& InB);
+
+private:
+
+	struct FRequest
+	{
+		FHoudiniPDGImportBGEOMessage Message;
+		int32 NumAttempts = 0;
+		// The same result object was queued again while this request was in flight
+		bool bSuperseded = false;
+	};
+
+	TArray<FRequest> Pending;
+	TMap<FGuid, TArray<FRequest>> InFlight;
+
+	int32 NumQueued = 0;
+	int32 NumCompleted = 0;
+	int32 NumFailed = 0;
+};
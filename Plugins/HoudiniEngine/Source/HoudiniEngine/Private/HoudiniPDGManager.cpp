@@ -29,6 +29,7 @@
 #include "Modules/ModuleManager.h"
 #include "MessageEndpointBuilder.h"
 #include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
 
 #include "HoudiniApi.h"
 #include "HoudiniAsset.h"
@@ -52,6 +53,24 @@ HOUDINI_PDG_DEFINE_LOG_CATEGORY();
 
 #define LOCTEXT_NAMESPACE HOUDINI_LOCTEXT_NAMESPACE
 
+static TAutoConsoleVariable<int32> CVarHoudiniEnginePDGResultLoadsPerTick(
+	TEXT("HoudiniEngine.PDGResultLoadsPerTick"),
+	4,
+	TEXT("Maximum number of work item results turned into outputs per tick of the PDG manager, either loaded\n")
+	TEXT("directly or from the async importer's results. The remaining results are processed on the next ticks.\n")
+	TEXT("<= 0: No limit\n")
+	TEXT("4: Default\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEnginePDGImportsPerWorker(
+	TEXT("HoudiniEngine.PDGImportsPerWorker"),
+	2,
+	TEXT("Maximum number of work item results sent to each async importer commandlet at once.\n")
+	TEXT("The other results wait in a queue, and are sent to the first importer that is done.\n")
+	TEXT("<= 0: No limit\n")
+	TEXT("2: Default\n")
+);
+
 FHoudiniPDGManager::FHoudiniPDGManager()
 {
 }
@@ -1655,6 +1674,22 @@ FHoudiniPDGManager::ProcessWorkItemResults()
 	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniPDGManager::ProcessWorkItemResults);
 
 	const EHoudiniBGEOCommandletStatus CommandletStatus = UpdateAndGetBGEOCommandletStatus();
+
+	// Results are turned into outputs on the game thread in bounded batches, so that networks producing thousands
+	// of work items do not stall the editor.
+	const int32 MaxResultLoads = CVarHoudiniEnginePDGResultLoadsPerTick.GetValueOnGameThread();
+	int32 NumResultLoads = 0;
+
+	// First, results that were imported by the commandlets
+	int32 NumAppliedResults = 0;
+	while (NumAppliedResults < PendingBGEOImportResults.Num() && (MaxResultLoads <= 0 || NumResultLoads < MaxResultLoads))
+	{
+		ApplyImportBGEOResult(PendingBGEOImportResults[NumAppliedResults++]);
+		NumResultLoads++;
+	}
+	if (NumAppliedResults > 0)
+		PendingBGEOImportResults.RemoveAt(0, NumAppliedResults);
+
 	for (auto& CurrentPDGAssetLink : PDGAssetLinks)
 	{
 		// Iterate through all PDG Asset Link
@@ -1740,6 +1775,12 @@ FHoudiniPDGManager::ProcessWorkItemResults()
 						FTOPWorkResultObject& CurrentWorkResultObj = CurrentWorkResult.ResultObjects[WorkResultObjectArrayIndex];
 						if (CurrentWorkResultObj.State == EPDGWorkResultState::ToLoad)
 						{
+							// Results loaded directly are limited per tick, the others stay in ToLoad until the next
+							// ticks. Results sent to the commandlets are only queued here.
+							const bool bUseCommandlets = (CommandletStatus == EHoudiniBGEOCommandletStatus::Connected);
+							if (!bUseCommandlets && MaxResultLoads > 0 && NumResultLoads >= MaxResultLoads)
+								continue;
+
 							CurrentWorkResultObj.State = EPDGWorkResultState::Loading;
 
 							// Load this WRObj
@@ -1750,9 +1791,9 @@ FHoudiniPDGManager::ProcessWorkItemResults()
 							// CurrentWorkResult.WorkItemIndex is not necessarily unique)
 							PackageParams.PDGWorkResultArrayIndex = WorkResultArrayIndex;
 
-							if (CommandletStatus == EHoudiniBGEOCommandletStatus::Connected)
+							if (bUseCommandlets)
 							{
-								BGEOCommandletEndpoint->Send(new FHoudiniPDGImportBGEOMessage(
+								BGEOImportQueue.Enqueue(FHoudiniPDGImportBGEOMessage(
 									CurrentWorkResultObj.FilePath,
 									CurrentWorkResultObj.Name,
 									PackageParams,
@@ -1760,10 +1801,11 @@ FHoudiniPDGManager::ProcessWorkItemResults()
 									CurrentWorkResult.WorkItemID,
 									StaticMeshGenerationProperties,
 									MeshBuildSettings
-								), BGEOCommandletAddress);
+								));
 							}
 							else
 							{
+								NumResultLoads++;
 								if (FHoudiniPDGTranslator::CreateAllResultObjectsForPDGWorkItem(
 									AssetLink,
 									CurrentTOPNode,
@@ -1821,6 +1863,38 @@ FHoudiniPDGManager::ProcessWorkItemResults()
 			}
 		}
 	}
+
+	if (BGEOImportQueue.GetNumPending() > 0)
+	{
+		if (CommandletStatus == EHoudiniBGEOCommandletStatus::Connected)
+		{
+			// Send the queued results to the least busy connected commandlets
+			TArray<FGuid> ReadyWorkers;
+			for (const FHoudiniBGEOCommandletWorker& Worker : BGEOCommandletWorkers)
+			{
+				if (Worker.Status == EHoudiniBGEOCommandletStatus::Connected)
+					ReadyWorkers.Add(Worker.Guid);
+			}
+
+			TArray<TPair<FGuid, FHoudiniPDGImportBGEOMessage>> Dispatched;
+			BGEOImportQueue.Dispatch(ReadyWorkers, CVarHoudiniEnginePDGImportsPerWorker.GetValueOnGameThread(), Dispatched);
+			for (const TPair<FGuid, FHoudiniPDGImportBGEOMessage>& Entry : Dispatched)
+			{
+				const FHoudiniBGEOCommandletWorker* Worker = BGEOCommandletWorkers.FindByPredicate(
+					[&Entry](const FHoudiniBGEOCommandletWorker& InWorker) { return InWorker.Guid == Entry.Key; });
+				if (Worker)
+					BGEOCommandletEndpoint->Send(new FHoudiniPDGImportBGEOMessage(Entry.Value), Worker->Address);
+			}
+		}
+		else if (CommandletStatus != EHoudiniBGEOCommandletStatus::Running)
+		{
+			// No commandlet left to import the queued results: load them directly instead
+			TArray<FHoudiniPDGImportBGEOMessage> Requests;
+			BGEOImportQueue.TakePending(Requests);
+			HOUDINI_LOG_WARNING(TEXT("PDG: No async importer available, loading %d queued work item results directly."), Requests.Num());
+			ResetImportWorkResultObjects(Requests, EPDGWorkResultState::ToLoad);
+		}
+	}
 }
 
 void FHoudiniPDGManager::HandleImportBGEODiscoverMessage(
@@ -1828,15 +1902,19 @@ void FHoudiniPDGManager::HandleImportBGEODiscoverMessage(
 	const TSharedRef<IMessageContext, ESPMode::ThreadSafe>& InContext)
 {
 	HOUDINI_LOG_DISPLAY(TEXT("Received Discover from %s"), *InContext->GetSender().ToString());
+	if (!InMessage.CommandletGuid.IsValid())
+		return;
+
+	FHoudiniBGEOCommandletWorker* Worker = BGEOCommandletWorkers.FindByPredicate(
+		[&InMessage](const FHoudiniBGEOCommandletWorker& InWorker) { return InWorker.Guid == InMessage.CommandletGuid; });
+
 	// Ignore any discover acks received if we already have a valid local address
 	// for the commandlet
-	if (BGEOCommandletAddress.IsValid())
+	if (!Worker || Worker->Address.IsValid() || !Worker->ProcHandle.IsValid())
 		return;
 
-	if (BGEOCommandletProcHandle.IsValid() && InMessage.CommandletGuid.IsValid() && BGEOCommandletGuid == InMessage.CommandletGuid)
-	{
-		BGEOCommandletAddress = InContext->GetSender();
-	}
+	Worker->Address = InContext->GetSender();
+	BGEOImportQueue.AddWorker(Worker->Guid);
 }
 
 void FHoudiniPDGManager::HandleImportBGEOResultMessage(
@@ -1844,49 +1922,110 @@ void FHoudiniPDGManager::HandleImportBGEOResultMessage(
 	const TSharedRef<IMessageContext, ESPMode::ThreadSafe>& InContext)
 {
 	HOUDINI_LOG_MESSAGE(TEXT("Received BGEO import result message"));
-	if (InMessage.ImportResult == EHoudiniPDGImportBGEOResult::HPIBR_Success || InMessage.ImportResult == EHoudiniPDGImportBGEOResult::HPIBR_PartialSuccess)
+
+	const bool bSuccess = (InMessage.ImportResult == EHoudiniPDGImportBGEOResult::HPIBR_Success || InMessage.ImportResult == EHoudiniPDGImportBGEOResult::HPIBR_PartialSuccess);
+
+	// Free the commandlet's slot right away, so it gets its next result on the next tick
+	const FMessageAddress& Sender = InContext->GetSender();
+	const FHoudiniBGEOCommandletWorker* Worker = BGEOCommandletWorkers.FindByPredicate(
+		[&Sender](const FHoudiniBGEOCommandletWorker& InWorker) { return InWorker.Address == Sender; });
+	// A result for a request this worker no longer owns (superseded by a newer request for the same result
+	// object, or requeued after the worker was removed) would be applied twice: discard it.
+	if (Worker && !BGEOImportQueue.Complete(Worker->Guid, InMessage, bSuccess))
 	{
-		FHoudiniPackageParams PackageParams;
-		InMessage.PopulatePackageParams(PackageParams);
+		HOUDINI_LOG_MESSAGE(TEXT("PDG: Discarding stale BGEO import result for work item %d."), InMessage.WorkItemId);
+		return;
+	}
 
-		// Find asset link and work result object
-		UHoudiniPDGAssetLink *AssetLink = nullptr;
-		UTOPNetwork *TOPNetwork = nullptr;
-		UTOPNode *TOPNode = nullptr;
-		if (!GetTOPAssetLinkNetworkAndNode(InMessage.TOPNodeId, AssetLink, TOPNetwork, TOPNode) ||
-			!IsValid(AssetLink) || !IsValid(TOPNode))
-		{
-			HOUDINI_LOG_WARNING(TEXT("Failed to find TOP node with id %d, aborting output object creation."), InMessage.TOPNodeId);
-			return;
-		}
+	const int32 NumDone = BGEOImportQueue.GetNumCompleted() + BGEOImportQueue.GetNumFailed();
+	HOUDINI_LOG_MESSAGE(
+		TEXT("PDG: Async importer processed %d/%d work item results (%d failed)."),
+		NumDone, BGEOImportQueue.GetNumQueued(), BGEOImportQueue.GetNumFailed());
 
-		FTOPWorkResult* WorkResult = nullptr;
-		const int32 WorkResultArrayIndex = TOPNode->ArrayIndexOfWorkResultByID(InMessage.WorkItemId);
-		if (WorkResultArrayIndex != INDEX_NONE)
-			WorkResult = TOPNode->GetWorkResultByArrayIndex(WorkResultArrayIndex);
-		if (WorkResult == nullptr)
-		{
-			HOUDINI_LOG_WARNING(TEXT("Failed to find TOP work result with id %d, aborting output object creation."), InMessage.WorkItemId);
-			return;
-		}
-		const FString& WorkResultObjectName = InMessage.Name;
-		FTOPWorkResultObject* WorkResultObject = WorkResult->ResultObjects.FindByPredicate(
-			[&WorkResultObjectName](const FTOPWorkResultObject& WorkResultObject) 
-			{ 
-				return WorkResultObject.Name == WorkResultObjectName; 
-			}
-		);
-		if (WorkResultObject == nullptr)
-		{
-			HOUDINI_LOG_WARNING(TEXT("Failed to find TOP work result object with name %s, aborting output object creation."), *InMessage.Name);
-			return;
-		}
+	// The outputs are created later, in bounded batches, by ProcessWorkItemResults
+	PendingBGEOImportResults.Add(InMessage);
+}
 
-		if (WorkResultObject->State != EPDGWorkResultState::Loading)
-		{
-			HOUDINI_LOG_WARNING(TEXT("TOP work result object (%s) not in Loading state, aborting output object creation."), *InMessage.Name);
-			return;
+FTOPWorkResultObject*
+FHoudiniPDGManager::FindImportWorkResultObject(
+	const FHoudiniPDGImportBGEOMessage& InMessage,
+	UHoudiniPDGAssetLink*& OutAssetLink,
+	UTOPNode*& OutTOPNode,
+	int32& OutWorkResultArrayIndex)
+{
+	// Find asset link and work result object
+	OutAssetLink = nullptr;
+	OutTOPNode = nullptr;
+	OutWorkResultArrayIndex = INDEX_NONE;
+	UTOPNetwork *TOPNetwork = nullptr;
+	if (!GetTOPAssetLinkNetworkAndNode(InMessage.TOPNodeId, OutAssetLink, TOPNetwork, OutTOPNode) ||
+		!IsValid(OutAssetLink) || !IsValid(OutTOPNode))
+	{
+		HOUDINI_LOG_WARNING(TEXT("Failed to find TOP node with id %d, aborting output object creation."), InMessage.TOPNodeId);
+		return nullptr;
+	}
+
+	FTOPWorkResult* WorkResult = nullptr;
+	OutWorkResultArrayIndex = OutTOPNode->ArrayIndexOfWorkResultByID(InMessage.WorkItemId);
+	if (OutWorkResultArrayIndex != INDEX_NONE)
+		WorkResult = OutTOPNode->GetWorkResultByArrayIndex(OutWorkResultArrayIndex);
+	if (WorkResult == nullptr)
+	{
+		HOUDINI_LOG_WARNING(TEXT("Failed to find TOP work result with id %d, aborting output object creation."), InMessage.WorkItemId);
+		return nullptr;
+	}
+	const FString& WorkResultObjectName = InMessage.Name;
+	FTOPWorkResultObject* WorkResultObject = WorkResult->ResultObjects.FindByPredicate(
+		[&WorkResultObjectName](const FTOPWorkResultObject& WorkResultObject) 
+		{ 
+			return WorkResultObject.Name == WorkResultObjectName; 
 		}
+	);
+	if (WorkResultObject == nullptr)
+	{
+		HOUDINI_LOG_WARNING(TEXT("Failed to find TOP work result object with name %s, aborting output object creation."), *InMessage.Name);
+		return nullptr;
+	}
+
+	return WorkResultObject;
+}
+
+void
+FHoudiniPDGManager::ResetImportWorkResultObjects(const TArray<FHoudiniPDGImportBGEOMessage>& InRequests, const EPDGWorkResultState& InState)
+{
+	for (const FHoudiniPDGImportBGEOMessage& Request : InRequests)
+	{
+		UHoudiniPDGAssetLink* AssetLink = nullptr;
+		UTOPNode* TOPNode = nullptr;
+		int32 WorkResultArrayIndex = INDEX_NONE;
+		FTOPWorkResultObject* WorkResultObject = FindImportWorkResultObject(Request, AssetLink, TOPNode, WorkResultArrayIndex);
+		if (WorkResultObject && WorkResultObject->State == EPDGWorkResultState::Loading)
+			WorkResultObject->State = InState;
+	}
+}
+
+void
+FHoudiniPDGManager::ApplyImportBGEOResult(const FHoudiniPDGImportBGEOResultMessage& InMessage)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniPDGManager::ApplyImportBGEOResult);
+
+	UHoudiniPDGAssetLink* AssetLink = nullptr;
+	UTOPNode* TOPNode = nullptr;
+	int32 WorkResultArrayIndex = INDEX_NONE;
+	FTOPWorkResultObject* WorkResultObject = FindImportWorkResultObject(InMessage, AssetLink, TOPNode, WorkResultArrayIndex);
+	if (!WorkResultObject)
+		return;
+
+	if (WorkResultObject->State != EPDGWorkResultState::Loading)
+	{
+		HOUDINI_LOG_WARNING(TEXT("TOP work result object (%s) not in Loading state, aborting output object creation."), *InMessage.Name);
+		return;
+	}
+
+	if (InMessage.ImportResult == EHoudiniPDGImportBGEOResult::HPIBR_Success || InMessage.ImportResult == EHoudiniPDGImportBGEOResult::HPIBR_PartialSuccess)
+	{
+		FHoudiniPackageParams PackageParams;
+		InMessage.PopulatePackageParams(PackageParams);
 
 		// Set package params outer
 		UObject* AssetLinkParent = AssetLink->GetOuter();
@@ -2076,7 +2215,10 @@ void FHoudiniPDGManager::HandleImportBGEOResultMessage(
 	}
 	else
 	{
-		HOUDINI_LOG_WARNING(TEXT("Commandlet failed to import bgeo for %s"), *InMessage.Name);
+		WorkResultObject->State = EPDGWorkResultState::None;
+		HOUDINI_LOG_WARNING(
+			TEXT("Commandlet failed to import bgeo for %s (TOP node %d, work item %d)"),
+			*InMessage.Name, InMessage.TOPNodeId, InMessage.WorkItemId);
 	}
 }
 
@@ -2084,7 +2226,9 @@ bool FHoudiniPDGManager::CreateBGEOCommandletAndEndpoint()
 {
 	if (!BGEOCommandletEndpoint.IsValid())
 	{
-		BGEOCommandletAddress.Invalidate();
+		for (FHoudiniBGEOCommandletWorker& Worker : BGEOCommandletWorkers)
+			Worker.Address.Invalidate();
+
 		BGEOCommandletEndpoint = FMessageEndpoint::Builder(TEXT("Houdini BGEO Commandlet"))
 			.Handling<FHoudiniPDGImportBGEOResultMessage>(this, &FHoudiniPDGManager::HandleImportBGEOResultMessage)
 			.Handling<FHoudiniPDGImportBGEODiscoverMessage>(this, &FHoudiniPDGManager::HandleImportBGEODiscoverMessage)
@@ -2099,101 +2243,193 @@ bool FHoudiniPDGManager::CreateBGEOCommandletAndEndpoint()
 		BGEOCommandletEndpoint->Subscribe<FHoudiniPDGImportBGEODiscoverMessage>();
 	}
 
-	if (!BGEOCommandletProcHandle.IsValid() || !FPlatformProcess::IsProcRunning(BGEOCommandletProcHandle))
+	int32 NumWorkers = 1;
+	const UHoudiniRuntimeSettings* HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
+	if (IsValid(HoudiniRuntimeSettings))
+		NumWorkers = FMath::Clamp(HoudiniRuntimeSettings->PDGAsyncCommandletImportWorkers, 1, 16);
+
+	if (BGEOCommandletWorkers.Num() < NumWorkers)
+		BGEOCommandletWorkers.SetNum(NumWorkers);
+
+	bool bSuccess = true;
+	for (FHoudiniBGEOCommandletWorker& Worker : BGEOCommandletWorkers)
 	{
-		// Start the bgeo commandlet
-		static const FString BGEOCommandletName = TEXT("HoudiniGeoImport");
-		BGEOCommandletGuid = FGuid::NewGuid();
-		BGEOCommandletAddress.Invalidate();
+		if (Worker.ProcHandle.IsValid() && FPlatformProcess::IsProcRunning(Worker.ProcHandle))
+			continue;
 
-		// Get the absolute path to the project file, if known, otherwise get
-		// the project name. For the path: quote it for the command line.
-		IFileManager& FileManager = IFileManager::Get();
-		FString ProjectPathOrName = FApp::GetProjectName();
-		if (FPaths::IsProjectFilePathSet())
-		{
-			const FString ProjectPath = FPaths::GetProjectFilePath();
-			if (!ProjectPath.IsEmpty())
-			{
-				ProjectPathOrName = FString::Printf(
-                    TEXT("\"%s\""),
-                    *FileManager.ConvertToAbsolutePathForExternalAppForRead(*ProjectPath)
-                );
-			}
-		}
+		if (!StartBGEOCommandletWorker(Worker))
+			bSuccess = false;
+	}
 
-		if (ProjectPathOrName.IsEmpty())
-			return false;
+	return bSuccess;
+}
 
-		// Get the executable path for the app/editor
-		FString ExePath = FPlatformProcess::GenerateApplicationPath(FApp::GetName(), FApp::GetBuildConfiguration());
-		if (!ExePath.IsEmpty())
-			ExePath = FileManager.ConvertToAbsolutePathForExternalAppForRead(*ExePath);
+bool FHoudiniPDGManager::StartBGEOCommandletWorker(FHoudiniBGEOCommandletWorker& InWorker)
+{
+	// Requests sent to a previous process of this worker go back to the queue
+	if (InWorker.Guid.IsValid() && BGEOImportQueue.HasWorker(InWorker.Guid))
+	{
+		TArray<FHoudiniPDGImportBGEOMessage> FailedRequests;
+		BGEOImportQueue.RemoveWorker(InWorker.Guid, FailedRequests);
+		ResetImportWorkResultObjects(FailedRequests, EPDGWorkResultState::None);
+	}
 
-		if (ExePath.IsEmpty())
-			return false;
-		
-		const FString CommandLineParameters = FString::Printf(
-			TEXT("%s -messaging -run=%s -guid=%s -listen=%s -managerpid=%d"),
-			*ProjectPathOrName,
-			*BGEOCommandletName,
-			*BGEOCommandletGuid.ToString(),
-			*BGEOCommandletEndpoint->GetAddress().ToString(),
-			FPlatformProcess::GetCurrentProcessId());
-
-		BGEOCommandletProcHandle = FPlatformProcess::CreateProc(
-			*ExePath,
-			*CommandLineParameters,
-			false,
-			true,
-			false,
-			&BGEOCommandletProcessId,
-			0,
-			NULL,
-			NULL);
-		if (!BGEOCommandletProcHandle.IsValid())
+	// Start the bgeo commandlet
+	static const FString BGEOCommandletName = TEXT("HoudiniGeoImport");
+	InWorker.Guid = FGuid::NewGuid();
+	InWorker.Address.Invalidate();
+
+	// Get the absolute path to the project file, if known, otherwise get
+	// the project name. For the path: quote it for the command line.
+	IFileManager& FileManager = IFileManager::Get();
+	FString ProjectPathOrName = FApp::GetProjectName();
+	if (FPaths::IsProjectFilePathSet())
+	{
+		const FString ProjectPath = FPaths::GetProjectFilePath();
+		if (!ProjectPath.IsEmpty())
 		{
-			return false;
+			ProjectPathOrName = FString::Printf(
+                TEXT("\"%s\""),
+                *FileManager.ConvertToAbsolutePathForExternalAppForRead(*ProjectPath)
+            );
 		}
 	}
 
+	if (ProjectPathOrName.IsEmpty())
+		return false;
+
+	// Get the executable path for the app/editor
+	FString ExePath = FPlatformProcess::GenerateApplicationPath(FApp::GetName(), FApp::GetBuildConfiguration());
+	if (!ExePath.IsEmpty())
+		ExePath = FileManager.ConvertToAbsolutePathForExternalAppForRead(*ExePath);
+
+	if (ExePath.IsEmpty())
+		return false;
+	
+	const FString CommandLineParameters = FString::Printf(
+		TEXT("%s -messaging -run=%s -guid=%s -listen=%s -managerpid=%d"),
+		*ProjectPathOrName,
+		*BGEOCommandletName,
+		*InWorker.Guid.ToString(),
+		*BGEOCommandletEndpoint->GetAddress().ToString(),
+		FPlatformProcess::GetCurrentProcessId());
+
+	InWorker.ProcHandle = FPlatformProcess::CreateProc(
+		*ExePath,
+		*CommandLineParameters,
+		false,
+		true,
+		false,
+		&InWorker.ProcessId,
+		0,
+		NULL,
+		NULL);
+	if (!InWorker.ProcHandle.IsValid())
+	{
+		return false;
+	}
+
 	return true;
 }
 
 void FHoudiniPDGManager::StopBGEOCommandletAndEndpoint()
 {
 	BGEOCommandletEndpoint.Reset();
-	BGEOCommandletAddress.Invalidate();
-	BGEOCommandletGuid.Invalidate();
 
-	if (BGEOCommandletProcHandle.IsValid() && FPlatformProcess::IsProcRunning(BGEOCommandletProcHandle))
+	TArray<FHoudiniPDGImportBGEOMessage> AbandonedRequests;
+	for (FHoudiniBGEOCommandletWorker& Worker : BGEOCommandletWorkers)
 	{
-		FPlatformProcess::TerminateProc(BGEOCommandletProcHandle, true);
-		if (BGEOCommandletProcHandle.IsValid())
+		BGEOImportQueue.RemoveWorker(Worker.Guid, AbandonedRequests);
+		Worker.Address.Invalidate();
+		Worker.Guid.Invalidate();
+
+		if (Worker.ProcHandle.IsValid() && FPlatformProcess::IsProcRunning(Worker.ProcHandle))
 		{
-			FPlatformProcess::WaitForProc(BGEOCommandletProcHandle);
-			FPlatformProcess::CloseProc(BGEOCommandletProcHandle);
+			FPlatformProcess::TerminateProc(Worker.ProcHandle, true);
+			if (Worker.ProcHandle.IsValid())
+			{
+				FPlatformProcess::WaitForProc(Worker.ProcHandle);
+				FPlatformProcess::CloseProc(Worker.ProcHandle);
+			}
 		}
 	}
+	BGEOCommandletWorkers.Empty();
+
+	// Results that were waiting for, or being imported by, the commandlets are loaded directly instead
+	BGEOImportQueue.TakePending(AbandonedRequests);
+	BGEOImportQueue.Reset();
+	PendingBGEOImportResults.Empty();
+	if (AbandonedRequests.Num() > 0)
+		ResetImportWorkResultObjects(AbandonedRequests, EPDGWorkResultState::ToLoad);
 }
 
 EHoudiniBGEOCommandletStatus FHoudiniPDGManager::UpdateAndGetBGEOCommandletStatus()
 {
-	if (BGEOCommandletProcHandle.IsValid())
+	bool bAnyStarted = false;
+	bool bAnyRunning = false;
+	bool bAnyConnected = false;
+	for (FHoudiniBGEOCommandletWorker& Worker : BGEOCommandletWorkers)
 	{
-		if (!FPlatformProcess::IsProcRunning(BGEOCommandletProcHandle))
-			BGEOCommandletStatus = EHoudiniBGEOCommandletStatus::Crashed;
-		else if (BGEOCommandletAddress.IsValid())
-			BGEOCommandletStatus = EHoudiniBGEOCommandletStatus::Connected;
+		if (Worker.ProcHandle.IsValid())
+		{
+			bAnyStarted = true;
+			if (!FPlatformProcess::IsProcRunning(Worker.ProcHandle))
+			{
+				if (Worker.Status != EHoudiniBGEOCommandletStatus::Crashed)
+				{
+					// Give the results this commandlet was importing to the other ones
+					HOUDINI_LOG_WARNING(TEXT("PDG: Async importer (pid %d) stopped, requeuing its %d work item results."),
+						Worker.ProcessId, BGEOImportQueue.GetNumInFlight(Worker.Guid));
+					TArray<FHoudiniPDGImportBGEOMessage> FailedRequests;
+					BGEOImportQueue.RemoveWorker(Worker.Guid, FailedRequests);
+					for (const FHoudiniPDGImportBGEOMessage& Request : FailedRequests)
+					{
+						HOUDINI_LOG_WARNING(
+							TEXT("PDG: Async importers stopped %d times while importing %s (TOP node %d, work item %d), giving up."),
+							FHoudiniPDGImportQueue::MaxAttempts, *Request.Name, Request.TOPNodeId, Request.WorkItemId);
+					}
+					ResetImportWorkResultObjects(FailedRequests, EPDGWorkResultState::None);
+					Worker.Address.Invalidate();
+				}
+				Worker.Status = EHoudiniBGEOCommandletStatus::Crashed;
+			}
+			else if (Worker.Address.IsValid())
+			{
+				Worker.Status = EHoudiniBGEOCommandletStatus::Connected;
+				bAnyConnected = true;
+			}
+			else
+			{
+				Worker.Status = EHoudiniBGEOCommandletStatus::Running;
+				bAnyRunning = true;
+			}
+		}
 		else
-			BGEOCommandletStatus = EHoudiniBGEOCommandletStatus::Running;
+		{
+			Worker.Status = EHoudiniBGEOCommandletStatus::NotStarted;
+		}
 	}
+
+	if (bAnyConnected)
+		BGEOCommandletStatus = EHoudiniBGEOCommandletStatus::Connected;
+	else if (bAnyRunning)
+		BGEOCommandletStatus = EHoudiniBGEOCommandletStatus::Running;
+	else if (bAnyStarted)
+		BGEOCommandletStatus = EHoudiniBGEOCommandletStatus::Crashed;
 	else
 		BGEOCommandletStatus = EHoudiniBGEOCommandletStatus::NotStarted;
 
 	return BGEOCommandletStatus;
 }
 
+void
+FHoudiniPDGManager::GetBGEOImportProgress(int32& OutNumQueued, int32& OutNumCompleted, int32& OutNumFailed) const
+{
+	OutNumQueued = BGEOImportQueue.GetNumQueued();
+	OutNumCompleted = BGEOImportQueue.GetNumCompleted();
+	OutNumFailed = BGEOImportQueue.GetNumFailed();
+}
+
 
 bool
 FHoudiniPDGManager::IsPDGAsset(const HAPI_NodeId& InAssetId)
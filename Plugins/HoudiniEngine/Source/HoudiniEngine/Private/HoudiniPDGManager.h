@@ -32,13 +32,17 @@
 
 #include "MessageEndpoint.h"
 
+#include "HoudiniPDGImportQueue.h"
+
 class UHoudiniAssetComponent;
 class UHoudiniPDGAssetLink;
 class UTOPNetwork;
 class UTOPNode;
 class FSocket;
+struct FTOPWorkResultObject;
 
 enum class EPDGNodeState : uint8;
+enum class EPDGWorkResultState : uint8;
 
 // BGEO commandlet status
 enum class HOUDINIENGINE_API EHoudiniBGEOCommandletStatus : uint8
@@ -55,6 +59,17 @@ enum class HOUDINIENGINE_API EHoudiniBGEOCommandletStatus : uint8
 	Crashed
 };
 
+// One of the BGEO commandlet processes importing work item results
+struct FHoudiniBGEOCommandletWorker
+{
+	FProcHandle ProcHandle;
+	FGuid Guid;
+	uint32 ProcessId = 0;
+	// Address of the commandlet's endpoint, valid once it replied to discovery
+	FMessageAddress Address;
+	EHoudiniBGEOCommandletStatus Status = EHoudiniBGEOCommandletStatus::NotStarted;
+};
+
 struct HOUDINIENGINE_API FHoudiniPDGManager
 {
 
@@ -153,14 +168,18 @@ public:
 		const struct FHoudiniPDGImportBGEOResultMessage& InMessage, 
 		const TSharedRef<IMessageContext, ESPMode::ThreadSafe>& InContext);
 
-	// Create the bgeo commandlet endpoint and start the commandlet (if not already running).
+	// Create the bgeo commandlet endpoint and start the commandlets (the ones not already running).
 	bool CreateBGEOCommandletAndEndpoint();
 
 	void StopBGEOCommandletAndEndpoint();
 
-	// Updates and returns the BGEO commandlet status
+	// Updates and returns the BGEO commandlet status: Connected if any of the commandlets is connected, Running if
+	// any is running, Crashed if they all stopped.
 	EHoudiniBGEOCommandletStatus UpdateAndGetBGEOCommandletStatus();
 
+	// Progress of the work item results imported by the commandlets, since their queue was last idle
+	void GetBGEOImportProgress(int32& OutNumQueued, int32& OutNumCompleted, int32& OutNumFailed) const;
+
 private:
 	
 	void UpdatePDGContexts();
@@ -171,6 +190,22 @@ private:
 
 	static void ResetPDGEventInfo(HAPI_PDG_EventInfo& InEventInfo);
 
+	// Launch a commandlet process for the given worker
+	bool StartBGEOCommandletWorker(FHoudiniBGEOCommandletWorker& InWorker);
+
+	// Create the outputs of a work result object from a commandlet import result, or mark it as failed
+	void ApplyImportBGEOResult(const FHoudiniPDGImportBGEOResultMessage& InMessage);
+
+	// Finds the work result object an import request was sent for, if it still exists
+	FTOPWorkResultObject* FindImportWorkResultObject(
+		const FHoudiniPDGImportBGEOMessage& InMessage,
+		UHoudiniPDGAssetLink*& OutAssetLink,
+		UTOPNode*& OutTOPNode,
+		int32& OutWorkResultArrayIndex);
+
+	// Set work result objects whose import failed (or was abandoned) back to a given state
+	void ResetImportWorkResultObjects(const TArray<FHoudiniPDGImportBGEOMessage>& InRequests, const EPDGWorkResultState& InState);
+
 	// Returns the PDGAssetLink and FTOPNode associated with this TOP node ID
 	bool GetTOPAssetLinkNetworkAndNode(const HAPI_NodeId& InNodeID, UHoudiniPDGAssetLink*& OutAssetLink, UTOPNetwork*& OutTOPNetwork, UTOPNode*& OutTOPNode);
 
@@ -205,10 +240,13 @@ private:
 	int32 MaxNumberOfPDGEvents = 20;
 
 	TSharedPtr<FMessageEndpoint, ESPMode::ThreadSafe> BGEOCommandletEndpoint;
-	FMessageAddress BGEOCommandletAddress;
-	FProcHandle BGEOCommandletProcHandle;
-	FGuid BGEOCommandletGuid;
-	uint32 BGEOCommandletProcessId;
+	// The pool of commandlets importing work item results
+	TArray<FHoudiniBGEOCommandletWorker> BGEOCommandletWorkers;
 	// Keep track of the BGEO commandlet status
-	EHoudiniBGEOCommandletStatus BGEOCommandletStatus;
+	EHoudiniBGEOCommandletStatus BGEOCommandletStatus = EHoudiniBGEOCommandletStatus::NotStarted;
+
+	// Work result objects waiting for, or being imported by, the commandlets
+	FHoudiniPDGImportQueue BGEOImportQueue;
+	// Import results received from the commandlets, turned into outputs in bounded batches on the manager's tick
+	TArray<FHoudiniPDGImportBGEOResultMessage> PendingBGEOImportResults;
 };
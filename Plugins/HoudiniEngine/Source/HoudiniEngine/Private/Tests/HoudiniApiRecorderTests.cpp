@@ -0,0 +1,131 @@
+#include "../HoudiniApiRecorder.h"
+#include "../HoudiniEngineUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// HAPI stubs: a fake session answering a few geometry queries.
+namespace HoudiniApiRecorderTest
+{
+	int32 StatusCalls = 0;
+
+	HAPI_Result StubCreateNode(const HAPI_Session * Session, HAPI_NodeId ParentNodeId, const char * OperatorName, const char * NodeLabel, HAPI_Bool bCookOnCreation, HAPI_NodeId * NewNodeId)
+	{
+		*NewNodeId = FCStringAnsi::Strcmp(OperatorName, "Sop/box") == 0 ? 12 : 34;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubGetPartInfo(const HAPI_Session * Session, HAPI_NodeId NodeId, HAPI_PartId PartId, HAPI_PartInfo * PartInfo)
+	{
+		*PartInfo = HAPI_PartInfo{};
+		PartInfo->id = PartId;
+		PartInfo->pointCount = 8 + NodeId;
+		PartInfo->faceCount = 6;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubGetAttributeFloatData(const HAPI_Session * Session, HAPI_NodeId NodeId, HAPI_PartId PartId, const char * Name, HAPI_AttributeInfo * AttrInfo, int Stride, float * Data, int Start, int Length)
+	{
+		for (int32 Idx = 0; Idx < Length * AttrInfo->tupleSize; Idx++)
+			Data[Idx] = (float)(Start * AttrInfo->tupleSize + Idx) * 0.5f;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubGetStatus(const HAPI_Session * Session, HAPI_StatusType StatusType, int * Status)
+	{
+		*Status = StatusCalls++ < 2 ? HAPI_STATE_COOKING : HAPI_STATE_READY;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	// The calls made by the test, outputs are appended to a flat log for comparison
+	void MakeCalls(TArray<float>& OutValues)
+	{
+		HAPI_NodeId NodeId = -1;
+		OutValues.Add(FHoudiniApi::CreateNode(nullptr, -1, "Sop/box", "Box", false, &NodeId));
+		OutValues.Add(NodeId);
+		OutValues.Add(FHoudiniApi::CreateNode(nullptr, -1, "Sop/sphere", "Sphere", false, &NodeId));
+		OutValues.Add(NodeId);
+
+		HAPI_PartInfo PartInfo = {};
+		OutValues.Add(FHoudiniApi::GetPartInfo(nullptr, 12, 0, &PartInfo));
+		OutValues.Add(PartInfo.pointCount);
+		OutValues.Add(PartInfo.faceCount);
+
+		HAPI_AttributeInfo AttrInfo = {};
+		AttrInfo.tupleSize = 3;
+		TArray<float> Positions;
+		Positions.SetNumZeroed(PartInfo.pointCount * AttrInfo.tupleSize);
+		OutValues.Add(FHoudiniApi::GetAttributeFloatData(nullptr, 12, 0, "P", &AttrInfo, -1, Positions.GetData(), 0, PartInfo.pointCount));
+		OutValues.Append(Positions);
+
+		// Polled status, replayed in recorded order
+		for (int32 Idx = 0; Idx < 4; Idx++)
+		{
+			int Status = -1;
+			FHoudiniApi::GetStatus(nullptr, HAPI_STATUS_COOK_STATE, &Status);
+			OutValues.Add(Status);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniApiRecorderReplayTest, "Houdini.Core.ApiRecorder.Replay", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniApiRecorderReplayTest::RunTest(const FString & Parameters)
+{
+	using namespace HoudiniApiRecorderTest;
+
+	// The stubs replace the global HAPI functions, don't run next to a live session.
+	if (FHoudiniEngineUtils::IsInitialized() || FHoudiniApiRecorder::GetMode() != EHoudiniApiRecorderMode::None)
+	{
+		AddInfo(TEXT("Skipped, a Houdini Engine session or recording is running."));
+		return true;
+	}
+
+	const FHoudiniApi::CreateNodeFuncPtr OldCreateNode = FHoudiniApi::CreateNode;
+	const FHoudiniApi::GetPartInfoFuncPtr OldGetPartInfo = FHoudiniApi::GetPartInfo;
+	const FHoudiniApi::GetAttributeFloatDataFuncPtr OldGetAttributeFloatData = FHoudiniApi::GetAttributeFloatData;
+	const FHoudiniApi::GetStatusFuncPtr OldGetStatus = FHoudiniApi::GetStatus;
+	FHoudiniApi::CreateNode = &StubCreateNode;
+	FHoudiniApi::GetPartInfo = &StubGetPartInfo;
+	FHoudiniApi::GetAttributeFloatData = &StubGetAttributeFloatData;
+	FHoudiniApi::GetStatus = &StubGetStatus;
+	StatusCalls = 0;
+
+	const FString RecordingFilePath = FPaths::AutomationTransientDir() / TEXT("HoudiniApiRecorderTest.hapirec");
+
+	// Record the calls made to the stubs
+	TArray<float> RecordedValues;
+	TestTrue(TEXT("Recording started"), FHoudiniApiRecorder::StartRecording(RecordingFilePath));
+	MakeCalls(RecordedValues);
+	TestEqual(TEXT("Recorded call count"), FHoudiniApiRecorder::GetCallCount(), 8);
+	FHoudiniApiRecorder::Stop();
+	TestTrue(TEXT("Stubs restored"), FHoudiniApi::GetStatus == &StubGetStatus);
+
+	// Replay them without any HAPI implementation behind the functions
+	FHoudiniApi::CreateNode = nullptr;
+	FHoudiniApi::GetPartInfo = nullptr;
+	FHoudiniApi::GetAttributeFloatData = nullptr;
+	FHoudiniApi::GetStatus = nullptr;
+	TArray<float> ReplayedValues;
+	TestTrue(TEXT("Replay started"), FHoudiniApiRecorder::StartReplay(RecordingFilePath));
+	MakeCalls(ReplayedValues);
+	TestTrue(TEXT("Replayed outputs match the recording"), ReplayedValues == RecordedValues);
+	TestEqual(TEXT("No missing calls"), FHoudiniApiRecorder::GetMissingCallCount(), 0);
+
+	// A call that was never recorded fails
+	HAPI_PartInfo PartInfo = {};
+	TestEqual(TEXT("Unknown call fails"), FHoudiniApi::GetPartInfo(nullptr, 99, 0, &PartInfo), HAPI_RESULT_FAILURE);
+	TestEqual(TEXT("Unknown call is counted"), FHoudiniApiRecorder::GetMissingCallCount(), 1);
+	FHoudiniApiRecorder::Stop();
+
+	IFileManager::Get().Delete(*RecordingFilePath);
+	FHoudiniApi::CreateNode = OldCreateNode;
+	FHoudiniApi::GetPartInfo = OldGetPartInfo;
+	FHoudiniApi::GetAttributeFloatData = OldGetAttributeFloatData;
+	FHoudiniApi::GetStatus = OldGetStatus;
+	return true;
+}
+
+#endif
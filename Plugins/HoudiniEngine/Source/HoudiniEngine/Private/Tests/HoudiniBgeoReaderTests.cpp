@@ -0,0 +1,248 @@
+#include "../HoudiniBgeoReader.h"
+#include "../HoudiniGeoImporter.h"
+#include "HoudiniGeoPartObject.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "MeshDescription.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "StaticMeshAttributes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Checks that two files describe the same geometry
+static void
+TestSameGeometry(FAutomationTestBase& Test, const FString& Name, const FHoudiniBgeoGeometry& Geometry, const FHoudiniBgeoGeometry& Expected)
+{
+	Test.TestTrue(Name + TEXT(" topology"), Geometry.VertexPoints == Expected.VertexPoints
+		&& Geometry.FaceCounts == Expected.FaceCounts && Geometry.FaceVertices == Expected.FaceVertices
+		&& Geometry.FacePrimitives == Expected.FacePrimitives);
+
+	if (Test.TestEqual(Name + TEXT(" attribute count"), Geometry.Attributes.Num(), Expected.Attributes.Num()))
+	{
+		for (const FHoudiniBgeoAttribute& Attribute : Expected.Attributes)
+		{
+			const FHoudiniBgeoAttribute* Other = Geometry.FindAttribute(Attribute.Name, Attribute.Owner);
+			Test.TestTrue(Name + TEXT(" attribute ") + Attribute.Name, Other && Other->TupleSize == Attribute.TupleSize
+				&& Other->FloatValues == Attribute.FloatValues && Other->IntValues == Attribute.IntValues
+				&& Other->StringValues == Attribute.StringValues);
+		}
+	}
+
+	if (Test.TestEqual(Name + TEXT(" group count"), Geometry.Groups.Num(), Expected.Groups.Num()))
+	{
+		for (int32 Group = 0; Group < Expected.Groups.Num(); Group++)
+		{
+			Test.TestTrue(Name + TEXT(" group ") + Expected.Groups[Group].Name, Geometry.Groups[Group].Name == Expected.Groups[Group].Name
+				&& Geometry.Groups[Group].Membership == Expected.Groups[Group].Membership);
+		}
+	}
+
+	if (Test.TestEqual(Name + TEXT(" volume count"), Geometry.Volumes.Num(), Expected.Volumes.Num()) && Expected.Volumes.Num() > 0)
+	{
+		Test.TestTrue(Name + TEXT(" volume"), Geometry.Volumes[0].Values == Expected.Volumes[0].Values
+			&& Geometry.Volumes[0].Transform.Equals(Expected.Volumes[0].Transform));
+	}
+
+	if (Test.TestEqual(Name + TEXT(" packed count"), Geometry.PackedPrimitives.Num(), Expected.PackedPrimitives.Num()) && Expected.PackedPrimitives.Num() > 0)
+		Test.TestTrue(Name + TEXT(" packed transform"), Geometry.PackedPrimitives[0].Transform.Equals(Expected.PackedPrimitives[0].Transform));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniBgeoReaderSampleFilesTest, "Houdini.Core.BgeoReader.SampleFiles", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniBgeoReaderSampleFilesTest::RunTest(const FString & Parameters)
+{
+	// The same hand-written geometry as ASCII, as binary (tokens, uniform arrays, raw pages, RLE groups, primitive runs)
+	// and as Blosc compressed binary (an LZ4 chunk with shuffled split blocks, a zlib chunk and a raw chunk)
+	TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("HoudiniEngine"));
+	if (!TestTrue(TEXT("Plugin found"), Plugin.IsValid()))
+		return false;
+
+	const FString Directory = FPaths::Combine(Plugin->GetBaseDir(), TEXT("Content"), TEXT("Tests"), TEXT("Geometry"));
+	const TArray<FString> FileNames = { TEXT("grid.geo"), TEXT("grid.bgeo"), TEXT("grid.bgeo.sc") };
+
+	TArray<FHoudiniBgeoGeometry> Geometries;
+	for (const FString& FileName : FileNames)
+	{
+		FHoudiniBgeoGeometry& Geometry = Geometries.AddDefaulted_GetRef();
+		if (!TestTrue(FString::Printf(TEXT("Read %s"), *FileName), FHoudiniBgeoReader::ReadFile(FPaths::Combine(Directory, FileName), Geometry)))
+			return false;
+	}
+
+	// 3x3 grid of quads, a volume and a packed disk primitive on two extra points
+	const FHoudiniBgeoGeometry& Expected = Geometries[0];
+	TestEqual(TEXT("Point count"), Expected.PointCount, 11);
+	TestEqual(TEXT("Vertex count"), Expected.VertexCount, 18);
+	TestEqual(TEXT("Primitive count"), Expected.PrimitiveCount, 6);
+	TestEqual(TEXT("Face count"), Expected.FaceCounts.Num(), 4);
+	TestEqual(TEXT("Unsupported primitives"), Expected.UnsupportedPrimitiveCount, 0);
+	if (TestEqual(TEXT("Face vertex count"), Expected.FaceVertices.Num(), 16))
+		TestTrue(TEXT("Last face points"), Expected.VertexPoints[Expected.FaceVertices[12]] == 4 && Expected.VertexPoints[Expected.FaceVertices[14]] == 8);
+
+	const FHoudiniBgeoAttribute* Ids = Expected.FindAttribute(TEXT("id"), HAPI_ATTROWNER_POINT);
+	if (TestNotNull(TEXT("Point ids"), Ids) && TestEqual(TEXT("Point id count"), Ids->IntValues.Num(), 11))
+		TestTrue(TEXT("Constant page ids"), Ids->IntValues[7] == 7 && Ids->IntValues[10] == 7);
+
+	const FHoudiniBgeoAttribute* Scale = Expected.FindAttribute(TEXT("scale"), HAPI_ATTROWNER_DETAIL);
+	if (TestNotNull(TEXT("Detail attribute"), Scale) && TestEqual(TEXT("Detail value count"), Scale->FloatValues.Num(), 1))
+		TestEqual(TEXT("Detail value"), Scale->FloatValues[0], 2.5f);
+
+	if (TestEqual(TEXT("Volume count"), Expected.Volumes.Num(), 1))
+	{
+		// A raw tile followed by a constant one
+		const FHoudiniBgeoVolume& Volume = Expected.Volumes[0];
+		TestEqual(TEXT("Volume name"), Volume.Name, FString(TEXT("density")));
+		TestTrue(TEXT("Volume resolution"), Volume.Resolution == FIntVector(20, 3, 1));
+		TestTrue(TEXT("Volume origin"), Volume.Transform.GetOrigin().Equals(FVector(5.0, 0.0, 5.0)));
+		if (TestEqual(TEXT("Voxel count"), Volume.Values.Num(), 60))
+		{
+			TestEqual(TEXT("Raw voxel"), Volume.Values[2 * 20 + 15], (2 * 16 + 15) * 0.25f);
+			TestEqual(TEXT("Constant voxel"), Volume.Values[1 * 20 + 17], 0.5f);
+		}
+	}
+
+	if (TestEqual(TEXT("Packed primitive count"), Expected.PackedPrimitives.Num(), 1))
+	{
+		// Placed on its point, offset by its scaled pivot
+		const FHoudiniBgeoPackedPrimitive& Packed = Expected.PackedPrimitives[0];
+		TestEqual(TEXT("Packed type"), Packed.Type, FString(TEXT("PackedDisk")));
+		TestEqual(TEXT("Packed point"), Packed.PointIndex, 10);
+		TestTrue(TEXT("Packed origin"), Packed.Transform.GetOrigin().Equals(FVector(-3.0, 1.0, 0.0)));
+		TestEqual(TEXT("Packed file"), Packed.FilePath, FString(TEXT("box.bgeo.sc")));
+	}
+
+	for (const FHoudiniBgeoGroup& Group : Expected.Groups)
+	{
+		int32 Members = 0;
+		for (const bool& bMember : Group.Membership)
+			Members += bMember ? 1 : 0;
+		TestEqual(FString::Printf(TEXT("Group %s members"), *Group.Name), Members, 4);
+	}
+	TestEqual(TEXT("Group count"), Expected.Groups.Num(), 2);
+
+	// All the formats give the same geometry
+	for (int32 Index = 1; Index < Geometries.Num(); Index++)
+	{
+		TestSameGeometry(*this, FileNames[Index], Geometries[Index], Expected);
+	}
+
+	// Parts as the translators would get them from HAPI
+	TArray<FHoudiniGeoPartObject> HGPOs;
+	FHoudiniBgeoReader::BuildGeoPartObjects(Expected, TEXT("grid"), HGPOs);
+	if (TestEqual(TEXT("Part count"), HGPOs.Num(), 3))
+	{
+		TestTrue(TEXT("Mesh part"), HGPOs[0].Type == EHoudiniPartType::Mesh && HGPOs[0].PartInfo.FaceCount == 4 && HGPOs[0].PartInfo.VertexCount == 16);
+		TestTrue(TEXT("Volume part"), HGPOs[1].Type == EHoudiniPartType::Volume && HGPOs[1].VolumeName == TEXT("density")
+			&& HGPOs[1].VolumeInfo.XLength == 20 && HGPOs[1].VolumeInfo.YLength == 3 && HGPOs[1].VolumeInfo.ZLength == 1);
+		TestTrue(TEXT("Instancer part"), HGPOs[2].Type == EHoudiniPartType::Instancer
+			&& HGPOs[2].InstancerType == EHoudiniInstancerType::PackedPrimitive && HGPOs[2].PartInfo.InstanceCount == 1);
+	}
+
+	// Files saved by Houdini itself: each compressed file has to give the same geometry as the ASCII file
+	// Houdini saved next to it, the ASCII reader doesn't share the binary, Blosc, LZ4 and shuffle code paths
+	const FString HoudiniDirectory = FPaths::Combine(Directory, TEXT("Houdini"));
+	TArray<FString> HoudiniFiles;
+	IFileManager::Get().FindFiles(HoudiniFiles, *FPaths::Combine(HoudiniDirectory, TEXT("*.bgeo.sc")), true, false);
+	if (HoudiniFiles.Num() <= 0)
+		AddError(TEXT("No geometry saved by Houdini found in Content/Tests/Geometry/Houdini, see the readme there"));
+
+	for (const FString& FileName : HoudiniFiles)
+	{
+		const FString AsciiFileName = FileName.LeftChop(FString(TEXT(".bgeo.sc")).Len()) + TEXT(".geo");
+		FHoudiniBgeoGeometry Geometry;
+		FHoudiniBgeoGeometry AsciiGeometry;
+		if (!TestTrue(FString::Printf(TEXT("Read Houdini file %s"), *FileName), FHoudiniBgeoReader::ReadFile(FPaths::Combine(HoudiniDirectory, FileName), Geometry))
+			|| !TestTrue(FString::Printf(TEXT("Read Houdini file %s"), *AsciiFileName), FHoudiniBgeoReader::ReadFile(FPaths::Combine(HoudiniDirectory, AsciiFileName), AsciiGeometry)))
+		{
+			continue;
+		}
+
+		TestTrue(FileName + TEXT(" has points"), Geometry.PointCount > 0);
+		TestNotNull(FileName + TEXT(" positions"), Geometry.FindAttribute(TEXT("P"), HAPI_ATTROWNER_POINT));
+		TestSameGeometry(*this, FileName, Geometry, AsciiGeometry);
+	}
+
+	// Corrupted data fails instead of reading out of bounds
+	TArray<uint8> Truncated;
+	FFileHelper::LoadFileToArray(Truncated, *FPaths::Combine(Directory, TEXT("grid.bgeo.sc")));
+	Truncated.SetNum(Truncated.Num() / 2);
+	AddExpectedError(TEXT("Unrecognized geometry file format"), EAutomationExpectedErrorFlags::Contains, 1);
+	FHoudiniBgeoGeometry Invalid;
+	TestFalse(TEXT("Truncated file"), FHoudiniBgeoReader::ReadFromMemory(Truncated, Invalid));
+
+	// Sizes read from the file are checked before anything is allocated: a volume with more voxels than a TArray can hold,
+	// and uniform bool arrays longer than a TArray or than the data left in the stream
+	const FString LargeVolume = TEXT("[\"pointcount\",1,\"vertexcount\",1,\"primitivecount\",1,\"topology\",[\"pointref\",[\"indices\",[0]]],")
+		TEXT("\"primitives\",[[[\"type\",\"Volume\"],[\"vertex\",0,\"res\",[65536,65536,2],\"voxels\",[\"tiledarray\",[\"tiles\",[]]]]]]]");
+	FTCHARToUTF8 LargeVolumeUtf8(*LargeVolume);
+	AddExpectedError(TEXT("Volume resolution 65536 x 65536 x 2 is too large"), EAutomationExpectedErrorFlags::Contains, 1);
+	AddExpectedError(TEXT("Failed to read the geometry primitives"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Volume too large"), FHoudiniBgeoReader::ReadFromMemory(TArray<uint8>((const uint8*)LargeVolumeUtf8.Get(), LargeVolumeUtf8.Length()), Invalid));
+
+	// Magic, 'bJSN', then a uniform bool array with a 32 bit length
+	const TArray<uint8> LongBoolArray = { 0x7f, 'N', 'S', 'J', 'b', 0x40, 0x10, 0xf4, 0x00, 0x00, 0x00, 0x80 };
+	const TArray<uint8> ShortBoolArray = { 0x7f, 'N', 'S', 'J', 'b', 0x40, 0x10, 0xf4, 0x00, 0x01, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff };
+	AddExpectedError(TEXT("Invalid array of"), EAutomationExpectedErrorFlags::Contains, 2);
+	AddExpectedError(TEXT("Failed to parse binary geometry"), EAutomationExpectedErrorFlags::Contains, 2);
+	FHoudiniBgeoValue InvalidValue;
+	TestFalse(TEXT("Bool array longer than a TArray"), FHoudiniBgeoReader::ParseJSON(LongBoolArray.GetData(), LongBoolArray.Num(), InvalidValue));
+	TestFalse(TEXT("Bool array longer than the stream"), FHoudiniBgeoReader::ParseJSON(ShortBoolArray.GetData(), ShortBoolArray.Num(), InvalidValue));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniBgeoReaderMeshImportTest, "Houdini.Core.BgeoReader.MeshImport", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniBgeoReaderMeshImportTest::RunTest(const FString & Parameters)
+{
+	// The session-less import builds a single mesh from the polygons of the file
+	TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("HoudiniEngine"));
+	if (!TestTrue(TEXT("Plugin found"), Plugin.IsValid()))
+		return false;
+
+	FHoudiniBgeoGeometry Geometry;
+	const FString FilePath = FPaths::Combine(Plugin->GetBaseDir(), TEXT("Content"), TEXT("Tests"), TEXT("Geometry"), TEXT("grid.geo"));
+	if (!TestTrue(TEXT("Read grid.geo"), FHoudiniBgeoReader::ReadFile(FilePath, Geometry)))
+		return false;
+
+	FMeshDescription MeshDescription;
+	TArray<FString> MaterialNames;
+	if (!TestTrue(TEXT("Mesh built"), UHoudiniGeoImporter::BuildMeshDescriptionFromBGEO(Geometry, MeshDescription, MaterialNames)))
+		return false;
+
+	TestEqual(TEXT("Polygon count"), MeshDescription.Polygons().Num(), 4);
+	TestTrue(TEXT("Default material only"), MaterialNames == TArray<FString>({ FString() }));
+
+	// A polygon group per material, and the polygons of the invisible collision groups left out
+	FHoudiniBgeoAttribute& Materials = Geometry.Attributes.AddDefaulted_GetRef();
+	Materials.Name = TEXT("unreal_material");
+	Materials.Owner = HAPI_ATTROWNER_PRIM;
+	Materials.Storage = HAPI_STORAGETYPE_STRING;
+	Materials.TupleSize = 1;
+	Materials.StringValues = { TEXT("/Game/A"), TEXT("/Game/B"), TEXT("/Game/A"), TEXT("/Game/B"), FString(), FString() };
+
+	FHoudiniBgeoGroup& Collision = Geometry.Groups.AddDefaulted_GetRef();
+	Collision.Name = TEXT("collision_geo_simple");
+	Collision.Type = HAPI_GROUPTYPE_PRIM;
+	Collision.Membership = { false, false, false, true, false, false };
+
+	FMeshDescription SplitMeshDescription;
+	AddExpectedError(TEXT("skipping 1 polygons in collision groups"), EAutomationExpectedErrorFlags::Contains, 1);
+	if (!TestTrue(TEXT("Mesh with materials built"), UHoudiniGeoImporter::BuildMeshDescriptionFromBGEO(Geometry, SplitMeshDescription, MaterialNames)))
+		return false;
+
+	TestEqual(TEXT("Polygon count without collisions"), SplitMeshDescription.Polygons().Num(), 3);
+	TestTrue(TEXT("Materials"), MaterialNames == TArray<FString>({ TEXT("/Game/A"), TEXT("/Game/B") }));
+
+	FStaticMeshConstAttributes Attributes(SplitMeshDescription);
+	TPolygonGroupAttributesConstRef<FName> SlotNames = Attributes.GetPolygonGroupMaterialSlotNames();
+	int32 NumPolygonsA = 0;
+	for (const FPolygonID PolygonID : SplitMeshDescription.Polygons().GetElementIDs())
+		NumPolygonsA += SlotNames[SplitMeshDescription.GetPolygonPolygonGroup(PolygonID)] == FName(TEXT("/Game/A")) ? 1 : 0;
+	TestEqual(TEXT("Polygons with material A"), NumPolygonsA, 2);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,140 @@
+#include "../HoudiniEngineManager.h"
+#include "HoudiniEngineRuntime.h"
+#include "HoudiniAssetComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniEngineManagerIdleTickTest, "Houdini.Core.Manager.IdleTick", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniEngineManagerIdleTickTest::RunTest(const FString & Parameters)
+{
+	if (!FHoudiniEngineRuntime::IsInitialized())
+		return true;
+
+	FHoudiniEngineRuntime& Runtime = FHoudiniEngineRuntime::Get();
+
+	// The asset state is not publicly writable, set it through reflection
+	FEnumProperty* AssetStateProperty = FindFProperty<FEnumProperty>(UHoudiniAssetComponent::StaticClass(), TEXT("AssetState"));
+	if (!TestNotNull(TEXT("AssetState property"), AssetStateProperty))
+		return false;
+
+	// 5000 idle components: fully loaded, nothing to cook
+	const int32 ComponentNum = 5000;
+	TArray<UHoudiniAssetComponent*> Components;
+	for (int32 Idx = 0; Idx < ComponentNum; Idx++)
+	{
+		UHoudiniAssetComponent* HAC = NewObject<UHoudiniAssetComponent>(GetTransientPackage());
+		*AssetStateProperty->ContainerPtrToValuePtr<EHoudiniAssetState>(HAC) = EHoudiniAssetState::None;
+		HAC->HoudiniEngineTick();
+		Runtime.RegisterHoudiniComponent(HAC);
+		Runtime.MarkHoudiniComponentIdle(HAC);
+		Components.Add(HAC);
+	}
+
+	// Marking an unregistered component as active or modified has no effect
+	UHoudiniAssetComponent* Unregistered = NewObject<UHoudiniAssetComponent>(GetTransientPackage());
+	*AssetStateProperty->ContainerPtrToValuePtr<EHoudiniAssetState>(Unregistered) = EHoudiniAssetState::None;
+	Unregistered->MarkAsNeedCook();
+
+	const IConsoleVariable* IdlePerTickCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("HoudiniEngine.IdleComponentsPerTick"));
+	const int32 IdlePerTick = IdlePerTickCVar ? FMath::Max(IdlePerTickCVar->GetInt(), 0) : 1;
+
+	FHoudiniEngineManager Manager;
+	TArray<UHoudiniAssetComponent*> ComponentsToProcess;
+
+	// Only the round robin idle components are visited
+	Manager.GatherComponentsToProcess(ComponentsToProcess);
+	TestTrue(TEXT("Idle components are not all visited"), ComponentsToProcess.Num() < 10);
+	for (UHoudiniAssetComponent* HAC : ComponentsToProcess)
+		Runtime.MarkHoudiniComponentIdle(HAC);
+
+	// Modified components are visited on the next tick
+	Components[1234]->MarkAsNeedCook();
+	Manager.GatherComponentsToProcess(ComponentsToProcess);
+	TestTrue(TEXT("Modified component is visited"), ComponentsToProcess.Contains(Components[1234]));
+	for (UHoudiniAssetComponent* HAC : ComponentsToProcess)
+		Runtime.MarkHoudiniComponentIdle(HAC);
+
+	// Benchmark: full scan of the registered components against the active set
+	const int32 Ticks = 100;
+	double Start = FPlatformTime::Seconds();
+	int32 Visited = 0;
+	for (int32 Tick = 0; Tick < Ticks; Tick++)
+	{
+		const int32 Count = Runtime.GetRegisteredHoudiniComponentCount();
+		for (int32 Idx = 0; Idx < Count; Idx++)
+		{
+			UHoudiniAssetComponent* HAC = Runtime.GetRegisteredHoudiniComponentAt(Idx);
+			if (!HAC || !HAC->IsValidLowLevelFast() || HAC->GetAssetState() == EHoudiniAssetState::Deleting)
+				continue;
+
+			UWorld* World = HAC->GetHACWorld();
+			if (World && World->IsPlayInEditor())
+				continue;
+
+			AActor* Owner = HAC->GetOwner();
+			if (HAC->IsFullyLoaded() && HAC->IsValidComponent() && !(Owner && Owner->IsSelectedInEditor()))
+				Visited++;
+		}
+	}
+	const double ScanTime = (FPlatformTime::Seconds() - Start) / Ticks;
+
+	// Components of the levels opened in the editor may be processed as well, only the test's components are counted
+	const TSet<UHoudiniAssetComponent*> TestComponents(Components);
+	auto CountTestComponents = [&TestComponents](const TArray<UHoudiniAssetComponent*>& InComponents)
+	{
+		int32 Count = 0;
+		for (UHoudiniAssetComponent* HAC : InComponents)
+			Count += TestComponents.Contains(HAC) ? 1 : 0;
+		return Count;
+	};
+
+	Start = FPlatformTime::Seconds();
+	int32 MaxVisitedPerTick = 0;
+	bool bUnregisteredVisited = false;
+	for (int32 Tick = 0; Tick < Ticks; Tick++)
+	{
+		Manager.GatherComponentsToProcess(ComponentsToProcess);
+		MaxVisitedPerTick = FMath::Max(MaxVisitedPerTick, CountTestComponents(ComponentsToProcess));
+		bUnregisteredVisited |= ComponentsToProcess.Contains(Unregistered);
+		for (UHoudiniAssetComponent* HAC : ComponentsToProcess)
+		{
+			if (FHoudiniEngineManager::IsComponentIdle(HAC))
+				Runtime.MarkHoudiniComponentIdle(HAC);
+		}
+	}
+	const double ActiveSetTime = (FPlatformTime::Seconds() - Start) / Ticks;
+
+	AddInfo(FString::Printf(TEXT("Tick with %d idle components: full scan %.3f ms, active set %.3f ms"), ComponentNum, ScanTime * 1000.0, ActiveSetTime * 1000.0));
+	TestTrue(TEXT("Scanned all components"), Visited >= ComponentNum * Ticks);
+
+	// Only the round robin components are visited while every component is idle
+	TestTrue(TEXT("Idle components are not visited"), MaxVisitedPerTick <= IdlePerTick);
+	TestFalse(TEXT("Unregistered component is not visited"), bUnregisteredVisited);
+	TArray<UHoudiniAssetComponent*> ActiveComponents;
+	Runtime.GetActiveHoudiniComponents(ActiveComponents);
+	TestEqual(TEXT("No active component left"), CountTestComponents(ActiveComponents), 0);
+
+	// A component modified after going idle becomes active again, and is visited on the next tick
+	Components[42]->MarkAsNeedCook();
+	Runtime.GetActiveHoudiniComponents(ActiveComponents);
+	TestTrue(TEXT("Modified component is active again"), ActiveComponents.Contains(Components[42]));
+	TestEqual(TEXT("Only the modified component is active"), CountTestComponents(ActiveComponents), 1);
+	Manager.GatherComponentsToProcess(ComponentsToProcess);
+	TestTrue(TEXT("Modified idle component is visited"), ComponentsToProcess.Contains(Components[42]));
+
+	for (UHoudiniAssetComponent* HAC : Components)
+	{
+		Runtime.UnRegisterHoudiniComponent(HAC);
+		HAC->MarkAsGarbage();
+	}
+	Unregistered->MarkAsGarbage();
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,153 @@
+#include "../HoudiniEngineString.h"
+#include "../HoudiniEngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// HAPI stubs: a fake string table, every string round trip is counted.
+namespace HoudiniEngineStringTest
+{
+	TMap<int32, FString> StringTable;
+	TArray<int32> PendingBatch;
+	int32 BatchCount = 0;
+	int32 BatchHandleCount = 0;
+	int32 SingleCount = 0;
+
+	HAPI_Result StubGetStringBatchSize(const HAPI_Session * Session, const int * StringHandles, int StringHandleCount, int * BufferSize)
+	{
+		PendingBatch.Empty();
+		*BufferSize = 0;
+		for (int32 Idx = 0; Idx < StringHandleCount; Idx++)
+		{
+			PendingBatch.Add(StringHandles[Idx]);
+			*BufferSize += FCStringAnsi::Strlen(TCHAR_TO_UTF8(*StringTable.FindRef(StringHandles[Idx]))) + 1;
+		}
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubGetStringBatch(const HAPI_Session * Session, char * Buffer, int BufferLength)
+	{
+		BatchCount++;
+		BatchHandleCount += PendingBatch.Num();
+		int32 Offset = 0;
+		for (const int32& Handle : PendingBatch)
+		{
+			const std::string Value = TCHAR_TO_UTF8(*StringTable.FindRef(Handle));
+			FMemory::Memcpy(Buffer + Offset, Value.c_str(), Value.size() + 1);
+			Offset += Value.size() + 1;
+		}
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubGetStringBufLength(const HAPI_Session * Session, HAPI_StringHandle Handle, int * BufferLength)
+	{
+		*BufferLength = FCStringAnsi::Strlen(TCHAR_TO_UTF8(*StringTable.FindRef(Handle))) + 1;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubGetString(const HAPI_Session * Session, HAPI_StringHandle Handle, char * Buffer, int Length)
+	{
+		SingleCount++;
+		const std::string Value = TCHAR_TO_UTF8(*StringTable.FindRef(Handle));
+		FMemory::Memcpy(Buffer, Value.c_str(), FMath::Min<int32>(Length, Value.size() + 1));
+		return HAPI_RESULT_SUCCESS;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniEngineStringCacheTest, "Houdini.Core.String.Cache", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniEngineStringCacheTest::RunTest(const FString & Parameters)
+{
+	using namespace HoudiniEngineStringTest;
+
+	// The stubs replace the global HAPI functions, don't run next to a live session.
+	if (FHoudiniEngineUtils::IsInitialized())
+	{
+		AddInfo(TEXT("Skipped, a Houdini Engine session is running."));
+		return true;
+	}
+
+	IConsoleVariable* CacheCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("HoudiniEngine.StringCache"));
+	if (!CacheCVar || CacheCVar->GetInt() <= 0)
+	{
+		AddInfo(TEXT("Skipped, the string cache is disabled."));
+		return true;
+	}
+
+	const FHoudiniApi::GetStringBatchSizeFuncPtr OldGetStringBatchSize = FHoudiniApi::GetStringBatchSize;
+	const FHoudiniApi::GetStringBatchFuncPtr OldGetStringBatch = FHoudiniApi::GetStringBatch;
+	const FHoudiniApi::GetStringBufLengthFuncPtr OldGetStringBufLength = FHoudiniApi::GetStringBufLength;
+	const FHoudiniApi::GetStringFuncPtr OldGetString = FHoudiniApi::GetString;
+	FHoudiniApi::GetStringBatchSize = &StubGetStringBatchSize;
+	FHoudiniApi::GetStringBatch = &StubGetStringBatch;
+	FHoudiniApi::GetStringBufLength = &StubGetStringBufLength;
+	FHoudiniApi::GetString = &StubGetString;
+
+	StringTable = { { 1, TEXT("/Game/Materials/M_Rock") }, { 2, TEXT("/Game/Maps/Level_A") }, { 3, TEXT("Bake_Rock") },
+		{ 4, TEXT("/Game/Meshes/SM_Tree") }, { 5, TEXT("/Game/Meshes/SM_Bush") } };
+	BatchCount = 0;
+	BatchHandleCount = 0;
+	SingleCount = 0;
+	FHoudiniEngineString::InvalidateStringCache();
+	FHoudiniEngineString::ResetStringCacheStats();
+
+	// First query: the unique handles are resolved in a single batch
+	TArray<FString> Strings;
+	TestTrue(TEXT("First query resolved"), FHoudiniEngineString::SHArrayToFStringArray({ 1, 2, 1, 3, 2 }, Strings));
+	TestTrue(TEXT("First query strings"), Strings == TArray<FString>({ StringTable[1], StringTable[2], StringTable[1], StringTable[3], StringTable[2] }));
+	TestEqual(TEXT("First query batch count"), BatchCount, 1);
+	TestEqual(TEXT("First query handle count"), BatchHandleCount, 3);
+
+	// Same strings from another attribute: no round trip
+	TestTrue(TEXT("Second query resolved"), FHoudiniEngineString::SHArrayToFStringArray({ 3, 1 }, Strings));
+	TestTrue(TEXT("Second query strings"), Strings == TArray<FString>({ StringTable[3], StringTable[1] }));
+	FString Single;
+	TestTrue(TEXT("Single string resolved"), FHoudiniEngineString::ToFString(2, Single));
+	TestEqual(TEXT("Single string"), Single, StringTable[2]);
+	TestEqual(TEXT("Cached queries batch count"), BatchCount, 1);
+	TestEqual(TEXT("Cached queries single count"), SingleCount, 0);
+
+	// A cook empties the cache, the strings are resolved again in a single batch
+	FHoudiniEngineString::MarkStringTableDirty();
+	FHoudiniEngineString::SHArrayToFStringArray({ 1, 2, 3 }, Strings);
+	TestEqual(TEXT("Batch count after a cook"), BatchCount, 2);
+	TestEqual(TEXT("Handle count after a cook"), BatchHandleCount, 6);
+
+	// Any handle changed by a cook is fetched again, not only the recently cached ones
+	StringTable[1] = TEXT("/Game/Materials/M_Sand");
+	StringTable[3] = TEXT("Bake_Sand");
+	FHoudiniEngineString::MarkStringTableDirty();
+	FHoudiniEngineString::SHArrayToFStringArray({ 3, 1 }, Strings);
+	TestTrue(TEXT("Changed strings are fetched again"), Strings == TArray<FString>({ StringTable[3], StringTable[1] }));
+	TestEqual(TEXT("Changed table batch count"), BatchCount, 3);
+
+	// Prefetched strings are served by the cache
+	TestTrue(TEXT("Prefetch"), FHoudiniEngineString::PrefetchStrings({ 4, 5, 4 }));
+	const int32 PrefetchBatchCount = BatchCount;
+	FHoudiniEngineString::SHArrayToFStringArray({ 5, 4 }, Strings);
+	TestTrue(TEXT("Prefetched strings"), Strings == TArray<FString>({ StringTable[5], StringTable[4] }));
+	TestEqual(TEXT("Prefetched strings batch count"), BatchCount, PrefetchBatchCount);
+
+	int64 HitCount = 0;
+	int64 MissCount = 0;
+	int32 EntryCount = 0;
+	FHoudiniEngineString::GetStringCacheStats(HitCount, MissCount, EntryCount);
+	AddInfo(FString::Printf(TEXT("String cache: %lld hits, %lld misses, %d entries"), HitCount, MissCount, EntryCount));
+	TestTrue(TEXT("Hits are counted"), HitCount >= 6);
+	TestTrue(TEXT("Misses are counted"), MissCount >= 6);
+
+	// A new session empties the cache
+	FHoudiniEngineString::InvalidateStringCache();
+	FHoudiniEngineString::GetStringCacheStats(HitCount, MissCount, EntryCount);
+	TestEqual(TEXT("Invalidated cache is empty"), EntryCount, 0);
+
+	FHoudiniEngineString::ResetStringCacheStats();
+	FHoudiniApi::GetStringBatchSize = OldGetStringBatchSize;
+	FHoudiniApi::GetStringBatch = OldGetStringBatch;
+	FHoudiniApi::GetStringBufLength = OldGetStringBufLength;
+	FHoudiniApi::GetString = OldGetString;
+	return true;
+}
+
+#endif
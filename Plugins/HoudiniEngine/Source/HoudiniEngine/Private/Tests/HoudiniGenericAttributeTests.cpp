@@ -0,0 +1,52 @@
+#include "HoudiniGenericAttribute.h"
+#include "Components/StaticMeshComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniGenericAttributeResolvedPropertyTest, "Houdini.Core.GenericAttribute.ResolvedProperty", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniGenericAttributeResolvedPropertyTest::RunTest(const FString & Parameters)
+{
+	UStaticMeshComponent* FirstComponent = NewObject<UStaticMeshComponent>(GetTransientPackage());
+	UStaticMeshComponent* SecondComponent = NewObject<UStaticMeshComponent>(GetTransientPackage());
+
+	// Nested property: found in the component's body instance
+	FEditPropertyChain FirstChain;
+	FProperty* FirstProperty = nullptr;
+	UObject* FirstObject = nullptr;
+	void* FirstContainer = nullptr;
+	TestTrue(TEXT("Property found"), FHoudiniGenericAttribute::FindPropertyOnObject(
+		FirstComponent, TEXT("bSimulatePhysics"), FirstChain, FirstProperty, FirstObject, FirstContainer));
+	TestTrue(TEXT("Property name"), FirstProperty && FirstProperty->GetName() == TEXT("bSimulatePhysics"));
+	TestTrue(TEXT("Container is the body instance"), FirstContainer == &FirstComponent->BodyInstance);
+	TestEqual(TEXT("Property chain"), FirstChain.Num(), 2);
+
+	// Same property on another object of the same class: resolved from the cache
+	FEditPropertyChain SecondChain;
+	FProperty* SecondProperty = nullptr;
+	UObject* SecondObject = nullptr;
+	void* SecondContainer = nullptr;
+	TestTrue(TEXT("Resolved property found"), FHoudiniGenericAttribute::FindPropertyOnObject(
+		SecondComponent, TEXT("bSimulatePhysics"), SecondChain, SecondProperty, SecondObject, SecondContainer));
+	TestTrue(TEXT("Resolved property"), SecondProperty == FirstProperty);
+	TestTrue(TEXT("Resolved property object"), SecondObject == SecondComponent);
+	TestTrue(TEXT("Resolved container"), SecondContainer == &SecondComponent->BodyInstance);
+	TestEqual(TEXT("Resolved property chain"), SecondChain.Num(), FirstChain.Num());
+
+	// Unknown properties stay unknown
+	FEditPropertyChain UnknownChain;
+	FProperty* UnknownProperty = nullptr;
+	UObject* UnknownObject = nullptr;
+	void* UnknownContainer = nullptr;
+	for (int32 Pass = 0; Pass < 2; Pass++)
+	{
+		TestFalse(TEXT("Unknown property"), FHoudiniGenericAttribute::FindPropertyOnObject(
+			FirstComponent, TEXT("NotAHoudiniProperty"), UnknownChain, UnknownProperty, UnknownObject, UnknownContainer));
+		TestEqual(TEXT("Unknown property chain"), UnknownChain.Num(), 0);
+	}
+
+	return true;
+}
+
+#endif
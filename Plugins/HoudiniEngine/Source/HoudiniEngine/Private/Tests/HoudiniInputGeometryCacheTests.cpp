@@ -0,0 +1,230 @@
+#include "../HoudiniInputGeometryCache.h"
+#include "../HoudiniInputTranslator.h"
+#include "HoudiniApi.h"
+#include "HoudiniEngineRuntime.h"
+#include "HoudiniInput.h"
+#include "HoudiniInputObject.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// HAPI stubs: nodes are valid while they are in the set, their unique id is their id * 10.
+namespace HoudiniInputGeometryCacheTest
+{
+	TSet<HAPI_NodeId> ValidNodes;
+
+	HAPI_Result StubGetNodeInfo(const HAPI_Session * Session, HAPI_NodeId NodeId, HAPI_NodeInfo * NodeInfo)
+	{
+		if (!ValidNodes.Contains(NodeId))
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		NodeInfo->id = NodeId;
+		NodeInfo->uniqueHoudiniNodeId = NodeId * 10;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubIsNodeValid(const HAPI_Session * Session, HAPI_NodeId NodeId, int UniqueNodeId, HAPI_Bool * Answer)
+	{
+		*Answer = ValidNodes.Contains(NodeId) && UniqueNodeId == NodeId * 10;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubDeleteNode(const HAPI_Session * Session, HAPI_NodeId NodeId)
+	{
+		ValidNodes.Remove(NodeId);
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	bool IsPendingDelete(const HAPI_NodeId& InNodeId)
+	{
+		for (int32 Idx = 0; Idx < FHoudiniEngineRuntime::Get().GetNodeIdsPendingDeleteCount(); Idx++)
+		{
+			if (FHoudiniEngineRuntime::Get().GetNodeIdsPendingDeleteAt(Idx) == InNodeId)
+				return true;
+		}
+		return false;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniInputGeometryCacheReferencesTest, "Houdini.Core.InputGeometryCache.References", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniInputGeometryCacheReferencesTest::RunTest(const FString & Parameters)
+{
+	using namespace HoudiniInputGeometryCacheTest;
+
+	const FHoudiniApi::GetNodeInfoFuncPtr OldGetNodeInfo = FHoudiniApi::GetNodeInfo;
+	const FHoudiniApi::IsNodeValidFuncPtr OldIsNodeValid = FHoudiniApi::IsNodeValid;
+	FHoudiniApi::GetNodeInfo = &StubGetNodeInfo;
+	FHoudiniApi::IsNodeValid = &StubIsNodeValid;
+	FHoudiniInputGeometryCache::Reset();
+
+	// Three references to the same mesh share its node
+	const uint64 BuildingKey = 0x1234;
+	ValidNodes = { 100 };
+	TestEqual(TEXT("Not cached yet"), FHoudiniInputGeometryCache::FindSharedNode(BuildingKey), -1);
+	TestTrue(TEXT("Add shared node"), FHoudiniInputGeometryCache::AddSharedNode(BuildingKey, 100));
+	TestEqual(TEXT("Cached"), FHoudiniInputGeometryCache::FindSharedNode(BuildingKey), 100);
+
+	for (HAPI_NodeId NodeId : { 201, 202, 203 })
+	{
+		FHoudiniInputGeometryReference Reference;
+		Reference.ContentKey = BuildingKey;
+		Reference.AttributesNodeId = NodeId;
+		FHoudiniInputGeometryCache::SetReference(Reference);
+	}
+	TestEqual(TEXT("Shared nodes"), FHoudiniInputGeometryCache::GetNumSharedNodes(), 1);
+	TestEqual(TEXT("References"), FHoudiniInputGeometryCache::GetNumReferences(), 3);
+
+	FHoudiniInputGeometryReference FoundReference;
+	TestTrue(TEXT("Find reference"), FHoudiniInputGeometryCache::FindReference(202, FoundReference));
+	TestTrue(TEXT("Reference key"), FoundReference.ContentKey == BuildingKey);
+	TestFalse(TEXT("Not a reference"), FHoudiniInputGeometryCache::FindReference(100, FoundReference));
+
+	// The shared node is only released with its last reference
+	HAPI_NodeId SharedNodeToDelete = -1;
+	TestTrue(TEXT("Release first reference"), FHoudiniInputGeometryCache::ReleaseReference(201, SharedNodeToDelete));
+	TestEqual(TEXT("Shared node kept"), SharedNodeToDelete, -1);
+	TestFalse(TEXT("Release first reference twice"), FHoudiniInputGeometryCache::ReleaseReference(201, SharedNodeToDelete));
+	TestFalse(TEXT("Release a node that isn't a reference"), FHoudiniInputGeometryCache::ReleaseReference(100, SharedNodeToDelete));
+	TestTrue(TEXT("Release second reference"), FHoudiniInputGeometryCache::ReleaseReference(202, SharedNodeToDelete));
+	TestEqual(TEXT("Shared node still kept"), SharedNodeToDelete, -1);
+	TestTrue(TEXT("Release last reference"), FHoudiniInputGeometryCache::ReleaseReference(203, SharedNodeToDelete));
+	TestEqual(TEXT("Shared node released"), SharedNodeToDelete, 100);
+	TestEqual(TEXT("Shared nodes after release"), FHoudiniInputGeometryCache::GetNumSharedNodes(), 0);
+	TestEqual(TEXT("References after release"), FHoudiniInputGeometryCache::GetNumReferences(), 0);
+
+	// Shared nodes deleted or replaced in Houdini are evicted
+	ValidNodes = { 300 };
+	FHoudiniInputGeometryCache::AddSharedNode(BuildingKey, 300);
+	ValidNodes = {};
+	TestEqual(TEXT("Deleted shared node"), FHoudiniInputGeometryCache::FindSharedNode(BuildingKey), -1);
+	TestEqual(TEXT("Deleted shared node evicted"), FHoudiniInputGeometryCache::GetNumSharedNodes(), 0);
+
+	FHoudiniInputGeometryCache::Reset();
+	FHoudiniApi::GetNodeInfo = OldGetNodeInfo;
+	FHoudiniApi::IsNodeValid = OldIsNodeValid;
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniInputGeometryCacheDestroyInputTest, "Houdini.Core.InputGeometryCache.DestroyInput", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniInputGeometryCacheDestroyInputTest::RunTest(const FString & Parameters)
+{
+	using namespace HoudiniInputGeometryCacheTest;
+
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Cube"), Cube) || !TestTrue(TEXT("Runtime"), FHoudiniEngineRuntime::IsInitialized()))
+		return false;
+
+	const FHoudiniApi::GetNodeInfoFuncPtr OldGetNodeInfo = FHoudiniApi::GetNodeInfo;
+	const FHoudiniApi::IsNodeValidFuncPtr OldIsNodeValid = FHoudiniApi::IsNodeValid;
+	const FHoudiniApi::DeleteNodeFuncPtr OldDeleteNode = FHoudiniApi::DeleteNode;
+	FHoudiniApi::GetNodeInfo = &StubGetNodeInfo;
+	FHoudiniApi::IsNodeValid = &StubIsNodeValid;
+	FHoudiniApi::DeleteNode = &StubDeleteNode;
+	FHoudiniInputGeometryCache::Reset();
+
+	// Two world inputs, each with a component referencing the same shared mesh
+	const uint64 BuildingKey = 0x1234;
+	const HAPI_NodeId SharedNodeId = 100;
+	ValidNodes = { SharedNodeId, 201, 202 };
+	FHoudiniInputGeometryCache::AddSharedNode(BuildingKey, SharedNodeId);
+
+	TArray<UHoudiniInput*> Inputs;
+	for (HAPI_NodeId NodeId : { 201, 202 })
+	{
+		UHoudiniInput* Input = NewObject<UHoudiniInput>(GetTransientPackage());
+		UStaticMeshComponent* Component = NewObject<UStaticMeshComponent>(GetTransientPackage());
+		Component->SetStaticMesh(Cube);
+		UHoudiniInputObject* InputObject = UHoudiniInputObject::CreateTypedInputObject(Component, Input, TEXT("1"));
+		if (!TestNotNull(TEXT("Input object"), InputObject))
+			break;
+
+		InputObject->InputNodeId = NodeId;
+		Input->GetHoudiniInputObjectArray(EHoudiniInputType::World)->Add(InputObject);
+		Inputs.Add(Input);
+
+		FHoudiniInputGeometryReference Reference;
+		Reference.ContentKey = BuildingKey;
+		Reference.AttributesNodeId = NodeId;
+		FHoudiniInputGeometryCache::SetReference(Reference);
+	}
+
+	if (Inputs.Num() == 2)
+	{
+		// The shared node is kept while another input references it
+		FHoudiniInputTranslator::DestroyInputNodes(Inputs[0], EHoudiniInputType::World);
+		TestEqual(TEXT("References after first destroy"), FHoudiniInputGeometryCache::GetNumReferences(), 1);
+		TestEqual(TEXT("Shared node kept"), FHoudiniInputGeometryCache::GetNumSharedNodes(), 1);
+		TestFalse(TEXT("Shared node not pending delete"), IsPendingDelete(SharedNodeId));
+
+		// Destroying the last referencing input frees it
+		FHoudiniInputTranslator::DestroyInputNodes(Inputs[1], EHoudiniInputType::World);
+		TestEqual(TEXT("References after last destroy"), FHoudiniInputGeometryCache::GetNumReferences(), 0);
+		TestEqual(TEXT("Shared node released"), FHoudiniInputGeometryCache::GetNumSharedNodes(), 0);
+		TestTrue(TEXT("Shared node pending delete"), IsPendingDelete(SharedNodeId));
+	}
+
+	// Don't let the manager delete our fake node
+	for (int32 Idx = FHoudiniEngineRuntime::Get().GetNodeIdsPendingDeleteCount() - 1; Idx >= 0; Idx--)
+	{
+		if (FHoudiniEngineRuntime::Get().GetNodeIdsPendingDeleteAt(Idx) == SharedNodeId)
+			FHoudiniEngineRuntime::Get().RemoveNodeIdPendingDeleteAt(Idx);
+	}
+	FHoudiniEngineRuntime::Get().RemoveParentNodePendingDelete(SharedNodeId);
+
+	FHoudiniInputGeometryCache::Reset();
+	FHoudiniApi::GetNodeInfo = OldGetNodeInfo;
+	FHoudiniApi::IsNodeValid = OldIsNodeValid;
+	FHoudiniApi::DeleteNode = OldDeleteNode;
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniInputGeometryCacheContentKeyTest, "Houdini.Core.InputGeometryCache.StaticMeshContentKey", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniInputGeometryCacheContentKeyTest::RunTest(const FString & Parameters)
+{
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UMaterialInterface* Material = LoadObject<UMaterialInterface>(nullptr, TEXT("/Engine/EngineMaterials/DefaultMaterial.DefaultMaterial"));
+	if (!TestNotNull(TEXT("Cube"), Cube) || !TestNotNull(TEXT("Material"), Material))
+		return false;
+
+	UStaticMeshComponent* FirstComponent = NewObject<UStaticMeshComponent>(GetTransientPackage());
+	UStaticMeshComponent* SecondComponent = NewObject<UStaticMeshComponent>(GetTransientPackage());
+	FirstComponent->SetStaticMesh(Cube);
+	SecondComponent->SetStaticMesh(Cube);
+
+	auto GetKey = [Cube](UStaticMeshComponent* InComponent, const bool& bExportLODs, uint64& OutKey)
+	{
+		return FHoudiniInputGeometryCache::GetStaticMeshContentKey(Cube, InComponent, bExportLODs, false, false, false, false, OutKey);
+	};
+
+	// Components of the same mesh share their key, but not with other export options
+	uint64 FirstKey = 0;
+	uint64 SecondKey = 0;
+	uint64 LODsKey = 0;
+	TestTrue(TEXT("First key"), GetKey(FirstComponent, false, FirstKey));
+	TestTrue(TEXT("Second key"), GetKey(SecondComponent, false, SecondKey));
+	TestTrue(TEXT("LODs key"), GetKey(FirstComponent, true, LODsKey));
+	TestTrue(TEXT("Same mesh"), FirstKey == SecondKey);
+	TestTrue(TEXT("Other options"), FirstKey != LODsKey);
+
+	// Material overrides are exported with the mesh
+	SecondComponent->SetMaterial(0, Material);
+	TestTrue(TEXT("Overridden material key"), GetKey(SecondComponent, false, SecondKey));
+	TestTrue(TEXT("Overridden material"), FirstKey != SecondKey);
+
+	// Component tags can't be shared
+	SecondComponent->ComponentTags.Add(TEXT("Tagged"));
+	TestFalse(TEXT("Tagged component"), GetKey(SecondComponent, false, SecondKey));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,54 @@
+#include "../HoudiniInstanceTranslator.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace HoudiniInstanceTranslatorTest
+{
+	// Ids of the instances in each slot
+	TArray<int32> GetSlotIds(const TArray<int32>& InNewIds, const TArray<int32>& InSlotToInstance)
+	{
+		TArray<int32> SlotIds;
+		for (const int32& InstanceIdx : InSlotToInstance)
+			SlotIds.Add(InNewIds[InstanceIdx]);
+		return SlotIds;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniInstanceTranslatorSlotsTest, "Houdini.Core.InstanceTranslator.InstanceSlots", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniInstanceTranslatorSlotsTest::RunTest(const FString & Parameters)
+{
+	using namespace HoudiniInstanceTranslatorTest;
+
+	// Same ids in another order: every instance keeps its slot
+	TArray<int32> SlotToInstance;
+	FHoudiniInstanceTranslator::ComputeInstanceSlots({ 10, 11, 12 }, { 12, 10, 11 }, SlotToInstance);
+	TestTrue(TEXT("Reordered ids keep their slots"), GetSlotIds({ 12, 10, 11 }, SlotToInstance) == TArray<int32>({ 10, 11, 12 }));
+
+	// Removing an instance in the middle only moves the last one
+	FHoudiniInstanceTranslator::ComputeInstanceSlots({ 10, 11, 12, 13, 14 }, { 10, 12, 13, 14 }, SlotToInstance);
+	TestTrue(TEXT("Removed id is replaced by the last one"), GetSlotIds({ 10, 12, 13, 14 }, SlotToInstance) == TArray<int32>({ 10, 14, 12, 13 }));
+
+	// Added instances reuse the removed slots, then are appended
+	FHoudiniInstanceTranslator::ComputeInstanceSlots({ 10, 11, 12 }, { 20, 10, 21, 12, 22 }, SlotToInstance);
+	TestTrue(TEXT("Added ids fill the free slots"), GetSlotIds({ 20, 10, 21, 12, 22 }, SlotToInstance) == TArray<int32>({ 10, 20, 12, 21, 22 }));
+
+	// Duplicated ids are treated as new instances
+	FHoudiniInstanceTranslator::ComputeInstanceSlots({ 10, 11 }, { 10, 10, 11 }, SlotToInstance);
+	TestTrue(TEXT("Duplicated ids are appended"), SlotToInstance == TArray<int32>({ 0, 2, 1 }));
+
+	// Every new instance is placed exactly once
+	const TArray<int32> OldIds = { 5, 4, 3, 2, 1, 0 };
+	const TArray<int32> NewIds = { 0, 7, 2, 9, 8 };
+	FHoudiniInstanceTranslator::ComputeInstanceSlots(OldIds, NewIds, SlotToInstance);
+	TestEqual(TEXT("Slot count"), SlotToInstance.Num(), NewIds.Num());
+	TArray<int32> SortedInstances = SlotToInstance;
+	SortedInstances.Sort();
+	TestTrue(TEXT("Each instance has a slot"), SortedInstances == TArray<int32>({ 0, 1, 2, 3, 4 }));
+	TestEqual(TEXT("Kept id keeps its slot"), NewIds[SlotToInstance[3]], 2);
+
+	return true;
+}
+
+#endif
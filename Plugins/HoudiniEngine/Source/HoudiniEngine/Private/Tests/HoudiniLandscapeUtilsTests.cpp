@@ -0,0 +1,95 @@
+#include "../HoudiniLandscapeUtils.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniLandscapeUtilsConversionTest, "Houdini.Core.LandscapeUtils.HeightFieldConversion", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniLandscapeUtilsConversionTest::RunTest(const FString & Parameters)
+{
+	// Odd dimensions, larger than a parallel chunk and not a multiple of the SIMD width or the transpose tile
+	const FIntPoint Dimensions(301, 211);
+	FRandomStream Random(1234);
+
+	TArray<float> HoudiniValues;
+	HoudiniValues.SetNumUninitialized(Dimensions.X * Dimensions.Y);
+	for (float& Value : HoudiniValues)
+		Value = Random.FRandRange(-300.0f, 300.0f);
+
+	// Transpose: same as the per-value strided copy
+	TArray<float> Transposed;
+	FHoudiniLandscapeUtils::TransposeHeightFieldData(HoudiniValues, Dimensions, Transposed);
+	int32 TransposeMismatches = 0;
+	for (int32 Y = 0; Y < Dimensions.Y; Y++)
+	{
+		for (int32 X = 0; X < Dimensions.X; X++)
+		{
+			if (Transposed[Y * Dimensions.X + X] != HoudiniValues[Y + Dimensions.Y * X])
+				TransposeMismatches++;
+		}
+	}
+	TestEqual(TEXT("Transposed values"), TransposeMismatches, 0);
+
+	// Resampling: same as the per-pixel bilinear filter
+	FHoudiniHeightFieldData HeightField;
+	HeightField.Dimensions = Dimensions;
+	HeightField.Values = Transposed;
+	for (const FIntPoint& NewDimensions : { FIntPoint(505, 505), FIntPoint(127, 63) })
+	{
+		const FHoudiniHeightFieldData Resampled = FHoudiniLandscapeUtils::ReDimensionLandscape(HeightField, NewDimensions);
+		TestTrue(TEXT("Resampled dimensions"), Resampled.Dimensions == NewDimensions);
+		TestEqual(TEXT("Resampled value count"), Resampled.Values.Num(), NewDimensions.X * NewDimensions.Y);
+
+		const float XScale = (float)(Dimensions.X - 1) / (NewDimensions.X - 1);
+		const float YScale = (float)(Dimensions.Y - 1) / (NewDimensions.Y - 1);
+		float MaxError = 0.0f;
+		for (int32 Y = 0; Y < NewDimensions.Y; ++Y)
+		{
+			for (int32 X = 0; X < NewDimensions.X; ++X)
+			{
+				float OldY = Y * YScale;
+				float OldX = X * XScale;
+				int32 X0 = FMath::FloorToInt(OldX);
+				int32 X1 = FMath::Min(X0 + 1, Dimensions.X - 1);
+				int32 Y0 = FMath::FloorToInt(OldY);
+				int32 Y1 = FMath::Min(Y0 + 1, Dimensions.Y - 1);
+				float Expected = FMath::BiLerp(
+					HeightField.Values[Y0 * Dimensions.X + X0], HeightField.Values[Y0 * Dimensions.X + X1],
+					HeightField.Values[Y1 * Dimensions.X + X0], HeightField.Values[Y1 * Dimensions.X + X1],
+					FMath::Fractional(OldX), FMath::Fractional(OldY));
+				MaxError = FMath::Max(MaxError, FMath::Abs(Resampled.Values[Y * NewDimensions.X + X] - Expected));
+			}
+		}
+		TestTrue(FString::Printf(TEXT("Resampled values %dx%d (max error %g)"), NewDimensions.X, NewDimensions.Y, MaxError), MaxError <= 1.0e-3f);
+	}
+
+	// Quantization: same as realign, clamp and quantize. The compiler may contract the scalar
+	// multiply-add, which can move a value across a quantization step.
+	const float Scale = 100.0f / 512.0f;
+	for (const float ValueRange : { 1.0f, 300.0f })
+	{
+		TArray<float> Data = Transposed;
+		for (float& Value : Data)
+			Value *= ValueRange / 300.0f;
+
+		TArray<float> Expected = Data;
+		FHoudiniLandscapeUtils::RealignHeightFieldData(Expected, 0.5f, Scale * 0.5f);
+		const bool bExpectedClamped = FHoudiniLandscapeUtils::ClampHeightFieldData(Expected, 0.0f, 1.0f);
+		const TArray<uint16> ExpectedQuantized = FHoudiniLandscapeUtils::QuantizeNormalizedDataTo16Bit(Expected);
+
+		TArray<uint16> Quantized;
+		const bool bClamped = FHoudiniLandscapeUtils::ConvertHeightFieldDataTo16Bit(Data, 0.5f, Scale * 0.5f, Quantized);
+		TestEqual(TEXT("Clamped"), bClamped, bExpectedClamped);
+		TestEqual(TEXT("Quantized value count"), Quantized.Num(), ExpectedQuantized.Num());
+
+		int32 MaxError = 0;
+		for (int32 Index = 0; Index < FMath::Min(Quantized.Num(), ExpectedQuantized.Num()); Index++)
+			MaxError = FMath::Max(MaxError, FMath::Abs((int32)Quantized[Index] - (int32)ExpectedQuantized[Index]));
+		TestTrue(FString::Printf(TEXT("Quantized values (max error %d)"), MaxError), MaxError <= 1);
+	}
+
+	return true;
+}
+
+#endif
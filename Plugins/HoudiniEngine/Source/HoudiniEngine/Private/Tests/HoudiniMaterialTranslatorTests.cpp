@@ -0,0 +1,66 @@
+#include "../HoudiniMaterialTranslator.h"
+#include "Engine/Texture2D.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniMaterialTranslatorTextureTest, "Houdini.Core.MaterialTranslator.CreateTexture", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniMaterialTranslatorTextureTest::RunTest(const FString & Parameters)
+{
+	UPackage* Package = CreatePackage(TEXT("/Temp/HoudiniEngineTests/HoudiniMaterialTranslatorTexture"));
+
+	// 3x2 RGBA image, with alpha on one pixel
+	HAPI_ImageInfo ImageInfo = {};
+	ImageInfo.xRes = 3;
+	ImageInfo.yRes = 2;
+	ImageInfo.packing = HAPI_IMAGE_PACKING_RGBA;
+	TArray<char> ImageBuffer;
+	ImageBuffer.SetNumUninitialized(ImageInfo.xRes * ImageInfo.yRes * 4);
+	for (int32 Idx = 0; Idx < ImageBuffer.Num(); Idx++)
+		ImageBuffer[Idx] = (char)(Idx % 4 == 3 ? 0xFF : Idx * 10);
+	ImageBuffer[7] = 0x40;
+
+	FCreateTexture2DParameters TextureParameters;
+	TextureParameters.bUseAlpha = true;
+
+	bool bTextureUpdated = false;
+	UTexture2D* Texture = FHoudiniMaterialTranslator::CreateUnrealTexture(
+		nullptr, ImageInfo, Package, TEXT("T_HoudiniTest"), ImageBuffer, TextureParameters,
+		TEXTUREGROUP_World, TEXT("C_A"), TEXT("/obj/test"), bTextureUpdated);
+	if (!TestNotNull(TEXT("Texture created"), Texture))
+		return false;
+
+	TestTrue(TEXT("New texture is updated"), bTextureUpdated);
+	TestFalse(TEXT("Alpha is detected"), Texture->CompressionNoAlpha);
+
+	// Pixels are converted to BGRA and flipped vertically
+	TArray64<uint8> MipData;
+	Texture->Source.GetMipData(MipData, 0);
+	const int32 LastRowFirstPixel = ImageInfo.xRes * 4;
+	TestEqual(TEXT("Blue"), (int32)MipData[LastRowFirstPixel + 0], 20);
+	TestEqual(TEXT("Green"), (int32)MipData[LastRowFirstPixel + 1], 10);
+	TestEqual(TEXT("Red"), (int32)MipData[LastRowFirstPixel + 2], 0);
+	TestEqual(TEXT("Alpha"), (int32)MipData[LastRowFirstPixel + 7], 0x40);
+
+	// Same image: the texture is left untouched
+	UTexture2D* SameTexture = FHoudiniMaterialTranslator::CreateUnrealTexture(
+		Texture, ImageInfo, Package, TEXT("T_HoudiniTest"), ImageBuffer, TextureParameters,
+		TEXTUREGROUP_World, TEXT("C_A"), TEXT("/obj/test"), bTextureUpdated);
+	TestTrue(TEXT("Same texture"), SameTexture == Texture);
+	TestFalse(TEXT("Identical image is skipped"), bTextureUpdated);
+
+	// Changed image: the texture is updated
+	ImageBuffer[0] = 0x7F;
+	FHoudiniMaterialTranslator::CreateUnrealTexture(
+		Texture, ImageInfo, Package, TEXT("T_HoudiniTest"), ImageBuffer, TextureParameters,
+		TEXTUREGROUP_World, TEXT("C_A"), TEXT("/obj/test"), bTextureUpdated);
+	TestTrue(TEXT("Changed image is updated"), bTextureUpdated);
+
+	Texture->ClearFlags(RF_Public | RF_Standalone);
+	Texture->MarkAsGarbage();
+	return true;
+}
+
+#endif
@@ -0,0 +1,266 @@
+#include "../HoudiniMeshMarshalling.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeLock.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace HoudiniMeshMarshallingTest
+{
+	// Grid of InQuads x InQuads quads, split in two triangles, with all the attributes sent to Houdini.
+	void BuildGridMesh(const int32 InQuads, FMeshDescription& OutMeshDescription)
+	{
+		FStaticMeshAttributes Attributes(OutMeshDescription);
+		Attributes.Register();
+		Attributes.GetVertexInstanceUVs().SetNumChannels(2);
+
+		TVertexAttributesRef<FVector3f> Positions = Attributes.GetVertexPositions();
+		TVertexInstanceAttributesRef<FVector3f> Normals = Attributes.GetVertexInstanceNormals();
+		TVertexInstanceAttributesRef<FVector3f> Tangents = Attributes.GetVertexInstanceTangents();
+		TVertexInstanceAttributesRef<float> BinormalSigns = Attributes.GetVertexInstanceBinormalSigns();
+		TVertexInstanceAttributesRef<FVector4f> Colors = Attributes.GetVertexInstanceColors();
+		TVertexInstanceAttributesRef<FVector2f> UVs = Attributes.GetVertexInstanceUVs();
+
+		const int32 NumRowVertices = InQuads + 1;
+		OutMeshDescription.ReserveNewVertices(NumRowVertices * NumRowVertices);
+		OutMeshDescription.ReserveNewVertexInstances(InQuads * InQuads * 6);
+		OutMeshDescription.ReserveNewTriangles(InQuads * InQuads * 2);
+		OutMeshDescription.ReserveNewPolygons(InQuads * InQuads * 2);
+
+		for (int32 Y = 0; Y < NumRowVertices; Y++)
+		{
+			for (int32 X = 0; X < NumRowVertices; X++)
+			{
+				const FVertexID VertexID = OutMeshDescription.CreateVertex();
+				Positions[VertexID] = FVector3f(X * 10.0f, Y * 10.0f, FMath::Sin(X * 0.1f) * 5.0f);
+			}
+		}
+
+		const FPolygonGroupID PolygonGroupID = OutMeshDescription.CreatePolygonGroup();
+		TArray<FVertexInstanceID> TriangleVertexInstanceIDs;
+		TriangleVertexInstanceIDs.SetNum(3);
+		auto AddTriangle = [&](const int32 InV0, const int32 InV1, const int32 InV2)
+		{
+			const int32 Corners[3] = { InV0, InV1, InV2 };
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const FVertexInstanceID VertexInstanceID = OutMeshDescription.CreateVertexInstance(FVertexID(Corners[Corner]));
+				const float Value = (float)(VertexInstanceID.GetValue() % 97) / 97.0f;
+				Normals[VertexInstanceID] = FVector3f(Value, 1.0f - Value, 0.5f);
+				Tangents[VertexInstanceID] = FVector3f(1.0f - Value, 0.25f, Value);
+				BinormalSigns[VertexInstanceID] = (VertexInstanceID.GetValue() % 2) ? 1.0f : -1.0f;
+				Colors[VertexInstanceID] = FVector4f(Value, 0.5f, 1.0f - Value, Value * 0.5f);
+				UVs.Set(VertexInstanceID, 0, FVector2f(Value, 1.0f - Value));
+				UVs.Set(VertexInstanceID, 1, FVector2f(Value * 0.5f, Value));
+				TriangleVertexInstanceIDs[Corner] = VertexInstanceID;
+			}
+			OutMeshDescription.CreateTriangle(PolygonGroupID, TriangleVertexInstanceIDs);
+		};
+
+		for (int32 Y = 0; Y < InQuads; Y++)
+		{
+			for (int32 X = 0; X < InQuads; X++)
+			{
+				const int32 V00 = Y * NumRowVertices + X;
+				AddTriangle(V00, V00 + 1, V00 + NumRowVertices + 1);
+				AddTriangle(V00, V00 + NumRowVertices + 1, V00 + NumRowVertices);
+			}
+		}
+	}
+
+	// Same fills and uploads as FUnrealMeshTranslator::CreateInputNodeForMeshDescription,
+	// but the uploads copy the buffers instead of sending them to a session.
+	bool MarshalMesh(const FMeshDescription& InMeshDescription, const bool bInParallel, FHoudiniMeshMarshallingBuffers& Buffers, int64& OutUploadedBytes)
+	{
+		TMap<FPolygonGroupID, int32> PolygonGroupToMaterialIndex;
+		for (const FPolygonGroupID PolygonGroupID : InMeshDescription.PolygonGroups().GetElementIDs())
+			PolygonGroupToMaterialIndex.Add(PolygonGroupID, PolygonGroupToMaterialIndex.Num());
+
+		if (Buffers.UVs.Num() < 2)
+			Buffers.UVs.SetNum(2);
+
+		TArray<uint8> Session;
+		OutUploadedBytes = 0;
+		auto Upload = [&](const auto& InValues)
+		{
+			Session.SetNumUninitialized(InValues.Num() * InValues.GetTypeSize(), false);
+			FMemory::Memcpy(Session.GetData(), InValues.GetData(), Session.Num());
+			OutUploadedBytes += Session.Num();
+			return true;
+		};
+
+		TArray<FHoudiniMeshAttributeUpload> Uploads;
+		Uploads.Add({ [&]() { FHoudiniMeshMarshalling::FillMeshDescriptionPoints(InMeshDescription, FVector3f::OneVector, bInParallel, Buffers); },
+			[&]() { return Upload(Buffers.Positions); } });
+		Uploads.Add({ [&]() { FHoudiniMeshMarshalling::FillMeshDescriptionTopology(InMeshDescription, PolygonGroupToMaterialIndex, bInParallel, Buffers); },
+			[&]() { return Upload(Buffers.VertexList) && Upload(Buffers.FaceCounts); } });
+		for (int32 UVLayer = 0; UVLayer < 2; UVLayer++)
+		{
+			Uploads.Add({ [&, UVLayer]() { FHoudiniMeshMarshalling::FillMeshDescriptionUVs(InMeshDescription, UVLayer, bInParallel, Buffers); },
+				[&, UVLayer]() { return Upload(Buffers.UVs[UVLayer]); } });
+		}
+		Uploads.Add({ [&]() { FHoudiniMeshMarshalling::FillMeshDescriptionNormals(InMeshDescription, bInParallel, Buffers); },
+			[&]() { return Upload(Buffers.Normals); } });
+		Uploads.Add({ [&]() { FHoudiniMeshMarshalling::FillMeshDescriptionTangents(InMeshDescription, bInParallel, Buffers); },
+			[&]() { return Upload(Buffers.Tangents); } });
+		Uploads.Add({ [&]() { FHoudiniMeshMarshalling::FillMeshDescriptionBinormals(InMeshDescription, bInParallel, Buffers); },
+			[&]() { return Upload(Buffers.Binormals); } });
+		Uploads.Add({ [&]() { FHoudiniMeshMarshalling::FillMeshDescriptionColors(InMeshDescription, nullptr, nullptr, bInParallel, Buffers); },
+			[&]() { return Upload(Buffers.RGBColors) && Upload(Buffers.Alphas); } });
+		Uploads.Add({ TFunction<void()>(), [&]() { return Upload(Buffers.FaceMaterialIndices); } });
+		Uploads.Add({ [&]() { FHoudiniMeshMarshalling::FillMeshDescriptionSmoothingMasks(InMeshDescription, Buffers); },
+			[&]() { return Upload(Buffers.FaceSmoothingMasks); } });
+
+		return FHoudiniMeshMarshalling::RunUploads(Uploads, bInParallel);
+	}
+
+	bool BuffersMatch(const FHoudiniMeshMarshallingBuffers& A, const FHoudiniMeshMarshallingBuffers& B)
+	{
+		return A.PointSources == B.PointSources && A.PointIndices == B.PointIndices && A.VertexSources == B.VertexSources
+			&& A.VertexList == B.VertexList && A.FaceCounts == B.FaceCounts && A.FaceMaterialIndices == B.FaceMaterialIndices
+			&& A.FaceSmoothingMasks == B.FaceSmoothingMasks && A.Positions == B.Positions && A.Normals == B.Normals
+			&& A.Tangents == B.Tangents && A.Binormals == B.Binormals && A.RGBColors == B.RGBColors && A.Alphas == B.Alphas
+			&& A.UVs == B.UVs;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniMeshMarshallingParallelTest, "Houdini.Core.MeshMarshalling.Parallel", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniMeshMarshallingParallelTest::RunTest(const FString & Parameters)
+{
+	using namespace HoudiniMeshMarshallingTest;
+
+	// Enough triangles to be split in several parallel chunks
+	FMeshDescription MeshDescription;
+	BuildGridMesh(160, MeshDescription);
+	const int32 NumTriangles = MeshDescription.Triangles().Num();
+
+	FHoudiniMeshMarshallingBuffers SerialBuffers;
+	FHoudiniMeshMarshallingBuffers ParallelBuffers;
+	int64 SerialBytes = 0;
+	int64 ParallelBytes = 0;
+	TestTrue(TEXT("Serial marshalling"), MarshalMesh(MeshDescription, false, SerialBuffers, SerialBytes));
+	TestTrue(TEXT("Parallel marshalling"), MarshalMesh(MeshDescription, true, ParallelBuffers, ParallelBytes));
+
+	TestEqual(TEXT("Uploaded bytes"), ParallelBytes, SerialBytes);
+	TestEqual(TEXT("Vertex count"), SerialBuffers.VertexList.Num(), NumTriangles * 3);
+	TestEqual(TEXT("Normal count"), SerialBuffers.Normals.Num(), NumTriangles * 9);
+	TestEqual(TEXT("Alpha count"), SerialBuffers.Alphas.Num(), NumTriangles * 3);
+	TestTrue(TEXT("Parallel buffers match the serial ones"), BuffersMatch(SerialBuffers, ParallelBuffers));
+
+	// The winding is reversed for Houdini: the first triangle (0, 1, 162) becomes (0, 162, 1)
+	if (SerialBuffers.VertexList.Num() >= 3)
+	{
+		TestEqual(TEXT("First vertex"), SerialBuffers.VertexList[0], 0);
+		TestEqual(TEXT("Second vertex"), SerialBuffers.VertexList[1], 162);
+		TestEqual(TEXT("Third vertex"), SerialBuffers.VertexList[2], 1);
+	}
+
+	// Y and Z are swapped and positions are converted to meters, V is flipped
+	if (SerialBuffers.Positions.Num() >= 6 && SerialBuffers.UVs[0].Num() >= 3)
+	{
+		TestEqual(TEXT("Second point X"), SerialBuffers.Positions[3], 0.1f);
+		TestEqual(TEXT("Second point Y"), SerialBuffers.Positions[4], FMath::Sin(0.1f) * 0.05f);
+		TestEqual(TEXT("Second point Z"), SerialBuffers.Positions[5], 0.0f);
+		// The first vertex instance has a (0, 1) UV
+		TestEqual(TEXT("First V"), SerialBuffers.UVs[0][1], 0.0f);
+	}
+
+	// Reused buffers give the same result
+	int64 ReusedBytes = 0;
+	TestTrue(TEXT("Marshalling into used buffers"), MarshalMesh(MeshDescription, true, SerialBuffers, ReusedBytes));
+	TestTrue(TEXT("Reused buffers match"), BuffersMatch(SerialBuffers, ParallelBuffers));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniMeshMarshallingUploadsTest, "Houdini.Core.MeshMarshalling.Uploads", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniMeshMarshallingUploadsTest::RunTest(const FString & Parameters)
+{
+	for (const bool bParallel : { false, true })
+	{
+		FCriticalSection EventsLock;
+		TArray<FString> Events;
+		auto AddEvent = [&](const FString& InEvent)
+		{
+			FScopeLock ScopeLock(&EventsLock);
+			Events.Add(InEvent);
+		};
+
+		// Each fill reads the result of the previous one, the third upload fails
+		TArray<int32> Values;
+		TArray<FHoudiniMeshAttributeUpload> Uploads;
+		for (int32 Index = 0; Index < 4; Index++)
+		{
+			Uploads.Add({
+				[&, Index]() { Values.Add(Values.Num() > 0 ? Values.Last() + 1 : 0); AddEvent(FString::Printf(TEXT("Fill%d"), Index)); },
+				[&, Index]() { AddEvent(FString::Printf(TEXT("Upload%d"), Index)); return Index != 2; } });
+		}
+
+		TestFalse(TEXT("A failed upload stops the uploads"), FHoudiniMeshMarshalling::RunUploads(Uploads, bParallel));
+		TestFalse(TEXT("Uploads after the failure are not sent"), Events.Contains(TEXT("Upload3")));
+		for (int32 Index = 0; Index < 3; Index++)
+		{
+			const int32 FillEvent = Events.IndexOfByKey(FString::Printf(TEXT("Fill%d"), Index));
+			const int32 UploadEvent = Events.IndexOfByKey(FString::Printf(TEXT("Upload%d"), Index));
+			TestTrue(FString::Printf(TEXT("Buffer %d is filled before its upload"), Index), FillEvent != INDEX_NONE && FillEvent < UploadEvent);
+		}
+
+		for (int32 Index = 0; Index < Values.Num(); Index++)
+			TestEqual(TEXT("Fills run in order"), Values[Index], Index);
+	}
+
+	// Released buffers are reused
+	FHoudiniMeshMarshalling::EmptyBufferPool();
+	TUniquePtr<FHoudiniMeshMarshallingBuffers> Buffers = FHoudiniMeshMarshalling::AcquireBuffers();
+	Buffers->Normals.SetNum(1024);
+	const FHoudiniMeshMarshallingBuffers* BuffersPtr = Buffers.Get();
+	FHoudiniMeshMarshalling::ReleaseBuffers(MoveTemp(Buffers));
+	TestEqual(TEXT("Pooled buffers"), FHoudiniMeshMarshalling::GetNumPooledBuffers(), 1);
+
+	Buffers = FHoudiniMeshMarshalling::AcquireBuffers();
+	TestTrue(TEXT("Pooled buffers are reused"), Buffers.Get() == BuffersPtr);
+	TestEqual(TEXT("Pooled buffers are empty"), Buffers->Normals.Num(), 0);
+	TestTrue(TEXT("Pooled buffers keep their allocation"), Buffers->Normals.Max() >= 1024);
+	FHoudiniMeshMarshalling::ReleaseBuffers(MoveTemp(Buffers));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniMeshMarshallingBenchmark, "Houdini.Core.MeshMarshalling.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool HoudiniMeshMarshallingBenchmark::RunTest(const FString & Parameters)
+{
+	using namespace HoudiniMeshMarshallingTest;
+
+	// About 1M, 4M and 10M triangles
+	for (const int32 Quads : { 708, 1415, 2237 })
+	{
+		FMeshDescription MeshDescription;
+		BuildGridMesh(Quads, MeshDescription);
+		const int32 NumTriangles = MeshDescription.Triangles().Num();
+
+		// Warm up the buffers, as when several meshes are sent
+		FHoudiniMeshMarshallingBuffers Buffers;
+		int64 UploadedBytes = 0;
+		MarshalMesh(MeshDescription, true, Buffers, UploadedBytes);
+
+		double Start = FPlatformTime::Seconds();
+		MarshalMesh(MeshDescription, false, Buffers, UploadedBytes);
+		const double SerialTime = FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		MarshalMesh(MeshDescription, true, Buffers, UploadedBytes);
+		const double ParallelTime = FPlatformTime::Seconds() - Start;
+
+		AddInfo(FString::Printf(TEXT("%d triangles (%.1f MB): serial %.1f ms, parallel %.1f ms (x%.2f)"),
+			NumTriangles, UploadedBytes / (1024.0 * 1024.0), SerialTime * 1000.0, ParallelTime * 1000.0,
+			ParallelTime > 0.0 ? SerialTime / ParallelTime : 0.0));
+	}
+
+	return true;
+}
+
+#endif
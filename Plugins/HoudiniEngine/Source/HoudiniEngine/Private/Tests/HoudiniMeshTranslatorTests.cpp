@@ -0,0 +1,695 @@
+#include "../HoudiniMeshTranslator.h"
+#include "../HoudiniEngineUtils.h"
+#include "BSPOps.h"
+#include "Engine/Polys.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "MeshDescription.h"
+#include "Model.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "StaticMeshAttributes.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Editor/UnrealEd/Private/GeomFitUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Synthetic split data, laid out like the arrays produced by TransferRegularPointAttributesToVertices.
+namespace HoudiniMeshTranslatorTest
+{
+	struct FSplitData
+	{
+		int32 VertexCount = 0;
+		TArray<int32> SplitIndices;
+		TArray<float> Normals;
+		TArray<float> TangentU;
+		TArray<float> TangentV;
+		TArray<float> Colors;
+		TArray<float> Alphas;
+		TArray<TArray<float>> UVSets;
+	};
+
+	void FillRandom(FRandomStream& Stream, TArray<float>& OutValues, int32 Num, float Min, float Max)
+	{
+		OutValues.SetNumUninitialized(Num);
+		for (int32 Idx = 0; Idx < Num; Idx++)
+			OutValues[Idx] = Stream.FRandRange(Min, Max);
+	}
+
+	FSplitData MakeSplitData(int32 TriangleCount, int32 VertexCount)
+	{
+		FRandomStream Stream(1234);
+		FSplitData Data;
+		Data.VertexCount = VertexCount;
+
+		const int32 SplitVertexCount = TriangleCount * 3;
+		Data.SplitIndices.SetNumUninitialized(SplitVertexCount);
+		for (int32 Idx = 0; Idx < SplitVertexCount; Idx++)
+			Data.SplitIndices[Idx] = Stream.RandHelper(VertexCount);
+
+		FillRandom(Stream, Data.Normals, SplitVertexCount * 3, -1.0f, 1.0f);
+		FillRandom(Stream, Data.TangentU, SplitVertexCount * 3, -1.0f, 1.0f);
+		FillRandom(Stream, Data.TangentV, SplitVertexCount * 3, -1.0f, 1.0f);
+		FillRandom(Stream, Data.Colors, SplitVertexCount * 3, -0.5f, 1.5f);
+		FillRandom(Stream, Data.Alphas, SplitVertexCount, 0.0f, 1.0f);
+
+		// The second UV set is empty, as for a part without uv2
+		Data.UVSets.SetNum(3);
+		FillRandom(Stream, Data.UVSets[0], SplitVertexCount * 2, 0.0f, 1.0f);
+		FillRandom(Stream, Data.UVSets[2], SplitVertexCount * 2, 0.0f, 1.0f);
+		return Data;
+	}
+
+	// Same construction order as CreateStaticMesh_MeshDescription: vertices, then instances and triangles,
+	// then the vertex instance attributes.
+	void BuildMeshDescription(const FSplitData& Data, bool bParallel, FMeshDescription& OutMeshDescription)
+	{
+		FStaticMeshAttributes Attributes(OutMeshDescription);
+		Attributes.Register();
+		Attributes.GetVertexInstanceUVs().SetNumChannels(Data.UVSets.Num());
+
+		const FPolygonGroupID PolygonGroupID = OutMeshDescription.CreatePolygonGroup();
+		for (int32 Idx = 0; Idx < Data.VertexCount; Idx++)
+			OutMeshDescription.CreateVertex();
+
+		TArray<FVertexInstanceID> VertexInstanceIDs;
+		TArray<int32> InstanceSplitIndices;
+		TArray<FVertexInstanceID> FaceVertexInstanceIDs;
+		FaceVertexInstanceIDs.SetNum(3);
+		for (int32 FaceIndex = 0; FaceIndex < Data.SplitIndices.Num() / 3; FaceIndex++)
+		{
+			const int32* Corners = &Data.SplitIndices[FaceIndex * 3];
+			if (Corners[0] == Corners[1] || Corners[0] == Corners[2] || Corners[1] == Corners[2])
+				continue;
+
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const FVertexInstanceID VertexInstanceID = OutMeshDescription.CreateVertexInstance(FVertexID(Corners[Corner]));
+				VertexInstanceIDs.Add(VertexInstanceID);
+				InstanceSplitIndices.Add(FaceIndex * 3 + (Corner == 1 ? 2 : Corner == 2 ? 1 : 0));
+				FaceVertexInstanceIDs[Corner] = VertexInstanceID;
+			}
+			OutMeshDescription.CreateTriangle(PolygonGroupID, FaceVertexInstanceIDs);
+		}
+
+		FHoudiniMeshTranslator::FillVertexInstanceAttributes(
+			OutMeshDescription, VertexInstanceIDs, InstanceSplitIndices,
+			Data.Normals, Data.TangentU, Data.TangentV,
+			Data.Colors, 3, Data.Alphas,
+			Data.UVSets, bParallel);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniMeshTranslatorParallelBuildTest, "Houdini.Core.MeshTranslator.ParallelBuild", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniMeshTranslatorParallelBuildTest::RunTest(const FString & Parameters)
+{
+	using namespace HoudiniMeshTranslatorTest;
+
+	// Enough vertex instances to be split in several parallel chunks
+	const FSplitData Data = MakeSplitData(100000, 20000);
+
+	FMeshDescription SerialMesh;
+	double Start = FPlatformTime::Seconds();
+	BuildMeshDescription(Data, false, SerialMesh);
+	const double SerialTime = FPlatformTime::Seconds() - Start;
+
+	FMeshDescription ParallelMesh;
+	Start = FPlatformTime::Seconds();
+	BuildMeshDescription(Data, true, ParallelMesh);
+	const double ParallelTime = FPlatformTime::Seconds() - Start;
+
+	AddInfo(FString::Printf(TEXT("Mesh description build: serial %.3f ms, parallel %.3f ms"), SerialTime * 1000.0, ParallelTime * 1000.0));
+
+	if (!TestEqual(TEXT("Vertex instance count"), ParallelMesh.VertexInstances().Num(), SerialMesh.VertexInstances().Num()))
+		return false;
+	TestEqual(TEXT("Triangle count"), ParallelMesh.Triangles().Num(), SerialMesh.Triangles().Num());
+
+	FStaticMeshConstAttributes SerialAttributes(SerialMesh);
+	FStaticMeshConstAttributes ParallelAttributes(ParallelMesh);
+	const int32 UVChannelCount = SerialAttributes.GetVertexInstanceUVs().GetNumChannels();
+
+	int32 MismatchCount = 0;
+	for (const FVertexInstanceID VertexInstanceID : SerialMesh.VertexInstances().GetElementIDs())
+	{
+		bool bMatch = SerialAttributes.GetVertexInstanceNormals()[VertexInstanceID] == ParallelAttributes.GetVertexInstanceNormals()[VertexInstanceID]
+			&& SerialAttributes.GetVertexInstanceTangents()[VertexInstanceID] == ParallelAttributes.GetVertexInstanceTangents()[VertexInstanceID]
+			&& SerialAttributes.GetVertexInstanceBinormalSigns()[VertexInstanceID] == ParallelAttributes.GetVertexInstanceBinormalSigns()[VertexInstanceID]
+			&& SerialAttributes.GetVertexInstanceColors()[VertexInstanceID] == ParallelAttributes.GetVertexInstanceColors()[VertexInstanceID];
+
+		for (int32 UVIndex = 0; UVIndex < UVChannelCount; UVIndex++)
+		{
+			bMatch = bMatch && SerialAttributes.GetVertexInstanceUVs().Get(VertexInstanceID, UVIndex)
+				== ParallelAttributes.GetVertexInstanceUVs().Get(VertexInstanceID, UVIndex);
+		}
+
+		if (!bMatch)
+			MismatchCount++;
+	}
+
+	TestEqual(TEXT("Vertex instance attributes match the serial build"), MismatchCount, 0);
+
+	// The input colors are in [-0.5, 1.5], they must be clamped
+	const FVector4f FirstColor = SerialAttributes.GetVertexInstanceColors()[FVertexInstanceID(0)];
+	TestTrue(TEXT("Colors are clamped"), FirstColor.X >= 0.0f && FirstColor.X <= 1.0f);
+
+	return true;
+}
+
+// Collision splits, laid out like the part caches the mesh translator fetches from HAPI
+namespace HoudiniMeshTranslatorCollision
+{
+	// Adds the 8 points and 12 triangles of a cube, in Houdini space
+	void AddCube(const FVector3f& InCenter, float InSize, TArray<float>& OutPositions, TArray<int32>& OutTriangles)
+	{
+		const int32 FirstPoint = OutPositions.Num() / 3;
+		for (int32 Corner = 0; Corner < 8; Corner++)
+		{
+			OutPositions.Add(InCenter.X + ((Corner & 1) ? InSize : -InSize) * 0.5f);
+			OutPositions.Add(InCenter.Y + ((Corner & 2) ? InSize : -InSize) * 0.5f);
+			OutPositions.Add(InCenter.Z + ((Corner & 4) ? InSize : -InSize) * 0.5f);
+		}
+
+		const int32 Faces[12][3] = {
+			{ 0, 2, 1 }, { 1, 2, 3 }, { 4, 5, 6 }, { 5, 7, 6 }, { 0, 1, 4 }, { 1, 5, 4 },
+			{ 2, 6, 3 }, { 3, 6, 7 }, { 0, 4, 2 }, { 2, 4, 6 }, { 1, 3, 5 }, { 3, 7, 5 } };
+		for (const int32 (&Face)[3] : Faces)
+		{
+			for (int32 Corner = 0; Corner < 3; Corner++)
+				OutTriangles.Add(FirstPoint + Face[Corner]);
+		}
+	}
+
+	bool IsSameAggregate(const FKAggregateGeom& A, const FKAggregateGeom& B)
+	{
+		if (A.BoxElems.Num() != B.BoxElems.Num() || A.SphereElems.Num() != B.SphereElems.Num()
+			|| A.SphylElems.Num() != B.SphylElems.Num() || A.ConvexElems.Num() != B.ConvexElems.Num())
+			return false;
+
+		for (int32 Idx = 0; Idx < A.BoxElems.Num(); Idx++)
+		{
+			const FKBoxElem& BoxA = A.BoxElems[Idx];
+			const FKBoxElem& BoxB = B.BoxElems[Idx];
+			if (BoxA.Center != BoxB.Center || BoxA.Rotation != BoxB.Rotation || BoxA.X != BoxB.X || BoxA.Y != BoxB.Y || BoxA.Z != BoxB.Z)
+				return false;
+		}
+
+		for (int32 Idx = 0; Idx < A.SphereElems.Num(); Idx++)
+		{
+			if (A.SphereElems[Idx].Center != B.SphereElems[Idx].Center || A.SphereElems[Idx].Radius != B.SphereElems[Idx].Radius)
+				return false;
+		}
+
+		for (int32 Idx = 0; Idx < A.SphylElems.Num(); Idx++)
+		{
+			const FKSphylElem& SphylA = A.SphylElems[Idx];
+			const FKSphylElem& SphylB = B.SphylElems[Idx];
+			if (SphylA.Center != SphylB.Center || SphylA.Rotation != SphylB.Rotation || SphylA.Radius != SphylB.Radius || SphylA.Length != SphylB.Length)
+				return false;
+		}
+
+		for (int32 Idx = 0; Idx < A.ConvexElems.Num(); Idx++)
+		{
+			if (A.ConvexElems[Idx].VertexData != B.ConvexElems[Idx].VertexData)
+				return false;
+		}
+
+		return true;
+	}
+
+	// The kdop colliders used to be built from a BSP of the kdop's polygons, through a temporary UModel and UBodySetup
+	bool BuildKDopWithBodySetup(const TArray<FVector>& InPositions, const TArray<FVector>& InDirs, FKConvexElem& OutConvex)
+	{
+		TArray<float> MaxDist;
+		MaxDist.Init(-3.402823466e+38F, InDirs.Num());
+		for (const FVector& Position : InPositions)
+		{
+			for (int32 Dir = 0; Dir < InDirs.Num(); Dir++)
+				MaxDist[Dir] = FMath::Max((float)(Position | InDirs[Dir]), MaxDist[Dir]);
+		}
+
+		TArray<FPlane4f> Planes;
+		for (int32 Dir = 0; Dir < InDirs.Num(); Dir++)
+			Planes.Add(FPlane4f((FVector3f)InDirs[Dir], MaxDist[Dir] + 0.1f));
+
+		UModel* Model = NewObject<UModel>();
+		Model->Initialize(nullptr, 1);
+		for (int32 PlaneIdx = 0; PlaneIdx < Planes.Num(); PlaneIdx++)
+		{
+			FPoly* Polygon = new(Model->Polys->Element) FPoly();
+			FVector3f Base, AxisX, AxisY;
+
+			Polygon->Init();
+			Polygon->Normal = Planes[PlaneIdx];
+			Polygon->Normal.FindBestAxisVectors(AxisX, AxisY);
+
+			Base = Planes[PlaneIdx] * Planes[PlaneIdx].W;
+			new(Polygon->Vertices) FVector3f(Base + AxisX * HALF_WORLD_MAX + AxisY * HALF_WORLD_MAX);
+			new(Polygon->Vertices) FVector3f(Base + AxisX * HALF_WORLD_MAX - AxisY * HALF_WORLD_MAX);
+			new(Polygon->Vertices) FVector3f(Base - AxisX * HALF_WORLD_MAX - AxisY * HALF_WORLD_MAX);
+			new(Polygon->Vertices) FVector3f(Base - AxisX * HALF_WORLD_MAX + AxisY * HALF_WORLD_MAX);
+
+			for (int32 Other = 0; Other < Planes.Num(); Other++)
+			{
+				if (Other != PlaneIdx && !Polygon->Split(-FVector3f(Planes[Other]), Planes[Other] * Planes[Other].W))
+				{
+					Polygon->Vertices.Empty();
+					break;
+				}
+			}
+
+			if (Polygon->Vertices.Num() < 3)
+			{
+				Model->Polys->Element.RemoveAt(Model->Polys->Element.Num() - 1);
+			}
+			else
+			{
+				Polygon->iLink = PlaneIdx;
+				Polygon->CalcNormal(1);
+			}
+		}
+
+		if (Model->Polys->Element.Num() < 4)
+			return false;
+
+		Model->BuildBound();
+		FBSPOps::bspBuild(Model, FBSPOps::BSP_Good, 15, 70, 1, 0);
+		FBSPOps::bspRefresh(Model, 1);
+		FBSPOps::bspBuildBounds(Model);
+
+		UBodySetup* BodySetup = NewObject<UBodySetup>();
+		BodySetup->CreateFromModel(Model, false);
+		if (BodySetup->AggGeom.ConvexElems.Num() != 1)
+			return false;
+
+		OutConvex = BodySetup->AggGeom.ConvexElems[0];
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniMeshTranslatorCollisionTest, "Houdini.Core.MeshTranslator.Collisions", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniMeshTranslatorCollisionTest::RunTest(const FString & Parameters)
+{
+	using namespace HoudiniMeshTranslatorCollision;
+
+	// Two 1m cubes 5m apart, and a lone triangle
+	TArray<float> Positions;
+	TArray<int32> FirstCube;
+	TArray<int32> SecondCube;
+	AddCube(FVector3f(0.0f, 0.0f, 0.0f), 1.0f, Positions, FirstCube);
+	AddCube(FVector3f(5.0f, 1.0f, 0.0f), 1.0f, Positions, SecondCube);
+	const int32 TrianglePoint = Positions.Num() / 3;
+	Positions.Append({ 0.0f, 3.0f, 0.0f, 1.0f, 3.0f, 0.0f, 0.0f, 3.0f, 1.0f });
+
+	TArray<int32> BothCubes = FirstCube;
+	BothCubes.Append(SecondCube);
+	TArray<int32> Pieces = BothCubes;
+	Pieces.Append({ TrianglePoint, TrianglePoint + 1, TrianglePoint + 2 });
+
+	FHoudiniMeshTranslator Translator;
+	Translator.PartPositions = Positions;
+	const TMap<FString, TArray<int32>> Splits = {
+		{ TEXT("collision_geo_ucx"), Pieces },
+		{ TEXT("collision_geo_simple_box"), FirstCube },
+		{ TEXT("collision_geo_simple_sphere"), SecondCube },
+		{ TEXT("collision_geo_simple_capsule"), FirstCube },
+		{ TEXT("collision_geo_simple_kdop18"), SecondCube },
+		{ TEXT("rendered_collision_geo_simple_kdop10X"), BothCubes } };
+	for (const auto& Split : Splits)
+	{
+		Translator.AllSplitGroups.Add(Split.Key);
+		Translator.AllSplitVertexLists.Add(Split.Key, Split.Value);
+	}
+
+	// Each split is built by its own task, the result must not depend on the scheduling
+	Translator.BuildAllSplitCollisions(false);
+	const TMap<FString, FKAggregateGeom> SerialCollisions = Translator.AllSplitCollisions;
+	Translator.BuildAllSplitCollisions(true);
+	if (!TestEqual(TEXT("Collision splits"), Translator.AllSplitCollisions.Num(), Splits.Num())
+		|| !TestEqual(TEXT("Serial collision splits"), SerialCollisions.Num(), Splits.Num()))
+		return false;
+
+	for (const auto& SerialCollision : SerialCollisions)
+	{
+		const FKAggregateGeom* ParallelCollision = Translator.AllSplitCollisions.Find(SerialCollision.Key);
+		TestTrue(SerialCollision.Key + TEXT(" matches the serial build"), ParallelCollision && IsSameAggregate(*ParallelCollision, SerialCollision.Value));
+	}
+
+	TestEqual(TEXT("Box"), Translator.AllSplitCollisions[TEXT("collision_geo_simple_box")].BoxElems.Num(), 1);
+	TestEqual(TEXT("Sphere"), Translator.AllSplitCollisions[TEXT("collision_geo_simple_sphere")].SphereElems.Num(), 1);
+	TestEqual(TEXT("Capsule"), Translator.AllSplitCollisions[TEXT("collision_geo_simple_capsule")].SphylElems.Num(), 1);
+
+	// By default, a single hull around the whole group
+	const FKAggregateGeom& SingleHull = Translator.AllSplitCollisions[TEXT("collision_geo_ucx")];
+	if (TestEqual(TEXT("Single hull"), SingleHull.ConvexElems.Num(), 1))
+		TestEqual(TEXT("Single hull points"), SingleHull.ConvexElems[0].VertexData.Num(), 19);
+
+	// One hull per connected piece, the flat triangle can't make one
+	IConsoleVariable* ConvexPieces = IConsoleManager::Get().FindConsoleVariable(TEXT("HoudiniEngine.ConvexCollisionPerConnectedPiece"));
+	if (!TestNotNull(TEXT("Connected pieces option"), ConvexPieces))
+		return false;
+
+	const int32 ConvexPiecesValue = ConvexPieces->GetInt();
+	ConvexPieces->Set(1, ECVF_SetByCode);
+	Translator.BuildAllSplitCollisions(true);
+	ConvexPieces->Set(ConvexPiecesValue, ECVF_SetByCode);
+
+	const FKAggregateGeom& PieceHulls = Translator.AllSplitCollisions[TEXT("collision_geo_ucx")];
+	if (TestEqual(TEXT("Hull per piece"), PieceHulls.ConvexElems.Num(), 2))
+	{
+		// Points are in Unreal space: Y and Z swapped, in centimeters
+		TestEqual(TEXT("First piece points"), PieceHulls.ConvexElems[0].VertexData.Num(), 8);
+		TestEqual(TEXT("Second piece points"), PieceHulls.ConvexElems[1].VertexData.Num(), 8);
+		TestTrue(TEXT("First piece bounds"), PieceHulls.ConvexElems[0].ElemBox.Equals(FBox(FVector(-50.0), FVector(50.0)), 0.01));
+		TestTrue(TEXT("Second piece bounds"), PieceHulls.ConvexElems[1].ElemBox.Equals(FBox(FVector(450.0, -50.0, 50.0), FVector(550.0, 50.0, 150.0)), 0.01));
+	}
+
+	// The kdop hull is built without the BSP and body setup it used to need, it must have the same shape:
+	// the new hull's points are points of the old hull, and the old hull's points are inside the kdop's planes.
+	TArray<FVector> CubePositions;
+	Translator.GetSplitUniquePositions(TEXT("collision_geo_simple_kdop18"), CubePositions);
+	TArray<FVector> KDop18Dirs;
+	for (int32 Dir = 0; Dir < 18; Dir++)
+		KDop18Dirs.Add(KDopDir18[Dir]);
+
+	FKConvexElem OldKDop;
+	const FKAggregateGeom& NewKDops = Translator.AllSplitCollisions[TEXT("collision_geo_simple_kdop18")];
+	if (TestTrue(TEXT("Old kdop"), BuildKDopWithBodySetup(CubePositions, KDop18Dirs, OldKDop))
+		&& TestEqual(TEXT("New kdop"), NewKDops.ConvexElems.Num(), 1))
+	{
+		const FKConvexElem& NewKDop = NewKDops.ConvexElems[0];
+		TestTrue(TEXT("Kdop bounds"), NewKDop.ElemBox.Equals(OldKDop.ElemBox, 0.01));
+
+		int32 NewPointsNotInOld = 0;
+		for (const FVector& Point : NewKDop.VertexData)
+		{
+			if (!OldKDop.VertexData.ContainsByPredicate([&Point](const FVector& InOther) { return InOther.Equals(Point, 0.01); }))
+				NewPointsNotInOld++;
+		}
+		TestEqual(TEXT("New kdop points are old kdop points"), NewPointsNotInOld, 0);
+
+		int32 OldPointsOutside = 0;
+		for (const FVector& Point : OldKDop.VertexData)
+		{
+			for (const FVector& Dir : KDop18Dirs)
+			{
+				float MaxDist = -3.402823466e+38F;
+				for (const FVector& Position : CubePositions)
+					MaxDist = FMath::Max((float)(Position | Dir), MaxDist);
+
+				if ((Point | Dir) > MaxDist + 0.1f + 0.01f)
+				{
+					OldPointsOutside++;
+					break;
+				}
+			}
+		}
+		TestEqual(TEXT("Old kdop points are inside the new kdop"), OldPointsOutside, 0);
+	}
+
+	return true;
+}
+
+// Deferred static mesh builds, as opened by the proxy refinement
+namespace HoudiniMeshTranslatorDeferredBuild
+{
+	// A transient static mesh with a one triangle mesh description, that still has to be built
+	UStaticMesh* CreateUnbuiltStaticMesh()
+	{
+		UStaticMesh* SM = NewObject<UStaticMesh>(GetTransientPackage(), NAME_None, RF_Transient);
+		SM->SetNumSourceModels(1);
+		SM->GetStaticMaterials().Add(FStaticMaterial());
+
+		FMeshDescription* MeshDescription = SM->CreateMeshDescription(0);
+		FStaticMeshAttributes Attributes(*MeshDescription);
+		Attributes.Register();
+
+		const FPolygonGroupID PolygonGroupID = MeshDescription->CreatePolygonGroup();
+		TArray<FVertexInstanceID> VertexInstanceIDs;
+		const FVector3f Positions[3] = { FVector3f(0.0f, 0.0f, 0.0f), FVector3f(0.0f, 100.0f, 0.0f), FVector3f(100.0f, 0.0f, 0.0f) };
+		for (const FVector3f& Position : Positions)
+		{
+			const FVertexID VertexID = MeshDescription->CreateVertex();
+			Attributes.GetVertexPositions()[VertexID] = Position;
+			VertexInstanceIDs.Add(MeshDescription->CreateVertexInstance(VertexID));
+		}
+		MeshDescription->CreateTriangle(PolygonGroupID, VertexInstanceIDs);
+		SM->CommitMeshDescription(0);
+		return SM;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniMeshTranslatorDeferredBuildTest, "Houdini.Core.MeshTranslator.DeferredBuilds", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniMeshTranslatorDeferredBuildTest::RunTest(const FString & Parameters)
+{
+	using namespace HoudiniMeshTranslatorDeferredBuild;
+
+	if (!TestFalse(TEXT("No deferred build before the test"), FHoudiniMeshTranslator::IsDeferringStaticMeshBuilds()))
+		return false;
+
+	// Outside of a deferred build, the meshes are built right away by the translator
+	UStaticMesh* Immediate = CreateUnbuiltStaticMesh();
+	TestFalse(TEXT("Not deferred outside of a scope"), FHoudiniMeshTranslator::DeferStaticMeshBuild(Immediate));
+
+	// Refinement without cooks: the scope is closed once every component was refined
+	UStaticMesh* Refined = CreateUnbuiltStaticMesh();
+	FHoudiniMeshTranslator::BeginDeferredStaticMeshBuilds();
+	TestTrue(TEXT("Refined mesh deferred"), FHoudiniMeshTranslator::DeferStaticMeshBuild(Refined));
+	TestFalse(TEXT("Refined mesh not built while deferring"), Refined->HasValidRenderData());
+	TestEqual(TEXT("Refined mesh built at the end of the scope"), FHoudiniMeshTranslator::EndDeferredStaticMeshBuilds(), 1);
+	TestTrue(TEXT("Refined mesh has render data"), Refined->HasValidRenderData());
+
+	// Refinement with cooks: the scope opened at the start of the batch stays open while the components cook,
+	// the meshes built by the cooks and by BuildStaticMeshesForAllHoudiniStaticMeshes (a nested scope) are
+	// only built when the background wait for the cooks completes.
+	UStaticMesh* RefinedBeforeCook = CreateUnbuiltStaticMesh();
+	UStaticMesh* Cooked = CreateUnbuiltStaticMesh();
+	UStaticMesh* NestedRefine = CreateUnbuiltStaticMesh();
+	FHoudiniMeshTranslator::BeginDeferredStaticMeshBuilds();
+	TestTrue(TEXT("Mesh refined before the cooks deferred"), FHoudiniMeshTranslator::DeferStaticMeshBuild(RefinedBeforeCook));
+	TestTrue(TEXT("Cooked mesh deferred"), FHoudiniMeshTranslator::DeferStaticMeshBuild(Cooked));
+
+	FHoudiniMeshTranslator::BeginDeferredStaticMeshBuilds();
+	TestTrue(TEXT("Nested mesh deferred"), FHoudiniMeshTranslator::DeferStaticMeshBuild(NestedRefine));
+	TestEqual(TEXT("Nested scope builds nothing"), FHoudiniMeshTranslator::EndDeferredStaticMeshBuilds(), 0);
+	TestTrue(TEXT("Still deferring after the nested scope"), FHoudiniMeshTranslator::IsDeferringStaticMeshBuilds());
+	TestFalse(TEXT("Nested mesh not built before the cooks are done"), NestedRefine->HasValidRenderData());
+	TestFalse(TEXT("Cooked mesh not built before the cooks are done"), Cooked->HasValidRenderData());
+
+	TestEqual(TEXT("All meshes built once the cooks are done"), FHoudiniMeshTranslator::EndDeferredStaticMeshBuilds(), 3);
+	TestFalse(TEXT("Scope closed"), FHoudiniMeshTranslator::IsDeferringStaticMeshBuilds());
+	TestTrue(TEXT("Mesh refined before the cooks has render data"), RefinedBeforeCook->HasValidRenderData());
+	TestTrue(TEXT("Cooked mesh has render data"), Cooked->HasValidRenderData());
+	TestTrue(TEXT("Nested mesh has render data"), NestedRefine->HasValidRenderData());
+
+	// An unbalanced end is ignored
+	TestEqual(TEXT("Unbalanced end ignored"), FHoudiniMeshTranslator::EndDeferredStaticMeshBuilds(), 0);
+
+	return true;
+}
+
+// HAPI stubs: mesh parts with positions, vertex normals and uvs, the values only depend on the part and element.
+namespace HoudiniMeshTranslatorOutputFetch
+{
+	const int32 PartCount = 12;
+	FThreadSafeCounter VertexListCount;
+
+	int32 GetPointCount(HAPI_PartId PartId) { return 8 + PartId * 5; }
+	int32 GetFaceCount(HAPI_PartId PartId) { return 4 + PartId * 3; }
+
+	float GetAttributeValue(HAPI_NodeId NodeId, HAPI_PartId PartId, int32 AttributeIdx, int32 ValueIdx)
+	{
+		return NodeId * 1000.0f + PartId * 100.0f + AttributeIdx * 10.0f + ValueIdx * 0.25f;
+	}
+
+	void StubAttributeInfo_Init(HAPI_AttributeInfo * AttributeInfo)
+	{
+		FMemory::Memzero(*AttributeInfo);
+		AttributeInfo->owner = HAPI_ATTROWNER_INVALID;
+		AttributeInfo->storage = HAPI_STORAGETYPE_INVALID;
+		AttributeInfo->typeInfo = HAPI_ATTRIBUTE_TYPE_INVALID;
+	}
+
+	void StubPartInfo_Init(HAPI_PartInfo * PartInfo)
+	{
+		FMemory::Memzero(*PartInfo);
+	}
+
+	HAPI_Result StubGetPartInfo(const HAPI_Session * Session, HAPI_NodeId NodeId, HAPI_PartId PartId, HAPI_PartInfo * PartInfo)
+	{
+		// No attribute is listed, so no uv set is found by type
+		StubPartInfo_Init(PartInfo);
+		PartInfo->id = PartId;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubGetAttributeNames(const HAPI_Session * Session, HAPI_NodeId NodeId, HAPI_PartId PartId, HAPI_AttributeOwner Owner, HAPI_StringHandle * AttributeNames, int Count)
+	{
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubGetAttributeInfo(const HAPI_Session * Session, HAPI_NodeId NodeId, HAPI_PartId PartId, const char * Name, HAPI_AttributeOwner Owner, HAPI_AttributeInfo * AttributeInfo)
+	{
+		StubAttributeInfo_Init(AttributeInfo);
+
+		HAPI_AttributeOwner AttributeOwner = HAPI_ATTROWNER_INVALID;
+		HAPI_AttributeTypeInfo AttributeType = HAPI_ATTRIBUTE_TYPE_INVALID;
+		if (FCStringAnsi::Strcmp(Name, HAPI_UNREAL_ATTRIB_POSITION) == 0)
+		{
+			AttributeOwner = HAPI_ATTROWNER_POINT;
+			AttributeType = HAPI_ATTRIBUTE_TYPE_POINT;
+		}
+		else if (FCStringAnsi::Strcmp(Name, HAPI_UNREAL_ATTRIB_NORMAL) == 0)
+		{
+			AttributeOwner = HAPI_ATTROWNER_VERTEX;
+			AttributeType = HAPI_ATTRIBUTE_TYPE_NORMAL;
+		}
+		else if (FCStringAnsi::Strcmp(Name, HAPI_UNREAL_ATTRIB_UV) == 0)
+		{
+			AttributeOwner = HAPI_ATTROWNER_VERTEX;
+			AttributeType = HAPI_ATTRIBUTE_TYPE_TEXTURE;
+		}
+
+		if (AttributeOwner != Owner)
+			return HAPI_RESULT_SUCCESS;
+
+		AttributeInfo->exists = true;
+		AttributeInfo->owner = AttributeOwner;
+		AttributeInfo->storage = HAPI_STORAGETYPE_FLOAT;
+		AttributeInfo->typeInfo = AttributeType;
+		AttributeInfo->tupleSize = 3;
+		AttributeInfo->count = AttributeOwner == HAPI_ATTROWNER_POINT ? GetPointCount(PartId) : GetFaceCount(PartId) * 3;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubGetAttributeFloatData(const HAPI_Session * Session, HAPI_NodeId NodeId, HAPI_PartId PartId, const char * Name, HAPI_AttributeInfo * AttributeInfo, int Stride, float * Data, int Start, int Length)
+	{
+		const int32 AttributeIdx = AttributeInfo->typeInfo;
+		const int32 TupleSize = AttributeInfo->tupleSize;
+		for (int32 ValueIdx = 0; ValueIdx < Length * TupleSize; ValueIdx++)
+			Data[ValueIdx] = GetAttributeValue(NodeId, PartId, AttributeIdx, Start * TupleSize + ValueIdx);
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubGetVertexList(const HAPI_Session * Session, HAPI_NodeId NodeId, HAPI_PartId PartId, int * VertexList, int Start, int Length)
+	{
+		VertexListCount.Increment();
+		for (int32 Idx = 0; Idx < Length; Idx++)
+			VertexList[Idx] = ((Start + Idx) * 7) % GetPointCount(PartId);
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubGetMaterialNodeIdsOnFaces(const HAPI_Session * Session, HAPI_NodeId NodeId, HAPI_PartId PartId, HAPI_Bool * AreAllTheSame, HAPI_NodeId * MaterialIds, int Start, int Length)
+	{
+		*AreAllTheSame = true;
+		for (int32 Idx = 0; Idx < Length; Idx++)
+			MaterialIds[Idx] = -1;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	UHoudiniOutput* CreateMeshOutput(HAPI_NodeId GeoId)
+	{
+		UHoudiniOutput* Output = NewObject<UHoudiniOutput>(GetTransientPackage(), NAME_None, RF_Transient);
+		for (int32 PartId = 0; PartId < PartCount; PartId++)
+		{
+			FHoudiniGeoPartObject HGPO;
+			HGPO.Type = EHoudiniPartType::Mesh;
+			HGPO.ObjectId = 1;
+			HGPO.GeoId = GeoId;
+			HGPO.PartId = PartId;
+			HGPO.bHasGeoChanged = true;
+			HGPO.GeoInfo.NodeId = GeoId;
+			HGPO.PartInfo.PartId = PartId;
+			HGPO.PartInfo.PointCount = GetPointCount(PartId);
+			HGPO.PartInfo.FaceCount = GetFaceCount(PartId);
+			HGPO.PartInfo.VertexCount = GetFaceCount(PartId) * 3;
+			Output->AddNewHGPO(HGPO);
+		}
+		return Output;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniMeshTranslatorParallelOutputFetchTest, "Houdini.Core.MeshTranslator.ParallelOutputFetch", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniMeshTranslatorParallelOutputFetchTest::RunTest(const FString & Parameters)
+{
+	using namespace HoudiniMeshTranslatorOutputFetch;
+
+	// The stubs replace the global HAPI functions, don't run next to a live session.
+	if (FHoudiniEngineUtils::IsInitialized())
+	{
+		AddInfo(TEXT("Skipped, a Houdini Engine session is running."));
+		return true;
+	}
+
+	const FHoudiniApi::AttributeInfo_InitFuncPtr OldAttributeInfo_Init = FHoudiniApi::AttributeInfo_Init;
+	const FHoudiniApi::PartInfo_InitFuncPtr OldPartInfo_Init = FHoudiniApi::PartInfo_Init;
+	const FHoudiniApi::GetPartInfoFuncPtr OldGetPartInfo = FHoudiniApi::GetPartInfo;
+	const FHoudiniApi::GetAttributeNamesFuncPtr OldGetAttributeNames = FHoudiniApi::GetAttributeNames;
+	const FHoudiniApi::GetAttributeInfoFuncPtr OldGetAttributeInfo = FHoudiniApi::GetAttributeInfo;
+	const FHoudiniApi::GetAttributeFloatDataFuncPtr OldGetAttributeFloatData = FHoudiniApi::GetAttributeFloatData;
+	const FHoudiniApi::GetVertexListFuncPtr OldGetVertexList = FHoudiniApi::GetVertexList;
+	const FHoudiniApi::GetMaterialNodeIdsOnFacesFuncPtr OldGetMaterialNodeIdsOnFaces = FHoudiniApi::GetMaterialNodeIdsOnFaces;
+	FHoudiniApi::AttributeInfo_Init = &StubAttributeInfo_Init;
+	FHoudiniApi::PartInfo_Init = &StubPartInfo_Init;
+	FHoudiniApi::GetPartInfo = &StubGetPartInfo;
+	FHoudiniApi::GetAttributeNames = &StubGetAttributeNames;
+	FHoudiniApi::GetAttributeInfo = &StubGetAttributeInfo;
+	FHoudiniApi::GetAttributeFloatData = &StubGetAttributeFloatData;
+	FHoudiniApi::GetVertexList = &StubGetVertexList;
+	FHoudiniApi::GetMaterialNodeIdsOnFaces = &StubGetMaterialNodeIdsOnFaces;
+
+	TArray<TPair<UHoudiniOutput*, EHoudiniStaticMeshMethod>> MeshOutputs;
+	MeshOutputs.Add(MakeTuple(CreateMeshOutput(10), EHoudiniStaticMeshMethod::RawMesh));
+	MeshOutputs.Add(MakeTuple(CreateMeshOutput(20), EHoudiniStaticMeshMethod::FMeshDescription));
+
+	VertexListCount.Reset();
+	FHoudiniMeshPrefetchedParts SerialParts;
+	FHoudiniMeshTranslator::PrefetchMeshPartData(MeshOutputs, false, SerialParts);
+	TestEqual(TEXT("Serial fetch reads every part once"), VertexListCount.GetValue(), PartCount * 2);
+
+	VertexListCount.Reset();
+	FHoudiniMeshPrefetchedParts ParallelParts;
+	FHoudiniMeshTranslator::PrefetchMeshPartData(MeshOutputs, true, ParallelParts);
+	TestEqual(TEXT("Parallel fetch reads every part once"), VertexListCount.GetValue(), PartCount * 2);
+
+	FHoudiniApi::AttributeInfo_Init = OldAttributeInfo_Init;
+	FHoudiniApi::PartInfo_Init = OldPartInfo_Init;
+	FHoudiniApi::GetPartInfo = OldGetPartInfo;
+	FHoudiniApi::GetAttributeNames = OldGetAttributeNames;
+	FHoudiniApi::GetAttributeInfo = OldGetAttributeInfo;
+	FHoudiniApi::GetAttributeFloatData = OldGetAttributeFloatData;
+	FHoudiniApi::GetVertexList = OldGetVertexList;
+	FHoudiniApi::GetMaterialNodeIdsOnFaces = OldGetMaterialNodeIdsOnFaces;
+
+	TestEqual(TEXT("Every serial part prefetched"), SerialParts.Num(), PartCount * 2);
+	TestEqual(TEXT("Every parallel part prefetched"), ParallelParts.Num(), PartCount * 2);
+
+	for (const TPair<TTuple<int32, int32, int32>, TSharedPtr<FHoudiniMeshTranslator>>& SerialPart : SerialParts)
+	{
+		const TSharedPtr<FHoudiniMeshTranslator>* ParallelPart = ParallelParts.Find(SerialPart.Key);
+		const FString PartName = FString::Printf(TEXT("Geo %d Part %d"), SerialPart.Key.Get<1>(), SerialPart.Key.Get<2>());
+		if (!TestNotNull(*FString::Printf(TEXT("%s prefetched in parallel"), *PartName), ParallelPart))
+			continue;
+
+		const FHoudiniMeshTranslator& Serial = *SerialPart.Value;
+		const FHoudiniMeshTranslator& Parallel = **ParallelPart;
+
+		// The stubbed values are read, not left uninitialized
+		if (TestEqual(*FString::Printf(TEXT("%s positions fetched"), *PartName), Serial.PartPositions.Num(), GetPointCount(SerialPart.Key.Get<2>()) * 3))
+			TestEqual(*FString::Printf(TEXT("%s first position"), *PartName), Serial.PartPositions[0], GetAttributeValue(SerialPart.Key.Get<1>(), SerialPart.Key.Get<2>(), HAPI_ATTRIBUTE_TYPE_POINT, 0));
+
+		TestTrue(*FString::Printf(TEXT("%s vertex list"), *PartName), Serial.PartVertexList == Parallel.PartVertexList);
+		TestTrue(*FString::Printf(TEXT("%s split vertex lists"), *PartName), Serial.AllSplitVertexLists.OrderIndependentCompareEqual(Parallel.AllSplitVertexLists));
+		TestTrue(*FString::Printf(TEXT("%s positions"), *PartName), Serial.PartPositions == Parallel.PartPositions);
+		TestTrue(*FString::Printf(TEXT("%s normals"), *PartName), Serial.PartNormals == Parallel.PartNormals);
+		TestTrue(*FString::Printf(TEXT("%s uv sets"), *PartName), Serial.PartUVSets == Parallel.PartUVSets);
+		TestTrue(*FString::Printf(TEXT("%s face material ids"), *PartName), Serial.PartFaceMaterialIds == Parallel.PartFaceMaterialIds);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,119 @@
+#include "../HoudiniPDGImportQueue.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniPDGImportQueueTest, "Houdini.Core.PDG.ImportQueue", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniPDGImportQueueTest::RunTest(const FString & Parameters)
+{
+	auto MakeRequest = [](const int32 WorkItemId)
+	{
+		return FHoudiniPDGImportBGEOMessage(
+			FString::Printf(TEXT("/tmp/tile_%d.bgeo.sc"), WorkItemId),
+			FString::Printf(TEXT("tile_%d"), WorkItemId),
+			FHoudiniPackageParams(),
+			7,
+			WorkItemId);
+	};
+
+	FHoudiniPDGImportQueue Queue;
+	const FGuid WorkerA = FGuid::NewGuid();
+	const FGuid WorkerB = FGuid::NewGuid();
+	const FGuid UnknownWorker = FGuid::NewGuid();
+	Queue.AddWorker(WorkerA);
+	Queue.AddWorker(WorkerB);
+
+	for (int32 WorkItemId = 0; WorkItemId < 10; WorkItemId++)
+		Queue.Enqueue(MakeRequest(WorkItemId));
+
+	// Queuing a result object again replaces its pending request
+	Queue.Enqueue(MakeRequest(3));
+	TestEqual(TEXT("Pending"), Queue.GetNumPending(), 10);
+	TestEqual(TEXT("Queued"), Queue.GetNumQueued(), 10);
+
+	// Requests alternate between the workers, in order, up to the per worker limit.
+	// Workers that are not registered get nothing.
+	TArray<TPair<FGuid, FHoudiniPDGImportBGEOMessage>> Dispatched;
+	TestEqual(TEXT("Dispatched"), Queue.Dispatch({ WorkerA, WorkerB, UnknownWorker }, 2, Dispatched), 4);
+	TestEqual(TEXT("Pending after dispatch"), Queue.GetNumPending(), 6);
+	TestEqual(TEXT("In flight A"), Queue.GetNumInFlight(WorkerA), 2);
+	TestEqual(TEXT("In flight B"), Queue.GetNumInFlight(WorkerB), 2);
+	for (int32 Index = 0; Index < Dispatched.Num(); Index++)
+	{
+		TestEqual(TEXT("Dispatch order"), Dispatched[Index].Value.WorkItemId, Index);
+		TestTrue(TEXT("Dispatch worker"), Dispatched[Index].Key == (Index % 2 == 0 ? WorkerA : WorkerB));
+	}
+
+	// Full workers do not get more requests
+	Dispatched.Empty();
+	TestEqual(TEXT("Dispatched when full"), Queue.Dispatch({ WorkerA, WorkerB }, 2, Dispatched), 0);
+
+	// Completing frees a slot on that worker only
+	TestTrue(TEXT("Complete"), Queue.Complete(WorkerB, MakeRequest(1), true));
+	TestFalse(TEXT("Complete on the wrong worker"), Queue.Complete(WorkerA, MakeRequest(3), true));
+	TestTrue(TEXT("Complete failure"), Queue.Complete(WorkerB, MakeRequest(3), false));
+	TestEqual(TEXT("Dispatched after completion"), Queue.Dispatch({ WorkerA, WorkerB }, 2, Dispatched), 2);
+	TestTrue(TEXT("Dispatched to the free worker"), Dispatched.Num() == 2 && Dispatched[0].Key == WorkerB && Dispatched[1].Key == WorkerB);
+	TestEqual(TEXT("Completed"), Queue.GetNumCompleted(), 1);
+	TestEqual(TEXT("Failed"), Queue.GetNumFailed(), 1);
+
+	// A worker that stops gives its requests back, in front of the queue
+	TArray<FHoudiniPDGImportBGEOMessage> Failed;
+	Queue.RemoveWorker(WorkerA, Failed);
+	TestEqual(TEXT("No failures on first stop"), Failed.Num(), 0);
+	TestFalse(TEXT("Worker removed"), Queue.HasWorker(WorkerA));
+	TestEqual(TEXT("Pending after stop"), Queue.GetNumPending(), 6);
+	Dispatched.Empty();
+	Queue.AddWorker(WorkerA);
+	TestEqual(TEXT("Redispatched"), Queue.Dispatch({ WorkerA }, 2, Dispatched), 2);
+	TestTrue(TEXT("Redispatched first"), Dispatched.Num() == 2 && Dispatched[0].Value.WorkItemId == 0 && Dispatched[1].Value.WorkItemId == 2);
+
+	// Requests that keep stopping workers are failed after MaxAttempts
+	Queue.RemoveWorker(WorkerA, Failed);
+	TestEqual(TEXT("Failed after max attempts"), Failed.Num(), 2);
+	TestEqual(TEXT("Failed count"), Queue.GetNumFailed(), 3);
+
+	// Pending requests can be taken back to be loaded without the workers
+	TArray<FHoudiniPDGImportBGEOMessage> Taken;
+	Queue.TakePending(Taken);
+	TestEqual(TEXT("Taken"), Taken.Num(), 4);
+	TestEqual(TEXT("Pending after take"), Queue.GetNumPending(), 0);
+	TestEqual(TEXT("In flight after take"), Queue.GetNumInFlight(), 2);
+
+	// Progress restarts once the queue is idle
+	TestTrue(TEXT("Complete remaining"), Queue.Complete(WorkerB, MakeRequest(4), true) && Queue.Complete(WorkerB, MakeRequest(5), true));
+	TestTrue(TEXT("Idle"), Queue.IsIdle());
+	Queue.Enqueue(MakeRequest(42));
+	TestEqual(TEXT("Queued after idle"), Queue.GetNumQueued(), 1);
+	TestEqual(TEXT("Completed after idle"), Queue.GetNumCompleted(), 0);
+
+	// Queuing a result object again while it is in flight supersedes that request: its result is discarded,
+	// and the new request takes its place in the progress
+	Dispatched.Empty();
+	TestEqual(TEXT("Dispatched before requeue"), Queue.Dispatch({ WorkerB }, 2, Dispatched), 1);
+	Queue.Enqueue(MakeRequest(42));
+	TestEqual(TEXT("Pending after requeue in flight"), Queue.GetNumPending(), 1);
+	TestEqual(TEXT("Queued after requeue in flight"), Queue.GetNumQueued(), 1);
+	TestFalse(TEXT("Superseded result discarded"), Queue.Complete(WorkerB, MakeRequest(42), true));
+	TestEqual(TEXT("Superseded not completed"), Queue.GetNumCompleted(), 0);
+	Dispatched.Empty();
+	TestEqual(TEXT("Dispatched after requeue"), Queue.Dispatch({ WorkerB }, 2, Dispatched), 1);
+	TestTrue(TEXT("Complete replacement"), Queue.Complete(WorkerB, MakeRequest(42), true));
+	TestEqual(TEXT("Completed after requeue"), Queue.GetNumCompleted(), 1);
+	TestTrue(TEXT("Idle after requeue"), Queue.IsIdle());
+
+	// A superseded request is dropped, not requeued, when its worker stops
+	Dispatched.Empty();
+	Queue.Enqueue(MakeRequest(43));
+	TestEqual(TEXT("Dispatched before stop"), Queue.Dispatch({ WorkerB }, 2, Dispatched), 1);
+	Queue.Enqueue(MakeRequest(43));
+	Failed.Empty();
+	Queue.RemoveWorker(WorkerB, Failed);
+	TestEqual(TEXT("Superseded not failed"), Failed.Num(), 0);
+	TestEqual(TEXT("Superseded not requeued"), Queue.GetNumPending(), 1);
+
+	return true;
+}
+
+#endif
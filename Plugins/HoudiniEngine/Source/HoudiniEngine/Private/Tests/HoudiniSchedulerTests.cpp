@@ -0,0 +1,179 @@
+#include "../HoudiniEngine.h"
+#include "../HoudiniEngineScheduler.h"
+#include "../HoudiniEngineUtils.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeLock.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// HAPI stubs: every cook finishes immediately, cooked node ids are recorded with their start time.
+namespace HoudiniSchedulerTest
+{
+	FCriticalSection CookLock;
+	TArray<HAPI_NodeId> CookedNodes;
+	TArray<double> CookTimes;
+
+	HAPI_Result StubSuccess(const HAPI_Session * Session)
+	{
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubCookNode(const HAPI_Session * Session, HAPI_NodeId NodeId, const HAPI_CookOptions * CookOptions)
+	{
+		FScopeLock ScopeLock(&CookLock);
+		CookedNodes.Add(NodeId);
+		CookTimes.Add(FPlatformTime::Seconds());
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	HAPI_Result StubGetStatus(const HAPI_Session * Session, HAPI_StatusType StatusType, int * Status)
+	{
+		*Status = HAPI_STATE_READY;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	void StubCookOptionsInit(HAPI_CookOptions * CookOptions)
+	{
+	}
+
+	int32 GetCookCount()
+	{
+		FScopeLock ScopeLock(&CookLock);
+		return CookedNodes.Num();
+	}
+
+	FHoudiniEngineTask MakeCookTask(HAPI_NodeId AssetId)
+	{
+		FHoudiniEngineTask Task(EHoudiniEngineTaskType::AssetCooking, FGuid::NewGuid());
+		Task.AssetId = AssetId;
+		Task.ActorName = TEXT("SchedulerTest");
+		return Task;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniSchedulerTest, "Houdini.Core.Scheduler", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniSchedulerTest::RunTest(const FString & Parameters)
+{
+	using namespace HoudiniSchedulerTest;
+
+	// The stubs replace the global HAPI functions, don't run next to a live session.
+	if (FHoudiniEngineUtils::IsInitialized())
+	{
+		AddInfo(TEXT("Skipped, a Houdini Engine session is running."));
+		return true;
+	}
+
+	const FHoudiniApi::IsInitializedFuncPtr OldIsInitialized = FHoudiniApi::IsInitialized;
+	const FHoudiniApi::IsSessionValidFuncPtr OldIsSessionValid = FHoudiniApi::IsSessionValid;
+	const FHoudiniApi::InterruptFuncPtr OldInterrupt = FHoudiniApi::Interrupt;
+	const FHoudiniApi::CookNodeFuncPtr OldCookNode = FHoudiniApi::CookNode;
+	const FHoudiniApi::GetStatusFuncPtr OldGetStatus = FHoudiniApi::GetStatus;
+	const FHoudiniApi::CookOptions_InitFuncPtr OldCookOptionsInit = FHoudiniApi::CookOptions_Init;
+	FHoudiniApi::IsInitialized = &StubSuccess;
+	FHoudiniApi::IsSessionValid = &StubSuccess;
+	FHoudiniApi::Interrupt = &StubSuccess;
+	FHoudiniApi::CookNode = &StubCookNode;
+	FHoudiniApi::GetStatus = &StubGetStatus;
+	FHoudiniApi::CookOptions_Init = &StubCookOptionsInit;
+	CookedNodes.Empty();
+	CookTimes.Empty();
+
+	// Ticked scheduler: priorities, coalescing and cancellation
+	{
+		FHoudiniEngineScheduler Scheduler;
+		FHoudiniEngineTask Low = MakeCookTask(1);
+		Low.Priority = EHoudiniEngineTaskPriority::Low;
+		FHoudiniEngineTask Normal = MakeCookTask(2);
+		Normal.Priority = EHoudiniEngineTaskPriority::Normal;
+		FHoudiniEngineTask High = MakeCookTask(3);
+		FHoudiniEngineTask HighAgain = MakeCookTask(3);
+		FHoudiniEngineTask Cancelled = MakeCookTask(4);
+		for (const FHoudiniEngineTask* Task : { &Low, &Normal, &High, &HighAgain, &Cancelled })
+			FHoudiniEngine::Get().AddTaskInfo(Task->HapiGUID, FHoudiniEngineTaskInfo());
+
+		Scheduler.AddTask(Low);
+		Scheduler.AddTask(Normal);
+		Scheduler.AddTask(High);
+		Scheduler.AddTask(HighAgain);
+		Scheduler.AddTask(Cancelled);
+		Scheduler.CancelTask(Cancelled.HapiGUID);
+		Scheduler.Tick();
+
+		TestTrue(TEXT("Cooks run by priority, coalesced and cancelled ones skipped"), CookedNodes == TArray<HAPI_NodeId>({ 3, 2, 1 }));
+		TestEqual(TEXT("Coalesced cook count"), Scheduler.GetCoalescedTaskCount(), 1);
+		TestFalse(TEXT("No pending tasks"), Scheduler.HasPendingTasks());
+
+		FHoudiniEngineTaskInfo TaskInfo;
+		FHoudiniEngine::Get().RetrieveTaskInfo(HighAgain.HapiGUID, TaskInfo);
+		TestTrue(TEXT("Coalesced request gets the cook result"), TaskInfo.TaskState == EHoudiniEngineTaskState::Success);
+		FHoudiniEngine::Get().RetrieveTaskInfo(Cancelled.HapiGUID, TaskInfo);
+		TestTrue(TEXT("Cancelled request is aborted"), TaskInfo.TaskState == EHoudiniEngineTaskState::Aborted);
+
+		for (const FHoudiniEngineTask* Task : { &Low, &Normal, &High, &HighAgain, &Cancelled })
+			FHoudiniEngine::Get().RemoveTaskInfo(Task->HapiGUID);
+	}
+
+	// Threaded scheduler: latency between queuing a cook and HAPI receiving it
+	if (FPlatformProcess::SupportsMultithreading())
+	{
+		CookedNodes.Empty();
+		CookTimes.Empty();
+
+		FHoudiniEngineScheduler Scheduler;
+		FRunnableThread* Thread = FRunnableThread::Create(&Scheduler, TEXT("HoudiniSchedulerTest"), 0, TPri_Normal);
+
+		const int32 Iterations = 50;
+		TArray<double> Latencies;
+		TArray<FGuid> TaskGUIDs;
+		for (int32 Idx = 0; Idx < Iterations; Idx++)
+		{
+			// Let the scheduler go idle so every cook measures a wake up.
+			FPlatformProcess::SleepNoStats(0.005f);
+
+			FHoudiniEngineTask Task = MakeCookTask(100 + Idx);
+			FHoudiniEngine::Get().AddTaskInfo(Task.HapiGUID, FHoudiniEngineTaskInfo());
+			const double QueuedTime = FPlatformTime::Seconds();
+			Scheduler.AddTask(Task);
+
+			while (GetCookCount() <= Idx && FPlatformTime::Seconds() - QueuedTime < 1.0)
+				FPlatformProcess::SleepNoStats(0.0f);
+
+			if (GetCookCount() > Idx)
+			{
+				FScopeLock ScopeLock(&CookLock);
+				Latencies.Add(CookTimes[Idx] - QueuedTime);
+			}
+
+			TaskGUIDs.Add(Task.HapiGUID);
+		}
+
+		Thread->Kill(true);
+		delete Thread;
+
+		for (const FGuid& TaskGUID : TaskGUIDs)
+			FHoudiniEngine::Get().RemoveTaskInfo(TaskGUID);
+
+		TestEqual(TEXT("All cooks ran"), Latencies.Num(), Iterations);
+		if (Latencies.Num() > 0)
+		{
+			Latencies.Sort();
+			const double Median = Latencies[Latencies.Num() / 2];
+			AddInfo(FString::Printf(TEXT("Cook dispatch latency: median %.3f ms, max %.3f ms"), Median * 1000.0, Latencies.Last() * 1000.0));
+
+			// The sleep-polling scheduler waited up to 100ms for a new task.
+			TestTrue(TEXT("Median dispatch latency below 25ms"), Median < 0.025);
+		}
+	}
+
+	FHoudiniApi::IsInitialized = OldIsInitialized;
+	FHoudiniApi::IsSessionValid = OldIsSessionValid;
+	FHoudiniApi::Interrupt = OldInterrupt;
+	FHoudiniApi::CookNode = OldCookNode;
+	FHoudiniApi::GetStatus = OldGetStatus;
+	FHoudiniApi::CookOptions_Init = OldCookOptionsInit;
+	return true;
+}
+
+#endif
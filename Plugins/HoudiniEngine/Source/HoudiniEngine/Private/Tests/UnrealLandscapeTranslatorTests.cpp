@@ -0,0 +1,67 @@
+#include "../UnrealLandscapeTranslator.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(UnrealLandscapeTranslatorRegionTest, "Houdini.Core.LandscapeTranslator.RegionOfInterest", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool UnrealLandscapeTranslatorRegionTest::RunTest(const FString & Parameters)
+{
+	// 2x2 components of 7x7 quads, sharing their edge vertices, in a region starting at (7, 14)
+	const FIntRect Region(7, 14, 21, 28);
+	const TArray<FIntRect> Components = {
+		FIntRect(7, 14, 14, 21), FIntRect(14, 14, 21, 21),
+		FIntRect(7, 21, 14, 28), FIntRect(14, 21, 21, 28) };
+
+	const int32 XSize = Region.Max.X - Region.Min.X + 1;
+	const int32 YSize = Region.Max.Y - Region.Min.Y + 1;
+	TArray<uint16> HeightData;
+	TArray<TArray<uint8>> LayersData;
+	LayersData.SetNum(1);
+	for (int32 Idx = 0; Idx < XSize * YSize; Idx++)
+	{
+		HeightData.Add((uint16)(Idx * 37));
+		LayersData[0].Add((uint8)Idx);
+	}
+
+	TArray<uint64> Hashes;
+	FUnrealLandscapeTranslator::HashLandscapeRegionComponents(Region, Components, HeightData, LayersData, Hashes);
+	TestEqual(TEXT("Hash count"), Hashes.Num(), Components.Num());
+
+	TMap<FIntPoint, uint64> PreviousHashes;
+	for (int32 Idx = 0; Idx < Components.Num(); Idx++)
+		PreviousHashes.Add(Components[Idx].Min, Hashes[Idx]);
+
+	// Nothing changed: nothing to send
+	TArray<FIntPoint> RowRuns;
+	TestEqual(TEXT("Unchanged components"), FUnrealLandscapeTranslator::GetChangedLandscapeRegionRows(Region, Components, Hashes, PreviousHashes, RowRuns), 0);
+	TestEqual(TEXT("Unchanged row runs"), RowRuns.Num(), 0);
+
+	// Painting inside the last component only sends its columns
+	LayersData[0][(25 - Region.Min.Y) * XSize + (17 - Region.Min.X)] += 1;
+	TArray<uint64> PaintedHashes;
+	FUnrealLandscapeTranslator::HashLandscapeRegionComponents(Region, Components, HeightData, LayersData, PaintedHashes);
+	TestEqual(TEXT("Painted components"), FUnrealLandscapeTranslator::GetChangedLandscapeRegionRows(Region, Components, PaintedHashes, PreviousHashes, RowRuns), 1);
+	TestEqual(TEXT("Painted row runs"), RowRuns.Num(), 1);
+	if (RowRuns.Num() == 1)
+		TestTrue(TEXT("Painted rows"), RowRuns[0] == FIntPoint(7, 8));
+
+	// Sculpting a shared edge changes both components on each side of it, their rows are merged
+	HeightData[(18 - Region.Min.Y) * XSize + (14 - Region.Min.X)] += 1;
+	TArray<uint64> SculptedHashes;
+	FUnrealLandscapeTranslator::HashLandscapeRegionComponents(Region, Components, HeightData, LayersData, SculptedHashes);
+	TestEqual(TEXT("Sculpted components"), FUnrealLandscapeTranslator::GetChangedLandscapeRegionRows(Region, Components, SculptedHashes, PreviousHashes, RowRuns), 3);
+	TestEqual(TEXT("Sculpted row runs"), RowRuns.Num(), 1);
+	if (RowRuns.Num() == 1)
+		TestTrue(TEXT("Sculpted rows"), RowRuns[0] == FIntPoint(0, XSize));
+
+	// Components that were not exported before are always sent
+	PreviousHashes.Remove(Components[0].Min);
+	TestEqual(TEXT("New components"), FUnrealLandscapeTranslator::GetChangedLandscapeRegionRows(Region, Components, Hashes, PreviousHashes, RowRuns), 1);
+	if (RowRuns.Num() == 1)
+		TestTrue(TEXT("New component rows"), RowRuns[0] == FIntPoint(0, 8));
+
+	return true;
+}
+
+#endif
@@ -47,6 +47,9 @@
 #include "UnrealObjectInputRuntimeTypes.h"
 #include "HoudiniEngineRuntimeUtils.h"
 
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+
 
 bool 
 FUnrealLandscapeTranslator::CreateMeshOrPointsFromLandscape(
@@ -724,6 +727,476 @@ FUnrealLandscapeTranslator::CreateHeightfieldFromLandscapeComponent(
 }
 
 
+// Last region of interest export of a landscape, keyed by its heightfield node id.
+// Used to only send the landscape components that changed since that export.
+struct FHoudiniLandscapeRegionExport
+{
+	TWeakObjectPtr<ALandscapeProxy> LandscapeProxy;
+
+	// Exported region, in landscape coordinates (Max is inclusive)
+	FIntRect Extent;
+
+	// Landscape actor to world transform: it is baked in the height values and in the node's transform
+	FTransform LandscapeTransform;
+
+	HAPI_NodeId HeightId = -1;
+
+	TArray<FString> LayerNames;
+	TArray<HAPI_NodeId> LayerNodeIds;
+
+	// Hash of the height and paint layer values of each exported component, keyed by the component's extent min
+	TMap<FIntPoint, uint64> ComponentHashes;
+};
+
+static TMap<HAPI_NodeId, FHoudiniLandscapeRegionExport> HoudiniLandscapeRegionExports;
+
+void
+FUnrealLandscapeTranslator::RemoveLandscapeRegionExport(const HAPI_NodeId& InHeightfieldNodeId)
+{
+	HoudiniLandscapeRegionExports.Remove(InHeightfieldNodeId);
+}
+
+void
+FUnrealLandscapeTranslator::ClearLandscapeRegionExports()
+{
+	HoudiniLandscapeRegionExports.Empty();
+}
+
+// Same as FHoudiniEngineRuntimeUtils::CalculateHoudiniLandscapeTransform, but centered on a region of the landscape
+static FTransform
+CalculateHoudiniLandscapeRegionTransform(ALandscapeProxy* LandscapeProxy, const FIntRect& RegionExtent)
+{
+	FTransform RegionTransform = LandscapeProxy->LandscapeActorToWorld();
+
+	// HF are centered, Landscape aren't
+	const FVector LandscapeScale = RegionTransform.GetScale3D();
+	const FVector RegionCenter(
+		(double)(RegionExtent.Min.X + RegionExtent.Max.X) / 2.0 * LandscapeScale.X,
+		(double)(RegionExtent.Min.Y + RegionExtent.Max.Y) / 2.0 * LandscapeScale.Y,
+		0.0);
+
+	RegionTransform.SetLocation(RegionTransform.GetLocation() + RegionTransform.GetRotation().RotateVector(RegionCenter));
+	return RegionTransform;
+}
+
+bool
+FUnrealLandscapeTranslator::GetLandscapeRegionExtent(
+	ALandscapeProxy* LandscapeProxy,
+	const FBox& RegionBounds,
+	FIntRect& OutRegionExtent,
+	TArray<FIntRect>& OutComponentExtents)
+{
+	OutComponentExtents.Empty();
+	if (!IsValid(LandscapeProxy) || !RegionBounds.IsValid)
+		return false;
+
+	ULandscapeInfo* LandscapeInfo = LandscapeProxy->GetLandscapeInfo();
+	if (!IsValid(LandscapeInfo))
+		return false;
+
+	// The region bounds in landscape coordinates
+	const FBox LocalBounds = RegionBounds.InverseTransformBy(LandscapeProxy->LandscapeActorToWorld());
+
+	OutRegionExtent = FIntRect(MAX_int32, MAX_int32, -MAX_int32, -MAX_int32);
+	auto AddComponentInRegion = [&](const ULandscapeComponent* LandscapeComponent)
+	{
+		if (!IsValid(LandscapeComponent))
+			return;
+
+		int32 MinX = MAX_int32;
+		int32 MinY = MAX_int32;
+		int32 MaxX = -MAX_int32;
+		int32 MaxY = -MAX_int32;
+		LandscapeComponent->GetComponentExtent(MinX, MinY, MaxX, MaxY);
+		if (MaxX < LocalBounds.Min.X || MinX > LocalBounds.Max.X || MaxY < LocalBounds.Min.Y || MinY > LocalBounds.Max.Y)
+			return;
+
+		OutComponentExtents.Add(FIntRect(MinX, MinY, MaxX, MaxY));
+		OutRegionExtent.Min = OutRegionExtent.Min.ComponentMin(FIntPoint(MinX, MinY));
+		OutRegionExtent.Max = OutRegionExtent.Max.ComponentMax(FIntPoint(MaxX, MaxY));
+	};
+
+	ALandscape* Landscape = LandscapeProxy->GetLandscapeActor();
+	if (LandscapeProxy == Landscape)
+	{
+		// The proxy is a landscape actor, so we have to look at all the landscape components
+		LandscapeInfo->ForAllLandscapeComponents([&](ULandscapeComponent* LandscapeComponent)
+		{
+			AddComponentInRegion(LandscapeComponent);
+		});
+	}
+	else
+	{
+		// Only look at the components of this landscape proxy
+		for (const ULandscapeComponent* LandscapeComponent : LandscapeProxy->LandscapeComponents)
+			AddComponentInRegion(LandscapeComponent);
+	}
+
+	return OutComponentExtents.Num() > 0;
+}
+
+void
+FUnrealLandscapeTranslator::HashLandscapeRegionComponents(
+	const FIntRect& RegionExtent,
+	const TArray<FIntRect>& ComponentExtents,
+	const TArray<uint16>& HeightData,
+	const TArray<TArray<uint8>>& LayersData,
+	TArray<uint64>& OutComponentHashes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FUnrealLandscapeTranslator::HashLandscapeRegionComponents);
+
+	// Unreal values are stored row by row along X
+	const int32 XSize = RegionExtent.Max.X - RegionExtent.Min.X + 1;
+
+	OutComponentHashes.SetNumZeroed(ComponentExtents.Num());
+	ParallelFor(ComponentExtents.Num(), [&](int32 ComponentIdx)
+	{
+		const FIntRect& ComponentExtent = ComponentExtents[ComponentIdx];
+		const int32 RowLength = ComponentExtent.Max.X - ComponentExtent.Min.X + 1;
+
+		uint64 Hash = 0;
+		for (int32 Y = ComponentExtent.Min.Y; Y <= ComponentExtent.Max.Y; Y++)
+		{
+			const int32 RowStart = (Y - RegionExtent.Min.Y) * XSize + (ComponentExtent.Min.X - RegionExtent.Min.X);
+			if (!HeightData.IsValidIndex(RowStart + RowLength - 1))
+				break;
+
+			Hash = CityHash64WithSeed((const char*)(HeightData.GetData() + RowStart), RowLength * sizeof(uint16), Hash);
+			for (const TArray<uint8>& LayerData : LayersData)
+			{
+				if (LayerData.IsValidIndex(RowStart + RowLength - 1))
+					Hash = CityHash64WithSeed((const char*)(LayerData.GetData() + RowStart), RowLength, Hash);
+			}
+		}
+
+		OutComponentHashes[ComponentIdx] = Hash;
+	});
+}
+
+int32
+FUnrealLandscapeTranslator::GetChangedLandscapeRegionRows(
+	const FIntRect& RegionExtent,
+	const TArray<FIntRect>& ComponentExtents,
+	const TArray<uint64>& ComponentHashes,
+	const TMap<FIntPoint, uint64>& PreviousComponentHashes,
+	TArray<FIntPoint>& OutRowRuns)
+{
+	OutRowRuns.Empty();
+
+	// Houdini heightfield rows are the landscape's X columns
+	const int32 NumRows = RegionExtent.Max.X - RegionExtent.Min.X + 1;
+	TBitArray<> ChangedRows(false, FMath::Max(NumRows, 0));
+
+	int32 NumChangedComponents = 0;
+	for (int32 ComponentIdx = 0; ComponentIdx < ComponentExtents.Num(); ComponentIdx++)
+	{
+		const FIntRect& ComponentExtent = ComponentExtents[ComponentIdx];
+		const uint64* PreviousHash = PreviousComponentHashes.Find(ComponentExtent.Min);
+		if (PreviousHash && ComponentHashes.IsValidIndex(ComponentIdx) && *PreviousHash == ComponentHashes[ComponentIdx])
+			continue;
+
+		NumChangedComponents++;
+		for (int32 X = FMath::Max(ComponentExtent.Min.X, RegionExtent.Min.X); X <= FMath::Min(ComponentExtent.Max.X, RegionExtent.Max.X); X++)
+			ChangedRows[X - RegionExtent.Min.X] = true;
+	}
+
+	// Merge the changed rows into runs of (first row, row count)
+	for (int32 Row = 0; Row < NumRows; Row++)
+	{
+		if (!ChangedRows[Row])
+			continue;
+
+		if (OutRowRuns.Num() > 0 && OutRowRuns.Last().X + OutRowRuns.Last().Y == Row)
+			OutRowRuns.Last().Y++;
+		else
+			OutRowRuns.Add(FIntPoint(Row, 1));
+	}
+
+	return NumChangedComponents;
+}
+
+bool
+FUnrealLandscapeTranslator::CreateHeightfieldFromLandscapeRegion(
+	ALandscapeProxy* LandscapeProxy,
+	const FBox& RegionBounds,
+	HAPI_NodeId& InOutHeightfieldNodeId,
+	const FString& InputNodeNameStr,
+	const HAPI_NodeId& ParentNodeId)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FUnrealLandscapeTranslator::CreateHeightfieldFromLandscapeRegion);
+
+	if (!IsValid(LandscapeProxy))
+		return false;
+
+	ULandscapeInfo* LandscapeInfo = LandscapeProxy->GetLandscapeInfo();
+	if (!IsValid(LandscapeInfo))
+		return false;
+
+	const HAPI_NodeId PreviousHeightfieldNodeId = InOutHeightfieldNodeId;
+	FHoudiniLandscapeRegionExport PreviousExport;
+	HoudiniLandscapeRegionExports.RemoveAndCopyValue(PreviousHeightfieldNodeId, PreviousExport);
+
+	FIntRect Extent;
+	TArray<FIntRect> ComponentExtents;
+	if (!GetLandscapeRegionExtent(LandscapeProxy, RegionBounds, Extent, ComponentExtents))
+	{
+		HOUDINI_LOG_MESSAGE(TEXT("Landscape input: no component of %s in the region of interest, exporting the whole landscape."), *LandscapeProxy->GetName());
+
+		HAPI_NodeId HeightfieldNodeId = -1;
+		if (!CreateHeightfieldFromLandscape(LandscapeProxy, HeightfieldNodeId, InputNodeNameStr, ParentNodeId))
+			return false;
+
+		InOutHeightfieldNodeId = HeightfieldNodeId;
+		return true;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+	// 1. Extract the height and paint layers data of the region
+	//--------------------------------------------------------------------------------------------------
+	TArray<uint16> HeightData;
+	int32 XSize, YSize;
+	if (!GetLandscapeData(LandscapeInfo, Extent.Min.X, Extent.Min.Y, Extent.Max.X, Extent.Max.Y, HeightData, XSize, YSize))
+		return false;
+
+	TArray<FString> LayerNames;
+	TArray<FLinearColor> LayerUsageDebugColors;
+	TArray<TArray<uint8>> LayersData;
+	for (int32 LayerIndex = 0; LayerIndex < LandscapeInfo->Layers.Num(); LayerIndex++)
+	{
+		TArray<uint8> LayerData;
+		FLinearColor LayerUsageDebugColor;
+		FString LayerName;
+		if (!GetLandscapeLayerData(LandscapeInfo, LayerIndex, Extent.Min.X, Extent.Min.Y, Extent.Max.X, Extent.Max.Y, LayerData, LayerUsageDebugColor, LayerName))
+			continue;
+
+		// Name the visibility layer according to the plugin's expectations
+		if (FName(LayerName).Compare(ALandscape::VisibilityLayer->LayerName) == 0)
+			LayerName = HAPI_UNREAL_VISIBILITY_LAYER_NAME;
+
+		LayerNames.Add(LayerName);
+		LayerUsageDebugColors.Add(LayerUsageDebugColor);
+		LayersData.Add(MoveTemp(LayerData));
+	}
+
+	TArray<uint64> ComponentHashes;
+	HashLandscapeRegionComponents(Extent, ComponentExtents, HeightData, LayersData, ComponentHashes);
+
+	FHoudiniLandscapeRegionExport Export;
+	Export.LandscapeProxy = LandscapeProxy;
+	Export.Extent = Extent;
+	Export.LandscapeTransform = LandscapeProxy->LandscapeActorToWorld();
+	Export.LayerNames = LayerNames;
+	for (int32 ComponentIdx = 0; ComponentIdx < ComponentExtents.Num(); ComponentIdx++)
+		Export.ComponentHashes.Add(ComponentExtents[ComponentIdx].Min, ComponentHashes[ComponentIdx]);
+
+	//--------------------------------------------------------------------------------------------------
+	// 2. Convert the height uint16 data to float
+	//--------------------------------------------------------------------------------------------------
+	TArray<float> HeightfieldFloatValues;
+	HAPI_VolumeInfo HeightfieldVolumeInfo;
+	FHoudiniApi::VolumeInfo_Init(&HeightfieldVolumeInfo);
+
+	FTransform RegionTransform = CalculateHoudiniLandscapeRegionTransform(LandscapeProxy, Extent);
+
+	FVector CenterOffset = FVector::ZeroVector;
+	if (!ConvertLandscapeDataToHeightfieldData(
+		HeightData, XSize, YSize, FVector::ZeroVector, FVector::ZeroVector, RegionTransform,
+		HeightfieldFloatValues, HeightfieldVolumeInfo, CenterOffset))
+		return false;
+
+	//--------------------------------------------------------------------------------------------------
+	// 3. If the same region was exported before, only send the rows of the components that changed
+	//--------------------------------------------------------------------------------------------------
+	const bool bCanPatchPreviousExport =
+		PreviousExport.LandscapeProxy.Get() == LandscapeProxy
+		&& PreviousExport.Extent == Extent
+		&& PreviousExport.LandscapeTransform.Equals(Export.LandscapeTransform)
+		&& PreviousExport.LayerNames == LayerNames
+		&& FHoudiniEngineUtils::IsHoudiniNodeValid(PreviousHeightfieldNodeId);
+
+	if (bCanPatchPreviousExport)
+	{
+		TArray<FIntPoint> RowRuns;
+		const int32 NumChangedComponents = GetChangedLandscapeRegionRows(
+			Extent, ComponentExtents, ComponentHashes, PreviousExport.ComponentHashes, RowRuns);
+
+		HOUDINI_LOG_MESSAGE(TEXT("Landscape input: %d of %d components of %s changed in the region of interest."),
+			NumChangedComponents, ComponentExtents.Num(), *LandscapeProxy->GetName());
+
+		if (NumChangedComponents > 0)
+		{
+			const int32 RowSize = HeightfieldVolumeInfo.xLength;
+			const TArray<FIntPoint> AllRows = { FIntPoint(0, HeightfieldVolumeInfo.yLength) };
+			auto SetVolumeRows = [&](const HAPI_NodeId& VolumeNodeId, const TArray<float>& FloatValues, const FString& VolumeName, const TArray<FIntPoint>& Rows)
+			{
+				for (const FIntPoint& Run : Rows)
+				{
+					HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetHeightFieldData(
+						VolumeNodeId, 0, FloatValues, VolumeName, Run.X * RowSize, Run.Y * RowSize), false);
+				}
+
+				HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::CommitGeo(
+					FHoudiniEngine::Get().GetSession(), VolumeNodeId), false);
+
+				return true;
+			};
+
+			if (!SetVolumeRows(PreviousExport.HeightId, HeightfieldFloatValues, TEXT("height"), RowRuns))
+				return false;
+
+			for (int32 LayerIdx = 0; LayerIdx < LayersData.Num(); LayerIdx++)
+			{
+				if (PreviousExport.LayerNodeIds[LayerIdx] < 0)
+					continue;
+
+				TArray<float> LayerFloatValues;
+				HAPI_VolumeInfo LayerVolumeInfo;
+				FHoudiniApi::VolumeInfo_Init(&LayerVolumeInfo);
+				if (!ConvertLandscapeLayerDataToHeightfieldData(
+					LayersData[LayerIdx], XSize, YSize, LayerUsageDebugColors[LayerIdx],
+					LayerFloatValues, LayerVolumeInfo))
+					continue;
+
+				// Layers that came from Houdini are remapped with the range of the whole region, send them entirely
+				const bool bRemappedLayer = LayerUsageDebugColors[LayerIdx].A == PI;
+				if (!SetVolumeRows(PreviousExport.LayerNodeIds[LayerIdx], LayerFloatValues, LayerNames[LayerIdx], bRemappedLayer ? AllRows : RowRuns))
+					return false;
+			}
+
+			if (!FHoudiniEngineUtils::HapiCookNode(PreviousHeightfieldNodeId, nullptr, true))
+				return false;
+		}
+
+		Export.HeightId = PreviousExport.HeightId;
+		Export.LayerNodeIds = PreviousExport.LayerNodeIds;
+		HoudiniLandscapeRegionExports.Add(PreviousHeightfieldNodeId, MoveTemp(Export));
+		return true;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+	// 4. Create the Heightfield Input Node and set its height data
+	//--------------------------------------------------------------------------------------------------
+	HAPI_NodeId HeightFieldId = -1;
+	HAPI_NodeId HeightId = -1;
+	HAPI_NodeId MaskId = -1;
+	HAPI_NodeId MergeId = -1;
+	if (!CreateHeightfieldInputNode(InputNodeNameStr, XSize, YSize, HeightFieldId, HeightId, MaskId, MergeId, ParentNodeId))
+		return false;
+
+	HAPI_PartId PartId = 0;
+	if (!SetHeightfieldData(HeightId, PartId, HeightfieldFloatValues, HeightfieldVolumeInfo, TEXT("height")))
+		return false;
+
+	// Apply attributes to the heightfield
+	ApplyAttributesToHeightfieldNode(HeightId, PartId, LandscapeProxy);
+
+	// Commit the height volume
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::CommitGeo(
+		FHoudiniEngine::Get().GetSession(), HeightId), false);
+
+	Export.HeightId = HeightId;
+
+	//--------------------------------------------------------------------------------------------------
+	// 5. Convert all the layers to HF masks
+	//--------------------------------------------------------------------------------------------------
+	int32 MergeInputIndex = 2;
+	bool bMaskInitialized = false;
+	for (int32 LayerIdx = 0; LayerIdx < LayersData.Num(); LayerIdx++)
+	{
+		const FString& LayerName = LayerNames[LayerIdx];
+
+		TArray<float> LayerFloatValues;
+		HAPI_VolumeInfo LayerVolumeInfo;
+		FHoudiniApi::VolumeInfo_Init(&LayerVolumeInfo);
+		HAPI_NodeId LayerVolumeNodeId = -1;
+		if (ConvertLandscapeLayerDataToHeightfieldData(
+			LayersData[LayerIdx], XSize, YSize, LayerUsageDebugColors[LayerIdx],
+			LayerFloatValues, LayerVolumeInfo))
+		{
+			// We reuse the height layer's transform
+			LayerVolumeInfo.transform = HeightfieldVolumeInfo.transform;
+
+			// The mask layer reuses the mask volume created by default by the heightfield node
+			const bool bIsMask = LayerName.Equals(TEXT("mask"), ESearchCase::IgnoreCase);
+			if (bIsMask)
+			{
+				LayerVolumeNodeId = MaskId;
+			}
+			else
+			{
+				std::string LayerNameStr;
+				FHoudiniEngineUtils::ConvertUnrealString(LayerName, LayerNameStr);
+
+				FHoudiniApi::CreateHeightfieldInputVolumeNode(
+					FHoudiniEngine::Get().GetSession(),
+					HeightFieldId, &LayerVolumeNodeId, LayerNameStr.c_str(), XSize, YSize, 1.0f);
+			}
+
+			if (FHoudiniEngineUtils::IsHoudiniNodeValid(LayerVolumeNodeId)
+				&& SetHeightfieldData(LayerVolumeNodeId, PartId, LayerFloatValues, LayerVolumeInfo, LayerName))
+			{
+				// Apply attributes to the heightfield input node
+				ApplyAttributesToHeightfieldNode(LayerVolumeNodeId, PartId, LandscapeProxy);
+
+				// Commit the volume's geo
+				HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::CommitGeo(
+					FHoudiniEngine::Get().GetSession(), LayerVolumeNodeId), false);
+
+				if (bIsMask)
+				{
+					bMaskInitialized = true;
+				}
+				else
+				{
+					// Connect the new volume to the HF's merge node
+					HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::ConnectNodeInput(
+						FHoudiniEngine::Get().GetSession(),
+						MergeId, MergeInputIndex++, LayerVolumeNodeId, 0), false);
+				}
+			}
+			else
+			{
+				LayerVolumeNodeId = -1;
+			}
+		}
+
+		// Layers that could not be sent are skipped when patching
+		Export.LayerNodeIds.Add(LayerVolumeNodeId);
+	}
+
+	// We need to have a mask layer as it is required for proper heightfield functionalities
+	if (!bMaskInitialized)
+	{
+		InitDefaultHeightfieldMask(HeightfieldVolumeInfo, MaskId);
+
+		ApplyAttributesToHeightfieldNode(MaskId, PartId, LandscapeProxy);
+
+		// Commit the mask volume's geo
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::CommitGeo(
+			FHoudiniEngine::Get().GetSession(), MaskId), false);
+	}
+
+	// Set the HF's parent OBJ's tranform to the region's transform
+	HAPI_TransformEuler HAPIObjectTransform;
+	FHoudiniApi::TransformEuler_Init(&HAPIObjectTransform);
+	RegionTransform.SetScale3D(FVector::OneVector);
+	FHoudiniEngineUtils::TranslateUnrealTransform(RegionTransform, HAPIObjectTransform);
+
+	HAPI_NodeId ParentObjNodeId = FHoudiniEngineUtils::HapiGetParentNodeId(HeightFieldId);
+	FHoudiniApi::SetObjectTransform(FHoudiniEngine::Get().GetSession(), ParentObjNodeId, &HAPIObjectTransform);
+
+	// Finally, cook the Heightfield node
+	if (!FHoudiniEngineUtils::HapiCookNode(HeightFieldId, nullptr, true))
+		return false;
+
+	HOUDINI_LOG_MESSAGE(TEXT("Landscape input: exported %d components of %s in the region of interest."),
+		ComponentExtents.Num(), *LandscapeProxy->GetName());
+
+	InOutHeightfieldNodeId = HeightFieldId;
+	HoudiniLandscapeRegionExports.Add(HeightFieldId, MoveTemp(Export));
+	return true;
+}
+
 bool 
 FUnrealLandscapeTranslator::CreateInputNodeForLandscape(
 	ALandscapeProxy* LandscapeProxy,
@@ -797,6 +1270,7 @@ FUnrealLandscapeTranslator::CreateInputNodeForLandscapeObject(
 
 	FUnrealObjectInputHandle ParentHandle;
 	HAPI_NodeId ParentNodeId = -1;
+	bool bCreatedGeoNode = false;
 
 	if (bUseRefCountedInputSystem)
 	{
@@ -871,6 +1345,7 @@ FUnrealLandscapeTranslator::CreateInputNodeForLandscapeObject(
 				*/
 
 				ParentNodeId = NodeId;
+				bCreatedGeoNode = true;
 			}
 			
 			switch (ExportType)
@@ -914,7 +1389,32 @@ FUnrealLandscapeTranslator::CreateInputNodeForLandscapeObject(
 		//DestroyInputNodes(InInput, InInput->GetInputType());
 
 		int32 NumComponents = InLandscape->LandscapeComponents.Num();
-		if (!bExportSelectionOnly || (SelectedComponents.Num() == NumComponents))
+		if (InInput->bLandscapeExportRegionOfInterest)
+		{
+			// Export the components under the region of interest as a single heightfield node,
+			// patching the previous export of this landscape when only some of its components changed
+			HAPI_NodeId HeightfieldNodeId = InputNodeId;
+			if (bUseRefCountedInputSystem)
+			{
+				HeightfieldNodeId = -1;
+				FUnrealObjectInputHandle PreviousHandle;
+				if (FHoudiniEngineUtils::FindNodeViaManager(Identifier, PreviousHandle))
+					FHoudiniEngineUtils::GetHAPINodeId(PreviousHandle, HeightfieldNodeId);
+			}
+
+			bSuccess = FUnrealLandscapeTranslator::CreateHeightfieldFromLandscapeRegion(
+				InLandscape, InInput->GetLandscapeRegionOfInterestBounds(), HeightfieldNodeId, FinalInputNodeName, ParentNodeId);
+
+			if (bSuccess)
+			{
+				// The geo node created for this export is not needed if the previous export was patched
+				if (bCreatedGeoNode && FHoudiniEngineUtils::HapiGetParentNodeId(HeightfieldNodeId) != ParentNodeId)
+					HOUDINI_CHECK_ERROR(FHoudiniApi::DeleteNode(FHoudiniEngine::Get().GetSession(), ParentNodeId));
+
+				InputNodeId = HeightfieldNodeId;
+			}
+		}
+		else if (!bExportSelectionOnly || (SelectedComponents.Num() == NumComponents))
 			// Export the whole landscape and its layer as a single heightfield node
 			bSuccess = FUnrealLandscapeTranslator::CreateHeightfieldFromLandscape(InLandscape, InputNodeId, FinalInputNodeName, ParentNodeId);
 		else
@@ -65,6 +65,47 @@ struct HOUDINIENGINE_API FUnrealLandscapeTranslator
 			const FTransform & ParentTransform,
 			const HAPI_NodeId& ParentNodeId);
 	
+		// Exports the landscape components under RegionBounds as a single heightfield.
+		// If InOutHeightfieldNodeId is a previous export of the same region, only the rows of
+		// the components that changed are sent to it.
+		static bool CreateHeightfieldFromLandscapeRegion(
+			ALandscapeProxy* LandscapeProxy,
+			const FBox& RegionBounds,
+			HAPI_NodeId& InOutHeightfieldNodeId,
+			const FString& InputNodeNameStr,
+			const HAPI_NodeId& ParentNodeId);
+
+		// Forgets the region of interest export of a heightfield node once that node is deleted
+		static void RemoveLandscapeRegionExport(const HAPI_NodeId& InHeightfieldNodeId);
+
+		// Forgets all the region of interest exports, their nodes are gone with the session
+		static void ClearLandscapeRegionExports();
+
+		// Finds the components of a landscape that intersect RegionBounds.
+		// Extents are in landscape coordinates, with an inclusive Max.
+		static bool GetLandscapeRegionExtent(
+			ALandscapeProxy* LandscapeProxy,
+			const FBox& RegionBounds,
+			FIntRect& OutRegionExtent,
+			TArray<FIntRect>& OutComponentExtents);
+
+		// Hashes the height and paint layer values of each component of a landscape region
+		static void HashLandscapeRegionComponents(
+			const FIntRect& RegionExtent,
+			const TArray<FIntRect>& ComponentExtents,
+			const TArray<uint16>& HeightData,
+			const TArray<TArray<uint8>>& LayersData,
+			TArray<uint64>& OutComponentHashes);
+
+		// Returns the number of components whose hash changed, and the heightfield rows they cover
+		// as runs of (first row, row count).
+		static int32 GetChangedLandscapeRegionRows(
+			const FIntRect& RegionExtent,
+			const TArray<FIntRect>& ComponentExtents,
+			const TArray<uint64>& ComponentHashes,
+			const TMap<FIntPoint, uint64>& PreviousComponentHashes,
+			TArray<FIntPoint>& OutRowRuns);
+	
 		static bool CreateInputNodeForLandscape(
 			ALandscapeProxy* LandscapeProxy,
 			const FString& InputNodeNameStr,
@@ -28,6 +28,7 @@
 
 #include "HoudiniEngine.h"
 #include "HoudiniEngineUtils.h"
+#include "HoudiniMeshMarshalling.h"
 #include "HoudiniEnginePrivatePCH.h"
 #include "UnrealObjectInputRuntimeTypes.h"
 #include "HoudiniDataLayerUtils.h"
@@ -2447,7 +2448,6 @@ FUnrealMeshTranslator::CreateInputNodeForStaticMeshLODResources(
 	}
 
 	// Vertex instance and triangle counts
-	const uint32 OrigNumVertexInstances = LODResources.VertexBuffers.StaticMeshVertexBuffer.GetNumVertices();
 	const uint32 NumTriangles = LODResources.GetNumTriangles();
 	const uint32 NumVertexInstances = NumTriangles * 3;
 	const uint32 NumSections = LODResources.Sections.Num();
@@ -2463,36 +2463,12 @@ FUnrealMeshTranslator::CreateInputNodeForStaticMeshLODResources(
 	// words, in Houdini terminology, the number of points and vertices are the same. We'll do the same thing that Epic
 	// does in FBX export: we'll run through all vertex instances and use a hash to determine which instances share a 
 	// position, so that we can a smaller number of points than vertices, and vertices share point positions
-	TArray<int32> UEVertexInstanceIdxToPointIdx;
-	UEVertexInstanceIdxToPointIdx.Reserve(OrigNumVertexInstances);
+	FHoudiniScopedMeshMarshallingBuffers ScopedBuffers;
+	FHoudiniMeshMarshallingBuffers& Buffers = ScopedBuffers.Get();
+	const bool bParallelMarshalling = FHoudiniMeshMarshalling::IsParallel();
 
-	TMap<FVector3f, int32> PositionToPointIndexMap;
-	PositionToPointIndexMap.Reserve(OrigNumVertexInstances);
-
-	TArray<float> StaticMeshVertices;
-	StaticMeshVertices.Reserve(OrigNumVertexInstances * 3);
-	for (uint32 VertexInstanceIndex = 0; VertexInstanceIndex < OrigNumVertexInstances; ++VertexInstanceIndex)
-	{
-		// Convert Unreal to Houdini
-		const FVector3f &PositionVector = LODResources.VertexBuffers.PositionVertexBuffer.VertexPosition(VertexInstanceIndex);
-		const int32 *FoundPointIndexPtr = PositionToPointIndexMap.Find(PositionVector);
-		if (!FoundPointIndexPtr)
-		{
-			const int32 NewPointIndex = StaticMeshVertices.Add(PositionVector.X / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScaleVector.X) / 3;
-			StaticMeshVertices.Add(PositionVector.Z / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScaleVector.Z);
-			StaticMeshVertices.Add(PositionVector.Y / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScaleVector.Y);
-
-			PositionToPointIndexMap.Add(PositionVector, NewPointIndex);
-			UEVertexInstanceIdxToPointIdx.Add(NewPointIndex);
-		}
-		else
-		{
-			UEVertexInstanceIdxToPointIdx.Add(*FoundPointIndexPtr);
-		}
-	}
-
-	StaticMeshVertices.Shrink();
-	const uint32 NumVertices = StaticMeshVertices.Num() / 3;
+	FHoudiniMeshMarshalling::FillLODResourcesPoints(LODResources, BuildScaleVector, Buffers);
+	const uint32 NumVertices = Buffers.PointSources.Num();
 
 	// Now that we know how many vertices (points), vertex instances (vertices) and triagnles we have,
 	// we can create the part.
@@ -2528,9 +2504,17 @@ FUnrealMeshTranslator::CreateInputNodeForStaticMeshLODResources(
 		FHoudiniEngine::Get().GetSession(), NodeId, 0,
 		HAPI_UNREAL_ATTRIB_POSITION, &AttributeInfoPoint), false);
 
+	// Each attribute buffer is built while the previous attribute is uploaded to Houdini
+	TArray<FHoudiniMeshAttributeUpload> Uploads;
+
 	// Now that we have raw positions, we can upload them for our attribute.
-	HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
-		StaticMeshVertices, NodeId, 0, HAPI_UNREAL_ATTRIB_POSITION, AttributeInfoPoint), false);
+	FHoudiniMeshAttributeUpload& PositionUpload = Uploads.AddDefaulted_GetRef();
+	PositionUpload.Upload = [&]()
+	{
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
+			Buffers.Positions, NodeId, 0, HAPI_UNREAL_ATTRIB_POSITION, AttributeInfoPoint), false);
+		return true;
+	};
 
 	// Determine which attributes we have
 	const bool bIsVertexInstanceNormalsValid = true;
@@ -2538,7 +2522,6 @@ FUnrealMeshTranslator::CreateInputNodeForStaticMeshLODResources(
 	const bool bIsVertexInstanceBinormalsValid = true;
 	const bool bIsVertexInstanceColorsValid = LODResources.bHasColorVertexData;
 	const uint32 NumUVLayers = FMath::Min<uint32>(LODResources.VertexBuffers.StaticMeshVertexBuffer.GetNumTexCoords(), MAX_STATIC_TEXCOORDS);
-	const bool bIsVertexInstanceUVsValid = NumUVLayers > 0;
 
 	bool bUseComponentOverrideColors = false;
 	// Determine if have override colors on the static mesh component, if so prefer to use those
@@ -2559,7 +2542,6 @@ FUnrealMeshTranslator::CreateInputNodeForStaticMeshLODResources(
 	// MATERIAL INDEX -> MATERIAL INTERFACE
 	//---------------------------------------------------------------------------------------------------------------------
 	TArray<UMaterialInterface*> MaterialInterfaces;
-	TArray<int32> TriangleMaterialIndices;
 
 	const TArray<FStaticMaterial>& StaticMaterials = StaticMesh->GetStaticMaterials();
 
@@ -2599,8 +2581,6 @@ FUnrealMeshTranslator::CreateInputNodeForStaticMeshLODResources(
 			// MaterialSlotToInterface.Add(MaterialInfo.ImportedMaterialSlotName, MaterialIndex);
 			MaterialInterfaces.Add(Material);
 		}
-
-		TriangleMaterialIndices.Reserve(NumTriangles);
 	}
 
 	// If we haven't created UEDefaultMaterial yet, check that all the sections' MaterialIndex
@@ -2628,197 +2608,62 @@ FUnrealMeshTranslator::CreateInputNodeForStaticMeshLODResources(
 	// Determine the final number of materials we have, with default for missing/invalid indices
 	const int32 NumMaterials = MaterialInterfaces.Num();
 
-	// Now we deal with vertex instance attributes. 
-	if (NumTriangles > 0)
+	// Material index of each section's triangles
+	TArray<int32> SectionMaterialIndices;
+	SectionMaterialIndices.SetNumUninitialized(NumSections);
+	for (uint32 SectionIndex = 0; SectionIndex < NumSections; ++SectionIndex)
 	{
-		// UV layer array. Each layer has an array of floats, 3 floats per vertex instance
-		TArray<TArray<float>> UVs;
-		// Normals: 3 floats per vertex instance
-		TArray<float> Normals;
-		// Tangents: 3 floats per vertex instance
-		TArray<float> Tangents;
-		// Binormals: 3 floats per vertex instance
-		TArray<float> Binormals;
-		// RGBColors: 3 floats per vertex instance
-		TArray<float> RGBColors;
-		// Alphas: 1 float per vertex instance
-		TArray<float> Alphas;
-
-		// Initialize the arrays for the attributes that are valid
-		if (bIsVertexInstanceUVsValid)
-		{
-			UVs.SetNum(NumUVLayers);
-			for (uint32 UVLayerIndex = 0; UVLayerIndex < NumUVLayers; ++UVLayerIndex)
-			{
-				UVs[UVLayerIndex].SetNumUninitialized(NumVertexInstances * 3);
-			}
-		}
-
-		if (bIsVertexInstanceNormalsValid)
+		const int32 MaterialIndex = LODResources.Sections[SectionIndex].MaterialIndex;
+		if (MaterialInterfaces.IsValidIndex(MaterialIndex))
 		{
-			Normals.SetNumUninitialized(NumVertexInstances * 3);
+			SectionMaterialIndices[SectionIndex] = MaterialIndex;
 		}
-
-		if (bIsVertexInstanceTangentsValid)
+		else
 		{
-			Tangents.SetNumUninitialized(NumVertexInstances * 3);
+			SectionMaterialIndices[SectionIndex] = UEDefaultMaterialIndex;
+			HOUDINI_LOG_WARNING(TEXT("Section Index %d references an invalid Material Index %d, falling back to default material: %s"), SectionIndex, MaterialIndex, UEDefaultMaterial ? *(UEDefaultMaterial->GetPathName()) : TEXT("None"));
 		}
+	}
 
-		if (bIsVertexInstanceBinormalsValid)
-		{
-			Binormals.SetNumUninitialized(NumVertexInstances * 3);
-		}
+	// Now we deal with vertex instance attributes. 
+	if (NumTriangles > 0)
+	{
+		// The UV layer array itself must not be resized once the uploads have started
+		if (Buffers.UVs.Num() < (int32)NumUVLayers)
+			Buffers.UVs.SetNum(NumUVLayers);
 
-		if (bUseComponentOverrideColors || bIsVertexInstanceColorsValid)
+		//--------------------------------------------------------------------------------------------------------------------- 
+		// TRIANGLE/FACE VERTEX INDICES
+		//---------------------------------------------------------------------------------------------------------------------
+		// Also finds the vertex buffer index of each Houdini vertex, used by all the vertex attributes below
+		FHoudiniMeshAttributeUpload& VertexListUpload = Uploads.AddDefaulted_GetRef();
+		VertexListUpload.Fill = [&]()
 		{
-			RGBColors.SetNumUninitialized(NumVertexInstances * 3);
-			Alphas.SetNumUninitialized(NumVertexInstances);
-		}
-
-		// Array of vertex (point position) indices per triangle
-		TArray<int32> MeshTriangleVertexIndices;
-		MeshTriangleVertexIndices.SetNumUninitialized(NumVertexInstances);
-		// Array of vertex counts per triangle/face
-		TArray<int32> MeshTriangleVertexCounts;
-		MeshTriangleVertexCounts.SetNumUninitialized(NumTriangles);
-
-		int32 TriangleIdx = 0;
-		int32 HoudiniVertexIdx = 0;
-		FIndexArrayView TriangleVertexIndices = LODResources.IndexBuffer.GetArrayView();
-		for (uint32 SectionIndex = 0; SectionIndex < NumSections; ++SectionIndex)
+			FHoudiniMeshMarshalling::FillLODResourcesTopology(LODResources, SectionMaterialIndices, bParallelMarshalling, Buffers);
+		};
+		VertexListUpload.Upload = [&]()
 		{
-			const FStaticMeshSection& Section = LODResources.Sections[SectionIndex];
-			for (uint32 SectionTriangleIndex = 0; SectionTriangleIndex < Section.NumTriangles; ++SectionTriangleIndex)
-			{
-				MeshTriangleVertexCounts[TriangleIdx] = 3;
-				for (int32 TriangleVertexIndex = 0; TriangleVertexIndex < 3; ++TriangleVertexIndex)
-				{
-					// Reverse the winding order for Houdini (but still start at 0)
-					const int32 WindingIdx = (3 - TriangleVertexIndex) % 3;
-					const uint32 UEVertexIndex = TriangleVertexIndices[Section.FirstIndex + SectionTriangleIndex * 3 + WindingIdx];
-
-					// Calculate the index of the first component of a vertex instance's value in an inline float array 
-					// representing vectors (3 float) per vertex instance
-					const int32 Float3Index = HoudiniVertexIdx * 3;
-
-					//--------------------------------------------------------------------------------------------------------------------- 
-					// UVS (uvX)
-					//--------------------------------------------------------------------------------------------------------------------- 
-					if (bIsVertexInstanceUVsValid)
-					{
-						for (uint32 UVLayerIndex = 0; UVLayerIndex < NumUVLayers; ++UVLayerIndex)
-						{
-							const FVector2f &UV = LODResources.VertexBuffers.StaticMeshVertexBuffer.GetVertexUV(UEVertexIndex, UVLayerIndex);
-							UVs[UVLayerIndex][Float3Index + 0] = UV.X;
-							UVs[UVLayerIndex][Float3Index + 1] = 1.0f - UV.Y;
-							UVs[UVLayerIndex][Float3Index + 2] = 0;
-						}
-					}
-
-					//--------------------------------------------------------------------------------------------------------------------- 
-					// NORMALS (N)
-					//---------------------------------------------------------------------------------------------------------------------
-					if (bIsVertexInstanceNormalsValid)
-					{
-						const FVector4f &Normal = LODResources.VertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(UEVertexIndex);
-						Normals[Float3Index + 0] = Normal.X;
-						Normals[Float3Index + 1] = Normal.Z;
-						Normals[Float3Index + 2] = Normal.Y;
-					}
-
-					//--------------------------------------------------------------------------------------------------------------------- 
-					// TANGENT (tangentu)
-					//---------------------------------------------------------------------------------------------------------------------
-					if (bIsVertexInstanceTangentsValid)
-					{
-						const FVector4f &Tangent = LODResources.VertexBuffers.StaticMeshVertexBuffer.VertexTangentX(UEVertexIndex);
-						Tangents[Float3Index + 0] = Tangent.X;
-						Tangents[Float3Index + 1] = Tangent.Z;
-						Tangents[Float3Index + 2] = Tangent.Y;
-					}
-
-					//--------------------------------------------------------------------------------------------------------------------- 
-					// BINORMAL (tangentv)
-					//---------------------------------------------------------------------------------------------------------------------
-					// In order to calculate the binormal we also need the tangent and normal
-					if (bIsVertexInstanceBinormalsValid)
-					{
-						FVector3f Binormal = LODResources.VertexBuffers.StaticMeshVertexBuffer.VertexTangentY(UEVertexIndex);
-						Binormals[Float3Index + 0] = Binormal.X;
-						Binormals[Float3Index + 1] = Binormal.Z;
-						Binormals[Float3Index + 2] = Binormal.Y;
-					}
-
-					//--------------------------------------------------------------------------------------------------------------------- 
-					// COLORS (Cd)
-					//---------------------------------------------------------------------------------------------------------------------
-					if (bUseComponentOverrideColors || bIsVertexInstanceColorsValid)
-					{
-						FLinearColor Color = FLinearColor::White;
-						if (bUseComponentOverrideColors)
-						{
-							FStaticMeshComponentLODInfo& ComponentLODInfo = StaticMeshComponent->LODData[InLODIndex];
-							FColorVertexBuffer& ColorVertexBuffer = *ComponentLODInfo.OverrideVertexColors;
-							Color = ColorVertexBuffer.VertexColor(UEVertexIndex).ReinterpretAsLinear();
-						}
-						else
-						{
-							Color = LODResources.VertexBuffers.ColorVertexBuffer.VertexColor(UEVertexIndex).ReinterpretAsLinear();
-						}
-						RGBColors[Float3Index + 0] = Color.R;
-						RGBColors[Float3Index + 1] = Color.G;
-						RGBColors[Float3Index + 2] = Color.B;
-						Alphas[HoudiniVertexIdx] = Color.A;
-					}
-
-					//--------------------------------------------------------------------------------------------------------------------- 
-					// TRIANGLE/FACE VERTEX INDICES
-					//---------------------------------------------------------------------------------------------------------------------
-					if (UEVertexInstanceIdxToPointIdx.IsValidIndex(UEVertexIndex))
-					{
-						MeshTriangleVertexIndices[HoudiniVertexIdx] = UEVertexInstanceIdxToPointIdx[UEVertexIndex];
-					}
-
-					HoudiniVertexIdx++;
-				}
-
-				//--------------------------------------------------------------------------------------------------------------------- 
-				// TRIANGLE MATERIAL ASSIGNMENT
-				//---------------------------------------------------------------------------------------------------------------------
-				if (MaterialInterfaces.IsValidIndex(Section.MaterialIndex))
-				{
-					TriangleMaterialIndices.Add(Section.MaterialIndex);
-				}
-				else
-				{
-					TriangleMaterialIndices.Add(UEDefaultMaterialIndex);
-					HOUDINI_LOG_WARNING(TEXT("Section Index %d references an invalid Material Index %d, falling back to default material: %s"), SectionIndex, Section.MaterialIndex, *(UEDefaultMaterial->GetPathName()));
-				}
+			HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetVertexList(
+				Buffers.VertexList, NodeId, 0), false);
 
-				TriangleIdx++;
-			}
-		}
-
-		// Now transfer valid vertex instance attributes to Houdini vertex attributes
+			// Send the array of face vertex counts.
+			HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetFaceCounts(
+				Buffers.FaceCounts, NodeId, 0), false);
+			return true;
+		};
 
-		//--------------------------------------------------------------------------------------------------------------------- 
-		// UVS (uvX)
-		//--------------------------------------------------------------------------------------------------------------------- 
-		if (bIsVertexInstanceUVsValid)
+		// Adds the upload of a float vertex attribute
+		auto AddVertexAttributeUpload = [&](const FString& InAttributeName, const TArray<float>& InValues, const int32& InTupleSize, const bool& bInAttemptRunLengthEncoding, TFunction<void()>&& InFill)
 		{
-			for (uint32 UVLayerIndex = 0; UVLayerIndex < NumUVLayers; UVLayerIndex++)
+			FHoudiniMeshAttributeUpload& AttributeUpload = Uploads.AddDefaulted_GetRef();
+			AttributeUpload.Fill = MoveTemp(InFill);
+			AttributeUpload.Upload = [&InValues, InAttributeName, InTupleSize, bInAttemptRunLengthEncoding, NodeId]()
 			{
-				// Construct the attribute name for this UV index.
-				FString UVAttributeName = HAPI_UNREAL_ATTRIB_UV;
-				if (UVLayerIndex > 0)
-					UVAttributeName += FString::Printf(TEXT("%d"), UVLayerIndex + 1);
-
-				// Create attribute for UVs
 				HAPI_AttributeInfo AttributeInfoVertex;
 				FHoudiniApi::AttributeInfo_Init(&AttributeInfoVertex);
 
-				AttributeInfoVertex.count = NumVertexInstances;
-				AttributeInfoVertex.tupleSize = 3;
+				AttributeInfoVertex.tupleSize = InTupleSize;
+				AttributeInfoVertex.count = InValues.Num() / InTupleSize;
 				AttributeInfoVertex.exists = true;
 				AttributeInfoVertex.owner = HAPI_ATTROWNER_VERTEX;
 				AttributeInfoVertex.storage = HAPI_STORAGETYPE_FLOAT;
@@ -2826,11 +2671,28 @@ FUnrealMeshTranslator::CreateInputNodeForStaticMeshLODResources(
 
 				HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
 					FHoudiniEngine::Get().GetSession(),
-					NodeId, 0, TCHAR_TO_ANSI(*UVAttributeName), &AttributeInfoVertex), false);
+					NodeId, 0, TCHAR_TO_ANSI(*InAttributeName), &AttributeInfoVertex), false);
 
 				HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
-					UVs[UVLayerIndex], NodeId, 0, UVAttributeName, AttributeInfoVertex), false);
-			}
+					InValues, NodeId, 0, InAttributeName, AttributeInfoVertex, bInAttemptRunLengthEncoding), false);
+				return true;
+			};
+		};
+
+		//--------------------------------------------------------------------------------------------------------------------- 
+		// UVS (uvX)
+		//--------------------------------------------------------------------------------------------------------------------- 
+		for (uint32 UVLayerIndex = 0; UVLayerIndex < NumUVLayers; UVLayerIndex++)
+		{
+			// Construct the attribute name for this UV index.
+			FString UVAttributeName = HAPI_UNREAL_ATTRIB_UV;
+			if (UVLayerIndex > 0)
+				UVAttributeName += FString::Printf(TEXT("%d"), UVLayerIndex + 1);
+
+			AddVertexAttributeUpload(UVAttributeName, Buffers.UVs[UVLayerIndex], 3, false, [&, UVLayerIndex]()
+			{
+				FHoudiniMeshMarshalling::FillLODResourcesUVs(LODResources, UVLayerIndex, bParallelMarshalling, Buffers);
+			});
 		}
 
 		//--------------------------------------------------------------------------------------------------------------------- 
@@ -2838,23 +2700,10 @@ FUnrealMeshTranslator::CreateInputNodeForStaticMeshLODResources(
 		//---------------------------------------------------------------------------------------------------------------------
 		if (bIsVertexInstanceNormalsValid)
 		{
-			// Create attribute for normals.
-			HAPI_AttributeInfo AttributeInfoVertex;
-			FHoudiniApi::AttributeInfo_Init(&AttributeInfoVertex);
-
-			AttributeInfoVertex.tupleSize = 3;
-			AttributeInfoVertex.count = Normals.Num() / AttributeInfoVertex.tupleSize;
-			AttributeInfoVertex.exists = true;
-			AttributeInfoVertex.owner = HAPI_ATTROWNER_VERTEX;
-			AttributeInfoVertex.storage = HAPI_STORAGETYPE_FLOAT;
-			AttributeInfoVertex.originalOwner = HAPI_ATTROWNER_INVALID;
-
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
-				FHoudiniEngine::Get().GetSession(),
-				NodeId, 0, HAPI_UNREAL_ATTRIB_NORMAL, &AttributeInfoVertex), false);
-
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
-				Normals, NodeId, 0, HAPI_UNREAL_ATTRIB_NORMAL, AttributeInfoVertex), false);
+			AddVertexAttributeUpload(HAPI_UNREAL_ATTRIB_NORMAL, Buffers.Normals, 3, false, [&]()
+			{
+				FHoudiniMeshMarshalling::FillLODResourcesNormals(LODResources, bParallelMarshalling, Buffers);
+			});
 		}
 
 		//--------------------------------------------------------------------------------------------------------------------- 
@@ -2862,23 +2711,10 @@ FUnrealMeshTranslator::CreateInputNodeForStaticMeshLODResources(
 		//---------------------------------------------------------------------------------------------------------------------
 		if (bIsVertexInstanceTangentsValid)
 		{
-			// Create attribute for tangentu.
-			HAPI_AttributeInfo AttributeInfoVertex;
-			FHoudiniApi::AttributeInfo_Init(&AttributeInfoVertex);
-
-			AttributeInfoVertex.tupleSize = 3;
-			AttributeInfoVertex.count = Tangents.Num() / AttributeInfoVertex.tupleSize;
-			AttributeInfoVertex.exists = true;
-			AttributeInfoVertex.owner = HAPI_ATTROWNER_VERTEX;
-			AttributeInfoVertex.storage = HAPI_STORAGETYPE_FLOAT;
-			AttributeInfoVertex.originalOwner = HAPI_ATTROWNER_INVALID;
-
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
-				FHoudiniEngine::Get().GetSession(),
-				NodeId, 0, HAPI_UNREAL_ATTRIB_TANGENTU, &AttributeInfoVertex), false);
-
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
-				Tangents, NodeId, 0, HAPI_UNREAL_ATTRIB_TANGENTU, AttributeInfoVertex), false);
+			AddVertexAttributeUpload(HAPI_UNREAL_ATTRIB_TANGENTU, Buffers.Tangents, 3, false, [&]()
+			{
+				FHoudiniMeshMarshalling::FillLODResourcesTangents(LODResources, bParallelMarshalling, Buffers);
+			});
 		}
 
 		//--------------------------------------------------------------------------------------------------------------------- 
@@ -2886,23 +2722,10 @@ FUnrealMeshTranslator::CreateInputNodeForStaticMeshLODResources(
 		//---------------------------------------------------------------------------------------------------------------------
 		if (bIsVertexInstanceBinormalsValid)
 		{
-			// Create attribute for normals.
-			HAPI_AttributeInfo AttributeInfoVertex;
-			FHoudiniApi::AttributeInfo_Init(&AttributeInfoVertex);
-
-			AttributeInfoVertex.tupleSize = 3;
-			AttributeInfoVertex.count = Binormals.Num() / AttributeInfoVertex.tupleSize;
-			AttributeInfoVertex.exists = true;
-			AttributeInfoVertex.owner = HAPI_ATTROWNER_VERTEX;
-			AttributeInfoVertex.storage = HAPI_STORAGETYPE_FLOAT;
-			AttributeInfoVertex.originalOwner = HAPI_ATTROWNER_INVALID;
-
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
-				FHoudiniEngine::Get().GetSession(),
-				NodeId, 0, HAPI_UNREAL_ATTRIB_TANGENTV, &AttributeInfoVertex), false);
-
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
-				Binormals, NodeId, 0, HAPI_UNREAL_ATTRIB_TANGENTV, AttributeInfoVertex), false);
+			AddVertexAttributeUpload(HAPI_UNREAL_ATTRIB_TANGENTV, Buffers.Binormals, 3, false, [&]()
+			{
+				FHoudiniMeshMarshalling::FillLODResourcesBinormals(LODResources, bParallelMarshalling, Buffers);
+			});
 		}
 
 		//--------------------------------------------------------------------------------------------------------------------- 
@@ -2910,134 +2733,71 @@ FUnrealMeshTranslator::CreateInputNodeForStaticMeshLODResources(
 		//---------------------------------------------------------------------------------------------------------------------
 		if (bUseComponentOverrideColors || bIsVertexInstanceColorsValid)
 		{
-			// Create attribute for colors.
-			HAPI_AttributeInfo AttributeInfoVertex;
-			FHoudiniApi::AttributeInfo_Init(&AttributeInfoVertex);
-
-			AttributeInfoVertex.tupleSize = 3;
-			AttributeInfoVertex.count = RGBColors.Num() / AttributeInfoVertex.tupleSize;
-			AttributeInfoVertex.exists = true;
-			AttributeInfoVertex.owner = HAPI_ATTROWNER_VERTEX;
-			AttributeInfoVertex.storage = HAPI_STORAGETYPE_FLOAT;
-			AttributeInfoVertex.originalOwner = HAPI_ATTROWNER_INVALID;
-
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
-				FHoudiniEngine::Get().GetSession(),
-				NodeId, 0, HAPI_UNREAL_ATTRIB_COLOR, &AttributeInfoVertex), false);
-
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
-				RGBColors, NodeId, 0, HAPI_UNREAL_ATTRIB_COLOR, AttributeInfoVertex, true), false);
+			const FColorVertexBuffer* ColorVertexBuffer = bUseComponentOverrideColors
+				? StaticMeshComponent->LODData[InLODIndex].OverrideVertexColors
+				: &LODResources.VertexBuffers.ColorVertexBuffer;
 
-			FHoudiniApi::AttributeInfo_Init(&AttributeInfoVertex);
-			AttributeInfoVertex.tupleSize = 1;
-			AttributeInfoVertex.count = Alphas.Num();
-			AttributeInfoVertex.exists = true;
-			AttributeInfoVertex.owner = HAPI_ATTROWNER_VERTEX;
-			AttributeInfoVertex.storage = HAPI_STORAGETYPE_FLOAT;
-			AttributeInfoVertex.originalOwner = HAPI_ATTROWNER_INVALID;
-
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
-				FHoudiniEngine::Get().GetSession(),
-				NodeId, 0, HAPI_UNREAL_ATTRIB_ALPHA, &AttributeInfoVertex), false);
+			AddVertexAttributeUpload(HAPI_UNREAL_ATTRIB_COLOR, Buffers.RGBColors, 3, true, [&, ColorVertexBuffer]()
+			{
+				FHoudiniMeshMarshalling::FillLODResourcesColors(*ColorVertexBuffer, bParallelMarshalling, Buffers);
+			});
 
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
-				Alphas, NodeId, 0, HAPI_UNREAL_ATTRIB_ALPHA, AttributeInfoVertex, true), false);
+			// The alphas are filled with the colors
+			AddVertexAttributeUpload(HAPI_UNREAL_ATTRIB_ALPHA, Buffers.Alphas, 1, true, TFunction<void()>());
 		}
 
-		//--------------------------------------------------------------------------------------------------------------------- 
-		// TRIANGLE/FACE VERTEX INDICES
-		//---------------------------------------------------------------------------------------------------------------------
-		// We can now set vertex list.
-		HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetVertexList(
-			MeshTriangleVertexIndices, NodeId, 0), false);
-
-		// Send the array of face vertex counts.
-		TArray<int32> StaticMeshFaceCounts;
-		StaticMeshFaceCounts.SetNumUninitialized(Part.faceCount);
-		for (int32 n = 0; n < Part.faceCount; n++)
-			StaticMeshFaceCounts[n] = 3;
-
-		HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetFaceCounts(
-			StaticMeshFaceCounts, NodeId, 0), false);
-
 		// Send material assignments to Houdini
 		if (NumMaterials > 0)
 		{
-			// List of materials, one for each face.
-			FHoudiniEngineIndexedStringMap TriangleMaterials;
+			FHoudiniMeshAttributeUpload& MaterialUpload = Uploads.AddDefaulted_GetRef();
+			MaterialUpload.Upload = [&]()
+			{
+				// List of materials, one for each face.
+				FHoudiniEngineIndexedStringMap TriangleMaterials;
 
-			//Lists of material parameters
-			TMap<FString, TArray<float>> ScalarMaterialParameters;
-			TMap<FString, TArray<float>> VectorMaterialParameters;
-            TMap<FString, FHoudiniEngineIndexedStringMap> TextureMaterialParameters;
+				//Lists of material parameters
+				TMap<FString, TArray<float>> ScalarMaterialParameters;
+				TMap<FString, TArray<float>> VectorMaterialParameters;
+				TMap<FString, FHoudiniEngineIndexedStringMap> TextureMaterialParameters;
 
-			bool bAttributeSuccess = false;
-			FString PhysicalMaterialPath = GetSimplePhysicalMaterialPath(StaticMeshComponent, StaticMesh);
-			if (bInExportMaterialParametersAsAttributes)
-			{
-				// Create attributes for the material and all its parameters
-				// Get material attribute data, and all material parameters data
-				FUnrealMeshTranslator::CreateFaceMaterialArray(
-					MaterialInterfaces, TriangleMaterialIndices, TriangleMaterials,
-					ScalarMaterialParameters, VectorMaterialParameters, TextureMaterialParameters);
-			}
-			else
-			{
-				// Create attributes only for the materials
-				// Only get the material attribute data
-				FUnrealMeshTranslator::CreateFaceMaterialArray(
-					MaterialInterfaces, TriangleMaterialIndices, TriangleMaterials);
-			}
-						
-			// Create all the needed attributes for materials
-			bAttributeSuccess = FUnrealMeshTranslator::CreateHoudiniMeshAttributes(
-				NodeId,
-				0,
-				TriangleMaterials.GetIds().Num(),
-				TriangleMaterials,
-				ScalarMaterialParameters,
-				VectorMaterialParameters,
-				TextureMaterialParameters,
-				PhysicalMaterialPath,
-				StaticMesh->NaniteSettings);
-
-			if (!bAttributeSuccess)
-			{
-				return false;
-			}
+				FString PhysicalMaterialPath = GetSimplePhysicalMaterialPath(StaticMeshComponent, StaticMesh);
+				if (bInExportMaterialParametersAsAttributes)
+				{
+					// Create attributes for the material and all its parameters
+					// Get material attribute data, and all material parameters data
+					FUnrealMeshTranslator::CreateFaceMaterialArray(
+						MaterialInterfaces, Buffers.FaceMaterialIndices, TriangleMaterials,
+						ScalarMaterialParameters, VectorMaterialParameters, TextureMaterialParameters);
+				}
+				else
+				{
+					// Create attributes only for the materials
+					// Only get the material attribute data
+					FUnrealMeshTranslator::CreateFaceMaterialArray(
+						MaterialInterfaces, Buffers.FaceMaterialIndices, TriangleMaterials);
+				}
+
+				// Create all the needed attributes for materials
+				return FUnrealMeshTranslator::CreateHoudiniMeshAttributes(
+					NodeId,
+					0,
+					TriangleMaterials.GetIds().Num(),
+					TriangleMaterials,
+					ScalarMaterialParameters,
+					VectorMaterialParameters,
+					TextureMaterialParameters,
+					PhysicalMaterialPath,
+					StaticMesh->NaniteSettings);
+			};
 		}
 
 		// TODO: The render mesh (LODResources) does not have face smoothing information, and the raw mesh triangle order is
 		// potentially different (see also line 4152 TODO_FBX in Engine\Source\Editor\UnrealEd\Private\Fbx\FbxMainExport.cpp
-		////--------------------------------------------------------------------------------------------------------------------- 
-		//// TRIANGLE SMOOTHING MASKS
-		////---------------------------------------------------------------------------------------------------------------------	
-		//TArray<uint32> TriangleSmoothingMasks;
-		//TriangleSmoothingMasks.SetNumZeroed(NumTriangles);
-		//FStaticMeshOperations::ConvertHardEdgesToSmoothGroup(MeshDescription, TriangleSmoothingMasks);
-		//if (TriangleSmoothingMasks.Num() > 0)
-		//{
-		//	HAPI_AttributeInfo AttributeInfoSmoothingMasks;
-		//	FHoudiniApi::AttributeInfo_Init(&AttributeInfoSmoothingMasks);
-
-		//	AttributeInfoSmoothingMasks.tupleSize = 1;
-		//	AttributeInfoSmoothingMasks.count = TriangleSmoothingMasks.Num();
-		//	AttributeInfoSmoothingMasks.exists = true;
-		//	AttributeInfoSmoothingMasks.owner = HAPI_ATTROWNER_PRIM;
-		//	AttributeInfoSmoothingMasks.storage = HAPI_STORAGETYPE_INT;
-		//	AttributeInfoSmoothingMasks.originalOwner = HAPI_ATTROWNER_INVALID;
-
-		//	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
-		//		FHoudiniEngine::Get().GetSession(),
-		//		NodeId, 0, HAPI_UNREAL_ATTRIB_FACE_SMOOTHING_MASK, &AttributeInfoSmoothingMasks), false);
-
-		//	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::SetAttributeIntData(
-		//		FHoudiniEngine::Get().GetSession(),
-		//		NodeId, 0, HAPI_UNREAL_ATTRIB_FACE_SMOOTHING_MASK, &AttributeInfoSmoothingMasks,
-		//		(const int32 *)TriangleSmoothingMasks.GetData(), 0, TriangleSmoothingMasks.Num()), false);
-		//}
 	}
 
+	if (!FHoudiniMeshMarshalling::RunUploads(Uploads, bParallelMarshalling))
+		return false;
+
 	//--------------------------------------------------------------------------------------------------------------------- 
 	// LIGHTMAP RESOLUTION
 	//---------------------------------------------------------------------------------------------------------------------
@@ -3275,7 +3035,6 @@ FUnrealMeshTranslator::CreateInputNodeForMeshDescription(
 	// Get the vertex and triangle arrays
 	const FVertexArray &MDVertices = MeshDescription.Vertices();
 	const FPolygonGroupArray &MDPolygonGroups = MeshDescription.PolygonGroups();
-	const FPolygonArray &MDPolygons = MeshDescription.Polygons();
 	const FTriangleArray &MDTriangles = MeshDescription.Triangles();
 
 	// Determine point, vertex and polygon counts
@@ -3338,38 +3097,30 @@ FUnrealMeshTranslator::CreateInputNodeForMeshDescription(
 	const FStaticMeshSourceModel &SourceModel = InLODIndex > 0 ? StaticMesh->GetSourceModel(InLODIndex) : StaticMesh->GetHiResSourceModel();
 	FVector3f BuildScaleVector = (FVector3f)SourceModel.BuildSettings.BuildScale3D;
 
+	// Staging buffers for the attributes, reused between meshes
+	FHoudiniScopedMeshMarshallingBuffers ScopedBuffers;
+	FHoudiniMeshMarshallingBuffers& Buffers = ScopedBuffers.Get();
+	const bool bParallelMarshalling = FHoudiniMeshMarshalling::IsParallel();
+
+	// Each attribute buffer is built while the previous attribute is uploaded to Houdini
+	TArray<FHoudiniMeshAttributeUpload> Uploads;
+
 	//--------------------------------------------------------------------------------------------------------------------- 
 	// POSITION (P)
 	//--------------------------------------------------------------------------------------------------------------------- 
-	// The mesh element arrays are sparse: the max index/ID value can be larger than the number of elements - 1
-	// so we have to maintain a lookup of VertexID (UE) to PointIndex (Houdini)
-	TArray<int32> VertexIDToHIndex;
 	if (bIsVertexPositionsValid && VertexPositions.GetNumElements() >= 3)
 	{
-		TArray<float> StaticMeshVertices;
-		StaticMeshVertices.SetNumUninitialized(NumVertices * 3);
-				
-		VertexIDToHIndex.SetNumUninitialized(MDVertices.GetArraySize());
-		for (int32 n = 0; n < VertexIDToHIndex.Num(); n++)
-			VertexIDToHIndex[n] = INDEX_NONE;
-
-		int32 VertexIdx = 0;
-		for (const FVertexID& VertexID : MDVertices.GetElementIDs())
+		FHoudiniMeshAttributeUpload& PositionUpload = Uploads.AddDefaulted_GetRef();
+		PositionUpload.Fill = [&]()
 		{
-			// Convert Unreal to Houdini
-			const FVector3f& PositionVector = VertexPositions.Get(VertexID);
-			StaticMeshVertices[VertexIdx * 3 + 0] = PositionVector.X / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScaleVector.X;
-			StaticMeshVertices[VertexIdx * 3 + 1] = PositionVector.Z / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScaleVector.Z;
-			StaticMeshVertices[VertexIdx * 3 + 2] = PositionVector.Y / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScaleVector.Y;
-
-			// Record the UE Vertex ID to Houdini Point Index lookup
-			VertexIDToHIndex[VertexID.GetValue()] = VertexIdx;
-			VertexIdx++;
-		}
-
-		// Now that we have raw positions, we can upload them for our attribute.
-		HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
-			StaticMeshVertices, NodeId, 0, HAPI_UNREAL_ATTRIB_POSITION, AttributeInfoPoint), false);
+			FHoudiniMeshMarshalling::FillMeshDescriptionPoints(MeshDescription, BuildScaleVector, bParallelMarshalling, Buffers);
+		};
+		PositionUpload.Upload = [&]()
+		{
+			HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
+				Buffers.Positions, NodeId, 0, HAPI_UNREAL_ATTRIB_POSITION, AttributeInfoPoint), false);
+			return true;
+		};
 	}
 
 	bool bUseComponentOverrideColors = false;
@@ -3411,7 +3162,6 @@ FUnrealMeshTranslator::CreateInputNodeForMeshDescription(
 	// and the UMaterialInterface array
 	// TMap<FName, int32> MaterialSlotToInterface;
 	TArray<UMaterialInterface*> MaterialInterfaces;
-	TArray<int32> TriangleMaterialIndices;
 
 	const TArray<FStaticMaterial>& StaticMaterials = StaticMesh->GetStaticMaterials();
 
@@ -3451,8 +3201,6 @@ FUnrealMeshTranslator::CreateInputNodeForMeshDescription(
 			// MaterialSlotToInterface.Add(MaterialInfo.ImportedMaterialSlotName, MaterialIndex);
 			MaterialInterfaces.Add(Material);
 		}
-
-		TriangleMaterialIndices.Reserve(NumTriangles);
 	}
 	// SectionIndex: Looking at Epic's StaticMesh build code, Sections are created in the same
 	// order as iterating over PolygonGroups, but skipping empty PolygonGroups
@@ -3518,429 +3266,212 @@ FUnrealMeshTranslator::CreateInputNodeForMeshDescription(
 
 	if (NumTriangles > 0)
 	{
-		// UV layer array. Each layer has an array of floats, 3 floats per vertex instance
-		TArray<TArray<float>> UVs;
 		const int32 NumUVLayers = bIsVertexInstanceUVsValid ? FMath::Min(VertexInstanceUVs.GetNumChannels(), (int32)MAX_STATIC_TEXCOORDS) : 0;
-		// Normals: 3 floats per vertex instance
-		TArray<float> Normals;
-		// Tangents: 3 floats per vertex instance
-		TArray<float> Tangents;
-		// Binormals: 3 floats per vertex instance
-		TArray<float> Binormals;
-		// RGBColors: 3 floats per vertex instance
-		TArray<float> RGBColors;
-		// Alphas: 1 float per vertex instance
-		TArray<float> Alphas;
-
-		// Initialize the arrays for the attributes that are valid
-		if (bIsVertexInstanceUVsValid)
+
+		// The UV layer array itself must not be resized once the uploads have started
+		if (Buffers.UVs.Num() < NumUVLayers)
+			Buffers.UVs.SetNum(NumUVLayers);
+
+		//--------------------------------------------------------------------------------------------------------------------- 
+		// TRIANGLE/FACE VERTEX INDICES
+		//---------------------------------------------------------------------------------------------------------------------
+		// Also finds the vertex instance of each Houdini vertex, used by all the vertex attributes below
+		FHoudiniMeshAttributeUpload& VertexListUpload = Uploads.AddDefaulted_GetRef();
+		VertexListUpload.Fill = [&]()
+		{
+			FHoudiniMeshMarshalling::FillMeshDescriptionTopology(MeshDescription, PolygonGroupToMaterialIndex, bParallelMarshalling, Buffers);
+		};
+		VertexListUpload.Upload = [&]()
 		{
-			UVs.SetNum(NumUVLayers);
-			for (int32 UVLayerIndex = 0; UVLayerIndex < NumUVLayers; ++UVLayerIndex)
+			HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetVertexList(
+				Buffers.VertexList, NodeId, 0), false);
+
+			// Send the array of face vertex counts.
+			HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetFaceCounts(
+				Buffers.FaceCounts, NodeId, 0), false);
+			return true;
+		};
+
+		// Adds the upload of a float vertex attribute
+		auto AddVertexAttributeUpload = [&](const FString& InAttributeName, const TArray<float>& InValues, const int32& InTupleSize, const bool& bInAttemptRunLengthEncoding, TFunction<void()>&& InFill)
+		{
+			FHoudiniMeshAttributeUpload& AttributeUpload = Uploads.AddDefaulted_GetRef();
+			AttributeUpload.Fill = MoveTemp(InFill);
+			AttributeUpload.Upload = [&InValues, InAttributeName, InTupleSize, bInAttemptRunLengthEncoding, NodeId]()
 			{
-				UVs[UVLayerIndex].SetNumUninitialized(NumVertexInstances * 3);
-			}
+				HAPI_AttributeInfo AttributeInfoVertex;
+				FHoudiniApi::AttributeInfo_Init(&AttributeInfoVertex);
+
+				AttributeInfoVertex.tupleSize = InTupleSize;
+				AttributeInfoVertex.count = InValues.Num() / InTupleSize;
+				AttributeInfoVertex.exists = true;
+				AttributeInfoVertex.owner = HAPI_ATTROWNER_VERTEX;
+				AttributeInfoVertex.storage = HAPI_STORAGETYPE_FLOAT;
+				AttributeInfoVertex.originalOwner = HAPI_ATTROWNER_INVALID;
+
+				HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
+					FHoudiniEngine::Get().GetSession(),
+					NodeId, 0, TCHAR_TO_ANSI(*InAttributeName), &AttributeInfoVertex), false);
+
+				HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
+					InValues, NodeId, 0, InAttributeName, AttributeInfoVertex, bInAttemptRunLengthEncoding), false);
+				return true;
+			};
+		};
+
+		//--------------------------------------------------------------------------------------------------------------------- 
+		// UVS (uvX)
+		//--------------------------------------------------------------------------------------------------------------------- 
+		for (int32 UVLayerIndex = 0; UVLayerIndex < NumUVLayers; UVLayerIndex++)
+		{
+			// Construct the attribute name for this UV index.
+			FString UVAttributeName = HAPI_UNREAL_ATTRIB_UV;
+			if (UVLayerIndex > 0)
+				UVAttributeName += FString::Printf(TEXT("%d"), UVLayerIndex + 1);
+
+			AddVertexAttributeUpload(UVAttributeName, Buffers.UVs[UVLayerIndex], 3, true, [&, UVLayerIndex]()
+			{
+				FHoudiniMeshMarshalling::FillMeshDescriptionUVs(MeshDescription, UVLayerIndex, bParallelMarshalling, Buffers);
+			});
 		}
 
+		//--------------------------------------------------------------------------------------------------------------------- 
+		// NORMALS (N)
+		//---------------------------------------------------------------------------------------------------------------------
 		if (bIsVertexInstanceNormalsValid)
 		{
-			Normals.SetNumUninitialized(NumVertexInstances * 3);
+			AddVertexAttributeUpload(HAPI_UNREAL_ATTRIB_NORMAL, Buffers.Normals, 3, true, [&]()
+			{
+				FHoudiniMeshMarshalling::FillMeshDescriptionNormals(MeshDescription, bParallelMarshalling, Buffers);
+			});
 		}
 
+		//--------------------------------------------------------------------------------------------------------------------- 
+		// TANGENT (tangentu)
+		//---------------------------------------------------------------------------------------------------------------------
 		if (bIsVertexInstanceTangentsValid)
 		{
-			Tangents.SetNumUninitialized(NumVertexInstances * 3);
+			AddVertexAttributeUpload(HAPI_UNREAL_ATTRIB_TANGENTU, Buffers.Tangents, 3, false, [&]()
+			{
+				FHoudiniMeshMarshalling::FillMeshDescriptionTangents(MeshDescription, bParallelMarshalling, Buffers);
+			});
 		}
 
+		//--------------------------------------------------------------------------------------------------------------------- 
+		// BINORMAL (tangentv)
+		//---------------------------------------------------------------------------------------------------------------------
+		// In order to calculate the binormal we also need the tangent and normal
 		if (bIsVertexInstanceBinormalSignsValid)
 		{
-			Binormals.SetNumUninitialized(NumVertexInstances * 3);
+			AddVertexAttributeUpload(HAPI_UNREAL_ATTRIB_TANGENTV, Buffers.Binormals, 3, false, [&]()
+			{
+				FHoudiniMeshMarshalling::FillMeshDescriptionBinormals(MeshDescription, bParallelMarshalling, Buffers);
+			});
 		}
 
+		//--------------------------------------------------------------------------------------------------------------------- 
+		// COLORS (Cd)
+		//---------------------------------------------------------------------------------------------------------------------
 		if (bUseComponentOverrideColors || bIsVertexInstanceColorsValid)
 		{
-			RGBColors.SetNumUninitialized(NumVertexInstances * 3);
-			Alphas.SetNumUninitialized(NumVertexInstances);
-		}
-
-		// Array of material index per triangle/face
-		TArray<int32> MeshTriangleVertexIndices;
-		MeshTriangleVertexIndices.SetNumUninitialized(NumVertexInstances);
-		// Array of vertex counts per triangle/face
-		TArray<int32> MeshTriangleVertexCounts;
-		MeshTriangleVertexCounts.SetNumUninitialized(NumTriangles);
-
-		int32 TriangleIdx = 0;
-		int32 VertexInstanceIdx = 0;
-		{
-            SCOPED_FUNCTION_LABELLED_TIMER("Fetching Vertex Data");
-		    for (const FPolygonID &PolygonID : MDPolygons.GetElementIDs())
-		    {
-			    for (const FTriangleID& TriangleID : MeshDescription.GetPolygonTriangles(PolygonID))
-			    {
+			const FColorVertexBuffer* OverrideColors = nullptr;
+			const TArray<int32>* WedgeMap = nullptr;
+			if (bUseComponentOverrideColors && SMRenderData)
+			{
+				OverrideColors = StaticMeshComponent->LODData[InLODIndex].OverrideVertexColors;
+				WedgeMap = &SMRenderData->LODResources[InLODIndex].WedgeMap;
+			}
 
-				    MeshTriangleVertexCounts[TriangleIdx] = 3;
-				    for (int32 TriangleVertexIndex = 0; TriangleVertexIndex < 3; ++TriangleVertexIndex)
-				    {
-					    // Reverse the winding order for Houdini (but still start at 0)
-					    const int32 WindingIdx = (3 - TriangleVertexIndex) % 3;
-					    const FVertexInstanceID &VertexInstanceID = MeshDescription.GetTriangleVertexInstance(TriangleID, WindingIdx);
-
-					    // // UE Vertex Instance ID to Houdini Vertex Index look up
-					    // VertexInstanceIDToHIndex[VertexInstanceID.GetValue()] = VertexInstanceIdx;
-
-					    // Calculate the index of the first component of a vertex instance's value in an inline float array 
-					    // representing vectors (3 float) per vertex instance
-					    const int32 Float3Index = VertexInstanceIdx * 3;
-
-					    //--------------------------------------------------------------------------------------------------------------------- 
-					    // UVS (uvX)
-					    //--------------------------------------------------------------------------------------------------------------------- 
-					    if (bIsVertexInstanceUVsValid)
-					    {
-						    for (int32 UVLayerIndex = 0; UVLayerIndex < NumUVLayers; ++UVLayerIndex)
-						    {
-							    const FVector2f &UV = VertexInstanceUVs.Get(VertexInstanceID, UVLayerIndex);
-							    UVs[UVLayerIndex][Float3Index + 0] = UV.X;
-							    UVs[UVLayerIndex][Float3Index + 1] = 1.0f - UV.Y;
-							    UVs[UVLayerIndex][Float3Index + 2] = 0;
-						    }
-					    }
-
-					    //--------------------------------------------------------------------------------------------------------------------- 
-					    // NORMALS (N)
-					    //---------------------------------------------------------------------------------------------------------------------
-					    if (bIsVertexInstanceNormalsValid)
-					    {
-						    const FVector3f &Normal = VertexInstanceNormals.Get(VertexInstanceID);
-						    Normals[Float3Index + 0] = Normal.X;
-						    Normals[Float3Index + 1] = Normal.Z;
-						    Normals[Float3Index + 2] = Normal.Y;
-					    }
-
-					    //--------------------------------------------------------------------------------------------------------------------- 
-					    // TANGENT (tangentu)
-					    //---------------------------------------------------------------------------------------------------------------------
-					    if (bIsVertexInstanceTangentsValid)
-					    {
-						    const FVector3f &Tangent = VertexInstanceTangents.Get(VertexInstanceID);
-						    Tangents[Float3Index + 0] = Tangent.X;
-						    Tangents[Float3Index + 1] = Tangent.Z;
-						    Tangents[Float3Index + 2] = Tangent.Y;
-					    }
-
-					    //--------------------------------------------------------------------------------------------------------------------- 
-					    // BINORMAL (tangentv)
-					    //---------------------------------------------------------------------------------------------------------------------
-					    // In order to calculate the binormal we also need the tangent and normal
-					    if (bIsVertexInstanceBinormalSignsValid && bIsVertexInstanceTangentsValid && bIsVertexInstanceNormalsValid)
-					    {
-						    const float &BinormalSign = VertexInstanceBinormalSigns.Get(VertexInstanceID);
-						    FVector Binormal = FVector::CrossProduct(
-							    FVector(Tangents[Float3Index + 0], Tangents[Float3Index + 1], Tangents[Float3Index + 2]),
-							    FVector(Normals[Float3Index + 0], Normals[Float3Index + 1], Normals[Float3Index + 2])
-						    ) * BinormalSign;
-						    Binormals[Float3Index + 0] = (float)Binormal.X;
-						    Binormals[Float3Index + 1] = (float)Binormal.Y;
-						    Binormals[Float3Index + 2] = (float)Binormal.Z;
-					    }
-
-					    //--------------------------------------------------------------------------------------------------------------------- 
-					    // COLORS (Cd)
-					    //---------------------------------------------------------------------------------------------------------------------
-					    if (bUseComponentOverrideColors || bIsVertexInstanceColorsValid)
-					    {
-						    FVector4f Color = FLinearColor::White;
-						    if (bUseComponentOverrideColors && SMRenderData)
-						    {
-							    FStaticMeshComponentLODInfo& ComponentLODInfo = StaticMeshComponent->LODData[InLODIndex];
-							    FStaticMeshLODResources& RenderModel = SMRenderData->LODResources[InLODIndex];
-							    FColorVertexBuffer& ColorVertexBuffer = *ComponentLODInfo.OverrideVertexColors;
-
-							    int32 Index = RenderModel.WedgeMap[VertexInstanceID];
-							    if (Index != INDEX_NONE)
-							    {
-								    Color = ColorVertexBuffer.VertexColor(Index).ReinterpretAsLinear();
-							    }
-						    }
-						    else
-						    {
-							    Color = VertexInstanceColors.Get(VertexInstanceID);
-						    }
-						    RGBColors[Float3Index + 0] = Color[0];
-						    RGBColors[Float3Index + 1] = Color[1];
-						    RGBColors[Float3Index + 2] = Color[2];
-						    Alphas[VertexInstanceIdx] = Color[3];
-					    }
-
-					    //--------------------------------------------------------------------------------------------------------------------- 
-					    // TRIANGLE/FACE VERTEX INDICES
-					    //---------------------------------------------------------------------------------------------------------------------
-					    const FVertexID& VertexID = MeshDescription.GetVertexInstanceVertex(VertexInstanceID);
-					    const int32 UEVertexIdx = VertexID.GetValue();
-					    if (VertexIDToHIndex.IsValidIndex(UEVertexIdx))
-					    {
-						    MeshTriangleVertexIndices[VertexInstanceIdx] = VertexIDToHIndex[UEVertexIdx];
-					    }
-
-					    VertexInstanceIdx++;
-				    }
-
-				    //--------------------------------------------------------------------------------------------------------------------- 
-				    // TRIANGLE MATERIAL ASSIGNMENT
-				    //---------------------------------------------------------------------------------------------------------------------
-				    const FPolygonGroupID& PolygonGroupID = MeshDescription.GetPolygonPolygonGroup(PolygonID);
-				    int32 MaterialIndex = PolygonGroupToMaterialIndex.FindChecked(PolygonGroupID);
-				    TriangleMaterialIndices.Add(MaterialIndex);
-
-				    TriangleIdx++;
-			    }
+			AddVertexAttributeUpload(HAPI_UNREAL_ATTRIB_COLOR, Buffers.RGBColors, 3, true, [&, OverrideColors, WedgeMap]()
+			{
+				FHoudiniMeshMarshalling::FillMeshDescriptionColors(MeshDescription, OverrideColors, WedgeMap, bParallelMarshalling, Buffers);
+			});
 
-		    }
+			// The alphas are filled with the colors
+			AddVertexAttributeUpload(HAPI_UNREAL_ATTRIB_ALPHA, Buffers.Alphas, 1, true, TFunction<void()>());
 		}
-		// Now transfer valid vertex instance attributes to Houdini vertex attributes
 
+		// Send material assignments to Houdini
+		if (NumMaterials > 0)
 		{
-            SCOPED_FUNCTION_LABELLED_TIMER("Transfering Data");
-		    //--------------------------------------------------------------------------------------------------------------------- 
-		    // UVS (uvX)
-		    //--------------------------------------------------------------------------------------------------------------------- 
-		    if (bIsVertexInstanceUVsValid)
-		    {
-			    for (int32 UVLayerIndex = 0; UVLayerIndex < NumUVLayers; UVLayerIndex++)
-			    {
-				    // Construct the attribute name for this UV index.
-				    FString UVAttributeName = HAPI_UNREAL_ATTRIB_UV;
-				    if (UVLayerIndex > 0)
-					    UVAttributeName += FString::Printf(TEXT("%d"), UVLayerIndex + 1);
-
-				    // Create attribute for UVs
-				    HAPI_AttributeInfo AttributeInfoVertex;
-				    FHoudiniApi::AttributeInfo_Init(&AttributeInfoVertex);
-
-				    AttributeInfoVertex.count = NumVertexInstances;
-				    AttributeInfoVertex.tupleSize = 3;
-				    AttributeInfoVertex.exists = true;
-				    AttributeInfoVertex.owner = HAPI_ATTROWNER_VERTEX;
-				    AttributeInfoVertex.storage = HAPI_STORAGETYPE_FLOAT;
-				    AttributeInfoVertex.originalOwner = HAPI_ATTROWNER_INVALID;
-
-				    HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
-					    FHoudiniEngine::Get().GetSession(),
-					    NodeId, 0, TCHAR_TO_ANSI(*UVAttributeName), &AttributeInfoVertex), false);
-
-				    HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
-					    UVs[UVLayerIndex], NodeId, 0, UVAttributeName, AttributeInfoVertex, true), false);
-			    }
-		    }
-
-		    //--------------------------------------------------------------------------------------------------------------------- 
-		    // NORMALS (N)
-		    //---------------------------------------------------------------------------------------------------------------------
-		    if (bIsVertexInstanceNormalsValid)
-		    {
-			    // Create attribute for normals.
-			    HAPI_AttributeInfo AttributeInfoVertex;
-			    FHoudiniApi::AttributeInfo_Init(&AttributeInfoVertex);
-
-			    AttributeInfoVertex.tupleSize = 3;
-			    AttributeInfoVertex.count = Normals.Num() / AttributeInfoVertex.tupleSize;
-			    AttributeInfoVertex.exists = true;
-			    AttributeInfoVertex.owner = HAPI_ATTROWNER_VERTEX;
-			    AttributeInfoVertex.storage = HAPI_STORAGETYPE_FLOAT;
-			    AttributeInfoVertex.originalOwner = HAPI_ATTROWNER_INVALID;
-
-			    HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
-				    FHoudiniEngine::Get().GetSession(),
-				    NodeId, 0, HAPI_UNREAL_ATTRIB_NORMAL, &AttributeInfoVertex), false);
-
-			    HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
-				    Normals, NodeId, 0, HAPI_UNREAL_ATTRIB_NORMAL, AttributeInfoVertex, true), false);
-		    }
-
-		    //--------------------------------------------------------------------------------------------------------------------- 
-		    // TANGENT (tangentu)
-		    //---------------------------------------------------------------------------------------------------------------------
-		    if (bIsVertexInstanceTangentsValid)
-		    {
-			    // Create attribute for tangentu.
-			    HAPI_AttributeInfo AttributeInfoVertex;
-			    FHoudiniApi::AttributeInfo_Init(&AttributeInfoVertex);
-
-			    AttributeInfoVertex.tupleSize = 3;
-			    AttributeInfoVertex.count = Tangents.Num() / AttributeInfoVertex.tupleSize;
-			    AttributeInfoVertex.exists = true;
-			    AttributeInfoVertex.owner = HAPI_ATTROWNER_VERTEX;
-			    AttributeInfoVertex.storage = HAPI_STORAGETYPE_FLOAT;
-			    AttributeInfoVertex.originalOwner = HAPI_ATTROWNER_INVALID;
-
-			    HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
-				    FHoudiniEngine::Get().GetSession(),
-				    NodeId, 0, HAPI_UNREAL_ATTRIB_TANGENTU, &AttributeInfoVertex), false);
-
-			    HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
-				    Tangents, NodeId, 0, HAPI_UNREAL_ATTRIB_TANGENTU, AttributeInfoVertex), false);
-		    }
-
-		    //--------------------------------------------------------------------------------------------------------------------- 
-		    // BINORMAL (tangentv)
-		    //---------------------------------------------------------------------------------------------------------------------
-		    if (bIsVertexInstanceBinormalSignsValid)
-		    {
-			    // Create attribute for normals.
-			    HAPI_AttributeInfo AttributeInfoVertex;
-			    FHoudiniApi::AttributeInfo_Init(&AttributeInfoVertex);
-
-			    AttributeInfoVertex.tupleSize = 3;
-			    AttributeInfoVertex.count = Binormals.Num() / AttributeInfoVertex.tupleSize;
-			    AttributeInfoVertex.exists = true;
-			    AttributeInfoVertex.owner = HAPI_ATTROWNER_VERTEX;
-			    AttributeInfoVertex.storage = HAPI_STORAGETYPE_FLOAT;
-			    AttributeInfoVertex.originalOwner = HAPI_ATTROWNER_INVALID;
-
-			    HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
-				    FHoudiniEngine::Get().GetSession(),
-				    NodeId, 0, HAPI_UNREAL_ATTRIB_TANGENTV, &AttributeInfoVertex), false);
-
-			    HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
-				    Binormals, NodeId, 0, HAPI_UNREAL_ATTRIB_TANGENTV, AttributeInfoVertex), false);
-		    }
-
-		    //--------------------------------------------------------------------------------------------------------------------- 
-		    // COLORS (Cd)
-		    //---------------------------------------------------------------------------------------------------------------------
-		    if (bUseComponentOverrideColors || bIsVertexInstanceColorsValid)
-		    {
-			    // Create attribute for colors.
-			    HAPI_AttributeInfo AttributeInfoVertex;
-			    FHoudiniApi::AttributeInfo_Init(&AttributeInfoVertex);
-
-			    AttributeInfoVertex.tupleSize = 3;
-			    AttributeInfoVertex.count = RGBColors.Num() / AttributeInfoVertex.tupleSize;
-			    AttributeInfoVertex.exists = true;
-			    AttributeInfoVertex.owner = HAPI_ATTROWNER_VERTEX;
-			    AttributeInfoVertex.storage = HAPI_STORAGETYPE_FLOAT;
-			    AttributeInfoVertex.originalOwner = HAPI_ATTROWNER_INVALID;
-
-			    HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
-				    FHoudiniEngine::Get().GetSession(),
-				    NodeId, 0, HAPI_UNREAL_ATTRIB_COLOR, &AttributeInfoVertex), false);
-
-			    HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
-				    RGBColors, NodeId, 0, HAPI_UNREAL_ATTRIB_COLOR, AttributeInfoVertex, true), false);
-
-			    FHoudiniApi::AttributeInfo_Init(&AttributeInfoVertex);
-			    AttributeInfoVertex.tupleSize = 1;
-			    AttributeInfoVertex.count = Alphas.Num();
-			    AttributeInfoVertex.exists = true;
-			    AttributeInfoVertex.owner = HAPI_ATTROWNER_VERTEX;
-			    AttributeInfoVertex.storage = HAPI_STORAGETYPE_FLOAT;
-			    AttributeInfoVertex.originalOwner = HAPI_ATTROWNER_INVALID;
-
-			    HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
-				    FHoudiniEngine::Get().GetSession(),
-				    NodeId, 0, HAPI_UNREAL_ATTRIB_ALPHA, &AttributeInfoVertex), false);
-
-			    HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeFloatData(
-				    Alphas, NodeId, 0, HAPI_UNREAL_ATTRIB_ALPHA, AttributeInfoVertex, true), false);
-		    }
+			FHoudiniMeshAttributeUpload& MaterialUpload = Uploads.AddDefaulted_GetRef();
+			MaterialUpload.Upload = [&]()
+			{
+				// List of materials, one for each face.
+				FHoudiniEngineIndexedStringMap TriangleMaterials;
 
-		    //--------------------------------------------------------------------------------------------------------------------- 
-		    // TRIANGLE/FACE VERTEX INDICES
-		    //---------------------------------------------------------------------------------------------------------------------
-		    // We can now set vertex list.
-		    HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetVertexList(
-			    MeshTriangleVertexIndices, NodeId, 0), false);
+				//Lists of material parameters
+				TMap<FString, TArray<float>> ScalarMaterialParameters;
+				TMap<FString, TArray<float>> VectorMaterialParameters;
+				TMap<FString, FHoudiniEngineIndexedStringMap> TextureMaterialParameters;
 
-		    // Send the array of face vertex counts.
-		    TArray<int32> StaticMeshFaceCounts;
-		    StaticMeshFaceCounts.SetNumUninitialized(Part.faceCount);
-		    for (int32 n = 0; n < Part.faceCount; n++)
-			    StaticMeshFaceCounts[n] = 3;
+				if (bInExportMaterialParametersAsAttributes)
+				{
+					// Create attributes for the material and all its parameters
+					// Get material attribute data, and all material parameters data
+					FUnrealMeshTranslator::CreateFaceMaterialArray(
+						MaterialInterfaces, Buffers.FaceMaterialIndices, TriangleMaterials,
+						ScalarMaterialParameters, VectorMaterialParameters, TextureMaterialParameters);
+				}
+				else
+				{
+					// Create attributes only for the materials
+					// Only get the material attribute data
+					FUnrealMeshTranslator::CreateFaceMaterialArray(
+						MaterialInterfaces, Buffers.FaceMaterialIndices, TriangleMaterials);
+				}
 
-		    HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetFaceCounts(
-			    StaticMeshFaceCounts, NodeId, 0), false);
+				// Create all the needed attributes for materials
+				return FUnrealMeshTranslator::CreateHoudiniMeshAttributes(
+					NodeId,
+					0,
+					TriangleMaterials.GetIds().Num(),
+					TriangleMaterials,
+					ScalarMaterialParameters,
+					VectorMaterialParameters,
+					TextureMaterialParameters,
+					PhysicalMaterialPath,
+					StaticMesh->NaniteSettings);
+			};
+		}
 
-		    // Send material assignments to Houdini
-		    if (NumMaterials > 0)
-		    {
-			    // List of materials, one for each face.
-			    FHoudiniEngineIndexedStringMap TriangleMaterials;
+		//--------------------------------------------------------------------------------------------------------------------- 
+		// TRIANGLE SMOOTHING MASKS
+		//---------------------------------------------------------------------------------------------------------------------
+		FHoudiniMeshAttributeUpload& SmoothingMaskUpload = Uploads.AddDefaulted_GetRef();
+		SmoothingMaskUpload.Fill = [&]()
+		{
+			FHoudiniMeshMarshalling::FillMeshDescriptionSmoothingMasks(MeshDescription, Buffers);
+		};
+		SmoothingMaskUpload.Upload = [&]()
+		{
+			if (Buffers.FaceSmoothingMasks.Num() <= 0)
+				return true;
 
-			    //Lists of material parameters
-			    TMap<FString, TArray<float>> ScalarMaterialParameters;
-			    TMap<FString, TArray<float>> VectorMaterialParameters;
-                TMap<FString, FHoudiniEngineIndexedStringMap> TextureMaterialParameters;
+			HAPI_AttributeInfo AttributeInfoSmoothingMasks;
+			FHoudiniApi::AttributeInfo_Init(&AttributeInfoSmoothingMasks);
 
-			    bool bAttributeSuccess = false;
-			    if (bInExportMaterialParametersAsAttributes)
-			    {
-				    // Create attributes for the material and all its parameters
-				    // Get material attribute data, and all material parameters data
-				    FUnrealMeshTranslator::CreateFaceMaterialArray(
-					    MaterialInterfaces, TriangleMaterialIndices, TriangleMaterials,
-					    ScalarMaterialParameters, VectorMaterialParameters, TextureMaterialParameters);
-			    }
-			    else
-			    {
-				    // Create attributes only for the materials
-				    // Only get the material attribute data
-				    FUnrealMeshTranslator::CreateFaceMaterialArray(
-					    MaterialInterfaces, TriangleMaterialIndices, TriangleMaterials);
-			    }
-
-			    // Create all the needed attributes for materials
-			    bAttributeSuccess = FUnrealMeshTranslator::CreateHoudiniMeshAttributes(
-				    NodeId,
-				    0,
-				    TriangleMaterials.GetIds().Num(),
-				    TriangleMaterials,
-				    ScalarMaterialParameters,
-				    VectorMaterialParameters,
-				    TextureMaterialParameters,
-				    PhysicalMaterialPath,
-					StaticMesh->NaniteSettings);
+			AttributeInfoSmoothingMasks.tupleSize = 1;
+			AttributeInfoSmoothingMasks.count = Buffers.FaceSmoothingMasks.Num();
+			AttributeInfoSmoothingMasks.exists = true;
+			AttributeInfoSmoothingMasks.owner = HAPI_ATTROWNER_PRIM;
+			AttributeInfoSmoothingMasks.storage = HAPI_STORAGETYPE_INT;
+			AttributeInfoSmoothingMasks.originalOwner = HAPI_ATTROWNER_INVALID;
 
-			    if (!bAttributeSuccess)
-			    {
-				    return false;
-			    }
-		    }
+			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
+				FHoudiniEngine::Get().GetSession(),
+				NodeId, 0, HAPI_UNREAL_ATTRIB_FACE_SMOOTHING_MASK, &AttributeInfoSmoothingMasks), false);
 
-		    //--------------------------------------------------------------------------------------------------------------------- 
-		    // TRIANGLE SMOOTHING MASKS
-		    //---------------------------------------------------------------------------------------------------------------------
-		    TArray<int32> TriangleSmoothingMasks;
-		    TriangleSmoothingMasks.SetNumZeroed(NumTriangles);
-		    {
-			    // Convert uint32 smoothing mask to int
-			    TArray<uint32> UnsignedSmoothingMasks;
-			    UnsignedSmoothingMasks.SetNumZeroed(NumTriangles);
-			    FStaticMeshOperations::ConvertHardEdgesToSmoothGroup(MeshDescription, UnsignedSmoothingMasks);
-			    for (int32 n = 0; n < TriangleSmoothingMasks.Num(); n++)
-				    TriangleSmoothingMasks[n] = (int32)UnsignedSmoothingMasks[n];
-		    }
+			HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeIntData(
+				Buffers.FaceSmoothingMasks, NodeId, 0, HAPI_UNREAL_ATTRIB_FACE_SMOOTHING_MASK, AttributeInfoSmoothingMasks, true), false);
+			return true;
+		};
+	}
 
-		    if (TriangleSmoothingMasks.Num() > 0)
-		    {
-			    HAPI_AttributeInfo AttributeInfoSmoothingMasks;
-			    FHoudiniApi::AttributeInfo_Init(&AttributeInfoSmoothingMasks);
-
-			    AttributeInfoSmoothingMasks.tupleSize = 1;
-			    AttributeInfoSmoothingMasks.count = TriangleSmoothingMasks.Num();
-			    AttributeInfoSmoothingMasks.exists = true;
-			    AttributeInfoSmoothingMasks.owner = HAPI_ATTROWNER_PRIM;
-			    AttributeInfoSmoothingMasks.storage = HAPI_STORAGETYPE_INT;
-			    AttributeInfoSmoothingMasks.originalOwner = HAPI_ATTROWNER_INVALID;
-
-			    HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::AddAttribute(
-				    FHoudiniEngine::Get().GetSession(),
-				    NodeId, 0, HAPI_UNREAL_ATTRIB_FACE_SMOOTHING_MASK, &AttributeInfoSmoothingMasks), false);
-
-			    HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetAttributeIntData(
-				    TriangleSmoothingMasks, NodeId, 0, HAPI_UNREAL_ATTRIB_FACE_SMOOTHING_MASK, AttributeInfoSmoothingMasks, true), false);
-		    }
-		}
+	{
+		SCOPED_FUNCTION_LABELLED_TIMER("Transfering Data");
+		if (!FHoudiniMeshMarshalling::RunUploads(Uploads, bParallelMarshalling))
+			return false;
 	}
 
 	//--------------------------------------------------------------------------------------------------------------------- 
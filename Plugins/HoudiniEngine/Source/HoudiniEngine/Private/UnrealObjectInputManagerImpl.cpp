@@ -31,6 +31,7 @@
 #include "HoudiniEngine.h"
 #include "HoudiniEngineUtils.h"
 #include "UnrealObjectInputRuntimeTypes.h"
+#include "UnrealLandscapeTranslator.h"
 
 FUnrealObjectInputManagerImpl::FUnrealObjectInputManagerImpl()
 	: WorldOriginNodeId(-1)
@@ -618,6 +619,7 @@ FUnrealObjectInputManagerImpl::RemoveRef(const FUnrealObjectInputIdentifier& InI
 	if (Node->IsRefCounted() && Node->GetRefCount() == 0 && Node->CanBeDeleted())
 	{
 		// Destroy HAPI nodes
+		FUnrealLandscapeTranslator::RemoveLandscapeRegionExport(Node->GetNodeId());
 		if (Node->AreHAPINodesValid())
 		{
 			// if (FHoudiniApi::DeleteNode(FHoudiniEngine::Get().GetSession(), Node->GetNodeId()) != HAPI_RESULT_SUCCESS)
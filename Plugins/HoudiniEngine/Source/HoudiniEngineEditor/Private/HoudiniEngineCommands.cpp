@@ -37,6 +37,7 @@
 #include "HoudiniAssetActor.h"
 #include "HoudiniAssetComponent.h"
 #include "HoudiniOutputTranslator.h"
+#include "HoudiniMeshTranslator.h"
 #include "HoudiniStaticMesh.h"
 #include "HoudiniOutput.h"
 #include "HoudiniEngineStyle.h"
@@ -64,6 +65,12 @@
 
 #define LOCTEXT_NAMESPACE HOUDINI_LOCTEXT_NAMESPACE 
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineRefineSaveBatchSize(
+	TEXT("HoudiniEngine.RefineSaveBatchSize"),
+	64,
+	TEXT("Number of static mesh packages saved at once after refining proxy meshes on save.\n")
+);
+
 FDelegateHandle FHoudiniEngineCommands::OnPostSaveWorldRefineProxyMeshesHandle = FDelegateHandle();
 FHoudiniEngineCommands::FOnHoudiniProxyMeshesRefinedDelegate FHoudiniEngineCommands::OnHoudiniProxyMeshesRefinedDelegate = FHoudiniEngineCommands::FOnHoudiniProxyMeshesRefinedDelegate();
 
@@ -1652,14 +1659,18 @@ FHoudiniEngineCommands::RefineTriagedHoudiniProxyMesehesToStaticMeshes(
 		if (!bInSilent)
 			TaskProgress->MakeDialog(/*bShowCancelButton=*/true);
 
-		// Iterate over the components for which we can build UStaticMesh, and build the meshes
+		// Iterate over the components for which we can build UStaticMesh, and build the meshes.
+		// The static meshes are only created here, they are all built in one batch once every component was processed.
 		bool bCancelled = false;
+		FHoudiniMeshTranslator::BeginDeferredStaticMeshBuilds();
 		for (uint32 ComponentIndex = 0; ComponentIndex < NumComponentsToRefine; ++ComponentIndex)
 		{
 			UHoudiniAssetComponent* HoudiniAssetComponent = InComponentsToRefine[ComponentIndex];
 			TaskProgress->EnterProgressFrame(1.0f);
+			const double RefineStart = FPlatformTime::Seconds();
 			const bool bDestroyProxies = true;
 			FHoudiniOutputTranslator::BuildStaticMeshesOnHoudiniProxyMeshOutputs(HoudiniAssetComponent, bDestroyProxies);
+			HOUDINI_LOG_MESSAGE(TEXT("Created the static meshes of %s in %f seconds."), *(HoudiniAssetComponent->GetPathName()), FPlatformTime::Seconds() - RefineStart);
 
 			SuccessfulComponents.Add(HoudiniAssetComponent);
 
@@ -1668,7 +1679,7 @@ FHoudiniEngineCommands::RefineTriagedHoudiniProxyMesehesToStaticMeshes(
 			{
 				for (uint32 SkippedIndex = ComponentIndex + 1; SkippedIndex < NumComponentsToRefine; ++SkippedIndex)
 				{
-					SkippedComponents.Add(InComponentsToRefine[ComponentIndex]);
+					SkippedComponents.Add(InComponentsToRefine[SkippedIndex]);
 				}
 				break;
 			}
@@ -1684,6 +1695,8 @@ FHoudiniEngineCommands::RefineTriagedHoudiniProxyMesehesToStaticMeshes(
 		
 		if (NumComponentsToCook > 0 && !bCancelled)
 		{
+			// The deferred build stays open while the components cook: the static meshes created by the cooks
+			// are queued as well, and built with the refined ones once the background thread is done waiting.
 			// Now use an async task to check on the progress of the cooking components
 			Async(EAsyncExecution::Thread, [InComponentsToCook, TaskProgress, NumComponentsToProcess, bInOnPreSaveWorld, InOnPreSaveWorld, SuccessfulComponents, FailedComponents, SkippedComponents]() {
 				RefineHoudiniProxyMeshesToStaticMeshesWithCookInBackgroundThread(
@@ -1695,6 +1708,9 @@ FHoudiniEngineCommands::RefineTriagedHoudiniProxyMesehesToStaticMeshes(
 		}
 		else
 		{
+			// The meshes of the components that were refined before a cancellation are still built
+			FHoudiniMeshTranslator::EndDeferredStaticMeshBuilds();
+
 			RefineHoudiniProxyMeshesToStaticMeshesNotifyDone(
 				NumComponentsToProcess, TaskProgress.Get(), bCancelled, bInOnPreSaveWorld, InOnPreSaveWorld, SuccessfulComponents, FailedComponents, SkippedComponents);
 
@@ -1795,8 +1811,10 @@ FHoudiniEngineCommands::RefineHoudiniProxyMeshesToStaticMeshesWithCookInBackgrou
 		}
 	}
 
-	// Cooking is done, or failed, display the notifications on the main thread
+	// Cooking is done, or failed, build the queued static meshes and display the notifications on the main thread
 	Async(EAsyncExecution::TaskGraphMainThread, [InNumComponentsToProcess, InTaskProgress, bCancelled, bInOnPreSaveWorld, InOnPreSaveWorld, SuccessfulComponents, FailedComponents, SkippedComponents]() {
+		// Closes the deferred build opened in RefineHoudiniProxyMeshesToStaticMeshes()
+		FHoudiniMeshTranslator::EndDeferredStaticMeshBuilds();
 		RefineHoudiniProxyMeshesToStaticMeshesNotifyDone(InNumComponentsToProcess, InTaskProgress.Get(), bCancelled, bInOnPreSaveWorld, InOnPreSaveWorld, SuccessfulComponents, FailedComponents, SkippedComponents);
 	});
 }
@@ -1916,13 +1934,28 @@ FHoudiniEngineCommands::RefineProxyMeshesHandleOnPostSaveWorld(const TArray<UHou
 
 				if (Package->IsDirty() && Package->IsFullyLoaded() && Package != GetTransientPackage())
 				{
-					PackagesToSave.Add(Package);
+					PackagesToSave.AddUnique(Package);
 				}
 			}
 		}
 	}
 
-	UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
+	// Save the packages in batches so that the progress can be reported, and the editor stays responsive
+	const int32 BatchSize = FMath::Max(1, CVarHoudiniEngineRefineSaveBatchSize.GetValueOnGameThread());
+	const int32 NumBatches = FMath::DivideAndRoundUp(PackagesToSave.Num(), BatchSize);
+	FScopedSlowTask SaveProgress((float)NumBatches, FText::FromString(TEXT("Saving refined static meshes...")));
+	const double SaveStart = FPlatformTime::Seconds();
+	for (int32 BatchStart = 0; BatchStart < PackagesToSave.Num(); BatchStart += BatchSize)
+	{
+		SaveProgress.EnterProgressFrame(1.0f);
+		const double BatchTime = FPlatformTime::Seconds();
+		const TArray<UPackage*> Batch(PackagesToSave.GetData() + BatchStart, FMath::Min(BatchSize, PackagesToSave.Num() - BatchStart));
+		UEditorLoadingAndSavingUtils::SavePackages(Batch, true);
+		HOUDINI_LOG_MESSAGE(TEXT("Saved %d refined static mesh packages in %f seconds."), Batch.Num(), FPlatformTime::Seconds() - BatchTime);
+	}
+
+	if (NumBatches > 1)
+		HOUDINI_LOG_MESSAGE(TEXT("Saved %d refined static mesh packages in %f seconds."), PackagesToSave.Num(), FPlatformTime::Seconds() - SaveStart);
 }
 
 void
@@ -4712,6 +4712,55 @@ FHoudiniInputDetails::AddLandscapeInputUI(TSharedRef<SVerticalBox> VerticalBox,
 		CheckBoxAutoSelectComponents->SetEnabled(bEnable);
 	}
 
+	// Checkbox: export the region of interest only
+	if (MainInput->LandscapeExportType == EHoudiniLandscapeExportType::Heightfield)
+	{
+		Landscape_VerticalBox->AddSlot().Padding(ItemPadding).AutoHeight()
+		[
+			SNew(SCheckBox)
+			.Content()
+			[
+				SNew(STextBlock)
+				.Text(LOCTEXT("LandscapeRegionOfInterestCheckbox", "Export Region Of Interest Only"))
+				.ToolTipText(LOCTEXT("LandscapeRegionOfInterestTooltip", "If enabled, only the Landscape Components within the asset's bounding box are exported, and only the components that changed are sent again. Overrides the component selection."))
+				.Font(_GetEditorStyle().GetFontStyle(TEXT("PropertyWindow.NormalFont")))
+			]
+			.IsChecked_Lambda([MainInput]()
+			{
+				if (!IsValidWeakPointer(MainInput))
+					return ECheckBoxState::Unchecked;
+
+				return MainInput->bLandscapeExportRegionOfInterest ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+			})
+			.OnCheckStateChanged_Lambda([InInputs, MainInput](ECheckBoxState NewState)
+			{
+				if (!IsValidWeakPointer(MainInput))
+					return;
+
+				// Record a transaction for undo/redo
+				FScopedTransaction Transaction(
+					TEXT(HOUDINI_MODULE_EDITOR),
+					LOCTEXT("HoudiniLandscapeInputChangeExportRegionOfInterest", "Houdini Input: Changing Landscape export region of interest only."),
+					MainInput->GetOuter());
+
+				for (auto CurrentInput : InInputs)
+				{
+					if (!IsValidWeakPointer(CurrentInput))
+						continue;
+
+					bool bNewState = (NewState == ECheckBoxState::Checked);
+					if (bNewState == CurrentInput->bLandscapeExportRegionOfInterest)
+						continue;
+
+					CurrentInput->Modify();
+					CurrentInput->bLandscapeExportRegionOfInterest = bNewState;
+					CurrentInput->MarkAllInputObjectsChanged(true);
+					CurrentInput->MarkChanged(true);
+				}
+			})
+		];
+	}
+
 	// -------------------------------------
 	// Landscape: Update component selection
 	// -------------------------------------
@@ -1119,6 +1119,8 @@ UHoudiniPublicAPILandscapeInput::UHoudiniPublicAPILandscapeInput()
 	: LandscapeExportType(EHoudiniLandscapeExportType::Heightfield)
 	, bLandscapeExportSelectionOnly(false)
 	, bLandscapeAutoSelectComponent(false)
+	, bLandscapeExportRegionOfInterest(false)
+	, LandscapeRegionOfInterest(ForceInit)
 	, bLandscapeExportMaterials(false)
 	, bLandscapeExportLighting(false)
 	, bLandscapeExportNormalizedUVs(false)
@@ -1136,6 +1138,8 @@ UHoudiniPublicAPILandscapeInput::PopulateFromHoudiniInput(UHoudiniInput const* c
 	LandscapeExportType = InInput->GetLandscapeExportType();
 	bLandscapeExportSelectionOnly = InInput->bLandscapeExportSelectionOnly;
 	bLandscapeAutoSelectComponent = InInput->bLandscapeAutoSelectComponent;
+	bLandscapeExportRegionOfInterest = InInput->bLandscapeExportRegionOfInterest;
+	LandscapeRegionOfInterest = InInput->LandscapeRegionOfInterest;
 	bLandscapeExportMaterials = InInput->bLandscapeExportMaterials;
 	bLandscapeExportLighting = InInput->bLandscapeExportLighting;
 	bLandscapeExportNormalizedUVs = InInput->bLandscapeExportNormalizedUVs;
@@ -1182,6 +1186,18 @@ UHoudiniPublicAPILandscapeInput::UpdateHoudiniInput(UHoudiniInput* const InInput
 		InInput->bLandscapeAutoSelectComponent = bLandscapeAutoSelectComponent;
 		bAnyChanges = true;
 	}
+
+	if (InInput->bLandscapeExportRegionOfInterest != bLandscapeExportRegionOfInterest)
+	{
+		InInput->bLandscapeExportRegionOfInterest = bLandscapeExportRegionOfInterest;
+		bAnyChanges = true;
+	}
+
+	if (!(InInput->LandscapeRegionOfInterest == LandscapeRegionOfInterest) || InInput->LandscapeRegionOfInterest.IsValid != LandscapeRegionOfInterest.IsValid)
+	{
+		InInput->LandscapeRegionOfInterest = LandscapeRegionOfInterest;
+		bAnyChanges = true;
+	}
 	
 	if (InInput->bLandscapeExportMaterials != bLandscapeExportMaterials)
 	{
@@ -437,6 +437,7 @@ bool FHoudiniEditorEquivalenceUtils::IsEquivalent(const UHoudiniInput* A, const
 	Result &= TestExpressionError(A->LandscapeExportType == B->LandscapeExportType, Header, "LandscapeExportType");
 	Result &= TestExpressionError(A->bLandscapeExportSelectionOnly == B->bLandscapeExportSelectionOnly, Header, "bLandscapeExportSelectionOnly");
 	Result &= TestExpressionError(A->bLandscapeAutoSelectComponent == B->bLandscapeAutoSelectComponent, Header, "bLandscapeAutoSelectComponent");
+	Result &= TestExpressionError(A->bLandscapeExportRegionOfInterest == B->bLandscapeExportRegionOfInterest, Header, "bLandscapeExportRegionOfInterest");
 	Result &= TestExpressionError(A->bLandscapeExportMaterials == B->bLandscapeExportMaterials, Header, "bLandscapeExportMaterials");
 	Result &= TestExpressionError(A->bLandscapeExportLighting == B->bLandscapeExportLighting, Header, "bLandscapeExportLighting");
 	Result &= TestExpressionError(A->bLandscapeExportNormalizedUVs == B->bLandscapeExportNormalizedUVs, Header, "bLandscapeExportNormalizedUVs");
@@ -642,6 +642,14 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Houdini Engine | Public API | Inputs")
 	bool bLandscapeAutoSelectComponent;
 
+	/** Is set to true when only the landscape components under the region of interest are exported as a heightfield. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Houdini Engine | Public API | Inputs")
+	bool bLandscapeExportRegionOfInterest;
+
+	/** World space region of interest for heightfield exports, the asset's bounds are used when invalid. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Houdini Engine | Public API | Inputs")
+	FBox LandscapeRegionOfInterest;
+
 	/** Is set to true when materials are to be exported. */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Houdini Engine | Public API | Inputs")
 	bool bLandscapeExportMaterials;
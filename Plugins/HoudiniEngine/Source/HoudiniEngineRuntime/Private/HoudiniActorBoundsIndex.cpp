@@ -0,0 +1,451 @@
+/*
+* Copyright (c) <2023> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniActorBoundsIndex.h"
+
+#include "HoudiniEngineRuntimePrivatePCH.h"
+
+#include "Components/ActorComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineDefines.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "UObject/UObjectGlobals.h"
+
+FHoudiniActorBoundsOctree::FHoudiniActorBoundsOctree()
+	: Octree(FVector::ZeroVector, HALF_WORLD_MAX)
+{
+}
+
+void
+FHoudiniActorBoundsOctree::UpdateActor(AActor* InActor, const FBox& InBounds)
+{
+	if (!InActor)
+		return;
+
+	const TObjectKey<AActor> ActorKey(InActor);
+	if (const FOctreeElementId2* FoundId = ElementIds.Find(ActorKey))
+	{
+		// Nothing to do if the actor hasn't moved
+		if (Octree.GetElementById(*FoundId).Bounds == InBounds)
+			return;
+
+		Octree.RemoveElement(*FoundId);
+		ElementIds.Remove(ActorKey);
+	}
+
+	// The octree can't place NaN bounds
+	if (InBounds.Min.ContainsNaN() || InBounds.Max.ContainsNaN())
+		return;
+
+	FHoudiniActorBoundsElement Element;
+	Element.Actor = InActor;
+	Element.ActorKey = ActorKey;
+	Element.Bounds = InBounds;
+	Element.ElementIds = &ElementIds;
+	Octree.AddElement(Element);
+}
+
+bool
+FHoudiniActorBoundsOctree::RemoveActor(const TObjectKey<AActor>& InActorKey)
+{
+	FOctreeElementId2 ElementId;
+	if (!ElementIds.RemoveAndCopyValue(InActorKey, ElementId))
+		return false;
+
+	Octree.RemoveElement(ElementId);
+	return true;
+}
+
+void
+FHoudiniActorBoundsOctree::Reset()
+{
+	Octree = TOctree2<FHoudiniActorBoundsElement, FHoudiniActorBoundsOctreeSemantics>(FVector::ZeroVector, HALF_WORLD_MAX);
+	ElementIds.Empty();
+}
+
+void
+FHoudiniActorBoundsOctree::FindActors(
+	const TArray<FBox>& InBounds,
+	TArray<AActor*>& OutActors,
+	TArray<TObjectKey<AActor>>& OutStaleActors) const
+{
+	TSet<AActor*> FoundActors;
+	for (const FBox& CurrentBounds : InBounds)
+	{
+		Octree.FindElementsWithBoundsTest(FBoxCenterAndExtent(CurrentBounds),
+			[&](const FHoudiniActorBoundsElement& Element)
+		{
+			// The octree's nodes are loose, do the same intersection test as a full scan of the actors
+			if (!Element.Bounds.Intersect(CurrentBounds))
+				return;
+
+			AActor* CurrentActor = Element.Actor.Get();
+			if (!CurrentActor)
+			{
+				OutStaleActors.AddUnique(Element.ActorKey);
+				return;
+			}
+
+			bool bAlreadyFound = false;
+			FoundActors.Add(CurrentActor, &bAlreadyFound);
+			if (!bAlreadyFound)
+				OutActors.Add(CurrentActor);
+		});
+	}
+}
+
+#if WITH_EDITOR
+
+// A scene component's transform updated handler
+struct FHoudiniTransformListener
+{
+	TWeakObjectPtr<USceneComponent> Component;
+	FDelegateHandle Handle;
+};
+
+// Indexed actor bounds of a world
+struct FHoudiniWorldActorBounds
+{
+	~FHoudiniWorldActorBounds() { StopListeningToTransforms(); }
+
+	void StopListeningToTransforms();
+
+	FHoudiniActorBoundsOctree Octree;
+
+	// Actors whose bounds have to be refreshed before the next query
+	TMap<TObjectKey<AActor>, TWeakObjectPtr<AActor>> DirtyActors;
+
+	// Scene components of the indexed actors, they only report the transforms set from code to their own listeners
+	TMap<TObjectKey<USceneComponent>, FHoudiniTransformListener> TransformListeners;
+
+	bool bNeedsRebuild = true;
+};
+
+void
+FHoudiniWorldActorBounds::StopListeningToTransforms()
+{
+	for (auto& Listener : TransformListeners)
+	{
+		if (USceneComponent* Component = Listener.Value.Component.Get())
+			Component->TransformUpdated.Remove(Listener.Value.Handle);
+	}
+
+	TransformListeners.Empty();
+}
+
+static TMap<TObjectKey<UWorld>, TUniquePtr<FHoudiniWorldActorBounds>> HoudiniIndexedWorlds;
+
+static bool bHoudiniActorBoundsHandlersRegistered = false;
+static FDelegateHandle HoudiniActorMovedHandle;
+static FDelegateHandle HoudiniActorMovingHandle;
+static FDelegateHandle HoudiniLevelActorAddedHandle;
+static FDelegateHandle HoudiniLevelActorDeletedHandle;
+static FDelegateHandle HoudiniLevelActorListChangedHandle;
+static FDelegateHandle HoudiniObjectPropertyChangedHandle;
+static FDelegateHandle HoudiniObjectTransactedHandle;
+static FDelegateHandle HoudiniLevelAddedToWorldHandle;
+static FDelegateHandle HoudiniLevelRemovedFromWorldHandle;
+static FDelegateHandle HoudiniWorldCleanupHandle;
+static FDelegateHandle HoudiniRenderStateDirtyHandle;
+
+static FHoudiniWorldActorBounds*
+FindWorldActorBounds(const UWorld* InWorld)
+{
+	if (!InWorld)
+		return nullptr;
+
+	TUniquePtr<FHoudiniWorldActorBounds>* FoundWorldBounds = HoudiniIndexedWorlds.Find(InWorld);
+	return FoundWorldBounds ? FoundWorldBounds->Get() : nullptr;
+}
+
+static void
+MarkActorBoundsDirty(AActor* InActor)
+{
+	if (!InActor || HoudiniIndexedWorlds.Num() <= 0)
+		return;
+
+	FHoudiniWorldActorBounds* WorldBounds = FindWorldActorBounds(InActor->GetWorld());
+	if (!WorldBounds)
+		return;
+
+	WorldBounds->DirtyActors.Add(InActor, InActor);
+
+	// Attached actors follow their parent without being moved themselves
+	TArray<AActor*> AttachedActors;
+	InActor->GetAttachedActors(AttachedActors, true, true);
+	for (AActor* AttachedActor : AttachedActors)
+	{
+		if (AttachedActor)
+			WorldBounds->DirtyActors.Add(AttachedActor, AttachedActor);
+	}
+}
+
+static void
+OnActorBoundsDeleted(AActor* InActor)
+{
+	if (!InActor)
+		return;
+
+	FHoudiniWorldActorBounds* WorldBounds = FindWorldActorBounds(InActor->GetWorld());
+	if (!WorldBounds)
+		return;
+
+	WorldBounds->DirtyActors.Remove(InActor);
+	WorldBounds->Octree.RemoveActor(InActor);
+
+	TInlineComponentArray<USceneComponent*> SceneComponents(InActor);
+	for (USceneComponent* SceneComponent : SceneComponents)
+	{
+		FHoudiniTransformListener Listener;
+		if (SceneComponent && WorldBounds->TransformListeners.RemoveAndCopyValue(SceneComponent, Listener))
+			SceneComponent->TransformUpdated.Remove(Listener.Handle);
+	}
+}
+
+static void
+OnObjectBoundsChanged(UObject* InObject)
+{
+	if (HoudiniIndexedWorlds.Num() <= 0)
+		return;
+
+	// Changes to a component (mesh, transform...) can change its owner's bounds
+	AActor* Actor = Cast<AActor>(InObject);
+	if (!Actor)
+	{
+		UActorComponent* Component = Cast<UActorComponent>(InObject);
+		Actor = Component ? Component->GetOwner() : nullptr;
+	}
+
+	MarkActorBoundsDirty(Actor);
+}
+
+static void
+OnComponentRenderStateDirty(UActorComponent& InComponent)
+{
+	// Also broadcast for changes made from code (re-cooked outputs, SetStaticMesh...) that don't send editor events.
+	// This is called often, only flag the owner: its attached actors' bounds don't depend on its components.
+	if (HoudiniIndexedWorlds.Num() <= 0 || !IsInGameThread())
+		return;
+
+	AActor* Actor = InComponent.GetOwner();
+	if (!Actor)
+		return;
+
+	FHoudiniWorldActorBounds* WorldBounds = FindWorldActorBounds(Actor->GetWorld());
+	if (WorldBounds)
+		WorldBounds->DirtyActors.Add(Actor, Actor);
+}
+
+static void
+OnComponentTransformUpdated(USceneComponent* InComponent, EUpdateTransformFlags InUpdateTransformFlags, ETeleportType InTeleport)
+{
+	// SetActorLocation() and the like only dirty the render transform, which doesn't broadcast any global event.
+	// Attached actors are flagged by their own components' updates.
+	if (!InComponent || HoudiniIndexedWorlds.Num() <= 0 || !IsInGameThread())
+		return;
+
+	AActor* Actor = InComponent->GetOwner();
+	if (!Actor)
+		return;
+
+	FHoudiniWorldActorBounds* WorldBounds = FindWorldActorBounds(Actor->GetWorld());
+	if (WorldBounds)
+		WorldBounds->DirtyActors.Add(Actor, Actor);
+}
+
+static void
+ListenToActorTransforms(FHoudiniWorldActorBounds& InWorldBounds, AActor* InActor)
+{
+	TInlineComponentArray<USceneComponent*> SceneComponents(InActor);
+	for (USceneComponent* SceneComponent : SceneComponents)
+	{
+		if (!SceneComponent || InWorldBounds.TransformListeners.Contains(SceneComponent))
+			continue;
+
+		FHoudiniTransformListener& Listener = InWorldBounds.TransformListeners.Add(SceneComponent);
+		Listener.Component = SceneComponent;
+		Listener.Handle = SceneComponent->TransformUpdated.AddStatic(&OnComponentTransformUpdated);
+	}
+}
+
+static void
+OnLevelActorListChanged()
+{
+	for (auto& WorldBounds : HoudiniIndexedWorlds)
+		WorldBounds.Value->bNeedsRebuild = true;
+}
+
+static void
+OnLevelChanged(ULevel* InLevel, UWorld* InWorld)
+{
+	if (FHoudiniWorldActorBounds* WorldBounds = FindWorldActorBounds(InWorld))
+		WorldBounds->bNeedsRebuild = true;
+}
+
+static void
+OnWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources)
+{
+	HoudiniIndexedWorlds.Remove(InWorld);
+}
+
+static void
+RegisterActorBoundsHandlers()
+{
+	if (bHoudiniActorBoundsHandlersRegistered || !GEngine)
+		return;
+
+	HoudiniActorMovedHandle = GEngine->OnActorMoved().AddStatic(&MarkActorBoundsDirty);
+	HoudiniActorMovingHandle = GEngine->OnActorMoving().AddStatic(&MarkActorBoundsDirty);
+	HoudiniLevelActorAddedHandle = GEngine->OnLevelActorAdded().AddStatic(&MarkActorBoundsDirty);
+	HoudiniLevelActorDeletedHandle = GEngine->OnLevelActorDeleted().AddStatic(&OnActorBoundsDeleted);
+	HoudiniLevelActorListChangedHandle = GEngine->OnLevelActorListChanged().AddStatic(&OnLevelActorListChanged);
+	HoudiniObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda(
+		[](UObject* InObject, FPropertyChangedEvent& InEvent) { OnObjectBoundsChanged(InObject); });
+	HoudiniObjectTransactedHandle = FCoreUObjectDelegates::OnObjectTransacted.AddLambda(
+		[](UObject* InObject, const FTransactionObjectEvent& InEvent) { OnObjectBoundsChanged(InObject); });
+	HoudiniLevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddStatic(&OnLevelChanged);
+	HoudiniLevelRemovedFromWorldHandle = FWorldDelegates::LevelRemovedFromWorld.AddStatic(&OnLevelChanged);
+	HoudiniWorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&OnWorldCleanup);
+	HoudiniRenderStateDirtyHandle = UActorComponent::MarkRenderStateDirtyEvent.AddStatic(&OnComponentRenderStateDirty);
+
+	bHoudiniActorBoundsHandlersRegistered = true;
+}
+
+#endif
+
+bool
+FHoudiniActorBoundsIndex::FindActorsInBounds(UWorld* InWorld, const TArray<FBox>& InBounds, TArray<AActor*>& OutActors)
+{
+#if WITH_EDITOR
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniActorBoundsIndex::FindActorsInBounds);
+
+	// Only the editor worlds report the changes made to their actors
+	if (!IsValid(InWorld) || InWorld->WorldType != EWorldType::Editor || !GEngine)
+		return false;
+
+	RegisterActorBoundsHandlers();
+
+	TUniquePtr<FHoudiniWorldActorBounds>& WorldBounds = HoudiniIndexedWorlds.FindOrAdd(InWorld);
+	if (!WorldBounds.IsValid())
+		WorldBounds = MakeUnique<FHoudiniWorldActorBounds>();
+
+	if (WorldBounds->bNeedsRebuild)
+	{
+		WorldBounds->Octree.Reset();
+		WorldBounds->StopListeningToTransforms();
+		for (TActorIterator<AActor> ActorItr(InWorld); ActorItr; ++ActorItr)
+		{
+			AActor* CurrentActor = *ActorItr;
+			if (!IsValid(CurrentActor))
+				continue;
+
+			WorldBounds->Octree.UpdateActor(CurrentActor, CurrentActor->GetComponentsBoundingBox(true));
+			ListenToActorTransforms(*WorldBounds, CurrentActor);
+		}
+
+		WorldBounds->DirtyActors.Empty();
+		WorldBounds->bNeedsRebuild = false;
+	}
+	else
+	{
+		for (auto& DirtyActor : WorldBounds->DirtyActors)
+		{
+			AActor* CurrentActor = DirtyActor.Value.Get();
+			if (IsValid(CurrentActor) && CurrentActor->GetWorld() == InWorld)
+			{
+				// Components can have been added since the actor was indexed
+				WorldBounds->Octree.UpdateActor(CurrentActor, CurrentActor->GetComponentsBoundingBox(true));
+				ListenToActorTransforms(*WorldBounds, CurrentActor);
+			}
+			else
+			{
+				WorldBounds->Octree.RemoveActor(DirtyActor.Key);
+			}
+		}
+
+		WorldBounds->DirtyActors.Reset();
+	}
+
+	TArray<AActor*> CandidateActors;
+	TArray<TObjectKey<AActor>> StaleActors;
+	WorldBounds->Octree.FindActors(InBounds, CandidateActors, StaleActors);
+	for (const TObjectKey<AActor>& StaleActor : StaleActors)
+		WorldBounds->Octree.RemoveActor(StaleActor);
+
+	// Not every bounds change is reported (mesh bounds changed from code...), so check the candidates against
+	// their current bounds: this only costs a bounds update for the actors found, not for the whole world.
+	for (AActor* CurrentActor : CandidateActors)
+	{
+		const FBox CurrentActorBounds = CurrentActor->GetComponentsBoundingBox(true);
+		WorldBounds->Octree.UpdateActor(CurrentActor, CurrentActorBounds);
+
+		for (const FBox& CurrentBounds : InBounds)
+		{
+			if (CurrentActorBounds.Intersect(CurrentBounds))
+			{
+				OutActors.Add(CurrentActor);
+				break;
+			}
+		}
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void
+FHoudiniActorBoundsIndex::Shutdown()
+{
+#if WITH_EDITOR
+	if (bHoudiniActorBoundsHandlersRegistered)
+	{
+		if (GEngine)
+		{
+			GEngine->OnActorMoved().Remove(HoudiniActorMovedHandle);
+			GEngine->OnActorMoving().Remove(HoudiniActorMovingHandle);
+			GEngine->OnLevelActorAdded().Remove(HoudiniLevelActorAddedHandle);
+			GEngine->OnLevelActorDeleted().Remove(HoudiniLevelActorDeletedHandle);
+			GEngine->OnLevelActorListChanged().Remove(HoudiniLevelActorListChangedHandle);
+		}
+
+		FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(HoudiniObjectPropertyChangedHandle);
+		FCoreUObjectDelegates::OnObjectTransacted.Remove(HoudiniObjectTransactedHandle);
+		FWorldDelegates::LevelAddedToWorld.Remove(HoudiniLevelAddedToWorldHandle);
+		FWorldDelegates::LevelRemovedFromWorld.Remove(HoudiniLevelRemovedFromWorldHandle);
+		FWorldDelegates::OnWorldCleanup.Remove(HoudiniWorldCleanupHandle);
+		UActorComponent::MarkRenderStateDirtyEvent.Remove(HoudiniRenderStateDirtyHandle);
+
+		bHoudiniActorBoundsHandlersRegistered = false;
+	}
+
+	HoudiniIndexedWorlds.Empty();
+#endif
+}
@@ -0,0 +1,124 @@
+/*
+* Copyright (c) <2023> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/GenericOctree.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class AActor;
+class UWorld;
+
+typedef TMap<TObjectKey<AActor>, FOctreeElementId2> FHoudiniActorBoundsElementIdMap;
+
+struct FHoudiniActorBoundsElement
+{
+	TWeakObjectPtr<AActor> Actor;
+	TObjectKey<AActor> ActorKey;
+	FBox Bounds = FBox(ForceInit);
+
+	// Map of the octree that owns this element, kept up to date by the octree semantics
+	FHoudiniActorBoundsElementIdMap* ElementIds = nullptr;
+};
+
+struct FHoudiniActorBoundsOctreeSemantics
+{
+	enum { MaxElementsPerLeaf = 16 };
+	enum { MinInclusiveElementsPerNode = 7 };
+	enum { MaxNodeDepth = 12 };
+
+	typedef TInlineAllocator<MaxElementsPerLeaf> ElementAllocator;
+
+	FORCEINLINE static FBoxCenterAndExtent GetBoundingBox(const FHoudiniActorBoundsElement& Element)
+	{
+		return FBoxCenterAndExtent(Element.Bounds);
+	}
+
+	FORCEINLINE static bool AreElementsEqual(const FHoudiniActorBoundsElement& A, const FHoudiniActorBoundsElement& B)
+	{
+		return A.ActorKey == B.ActorKey;
+	}
+
+	FORCEINLINE static void SetElementId(const FHoudiniActorBoundsElement& Element, FOctreeElementId2 Id)
+	{
+		if (Element.ElementIds)
+			Element.ElementIds->Add(Element.ActorKey, Id);
+	}
+};
+
+// Loose octree of actor bounds, keyed by actor.
+class FHoudiniActorBoundsOctree
+{
+	public:
+
+		FHoudiniActorBoundsOctree();
+		FHoudiniActorBoundsOctree(const FHoudiniActorBoundsOctree&) = delete;
+		FHoudiniActorBoundsOctree& operator=(const FHoudiniActorBoundsOctree&) = delete;
+
+		// Adds the actor, or moves it if its bounds have changed.
+		void UpdateActor(AActor* InActor, const FBox& InBounds);
+
+		// Returns false if the actor wasn't in the octree.
+		bool RemoveActor(const TObjectKey<AActor>& InActorKey);
+
+		bool ContainsActor(const TObjectKey<AActor>& InActorKey) const { return ElementIds.Contains(InActorKey); };
+
+		int32 Num() const { return ElementIds.Num(); };
+
+		void Reset();
+
+		// Appends the actors whose bounds intersect at least one of the boxes, each actor only once.
+		// Actors that have been garbage collected are added to OutStaleActors instead.
+		void FindActors(
+			const TArray<FBox>& InBounds,
+			TArray<AActor*>& OutActors,
+			TArray<TObjectKey<AActor>>& OutStaleActors) const;
+
+	private:
+
+		TOctree2<FHoudiniActorBoundsElement, FHoudiniActorBoundsOctreeSemantics> Octree;
+
+		FHoudiniActorBoundsElementIdMap ElementIds;
+};
+
+// Actor bounds of the editor worlds, used by world inputs' bound selectors.
+// Each world is indexed on its first query, then updated from the editor's actor
+// add/move/delete/property change events and from its components' render state and transform changes instead
+// of iterating on all of its actors. The actors found are checked against their current bounds.
+class FHoudiniActorBoundsIndex
+{
+	public:
+
+		// Finds the actors of the world whose bounds intersect at least one of the boxes.
+		// Returns false if the world can't be indexed (not an editor world), the caller should then
+		// iterate on the world's actors.
+		static bool FindActorsInBounds(UWorld* InWorld, const TArray<FBox>& InBounds, TArray<AActor*>& OutActors);
+
+		// Unregisters the event handlers and releases all the indexed worlds.
+		static void Shutdown();
+};
@@ -1670,6 +1670,7 @@ UHoudiniAssetBlueprintComponent::ApplyComponentInstanceData(FHoudiniAssetBluepri
 		bHasRegisteredComponentTemplate = InstanceData->bRegisteredComponentTemplate;
 
 		AssetState = InstanceData->AssetState;
+		MarkAsActive();
 		
 		SetCanDeleteHoudiniNodes(false);
 
@@ -1419,6 +1419,15 @@ UHoudiniAssetComponent::MarkAsNeedCook()
 
 	// Clear the static mesh bake timer
 	ClearRefineMeshesTimer();
+
+	MarkAsActive();
+}
+
+void
+UHoudiniAssetComponent::MarkAsActive()
+{
+	if (FHoudiniEngineRuntime::IsInitialized())
+		FHoudiniEngineRuntime::Get().MarkHoudiniComponentActive(this);
 }
 
 void
@@ -2075,6 +2084,9 @@ UHoudiniAssetComponent::PostEditChangeProperty(FPropertyChangedEvent & PropertyC
 	if (!Property)
 		return;
 
+	// Any property change might need processing
+	MarkAsActive();
+
 	FName PropertyName = Property->GetFName();
 
 	// Changing the Houdini Asset?
@@ -2433,6 +2445,9 @@ UHoudiniAssetComponent::SetHasComponentTransformChanged(const bool& InHasChanged
 	{
 		bHasComponentTransformChanged = InHasChanged;
 		LastComponentTransform = GetComponentTransform();
+
+		if (InHasChanged)
+			MarkAsActive();
 	}
 }
 
@@ -3038,6 +3053,9 @@ UHoudiniAssetComponent::SetAssetState(EHoudiniAssetState InNewState)
 	const EHoudiniAssetState OldState = AssetState;
 	AssetState = InNewState;
 
+	// State changes (including cook completion) need to be processed by the manager
+	MarkAsActive();
+
 	HandleOnHoudiniAssetStateChange(this, OldState, InNewState);
 }
 
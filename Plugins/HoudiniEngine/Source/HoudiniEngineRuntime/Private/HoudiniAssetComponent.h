@@ -272,6 +272,8 @@ public:
 	void MarkAsNeedRebuild();
 	// Marks the asset as needing to be instantiated
 	void MarkAsNeedInstantiation();
+	// Lets the Houdini Engine Manager know this component needs to be processed
+	void MarkAsActive();
 	// The blueprint has been structurally modified
 	void MarkAsBlueprintStructureModified();
 	// The blueprint has been modified but not structurally changed.
@@ -29,6 +29,7 @@
 #include "HoudiniRuntimeSettings.h"
 
 #include "HoudiniAssetComponent.h"
+#include "HoudiniActorBoundsIndex.h"
 
 #include "Modules/ModuleManager.h"
 
@@ -72,6 +73,8 @@ void FHoudiniEngineRuntime::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FHoudiniActorBoundsIndex::Shutdown();
+
 	FHoudiniEngineRuntime::HoudiniEngineRuntimeInstance = nullptr;
 }
 
@@ -137,7 +140,7 @@ bool
 FHoudiniEngineRuntime::IsComponentRegistered(UHoudiniAssetComponent* HAC) const
 {
 	// No need for duplicates
-	if (HAC && RegisteredHoudiniComponents.Find(HAC) != INDEX_NONE)
+	if (HAC && RegisteredHoudiniComponentSet.Contains(HAC))
 		return true;
 
 	return false;
@@ -168,10 +171,12 @@ FHoudiniEngineRuntime::RegisterHoudiniComponent(UHoudiniAssetComponent* HAC, boo
 	// Before adding, clean up the all ready registered
 	CleanUpRegisteredHoudiniComponents();
 
-	// Add the new component
+	// Add the new component, it needs to be processed at least once
 	{
 		FScopeLock ScopeLock(&CriticalSection);
 		RegisteredHoudiniComponents.Add(HAC);
+		RegisteredHoudiniComponentSet.Add(HAC);
+		ActiveHoudiniComponents.Add(HAC);
 	}
 
 	HAC->NotifyHoudiniRegisterCompleted();
@@ -236,10 +241,77 @@ FHoudiniEngineRuntime::UnRegisterHoudiniComponent(const int32& ValidIndex)
 		}
 	}
 	
+	ActiveHoudiniComponents.Remove(Ptr);
+	RegisteredHoudiniComponentSet.Remove(Ptr);
 	RegisteredHoudiniComponents.RemoveAt(ValidIndex);
 }
 
 
+void
+FHoudiniEngineRuntime::MarkHoudiniComponentActive(UHoudiniAssetComponent* HAC)
+{
+	if (!IsInitialized())
+		return;
+
+	if (!IsValid(HAC))
+		return;
+
+	FScopeLock ScopeLock(&CriticalSection);
+
+	// Only registered components can be processed
+	TWeakObjectPtr<UHoudiniAssetComponent> Ptr(HAC);
+	if (!RegisteredHoudiniComponentSet.Contains(Ptr))
+		return;
+
+	ActiveHoudiniComponents.Add(Ptr);
+}
+
+
+void
+FHoudiniEngineRuntime::MarkHoudiniComponentIdle(UHoudiniAssetComponent* HAC)
+{
+	if (!IsInitialized())
+		return;
+
+	FScopeLock ScopeLock(&CriticalSection);
+	ActiveHoudiniComponents.Remove(TWeakObjectPtr<UHoudiniAssetComponent>(HAC));
+}
+
+
+int32
+FHoudiniEngineRuntime::GetActiveHoudiniComponentCount()
+{
+	if (!IsInitialized())
+		return 0;
+
+	FScopeLock ScopeLock(&CriticalSection);
+	return ActiveHoudiniComponents.Num();
+}
+
+
+void
+FHoudiniEngineRuntime::GetActiveHoudiniComponents(TArray<UHoudiniAssetComponent*>& OutComponents)
+{
+	OutComponents.Reset();
+	if (!IsInitialized())
+		return;
+
+	FScopeLock ScopeLock(&CriticalSection);
+	for (auto It = ActiveHoudiniComponents.CreateIterator(); It; ++It)
+	{
+		// Remove stale components
+		UHoudiniAssetComponent* HAC = It->Get();
+		if (!IsValid(HAC))
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		OutComponents.Add(HAC);
+	}
+}
+
+
 int32
 FHoudiniEngineRuntime::GetNodeIdsPendingDeleteCount()
 {
@@ -66,6 +66,18 @@ class HOUDINIENGINERUNTIME_API FHoudiniEngineRuntime : public IModuleInterface
 		UHoudiniAssetComponent* GetRegisteredHoudiniComponentAt(const int32& Index);
 
 		virtual TArray<TWeakObjectPtr<UHoudiniAssetComponent>>* GetRegisteredHoudiniComponents() { return &RegisteredHoudiniComponents; };
+
+		//
+		// Active components
+		//
+		// Registered components that need processing by the Houdini Engine Manager.
+		// Components mark themselves active on state, parameter, input or transform changes,
+		// the manager marks them idle again once they've been processed and have nothing left to do.
+		void MarkHoudiniComponentActive(UHoudiniAssetComponent* HAC);
+		void MarkHoudiniComponentIdle(UHoudiniAssetComponent* HAC);
+
+		int32 GetActiveHoudiniComponentCount();
+		void GetActiveHoudiniComponents(TArray<UHoudiniAssetComponent*>& OutComponents);
 		
 		//
 		// Node deletion
@@ -101,6 +113,12 @@ class HOUDINIENGINERUNTIME_API FHoudiniEngineRuntime : public IModuleInterface
 		// 
 		TArray<TWeakObjectPtr<UHoudiniAssetComponent>> RegisteredHoudiniComponents;
 
+		// Lookup set for the registered components
+		TSet<TWeakObjectPtr<UHoudiniAssetComponent>> RegisteredHoudiniComponentSet;
+
+		// Subset of the registered components that need processing
+		TSet<TWeakObjectPtr<UHoudiniAssetComponent>> ActiveHoudiniComponents;
+
 		TArray<int32> NodeIdsPendingDelete;
 
 		TArray<int32> NodeIdsParentPendingDelete;
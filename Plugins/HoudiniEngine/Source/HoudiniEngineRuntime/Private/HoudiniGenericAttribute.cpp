@@ -38,6 +38,27 @@
 #include "PhysicsEngine/BodySetup.h"
 #include "EditorFramework/AssetImportData.h"
 #include "AI/Navigation/NavCollisionBase.h"
+#include "Misc/ScopeRWLock.h"
+
+#if WITH_EDITOR
+// Property found on a class for a given property name.
+// Resolving a property walks the class properties and compares their display names,
+// so it is done once per class and name, and reused for all the objects of that class.
+struct FHoudiniResolvedProperty
+{
+	// The class the property was resolved on, to detect classes that have been destroyed
+	TWeakObjectPtr<const UStruct> Struct;
+	// The found property, null if the property isn't on the class
+	FProperty* Property = nullptr;
+	// Offset of the property's container in the object, INDEX_NONE if the property has no container
+	int64 ContainerOffset = INDEX_NONE;
+	// The properties to add to the property chain
+	TArray<FProperty*> PropertyChain;
+};
+
+static FRWLock HoudiniResolvedPropertiesLock;
+static TMap<TPair<const UStruct*, FString>, FHoudiniResolvedProperty> HoudiniResolvedProperties;
+#endif
 
 FHoudiniGenericAttributeChangedProperty::FHoudiniGenericAttributeChangedProperty()
 	: Object()
@@ -635,15 +656,36 @@ FHoudiniGenericAttribute::FindPropertyOnObject(
 	OutFoundProperty = nullptr;
 	OutFoundPropertyObject = InObject;
 
-	bool bPropertyHasBeenFound = false;
-	FHoudiniGenericAttribute::TryToFindProperty(
-		InObject,
-		ObjectClass,
-		InPropertyName,
-		InPropertyChain,
-		OutFoundProperty,
-		bPropertyHasBeenFound,
-		OutContainer);
+	// Use the property resolved by a previous search on this class if we have one
+	const TPair<const UStruct*, FString> ResolvedPropertyKey(ObjectClass, InPropertyName);
+	bool bHasResolvedProperty = false;
+	{
+		FReadScopeLock ScopeLock(HoudiniResolvedPropertiesLock);
+		const FHoudiniResolvedProperty* ResolvedProperty = HoudiniResolvedProperties.Find(ResolvedPropertyKey);
+		if (ResolvedProperty && ResolvedProperty->Struct.Get() == ObjectClass)
+		{
+			bHasResolvedProperty = true;
+			OutFoundProperty = ResolvedProperty->Property;
+			if (ResolvedProperty->ContainerOffset != INDEX_NONE)
+				OutContainer = (uint8*)InObject + ResolvedProperty->ContainerOffset;
+			for (FProperty* ChainProperty : ResolvedProperty->PropertyChain)
+				InPropertyChain.AddTail(ChainProperty);
+		}
+	}
+
+	if (!bHasResolvedProperty)
+	{
+		const int32 PropertyChainStart = InPropertyChain.Num();
+
+		bool bPropertyHasBeenFound = false;
+		FHoudiniGenericAttribute::TryToFindProperty(
+			InObject,
+			ObjectClass,
+			InPropertyName,
+			InPropertyChain,
+			OutFoundProperty,
+			bPropertyHasBeenFound,
+			OutContainer);
 
 	/*
 	// TODO: Parsing needs to be made recursively!
@@ -720,13 +762,30 @@ FHoudiniGenericAttribute::FindPropertyOnObject(
 		return true;
 	*/
 
-	// Try with FindField??
-	if (!OutFoundProperty)
-		OutFoundProperty = FindFProperty<FProperty>(ObjectClass, *InPropertyName);
+		// Try with FindField??
+		if (!OutFoundProperty)
+			OutFoundProperty = FindFProperty<FProperty>(ObjectClass, *InPropertyName);
+
+		// Try with FindPropertyByName ??
+		if (!OutFoundProperty)
+			OutFoundProperty = ObjectClass->FindPropertyByName(*InPropertyName);
+
+		FHoudiniResolvedProperty ResolvedProperty;
+		ResolvedProperty.Struct = ObjectClass;
+		ResolvedProperty.Property = OutFoundProperty;
+		if (OutContainer)
+			ResolvedProperty.ContainerOffset = (uint8*)OutContainer - (uint8*)InObject;
 
-	// Try with FindPropertyByName ??
-	if (!OutFoundProperty)
-		OutFoundProperty = ObjectClass->FindPropertyByName(*InPropertyName);
+		int32 ChainIndex = 0;
+		for (FProperty* ChainProperty : InPropertyChain)
+		{
+			if (ChainIndex++ >= PropertyChainStart)
+				ResolvedProperty.PropertyChain.Add(ChainProperty);
+		}
+
+		FWriteScopeLock ScopeLock(HoudiniResolvedPropertiesLock);
+		HoudiniResolvedProperties.Add(ResolvedPropertyKey, MoveTemp(ResolvedProperty));
+	}
 
 	// We found the Property we were looking for
 	if (OutFoundProperty)
@@ -34,6 +34,7 @@
 #include "HoudiniGeoPartObject.h"
 #include "HoudiniAssetComponent.h"
 #include "HoudiniAssetBlueprintComponent.h"
+#include "HoudiniActorBoundsIndex.h"
 #include "UnrealObjectInputRuntimeTypes.h"
 #include "UnrealObjectInputManager.h"
 
@@ -92,6 +93,8 @@ UHoudiniInput::UHoudiniInput()
 	, LandscapeExportType(EHoudiniLandscapeExportType::Heightfield)
 	, bLandscapeExportSelectionOnly(false)
 	, bLandscapeAutoSelectComponent(false)
+	, bLandscapeExportRegionOfInterest(false)
+	, LandscapeRegionOfInterest(ForceInit)
 	, bLandscapeExportMaterials(false)
 	, bLandscapeExportLighting(false)
 	, bLandscapeExportNormalizedUVs(false)
@@ -569,6 +572,21 @@ void UHoudiniInput::UpdateLandscapeInputSelection()
 #endif
 }
 
+FBox
+UHoudiniInput::GetLandscapeRegionOfInterestBounds()
+{
+	if (LandscapeRegionOfInterest.IsValid)
+		return LandscapeRegionOfInterest;
+
+	// Use our asset's or our connected input asset's bounds
+	FBox Bounds(ForceInit);
+	UHoudiniAssetComponent* AssetComponent = Cast<UHoudiniAssetComponent>(GetOuter());
+	if (IsValid(AssetComponent))
+		Bounds = AssetComponent->GetAssetBounds(this, true);
+
+	return Bounds;
+}
+
 void
 UHoudiniInput::MarkInputNodeAsPendingDelete()
 {
@@ -1093,6 +1111,18 @@ UHoudiniInput::CreateNewCurveInputObject(bool& bOutBlueprintStructureModified)
 	return NewCurveInputObject;
 }
 
+void
+UHoudiniInput::MarkChanged(const bool& bInChanged)
+{
+	bHasChanged = bInChanged;
+	SetNeedsToTriggerUpdate(bInChanged);
+
+	// Let our component know it needs to be processed
+	UHoudiniAssetComponent* OuterHAC = bInChanged ? Cast<UHoudiniAssetComponent>(GetOuter()) : nullptr;
+	if (OuterHAC)
+		OuterHAC->MarkAsActive();
+}
+
 void
 UHoudiniInput::MarkAllInputObjectsChanged(const bool& bInChanged)
 {
@@ -2589,12 +2619,34 @@ UHoudiniInput::UpdateWorldSelectionFromBoundSelectors()
 	USceneComponent* ParentComponent = Cast<USceneComponent>(GetOuter());
 	AActor* ParentActor = ParentComponent ? ParentComponent->GetOwner() : nullptr;
 
-	//UWorld* editorWorld = GEditor->GetEditorWorldContext().World();
+	// Look for the actors intersecting the bounds in the world's index,
+	// only iterate on all the actors if the world isn't indexed
 	UWorld* MyWorld = GetWorld();
+	TArray<AActor*> ActorsInBounds;
+	if (AllBBox.Num() > 0 && !FHoudiniActorBoundsIndex::FindActorsInBounds(MyWorld, AllBBox, ActorsInBounds))
+	{
+		for (TActorIterator<AActor> ActorItr(MyWorld); ActorItr; ++ActorItr)
+		{
+			AActor *CurrentActor = *ActorItr;
+			if (!IsValid(CurrentActor))
+				continue;
+
+			FBox ActorBounds = CurrentActor->GetComponentsBoundingBox(true);
+			for (auto InBounds : AllBBox)
+			{
+				// Check if both actor's bounds intersects
+				if (!ActorBounds.Intersect(InBounds))
+					continue;
+
+				ActorsInBounds.Add(CurrentActor);
+				break;
+			}
+		}
+	}
+
 	TArray<AActor*> NewSelectedActors;
-	for (TActorIterator<AActor> ActorItr(MyWorld); ActorItr; ++ActorItr)
+	for (AActor* CurrentActor : ActorsInBounds)
 	{
-		AActor *CurrentActor = *ActorItr;
 		if (!IsValid(CurrentActor))
 			continue;
 
@@ -2619,18 +2671,29 @@ UHoudiniInput::UpdateWorldSelectionFromBoundSelectors()
 				continue;
 		}
 
-		FBox ActorBounds = CurrentActor->GetComponentsBoundingBox(true);
-		for (auto InBounds : AllBBox)
-		{
-			// Check if both actor's bounds intersects
-			if (!ActorBounds.Intersect(InBounds))
-				continue;
+		NewSelectedActors.Add(CurrentActor);
+	}
 
-			NewSelectedActors.Add(CurrentActor);
-			break;
+	// Only update the selection (and mark the input as changed) if the selected actors are different
+	if (NewSelectedActors.Num() == WorldInputObjects.Num())
+	{
+		TSet<AActor*> CurrentSelectedActors;
+		for (auto& CurrentInputObject : WorldInputObjects)
+		{
+			UHoudiniInputActor* InputActor = Cast<UHoudiniInputActor>(CurrentInputObject);
+			AActor* CurActor = InputActor ? InputActor->GetActor() : nullptr;
+			if (CurActor)
+				CurrentSelectedActors.Add(CurActor);
 		}
+
+		bool bSameSelection = CurrentSelectedActors.Num() == NewSelectedActors.Num();
+		for (int32 Idx = 0; bSameSelection && Idx < NewSelectedActors.Num(); Idx++)
+			bSameSelection = CurrentSelectedActors.Contains(NewSelectedActors[Idx]);
+
+		if (bSameSelection)
+			return false;
 	}
-	
+
 	return UpdateWorldSelection(NewSelectedActors);
 }
 
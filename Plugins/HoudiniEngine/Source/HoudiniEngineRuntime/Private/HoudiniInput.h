@@ -226,11 +226,7 @@ public:
 	// Mutators
 	//------------------------------------------------------------------------------------------------
 
-	void MarkChanged(const bool& bInChanged)
-	{
-		bHasChanged = bInChanged;
-		SetNeedsToTriggerUpdate(bInChanged);
-	};
+	void MarkChanged(const bool& bInChanged);
 	void SetNeedsToTriggerUpdate(const bool& bInTriggersUpdate) { bNeedsToTriggerUpdate = bInTriggersUpdate; };
 	void MarkDataUploadNeeded(const bool& bInDataUploadNeeded) { bDataUploadNeeded = bInDataUploadNeeded; };
 	void MarkAllInputObjectsChanged(const bool& bInChanged);
@@ -365,6 +361,10 @@ public:
 
 	void UpdateLandscapeInputSelection();
 
+	// Returns the world space box used by region of interest landscape exports:
+	// LandscapeRegionOfInterest if valid, the asset's bounds otherwise.
+	FBox GetLandscapeRegionOfInterestBounds();
+
 	// Add the current InputNodeId to the pending delete set and set it to -1
 	void MarkInputNodeAsPendingDelete();
 
@@ -617,6 +617,15 @@ public:
 	UPROPERTY()
 	bool bLandscapeAutoSelectComponent = false;
 
+	// Is set to true when only the landscape components under the region of interest are exported as a heightfield.
+	// Components that did not change since the previous export are not sent again.
+	UPROPERTY()
+	bool bLandscapeExportRegionOfInterest = false;
+
+	// World space region of interest for landscape heightfield exports, the asset's bounds are used when invalid.
+	UPROPERTY()
+	FBox LandscapeRegionOfInterest = FBox(ForceInit);
+
 	// Is set to true when materials are to be exported.
 	UPROPERTY()
 	bool bLandscapeExportMaterials = false;
@@ -25,6 +25,7 @@
 */
 
 #include "HoudiniParameter.h"
+#include "HoudiniAssetComponent.h"
 
 UHoudiniParameter::UHoudiniParameter(const FObjectInitializer & ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -73,6 +74,18 @@ UHoudiniParameter::IsChildParameter() const
 	return ParentParmId >= 0;
 }
 
+void
+UHoudiniParameter::MarkChanged(const bool& bInChanged)
+{
+	bHasChanged = bInChanged;
+	SetNeedsToTriggerUpdate(bInChanged);
+
+	// Let our component know it needs to be processed
+	UHoudiniAssetComponent* OuterHAC = bInChanged ? Cast<UHoudiniAssetComponent>(GetOuter()) : nullptr;
+	if (OuterHAC)
+		OuterHAC->MarkAsActive();
+}
+
 void
 UHoudiniParameter::RevertToDefault()
 {
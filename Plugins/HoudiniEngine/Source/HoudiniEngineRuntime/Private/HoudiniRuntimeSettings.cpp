@@ -147,6 +147,7 @@ UHoudiniRuntimeSettings::UHoudiniRuntimeSettings( const FObjectInitializer & Obj
 	DistanceFieldResolutionScale = 2.0f; // ue default is 1.0
 
 	bPDGAsyncCommandletImportEnabled = false;
+	PDGAsyncCommandletImportWorkers = 2;
 
 	// Legacy settings
 	bEnableBackwardCompatibility = true;
@@ -475,6 +475,11 @@ protected:
 		UPROPERTY(GlobalConfig, EditAnywhere, Category = "PDG Settings", Meta = (DisplayName = "Async Importer Enabled"))
 		bool bPDGAsyncCommandletImportEnabled;
 
+		// Number of importer commandlets started when the async importer is enabled. Work item results are
+		// dispatched to the least busy importer. Each importer is a separate editor process.
+		UPROPERTY(GlobalConfig, EditAnywhere, Category = "PDG Settings", Meta = (DisplayName = "Async Importer Workers", ClampMin = "1", ClampMax = "16", EditCondition = "bPDGAsyncCommandletImportEnabled"))
+		int32 PDGAsyncCommandletImportWorkers;
+
 		//-------------------------------------------------------------------------------------------------------------
 		// Legacy
 		//-------------------------------------------------------------------------------------------------------------
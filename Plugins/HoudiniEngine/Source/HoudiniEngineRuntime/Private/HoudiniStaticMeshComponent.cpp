@@ -138,7 +138,13 @@ void UHoudiniStaticMeshComponent::SetHoudiniIconVisible(bool bInHoudiniIconVisib
 
 void UHoudiniStaticMeshComponent::NotifyMeshUpdated()
 {
-	MarkRenderStateDirty();
+	// When only the vertex data changed, update the GPU buffers of the current proxy in place: this keeps its
+	// cached static draw commands. Otherwise, recreate the proxy.
+	FHoudiniStaticMeshSceneProxy* Proxy = static_cast<FHoudiniStaticMeshSceneProxy*>(SceneProxy);
+	const bool bUpdatedInPlace = Proxy && Mesh && !IsRenderStateDirty() && Proxy->UpdateBuffersInPlace();
+	if (!bUpdatedInPlace)
+		MarkRenderStateDirty();
+
 	if (Mesh)
 	{
 		LocalBounds = Mesh->CalcBounds();
@@ -150,6 +156,10 @@ void UHoudiniStaticMeshComponent::NotifyMeshUpdated()
 
 	UpdateBounds();
 
+	// Send the new bounds to the proxy
+	if (bUpdatedInPlace)
+		MarkRenderTransformDirty();
+
 #if WITH_EDITORONLY_DATA
 	UpdateSpriteComponent();
 #endif
@@ -30,6 +30,7 @@
 #include "Materials/Material.h"
 #include "PrimitiveViewRelevance.h"
 #include "Engine/Engine.h"
+#include "Misc/Crc.h"
 #if ENGINE_MINOR_VERSION > 1
 	#include "MaterialDomain.h"
 	#include "Materials/MaterialRenderProxy.h"
@@ -108,9 +109,61 @@ void FHoudiniStaticMeshRenderBufferSet::InitOrUpdateResource(FRenderResource* Re
 		Resource->InitResource();
 }
 
+bool FHoudiniStaticMeshRenderBufferSet::HasSameLayout(const FHoudiniStaticMeshRenderBufferSet& InOther) const
+{
+	return NumTriangles == InOther.NumTriangles
+		&& TopologyHash == InOther.TopologyHash
+		&& Material == InOther.Material
+		&& PositionVertexBuffer.GetNumVertices() == InOther.PositionVertexBuffer.GetNumVertices()
+		&& StaticMeshVertexBuffer.GetNumTexCoords() == InOther.StaticMeshVertexBuffer.GetNumTexCoords()
+		&& StaticMeshVertexBuffer.GetTangentSize() == InOther.StaticMeshVertexBuffer.GetTangentSize()
+		&& StaticMeshVertexBuffer.GetTexCoordSize() == InOther.StaticMeshVertexBuffer.GetTexCoordSize()
+		&& ColorVertexBuffer.GetNumVertices() == InOther.ColorVertexBuffer.GetNumVertices()
+		&& TriangleIndexBuffer.Indices == InOther.TriangleIndexBuffer.Indices;
+}
+
+void FHoudiniStaticMeshRenderBufferSet::UpdateVertexBuffers(FHoudiniStaticMeshRenderBufferSet& InSource)
+{
+	check(IsInRenderingThread());
+
+	if (NumTriangles == 0)
+		return;
+
+	FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
+	auto CopyVertexData = [&RHICmdList](FVertexBuffer& InBuffer, void* InDestData, const void* InSourceData, const uint32 InSize)
+	{
+		if (InSize == 0)
+			return;
+
+		// Keep the CPU copy in sync, in case the buffer is reinitialized
+		if (InDestData)
+			FMemory::Memcpy(InDestData, InSourceData, InSize);
+
+		if (!InBuffer.VertexBufferRHI.IsValid())
+			return;
+
+		void* Data = RHICmdList.LockBuffer(InBuffer.VertexBufferRHI, 0, InSize, RLM_WriteOnly);
+		FMemory::Memcpy(Data, InSourceData, InSize);
+		RHICmdList.UnlockBuffer(InBuffer.VertexBufferRHI);
+	};
+
+	CopyVertexData(
+		PositionVertexBuffer, PositionVertexBuffer.GetVertexData(), InSource.PositionVertexBuffer.GetVertexData(),
+		PositionVertexBuffer.GetNumVertices() * PositionVertexBuffer.GetStride());
+	CopyVertexData(
+		StaticMeshVertexBuffer.TangentsVertexBuffer, StaticMeshVertexBuffer.GetTangentData(), InSource.StaticMeshVertexBuffer.GetTangentData(),
+		StaticMeshVertexBuffer.GetTangentSize());
+	CopyVertexData(
+		StaticMeshVertexBuffer.TexCoordVertexBuffer, StaticMeshVertexBuffer.GetTexCoordData(), InSource.StaticMeshVertexBuffer.GetTexCoordData(),
+		StaticMeshVertexBuffer.GetTexCoordSize());
+	CopyVertexData(
+		ColorVertexBuffer, ColorVertexBuffer.GetVertexData(), InSource.ColorVertexBuffer.GetVertexData(),
+		ColorVertexBuffer.GetNumVertices() * ColorVertexBuffer.GetStride());
+}
+
 void FHoudiniStaticMeshRenderBufferSet::DestroyRenderBufferSet(FHoudiniStaticMeshRenderBufferSet* BufferSet)
 {
-	if (BufferSet->NumTriangles == 0)
+	if (!BufferSet)
 	{
 		return;
 	}
@@ -190,42 +243,135 @@ void FHoudiniStaticMeshSceneProxy::UpdatedReferencedMaterials()
 #endif
 }
 
-void FHoudiniStaticMeshSceneProxy::Build()
+void FHoudiniStaticMeshSceneProxy::AllocateBufferSets(TArray<FHoudiniStaticMeshRenderBufferSet*>& OutBufferSets)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniStaticMeshSceneProxy::Build"));
-
 	// Allocate a buffer set per material
 	const uint32 NumMaterials = GetNumMaterials();
 	if (NumMaterials == 0)
 	{
-		// No materials, allocate a singel buffer set using the default material
-		FHoudiniStaticMeshRenderBufferSet *BufferSet = nullptr;
-		AllocateNewRenderBufferSet(BufferSet);
+		// No materials, allocate a single buffer set using the default material
+		FHoudiniStaticMeshRenderBufferSet *BufferSet = MakeNewBufferSet();
 		BufferSet->Material = UMaterial::GetDefaultMaterial(MD_Surface);
+		OutBufferSets.Add(BufferSet);
 	}
 	else
 	{
 		for (uint32 MaterialIdx = 0; MaterialIdx < NumMaterials; ++MaterialIdx)
 		{
-			FHoudiniStaticMeshRenderBufferSet *BufferSet = nullptr;
-			AllocateNewRenderBufferSet(BufferSet);
+			FHoudiniStaticMeshRenderBufferSet *BufferSet = MakeNewBufferSet();
 			BufferSet->Material = GetMaterial(MaterialIdx);
+			OutBufferSets.Add(BufferSet);
 		}
 	}
+}
+
+void FHoudiniStaticMeshSceneProxy::PopulateBufferSets(const TArray<FHoudiniStaticMeshRenderBufferSet*>& InBufferSets)
+{
+	if (!Component)
+		return;
+
+	UHoudiniStaticMesh *Mesh = Component->GetMesh();
+	if (!Mesh)
+		return;
+
+	if (GetNumMaterials() > 1 && Mesh->HasPerFaceMaterials())
+	{
+		BuildBufferSetsByMaterial(InBufferSets);
+	}
+	else
+	{
+		BuildSingleBufferSet(InBufferSets);
+	}
+}
+
+void FHoudiniStaticMeshSceneProxy::Build()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniStaticMeshSceneProxy::Build"));
+
+	TArray<FHoudiniStaticMeshRenderBufferSet*> NewBufferSets;
+	AllocateBufferSets(NewBufferSets);
+	PopulateBufferSets(NewBufferSets);
+
+	BufferSetsLock.Lock();
+	BufferSets.Append(NewBufferSets);
+	BufferSetsLock.Unlock();
 
-	if (Component)
+	for (FHoudiniStaticMeshRenderBufferSet* Buffers : NewBufferSets)
 	{
-		UHoudiniStaticMesh *Mesh = Component->GetMesh();
-		if (Mesh)
+		if (Buffers->NumTriangles == 0)
+			continue;
+
+		ENQUEUE_RENDER_COMMAND(FHoudiniStaticMeshSceneProxy_CopyBuffers)(
+			[Buffers](FRHICommandListImmediate& RHICMdList)
 		{
-			if (NumMaterials > 1 && Mesh->HasPerFaceMaterials())
-			{
-				BuildBufferSetsByMaterial();
-			}
-			else
-			{
-				BuildSingleBufferSet();
-			}
+			Buffers->CopyBuffers();
+		});
+	}
+}
+
+bool FHoudiniStaticMeshSceneProxy::UpdateBuffersInPlace()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniStaticMeshSceneProxy::UpdateBuffersInPlace"));
+
+	check(IsInGameThread());
+
+	if (!Component || !Component->GetMesh() || Component->GetMesh()->GetNumTriangles() == 0)
+		return false;
+
+	TArray<FHoudiniStaticMeshRenderBufferSet*> NewBufferSets;
+	AllocateBufferSets(NewBufferSets);
+	PopulateBufferSets(NewBufferSets);
+
+	// The index buffers, vertex counts and materials must match for the cached draw commands to stay valid
+	bool bSameLayout = NewBufferSets.Num() == BufferSets.Num();
+	for (int32 BufferSetIdx = 0; bSameLayout && BufferSetIdx < NewBufferSets.Num(); ++BufferSetIdx)
+		bSameLayout = BufferSets[BufferSetIdx]->HasSameLayout(*NewBufferSets[BufferSetIdx]);
+
+	if (!bSameLayout)
+	{
+		for (FHoudiniStaticMeshRenderBufferSet* NewBufferSet : NewBufferSets)
+			FHoudiniStaticMeshRenderBufferSet::DestroyRenderBufferSet(NewBufferSet);
+		return false;
+	}
+
+	ENQUEUE_RENDER_COMMAND(FHoudiniStaticMeshSceneProxy_UpdateBuffersInPlace)(
+		[this, NewBufferSets](FRHICommandListImmediate& RHICmdList)
+	{
+		for (int32 BufferSetIdx = 0; BufferSetIdx < NewBufferSets.Num(); ++BufferSetIdx)
+		{
+			BufferSets[BufferSetIdx]->UpdateVertexBuffers(*NewBufferSets[BufferSetIdx]);
+			delete NewBufferSets[BufferSetIdx];
+		}
+	});
+
+	return true;
+}
+
+bool FHoudiniStaticMeshSceneProxy::UseDynamicPath(const FSceneView* View) const
+{
+	// Same as static meshes: debug views go through GetDynamicMeshElements
+	const FEngineShowFlags& EngineShowFlags = View->Family->EngineShowFlags;
+	return IsRichView(*View->Family)
+		|| EngineShowFlags.Wireframe
+		|| EngineShowFlags.Bounds
+		|| EngineShowFlags.Collision;
+}
+
+void FHoudiniStaticMeshSceneProxy::DrawStaticElements(FStaticPrimitiveDrawInterface* PDI)
+{
+	// The batches are cached by the renderer until the proxy is recreated,
+	// in place updates of the vertex buffers keep them valid
+	const uint32 NumBufferSets = BufferSets.Num();
+	for (uint32 BufferSetIdx = 0; BufferSetIdx < NumBufferSets; ++BufferSetIdx)
+	{
+		const FHoudiniStaticMeshRenderBufferSet *BufferSet = BufferSets[BufferSetIdx];
+		if (BufferSet->NumTriangles == 0 || BufferSet->TriangleIndexBuffer.Indices.Num() == 0)
+			continue;
+
+		FMeshBatch Mesh;
+		if (PopulateMeshElement(Mesh, *BufferSet, BufferSet->Material->GetRenderProxy(), false, SDPG_World, 0, nullptr))
+		{
+			PDI->DrawMesh(Mesh, FLT_MAX);
 		}
 	}
 }
@@ -257,6 +403,10 @@ void FHoudiniStaticMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSc
 
 		const FSceneView *View = Views[ViewIdx];
 
+		// Regular views use the cached static path
+		if (!UseDynamicPath(View))
+			continue;
+
 		bool bHasPrecomputedVolumetricLightmap;
 		FMatrix PreviousLocalToWorld;
 		int32 SingleCaptureIndex;
@@ -287,14 +437,14 @@ void FHoudiniStaticMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSc
 			if (BufferSet->TriangleIndexBuffer.Indices.Num() > 0)
 			{
 				FMeshBatch& Mesh = Collector.AllocateMesh();
-				if (PopulateMeshElement(Mesh, *BufferSet, MaterialProxy, false, DepthPriority, ViewIdx, DynamicPrimitiveUniformBuffer))
+				if (PopulateMeshElement(Mesh, *BufferSet, MaterialProxy, false, DepthPriority, ViewIdx, &DynamicPrimitiveUniformBuffer))
 				{
 					Collector.AddMesh(ViewIdx, Mesh);
 				}
 				if (bRenderAsWireframe)
 				{
 					FMeshBatch& WireframeMesh = Collector.AllocateMesh();
-					if (PopulateMeshElement(WireframeMesh, *BufferSet, WireframeMaterialProxy, true, DepthPriority, ViewIdx, DynamicPrimitiveUniformBuffer))
+					if (PopulateMeshElement(WireframeMesh, *BufferSet, WireframeMaterialProxy, true, DepthPriority, ViewIdx, &DynamicPrimitiveUniformBuffer))
 					{
 						Collector.AddMesh(ViewIdx, WireframeMesh);
 					}
@@ -318,7 +468,7 @@ bool FHoudiniStaticMeshSceneProxy::PopulateMeshElement(
 	bool bRenderAsWireframe,
 	ESceneDepthPriorityGroup DepthPriority,
 	int ViewIndex,
-	FDynamicPrimitiveUniformBuffer& DynamicPrimitiveUniformBuffer) const
+	FDynamicPrimitiveUniformBuffer* DynamicPrimitiveUniformBuffer) const
 {
 	FMeshBatchElement& BatchElement = InMeshBatch.Elements[0];
 	BatchElement.IndexBuffer = &Buffers.TriangleIndexBuffer;
@@ -326,7 +476,8 @@ bool FHoudiniStaticMeshSceneProxy::PopulateMeshElement(
 	InMeshBatch.VertexFactory = &Buffers.LocalVertexFactory;
 	InMeshBatch.MaterialRenderProxy = Material;
 
-	BatchElement.PrimitiveUniformBufferResource = &DynamicPrimitiveUniformBuffer.UniformBuffer;
+	// Static batches use the proxy's primitive uniform buffer
+	BatchElement.PrimitiveUniformBufferResource = DynamicPrimitiveUniformBuffer ? &DynamicPrimitiveUniformBuffer->UniformBuffer : nullptr;
 
 	BatchElement.FirstIndex = 0;
 	BatchElement.NumPrimitives = Buffers.NumTriangles;
@@ -346,7 +497,10 @@ FPrimitiveViewRelevance FHoudiniStaticMeshSceneProxy::GetViewRelevance(const FSc
 	FPrimitiveViewRelevance Result;
 
 	Result.bDrawRelevance = IsShown(View);
-	Result.bDynamicRelevance = true;
+	if (UseDynamicPath(View))
+		Result.bDynamicRelevance = true;
+	else
+		Result.bStaticRelevance = true;
 	Result.bRenderCustomDepth = ShouldRenderCustomDepth();
 	Result.bRenderInMainPass = ShouldRenderInMainPass();
 	Result.bShadowRelevance = IsShadowCast(View);
@@ -363,28 +517,23 @@ bool FHoudiniStaticMeshSceneProxy::CanBeOccluded() const
 	return !MaterialRelevance.bDisableDepthTest;
 }
 
-void FHoudiniStaticMeshSceneProxy::PopulateBuffers(const UHoudiniStaticMesh *InMesh, FHoudiniStaticMeshRenderBufferSet *InBuffers, const TArray<uint32>* InTriangleIDs, uint32 InTriangleGroupStartIdx, uint32 InNumTrianglesInGroup)
+void FHoudiniStaticMeshSceneProxy::InitBufferLayout(const UHoudiniStaticMesh *InMesh, FHoudiniStaticMeshRenderBufferSet *InBuffers, TArray<uint32>& OutRenderVertexInstances, const TArray<uint32>* InTriangleIDs, uint32 InTriangleGroupStartIdx, uint32 InNumTrianglesInGroup)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniStaticMeshSceneProxy::PopulateBuffers"));
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniStaticMeshSceneProxy::InitBufferLayout"));
 
 	check(InMesh);
 	check(InBuffers);
 
+	OutRenderVertexInstances.Reset();
+
 	const uint32 NumTriangles = InTriangleIDs ? InNumTrianglesInGroup : InMesh->GetNumTriangles();
 	InBuffers->NumTriangles = NumTriangles;
 
 	if (NumTriangles == 0)
 		return;
 
-	const uint32 NumVertices = NumTriangles * 3;
 	const uint32 NumUVLayers = InMesh->GetNumUVLayers();
-
-	InBuffers->PositionVertexBuffer.Init(NumVertices);
-	// There must be at least one UV layer
-	// TODO: Would it be possible to have no UV layers and bind to a dummy 0/black SRV?
-	InBuffers->StaticMeshVertexBuffer.Init(NumVertices, NumUVLayers > 0 ? NumUVLayers : 1);
-	InBuffers->ColorVertexBuffer.Init(NumVertices);
-	InBuffers->TriangleIndexBuffer.Indices.AddUninitialized(NumTriangles * 3);
+	const uint32 NumVertexInstances = InMesh->GetNumVertexInstances();
 
 	const TArray<FVector3f>& VertexPositions = InMesh->GetVertexPositions();
 	const TArray<FIntVector>& TriangleIndices = InMesh->GetTriangleIndices();
@@ -398,56 +547,133 @@ void FHoudiniStaticMeshSceneProxy::PopulateBuffers(const UHoudiniStaticMesh *InM
 	const bool bHasNormals = InMesh->HasNormals();
 	const bool bHasTangents = InMesh->HasTangents();
 
-	FThreadSafeCounter VertCounter(0);
-	//for (uint32 TriangleIDIdx = 0; TriangleIDIdx < NumTriangles; ++TriangleIDIdx)
-	ParallelFor(NumTriangles, [&](uint32 TriangleIDIdx)
+	// Vertex instances sharing a mesh vertex and all of their attributes share a render vertex, instead of
+	// expanding every triangle into three vertices. Each render vertex keeps the first instance that uses it.
+	auto HaveSameAttributes = [&](const uint32 InInstanceA, const uint32 InInstanceB)
+	{
+		if (bHasNormals && VertexInstanceNormals[InInstanceA] != VertexInstanceNormals[InInstanceB])
+			return false;
+		if (bHasTangents && (VertexInstanceUTangents[InInstanceA] != VertexInstanceUTangents[InInstanceB]
+			|| VertexInstanceVTangents[InInstanceA] != VertexInstanceVTangents[InInstanceB]))
+			return false;
+		if (bHasColors && VertexInstanceColors[InInstanceA] != VertexInstanceColors[InInstanceB])
+			return false;
+		for (uint32 UVLayerIdx = 0; UVLayerIdx < NumUVLayers; ++UVLayerIdx)
+		{
+			if (VertexInstanceUVs[UVLayerIdx * NumVertexInstances + InInstanceA] != VertexInstanceUVs[UVLayerIdx * NumVertexInstances + InInstanceB])
+				return false;
+		}
+		return true;
+	};
+
+	TArray<uint32>& Indices = InBuffers->TriangleIndexBuffer.Indices;
+	Indices.SetNumUninitialized(NumTriangles * 3);
+
+	OutRenderVertexInstances.Reserve(NumTriangles * 3);
+	// Linked lists of the render vertices of each mesh vertex
+	TArray<int32> FirstRenderVertex;
+	FirstRenderVertex.Init(INDEX_NONE, VertexPositions.Num());
+	TArray<int32> NextRenderVertex;
+	NextRenderVertex.Reserve(NumTriangles * 3);
+
+	for (uint32 TriangleIDIdx = 0; TriangleIDIdx < NumTriangles; ++TriangleIDIdx)
 	{
 		const uint32 TriangleID = InTriangleIDs ? (*InTriangleIDs)[InTriangleGroupStartIdx + TriangleIDIdx] : TriangleIDIdx;
 		const FIntVector &TriIndices = TriangleIndices[TriangleID];
-
-		FVector3f TangentU;
-		FVector3f TangentV;
-		uint32 VertIdx = VertCounter.Add(3);
 		for (uint8 TriVertIdx = 0; TriVertIdx < 3; ++TriVertIdx)
 		{
 			const uint32 MeshVtxIdx = TriIndices[TriVertIdx];
 			const uint32 MeshVtxInstanceIdx = TriangleID * 3 + TriVertIdx;
 
-			InBuffers->PositionVertexBuffer.VertexPosition(VertIdx) = VertexPositions[TriIndices[TriVertIdx]];
+			int32 RenderVertex = FirstRenderVertex[MeshVtxIdx];
+			while (RenderVertex != INDEX_NONE && !HaveSameAttributes(OutRenderVertexInstances[RenderVertex], MeshVtxInstanceIdx))
+				RenderVertex = NextRenderVertex[RenderVertex];
 
-			FVector3f Normal = bHasNormals ? VertexInstanceNormals[MeshVtxInstanceIdx] : FVector3f(0, 0, 1);
-			if (bHasTangents)
-			{
-				TangentU = VertexInstanceUTangents[MeshVtxInstanceIdx];
-				TangentV = VertexInstanceVTangents[MeshVtxInstanceIdx];
-			}
-			else
+			if (RenderVertex == INDEX_NONE)
 			{
-				Normal.FindBestAxisVectors(TangentU, TangentV);
+				RenderVertex = OutRenderVertexInstances.Add(MeshVtxInstanceIdx);
+				NextRenderVertex.Add(FirstRenderVertex[MeshVtxIdx]);
+				FirstRenderVertex[MeshVtxIdx] = RenderVertex;
 			}
-			InBuffers->StaticMeshVertexBuffer.SetVertexTangents(VertIdx, TangentU, TangentV, Normal);
 
-			if (NumUVLayers > 0)
-			{
-				for (uint8 UVLayerIdx = 0; UVLayerIdx < NumUVLayers; ++UVLayerIdx)
-				{
-					InBuffers->StaticMeshVertexBuffer.SetVertexUV(VertIdx, UVLayerIdx, VertexInstanceUVs[MeshVtxInstanceIdx]);
-				}
-			}
-			else
-			{
-				InBuffers->StaticMeshVertexBuffer.SetVertexUV(VertIdx, 0, FVector2f::ZeroVector);
-			}
+			Indices[TriangleIDIdx * 3 + TriVertIdx] = RenderVertex;
+		}
+	}
+
+	const uint32 NumVertices = OutRenderVertexInstances.Num();
+	InBuffers->TopologyHash = FCrc::MemCrc32(Indices.GetData(), Indices.Num() * Indices.GetTypeSize(), NumVertices);
+
+	InBuffers->PositionVertexBuffer.Init(NumVertices);
+	// There must be at least one UV layer
+	// TODO: Would it be possible to have no UV layers and bind to a dummy 0/black SRV?
+	InBuffers->StaticMeshVertexBuffer.Init(NumVertices, NumUVLayers > 0 ? NumUVLayers : 1);
+	InBuffers->ColorVertexBuffer.Init(NumVertices);
+}
+
+void FHoudiniStaticMeshSceneProxy::PopulateBuffers(const UHoudiniStaticMesh *InMesh, FHoudiniStaticMeshRenderBufferSet *InBuffers, const TArray<uint32>* InTriangleIDs, uint32 InTriangleGroupStartIdx, uint32 InNumTrianglesInGroup)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniStaticMeshSceneProxy::PopulateBuffers"));
+
+	TArray<uint32> RenderVertexInstances;
+	InitBufferLayout(InMesh, InBuffers, RenderVertexInstances, InTriangleIDs, InTriangleGroupStartIdx, InNumTrianglesInGroup);
+
+	const uint32 NumVertices = RenderVertexInstances.Num();
+	if (InBuffers->NumTriangles == 0 || NumVertices == 0)
+		return;
 
-			InBuffers->ColorVertexBuffer.VertexColor(VertIdx) = bHasColors ? VertexInstanceColors[MeshVtxInstanceIdx] : DefaultVertexColor;
+	const uint32 NumUVLayers = InMesh->GetNumUVLayers();
+	const uint32 NumVertexInstances = InMesh->GetNumVertexInstances();
 
-			InBuffers->TriangleIndexBuffer.Indices[VertIdx] = VertIdx;
-			VertIdx++;
+	const TArray<FVector3f>& VertexPositions = InMesh->GetVertexPositions();
+	const TArray<FIntVector>& TriangleIndices = InMesh->GetTriangleIndices();
+	const TArray<FColor>& VertexInstanceColors = InMesh->GetVertexInstanceColors();
+	const TArray<FVector3f>& VertexInstanceNormals = InMesh->GetVertexInstanceNormals();
+	const TArray<FVector3f>& VertexInstanceUTangents = InMesh->GetVertexInstanceUTangents();
+	const TArray<FVector3f>& VertexInstanceVTangents = InMesh->GetVertexInstanceVTangents();
+	const TArray<FVector2f>& VertexInstanceUVs = InMesh->GetVertexInstanceUVs();
+
+	const bool bHasColors = InMesh->HasColors();
+	const bool bHasNormals = InMesh->HasNormals();
+	const bool bHasTangents = InMesh->HasTangents();
+
+	ParallelFor(NumVertices, [&](uint32 VertIdx)
+	{
+		const uint32 MeshVtxInstanceIdx = RenderVertexInstances[VertIdx];
+		const uint32 MeshVtxIdx = TriangleIndices[MeshVtxInstanceIdx / 3][MeshVtxInstanceIdx % 3];
+
+		InBuffers->PositionVertexBuffer.VertexPosition(VertIdx) = VertexPositions[MeshVtxIdx];
+
+		FVector3f TangentU;
+		FVector3f TangentV;
+		FVector3f Normal = bHasNormals ? VertexInstanceNormals[MeshVtxInstanceIdx] : FVector3f(0, 0, 1);
+		if (bHasTangents)
+		{
+			TangentU = VertexInstanceUTangents[MeshVtxInstanceIdx];
+			TangentV = VertexInstanceVTangents[MeshVtxInstanceIdx];
+		}
+		else
+		{
+			Normal.FindBestAxisVectors(TangentU, TangentV);
 		}
+		InBuffers->StaticMeshVertexBuffer.SetVertexTangents(VertIdx, TangentU, TangentV, Normal);
+
+		if (NumUVLayers > 0)
+		{
+			for (uint8 UVLayerIdx = 0; UVLayerIdx < NumUVLayers; ++UVLayerIdx)
+			{
+				InBuffers->StaticMeshVertexBuffer.SetVertexUV(VertIdx, UVLayerIdx, VertexInstanceUVs[UVLayerIdx * NumVertexInstances + MeshVtxInstanceIdx]);
+			}
+		}
+		else
+		{
+			InBuffers->StaticMeshVertexBuffer.SetVertexUV(VertIdx, 0, FVector2f::ZeroVector);
+		}
+
+		InBuffers->ColorVertexBuffer.VertexColor(VertIdx) = bHasColors ? VertexInstanceColors[MeshVtxInstanceIdx] : DefaultVertexColor;
 	});
 }
 
-void FHoudiniStaticMeshSceneProxy::BuildSingleBufferSet()
+void FHoudiniStaticMeshSceneProxy::BuildSingleBufferSet(const TArray<FHoudiniStaticMeshRenderBufferSet*>& InBufferSets)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniStaticMeshSceneProxy::BuildSingleBufferSet"));
 
@@ -458,21 +684,13 @@ void FHoudiniStaticMeshSceneProxy::BuildSingleBufferSet()
 	if (!Mesh)
 		return;
 
-	if (BufferSets.Num() == 0)
+	if (InBufferSets.Num() == 0)
 		return;
 
-	FHoudiniStaticMeshRenderBufferSet *Buffers = BufferSets.Last();
-
-	PopulateBuffers(Mesh, Buffers);
-
-	ENQUEUE_RENDER_COMMAND(FHoudiniStaticMeshSceneProxy_BuildSingleBufferSet)(
-		[Buffers](FRHICommandListImmediate& RHICMdList)
-	{
-		Buffers->CopyBuffers();
-	});
+	PopulateBuffers(Mesh, InBufferSets.Last());
 }
 
-void FHoudiniStaticMeshSceneProxy::BuildBufferSetsByMaterial()
+void FHoudiniStaticMeshSceneProxy::BuildBufferSetsByMaterial(const TArray<FHoudiniStaticMeshRenderBufferSet*>& InBufferSets)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniStaticMeshSceneProxy::BuildBufferSetsByMaterial"));
 
@@ -484,70 +702,57 @@ void FHoudiniStaticMeshSceneProxy::BuildBufferSetsByMaterial()
 	if (!Mesh)
 		return;
 
-	if (BufferSets.Num() == 0)
+	if (InBufferSets.Num() == 0)
 		return;
 
 	const TArray<int32>& MaterialIDsPerTriangle = Mesh->GetMaterialIDsPerTriangle();
 
 	const uint32 NumTriangles = MaterialIDsPerTriangle.Num();
-	const uint32 NumMaterials = GetNumMaterials();
-	TArray<FThreadSafeCounter> TriCountPerMaterialSafe;
-	TriCountPerMaterialSafe.Init(FThreadSafeCounter(0), NumMaterials);
+	const uint32 NumMaterials = FMath::Min<uint32>(GetNumMaterials(), InBufferSets.Num());
 
-	ParallelFor(NumTriangles, [&](uint32 TriangleID)
+	// Counting sort of the triangles by material, in triangle order so that rebuilding the same mesh
+	// gives the same index buffers
+	TArray<uint32> TriCountPerMaterial;
+	TriCountPerMaterial.SetNumZeroed(NumMaterials);
+	for (uint32 TriangleID = 0; TriangleID < NumTriangles; ++TriangleID)
 	{
 		const int32 MatID = MaterialIDsPerTriangle[TriangleID];
 		if (MatID >= 0 && (uint32) MatID < NumMaterials)
 		{
-			TriCountPerMaterialSafe[MatID].Increment();
+			TriCountPerMaterial[MatID]++;
 		}
-	});
+	}
 
-	TArray<uint32> TriCountPerMaterial;
-	TriCountPerMaterial.SetNumZeroed(NumMaterials);
 	TArray<uint32> OffsetPerMaterial;
 	OffsetPerMaterial.SetNumZeroed(NumMaterials);
-	TArray<FThreadSafeCounter> WrittenPerMaterial;
-	WrittenPerMaterial.Init(FThreadSafeCounter(0), NumMaterials);
-	for (int32 MatID = 0; (uint32) MatID < NumMaterials; ++MatID)
+	for (int32 MatID = 1; (uint32) MatID < NumMaterials; ++MatID)
 	{
-		const uint32 Count = TriCountPerMaterialSafe[MatID].GetValue();
-		TriCountPerMaterial[MatID] = Count;
-		if (MatID > 0)
-		{
-			OffsetPerMaterial[MatID] = OffsetPerMaterial[MatID - 1] + TriCountPerMaterial[MatID - 1];
-		}
+		OffsetPerMaterial[MatID] = OffsetPerMaterial[MatID - 1] + TriCountPerMaterial[MatID - 1];
 	}
 
+	TArray<uint32> WrittenPerMaterial = OffsetPerMaterial;
 	TArray<uint32> GroupTriangleIDs;
 	GroupTriangleIDs.SetNumZeroed(NumTriangles);
-	ParallelFor(NumTriangles, [&](uint32 TriangleID) 
+	for (uint32 TriangleID = 0; TriangleID < NumTriangles; ++TriangleID)
 	{
 		const int32 MatID = MaterialIDsPerTriangle[TriangleID];
 		if (MatID >= 0 && (uint32) MatID < NumMaterials)
 		{
-			GroupTriangleIDs[OffsetPerMaterial[MatID] + WrittenPerMaterial[MatID].Add(1)] = TriangleID;
+			GroupTriangleIDs[WrittenPerMaterial[MatID]++] = TriangleID;
 		}
-	});
+	}
 
-	for (int32 MatID = 0; (uint32) MatID < NumMaterials; ++MatID)
+	// Each buffer set only depends on its own triangles
+	ParallelFor(NumMaterials, [&](uint32 MatID)
 	{
 		if (TriCountPerMaterial[MatID] == 0)
-			continue;
-
-		FHoudiniStaticMeshRenderBufferSet *Buffers = BufferSets[MatID];
+			return;
 
 		PopulateBuffers(
-			Mesh, Buffers,
+			Mesh, InBufferSets[MatID],
 			&GroupTriangleIDs, OffsetPerMaterial[MatID], TriCountPerMaterial[MatID]
 		);
-
-		ENQUEUE_RENDER_COMMAND(FHoudiniStaticMeshSceneProxy_BuildSingleBufferSet)(
-			[Buffers](FRHICommandListImmediate& RHICMdList)
-		{
-			Buffers->CopyBuffers();
-		});
-	}
+	});
 }
 
 UMaterialInterface* FHoudiniStaticMeshSceneProxy::GetMaterial(uint32 InMaterialIdx) const
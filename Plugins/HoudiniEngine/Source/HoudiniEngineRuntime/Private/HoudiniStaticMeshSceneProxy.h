@@ -48,7 +48,10 @@ public:
 	// Data members
 
 	/** The number of triangles in the buffer set. */
-	int NumTriangles;
+	int NumTriangles = 0;
+
+	/** Hash of the vertex count and triangle indices, buffer sets with the same hash can be updated in place. */
+	uint32 TopologyHash = 0;
 
 	/** The static mesh data buffer. */
 	FStaticMeshVertexBuffer StaticMeshVertexBuffer;
@@ -85,6 +88,16 @@ public:
 	 */
 	void InitOrUpdateResource(FRenderResource* Resource);
 
+	/**
+	 * Copy the vertex data of a buffer set with the same topology in the existing GPU buffers,
+	 * without recreating them so cached mesh draw commands stay valid.
+	 * @warning Render thread only.
+	 */
+	void UpdateVertexBuffers(FHoudiniStaticMeshRenderBufferSet& InSource);
+
+	/** Indicates if the vertex data of InOther can be copied in this buffer set's GPU buffers. */
+	bool HasSameLayout(const FHoudiniStaticMeshRenderBufferSet& InOther) const;
+
 protected:
 	friend class FHoudiniStaticMeshSceneProxy;
 
@@ -109,7 +122,19 @@ public:
 	// Build buffer sets to render the mesh.
 	virtual void Build();
 
+	// Rebuild the buffer sets from the component's mesh and update the existing GPU buffers in place.
+	// Returns false, without updating anything, if the topology or materials changed and the proxy must be recreated.
+	// Called on the game thread.
+	bool UpdateBuffersInPlace();
+
+	// Fill the index buffer of a buffer set and size its vertex buffers, without their vertex data.
+	// Vertex instances that share a mesh vertex and all of their attributes are mapped to the same render vertex,
+	// OutRenderVertexInstances receives the vertex instance used by each render vertex.
+	static void InitBufferLayout(const UHoudiniStaticMesh *InMesh, FHoudiniStaticMeshRenderBufferSet *InBuffers, TArray<uint32>& OutRenderVertexInstances, const TArray<uint32>* InTriangleIDs=nullptr, uint32 InTriangleGroupStartIdx=0u, uint32 InNumTrianglesInGroup=0u);
+
 	// FPrimitiveSceneProxy
+	virtual void DrawStaticElements(FStaticPrimitiveDrawInterface* PDI) override;
+
 	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const override;
 
 	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override;
@@ -139,10 +164,19 @@ protected:
 	// different instantiation requirements.
 	virtual FHoudiniStaticMeshRenderBufferSet* MakeNewBufferSet() { return new FHoudiniStaticMeshRenderBufferSet(FeatureLevel);	}
 
+	// Allocate a buffer set per material (or one with the default material), without registering them
+	void AllocateBufferSets(TArray<FHoudiniStaticMeshRenderBufferSet*>& OutBufferSets);
+
+	// Populate the CPU data of the buffer sets from the component's mesh.
+	void PopulateBufferSets(const TArray<FHoudiniStaticMeshRenderBufferSet*>& InBufferSets);
+
 	// Build a single buffer set for the entire mesh (one material for the entire mesh).
-	void BuildSingleBufferSet();
+	void BuildSingleBufferSet(const TArray<FHoudiniStaticMeshRenderBufferSet*>& InBufferSets);
+
+	void BuildBufferSetsByMaterial(const TArray<FHoudiniStaticMeshRenderBufferSet*>& InBufferSets);
 
-	void BuildBufferSetsByMaterial();
+	// Indicates if the view needs the dynamic path (wireframe, bounds and other debug views)
+	bool UseDynamicPath(const FSceneView* View) const;
 
 	// Get the number of materials from the parent mesh/component
 	uint32 GetNumMaterials() const { return Component ? Component->GetNumMaterials() : 0; }
@@ -154,7 +188,7 @@ protected:
 		bool bRenderAsWireframe,
 		ESceneDepthPriorityGroup DepthPriority,
 		int ViewIndex,
-		FDynamicPrimitiveUniformBuffer& DynamicPrimitiveUniformBuffer) const;
+		FDynamicPrimitiveUniformBuffer* DynamicPrimitiveUniformBuffer) const;
 
 	virtual UMaterialInterface* GetMaterial(uint32 InMaterialIdx) const;
 
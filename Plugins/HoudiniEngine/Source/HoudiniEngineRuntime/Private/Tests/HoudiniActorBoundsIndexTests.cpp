@@ -0,0 +1,113 @@
+#include "../HoudiniActorBoundsIndex.h"
+#include "Components/BoxComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniActorBoundsOctreeTest, "Houdini.Core.ActorBoundsIndex.Octree", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniActorBoundsOctreeTest::RunTest(const FString & Parameters)
+{
+	// Enough actors to split the octree's nodes, on a 10x10x10 grid of 1m boxes every 10m
+	TArray<AActor*> Actors;
+	FHoudiniActorBoundsOctree Octree;
+	for (int32 Idx = 0; Idx < 1000; Idx++)
+	{
+		AActor* Actor = NewObject<AActor>(GetTransientPackage());
+		const FVector Center(Idx % 10 * 1000.0, Idx / 10 % 10 * 1000.0, Idx / 100 * 1000.0);
+		Octree.UpdateActor(Actor, FBox(Center - FVector(50.0), Center + FVector(50.0)));
+		Actors.Add(Actor);
+	}
+	TestEqual(TEXT("Indexed actors"), Octree.Num(), Actors.Num());
+
+	// A query must return the same actors as testing every actor's bounds
+	auto FindActors = [&Octree](const TArray<FBox>& InBounds)
+	{
+		TArray<AActor*> Found;
+		TArray<TObjectKey<AActor>> Stale;
+		Octree.FindActors(InBounds, Found, Stale);
+		return Found;
+	};
+
+	// Touching bounds intersect, overlapping queries return the actor only once
+	const FBox FirstRow(FVector(-50.0), FVector(9050.0, 50.0, 50.0));
+	TArray<AActor*> Found = FindActors({ FirstRow, FBox(FVector(950.0, -10.0, -10.0), FVector(1500.0, 10.0, 10.0)) });
+	TestEqual(TEXT("First row actors"), Found.Num(), 10);
+	for (int32 Idx = 0; Idx < 10; Idx++)
+		TestTrue(TEXT("First row contains actor"), Found.Contains(Actors[Idx]));
+
+	TestEqual(TEXT("Empty space"), FindActors({ FBox(FVector(100.0), FVector(900.0)) }).Num(), 0);
+	TestEqual(TEXT("No bounds"), FindActors({}).Num(), 0);
+	TestEqual(TEXT("Whole grid"), FindActors({ FBox(FVector(-100.0), FVector(10000.0)) }).Num(), Actors.Num());
+
+	// Moving an actor out of the row, then removing another one
+	Octree.UpdateActor(Actors[3], FBox(FVector(3950.0, 5950.0, -50.0), FVector(4050.0, 6050.0, 50.0)));
+	TestTrue(TEXT("Removed actor"), Octree.RemoveActor(Actors[5]));
+	TestFalse(TEXT("Removed actor twice"), Octree.RemoveActor(Actors[5]));
+	TestEqual(TEXT("Indexed actors after removal"), Octree.Num(), Actors.Num() - 1);
+
+	Found = FindActors({ FirstRow });
+	TestEqual(TEXT("First row actors after update"), Found.Num(), 8);
+	TestFalse(TEXT("Moved actor"), Found.Contains(Actors[3]));
+	TestFalse(TEXT("Removed actor"), Found.Contains(Actors[5]));
+	TestTrue(TEXT("Moved actor's new position"), FindActors({ FBox(FVector(4000.0, 6000.0, 0.0), FVector(4000.0, 6000.0, 0.0)) }).Contains(Actors[3]));
+
+	// Actors without bounds are at the origin, like their empty bounding box
+	AActor* EmptyActor = NewObject<AActor>(GetTransientPackage());
+	Octree.UpdateActor(EmptyActor, FBox(ForceInit));
+	TestTrue(TEXT("Actor without bounds"), FindActors({ FBox(FVector(-1.0), FVector(1.0)) }).Contains(EmptyActor));
+
+	Octree.Reset();
+	TestEqual(TEXT("Reset"), Octree.Num(), 0);
+	TestEqual(TEXT("Query after reset"), FindActors({ FirstRow }).Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniActorBoundsIndexMovedFromCodeTest, "Houdini.Core.ActorBoundsIndex.MovedFromCode", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniActorBoundsIndexMovedFromCodeTest::RunTest(const FString & Parameters)
+{
+	// Only editor worlds are indexed
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false);
+	if (!TestNotNull(TEXT("Editor world"), World))
+		return false;
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+	WorldContext.SetCurrentWorld(World);
+
+	// A 1m box far from the region
+	AActor* Actor = World->SpawnActor<AActor>(FVector(10000.0, 0.0, 0.0), FRotator::ZeroRotator);
+	UBoxComponent* Box = NewObject<UBoxComponent>(Actor);
+	Box->SetBoxExtent(FVector(50.0));
+	Actor->SetRootComponent(Box);
+	Box->RegisterComponent();
+	Actor->SetActorLocation(FVector(10000.0, 0.0, 0.0));
+
+	const TArray<FBox> Region = { FBox(FVector(-100.0), FVector(100.0)) };
+	TArray<AActor*> Found;
+	TestTrue(TEXT("World indexed"), FHoudiniActorBoundsIndex::FindActorsInBounds(World, Region, Found));
+	TestFalse(TEXT("Actor outside of the region"), Found.Contains(Actor));
+
+	// Moved from code: no editor event, and only the render transform is dirtied
+	Actor->SetActorLocation(FVector::ZeroVector);
+	Found.Reset();
+	FHoudiniActorBoundsIndex::FindActorsInBounds(World, Region, Found);
+	TestTrue(TEXT("Actor moved into the region"), Found.Contains(Actor));
+
+	Actor->SetActorLocation(FVector(0.0, -10000.0, 0.0));
+	Found.Reset();
+	FHoudiniActorBoundsIndex::FindActorsInBounds(World, Region, Found);
+	TestFalse(TEXT("Actor moved out of the region"), Found.Contains(Actor));
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
+
+#endif
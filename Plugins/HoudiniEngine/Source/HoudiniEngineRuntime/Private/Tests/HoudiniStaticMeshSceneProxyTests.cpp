@@ -0,0 +1,121 @@
+#include "../HoudiniStaticMeshSceneProxy.h"
+#include "../HoudiniStaticMesh.h"
+#include "Materials/Material.h"
+#include "Misc/AutomationTest.h"
+#include "RenderingThread.h"
+#include "UObject/Package.h"
+#if ENGINE_MINOR_VERSION > 1
+	#include "MaterialDomain.h"
+#endif
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Render buffer layouts of a 1m quad, made of two triangles sharing an edge
+namespace HoudiniStaticMeshSceneProxyLayout
+{
+	UHoudiniStaticMesh* CreateQuad(float InHeight)
+	{
+		UHoudiniStaticMesh* Mesh = NewObject<UHoudiniStaticMesh>(GetTransientPackage(), NAME_None, RF_Transient);
+		Mesh->Initialize(4, 2, 1, 0, true, false, false, false);
+
+		const FVector3f Positions[4] = { FVector3f(0.0f, 0.0f, InHeight), FVector3f(100.0f, 0.0f, InHeight), FVector3f(100.0f, 100.0f, InHeight), FVector3f(0.0f, 100.0f, InHeight) };
+		for (uint32 VertexIdx = 0; VertexIdx < 4; VertexIdx++)
+			Mesh->SetVertexPosition(VertexIdx, Positions[VertexIdx]);
+
+		Mesh->SetTriangleVertexIndices(0, FIntVector(0, 1, 2));
+		Mesh->SetTriangleVertexIndices(1, FIntVector(0, 2, 3));
+		for (uint32 TriangleIdx = 0; TriangleIdx < 2; TriangleIdx++)
+		{
+			const FIntVector TriangleIndices = Mesh->GetTriangleIndices()[TriangleIdx];
+			for (uint8 TriVertIdx = 0; TriVertIdx < 3; TriVertIdx++)
+			{
+				const FVector3f& Position = Positions[TriangleIndices[TriVertIdx]];
+				Mesh->SetTriangleVertexNormal(TriangleIdx, TriVertIdx, FVector3f(0.0f, 0.0f, 1.0f));
+				Mesh->SetTriangleVertexUV(TriangleIdx, TriVertIdx, 0, FVector2f(Position.X / 100.0f, Position.Y / 100.0f));
+			}
+		}
+		return Mesh;
+	}
+
+	FHoudiniStaticMeshRenderBufferSet* CreateBufferSet(const UHoudiniStaticMesh* InMesh, TArray<uint32>& OutRenderVertexInstances, const TArray<uint32>* InTriangleIDs=nullptr, uint32 InNumTriangles=0u)
+	{
+		FHoudiniStaticMeshRenderBufferSet* BufferSet = new FHoudiniStaticMeshRenderBufferSet(GMaxRHIFeatureLevel);
+		FHoudiniStaticMeshSceneProxy::InitBufferLayout(InMesh, BufferSet, OutRenderVertexInstances, InTriangleIDs, 0u, InNumTriangles);
+		return BufferSet;
+	}
+
+	// Buffer sets must be deleted on the render thread
+	void DestroyBufferSets(const TArray<FHoudiniStaticMeshRenderBufferSet*>& InBufferSets)
+	{
+		ENQUEUE_RENDER_COMMAND(HoudiniStaticMeshSceneProxyTest_DestroyBufferSets)(
+			[InBufferSets](FRHICommandListImmediate& RHICmdList)
+		{
+			for (FHoudiniStaticMeshRenderBufferSet* BufferSet : InBufferSets)
+				delete BufferSet;
+		});
+		FlushRenderingCommands();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoudiniStaticMeshSceneProxyLayoutTest, "Houdini.Core.StaticMeshSceneProxy.Layout", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoudiniStaticMeshSceneProxyLayoutTest::RunTest(const FString & Parameters)
+{
+	using namespace HoudiniStaticMeshSceneProxyLayout;
+
+	// The two corners on the shared edge have the same attributes in both triangles: 6 instances, 4 render vertices
+	UHoudiniStaticMesh* Quad = CreateQuad(0.0f);
+	TArray<uint32> QuadInstances;
+	FHoudiniStaticMeshRenderBufferSet* QuadBuffers = CreateBufferSet(Quad, QuadInstances);
+	TestEqual(TEXT("Quad triangles"), QuadBuffers->NumTriangles, 2);
+	TestEqual(TEXT("Quad render vertices"), QuadInstances.Num(), 4);
+	TestEqual(TEXT("Quad vertex buffer size"), (int32)QuadBuffers->PositionVertexBuffer.GetNumVertices(), 4);
+	TestTrue(TEXT("Quad render vertex instances"), QuadInstances == TArray<uint32>({ 0, 1, 2, 5 }));
+	TestTrue(TEXT("Quad indices"), QuadBuffers->TriangleIndexBuffer.Indices == TArray<uint32>({ 0, 1, 2, 0, 2, 3 }));
+
+	// Moving the vertices keeps the layout: the vertex buffers can be updated in place
+	UHoudiniStaticMesh* MovedQuad = CreateQuad(50.0f);
+	TArray<uint32> MovedInstances;
+	FHoudiniStaticMeshRenderBufferSet* MovedBuffers = CreateBufferSet(MovedQuad, MovedInstances);
+	TestTrue(TEXT("Moved quad topology hash"), MovedBuffers->TopologyHash == QuadBuffers->TopologyHash);
+	TestTrue(TEXT("Moved quad updated in place"), QuadBuffers->HasSameLayout(*MovedBuffers));
+
+	// A hard edge splits the shared corner into two render vertices, the proxy must be recreated
+	UHoudiniStaticMesh* HardEdgeQuad = CreateQuad(0.0f);
+	HardEdgeQuad->SetTriangleVertexNormal(1, 0, FVector3f(0.0f, 1.0f, 0.0f));
+	TArray<uint32> HardEdgeInstances;
+	FHoudiniStaticMeshRenderBufferSet* HardEdgeBuffers = CreateBufferSet(HardEdgeQuad, HardEdgeInstances);
+	TestEqual(TEXT("Hard edge render vertices"), HardEdgeInstances.Num(), 5);
+	TestTrue(TEXT("Hard edge indices"), HardEdgeBuffers->TriangleIndexBuffer.Indices == TArray<uint32>({ 0, 1, 2, 3, 2, 4 }));
+	TestTrue(TEXT("Hard edge topology hash"), HardEdgeBuffers->TopologyHash != QuadBuffers->TopologyHash);
+	TestFalse(TEXT("Hard edge not updated in place"), QuadBuffers->HasSameLayout(*HardEdgeBuffers));
+
+	// Same vertices, different UVs on the shared corner
+	UHoudiniStaticMesh* SeamQuad = CreateQuad(0.0f);
+	SeamQuad->SetTriangleVertexUV(1, 1, 0, FVector2f(0.5f, 0.5f));
+	TArray<uint32> SeamInstances;
+	FHoudiniStaticMeshRenderBufferSet* SeamBuffers = CreateBufferSet(SeamQuad, SeamInstances);
+	TestEqual(TEXT("UV seam render vertices"), SeamInstances.Num(), 5);
+	TestFalse(TEXT("UV seam not updated in place"), QuadBuffers->HasSameLayout(*SeamBuffers));
+
+	// A material change keeps the topology but not the cached draw commands
+	TArray<uint32> MaterialInstances;
+	FHoudiniStaticMeshRenderBufferSet* MaterialBuffers = CreateBufferSet(Quad, MaterialInstances);
+	TestTrue(TEXT("Rebuilt quad updated in place"), QuadBuffers->HasSameLayout(*MaterialBuffers));
+	MaterialBuffers->Material = UMaterial::GetDefaultMaterial(MD_Surface);
+	TestFalse(TEXT("Material change not updated in place"), QuadBuffers->HasSameLayout(*MaterialBuffers));
+
+	// A material group only maps its own triangles, in the group's order
+	const TArray<uint32> GroupTriangleIDs = { 1 };
+	TArray<uint32> GroupInstances;
+	FHoudiniStaticMeshRenderBufferSet* GroupBuffers = CreateBufferSet(Quad, GroupInstances, &GroupTriangleIDs, 1u);
+	TestEqual(TEXT("Group triangles"), GroupBuffers->NumTriangles, 1);
+	TestTrue(TEXT("Group render vertex instances"), GroupInstances == TArray<uint32>({ 3, 4, 5 }));
+	TestTrue(TEXT("Group indices"), GroupBuffers->TriangleIndexBuffer.Indices == TArray<uint32>({ 0, 1, 2 }));
+
+	DestroyBufferSets({ QuadBuffers, MovedBuffers, HardEdgeBuffers, SeamBuffers, MaterialBuffers, GroupBuffers });
+
+	return true;
+}
+
+#endif
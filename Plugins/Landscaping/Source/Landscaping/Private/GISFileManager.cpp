@@ -862,7 +862,8 @@ FDataLoadResult UGISFileManager::HandleImport()
 	for (auto& Elem : FetchedData)
 	{
 		int TileIndex = Elem.Key;
-		TArray<RasterData> InDatas = Elem.Value;
+		// the fetched rasters are only used by this import, they are written without copying their pixels
+		TArray<RasterData>& InDatas = Elem.Value;
 		// check if we are dealing with vector data
 		if(InDatas[0].Filename.EndsWith(".pbf"))
 		{
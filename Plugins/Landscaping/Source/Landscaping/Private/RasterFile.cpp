@@ -30,7 +30,7 @@ RasterFile::RasterFile(GDALDataset* Dataset)
     }
 }
 
-RasterFile::RasterFile(RasterData InData)
+RasterFile::RasterFile(const RasterData& InData)
 {
     CreateNew(InData);
     if(IsValid())
@@ -265,7 +265,7 @@ bool RasterFile::Warp(FString NewFilename, FString EPSG)
 }
 
 // creates a new RasterFile file with the given extents and all other data from this RasterFile struct
-bool RasterFile::CreateNew(RasterData InData)
+bool RasterFile::CreateNew(const RasterData& InData)
 {
     //UE_LOG(LogTemp, Log, TEXT("Landscaping: Create new raster with %s"), *InData.ToString());
     int SizeBytes = GDALGetDataTypeSizeBytes(GDT_Float32);
@@ -276,6 +276,31 @@ bool RasterFile::CreateNew(RasterData InData)
 		"PROFILE=GeoTIFF",
 		NULL
 	};
+    // stitched mapbox mosaics are written tiled, so warping or cropping only reads the blocks it needs
+    char* TiledArgs[] = {
+        "TILED=YES",
+        "BIGTIFF=IF_SAFER",
+        NULL
+    };
+    char* TiledColorArgs[] = {
+        "PHOTOMETRIC=RGB",
+        "PROFILE=GeoTIFF",
+        "TILED=YES",
+        "BIGTIFF=IF_SAFER",
+        NULL
+    };
+    const int64 PixelCount = (int64)InData.ImportResolution.X * InData.ImportResolution.Y;
+    const bool bHasHeightBuffer = InData.BandCount == 1 && PixelCount > 0 && InData.HeightBuffer.Num() == PixelCount;
+    const bool bHasColorBuffer = InData.BandCount >= 3 && PixelCount > 0 && InData.ColorBuffer.Num() == PixelCount;
+    char** Options = NULL;
+    if(InData.BandCount >= 3)
+    {
+        Options = bHasColorBuffer ? TiledColorArgs : Args;
+    }
+    else if(bHasHeightBuffer)
+    {
+        Options = TiledArgs;
+    }
 
     RasterDataset = GetGDALDriverManager()->GetDriverByName("GTiff")->Create(
         TCHAR_TO_ANSI(*InData.Filename), 
@@ -283,7 +308,7 @@ bool RasterFile::CreateNew(RasterData InData)
         InData.ImportResolution.Y, 
         InData.BandCount, 
         GDT_Float32,
-        InData.BandCount >= 3 ? Args : NULL);
+        Options);
     if(RasterDataset == nullptr && (!FPaths::FileExists(InData.Filename) || InData.Filename.StartsWith("/vsimem/")))
     {
         UE_LOG(LogTemp, Error, TEXT("Landscaping: Could not create Raster %s"), *InData.Filename);
@@ -306,7 +331,58 @@ bool RasterFile::CreateNew(RasterData InData)
         RasterDataset->SetProjection(TCHAR_TO_ANSI(*InData.ProjectionWkt));
     }
     // write data if there is any
-    if(!InData.RasterBandData.IsEmpty() || !InData.ColorBandData.IsEmpty())
+    if(bHasHeightBuffer)
+    {
+        // heightdata already in the target layout, one write for the whole band
+        GDALRasterBand* poBand = RasterDataset->GetRasterBand(1);
+        poBand->SetNoDataValue(InData.NoDataValue);
+        CPLErr e = poBand->RasterIO(
+            GF_Write,
+            0,
+            0,
+            InData.ImportResolution.X,
+            InData.ImportResolution.Y,
+            // GDAL only reads from the buffer on GF_Write
+            const_cast<float*>(InData.HeightBuffer.GetData()),
+            InData.ImportResolution.X,
+            InData.ImportResolution.Y,
+            GDT_Float32,
+            0,
+            0);
+        if(e != CE_None)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Landscaping: Could not write height data to %s"), *InData.Filename);
+            return false;
+        }
+    }
+    else if(bHasColorBuffer)
+    {
+        // one write per band straight from the FColor buffer, the pixel spacing skips the other channels
+        for(int BandNr = 1; BandNr <= 3; BandNr++)
+        {
+            GDALRasterBand* poBand = RasterDataset->GetRasterBand(BandNr);
+            poBand->SetNoDataValue(InData.NoDataValue);
+            const uint8* Channel = BandNr == 1 ? &InData.ColorBuffer[0].R : (BandNr == 2 ? &InData.ColorBuffer[0].G : &InData.ColorBuffer[0].B);
+            CPLErr e = poBand->RasterIO(
+                GF_Write,
+                0,
+                0,
+                InData.ImportResolution.X,
+                InData.ImportResolution.Y,
+                const_cast<uint8*>(Channel),
+                InData.ImportResolution.X,
+                InData.ImportResolution.Y,
+                GDT_Byte,
+                sizeof(FColor),
+                (GSpacing)sizeof(FColor) * InData.ImportResolution.X);
+            if(e != CE_None)
+            {
+                UE_LOG(LogTemp, Error, TEXT("Landscaping: Could not write color band %i to %s"), BandNr, *InData.Filename);
+                return false;
+            }
+        }
+    }
+    else if(!InData.RasterBandData.IsEmpty() || !InData.ColorBandData.IsEmpty())
     {
         for(int BandNr = 1; BandNr <= InData.BandCount; BandNr++)
         {
@@ -23,7 +23,7 @@ class RasterFile
 public:
     RasterFile(FString RasterFilename);
     RasterFile(GDALDataset* Dataset);
-    RasterFile(RasterData InData);
+    RasterFile(const RasterData& InData);
     ~RasterFile();
     void Init();
     const char* GetProjection();
@@ -50,7 +50,7 @@ public:
     FString GetInfo();
 
 private:
-    bool CreateNew(RasterData InData);
+    bool CreateNew(const RasterData& InData);
     GDALResampleAlg GetGDALResampleAlgEnum(ELandscapingResampleAlgorithm InResampleAlg);
     CPLErr GDALReprojectImageMulti( GDALDatasetH hSrcDS, const char *pszSrcWKT,
                     GDALDatasetH hDstDS, const char *pszDstWKT,
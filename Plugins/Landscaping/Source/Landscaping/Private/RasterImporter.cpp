@@ -101,7 +101,7 @@ FString RasterImporter::LoadFiles(TArray<FString>& Filenames, int TileIndex)
 	return FString();
 }
 
-TArray<FString> RasterImporter::WriteFiles(TArray<RasterData> InData)
+TArray<FString> RasterImporter::WriteFiles(TArray<RasterData>& InData)
 {
 	return TileFactory->WriteFiles(InData);
 }
@@ -48,7 +48,8 @@ public:
     
     // TileIndex is only relevant for satellite data, because through heightdata tiles get added
     FString LoadFiles(TArray<FString>& Filenames, int TileIndex = 0);
-    TArray<FString> WriteFiles(TArray<RasterData> InDatas);
+    // converts the extents of InDatas to EPSG:3857 in place
+    TArray<FString> WriteFiles(TArray<RasterData>& InDatas);
     ALandscapeProxy* CreateLandscape(RasterData RasterData, FGuid Guid, RasterImportOptions Options, int TileIndex = 0);
     bool CreateTerrains(UMaterialInterface* Material, TArray<TSharedPtr<MaterialLayerSettings>> LayerSettings, WeightmapImporter* InWeightmapCreator, RasterImportOptions Options);
     bool CreateSatelliteImages(int TileIndex, RasterImportOptions Options);
@@ -185,7 +185,7 @@ bool RasterTileFactory::FetchAuthorityID(FString FileToRead)
 }
 
 // write mapbox downloaded data into geotiff
-TArray<FString> RasterTileFactory::WriteFiles(TArray<RasterData> InDatas)
+TArray<FString> RasterTileFactory::WriteFiles(TArray<RasterData>& InDatas)
 {
 	UE_LOG(LogTemp, Log, TEXT("Landscaping: Write %i Files"), InDatas.Num());
 	int CachedFiles = 0;
@@ -201,17 +201,22 @@ TArray<FString> RasterTileFactory::WriteFiles(TArray<RasterData> InDatas)
 	SlowTask.MakeDialog();
 	SlowTask.EnterProgressFrame();
 	int BandCount = InDatas[0].BandCount;
+	// a stitched mosaic (one raster for all tiles) already is in web mercator and needs no merge
+	bool bStitched = InDatas.Num() == 1 && (!InDatas[0].HeightBuffer.IsEmpty() || !InDatas[0].ColorBuffer.IsEmpty());
 	for(int i = 0; i < InDatas.Num(); i++)
 	{
-		InDatas[i].Projection = "EPSG:3857";
-		FExtents Extents3857 = GisFM->GetCRS()->ConvertFromTo(FExtents(InDatas[i].Bottom, InDatas[i].Left, InDatas[i].Top, InDatas[i].Right), FString("EPSG:4326"), InDatas[i].Projection);
-		InDatas[i].Bottom = Extents3857.Bottom;
-		InDatas[i].Left = Extents3857.Left; 
-		InDatas[i].Top = Extents3857.Top;
-		InDatas[i].Right = Extents3857.Right;
-		InDatas[i].MeterPerPixel.X = FMath::Abs(Extents3857.Right - Extents3857.Left) / InDatas[i].ImportResolution.X;
-		InDatas[i].MeterPerPixel.Y = (Extents3857.Bottom - Extents3857.Top) / InDatas[i].ImportResolution.Y;
-		if(BandCount == 3) // satellite data
+		if(InDatas[i].Projection != "EPSG:3857")
+		{
+			InDatas[i].Projection = "EPSG:3857";
+			FExtents Extents3857 = GisFM->GetCRS()->ConvertFromTo(FExtents(InDatas[i].Bottom, InDatas[i].Left, InDatas[i].Top, InDatas[i].Right), FString("EPSG:4326"), InDatas[i].Projection);
+			InDatas[i].Bottom = Extents3857.Bottom;
+			InDatas[i].Left = Extents3857.Left; 
+			InDatas[i].Top = Extents3857.Top;
+			InDatas[i].Right = Extents3857.Right;
+			InDatas[i].MeterPerPixel.X = FMath::Abs(Extents3857.Right - Extents3857.Left) / InDatas[i].ImportResolution.X;
+			InDatas[i].MeterPerPixel.Y = (Extents3857.Bottom - Extents3857.Top) / InDatas[i].ImportResolution.Y;
+		}
+		if(BandCount == 3 || bStitched) // satellite data or single mosaic
 		{
 			OutFilenames.Add(InDatas[i].Filename);
 		}
@@ -229,7 +234,7 @@ TArray<FString> RasterTileFactory::WriteFiles(TArray<RasterData> InDatas)
 
 	UE_LOG(LogTemp, Log, TEXT("Landscaping: Wrote %i files (found %i in cache)"), InDatas.Num() - CachedFiles, CachedFiles);
 	SlowTask.EnterProgressFrame();
-	if(BandCount == 1) // heightdata
+	if(BandCount == 1 && !bStitched) // heightdata
 	{
 		FScopedSlowTask SlowTaskMerge(InDatas.Num(), FText::FromString("Merging Files"));
 		SlowTaskMerge.MakeDialog();
@@ -50,7 +50,8 @@ class RasterTileFactory
     TArray<FTileImportConfiguration> GetSquareConfigurations();
     TArray<FString> ReadFiles(TArray<FString> FilesToRead, int TileIndex = 0);
     bool FetchAuthorityID(FString FileToRead);
-    TArray<FString> WriteFiles(TArray<RasterData> InDatas);
+    // converts the extents of InDatas to EPSG:3857 in place
+    TArray<FString> WriteFiles(TArray<RasterData>& InDatas);
     bool HasRasterFile(int LandscapeDataIndex) const;
     RasterData GetFirstRasterData(int LandscapeDataIndex, bool bWithRasterBandData = false);
     RasterData GetNextRasterData(int LandscapeDataIndex, int RasterDataIndex);
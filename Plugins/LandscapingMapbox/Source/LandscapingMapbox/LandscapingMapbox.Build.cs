@@ -27,7 +27,9 @@ public class LandscapingMapbox : ModuleRules
 			new string[]
 			{
 				"CoreUObject",
-				"Engine"
+				"Engine",
+				"HTTPServer",
+				"ImageWrapper"
 			}
 			);
 	}
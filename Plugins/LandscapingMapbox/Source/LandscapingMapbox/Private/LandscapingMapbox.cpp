@@ -26,6 +26,10 @@ void FLandscapingMapboxModule::ShutdownModule()
 void FLandscapingMapboxModule::ResetDataSource()
 {
 	UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: LandscapingMapbox - reset Data Source"));
+	for(UMapboxDataSource* DataSource : MapboxDS)
+	{
+		DataSource->CancelFetch();
+	}
 	MapboxDS.Empty();
 }
 
@@ -33,6 +33,32 @@ public:
 	int ZoomSatellite = 16;
 	UPROPERTY(EditAnywhere, Config, Category = Mapbox, meta=(Tooltip="Display a warning message popup when downloading more than a certain number of tiles. E.g. more than 1000 tiles.\n0 means no warn messages."))
 	int TileDownloadWarnLimit = 0;
+	UPROPERTY(EditAnywhere, Config, Category = "Mapbox|Tiles", meta=(Tooltip="Request @2x tiles with 512x512 pixels for 'Mapbox Terrain-RGB v1' and satellite images.\nOne retina tile has the resolution of four regular tiles of the next zoom level, but is only one request.\n'Mapbox Terrain-DEM v1' always uses 512x512 pixel tiles."))
+	bool bRetinaTiles = false;
+	UPROPERTY(EditAnywhere, Config, Category = "Mapbox|Tiles", meta=(Tooltip="Fetch heightmaps and satellite images at full zoom only near the Areas of Interest and at a lower zoom elsewhere.\nLower zoom tiles are upsampled to the full zoom, which reduces the number of requests for large maps a lot."))
+	bool bMixedZoom = false;
+	UPROPERTY(EditAnywhere, Config, Category = "Mapbox|Tiles", meta=(EditCondition="bMixedZoom", ClampMin=1, ClampMax=6, Tooltip="Number of zoom levels below the requested zoom used outside the Areas of Interest.\n2 means one tile covers 4x4 full zoom tiles."))
+	int MixedZoomLevelsBelow = 2;
+	UPROPERTY(EditAnywhere, Config, Category = "Mapbox|Tiles", meta=(EditCondition="bMixedZoom", ClampMin=0, ClampMax=16, Tooltip="Number of full zoom tiles around an Area of Interest which are fetched at full zoom as well."))
+	int MixedZoomMarginTiles = 1;
+	UPROPERTY(EditAnywhere, Config, Category = "Mapbox|Tiles", meta=(EditCondition="bMixedZoom", Tooltip="Areas fetched at full zoom in mixed zoom mode.\nMin is the left longitude and bottom latitude, Max the right longitude and top latitude (WGS84).\nAreas set by the importer (e.g. bounds of imported vector features) are added to these."))
+	TArray<FBox2D> AreasOfInterest;
+	UPROPERTY(EditAnywhere, Config, Category = "Mapbox|Download", meta=(ClampMin=1, ClampMax=64, Tooltip="Maximum number of tile requests sent to Mapbox at the same time.\nDefault is 8."))
+	int MaxConcurrentRequests = 8;
+	UPROPERTY(EditAnywhere, Config, Category = "Mapbox|Download", meta=(ClampMin=0, ClampMax=10, Tooltip="How often a tile is requested again after a connection error, timeout or server error.\nThe delay between retries doubles on every attempt."))
+	int MaxRetries = 3;
+	UPROPERTY(EditAnywhere, Config, Category = "Mapbox|Download", meta=(ClampMin=0.1, ClampMax=60.0, Tooltip="Delay in seconds before the first retry of a failed tile request."))
+	float RetryBaseDelay = 1.0f;
+	UPROPERTY(EditAnywhere, Config, Category = "Mapbox|Download", meta=(ClampMin=0.0, Tooltip="Timeout in seconds for a single tile request.\n0 uses the engine default."))
+	float RequestTimeout = 30.0f;
+	UPROPERTY(EditAnywhere, Config, Category = "Mapbox|Cache", meta=(Tooltip="Keep downloaded tiles in the Landscaping cache directory and reuse them while they are valid according to the Mapbox cache headers."))
+	bool bUseTileCache = true;
+	UPROPERTY(EditAnywhere, Config, Category = "Mapbox|Cache", meta=(EditCondition="bUseTileCache", Tooltip="Serve tiles only from the tile cache, also if they are expired.\nTiles not in the cache are reported as errors, no requests are sent to Mapbox."))
+	bool bOfflineMode = false;
+	UPROPERTY(EditAnywhere, Config, Category = "Mapbox|Cache", meta=(EditCondition="bUseTileCache", ClampMin=0, Tooltip="Maximum size of the tile cache in megabytes. Least recently used tiles are removed first.\n0 means no limit."))
+	int TileCacheSizeLimitMB = 4096;
+	UPROPERTY(EditAnywhere, Config, Category = "Mapbox|Download", AdvancedDisplay, meta=(Tooltip="Base URL of the Mapbox API.\nOnly change this to point to a proxy or a local test server serving tiles in the same url scheme."))
+	FString ApiBaseUrl = TEXT("https://api.mapbox.com");
     
 
 #if WITH_EDITOR
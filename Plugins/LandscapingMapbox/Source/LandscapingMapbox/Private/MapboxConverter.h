@@ -34,4 +34,17 @@ public:
 		double N = Pi - 2.0 * Pi * Y / (double)(1 << Z);
 		return 180.0 / Pi * atan(0.5 * (exp(N) - exp(-N)));
 	}
+
+	// tile corners in web mercator (EPSG:3857) meters, the tile grid is linear in this projection
+	static double TileXToMercatorX(int X, int Z)
+	{
+		const double OriginShift = 20037508.342789244;
+		return X / (double)(1 << Z) * 2.0 * OriginShift - OriginShift;
+	}
+
+	static double TileYToMercatorY(int Y, int Z)
+	{
+		const double OriginShift = 20037508.342789244;
+		return OriginShift - Y / (double)(1 << Z) * 2.0 * OriginShift;
+	}
 };
\ No newline at end of file
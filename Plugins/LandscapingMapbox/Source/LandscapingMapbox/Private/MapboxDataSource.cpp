@@ -4,6 +4,9 @@
 // All Rights Reserved
 
 #include "MapboxDataSource.h"
+#include "LandscapingMapboxSettings.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
 
 
 UMapboxDataSource::UMapboxDataSource() : Super()
@@ -54,6 +57,8 @@ void UMapboxDataSource::FetchData(FLandscapingDataSourceDelegate InOnDataFetched
 	this->RequestedZoomSatellite = Settings->ZoomSatellite;
 	this->MapboxApiKey = Settings->ApiKey;
 	UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: Fetch Data from Mapbox Data Source"));
+	// a running fetch reports its cancellation to the previous listener
+	CancelFetch();
 	this->OnDataFetched = InOnDataFetched;
 	this->Request(this->RequestedBottomLatitude, this->RequestedLeftLongitude, this->RequestedTopLatitude, this->RequestedRightLongitutde, Type);
 }
@@ -96,9 +101,12 @@ bool UMapboxDataSource::ValidateRequest(FString& OutError)
 
 void UMapboxDataSource::Request(double Bottom, double Left, double Top, double Right, ELandscapingRequestDataType Type)
 {
-	this->bRequestFailed = false;
 	this->TotalRequests = 0;
-	this->CompletedRequests = 0;
+	this->FailedRequests = 0;
+	this->PendingDecodes = 0;
+	this->bFetchFinished = false;
+	this->bFetchCancelled = false;
+	this->Mosaic.Reset();
 
 	FString ValidationError;
 	if (!this->ValidateRequest(ValidationError))
@@ -117,10 +125,21 @@ void UMapboxDataSource::Request(double Bottom, double Left, double Top, double R
 	MapboxDimX = MB_DIMX;
 	MapboxDimY = MB_DIMY;
 	ULandscapingMapboxSettings* Settings = GetMutableDefault<ULandscapingMapboxSettings>();
+	if(Settings->bRetinaTiles)
+	{
+		Format = TEXT("@2x.pngraw");
+		MapboxDimX = 2 * MB_DIMX;
+		MapboxDimY = 2 * MB_DIMY;
+	}
 	if(Settings->HeightDataAPI == EMapboxHeightData::MapboxTerrainDEMv1)
 	{
 		Tileset = TEXT("mapbox.mapbox-terrain-dem-v1");
 		Format = TEXT("@2x.pngraw");
+		// the tileset has no data above zoom 14, its 512 pixel tiles match the resolution of zoom 15
+		if(this->RequestedZoom > 14 && Type == ELandscapingRequestDataType::TERRAIN)
+		{
+			UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: Mapbox Terrain-DEM v1 provides data until zoom 14 - using zoom 14 instead of %i"), this->RequestedZoom);
+		}
 		RequestTask->RequestedZoom = this->RequestedZoom > 14 ? 14 : this->RequestedZoom;
 		MapboxDimX = 2 * MB_DIMX;
 		MapboxDimY = 2 * MB_DIMY;
@@ -131,10 +150,10 @@ void UMapboxDataSource::Request(double Bottom, double Left, double Top, double R
 		case ELandscapingRequestDataType::SATELLITE:
 		{
 			Tileset = TEXT("mapbox.satellite");
-			Format = TEXT(".jpg90");
+			Format = Settings->bRetinaTiles ? TEXT("@2x.jpg90") : TEXT(".jpg90");
 			RequestTask->RequestedZoom = this->RequestedZoomSatellite;
-			MapboxDimX = MB_DIMX;
-			MapboxDimY = MB_DIMY;
+			MapboxDimX = Settings->bRetinaTiles ? 2 * MB_DIMX : MB_DIMX;
+			MapboxDimY = Settings->bRetinaTiles ? 2 * MB_DIMY : MB_DIMY;
 			break;
 		}
 		case ELandscapingRequestDataType::VECTOR:
@@ -172,64 +191,183 @@ void UMapboxDataSource::Request(double Bottom, double Left, double Top, double R
 	//UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: minx: %i maxx: %i miny: %i maxy: %i zoom: %i"), minx, maxx, miny, maxy, RequestTask->RequestedZoom);
 
 	this->OutDatas.Empty();
-	this->TotalRequests = (maxx + 1 - minx) * (maxy + 1 - miny);
+	// tiles to request as x, y and zoom
+	TArray<FIntVector> RequestTiles;
+	TArray<bool> NativeTiles;
+	const int Zoom = RequestTask->RequestedZoom;
+	const int CoarseLevels = Settings->MixedZoomLevelsBelow;
+	TArray<FBox2D> Areas = Settings->AreasOfInterest;
+	Areas.Append(this->AreasOfInterest);
+	const bool bMixedZoom = Settings->bMixedZoom && Type != ELandscapingRequestDataType::VECTOR && !Areas.IsEmpty() && CoarseLevels > 0 && Zoom - CoarseLevels >= MB_MINZOOM;
+	if(bMixedZoom)
+	{
+		// full zoom near the areas of interest, the parent tile at the lower zoom everywhere else
+		const int Margin = Settings->MixedZoomMarginTiles;
+		TSet<FIntPoint> ParentTiles;
+		for (int y = miny; y <= maxy; y++)
+		{
+			for (int x = minx; x <= maxx; x++)
+			{
+				const double TileLeft = FMapboxConverter::TileXToLon(x - Margin, Zoom);
+				const double TileRight = FMapboxConverter::TileXToLon(x + 1 + Margin, Zoom);
+				const double TileTop = FMapboxConverter::TileYToLat(y - Margin, Zoom);
+				const double TileBottom = FMapboxConverter::TileYToLat(y + 1 + Margin, Zoom);
+				bool bNative = false;
+				for(const FBox2D& Area : Areas)
+				{
+					if(Area.Min.X <= TileRight && Area.Max.X >= TileLeft && Area.Min.Y <= TileTop && Area.Max.Y >= TileBottom)
+					{
+						bNative = true;
+						break;
+					}
+				}
+				NativeTiles.Add(bNative);
+				if(bNative)
+				{
+					RequestTiles.Add(FIntVector(x, y, Zoom));
+				}
+				else
+				{
+					ParentTiles.Add(FIntPoint(x >> CoarseLevels, y >> CoarseLevels));
+				}
+			}
+		}
+		for(const FIntPoint& Parent : ParentTiles)
+		{
+			RequestTiles.Add(FIntVector(Parent.X, Parent.Y, Zoom - CoarseLevels));
+		}
+		UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: Mixed zoom - %i tiles at zoom %i and %i tiles at zoom %i instead of %i tiles"), 
+			RequestTiles.Num() - ParentTiles.Num(), Zoom, ParentTiles.Num(), Zoom - CoarseLevels, NativeTiles.Num());
+	}
+	else
+	{
+		for (int x = minx; x <= maxx; x++)
+		{
+			for (int y = miny; y <= maxy; y++)
+			{
+				RequestTiles.Add(FIntVector(x, y, Zoom));
+			}
+		}
+	}
+	this->TotalRequests = RequestTiles.Num();
 	if(this->TotalRequests > 0)
 	{
-		FScopedSlowTask MapboxSlowTask(this->TotalRequests, FText::FromString("Requesting Mapbox Tiles"));
-		MapboxSlowTask.MakeDialog();
 		if(Settings->TileDownloadWarnLimit > 0 && this->TotalRequests > Settings->TileDownloadWarnLimit)
 		{
-			FString InfoMsg = FString::Printf(TEXT("With zoom-level %i you are going to import %i tiles from Mapbox.\n\nAre you sure?"), RequestTask->RequestedZoom, this->TotalRequests);
+			FString InfoMsg = FString::Printf(TEXT("With zoom-level %i you are going to import %i tiles from Mapbox.\n\nAre you sure?"), Zoom, this->TotalRequests);
 			EAppReturnType::Type Answer = FMessageDialog::Open(EAppMsgType::OkCancel, FText::FromString(*InfoMsg));
 			if(Answer == EAppReturnType::Cancel)
 			{
-				MapboxSlowTask.Destroy();
 				return;
 			}
 		}
-		for (int x = minx; x <= maxx; x++)
+		FMapboxFetchSettings FetchSettings;
+		FetchSettings.MaxConcurrentRequests = Settings->MaxConcurrentRequests;
+		FetchSettings.MaxRetries = Settings->MaxRetries;
+		FetchSettings.RetryBaseDelay = Settings->RetryBaseDelay;
+		FetchSettings.RequestTimeout = Settings->RequestTimeout;
+		this->Fetcher = MakeShared<FMapboxTileFetcher, ESPMode::ThreadSafe>(FetchSettings);
+		FString BaseUrl = Settings->ApiBaseUrl.IsEmpty() ? FString("https://api.mapbox.com") : Settings->ApiBaseUrl;
+		BaseUrl.RemoveFromEnd(TEXT("/"));
+		this->TileCache.Reset();
+		if(Settings->bUseTileCache)
 		{
-			for (int y = miny; y <= maxy; y++)
+			this->TileCache = FMapboxTileCache::Get(FPaths::Combine(this->CacheWorkingDir, TEXT("TileCache")));
+		}
+		if(Type == ELandscapingRequestDataType::TERRAIN || Type == ELandscapingRequestDataType::SATELLITE)
+		{
+			// decompression on worker threads needs the module loaded on the game thread
+			FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+			this->Mosaic = MakeShared<FMapboxMosaic, ESPMode::ThreadSafe>();
+			const int BandCount = Type == ELandscapingRequestDataType::SATELLITE ? 3 : 1;
+			bool bMosaicAllocated = this->Mosaic->Init(Zoom, minx, miny, maxx + 1 - minx, maxy + 1 - miny, MapboxDimX, BandCount);
+			if(bMosaicAllocated && bMixedZoom)
 			{
-				MapboxSlowTask.EnterProgressFrame(1.0, FText::FromString(FString::Printf(TEXT("Mapbox Requests %i / %i"), this->CompletedRequests + 1, this->TotalRequests)));
+				this->Mosaic->NativeTiles = MoveTemp(NativeTiles);
+				this->Mosaic->Coarse = MakeShared<FMapboxMosaic, ESPMode::ThreadSafe>();
+				bMosaicAllocated = this->Mosaic->Coarse->Init(Zoom - CoarseLevels, minx >> CoarseLevels, miny >> CoarseLevels, 
+					(maxx >> CoarseLevels) + 1 - (minx >> CoarseLevels), (maxy >> CoarseLevels) + 1 - (miny >> CoarseLevels), MapboxDimX, BandCount);
+			}
+			if(!bMosaicAllocated)
+			{
+				this->Mosaic.Reset();
+				this->Fetcher.Reset();
 				RasterData Data = RasterData();
-				if(Type == ELandscapingRequestDataType::VECTOR)
-				{
-					Data.Filename = FString::Printf(TEXT("%s/x%iy%iz%i.pbf"), *this->CacheWorkingDir, x, y, RequestTask->RequestedZoom);
-				}
-				else
-				{
-					FString Postfix = Type == ELandscapingRequestDataType::SATELLITE ? "_sat" : "";
-					Data.Filename = FString::Printf(TEXT("%s/x%iy%iz%i%s.tif"), *this->CacheWorkingDir, x, y, RequestTask->RequestedZoom, *Postfix);
-				}
-				Data.ImportResolution.X = MapboxDimX;
-				Data.ImportResolution.Y = MapboxDimY;
-				Data.Projection = "EPSG:4326";
-				Data.Bottom = FMapboxConverter::TileYToLat(y + 1, RequestTask->RequestedZoom);
-				Data.Left = FMapboxConverter::TileXToLon(x, RequestTask->RequestedZoom);
-				Data.Top = FMapboxConverter::TileYToLat(y, RequestTask->RequestedZoom);
-				Data.Right = FMapboxConverter::TileXToLon(x + 1, RequestTask->RequestedZoom);
-				Data.MeterPerPixel.X = (Data.Right - Data.Left) / Data.ImportResolution.X;
-				Data.MeterPerPixel.Y = (Data.Bottom - Data.Top) / Data.ImportResolution.Y;
-				Data.bMapboxImport = true;
-				Data.BandCount = Type == ELandscapingRequestDataType::SATELLITE ? 3 : 1;
-				FMapboxRequestData RequestData = FMapboxRequestData();
-				RequestData.DataType = Type;
-				RequestData.TileNumberX = x;
-				RequestData.TileNumberY = y;
-				RequestData.RasterData = Data;
-				if(!FPaths::FileExists(Data.Filename))
+				Data.Error = FString::Printf(TEXT("Area too large for zoom-level %i - Please use a lower zoom-level or a smaller Map Bounding Box!"), Zoom);
+				this->OutDatas.Add(Data);
+				this->OnDataFetched.Broadcast(OutDatas, this->LandscapingTileIndex);
+				return;
+			}
+		}
+		for (const FIntVector& RequestTile : RequestTiles)
+		{
+			const int x = RequestTile.X;
+			const int y = RequestTile.Y;
+			const int z = RequestTile.Z;
+			RasterData Data = RasterData();
+			if(Type == ELandscapingRequestDataType::VECTOR)
+			{
+				Data.Filename = FString::Printf(TEXT("%s/x%iy%iz%i.pbf"), *this->CacheWorkingDir, x, y, z);
+			}
+			else
+			{
+				FString Postfix = Type == ELandscapingRequestDataType::SATELLITE ? "_sat" : "";
+				Data.Filename = FString::Printf(TEXT("%s/x%iy%iz%i%s.tif"), *this->CacheWorkingDir, x, y, z, *Postfix);
+			}
+			Data.ImportResolution.X = MapboxDimX;
+			Data.ImportResolution.Y = MapboxDimY;
+			Data.Projection = "EPSG:4326";
+			Data.Bottom = FMapboxConverter::TileYToLat(y + 1, z);
+			Data.Left = FMapboxConverter::TileXToLon(x, z);
+			Data.Top = FMapboxConverter::TileYToLat(y, z);
+			Data.Right = FMapboxConverter::TileXToLon(x + 1, z);
+			Data.MeterPerPixel.X = (Data.Right - Data.Left) / Data.ImportResolution.X;
+			Data.MeterPerPixel.Y = (Data.Bottom - Data.Top) / Data.ImportResolution.Y;
+			Data.bMapboxImport = true;
+			Data.BandCount = Type == ELandscapingRequestDataType::SATELLITE ? 3 : 1;
+			FMapboxRequestData RequestData = FMapboxRequestData();
+			RequestData.DataType = Type;
+			RequestData.TileNumberX = x;
+			RequestData.TileNumberY = y;
+			RequestData.Zoom = z;
+			RequestData.RasterData = Data;
+			RequestData.CacheKey = FMapboxTileCache::MakeKey(Tileset, Format, z, x, y);
+			FString RequestURL = FString::Printf(TEXT("%s/v4/%s/%d/%d/%d%s?access_token=%s"), 
+				*BaseUrl, *Tileset, z, x, y, *Format, *this->MapboxApiKey);
+			if(!this->TileCache.IsValid())
+			{
+				// raster tiles are not written to single files anymore, see CompleteFetch
+				if(this->Mosaic.IsValid() || !FPaths::FileExists(Data.Filename))
 				{
-					FString RequestURL = FString::Printf(TEXT("https://api.mapbox.com/v4/%s/%d/%d/%d%s?access_token=%s"), 
-						*Tileset, RequestTask->RequestedZoom, x, y, *Format, *this->MapboxApiKey);
-					RequestTask->Start(RequestURL, RequestData);
+					this->Fetcher->Enqueue(RequestURL, RequestData);
 				}
 				else
 				{
 					FinishResponse(Data);
 				}
+				continue;
+			}
+			TArray<uint8> CachedContent;
+			TMap<FString, FString> Headers;
+			const EMapboxCacheLookup Lookup = this->TileCache->Lookup(RequestData.CacheKey, Settings->bOfflineMode, CachedContent, Headers);
+			if(Lookup == EMapboxCacheLookup::Hit)
+			{
+				HandleCachedTile(RequestData, CachedContent);
+				continue;
+			}
+			if(Lookup == EMapboxCacheLookup::OfflineMiss)
+			{
+				UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: Tile %s not in cache - no request sent in offline mode"), *RequestData.CacheKey);
+				this->FailedRequests++;
+				continue;
 			}
+			this->Fetcher->Enqueue(RequestURL, RequestData, Headers);
 		}
+		UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: Requesting %i of %i tiles (%i found in cache)"), this->Fetcher->GetTotalCount(), this->TotalRequests, this->TotalRequests - this->Fetcher->GetTotalCount() - this->FailedRequests);
+		this->Fetcher->Start(
+			FMapboxTileFetchedDelegate::CreateUObject(this, &UMapboxDataSource::HandleTileFetched),
+			FMapboxFetchProgressDelegate::CreateUObject(this, &UMapboxDataSource::HandleFetchProgress),
+			FMapboxFetchFinishedDelegate::CreateUObject(this, &UMapboxDataSource::HandleFetchFinished));
 	}
 	else
 	{
@@ -240,159 +378,267 @@ void UMapboxDataSource::Request(double Bottom, double Left, double Top, double R
 	}
 }
 
-void UMapboxDataSource::Start(FString URL, FMapboxRequestData MapboxMetaData)
+void UMapboxDataSource::SetAreasOfInterest(const TArray<FBox2D>& InAreas)
 {
-#if ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION == 25
-	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
-#else 
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
-#endif
-	// UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: Sent Request: %s"), *URL);
-	
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UMapboxDataSource::HandleMapboxResponse, MapboxMetaData);
-	HttpRequest->SetURL(URL);
-	HttpRequest->SetVerb(TEXT("GET"));
-	HttpRequest->ProcessRequest();
+	this->AreasOfInterest = InAreas;
 }
 
-void UMapboxDataSource::HandleMapboxResponse(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FMapboxRequestData MapboxMetaData)
+void UMapboxDataSource::CancelFetch()
 {
-	if (bSucceeded && HttpResponse.IsValid() && HttpResponse->GetContentLength() > 0)
+	if(this->Fetcher.IsValid() && this->Fetcher->IsRunning())
 	{
-		FScopedSlowTask MapboxSlowTask(2.0, FText::FromString(FString::Printf(TEXT("Finishing Request #%i"), this->CompletedRequests + 1)));
-		MapboxSlowTask.MakeDialog();
-		MapboxSlowTask.EnterProgressFrame(1.0);
-		FString ContentType = HttpResponse->GetContentType();
-		if(ContentType.Contains("application/json"))
-		{
-			UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: Could not retrieve expected data from Mapbox: %s"), *HttpResponse->GetContentAsString());
-			MapboxSlowTask.EnterProgressFrame(1.0);
-			return AbortWithError();
-		}
+		this->Fetcher->Cancel();
+	}
+}
 
-		const TArray<uint8>& Content = HttpResponse->GetContent();
-		if(MapboxMetaData.DataType == ELandscapingRequestDataType::VECTOR)
+void UMapboxDataSource::HandleTileFetched(FMapboxTileResult& Result)
+{
+	if(!Result.bSucceeded)
+	{
+		UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: %s"), *Result.Error);
+		if(Result.ContentType.Contains("application/json"))
 		{
-			if(FFileHelper::SaveArrayToFile(Content, *MapboxMetaData.RasterData.Filename))
-			{
-				MapboxSlowTask.EnterProgressFrame(1.0);
-				return FinishResponse(MapboxMetaData.RasterData);
-			}
-			else
-			{
-				UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: Could not save vector file from Mapbox: %s"), *MapboxMetaData.RasterData.Filename);
-				MapboxSlowTask.EnterProgressFrame(1.0);
-				return AbortWithError();
-			}
+			UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: Mapbox responded: %s"), *FString(Result.Content.Num(), UTF8_TO_TCHAR(Result.Content.GetData())));
 		}
+		this->FailedRequests++;
+		return;
+	}
 
-		static const FName MODULE_IMAGE_WRAPPER("ImageWrapper");
-		IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(MODULE_IMAGE_WRAPPER);
-
-		EImageFormat ImageFormat = ImageWrapperModule.DetectImageFormat(Content.GetData(), Content.Num());
-		bool bIsValid = true;
-		if (ImageFormat == EImageFormat::Invalid)
+	if(Result.bNotModified)
+	{
+		bool bExpired = false;
+		if(this->TileCache.IsValid())
 		{
-			
-			UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: Image Download: Could not recognize file type of image downloaded from Mapbox, server-reported content type: %s"), *ContentType);
-			MapboxSlowTask.EnterProgressFrame(1.0);
-			return AbortWithError();
+			this->TileCache->Refresh(Result.MetaData.CacheKey, Result.CacheHeaders);
 		}
-
-		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageFormat);
-		if (!ImageWrapper.IsValid())
+		if(!this->TileCache.IsValid() || !this->TileCache->Find(Result.MetaData.CacheKey, Result.Content, bExpired))
 		{
-			UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: Image Download: Unable to make image wrapper for image format %d"), (int32)ImageFormat);
-			MapboxSlowTask.EnterProgressFrame(1.0);
-			return AbortWithError();
+			UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: Tile %s not modified, but it is missing in the cache"), *Result.MetaData.CacheKey);
+			this->FailedRequests++;
+			return;
 		}
+	}
 
-		if (!ImageWrapper->SetCompressed(Content.GetData(), Content.Num()))
-		{
-			UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: Image Download: Unable to parse image format %d from Mapbox"), (int32)ImageFormat);
-			MapboxSlowTask.EnterProgressFrame(1.0);
-			return AbortWithError();
-		}
+	FScopedSlowTask MapboxSlowTask(1.0, FText::FromString(FString::Printf(TEXT("Mapbox Requests %i / %i"), this->Fetcher->GetCompletedCount(), this->Fetcher->GetTotalCount())));
+	MapboxSlowTask.MakeDialog();
+	MapboxSlowTask.EnterProgressFrame(1.0);
+	if(this->Mosaic.IsValid())
+	{
+		DecodeMosaicTileAsync(Result, !Result.bNotModified);
+		return;
+	}
+	FString DecodeError;
+	RasterData Data = Result.MetaData.RasterData;
+	if(!DecodeTile(Result, Data, DecodeError))
+	{
+		UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: %s"), *DecodeError);
+		this->FailedRequests++;
+		return;
+	}
+	// only tiles which could be decoded end up in the cache
+	if(this->TileCache.IsValid() && !Result.bNotModified)
+	{
+		this->TileCache->Store(Result.MetaData.CacheKey, Result.Content, Result.CacheHeaders);
+	}
+	FinishResponse(Data);
+}
 
-		// UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: Image Download of image format %d"), (int32)ImageFormat);
+void UMapboxDataSource::HandleCachedTile(const FMapboxRequestData& RequestData, TArray<uint8>& Content)
+{
+	FMapboxTileResult Result;
+	Result.MetaData = RequestData;
+	Result.Content = MoveTemp(Content);
+	Result.bSucceeded = true;
+	if(this->Mosaic.IsValid())
+	{
+		DecodeMosaicTileAsync(Result, false);
+		return;
+	}
+	FString DecodeError;
+	RasterData Data = RequestData.RasterData;
+	if(!DecodeTile(Result, Data, DecodeError))
+	{
+		// drop it, so the next import requests the tile again
+		UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: Cached tile %s - %s"), *RequestData.CacheKey, *DecodeError);
+		this->TileCache->Remove(RequestData.CacheKey);
+		this->FailedRequests++;
+		return;
+	}
+	FinishResponse(Data);
+}
 
-		TArray<uint8> RawImageData;
-		if (!ImageWrapper->GetRaw(ERGBFormat::RGBA, 8, RawImageData))
-		{
-			UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: Image Download: Unable to convert image format %d to BGRA 8"), (int32)ImageFormat);
-			MapboxSlowTask.EnterProgressFrame(1.0);
-			return AbortWithError();
-		}
-		
-		// UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: Completed Request, total resolved: %d"), this->CompletedRequests);
+void UMapboxDataSource::HandleFetchProgress(int Completed, int Total)
+{
+	this->OnFetchProgress.Broadcast(Completed, Total);
+}
 
-		MapboxMetaData.RasterData.NoDataValue = -99999;
-		uint64 DataIndex = 0;
-		uint64 DataNum = RawImageData.Num();
-		if(DataNum < MapboxDimX * MapboxDimY)
+void UMapboxDataSource::HandleFetchFinished(bool bCancelled)
+{
+	this->bFetchFinished = true;
+	this->bFetchCancelled = bCancelled;
+	if(bCancelled)
+	{
+		// decodes still running write into the dropped mosaic, their results are ignored
+		this->Mosaic.Reset();
+		this->PendingDecodes = 0;
+	}
+	if(this->PendingDecodes == 0)
+	{
+		CompleteFetch();
+	}
+}
+
+void UMapboxDataSource::DecodeMosaicTileAsync(FMapboxTileResult& Result, bool bStoreInCache)
+{
+	this->PendingDecodes++;
+	TWeakObjectPtr<UMapboxDataSource> WeakThis(this);
+	TSharedPtr<FMapboxMosaic, ESPMode::ThreadSafe> TargetMosaic = this->Mosaic;
+	Async(EAsyncExecution::ThreadPool, [WeakThis, TargetMosaic, Result = MoveTemp(Result), bStoreInCache]() mutable
+	{
+		FString DecodeError;
+		bool bDecoded = false;
+		TArray<uint8> Rgba;
+		int Width = 0;
+		int Height = 0;
+		if(Result.ContentType.Contains("application/json"))
 		{
-			UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: Data does not match (%i), (Rows: %i Columns: %i)"), DataNum, MapboxDimY, MapboxDimX);
-			MapboxSlowTask.EnterProgressFrame(1.0);
-			return AbortWithError();
+			DecodeError = FString::Printf(TEXT("Could not retrieve expected data from Mapbox: %s"), *FString(Result.Content.Num(), UTF8_TO_TCHAR(Result.Content.GetData())));
 		}
-		TArray<FColor> ColorBand;
-		for(int Row = 0; Row < MapboxDimX; Row++)
+		else if(FMapboxTerrainDecoder::Decompress(Result.Content, Rgba, Width, Height, DecodeError))
 		{
-			if(MapboxMetaData.DataType == ELandscapingRequestDataType::TERRAIN)
-			{
-				MapboxMetaData.RasterData.RasterBandData.Add(TArray<double>());
-			}
-			else if(MapboxMetaData.DataType == ELandscapingRequestDataType::SATELLITE)
+			FMapboxMosaic* Target = TargetMosaic->GetTarget(Result.MetaData.Zoom);
+			if(Width != Target->TileDim || Height != Target->TileDim || !Target->Contains(Result.MetaData.TileNumberX, Result.MetaData.TileNumberY))
 			{
-				MapboxMetaData.RasterData.ColorBandData.Add(TArray<FColor>());
+				DecodeError = FString::Printf(TEXT("Data does not match (%ix%i), (Rows: %i Columns: %i)"), Width, Height, Target->TileDim, Target->TileDim);
 			}
-			for(int Column = 0; Column < MapboxDimY; Column++)
+			else
 			{
-				const FColor* Source = &((FColor*)(RawImageData.GetData()))[DataIndex];
-				if(MapboxMetaData.DataType == ELandscapingRequestDataType::TERRAIN)
-				{	
-					// according to https://docs.mapbox.com/MapboxMetaData/tilesets/guides/access-elevation-MapboxMetaData/
-					// elevation = -10000 + (({R} * 256 * 256 + {G} * 256 + {B}) * 0.1)
-					// note: in the FColor we deal with BGR (so we have to swap R and B)
-					double Height = DataIndex < DataNum ? -10000.0 + ((Source->B * 256 * 256 + Source->G * 256 + Source->R) * 0.1) : MapboxMetaData.RasterData.NoDataValue;
-					MapboxMetaData.RasterData.RasterBandData[Row].Add(Height);
+				const int TileX = Result.MetaData.TileNumberX;
+				const int TileY = Result.MetaData.TileNumberY;
+				if(Target->BandCount == 1)
+				{
+					FMapboxTerrainDecoder::DecodeTile(Rgba.GetData(), Target->TileDim, Target->GetTileOrigin(TileX, TileY), Target->Width);
 				}
-				else if(MapboxMetaData.DataType == ELandscapingRequestDataType::SATELLITE)
+				else
 				{
-					MapboxMetaData.RasterData.ColorBandData[Row].Add(FColor(Source->B, Source->G, Source->R, Source->A));
-					ColorBand.Add(FColor(Source->B, Source->G, Source->R, Source->A));
+					FMapboxTerrainDecoder::CopyColorTile(Rgba.GetData(), Target->TileDim, Target->GetColorTileOrigin(TileX, TileY), Target->Width);
 				}
-				DataIndex++;
+				bDecoded = true;
 			}
 		}
-		
-		MapboxSlowTask.EnterProgressFrame(1.0);
-		FinishResponse(MapboxMetaData.RasterData);
-		return;
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, TargetMosaic, Result = MoveTemp(Result), bStoreInCache, bDecoded, DecodeError]()
+		{
+			// the data source is gone or a new request was started meanwhile
+			if(WeakThis.IsValid() && WeakThis->Mosaic == TargetMosaic)
+			{
+				WeakThis->HandleMosaicTileDecoded(Result, bStoreInCache, bDecoded, DecodeError);
+			}
+		});
+	});
+}
+
+void UMapboxDataSource::HandleMosaicTileDecoded(const FMapboxTileResult& Result, bool bStoreInCache, bool bDecoded, const FString& DecodeError)
+{
+	this->PendingDecodes--;
+	if(!bDecoded)
+	{
+		UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: Tile %s - %s"), *Result.MetaData.CacheKey, *DecodeError);
+		if(this->TileCache.IsValid() && !bStoreInCache)
+		{
+			// drop it, so the next import requests the tile again
+			this->TileCache->Remove(Result.MetaData.CacheKey);
+		}
+		this->FailedRequests++;
 	}
-	
-	if (!bSucceeded)
+	else if(this->TileCache.IsValid() && bStoreInCache)
 	{
-		AbortWithError();
+		// only tiles which could be decoded end up in the cache
+		this->TileCache->Store(Result.MetaData.CacheKey, Result.Content, Result.CacheHeaders);
+	}
+	if(this->bFetchFinished && this->PendingDecodes == 0)
+	{
+		CompleteFetch();
 	}
 }
 
-void UMapboxDataSource::AbortWithError()
+void UMapboxDataSource::CompleteFetch()
 {
-	this->CompletedRequests++;
-	if (this->CompletedRequests >= this->TotalRequests)
+	if(this->TileCache.IsValid())
 	{
-		this->OnDataFetched.Broadcast(OutDatas, this->LandscapingTileIndex);
+		ULandscapingMapboxSettings* Settings = GetMutableDefault<ULandscapingMapboxSettings>();
+		this->TileCache->Trim((int64)Settings->TileCacheSizeLimitMB * 1024 * 1024);
+		this->TileCache->Save();
+	}
+	if(this->bFetchCancelled)
+	{
+		RasterData Data = RasterData();
+		Data.Error = "Mapbox requests cancelled";
+		this->OutDatas.Add(Data);
+	}
+	else if(this->FailedRequests > 0)
+	{
+		// tiles missing in the result would leave holes in the landscape
+		RasterData Data = RasterData();
+		Data.Error = FString::Printf(TEXT("%i of %i tiles could not be fetched from Mapbox - see Output Log for details"), this->FailedRequests, this->TotalRequests);
+		this->OutDatas.Add(Data);
 	}
+	else
+	{
+		UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: Requests done"));
+		if(this->Mosaic.IsValid())
+		{
+			if(Mosaic->Coarse.IsValid())
+			{
+				FMapboxTerrainDecoder::FillFromCoarse(*Mosaic);
+				Mosaic->Coarse.Reset();
+			}
+			// all tiles as one web mercator raster, the importer writes it as a single GeoTIFF and uses it as the only source
+			RasterData Data = RasterData();
+			FString Postfix = Mosaic->BandCount == 3 ? "_sat" : "";
+			Data.Filename = FString::Printf(TEXT("%s/mosaic_x%i-%iy%i-%iz%i%s.tif"), *this->CacheWorkingDir, 
+				Mosaic->MinTileX, Mosaic->MinTileX + Mosaic->TilesX - 1, Mosaic->MinTileY, Mosaic->MinTileY + Mosaic->TilesY - 1, Mosaic->Zoom, *Postfix);
+			// the importer keeps existing files
+			IFileManager::Get().Delete(*Data.Filename, false, true, true);
+			Data.ImportResolution.X = Mosaic->Width;
+			Data.ImportResolution.Y = Mosaic->Height;
+			Data.Projection = "EPSG:3857";
+			Data.Bottom = FMapboxConverter::TileYToMercatorY(Mosaic->MinTileY + Mosaic->TilesY, Mosaic->Zoom);
+			Data.Left = FMapboxConverter::TileXToMercatorX(Mosaic->MinTileX, Mosaic->Zoom);
+			Data.Top = FMapboxConverter::TileYToMercatorY(Mosaic->MinTileY, Mosaic->Zoom);
+			Data.Right = FMapboxConverter::TileXToMercatorX(Mosaic->MinTileX + Mosaic->TilesX, Mosaic->Zoom);
+			Data.MeterPerPixel.X = (Data.Right - Data.Left) / Data.ImportResolution.X;
+			Data.MeterPerPixel.Y = (Data.Bottom - Data.Top) / Data.ImportResolution.Y;
+			Data.bMapboxImport = true;
+			Data.BandCount = Mosaic->BandCount;
+			Data.NoDataValue = MB_NODATA;
+			Data.HeightBuffer = MoveTemp(Mosaic->Heights);
+			Data.ColorBuffer = MoveTemp(Mosaic->Colors);
+			this->OutDatas.Add(MoveTemp(Data));
+		}
+	}
+	this->Mosaic.Reset();
+	this->OnDataFetched.Broadcast(OutDatas, this->LandscapingTileIndex);
 }
 
-void UMapboxDataSource::FinishResponse(RasterData Data)
+bool UMapboxDataSource::DecodeTile(const FMapboxTileResult& Result, RasterData& OutData, FString& OutError)
 {
-	this->CompletedRequests++;
-	this->OutDatas.Add(Data);
-	if (this->CompletedRequests >= this->TotalRequests)
+	FString ContentType = Result.ContentType;
+	if(ContentType.Contains("application/json"))
 	{
-		UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: Requests done"));
-		this->OnDataFetched.Broadcast(OutDatas, this->LandscapingTileIndex);
+		OutError = FString::Printf(TEXT("Could not retrieve expected data from Mapbox: %s"), *FString(Result.Content.Num(), UTF8_TO_TCHAR(Result.Content.GetData())));
+		return false;
 	}
+
+	// raster tiles are decoded into the mosaic by DecodeMosaicTileAsync
+	if(!FFileHelper::SaveArrayToFile(Result.Content, *OutData.Filename))
+	{
+		OutError = FString::Printf(TEXT("Could not save vector file from Mapbox: %s"), *OutData.Filename);
+		return false;
+	}
+	return true;
+}
+
+void UMapboxDataSource::FinishResponse(RasterData Data)
+{
+	this->OutDatas.Add(Data);
 }
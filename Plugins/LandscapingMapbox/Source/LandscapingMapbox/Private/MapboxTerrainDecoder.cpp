@@ -0,0 +1,193 @@
+// Copyright (c) 2021-2023 Josef Prenner
+// support@ludicdrive.com
+// ludicdrive.com
+// All Rights Reserved
+
+#include "MapboxTerrainDecoder.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Modules/ModuleManager.h"
+#include "Async/ParallelFor.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#include <arm_neon.h>
+#define MB_TERRAIN_NEON 1
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+#include <emmintrin.h>
+#define MB_TERRAIN_SSE 1
+#endif
+
+
+void FMapboxTerrainDecoder::DecodeRow(const uint8* Rgba, float* OutHeights, int Count)
+{
+	int i = 0;
+	// 4 pixels per iteration: the RGBA bytes of a pixel are one little endian uint32,
+	// R, G and B are masked out, recombined to R << 16 | G << 8 | B and converted to float
+#if MB_TERRAIN_SSE
+	const __m128i ByteMask = _mm_set1_epi32(0xFF);
+	const __m128 Scale = _mm_set1_ps(0.1f);
+	const __m128 Offset = _mm_set1_ps(-10000.0f);
+	for(; i + 4 <= Count; i += 4)
+	{
+		const __m128i Pixels = _mm_loadu_si128((const __m128i*)(Rgba + i * 4));
+		const __m128i R = _mm_and_si128(Pixels, ByteMask);
+		const __m128i G = _mm_and_si128(_mm_srli_epi32(Pixels, 8), ByteMask);
+		const __m128i B = _mm_and_si128(_mm_srli_epi32(Pixels, 16), ByteMask);
+		const __m128i Value = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(R, 16), _mm_slli_epi32(G, 8)), B);
+		_mm_storeu_ps(OutHeights + i, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(Value), Scale), Offset));
+	}
+#elif MB_TERRAIN_NEON
+	const uint32x4_t ByteMask = vdupq_n_u32(0xFF);
+	const float32x4_t Scale = vdupq_n_f32(0.1f);
+	const float32x4_t Offset = vdupq_n_f32(-10000.0f);
+	for(; i + 4 <= Count; i += 4)
+	{
+		const uint32x4_t Pixels = vld1q_u32((const uint32_t*)(Rgba + i * 4));
+		const uint32x4_t R = vandq_u32(Pixels, ByteMask);
+		const uint32x4_t G = vandq_u32(vshrq_n_u32(Pixels, 8), ByteMask);
+		const uint32x4_t B = vandq_u32(vshrq_n_u32(Pixels, 16), ByteMask);
+		const uint32x4_t Value = vorrq_u32(vorrq_u32(vshlq_n_u32(R, 16), vshlq_n_u32(G, 8)), B);
+		vst1q_f32(OutHeights + i, vaddq_f32(vmulq_f32(vcvtq_f32_u32(Value), Scale), Offset));
+	}
+#endif
+	DecodeRowScalar(Rgba + i * 4, OutHeights + i, Count - i);
+}
+
+void FMapboxTerrainDecoder::DecodeRowScalar(const uint8* Rgba, float* OutHeights, int Count)
+{
+	for(int i = 0; i < Count; i++)
+	{
+		const uint8* Pixel = Rgba + i * 4;
+		const int32 Value = (Pixel[0] << 16) | (Pixel[1] << 8) | Pixel[2];
+		OutHeights[i] = (float)Value * 0.1f + -10000.0f;
+	}
+}
+
+void FMapboxTerrainDecoder::DecodeTile(const uint8* Rgba, int Dim, float* Dest, int Stride)
+{
+	for(int Row = 0; Row < Dim; Row++)
+	{
+		DecodeRow(Rgba + (int64)Row * Dim * 4, Dest + (int64)Row * Stride, Dim);
+	}
+}
+
+void FMapboxTerrainDecoder::CopyColorTile(const uint8* Rgba, int Dim, FColor* Dest, int Stride)
+{
+	for(int Row = 0; Row < Dim; Row++)
+	{
+		const uint8* Source = Rgba + (int64)Row * Dim * 4;
+		FColor* DestLine = Dest + (int64)Row * Stride;
+		for(int Column = 0; Column < Dim; Column++)
+		{
+			DestLine[Column] = FColor(Source[0], Source[1], Source[2], Source[3]);
+			Source += 4;
+		}
+	}
+}
+
+void FMapboxTerrainDecoder::FillFromCoarse(FMapboxMosaic& Mosaic)
+{
+	if(!Mosaic.Coarse.IsValid() || Mosaic.NativeTiles.IsEmpty() || Mosaic.Coarse->Zoom >= Mosaic.Zoom)
+	{
+		return;
+	}
+	const FMapboxMosaic& Coarse = *Mosaic.Coarse;
+	// pixel centers are aligned in the global pixel grid of both zoom levels
+	const double Scale = (double)Coarse.TileDim / Mosaic.TileDim / (double)(1 << (Mosaic.Zoom - Coarse.Zoom));
+	const double FineOriginX = (double)Mosaic.MinTileX * Mosaic.TileDim;
+	const double FineOriginY = (double)Mosaic.MinTileY * Mosaic.TileDim;
+	const double CoarseOriginX = (double)Coarse.MinTileX * Coarse.TileDim;
+	const double CoarseOriginY = (double)Coarse.MinTileY * Coarse.TileDim;
+	ParallelFor(Mosaic.Height, [&](int Row)
+	{
+		const int TileY = Mosaic.MinTileY + Row / Mosaic.TileDim;
+		const double CoarseY = (FineOriginY + Row + 0.5) * Scale - 0.5 - CoarseOriginY;
+		const int Y0 = FMath::Clamp(FMath::FloorToInt(CoarseY), 0, Coarse.Height - 1);
+		const int Y1 = FMath::Min(Y0 + 1, Coarse.Height - 1);
+		const double FractionY = FMath::Clamp(CoarseY - Y0, 0.0, 1.0);
+		for(int Column = 0; Column < Mosaic.Width; Column++)
+		{
+			const int TileX = Mosaic.MinTileX + Column / Mosaic.TileDim;
+			if(Mosaic.IsNative(TileX, TileY))
+			{
+				// skip to the next tile
+				Column += Mosaic.TileDim - 1 - Column % Mosaic.TileDim;
+				continue;
+			}
+			const double CoarseX = (FineOriginX + Column + 0.5) * Scale - 0.5 - CoarseOriginX;
+			const int X0 = FMath::Clamp(FMath::FloorToInt(CoarseX), 0, Coarse.Width - 1);
+			const int X1 = FMath::Min(X0 + 1, Coarse.Width - 1);
+			const double FractionX = FMath::Clamp(CoarseX - X0, 0.0, 1.0);
+			const int64 Indices[4] = { (int64)Y0 * Coarse.Width + X0, (int64)Y0 * Coarse.Width + X1, (int64)Y1 * Coarse.Width + X0, (int64)Y1 * Coarse.Width + X1 };
+			const double Weights[4] = { (1.0 - FractionX) * (1.0 - FractionY), FractionX * (1.0 - FractionY), (1.0 - FractionX) * FractionY, FractionX * FractionY };
+			const int64 Index = (int64)Row * Mosaic.Width + Column;
+			if(Mosaic.BandCount == 1)
+			{
+				// nodata samples (tiles which were fetched at full zoom only) do not contribute
+				double Sum = 0;
+				double WeightSum = 0;
+				for(int i = 0; i < 4; i++)
+				{
+					const float Sample = Coarse.Heights[Indices[i]];
+					if(Sample != MB_NODATA)
+					{
+						Sum += Sample * Weights[i];
+						WeightSum += Weights[i];
+					}
+				}
+				Mosaic.Heights[Index] = WeightSum > 0 ? (float)(Sum / WeightSum) : MB_NODATA;
+			}
+			else
+			{
+				// same for pixels of coarse tiles which were not fetched, they would darken the border
+				double R = 0, G = 0, B = 0;
+				double WeightSum = 0;
+				for(int i = 0; i < 4; i++)
+				{
+					const FColor& Sample = Coarse.Colors[Indices[i]];
+					if(Sample != MB_NODATA_COLOR)
+					{
+						R += Sample.R * Weights[i];
+						G += Sample.G * Weights[i];
+						B += Sample.B * Weights[i];
+						WeightSum += Weights[i];
+					}
+				}
+				Mosaic.Colors[Index] = WeightSum > 0
+					? FColor((uint8)FMath::RoundToInt(R / WeightSum), (uint8)FMath::RoundToInt(G / WeightSum), (uint8)FMath::RoundToInt(B / WeightSum), 255)
+					: MB_NODATA_COLOR;
+			}
+		}
+	});
+}
+
+bool FMapboxTerrainDecoder::Decompress(const TArray<uint8>& Content, TArray<uint8>& OutRgba, int& OutWidth, int& OutHeight, FString& OutError)
+{
+	static const FName MODULE_IMAGE_WRAPPER("ImageWrapper");
+	IImageWrapperModule* ImageWrapperModule = FModuleManager::GetModulePtr<IImageWrapperModule>(MODULE_IMAGE_WRAPPER);
+	if(ImageWrapperModule == nullptr)
+	{
+		OutError = TEXT("ImageWrapper module not loaded");
+		return false;
+	}
+	EImageFormat ImageFormat = ImageWrapperModule->DetectImageFormat(Content.GetData(), Content.Num());
+	if (ImageFormat == EImageFormat::Invalid)
+	{
+		OutError = TEXT("Image Download: Could not recognize file type of image downloaded from Mapbox");
+		return false;
+	}
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule->CreateImageWrapper(ImageFormat);
+	if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(Content.GetData(), Content.Num()))
+	{
+		OutError = FString::Printf(TEXT("Image Download: Unable to parse image format %d from Mapbox"), (int32)ImageFormat);
+		return false;
+	}
+	if (!ImageWrapper->GetRaw(ERGBFormat::RGBA, 8, OutRgba))
+	{
+		OutError = FString::Printf(TEXT("Image Download: Unable to convert image format %d to RGBA 8"), (int32)ImageFormat);
+		return false;
+	}
+	OutWidth = (int)ImageWrapper->GetWidth();
+	OutHeight = (int)ImageWrapper->GetHeight();
+	return true;
+}
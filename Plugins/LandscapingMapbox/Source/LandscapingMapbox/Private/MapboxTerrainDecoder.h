@@ -0,0 +1,121 @@
+// Copyright (c) 2021-2023 Josef Prenner
+// support@ludicdrive.com
+// ludicdrive.com
+// All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#define MB_NODATA -99999.0f
+// satellite pixels are opaque, transparent black marks pixels of tiles which were not fetched
+#define MB_NODATA_COLOR FColor(0, 0, 0, 0)
+
+/**
+ * Height or color buffer for the whole requested tile range.
+ * Tiles are decoded straight into their place in the buffer, each tile owns a disjoint
+ * block of pixels, so tiles can be decoded concurrently without locking.
+ */
+struct FMapboxMosaic
+{
+	int Zoom = 0;
+	int MinTileX = 0;
+	int MinTileY = 0;
+	int TilesX = 0;
+	int TilesY = 0;
+	int TileDim = 256;
+	int Width = 0;
+	int Height = 0;
+	// 1 for terrain, 3 for satellite
+	int BandCount = 1;
+	// row-major, Width * Height, only one of them is allocated depending on BandCount
+	TArray<float> Heights = TArray<float>();
+	TArray<FColor> Colors = TArray<FColor>();
+	// mixed zoom: tiles outside the areas of interest are fetched at a lower zoom into Coarse
+	// and upsampled into this mosaic, NativeTiles marks the tiles fetched at Zoom
+	TSharedPtr<FMapboxMosaic, ESPMode::ThreadSafe> Coarse = nullptr;
+	TArray<bool> NativeTiles = TArray<bool>();
+
+	// returns false, leaving the mosaic empty, if the pixel count does not fit a TArray
+	bool Init(int InZoom, int InMinTileX, int InMinTileY, int InTilesX, int InTilesY, int InTileDim, int InBandCount = 1)
+	{
+		Zoom = InZoom;
+		MinTileX = InMinTileX;
+		MinTileY = InMinTileY;
+		TilesX = InTilesX;
+		TilesY = InTilesY;
+		TileDim = InTileDim;
+		BandCount = InBandCount;
+		Heights.Empty();
+		Colors.Empty();
+		const int64 PixelsX = (int64)TilesX * TileDim;
+		const int64 PixelsY = (int64)TilesY * TileDim;
+		if(PixelsX > MAX_int32 || PixelsY > MAX_int32 || PixelsX * PixelsY > MAX_int32)
+		{
+			UE_LOG(LogTemp, Error, TEXT("LandscapingMapbox: %i x %i tiles at zoom %i exceed the maximum of %i pixels - please use a lower zoom or a smaller area"), TilesX, TilesY, Zoom, MAX_int32);
+			Width = 0;
+			Height = 0;
+			return false;
+		}
+		Width = (int)PixelsX;
+		Height = (int)PixelsY;
+		if(BandCount == 1)
+		{
+			Heights.Init(MB_NODATA, Width * Height);
+		}
+		else
+		{
+			Colors.Init(MB_NODATA_COLOR, Width * Height);
+		}
+		return true;
+	}
+
+	bool Contains(int TileX, int TileY) const
+	{
+		return TileX >= MinTileX && TileX < MinTileX + TilesX && TileY >= MinTileY && TileY < MinTileY + TilesY;
+	}
+
+	bool IsNative(int TileX, int TileY) const
+	{
+		return NativeTiles.IsEmpty() || NativeTiles[(TileY - MinTileY) * TilesX + (TileX - MinTileX)];
+	}
+
+	// the mosaic a tile of the given zoom is decoded into
+	FMapboxMosaic* GetTarget(int TileZoom)
+	{
+		return TileZoom != Zoom && Coarse.IsValid() ? Coarse.Get() : this;
+	}
+
+	int64 GetTileOffset(int TileX, int TileY) const
+	{
+		return (int64)(TileY - MinTileY) * TileDim * Width + (int64)(TileX - MinTileX) * TileDim;
+	}
+
+	float* GetTileOrigin(int TileX, int TileY)
+	{
+		return Heights.GetData() + GetTileOffset(TileX, TileY);
+	}
+
+	FColor* GetColorTileOrigin(int TileX, int TileY)
+	{
+		return Colors.GetData() + GetTileOffset(TileX, TileY);
+	}
+};
+
+class FMapboxTerrainDecoder
+{
+public:
+	// according to https://docs.mapbox.com/data/tilesets/guides/access-elevation-data/
+	// elevation = -10000 + ((R * 256 * 256 + G * 256 + B) * 0.1) for Count RGBA8 pixels
+	static void DecodeRow(const uint8* Rgba, float* OutHeights, int Count);
+	static void DecodeRowScalar(const uint8* Rgba, float* OutHeights, int Count);
+	// decodes a Dim x Dim tile into the mosaic, Stride is the row length of the destination
+	static void DecodeTile(const uint8* Rgba, int Dim, float* Dest, int Stride);
+	// copies a Dim x Dim satellite tile into the mosaic
+	static void CopyColorTile(const uint8* Rgba, int Dim, FColor* Dest, int Stride);
+	// fills all tiles of the mosaic which are not native with bilinear samples of its coarse mosaic,
+	// sampling across coarse tile borders so upsampled neighbours have no seams
+	static void FillFromCoarse(FMapboxMosaic& Mosaic);
+	// png / webp to RGBA8, safe to call from worker threads once the ImageWrapper module is loaded
+	static bool Decompress(const TArray<uint8>& Content, TArray<uint8>& OutRgba, int& OutWidth, int& OutHeight, FString& OutError);
+};
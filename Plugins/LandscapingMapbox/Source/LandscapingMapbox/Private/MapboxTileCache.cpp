@@ -0,0 +1,367 @@
+// Copyright (c) 2021-2023 Josef Prenner
+// support@ludicdrive.com
+// ludicdrive.com
+// All Rights Reserved
+
+#include "MapboxTileCache.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "HAL/FileManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+// lifetime of a tile if the response has neither Cache-Control max-age nor Expires
+#define MB_CACHE_DEFAULT_LIFETIME 86400
+#define MB_CACHE_INDEX_VERSION 1
+
+
+TSharedRef<FMapboxTileCache, ESPMode::ThreadSafe> FMapboxTileCache::Get(const FString& CacheDir)
+{
+	static TMap<FString, TSharedRef<FMapboxTileCache, ESPMode::ThreadSafe>> Caches;
+	static FCriticalSection CachesMutex;
+	FScopeLock Lock(&CachesMutex);
+	FString Dir = FPaths::ConvertRelativePathToFull(CacheDir);
+	if(TSharedRef<FMapboxTileCache, ESPMode::ThreadSafe>* Existing = Caches.Find(Dir))
+	{
+		return *Existing;
+	}
+	TSharedRef<FMapboxTileCache, ESPMode::ThreadSafe> Cache = MakeShared<FMapboxTileCache, ESPMode::ThreadSafe>(Dir);
+	Caches.Add(Dir, Cache);
+	return Cache;
+}
+
+FString FMapboxTileCache::MakeKey(const FString& Tileset, const FString& Format, int Zoom, int X, int Y)
+{
+	return FString::Printf(TEXT("%s%s/%i/%i/%i"), *Tileset, *Format, Zoom, X, Y);
+}
+
+FMapboxTileCache::FMapboxTileCache(const FString& InCacheDir)
+	: CacheDir(InCacheDir)
+{
+	IFileManager::Get().MakeDirectory(*FPaths::Combine(CacheDir, TEXT("Blobs")), true);
+	Load();
+}
+
+bool FMapboxTileCache::Find(const FString& Key, TArray<uint8>& OutContent, bool& bOutExpired)
+{
+	FScopeLock Lock(&Mutex);
+	FMapboxTileCacheEntry* Entry = Entries.Find(Key);
+	if(Entry == nullptr)
+	{
+		return false;
+	}
+	if(!FFileHelper::LoadFileToArray(OutContent, *GetBlobPath(Entry->Hash), FILEREAD_Silent)
+		|| FSHA1::HashBuffer(OutContent.GetData(), OutContent.Num()).ToString() != Entry->Hash)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LandscapingMapbox: Cached tile %s is missing or corrupt - requesting it again"), *Key);
+		OutContent.Empty();
+		ReleaseBlob(Entry->Hash, Entry->Size);
+		Entries.Remove(Key);
+		bDirty = true;
+		return false;
+	}
+	const int64 Now = FDateTime::UtcNow().ToUnixTimestamp();
+	bOutExpired = Entry->ExpiresAt <= Now;
+	Entry->LastAccess = Now;
+	bDirty = true;
+	return true;
+}
+
+bool FMapboxTileCache::GetValidators(const FString& Key, FString& OutETag, FString& OutLastModified)
+{
+	FScopeLock Lock(&Mutex);
+	const FMapboxTileCacheEntry* Entry = Entries.Find(Key);
+	if(Entry == nullptr)
+	{
+		return false;
+	}
+	OutETag = Entry->ETag;
+	OutLastModified = Entry->LastModified;
+	return !OutETag.IsEmpty() || !OutLastModified.IsEmpty();
+}
+
+EMapboxCacheLookup FMapboxTileCache::Lookup(const FString& Key, bool bOfflineMode, TArray<uint8>& OutContent, TMap<FString, FString>& OutHeaders)
+{
+	bool bExpired = false;
+	if(Find(Key, OutContent, bExpired) && (!bExpired || bOfflineMode))
+	{
+		return EMapboxCacheLookup::Hit;
+	}
+	OutContent.Empty();
+	if(bOfflineMode)
+	{
+		return EMapboxCacheLookup::OfflineMiss;
+	}
+	// an expired tile is revalidated, Mapbox answers with 304 if it did not change
+	FString ETag, LastModified;
+	if(GetValidators(Key, ETag, LastModified))
+	{
+		if(!ETag.IsEmpty())
+		{
+			OutHeaders.Add(TEXT("If-None-Match"), ETag);
+		}
+		if(!LastModified.IsEmpty())
+		{
+			OutHeaders.Add(TEXT("If-Modified-Since"), LastModified);
+		}
+	}
+	return EMapboxCacheLookup::Request;
+}
+
+void FMapboxTileCache::Store(const FString& Key, const TArray<uint8>& Content, const FMapboxCacheHeaders& Headers)
+{
+	int64 ExpiresAt = 0;
+	if(Content.IsEmpty() || !GetExpiry(Headers, ExpiresAt))
+	{
+		return;
+	}
+	FString Hash = FSHA1::HashBuffer(Content.GetData(), Content.Num()).ToString();
+	FScopeLock Lock(&Mutex);
+	FString BlobPath = GetBlobPath(Hash);
+	if(!BlobRefs.Contains(Hash) || !FPaths::FileExists(BlobPath))
+	{
+		// write to a temp file first, so an interrupted write never leaves a truncated blob
+		FString TempPath = BlobPath + TEXT(".tmp");
+		if(!FFileHelper::SaveArrayToFile(Content, *TempPath) || !IFileManager::Get().Move(*BlobPath, *TempPath, true, true))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("LandscapingMapbox: Could not write tile %s to cache %s"), *Key, *BlobPath);
+			return;
+		}
+	}
+	FMapboxTileCacheEntry Entry;
+	Entry.Hash = Hash;
+	Entry.Size = Content.Num();
+	Entry.ExpiresAt = ExpiresAt;
+	Entry.LastAccess = FDateTime::UtcNow().ToUnixTimestamp();
+	Entry.ETag = Headers.ETag;
+	Entry.LastModified = Headers.LastModified;
+	int& Refs = BlobRefs.FindOrAdd(Hash);
+	if(Refs == 0)
+	{
+		TotalSize += Entry.Size;
+	}
+	Refs++;
+	// release the previous content only after referencing the new one, both may share the blob
+	if(FMapboxTileCacheEntry* Existing = Entries.Find(Key))
+	{
+		ReleaseBlob(Existing->Hash, Existing->Size);
+	}
+	Entries.Add(Key, Entry);
+	bDirty = true;
+}
+
+void FMapboxTileCache::Refresh(const FString& Key, const FMapboxCacheHeaders& Headers)
+{
+	FScopeLock Lock(&Mutex);
+	FMapboxTileCacheEntry* Entry = Entries.Find(Key);
+	int64 ExpiresAt = 0;
+	if(Entry == nullptr || !GetExpiry(Headers, ExpiresAt))
+	{
+		return;
+	}
+	Entry->ExpiresAt = ExpiresAt;
+	Entry->LastAccess = FDateTime::UtcNow().ToUnixTimestamp();
+	if(!Headers.ETag.IsEmpty())
+	{
+		Entry->ETag = Headers.ETag;
+	}
+	if(!Headers.LastModified.IsEmpty())
+	{
+		Entry->LastModified = Headers.LastModified;
+	}
+	bDirty = true;
+}
+
+void FMapboxTileCache::Remove(const FString& Key)
+{
+	FScopeLock Lock(&Mutex);
+	if(FMapboxTileCacheEntry* Entry = Entries.Find(Key))
+	{
+		ReleaseBlob(Entry->Hash, Entry->Size);
+		Entries.Remove(Key);
+		bDirty = true;
+	}
+}
+
+void FMapboxTileCache::Trim(int64 MaxSizeBytes)
+{
+	FScopeLock Lock(&Mutex);
+	if(MaxSizeBytes <= 0 || TotalSize <= MaxSizeBytes)
+	{
+		return;
+	}
+	TArray<TPair<int64, FString>> ByAccess;
+	for(const TPair<FString, FMapboxTileCacheEntry>& Elem : Entries)
+	{
+		ByAccess.Add(TPair<int64, FString>(Elem.Value.LastAccess, Elem.Key));
+	}
+	ByAccess.Sort([](const TPair<int64, FString>& A, const TPair<int64, FString>& B) { return A.Key < B.Key; });
+	int Evicted = 0;
+	for(const TPair<int64, FString>& Elem : ByAccess)
+	{
+		if(TotalSize <= MaxSizeBytes)
+		{
+			break;
+		}
+		ReleaseBlob(Entries[Elem.Value].Hash, Entries[Elem.Value].Size);
+		Entries.Remove(Elem.Value);
+		Evicted++;
+	}
+	bDirty = true;
+	UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: Evicted %i tiles from cache - %.1f MB in %i tiles remaining"), Evicted, TotalSize / (1024.0 * 1024.0), Entries.Num());
+}
+
+bool FMapboxTileCache::Save()
+{
+	FScopeLock Lock(&Mutex);
+	if(!bDirty)
+	{
+		return true;
+	}
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("version"), MB_CACHE_INDEX_VERSION);
+	TSharedRef<FJsonObject> JsonEntries = MakeShared<FJsonObject>();
+	for(const TPair<FString, FMapboxTileCacheEntry>& Elem : Entries)
+	{
+		TSharedRef<FJsonObject> JsonEntry = MakeShared<FJsonObject>();
+		JsonEntry->SetStringField(TEXT("hash"), Elem.Value.Hash);
+		JsonEntry->SetNumberField(TEXT("size"), Elem.Value.Size);
+		JsonEntry->SetNumberField(TEXT("expires"), Elem.Value.ExpiresAt);
+		JsonEntry->SetNumberField(TEXT("access"), Elem.Value.LastAccess);
+		if(!Elem.Value.ETag.IsEmpty())
+		{
+			JsonEntry->SetStringField(TEXT("etag"), Elem.Value.ETag);
+		}
+		if(!Elem.Value.LastModified.IsEmpty())
+		{
+			JsonEntry->SetStringField(TEXT("modified"), Elem.Value.LastModified);
+		}
+		JsonEntries->SetObjectField(Elem.Key, JsonEntry);
+	}
+	Root->SetObjectField(TEXT("tiles"), JsonEntries);
+	FString Output;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	if(!FJsonSerializer::Serialize(Root, Writer))
+	{
+		return false;
+	}
+	FString TempPath = GetIndexPath() + TEXT(".tmp");
+	if(!FFileHelper::SaveStringToFile(Output, *TempPath) || !IFileManager::Get().Move(*GetIndexPath(), *TempPath, true, true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LandscapingMapbox: Could not write tile cache index %s"), *GetIndexPath());
+		return false;
+	}
+	bDirty = false;
+	return true;
+}
+
+bool FMapboxTileCache::Load()
+{
+	FString Input;
+	if(!FFileHelper::LoadFileToString(Input, *GetIndexPath()))
+	{
+		return false;
+	}
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Input);
+	if(!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || Root->GetIntegerField(TEXT("version")) != MB_CACHE_INDEX_VERSION)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LandscapingMapbox: Tile cache index %s is invalid - starting with an empty cache"), *GetIndexPath());
+		return false;
+	}
+	const TSharedPtr<FJsonObject>* JsonEntries;
+	if(!Root->TryGetObjectField(TEXT("tiles"), JsonEntries))
+	{
+		return false;
+	}
+	for(const TPair<FString, TSharedPtr<FJsonValue>>& Elem : (*JsonEntries)->Values)
+	{
+		const TSharedPtr<FJsonObject>* JsonEntry;
+		if(!Elem.Value->TryGetObject(JsonEntry))
+		{
+			continue;
+		}
+		FMapboxTileCacheEntry Entry;
+		Entry.Hash = (*JsonEntry)->GetStringField(TEXT("hash"));
+		Entry.Size = (int64)(*JsonEntry)->GetNumberField(TEXT("size"));
+		Entry.ExpiresAt = (int64)(*JsonEntry)->GetNumberField(TEXT("expires"));
+		Entry.LastAccess = (int64)(*JsonEntry)->GetNumberField(TEXT("access"));
+		(*JsonEntry)->TryGetStringField(TEXT("etag"), Entry.ETag);
+		(*JsonEntry)->TryGetStringField(TEXT("modified"), Entry.LastModified);
+		if(Entry.Hash.IsEmpty())
+		{
+			continue;
+		}
+		int& Refs = BlobRefs.FindOrAdd(Entry.Hash);
+		if(Refs == 0)
+		{
+			TotalSize += Entry.Size;
+		}
+		Refs++;
+		Entries.Add(Elem.Key, Entry);
+	}
+	UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: Tile cache with %i tiles (%.1f MB) loaded from %s"), Entries.Num(), TotalSize / (1024.0 * 1024.0), *CacheDir);
+	return true;
+}
+
+FString FMapboxTileCache::GetBlobPath(const FString& Hash) const
+{
+	return FPaths::Combine(CacheDir, TEXT("Blobs"), Hash + TEXT(".bin"));
+}
+
+FString FMapboxTileCache::GetIndexPath() const
+{
+	return FPaths::Combine(CacheDir, TEXT("index.json"));
+}
+
+void FMapboxTileCache::ReleaseBlob(const FString& Hash, int64 Size)
+{
+	int* Refs = BlobRefs.Find(Hash);
+	if(Refs == nullptr)
+	{
+		return;
+	}
+	(*Refs)--;
+	if(*Refs <= 0)
+	{
+		TotalSize -= Size;
+		IFileManager::Get().Delete(*GetBlobPath(Hash), false, false, true);
+		BlobRefs.Remove(Hash);
+	}
+}
+
+bool FMapboxTileCache::GetExpiry(const FMapboxCacheHeaders& Headers, int64& OutExpiresAt)
+{
+	const int64 Now = FDateTime::UtcNow().ToUnixTimestamp();
+	TArray<FString> Directives;
+	Headers.CacheControl.ParseIntoArray(Directives, TEXT(","));
+	for(FString Directive : Directives)
+	{
+		Directive.TrimStartAndEndInline();
+		if(Directive.Equals(TEXT("no-store"), ESearchCase::IgnoreCase))
+		{
+			return false;
+		}
+		if(Directive.Equals(TEXT("no-cache"), ESearchCase::IgnoreCase))
+		{
+			// keep it, but revalidate before every use
+			OutExpiresAt = Now;
+			return true;
+		}
+		if(Directive.StartsWith(TEXT("max-age="), ESearchCase::IgnoreCase))
+		{
+			OutExpiresAt = Now + FCString::Atoi64(*Directive.RightChop(8));
+			return true;
+		}
+	}
+	FDateTime ExpiresDate;
+	if(!Headers.Expires.IsEmpty() && FDateTime::ParseHttpDate(Headers.Expires, ExpiresDate))
+	{
+		OutExpiresAt = ExpiresDate.ToUnixTimestamp();
+		return true;
+	}
+	OutExpiresAt = Now + MB_CACHE_DEFAULT_LIFETIME;
+	return true;
+}
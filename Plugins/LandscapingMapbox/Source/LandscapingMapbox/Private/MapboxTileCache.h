@@ -0,0 +1,88 @@
+// Copyright (c) 2021-2023 Josef Prenner
+// support@ludicdrive.com
+// ludicdrive.com
+// All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+struct FMapboxTileCacheEntry
+{
+	// SHA1 of the tile content, also the name of the blob file
+	FString Hash = FString();
+	int64 Size = 0;
+	// unix timestamps in seconds
+	int64 ExpiresAt = 0;
+	int64 LastAccess = 0;
+	FString ETag = FString();
+	FString LastModified = FString();
+};
+
+struct FMapboxCacheHeaders
+{
+	FString CacheControl = FString();
+	FString Expires = FString();
+	FString ETag = FString();
+	FString LastModified = FString();
+};
+
+// how a tile is loaded, see FMapboxTileCache::Lookup
+enum class EMapboxCacheLookup : uint8
+{
+	// the cached content is used without a request
+	Hit,
+	// the tile is requested, conditionally if the headers carry the validators of an expired entry
+	Request,
+	// offline mode and the tile is not cached, it fails without a request
+	OfflineMiss
+};
+
+/**
+ * Content-addressed on-disk cache for raw Mapbox tile responses.
+ * Tiles are keyed by tileset, format, zoom, x and y. The content is stored once per SHA1 hash
+ * in Blobs/, so identical tiles (e.g. ocean or empty vector tiles) share one file.
+ * Expiry follows the Cache-Control / Expires headers of the response, ETag and Last-Modified
+ * are kept for revalidation. The cache is trimmed least recently used first to the size limit.
+ * Instances are shared per directory, see Get().
+ */
+class FMapboxTileCache
+{
+public:
+	static TSharedRef<FMapboxTileCache, ESPMode::ThreadSafe> Get(const FString& CacheDir);
+	static FString MakeKey(const FString& Tileset, const FString& Format, int Zoom, int X, int Y);
+
+	FMapboxTileCache(const FString& InCacheDir);
+
+	// returns false on cache miss or if the stored content does not match its hash
+	bool Find(const FString& Key, TArray<uint8>& OutContent, bool& bOutExpired);
+	// validators of a stored entry to send with a conditional request
+	bool GetValidators(const FString& Key, FString& OutETag, FString& OutLastModified);
+	// in offline mode expired entries are used and missing tiles are not requested
+	EMapboxCacheLookup Lookup(const FString& Key, bool bOfflineMode, TArray<uint8>& OutContent, TMap<FString, FString>& OutHeaders);
+	void Store(const FString& Key, const TArray<uint8>& Content, const FMapboxCacheHeaders& Headers);
+	// a 304 response only updates the expiry of an entry
+	void Refresh(const FString& Key, const FMapboxCacheHeaders& Headers);
+	void Remove(const FString& Key);
+	void Trim(int64 MaxSizeBytes);
+	bool Save();
+
+	int64 GetTotalSize() const { return TotalSize; }
+	int GetNumEntries() const { return Entries.Num(); }
+
+private:
+	bool Load();
+	FString GetBlobPath(const FString& Hash) const;
+	FString GetIndexPath() const;
+	void ReleaseBlob(const FString& Hash, int64 Size);
+	static bool GetExpiry(const FMapboxCacheHeaders& Headers, int64& OutExpiresAt);
+
+	FString CacheDir;
+	TMap<FString, FMapboxTileCacheEntry> Entries = TMap<FString, FMapboxTileCacheEntry>();
+	// number of entries referencing a blob
+	TMap<FString, int> BlobRefs = TMap<FString, int>();
+	int64 TotalSize = 0;
+	bool bDirty = false;
+	mutable FCriticalSection Mutex;
+};
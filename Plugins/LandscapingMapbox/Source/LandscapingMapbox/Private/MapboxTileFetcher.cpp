@@ -0,0 +1,249 @@
+// Copyright (c) 2021-2023 Josef Prenner
+// support@ludicdrive.com
+// ludicdrive.com
+// All Rights Reserved
+
+#include "MapboxTileFetcher.h"
+
+
+FMapboxTileFetcher::FMapboxTileFetcher(const FMapboxFetchSettings& InSettings)
+	: Settings(InSettings)
+{
+	Settings.MaxConcurrentRequests = FMath::Max(1, Settings.MaxConcurrentRequests);
+	Settings.MaxRetries = FMath::Max(0, Settings.MaxRetries);
+}
+
+FMapboxTileFetcher::~FMapboxTileFetcher()
+{
+	if(TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+}
+
+void FMapboxTileFetcher::Enqueue(const FString& URL, const FMapboxRequestData& MetaData, const TMap<FString, FString>& Headers)
+{
+	FPendingTile Tile;
+	Tile.URL = URL;
+	Tile.MetaData = MetaData;
+	Tile.Headers = Headers;
+	Pending.Add(Tile);
+	TotalCount++;
+}
+
+void FMapboxTileFetcher::Start(FMapboxTileFetchedDelegate InOnTileFetched, FMapboxFetchProgressDelegate InOnProgress, FMapboxFetchFinishedDelegate InOnFinished)
+{
+	OnTileFetched = InOnTileFetched;
+	OnProgress = InOnProgress;
+	OnFinished = InOnFinished;
+	CompletedCount = 0;
+	FailedCount = 0;
+	RateLimitedUntil = 0;
+	bRunning = true;
+	if(Pending.IsEmpty())
+	{
+		Finish(false);
+		return;
+	}
+	// the ticker picks up retries whose backoff delay has passed
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FMapboxTileFetcher::Tick), 0.1f);
+	Dispatch();
+}
+
+void FMapboxTileFetcher::Cancel()
+{
+	if(!bRunning)
+	{
+		return;
+	}
+	UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: Cancel fetch - %i of %i tiles done, %i in flight"), CompletedCount, TotalCount, InFlight.Num());
+	bRunning = false;
+	Pending.Empty();
+	TArray<FHttpRequestPtr> RequestsToCancel = InFlight;
+	InFlight.Empty();
+	for(FHttpRequestPtr HttpRequest : RequestsToCancel)
+	{
+		HttpRequest->CancelRequest();
+	}
+	Finish(true);
+}
+
+bool FMapboxTileFetcher::Tick(float DeltaTime)
+{
+	Dispatch();
+	return true;
+}
+
+void FMapboxTileFetcher::Dispatch()
+{
+	const double Now = FPlatformTime::Seconds();
+	if(!bRunning || Now < RateLimitedUntil)
+	{
+		return;
+	}
+	// tiles are kept in enqueue order, retries are appended with their NotBefore time
+	for(int i = 0; i < Pending.Num() && InFlight.Num() < Settings.MaxConcurrentRequests;)
+	{
+		if(Pending[i].NotBefore > Now)
+		{
+			i++;
+			continue;
+		}
+		FPendingTile Tile = MoveTemp(Pending[i]);
+		Pending.RemoveAt(i, 1, false);
+		Send(MoveTemp(Tile));
+	}
+}
+
+void FMapboxTileFetcher::Send(FPendingTile Tile)
+{
+#if ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION == 25
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+#else
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+#endif
+	Tile.Attempts++;
+	HttpRequest->OnProcessRequestComplete().BindSP(this, &FMapboxTileFetcher::HandleResponse, Tile);
+	HttpRequest->SetURL(Tile.URL);
+	HttpRequest->SetVerb(TEXT("GET"));
+	for(const TPair<FString, FString>& Header : Tile.Headers)
+	{
+		HttpRequest->SetHeader(Header.Key, Header.Value);
+	}
+	if(Settings.RequestTimeout > 0)
+	{
+		HttpRequest->SetTimeout(Settings.RequestTimeout);
+	}
+	InFlight.Add(HttpRequest);
+	HttpRequest->ProcessRequest();
+}
+
+void FMapboxTileFetcher::HandleResponse(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FPendingTile Tile)
+{
+	if(!bRunning)
+	{
+		// cancelled
+		return;
+	}
+	InFlight.Remove(HttpRequest);
+
+	const int ResponseCode = HttpResponse.IsValid() ? HttpResponse->GetResponseCode() : 0;
+	const bool bCanRetry = Tile.Attempts <= Settings.MaxRetries;
+	if(ResponseCode == EHttpResponseCodes::TooManyRequests)
+	{
+		const double Delay = FMath::Max(GetRetryAfter(HttpResponse), GetBackoffDelay(Tile.Attempts));
+		RateLimitedUntil = FMath::Max(RateLimitedUntil, FPlatformTime::Seconds() + Delay);
+		UE_LOG(LogTemp, Warning, TEXT("LandscapingMapbox: Rate limited by Mapbox - pausing requests for %.1f seconds"), Delay);
+		if(bCanRetry)
+		{
+			Retry(MoveTemp(Tile), Delay);
+			return;
+		}
+	}
+	else if(!bSucceeded || !HttpResponse.IsValid() || IsRetryable(ResponseCode))
+	{
+		if(bCanRetry)
+		{
+			Retry(MoveTemp(Tile), GetBackoffDelay(Tile.Attempts));
+			return;
+		}
+	}
+
+	FMapboxTileResult Result;
+	Result.MetaData = MoveTemp(Tile.MetaData);
+	Result.Attempts = Tile.Attempts;
+	Result.ResponseCode = ResponseCode;
+	if(HttpResponse.IsValid())
+	{
+		Result.ContentType = HttpResponse->GetContentType();
+		Result.Content = HttpResponse->GetContent();
+		Result.CacheHeaders.CacheControl = HttpResponse->GetHeader(TEXT("Cache-Control"));
+		Result.CacheHeaders.Expires = HttpResponse->GetHeader(TEXT("Expires"));
+		Result.CacheHeaders.ETag = HttpResponse->GetHeader(TEXT("ETag"));
+		Result.CacheHeaders.LastModified = HttpResponse->GetHeader(TEXT("Last-Modified"));
+	}
+	Result.bNotModified = bSucceeded && ResponseCode == EHttpResponseCodes::NotModified;
+	Result.bSucceeded = Result.bNotModified || (bSucceeded && EHttpResponseCodes::IsOk(ResponseCode) && Result.Content.Num() > 0);
+	if(!Result.bSucceeded)
+	{
+		Result.Error = FString::Printf(TEXT("Tile x%i y%i failed after %i attempt(s) - %s"),
+			Result.MetaData.TileNumberX, Result.MetaData.TileNumberY, Result.Attempts,
+			ResponseCode > 0 ? *FString::Printf(TEXT("HTTP %i"), ResponseCode) : TEXT("no response"));
+	}
+	Complete(Result);
+	Dispatch();
+}
+
+void FMapboxTileFetcher::Retry(FPendingTile Tile, double Delay)
+{
+	UE_LOG(LogTemp, Log, TEXT("LandscapingMapbox: Retry tile x%i y%i in %.1f seconds (attempt %i of %i)"),
+		Tile.MetaData.TileNumberX, Tile.MetaData.TileNumberY, Delay, Tile.Attempts + 1, Settings.MaxRetries + 1);
+	Tile.NotBefore = FPlatformTime::Seconds() + Delay;
+	Pending.Add(MoveTemp(Tile));
+	Dispatch();
+}
+
+void FMapboxTileFetcher::Complete(FMapboxTileResult& Result)
+{
+	CompletedCount++;
+	if(!Result.bSucceeded)
+	{
+		FailedCount++;
+	}
+	OnTileFetched.ExecuteIfBound(Result);
+	OnProgress.ExecuteIfBound(CompletedCount, TotalCount);
+	if(bRunning && CompletedCount >= TotalCount)
+	{
+		Finish(false);
+	}
+}
+
+void FMapboxTileFetcher::Finish(bool bCancelled)
+{
+	bRunning = false;
+	if(TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	OnFinished.ExecuteIfBound(bCancelled);
+}
+
+double FMapboxTileFetcher::GetBackoffDelay(int Attempts) const
+{
+	// exponential backoff with jitter, so parallel retries do not hit the server at the same time
+	const double Delay = Settings.RetryBaseDelay * FMath::Pow(2.0, FMath::Max(0, Attempts - 1));
+	return FMath::Min((double)Settings.RetryMaxDelay, Delay * FMath::FRandRange(0.75, 1.25));
+}
+
+double FMapboxTileFetcher::GetRetryAfter(FHttpResponsePtr HttpResponse) const
+{
+	if(!HttpResponse.IsValid())
+	{
+		return 0;
+	}
+	FString RetryAfter = HttpResponse->GetHeader(TEXT("Retry-After"));
+	if(RetryAfter.IsEmpty())
+	{
+		return 0;
+	}
+	if(RetryAfter.IsNumeric())
+	{
+		return FMath::Clamp(FCString::Atod(*RetryAfter), 0.0, (double)Settings.RetryMaxDelay);
+	}
+	FDateTime RetryAt;
+	if(FDateTime::ParseHttpDate(RetryAfter, RetryAt))
+	{
+		return FMath::Clamp((RetryAt - FDateTime::UtcNow()).GetTotalSeconds(), 0.0, (double)Settings.RetryMaxDelay);
+	}
+	return 0;
+}
+
+bool FMapboxTileFetcher::IsRetryable(int ResponseCode)
+{
+	return ResponseCode == EHttpResponseCodes::RequestTimeout
+		|| ResponseCode == EHttpResponseCodes::ServerError
+		|| ResponseCode == EHttpResponseCodes::BadGateway
+		|| ResponseCode == EHttpResponseCodes::ServiceUnavail
+		|| ResponseCode == EHttpResponseCodes::GatewayTimeout;
+}
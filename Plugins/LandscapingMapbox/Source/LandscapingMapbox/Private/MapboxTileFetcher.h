@@ -0,0 +1,115 @@
+// Copyright (c) 2021-2023 Josef Prenner
+// support@ludicdrive.com
+// ludicdrive.com
+// All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Interfaces/IHttpRequest.h"
+#include "ILandscapingDataSource.h"
+#include "MapboxTileCache.h"
+#include "RasterData.h"
+
+struct FMapboxRequestData
+{
+	ELandscapingRequestDataType DataType;
+	int TileNumberX;
+	int TileNumberY;
+	int Zoom = 0;
+	FString CacheKey;
+	RasterData RasterData;
+};
+
+struct FMapboxTileResult
+{
+	FMapboxRequestData MetaData;
+	TArray<uint8> Content;
+	FString ContentType;
+	int ResponseCode = 0;
+	int Attempts = 0;
+	bool bSucceeded = false;
+	// 304 on a conditional request, the content is still the cached one
+	bool bNotModified = false;
+	FMapboxCacheHeaders CacheHeaders;
+	FString Error = FString();
+};
+
+struct FMapboxFetchSettings
+{
+	// number of requests in flight at the same time
+	int MaxConcurrentRequests = 8;
+	// retries per tile after the first attempt failed
+	int MaxRetries = 3;
+	// delay before the first retry in seconds, doubled on every further retry
+	float RetryBaseDelay = 1.0f;
+	// upper bound for the backoff delay and for a Retry-After header
+	float RetryMaxDelay = 60.0f;
+	// per request timeout in seconds, 0 means the http module default
+	float RequestTimeout = 30.0f;
+};
+
+DECLARE_DELEGATE_OneParam(FMapboxTileFetchedDelegate, FMapboxTileResult&);
+DECLARE_DELEGATE_TwoParams(FMapboxFetchProgressDelegate, int, int);
+DECLARE_DELEGATE_OneParam(FMapboxFetchFinishedDelegate, bool);
+
+/**
+ * Schedules Mapbox tile downloads with a bounded number of concurrent requests.
+ * Transient failures (connection errors, timeouts, 5xx) are retried with exponential backoff,
+ * a 429 response pauses all requests until the Retry-After time has passed.
+ * Every enqueued tile is reported exactly once through OnTileFetched, successful or not,
+ * so the finished delegate always fires - either when all tiles are resolved or on Cancel.
+ * All callbacks are executed on the game thread.
+ */
+class FMapboxTileFetcher : public TSharedFromThis<FMapboxTileFetcher, ESPMode::ThreadSafe>
+{
+public:
+	FMapboxTileFetcher(const FMapboxFetchSettings& InSettings);
+	~FMapboxTileFetcher();
+
+	void Enqueue(const FString& URL, const FMapboxRequestData& MetaData, const TMap<FString, FString>& Headers = TMap<FString, FString>());
+	void Start(FMapboxTileFetchedDelegate InOnTileFetched, FMapboxFetchProgressDelegate InOnProgress, FMapboxFetchFinishedDelegate InOnFinished);
+	void Cancel();
+
+	bool IsRunning() const { return bRunning; }
+	int GetTotalCount() const { return TotalCount; }
+	int GetCompletedCount() const { return CompletedCount; }
+	int GetFailedCount() const { return FailedCount; }
+
+private:
+	struct FPendingTile
+	{
+		FString URL;
+		FMapboxRequestData MetaData;
+		TMap<FString, FString> Headers;
+		int Attempts = 0;
+		double NotBefore = 0;
+	};
+
+	bool Tick(float DeltaTime);
+	void Dispatch();
+	void Send(FPendingTile Tile);
+	void HandleResponse(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FPendingTile Tile);
+	void Retry(FPendingTile Tile, double Delay);
+	void Complete(FMapboxTileResult& Result);
+	void Finish(bool bCancelled);
+	double GetBackoffDelay(int Attempts) const;
+	double GetRetryAfter(FHttpResponsePtr HttpResponse) const;
+	static bool IsRetryable(int ResponseCode);
+
+	FMapboxFetchSettings Settings;
+	TArray<FPendingTile> Pending = TArray<FPendingTile>();
+	TArray<FHttpRequestPtr> InFlight = TArray<FHttpRequestPtr>();
+	FMapboxTileFetchedDelegate OnTileFetched;
+	FMapboxFetchProgressDelegate OnProgress;
+	FMapboxFetchFinishedDelegate OnFinished;
+	FTSTicker::FDelegateHandle TickerHandle;
+	double RateLimitedUntil = 0;
+	int TotalCount = 0;
+	int CompletedCount = 0;
+	int FailedCount = 0;
+	bool bRunning = false;
+};
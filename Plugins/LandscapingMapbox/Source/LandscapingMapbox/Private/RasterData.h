@@ -34,6 +34,10 @@ struct RasterData
     bool bHasNoData0 = false;
     bool bMapboxImport = false;
     int BandCount = 1;
+    // optional row-major float heights of band 1 (ImportResolution.X * ImportResolution.Y), written in one go instead of RasterBandData
+    TArray<float> HeightBuffer = TArray<float>();
+    // optional row-major colors for BandCount 3, written in one go instead of ColorBandData
+    TArray<FColor> ColorBuffer = TArray<FColor>();
 
     // overlaps and touches are counted as overlaps
     bool IsOverlapping(RasterData Other) const
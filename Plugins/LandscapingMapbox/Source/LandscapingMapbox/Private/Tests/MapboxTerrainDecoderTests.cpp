@@ -0,0 +1,133 @@
+// Copyright (c) 2021-2023 Josef Prenner
+// support@ludicdrive.com
+// ludicdrive.com
+// All Rights Reserved
+
+#include "../MapboxTerrainDecoder.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMapboxTerrainDecoderTest, "Landscaping.Mapbox.TerrainDecoder", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMapboxTerrainDecoderTest::RunTest(const FString& Parameters)
+{
+	// known values: R 1 G 134 B 160 is 0 m, all zero is -10000 m, all 255 is the maximum
+	const uint8 Known[] = { 1, 134, 160, 255, 0, 0, 0, 255, 255, 255, 255, 255, 1, 134, 170, 255, 0, 0, 0, 255 };
+	float KnownHeights[5];
+	FMapboxTerrainDecoder::DecodeRow(Known, KnownHeights, 5);
+	TestEqual(TEXT("Sea level"), KnownHeights[0], 0.0f, 0.01f);
+	TestEqual(TEXT("Minimum"), KnownHeights[1], -10000.0f);
+	TestEqual(TEXT("Maximum"), KnownHeights[2], 16777215 * 0.1f - 10000.0f, 1.0f);
+	TestEqual(TEXT("1 m"), KnownHeights[3], 1.0f, 0.01f);
+	TestEqual(TEXT("Scalar tail"), KnownHeights[4], -10000.0f);
+
+	// random tiles, the vectorized path has to match the scalar path.
+	// Both compute Value * 0.1 - 10000 in float, but the compiler may contract the scalar one into a fused multiply-add,
+	// which rounds once instead of twice. Heights go up to 1.67e6 m, where floats are 0.125 apart, so one rounding step is allowed.
+	const float Tolerance = 0.125f;
+	const int Dim = 512;
+	const int TilesX = 4;
+	const int TilesY = 4;
+	FRandomStream Random(2023);
+	TArray<uint8> Rgba;
+	Rgba.SetNumUninitialized(Dim * Dim * 4);
+	for(int i = 0; i < Rgba.Num(); i++)
+	{
+		Rgba[i] = (uint8)Random.RandRange(0, 255);
+	}
+	TArray<float> Scalar;
+	Scalar.SetNumUninitialized(Dim * Dim);
+	TArray<float> Vectorized;
+	Vectorized.SetNumUninitialized(Dim * Dim);
+	FMapboxTerrainDecoder::DecodeRowScalar(Rgba.GetData(), Scalar.GetData(), Dim * Dim);
+	FMapboxTerrainDecoder::DecodeRow(Rgba.GetData(), Vectorized.GetData(), Dim * Dim);
+	int Mismatches = 0;
+	for(int i = 0; i < Scalar.Num(); i++)
+	{
+		Mismatches += FMath::IsNearlyEqual(Scalar[i], Vectorized[i], Tolerance) ? 0 : 1;
+	}
+	TestEqual(TEXT("Vectorized decode matches scalar decode"), Mismatches, 0);
+
+	// tiles land in their own block of the mosaic
+	FMapboxMosaic Mosaic;
+	Mosaic.Init(14, 100, 200, TilesX, TilesY, Dim);
+	FMapboxTerrainDecoder::DecodeTile(Rgba.GetData(), Dim, Mosaic.GetTileOrigin(102, 201), Mosaic.Width);
+	TestEqual(TEXT("Mosaic width"), Mosaic.Width, TilesX * Dim);
+	TestEqual(TEXT("First pixel of tile"), Mosaic.Heights[(int64)Dim * Mosaic.Width + 2 * Dim], Scalar[0], Tolerance);
+	TestEqual(TEXT("Last pixel of tile"), Mosaic.Heights[(int64)(2 * Dim - 1) * Mosaic.Width + 3 * Dim - 1], Scalar[Dim * Dim - 1], Tolerance);
+	TestEqual(TEXT("Neighbour tile untouched"), Mosaic.Heights[(int64)Dim * Mosaic.Width + 3 * Dim], MB_NODATA);
+
+	// areas with more pixels than a TArray can index are rejected instead of overflowing the allocation
+	FMapboxMosaic Oversized;
+	AddExpectedError(TEXT("exceed the maximum"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Oversized mosaic rejected"), Oversized.Init(18, 0, 0, 300, 300, Dim));
+	TestEqual(TEXT("Oversized mosaic empty"), Oversized.Heights.Num(), 0);
+
+	FMapboxMosaic ColorMosaic;
+	ColorMosaic.Init(14, 100, 200, 2, 1, Dim, 3);
+	FMapboxTerrainDecoder::CopyColorTile(Rgba.GetData(), Dim, ColorMosaic.GetColorTileOrigin(101, 200), ColorMosaic.Width);
+	TestEqual(TEXT("Satellite tile placed in mosaic"), ColorMosaic.Colors[Dim + ColorMosaic.Width], FColor(Rgba[Dim * 4], Rgba[Dim * 4 + 1], Rgba[Dim * 4 + 2], Rgba[Dim * 4 + 3]));
+
+	// mixed zoom: tile 0,0 native, the other three upsampled from one tile two zoom levels below
+	FMapboxMosaic Mixed;
+	Mixed.Init(14, 0, 0, 2, 2, 4);
+	Mixed.NativeTiles = { true, false, false, false };
+	Mixed.Coarse = MakeShared<FMapboxMosaic, ESPMode::ThreadSafe>();
+	Mixed.Coarse->Init(12, 0, 0, 1, 1, 4);
+	for(int i = 0; i < Mixed.Coarse->Heights.Num(); i++)
+	{
+		Mixed.Coarse->Heights[i] = 100.0f;
+	}
+	FMapboxTerrainDecoder::FillFromCoarse(Mixed);
+	TestEqual(TEXT("Native tile untouched"), Mixed.Heights[0], MB_NODATA);
+	TestEqual(TEXT("Upsampled tile filled"), Mixed.Heights[Mixed.Width * Mixed.Height - 1], 100.0f);
+	TestEqual(TEXT("Upsampled neighbour filled"), Mixed.Heights[Mixed.TileDim], 100.0f);
+
+	// satellite: only the left coarse tile was fetched, the colors next to the unfetched right tile keep their value
+	FMapboxMosaic MixedColor;
+	MixedColor.Init(13, 0, 0, 4, 1, 4, 3);
+	MixedColor.NativeTiles = { false, false, true, true };
+	MixedColor.Coarse = MakeShared<FMapboxMosaic, ESPMode::ThreadSafe>();
+	MixedColor.Coarse->Init(12, 0, 0, 2, 1, 4, 3);
+	for(int Row = 0; Row < MixedColor.Coarse->Height; Row++)
+	{
+		for(int Column = 0; Column < MixedColor.Coarse->TileDim; Column++)
+		{
+			MixedColor.Coarse->Colors[Row * MixedColor.Coarse->Width + Column] = FColor(200, 100, 50, 255);
+		}
+	}
+	FMapboxTerrainDecoder::FillFromCoarse(MixedColor);
+	TestEqual(TEXT("Native satellite tile untouched"), MixedColor.Colors[2 * MixedColor.TileDim], MB_NODATA_COLOR);
+	TestEqual(TEXT("Upsampled satellite pixel filled"), MixedColor.Colors[0], FColor(200, 100, 50, 255));
+	TestEqual(TEXT("No dark seam next to an unfetched coarse tile"), MixedColor.Colors[2 * MixedColor.TileDim - 1], FColor(200, 100, 50, 255));
+
+	// benchmark: the previous per pixel decode into TArray<TArray<double>> against the row decoder
+	const int Iterations = TilesX * TilesY;
+	double Start = FPlatformTime::Seconds();
+	for(int Tile = 0; Tile < Iterations; Tile++)
+	{
+		TArray<TArray<double>> RasterBandData;
+		for(int Row = 0; Row < Dim; Row++)
+		{
+			RasterBandData.Add(TArray<double>());
+			for(int Column = 0; Column < Dim; Column++)
+			{
+				const uint8* Pixel = &Rgba[(Row * Dim + Column) * 4];
+				RasterBandData[Row].Add(-10000.0 + ((Pixel[0] * 256 * 256 + Pixel[1] * 256 + Pixel[2]) * 0.1));
+			}
+		}
+	}
+	const double PerPixelTime = FPlatformTime::Seconds() - Start;
+	Start = FPlatformTime::Seconds();
+	for(int Tile = 0; Tile < Iterations; Tile++)
+	{
+		FMapboxTerrainDecoder::DecodeTile(Rgba.GetData(), Dim, Mosaic.GetTileOrigin(100 + Tile % TilesX, 200 + Tile / TilesX), Mosaic.Width);
+	}
+	const double RowTime = FPlatformTime::Seconds() - Start;
+	AddInfo(FString::Printf(TEXT("Decoded %i tiles of %ix%i: per pixel %.2f ms, vectorized %.2f ms"), Iterations, Dim, Dim, PerPixelTime * 1000.0, RowTime * 1000.0));
+	return true;
+}
+
+#endif
@@ -0,0 +1,399 @@
+// Copyright (c) 2021-2023 Josef Prenner
+// support@ludicdrive.com
+// ludicdrive.com
+// All Rights Reserved
+
+#include "../LandscapingMapboxSettings.h"
+#include "../MapboxTileFetcher.h"
+#include "../MapboxTileCache.h"
+#include "MapboxDataSource.h"
+#include "HAL/FileManager.h"
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// local stand-in for the Mapbox API, the fetcher is pointed at http://localhost:MB_TEST_SERVER_PORT
+#define MB_TEST_SERVER_PORT 8931
+#define MB_TEST_TIMEOUT 30.0
+
+struct FMapboxFetcherTestState
+{
+	TSharedPtr<FMapboxTileFetcher, ESPMode::ThreadSafe> Fetcher = nullptr;
+	TSharedPtr<IHttpRouter> Router = nullptr;
+	TArray<FHttpRouteHandle> Routes = TArray<FHttpRouteHandle>();
+	// requests the stand-in received per path
+	TMap<FString, int> Hits = TMap<FString, int>();
+	// results by tile x
+	TMap<int, FMapboxTileResult> Results = TMap<int, FMapboxTileResult>();
+	// responses of the stand-in held back until the fetch was cancelled
+	TArray<FHttpResultCallback> HeldResponses = TArray<FHttpResultCallback>();
+	bool bFinished = false;
+	bool bCancelled = false;
+	double StartTime = 0;
+};
+
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FMapboxWaitForFetchCommand, TSharedPtr<FMapboxFetcherTestState>, State, FAutomationTestBase*, Test);
+
+bool FMapboxWaitForFetchCommand::Update()
+{
+	if(!State->bFinished && FPlatformTime::Seconds() - State->StartTime < MB_TEST_TIMEOUT)
+	{
+		return false;
+	}
+	for(const FHttpRouteHandle& Route : State->Routes)
+	{
+		State->Router->UnbindRoute(Route);
+	}
+	State->Routes.Empty();
+	if(!Test->TestTrue(TEXT("Fetch finished"), State->bFinished))
+	{
+		State->Fetcher->Cancel();
+		return true;
+	}
+	Test->TestFalse(TEXT("Fetch not cancelled"), State->bCancelled);
+	Test->TestEqual(TEXT("Completed"), State->Fetcher->GetCompletedCount(), 5);
+	Test->TestEqual(TEXT("Failed"), State->Fetcher->GetFailedCount(), 1);
+
+	// 200
+	const FMapboxTileResult& Ok = State->Results.FindRef(0);
+	Test->TestTrue(TEXT("200 succeeded"), Ok.bSucceeded && !Ok.bNotModified);
+	Test->TestTrue(TEXT("200 content"), Ok.Content == TArray<uint8>({ 't', 'i', 'l', 'e' }));
+	Test->TestEqual(TEXT("200 ETag"), Ok.CacheHeaders.ETag, FString(TEXT("\"v1\"")));
+	Test->TestEqual(TEXT("200 attempts"), Ok.Attempts, 1);
+
+	// 304 on the conditional request of an expired cache entry
+	const FMapboxTileResult& NotModified = State->Results.FindRef(1);
+	Test->TestTrue(TEXT("304 succeeded"), NotModified.bSucceeded && NotModified.bNotModified);
+	Test->TestEqual(TEXT("304 response code"), NotModified.ResponseCode, 304);
+
+	// 429 pauses and retries, 503 retries with backoff
+	const FMapboxTileResult& RateLimited = State->Results.FindRef(2);
+	Test->TestTrue(TEXT("429 retried"), RateLimited.bSucceeded);
+	Test->TestEqual(TEXT("429 attempts"), RateLimited.Attempts, 2);
+	const FMapboxTileResult& Unavailable = State->Results.FindRef(3);
+	Test->TestTrue(TEXT("503 retried"), Unavailable.bSucceeded);
+	Test->TestEqual(TEXT("503 attempts"), Unavailable.Attempts, 3);
+
+	// a persistent 5xx fails once the retries are used up
+	const FMapboxTileResult& ServerError = State->Results.FindRef(4);
+	Test->TestFalse(TEXT("500 failed"), ServerError.bSucceeded);
+	Test->TestEqual(TEXT("500 attempts"), ServerError.Attempts, 3);
+	Test->TestEqual(TEXT("500 response code"), ServerError.ResponseCode, 500);
+	Test->TestFalse(TEXT("500 error reported"), ServerError.Error.IsEmpty());
+	return true;
+}
+
+// binds a route which never answers on its own, see ReleaseHeldResponses
+static void BindHeldRoute(const TSharedPtr<FMapboxFetcherTestState>& State, const FString& Path)
+{
+	FHttpRouteHandle Route = State->Router->BindRoute(FHttpPath(Path), EHttpServerRequestVerbs::VERB_GET,
+		[State, Path](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			State->Hits.FindOrAdd(Path)++;
+			State->HeldResponses.Add(OnComplete);
+			return true;
+		});
+	State->Routes.Add(Route);
+}
+
+static void ReleaseHeldResponses(const TSharedPtr<FMapboxFetcherTestState>& State)
+{
+	for(const FHttpResultCallback& OnComplete : State->HeldResponses)
+	{
+		OnComplete(FHttpServerResponse::Create(TEXT("tile"), TEXT("application/octet-stream")));
+	}
+	State->HeldResponses.Empty();
+	for(const FHttpRouteHandle& Route : State->Routes)
+	{
+		State->Router->UnbindRoute(Route);
+	}
+	State->Routes.Empty();
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FMapboxCancelInFlightCommand, TSharedPtr<FMapboxFetcherTestState>, State, FAutomationTestBase*, Test);
+
+bool FMapboxCancelInFlightCommand::Update()
+{
+	if(State->HeldResponses.Num() < 2 && FPlatformTime::Seconds() - State->StartTime < MB_TEST_TIMEOUT)
+	{
+		return false;
+	}
+	Test->TestEqual(TEXT("Requests in flight"), State->HeldResponses.Num(), 2);
+	State->Fetcher->Cancel();
+	Test->TestTrue(TEXT("Fetch finished on cancel"), State->bFinished);
+	Test->TestTrue(TEXT("Fetch cancelled"), State->bCancelled);
+	Test->TestFalse(TEXT("Fetcher stopped"), State->Fetcher->IsRunning());
+	Test->TestEqual(TEXT("No tile completed"), State->Fetcher->GetCompletedCount(), 0);
+	// the responses arriving after the cancel are dropped, the pending tile is never requested
+	ReleaseHeldResponses(State);
+	Test->TestEqual(TEXT("Pending tile not requested"), State->Hits.FindRef(TEXT("/held")), 2);
+	Test->TestEqual(TEXT("No tile reported"), State->Results.Num(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMapboxTileFetcherCancelTest, "Landscaping.Mapbox.TileFetcher.Cancel", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMapboxTileFetcherCancelTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FMapboxFetcherTestState> State = MakeShared<FMapboxFetcherTestState>();
+	State->Router = FHttpServerModule::Get().GetHttpRouter(MB_TEST_SERVER_PORT);
+	if(!TestTrue(TEXT("Local http server"), State->Router.IsValid()))
+	{
+		return false;
+	}
+	BindHeldRoute(State, TEXT("/held"));
+	FHttpServerModule::Get().StartAllListeners();
+
+	FMapboxFetchSettings Settings;
+	Settings.MaxConcurrentRequests = 2;
+	Settings.MaxRetries = 0;
+	Settings.RequestTimeout = MB_TEST_TIMEOUT;
+	State->Fetcher = MakeShared<FMapboxTileFetcher, ESPMode::ThreadSafe>(Settings);
+	for(int i = 0; i < 3; i++)
+	{
+		FMapboxRequestData RequestData = FMapboxRequestData();
+		RequestData.DataType = ELandscapingRequestDataType::TERRAIN;
+		RequestData.TileNumberX = i;
+		RequestData.TileNumberY = 0;
+		RequestData.Zoom = 14;
+		State->Fetcher->Enqueue(FString::Printf(TEXT("http://localhost:%i/held"), MB_TEST_SERVER_PORT), RequestData);
+	}
+
+	State->StartTime = FPlatformTime::Seconds();
+	State->Fetcher->Start(
+		FMapboxTileFetchedDelegate::CreateLambda([State](FMapboxTileResult& Result) { State->Results.Add(Result.MetaData.TileNumberX, Result); }),
+		FMapboxFetchProgressDelegate(),
+		FMapboxFetchFinishedDelegate::CreateLambda([State](bool bCancelled) { State->bFinished = true; State->bCancelled = bCancelled; }));
+	ADD_LATENT_AUTOMATION_COMMAND(FMapboxCancelInFlightCommand(State, this));
+	return true;
+}
+
+struct FMapboxDataSourceTestState
+{
+	TSharedPtr<FMapboxFetcherTestState> Server = nullptr;
+	UMapboxDataSource* DataSource = nullptr;
+	// data broadcast by the data source
+	TArray<RasterData> Datas = TArray<RasterData>();
+	bool bFetched = false;
+	ULandscapingMapboxSettings* Settings = nullptr;
+	// settings changed by the test, restored when it is done
+	FString ApiKey = FString();
+	FString ApiBaseUrl = FString();
+	int Zoom = 0;
+	bool bMixedZoom = false;
+	int TileDownloadWarnLimit = 0;
+	bool bUseTileCache = false;
+	bool bOfflineMode = false;
+};
+
+static void FetchTerrain(const TSharedPtr<FMapboxDataSourceTestState>& State, bool bOfflineMode)
+{
+	State->Settings->bOfflineMode = bOfflineMode;
+	State->Datas.Empty();
+	State->bFetched = false;
+	State->Server->StartTime = FPlatformTime::Seconds();
+	FLandscapingDataSourceDelegate OnDataFetched;
+	OnDataFetched.AddLambda([State](TArray<RasterData>& Datas, int TileIndex)
+	{
+		State->Datas = Datas;
+		State->bFetched = true;
+	});
+	State->DataSource->FetchData(OnDataFetched, ELandscapingRequestDataType::TERRAIN);
+}
+
+static void RestoreDataSourceTest(const TSharedPtr<FMapboxDataSourceTestState>& State)
+{
+	ReleaseHeldResponses(State->Server);
+	State->Settings->ApiKey = State->ApiKey;
+	State->Settings->ApiBaseUrl = State->ApiBaseUrl;
+	State->Settings->Zoom = State->Zoom;
+	State->Settings->bMixedZoom = State->bMixedZoom;
+	State->Settings->TileDownloadWarnLimit = State->TileDownloadWarnLimit;
+	State->Settings->bUseTileCache = State->bUseTileCache;
+	State->Settings->bOfflineMode = State->bOfflineMode;
+	State->DataSource->RemoveFromRoot();
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FMapboxWaitForOfflineFetchCommand, TSharedPtr<FMapboxDataSourceTestState>, State, FAutomationTestBase*, Test);
+
+bool FMapboxWaitForOfflineFetchCommand::Update()
+{
+	if(!State->bFetched && FPlatformTime::Seconds() - State->Server->StartTime < MB_TEST_TIMEOUT)
+	{
+		return false;
+	}
+	// offline mode never asks the server for a tile missing in the cache, the fetch fails
+	Test->TestTrue(TEXT("Offline fetch finished"), State->bFetched);
+	Test->TestEqual(TEXT("No request for offline cache miss"), State->Server->Hits.FindRef(TEXT("/v4")), 0);
+	Test->TestEqual(TEXT("Offline fetch result"), State->Datas.Num(), 1);
+	Test->TestTrue(TEXT("Offline fetch failed"), State->Datas.Num() == 1 && State->Datas[0].Error.Contains(TEXT("could not be fetched")));
+
+	// the tile is requested online, the stand-in holds the response back until the fetch was cancelled
+	FetchTerrain(State, false);
+	return true;
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FMapboxCancelDataSourceFetchCommand, TSharedPtr<FMapboxDataSourceTestState>, State, FAutomationTestBase*, Test);
+
+bool FMapboxCancelDataSourceFetchCommand::Update()
+{
+	if(State->Server->HeldResponses.Num() == 0 && FPlatformTime::Seconds() - State->Server->StartTime < MB_TEST_TIMEOUT)
+	{
+		return false;
+	}
+	Test->TestEqual(TEXT("Online request sent"), State->Server->Hits.FindRef(TEXT("/v4")), 1);
+	Test->TestFalse(TEXT("Not fetched before the cancel"), State->bFetched);
+	State->DataSource->CancelFetch();
+	Test->TestTrue(TEXT("Cancel broadcast"), State->bFetched);
+	Test->TestEqual(TEXT("Cancelled fetch result"), State->Datas.Num(), 1);
+	Test->TestTrue(TEXT("Cancelled fetch error"), State->Datas.Num() == 1 && State->Datas[0].Error == TEXT("Mapbox requests cancelled"));
+	RestoreDataSourceTest(State);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMapboxDataSourceFetchTest, "Landscaping.Mapbox.DataSource.Fetch", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMapboxDataSourceFetchTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FMapboxDataSourceTestState> State = MakeShared<FMapboxDataSourceTestState>();
+	State->Server = MakeShared<FMapboxFetcherTestState>();
+	State->Server->Router = FHttpServerModule::Get().GetHttpRouter(MB_TEST_SERVER_PORT);
+	if(!TestTrue(TEXT("Local http server"), State->Server->Router.IsValid()))
+	{
+		return false;
+	}
+	// all tile urls start with /v4/<tileset>
+	BindHeldRoute(State->Server, TEXT("/v4"));
+	FHttpServerModule::Get().StartAllListeners();
+
+	State->Settings = GetMutableDefault<ULandscapingMapboxSettings>();
+	State->ApiKey = State->Settings->ApiKey;
+	State->ApiBaseUrl = State->Settings->ApiBaseUrl;
+	State->Zoom = State->Settings->Zoom;
+	State->bMixedZoom = State->Settings->bMixedZoom;
+	State->TileDownloadWarnLimit = State->Settings->TileDownloadWarnLimit;
+	State->bUseTileCache = State->Settings->bUseTileCache;
+	State->bOfflineMode = State->Settings->bOfflineMode;
+	State->Settings->ApiKey = TEXT("test");
+	State->Settings->ApiBaseUrl = FString::Printf(TEXT("http://localhost:%i"), MB_TEST_SERVER_PORT);
+	State->Settings->Zoom = 10;
+	State->Settings->bMixedZoom = false;
+	State->Settings->TileDownloadWarnLimit = 0;
+	State->Settings->bUseTileCache = true;
+
+	// an empty tile cache, a single tile at zoom 10
+	const FString WorkingDir = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("MapboxDataSource"));
+	IFileManager::Get().DeleteDirectory(*WorkingDir, false, true);
+	State->DataSource = NewObject<UMapboxDataSource>();
+	State->DataSource->AddToRoot();
+	State->DataSource->SetWorkingDir(WorkingDir);
+	State->DataSource->SetExtents(47.001, 11.001, 47.002, 11.002, 0);
+
+	AddExpectedError(TEXT("no request sent in offline mode"), EAutomationExpectedErrorFlags::Contains, 1);
+	FetchTerrain(State, true);
+	ADD_LATENT_AUTOMATION_COMMAND(FMapboxWaitForOfflineFetchCommand(State, this));
+	ADD_LATENT_AUTOMATION_COMMAND(FMapboxCancelDataSourceFetchCommand(State, this));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMapboxTileFetcherTest, "Landscaping.Mapbox.TileFetcher", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMapboxTileFetcherTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FMapboxFetcherTestState> State = MakeShared<FMapboxFetcherTestState>();
+	State->Router = FHttpServerModule::Get().GetHttpRouter(MB_TEST_SERVER_PORT);
+	if(!TestTrue(TEXT("Local http server"), State->Router.IsValid()))
+	{
+		return false;
+	}
+
+	// responds with Codes in order, the last one is repeated
+	auto BindRoute = [State](const FString& Path, const TArray<EHttpServerResponseCodes>& Codes)
+	{
+		FHttpRouteHandle Route = State->Router->BindRoute(FHttpPath(Path), EHttpServerRequestVerbs::VERB_GET,
+			[State, Path, Codes](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+			{
+				int& Hits = State->Hits.FindOrAdd(Path);
+				EHttpServerResponseCodes Code = Codes[FMath::Min(Hits, Codes.Num() - 1)];
+				Hits++;
+				const TArray<FString>* IfNoneMatch = Request.Headers.Find(TEXT("If-None-Match"));
+				if(IfNoneMatch && IfNoneMatch->Contains(TEXT("\"v1\"")))
+				{
+					Code = EHttpServerResponseCodes::NotModified;
+				}
+				TUniquePtr<FHttpServerResponse> Response = Code == EHttpServerResponseCodes::Ok
+					? FHttpServerResponse::Create(TEXT("tile"), TEXT("application/octet-stream"))
+					: MakeUnique<FHttpServerResponse>();
+				Response->Code = Code;
+				Response->Headers.Add(TEXT("ETag"), { TEXT("\"v1\"") });
+				Response->Headers.Add(TEXT("Cache-Control"), { TEXT("max-age=3600") });
+				if(Code == EHttpServerResponseCodes::TooManyRequests)
+				{
+					Response->Headers.Add(TEXT("Retry-After"), { TEXT("0") });
+				}
+				OnComplete(MoveTemp(Response));
+				return true;
+			});
+		State->Routes.Add(Route);
+	};
+	BindRoute(TEXT("/ok"), { EHttpServerResponseCodes::Ok });
+	BindRoute(TEXT("/notmodified"), { EHttpServerResponseCodes::Ok });
+	BindRoute(TEXT("/ratelimited"), { EHttpServerResponseCodes::TooManyRequests, EHttpServerResponseCodes::Ok });
+	BindRoute(TEXT("/unavailable"), { EHttpServerResponseCodes::ServiceUnavail, EHttpServerResponseCodes::ServiceUnavail, EHttpServerResponseCodes::Ok });
+	BindRoute(TEXT("/servererror"), { EHttpServerResponseCodes::ServerError });
+	FHttpServerModule::Get().StartAllListeners();
+
+	// an expired entry with an ETag is revalidated, a missing one is reported as offline miss
+	const FString CacheDir = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("MapboxTileFetcher"));
+	IFileManager::Get().DeleteDirectory(*CacheDir, false, true);
+	FMapboxTileCache Cache(CacheDir);
+	FMapboxCacheHeaders ExpiredHeaders;
+	ExpiredHeaders.CacheControl = TEXT("no-cache");
+	ExpiredHeaders.ETag = TEXT("\"v1\"");
+	const TArray<uint8> CachedTile = { 't', 'i', 'l', 'e' };
+	Cache.Store(TEXT("notmodified"), CachedTile, ExpiredHeaders);
+	TArray<uint8> Content;
+	TMap<FString, FString> NotModifiedHeaders;
+	TestTrue(TEXT("Expired entry requested"), Cache.Lookup(TEXT("notmodified"), false, Content, NotModifiedHeaders) == EMapboxCacheLookup::Request);
+	TestEqual(TEXT("Conditional request"), NotModifiedHeaders.FindRef(TEXT("If-None-Match")), FString(TEXT("\"v1\"")));
+	TMap<FString, FString> OfflineHeaders;
+	TestTrue(TEXT("Expired entry used offline"), Cache.Lookup(TEXT("notmodified"), true, Content, OfflineHeaders) == EMapboxCacheLookup::Hit);
+	TestTrue(TEXT("Offline cache miss"), Cache.Lookup(TEXT("offline"), true, Content, OfflineHeaders) == EMapboxCacheLookup::OfflineMiss);
+
+	FMapboxFetchSettings Settings;
+	Settings.MaxConcurrentRequests = 2;
+	Settings.MaxRetries = 2;
+	Settings.RetryBaseDelay = 0.05f;
+	Settings.RetryMaxDelay = 1.0f;
+	Settings.RequestTimeout = 5.0f;
+	State->Fetcher = MakeShared<FMapboxTileFetcher, ESPMode::ThreadSafe>(Settings);
+	const TArray<FString> Paths = { TEXT("/ok"), TEXT("/notmodified"), TEXT("/ratelimited"), TEXT("/unavailable"), TEXT("/servererror") };
+	for(int i = 0; i < Paths.Num(); i++)
+	{
+		FMapboxRequestData RequestData = FMapboxRequestData();
+		RequestData.DataType = ELandscapingRequestDataType::TERRAIN;
+		RequestData.TileNumberX = i;
+		RequestData.TileNumberY = 0;
+		RequestData.Zoom = 14;
+		RequestData.CacheKey = Paths[i].RightChop(1);
+		const FString URL = FString::Printf(TEXT("http://localhost:%i%s"), MB_TEST_SERVER_PORT, *Paths[i]);
+		State->Fetcher->Enqueue(URL, RequestData, i == 1 ? NotModifiedHeaders : TMap<FString, FString>());
+	}
+
+	AddExpectedError(TEXT("Rate limited by Mapbox"), EAutomationExpectedErrorFlags::Contains, 1);
+	State->StartTime = FPlatformTime::Seconds();
+	State->Fetcher->Start(
+		FMapboxTileFetchedDelegate::CreateLambda([State](FMapboxTileResult& Result) { State->Results.Add(Result.MetaData.TileNumberX, Result); }),
+		FMapboxFetchProgressDelegate(),
+		FMapboxFetchFinishedDelegate::CreateLambda([State](bool bCancelled) { State->bFinished = true; State->bCancelled = bCancelled; }));
+	ADD_LATENT_AUTOMATION_COMMAND(FMapboxWaitForFetchCommand(State, this));
+	return true;
+}
+
+#endif
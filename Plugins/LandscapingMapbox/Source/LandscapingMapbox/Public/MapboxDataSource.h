@@ -19,6 +19,8 @@
 #include "FileHelpers.h"
 #include "ILandscapingDataSource.h"
 #include "MapboxConverter.h"
+#include "MapboxTerrainDecoder.h"
+#include "MapboxTileFetcher.h"
 #include "RasterData.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "MapboxDataSource.generated.h"
@@ -32,13 +34,7 @@
 #define MB_MINLONGITUDE -180.0f
 #define MB_MAXLONGITUDE 180.0f
 
-struct FMapboxRequestData
-{
-	ELandscapingRequestDataType DataType;
-	int TileNumberX;
-	int TileNumberY;
-	RasterData RasterData;
-};
+DECLARE_MULTICAST_DELEGATE_TwoParams(FMapboxFetchProgressEvent, int, int);
 
 UCLASS(BlueprintType, ClassGroup=LandscapingMapbox)
 class UMapboxDataSource : public UObject, public ILandscapingDataSource
@@ -63,18 +59,36 @@ public:
 	int RequestedZoomSatellite;
 	int RequestedZoomVector;
 	FString SkuToken = FString();
-	void Start(FString URL, FMapboxRequestData MapboxMetaData);
+	// areas in WGS84 (Min = left/bottom, Max = right/top) fetched at full zoom in mixed zoom mode
+	void LANDSCAPINGMAPBOX_API SetAreasOfInterest(const TArray<FBox2D>& InAreas);
+	// cancels all pending tile requests, OnDataFetched is broadcast with an error
+	void LANDSCAPINGMAPBOX_API CancelFetch();
+	// completed and total number of tiles of the running fetch
+	FMapboxFetchProgressEvent OnFetchProgress;
 	
 private:
 	bool ValidateRequest(FString& OutError);
 	void Request(double BottomLatitude, double LeftLongitude, double TopLatitude, double RightLongitude, ELandscapingRequestDataType Type);
-	void HandleMapboxResponse(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FMapboxRequestData MapboxMetaData);
-	void AbortWithError();
+	void HandleTileFetched(FMapboxTileResult& Result);
+	void HandleCachedTile(const FMapboxRequestData& RequestData, TArray<uint8>& Content);
+	void HandleFetchProgress(int Completed, int Total);
+	void HandleFetchFinished(bool bCancelled);
+	bool DecodeTile(const FMapboxTileResult& Result, RasterData& OutData, FString& OutError);
+	void DecodeMosaicTileAsync(FMapboxTileResult& Result, bool bStoreInCache);
+	void HandleMosaicTileDecoded(const FMapboxTileResult& Result, bool bStoreInCache, bool bDecoded, const FString& DecodeError);
+	void CompleteFetch();
 	void FinishResponse(RasterData Data);
 
+	TSharedPtr<FMapboxTileFetcher, ESPMode::ThreadSafe> Fetcher;
+	TSharedPtr<FMapboxTileCache, ESPMode::ThreadSafe> TileCache;
+	// terrain and satellite tiles are decoded on worker threads straight into one buffer
+	TSharedPtr<FMapboxMosaic, ESPMode::ThreadSafe> Mosaic;
+	int PendingDecodes = 0;
+	TArray<FBox2D> AreasOfInterest = TArray<FBox2D>();
+	bool bFetchFinished = false;
+	bool bFetchCancelled = false;
 	int TotalRequests = 0;
-	bool bRequestFailed = false;
-	int CompletedRequests = 0;
+	int FailedRequests = 0;
 	TArray<RasterData> OutDatas = TArray<RasterData>();
 	FString CacheWorkingDir;
 	int64_t TokenExpiresAt = 0;